@@ -0,0 +1,157 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_batch.h
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#ifndef OJPH_BATCH_H
+#define OJPH_BATCH_H
+
+#include <string>
+#include <vector>
+
+#include "ojph_defs.h"
+
+namespace ojph
+{
+namespace batch
+{
+
+///////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////
+
+//************************************************************************/
+/** @brief The input and output file names of the images of a batch
+  *
+  *  The names come either from a list file, or from a pair of printf-style
+  *  patterns, such as "frame_%05d.dpx", that are expanded for a range of
+  *  frame numbers.
+  */
+class job_list {
+public:
+  /**
+    *  @brief Expands a pair of patterns into num_frames jobs
+    *
+    *  Each pattern must contain exactly one integer conversion, %d, %i,
+    *  or %u, with optional flags and width, as in %05d; a literal '%' is
+    *  written as %%.
+    *
+    *  @param in_pattern the pattern of the input file names
+    *  @param out_pattern the pattern of the output file names
+    *  @param first_frame the frame number of the first job
+    *  @param num_frames the number of jobs
+    */
+  void init_from_patterns(const char *in_pattern, const char *out_pattern,
+                          ui32 first_frame, ui32 num_frames);
+
+  /**
+    *  @brief Reads the jobs from a text file
+    *
+    *  Each line holds an input file name followed by an output file
+    *  name, separated by spaces or tabs; names cannot contain spaces.
+    *  Empty lines, and lines that start with '#', are skipped.
+    *
+    *  @param filename the list file
+    */
+  void init_from_file(const char *filename);
+
+  /**
+    *  @brief Returns true if the name has a printf-style conversion
+    */
+  static bool is_pattern(const char *name);
+
+  size_t get_num_jobs() const { return inputs.size(); }
+  const char *get_input(size_t i) const { return inputs[i].c_str(); }
+  const char *get_output(size_t i) const { return outputs[i].c_str(); }
+
+private:
+  std::vector<std::string> inputs;
+  std::vector<std::string> outputs;
+};
+
+//************************************************************************/
+/** @brief What a worker reports for one image
+  */
+struct image_stats {
+  image_stats() : num_samples(0), coded_bytes(0) {}
+  ui64 num_samples;   //!<image samples, over all components
+  ui64 coded_bytes;   //!<size of the codestream written or read
+};
+
+//************************************************************************/
+/** @brief Processes the images of a batch, one after another
+  *
+  *  A tool derives a worker that keeps its codestream and image file
+  *  objects between images, so that their memory is allocated for the
+  *  first image and reused for the rest.  Each worker is used by one
+  *  thread only.
+  */
+class worker {
+public:
+  virtual ~worker() {}
+
+  /**
+    *  @brief Processes one image; errors are reported by throwing
+    *
+    *  @param input_filename the input file
+    *  @param output_filename the output file; some image writers change
+    *         its extension in place, so it must be writable
+    *  @param stats receives the size of the processed image
+    */
+  virtual void process(const char *input_filename, char *output_filename,
+                       image_stats& stats) = 0;
+};
+
+//************************************************************************/
+/** @brief Runs the jobs of a list on the given workers, and prints the
+  *         aggregate throughput
+  *
+  *  Each worker runs on its own thread, taking the next job from the list
+  *  until none remain; the calling thread runs the first worker.  A job
+  *  that fails is reported and skipped.
+  *
+  *  @param jobs the jobs to run
+  *  @param workers the workers, one per thread
+  *  @param num_workers the number of workers
+  *  @return the number of jobs that failed
+  */
+size_t run(const job_list& jobs, worker **workers, ui32 num_workers);
+
+} // !batch namespace
+} // !ojph namespace
+
+#endif // !OJPH_BATCH_H
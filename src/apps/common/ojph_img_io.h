@@ -56,6 +56,86 @@ namespace ojph {
   class mem_fixed_allocator;
   class line_buf;
 
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+  /** @brief A read-only memory mapping of a whole file
+    *
+    *  The ppm, yuv and raw readers map their input file, which saves the
+    *  copy that fread makes.  open() returns false for files that cannot
+    *  be mapped, such as pipes and empty files, and these readers then
+    *  fall back to fread.
+    */
+  class mapped_file
+  {
+  public:
+    mapped_file() : data(NULL), size(0) {}
+    ~mapped_file() { close(); }
+
+    bool open(const char *filename);
+    void close();
+
+    bool is_open() const { return data != NULL; }
+    const ui8* get_data() const { return data; }
+    ui64 get_size() const { return size; }
+
+  private:
+    const ui8 *data;
+    ui64 size;
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Accelerators for the readers (defined in ojph_img_io_*); these convert
+  // count 8- or 16-bit samples to 32-bit samples.  The 3c variants take
+  // one component of interleaved 3-component data.
+  typedef void (*unpack_fun)(const void *sp, si32 *dp, ui32 count);
+
+  void gen_cvrt_8ub1c_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void gen_cvrt_8sb1c_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void gen_cvrt_8ub3c_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void gen_cvrt_16ub1c_le_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void gen_cvrt_16sb1c_le_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void gen_cvrt_16ub1c_be_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void gen_cvrt_16ub3c_be_to_32b1c(const void *sp, si32 *dp, ui32 count);
+
+  void avx2_cvrt_8ub1c_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void avx2_cvrt_8sb1c_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void avx2_cvrt_8ub3c_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void avx2_cvrt_16ub1c_le_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void avx2_cvrt_16sb1c_le_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void avx2_cvrt_16ub1c_be_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void avx2_cvrt_16ub3c_be_to_32b1c(const void *sp, si32 *dp, ui32 count);
+
+  void avx512_cvrt_8ub1c_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void avx512_cvrt_8sb1c_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void avx512_cvrt_8ub3c_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void avx512_cvrt_16ub1c_le_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void avx512_cvrt_16sb1c_le_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void avx512_cvrt_16ub1c_be_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void avx512_cvrt_16ub3c_be_to_32b1c(const void *sp, si32 *dp, ui32 count);
+
+  // P010 holds 10-bit samples in the upper bits of 16-bit little-endian
+  // words; the 2c variants take one component of interleaved CbCr
+  void gen_cvrt_p010_1c_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void gen_cvrt_p010_2c_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void avx2_cvrt_p010_1c_to_32b1c(const void *sp, si32 *dp, ui32 count);
+  void avx2_cvrt_p010_2c_to_32b1c(const void *sp, si32 *dp, ui32 count);
+
+  // v210 packs 6 pixels of 4:2:2 10-bit video into 4 little-endian 32-bit
+  // words; count is the number of luma samples, and dp1 and dp2 receive
+  // (count + 1) / 2 chroma samples each
+  typedef void (*unpack3_fun)(const void *sp, si32 *dp0, si32 *dp1,
+                              si32 *dp2, ui32 count);
+
+  void gen_cvrt_v210_to_32b3c(const void *sp, si32 *dp0, si32 *dp1,
+                              si32 *dp2, ui32 count);
+  void avx2_cvrt_v210_to_32b3c(const void *sp, si32 *dp0, si32 *dp1,
+                               si32 *dp2, ui32 count);
+
   ////////////////////////////////////////////////////////////////////////////
   //
   //
@@ -90,6 +170,8 @@ namespace ojph {
       width = height = num_comps = max_val = max_val_num_bits = 0;
       bytes_per_sample = num_ele_per_line = 0;
       temp_buf_byte_size = 0;
+      line_data = NULL;
+      unpacker = NULL;
 
       cur_line = 0;
       start_of_data = 0;
@@ -109,7 +191,8 @@ namespace ojph {
     void open(const char* filename);
     void finalize_alloc();
     virtual ui32 read(const line_buf* line, ui32 comp_num);
-    void close() { if(fh) { fclose(fh); fh = NULL; } fname = NULL; }
+    void close()
+    { if(fh) { fclose(fh); fh = NULL; } map.close(); fname = NULL; }
     void set_planar(bool planar) { this->planar = planar; }
 
     size get_size() { assert(fh); return size(width, height); }
@@ -132,6 +215,9 @@ namespace ojph {
     ui32 width, height, num_comps, max_val, max_val_num_bits;
     ui32 bytes_per_sample, num_ele_per_line;
     ui32 temp_buf_byte_size;
+    mapped_file map;
+    const ui8 *line_data;     // the current line, in map or in temp_buf
+    unpack_fun unpacker;
 
     ui32 cur_line;
     si64 start_of_data;
@@ -360,6 +446,8 @@ namespace ojph {
         bytes_per_sample[i] = 0;
       }
       num_com = 0;
+      unpacker[2] = unpacker[1] = unpacker[0] = NULL;
+      map_offset = 0;
 
       cur_line = 0;
       last_comp = 0;
@@ -374,7 +462,8 @@ namespace ojph {
 
     void open(const char* filename);
     virtual ui32 read(const line_buf* line, ui32 comp_num);
-    void close() { if(fh) { fclose(fh); fh = NULL; } fname = NULL; }
+    void close()
+    { if(fh) { fclose(fh); fh = NULL; } map.close(); fname = NULL; }
 
     void set_bit_depth(ui32 num_bit_depths, ui32* bit_depth);
     void set_img_props(const size& s, ui32 num_components,
@@ -391,6 +480,9 @@ namespace ojph {
     ui32 width[3], height[3], num_com;
     ui32 bytes_per_sample[3];
     ui32 comp_address[3];
+    mapped_file map;
+    ui64 map_offset;          // the next line in map
+    unpack_fun unpacker[3];
 
     ui32 cur_line, last_comp;
     bool planar;
@@ -418,6 +510,8 @@ namespace ojph {
       cur_line = 0;
       buffer = NULL;
       buffer_size = 0;
+      map_offset = 0;
+      unpacker = NULL;
     }
     virtual ~raw_in()
     {
@@ -428,7 +522,8 @@ namespace ojph {
 
     void open(const char* filename);
     virtual ui32 read(const line_buf* line, ui32 comp_num = 0);
-    void close() { if(fh) { fclose(fh); fh = NULL; } fname = NULL; }
+    void close()
+    { if(fh) { fclose(fh); fh = NULL; } map.close(); fname = NULL; }
 
     void set_img_props(const size& s, ui32 bit_depth, bool is_signed);
 
@@ -444,6 +539,133 @@ namespace ojph {
     ui32 cur_line;
     void* buffer;
     size_t buffer_size;
+    mapped_file map;
+    ui64 map_offset;          // the next line in map
+    unpack_fun unpacker;      // for 8- and 16-bit samples
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+  /** @brief Reads a v210 file, which holds 4:2:2 10-bit Y'CbCr video
+    *
+    *  Each line of the file is padded to a multiple of 128 bytes.  The
+    *  components are Y, Cb and Cr; Cb and Cr are downsampled by {2,1}.
+    *  Lines can be read in any order.
+    */
+  class v210_in : public image_in_base
+  {
+  public:
+    v210_in()
+    {
+      fh = NULL;
+      fname = NULL;
+      width = height = 0;
+      bytes_per_line = 0;
+      cur_line[2] = cur_line[1] = cur_line[0] = 0;
+      unpacked_line = 0;
+      file_pos = 0;
+      line_data = NULL;
+      samples = NULL;
+      buffer_size = 0;
+      unpacker = NULL;
+    }
+    virtual ~v210_in()
+    {
+      close();
+      if (line_data)
+        free(line_data);
+      if (samples)
+        free(samples);
+    }
+
+    void set_img_props(const size& s);
+    void open(const char* filename);
+    virtual ui32 read(const line_buf* line, ui32 comp_num);
+    void close()
+    { if(fh) { fclose(fh); fh = NULL; } map.close(); fname = NULL; }
+
+    ui32 get_num_components() { return 3; }
+    ui32 get_bit_depth() { return 10; }
+    point get_comp_subsampling(ui32 comp_num)
+    { assert(comp_num < 3); return comp_num ? point(2, 1) : point(1, 1); }
+
+  private:
+    FILE *fh;
+    const char *fname;
+    mapped_file map;
+    ui32 width, height;
+    ui32 bytes_per_line;
+    ui32 cur_line[3];         // the next line of each component
+    ui32 unpacked_line;       // the line in samples, or height if none
+    ui64 file_pos;            // where fread reads next; seeks are avoided
+    ui8 *line_data;           // a line read with fread
+    si32 *samples;            // the Y, Cb and Cr samples of unpacked_line
+    size_t buffer_size;
+    unpack3_fun unpacker;
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+  /** @brief Reads a P010 file, which holds 4:2:0 10-bit Y'CbCr video
+    *
+    *  The file has a plane of Y samples followed by a plane of interleaved
+    *  Cb and Cr samples; each sample occupies the upper 10 bits of a 16-bit
+    *  little-endian word.  Cb and Cr are downsampled by {2,2}.  Lines can be
+    *  read in any order, but the file must be seekable, because Cb and Cr
+    *  lines are read from the same plane.
+    */
+  class p010_in : public image_in_base
+  {
+  public:
+    p010_in()
+    {
+      fh = NULL;
+      fname = NULL;
+      width = height = 0;
+      cur_line[2] = cur_line[1] = cur_line[0] = 0;
+      file_pos = 0;
+      line_data = NULL;
+      buffer_size = 0;
+      unpacker[1] = unpacker[0] = NULL;
+    }
+    virtual ~p010_in()
+    {
+      close();
+      if (line_data)
+        free(line_data);
+    }
+
+    void set_img_props(const size& s);
+    void open(const char* filename);
+    virtual ui32 read(const line_buf* line, ui32 comp_num);
+    void close()
+    { if(fh) { fclose(fh); fh = NULL; } map.close(); fname = NULL; }
+
+    ui32 get_num_components() { return 3; }
+    ui32 get_bit_depth() { return 10; }
+    point get_comp_subsampling(ui32 comp_num)
+    { assert(comp_num < 3); return comp_num ? point(2, 2) : point(1, 1); }
+
+  private:
+    FILE *fh;
+    const char *fname;
+    mapped_file map;
+    ui32 width, height;
+    ui32 cur_line[3];         // the next line of each component
+    ui64 file_pos;            // where fread reads next; seeks are avoided
+    ui8 *line_data;           // a line read with fread
+    size_t buffer_size;
+    unpack_fun unpacker[2];   // for Y, and for Cb or Cr
   };
 
   ////////////////////////////////////////////////////////////////////////////
@@ -565,6 +787,37 @@ namespace ojph {
                                     const line_buf *ln2, void *dp, 
                                     ui32 bit_depth, ui32 count);
 
+  // the 2c variant writes every other 16-bit word of dp, leaving the other
+  // component of interleaved CbCr untouched
+  void gen_cvrt_32b1c_to_p010_1c(const line_buf *ln0, const line_buf *ln1,
+                                 const line_buf *ln2, void *dp,
+                                 ui32 bit_depth, ui32 count);
+  void gen_cvrt_32b1c_to_p010_2c(const line_buf *ln0, const line_buf *ln1,
+                                 const line_buf *ln2, void *dp,
+                                 ui32 bit_depth, ui32 count);
+  void avx2_cvrt_32b1c_to_p010_1c(const line_buf *ln0, const line_buf *ln1,
+                                  const line_buf *ln2, void *dp,
+                                  ui32 bit_depth, ui32 count);
+  void avx2_cvrt_32b1c_to_p010_2c(const line_buf *ln0, const line_buf *ln1,
+                                  const line_buf *ln2, void *dp,
+                                  ui32 bit_depth, ui32 count);
+
+  // count is the number of luma samples in ln0
+  void gen_cvrt_32b3c_to_v210(const line_buf *ln0, const line_buf *ln1,
+                              const line_buf *ln2, void *dp,
+                              ui32 bit_depth, ui32 count);
+  void avx2_cvrt_32b3c_to_v210(const line_buf *ln0, const line_buf *ln1,
+                               const line_buf *ln2, void *dp,
+                               ui32 bit_depth, ui32 count);
+
+  // DPX 10-bit RGB, filled to 32-bit big-endian words (packing method A)
+  void gen_cvrt_32b3c_to_dpx10_be(const line_buf *ln0, const line_buf *ln1,
+                                  const line_buf *ln2, void *dp,
+                                  ui32 bit_depth, ui32 count);
+  void avx2_cvrt_32b3c_to_dpx10_be(const line_buf *ln0, const line_buf *ln1,
+                                   const line_buf *ln2, void *dp,
+                                   ui32 bit_depth, ui32 count);
+
   ////////////////////////////////////////////////////////////////////////////
   //
   //
@@ -766,6 +1019,149 @@ namespace ojph {
     ui32 buffer_size;
   };
 
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+  /** @brief Writes a v210 file; see v210_in
+    *
+    *  The components must be written one line of each in turn.
+    */
+  class v210_out : public image_out_base
+  {
+  public:
+    v210_out()
+    {
+      fh = NULL;
+      fname = NULL;
+      width = height = 0;
+      bytes_per_line = 0;
+      buffer = NULL;
+      buffer_size = 0;
+      converter = NULL;
+      lptr[0] = lptr[1] = lptr[2] = NULL;
+    }
+    virtual ~v210_out()
+    {
+      close();
+      if (buffer)
+        free(buffer);
+    }
+
+    void open(char* filename);
+    void configure(ui32 width, ui32 height);
+    virtual ui32 write(const line_buf* line, ui32 comp_num);
+    virtual void close() { if(fh) { fclose(fh); fh = NULL; } fname = NULL; }
+
+  private:
+    FILE *fh;
+    const char *fname;
+    ui32 width, height;
+    ui32 bytes_per_line;
+    ui8 *buffer;
+    size_t buffer_size;
+    conversion_fun converter;
+    const line_buf *lptr[3];
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+  /** @brief Writes a P010 file; see p010_in
+    *
+    *  The components must be written one after the other.  Y lines go to
+    *  the file as they arrive, while the CbCr plane is assembled in memory
+    *  and written after its last line.
+    */
+  class p010_out : public image_out_base
+  {
+  public:
+    p010_out()
+    {
+      fh = NULL;
+      fname = NULL;
+      width = height = 0;
+      cur_line[2] = cur_line[1] = cur_line[0] = 0;
+      buffer = NULL;
+      buffer_size = 0;
+      converter[1] = converter[0] = NULL;
+    }
+    virtual ~p010_out()
+    {
+      close();
+      if (buffer)
+        free(buffer);
+    }
+
+    void open(char* filename);
+    void configure(ui32 width, ui32 height);
+    virtual ui32 write(const line_buf* line, ui32 comp_num);
+    virtual void close() { if(fh) { fclose(fh); fh = NULL; } fname = NULL; }
+
+  private:
+    FILE *fh;
+    const char *fname;
+    ui32 width, height;
+    ui32 cur_line[3];         // the next line of each component
+    ui16 *buffer;             // a line of Y, followed by the CbCr plane
+    size_t buffer_size;
+    conversion_fun converter[2];  // for Y, and for Cb or Cr
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+  /** @brief Writes a big-endian DPX file of 10-bit RGB samples, filled to
+    *         32-bit words (packing method A), which dpx_in reads
+    *
+    *  The components must be written one line of each in turn.
+    */
+  class dpx_out : public image_out_base
+  {
+  public:
+    dpx_out()
+    {
+      fh = NULL;
+      fname = NULL;
+      width = height = 0;
+      buffer = NULL;
+      buffer_size = 0;
+      converter = NULL;
+      lptr[0] = lptr[1] = lptr[2] = NULL;
+    }
+    virtual ~dpx_out()
+    {
+      close();
+      if (buffer)
+        free(buffer);
+    }
+
+    void open(char* filename);
+    void configure(ui32 width, ui32 height);
+    virtual ui32 write(const line_buf* line, ui32 comp_num);
+    virtual void close() { if(fh) { fclose(fh); fh = NULL; } fname = NULL; }
+
+  private:
+    FILE *fh;
+    const char *fname;
+    ui32 width, height;
+    ui32 *buffer;
+    size_t buffer_size;
+    conversion_fun converter;
+    const line_buf *lptr[3];
+  };
+
   ////////////////////////////////////////////////////////////////////////////
   //
   //
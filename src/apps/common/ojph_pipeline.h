@@ -0,0 +1,312 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_pipeline.h
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#ifndef OJPH_PIPELINE_H
+#define OJPH_PIPELINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ojph_defs.h"
+#include "ojph_file.h"
+#include "ojph_mem.h"
+#include "ojph_img_io.h"
+
+namespace ojph
+{
+namespace pipeline
+{
+
+///////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////
+
+//************************************************************************/
+/** @brief A bounded queue between one producer thread and one consumer
+  *         thread
+  *
+  *  Items pass through a ring buffer without locking; a thread takes the
+  *  lock only to sleep when the queue is full, for push(), or empty, for
+  *  pop(), and the other thread takes it only to wake a sleeping thread.
+  *  T must be cheap to copy, such as a pointer.
+  */
+template<typename T>
+class spsc_queue
+{
+public:
+  spsc_queue() : head(0), tail(0), closed(false), waiting(false) {}
+
+  /**
+    *  @brief Empties and opens the queue; call when no thread uses it
+    *
+    *  @param capacity the number of items the queue can hold
+    */
+  void init(size_t capacity)
+  {
+    items.resize(capacity);
+    head.store(0);
+    tail.store(0);
+    closed.store(false);
+    waiting.store(false);
+  }
+
+  /**
+    *  @brief Adds an item, waiting while the queue is full
+    *
+    *  @return false if the queue was closed, in which case the item is
+    *          not added
+    */
+  bool push(const T& item)
+  {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load() == items.size())
+      if (!wait_for(true))
+        return false;
+    if (closed.load())
+      return false;
+    items[t % items.size()] = item;
+    tail.store(t + 1);
+    wake();
+    return true;
+  }
+
+  /**
+    *  @brief Takes the oldest item, waiting while the queue is empty
+    *
+    *  @return false if the queue is closed and empty
+    */
+  bool pop(T& item)
+  {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (tail.load() == h)
+      if (!wait_for(false))
+        return false;
+    item = items[h % items.size()];
+    head.store(h + 1);
+    wake();
+    return true;
+  }
+
+  /**
+    *  @brief Closes the queue and wakes both threads; items already in
+    *         the queue can still be taken
+    */
+  void close()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed.store(true);
+    condition.notify_all();
+  }
+
+private:
+  // waits for space (for_space is true) or for an item; returns false
+  // when the queue is closed and the wait cannot succeed
+  bool wait_for(bool for_space)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    waiting.store(true);
+    bool ready = false;
+    condition.wait(lock, [&] {
+      size_t h = head.load(), t = tail.load();
+      ready = for_space ? (t - h < items.size()) : (t != h);
+      return ready || closed.load();
+    });
+    waiting.store(false);
+    return ready;
+  }
+
+  // wakes the other thread if it sleeps; the sequentially-consistent
+  // accesses to waiting, head and tail ensure that a wake-up is not lost
+  void wake()
+  {
+    if (waiting.load())
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      condition.notify_all();
+    }
+  }
+
+private:
+  std::vector<T> items;
+  std::atomic<size_t> head;           //!<number of items taken
+  std::atomic<size_t> tail;           //!<number of items added
+  std::atomic<bool> closed;
+  std::atomic<bool> waiting;          //!<a thread sleeps, or is about to
+  std::mutex mutex;
+  std::condition_variable condition;
+};
+
+//************************************************************************/
+/** @brief Reads the lines of an image ahead, on a thread of its own
+  *
+  *  The reader thread calls the read() function of an image reader, which
+  *  reads the file and converts samples, and fills batches of lines in
+  *  the order in which the encoder asks for them.  read() then copies a
+  *  line from a filled batch, so that reading overlaps encoding.  The
+  *  batches are kept for the next image.
+  */
+class line_reader : public image_in_base
+{
+public:
+  line_reader() : source(NULL), num_comps(0), planar(false),
+                  max_width(0), cur(NULL), cur_idx(0) {}
+  virtual ~line_reader() { finish(); }
+
+  /**
+    *  @brief Starts the reader thread
+    *
+    *  @param source the image reader, already opened and configured
+    *  @param num_comps the number of components
+    *  @param height the number of lines of each component
+    *  @param max_width the number of samples in the widest line
+    *  @param planar true if the encoder takes all the lines of a
+    *         component before the next component, false if it takes
+    *         one line of each component in turn
+    */
+  void start(image_in_base *source, ui32 num_comps, const ui32 *height,
+             ui32 max_width, bool planar);
+
+  /**
+    *  @brief Copies the next line into line; errors of the reader thread
+    *         are rethrown here
+    */
+  virtual ui32 read(const line_buf *line, ui32 comp_num);
+
+  /**
+    *  @brief Stops the reader thread, if running, and waits for it; this
+    *         must be called before the image reader is closed
+    */
+  void finish();
+
+private:
+  static const ui32 lines_per_batch = 16;
+  static const ui32 num_batches = 4;
+
+  struct batch {
+    batch() : num_lines(0) {}
+    ui32 num_lines;
+    line_buf lines[lines_per_batch];
+    ui32 comp_nums[lines_per_batch];
+    ui32 widths[lines_per_batch];     //!<samples read into each line
+    std::vector<si32> store;
+  };
+
+  void run();
+
+private:
+  image_in_base *source;
+  ui32 num_comps;
+  std::vector<ui32> height;
+  bool planar;
+  ui32 max_width;
+  batch batches[num_batches];
+  spsc_queue<batch*> filled;          //!<from the reader thread
+  spsc_queue<batch*> empty;           //!<to the reader thread
+  batch *cur;                         //!<the batch being copied from
+  ui32 cur_idx;                       //!<the next line in cur
+  std::exception_ptr error;           //!<set by the reader thread
+  std::thread thread;
+};
+
+//************************************************************************/
+/** @brief Writes a codestream to a file on a thread of its own
+  *
+  *  write() copies the data into chunks, and full chunks are written by
+  *  the writer thread, so that the file system does not hold up the
+  *  encoder.  The chunks are kept for the next file.
+  */
+class async_outfile : public outfile_base
+{
+public:
+  async_outfile() : fh(NULL), fname(NULL), cur(NULL), total(0), failed(false) {}
+  ~async_outfile() override { abort(); }
+
+  void open(const char *filename);
+  size_t write(const void *ptr, size_t size) override;
+  si64 tell() override { return total; }
+
+  /**
+    *  @brief Passes the data written so far to the writer thread
+    */
+  void flush() override;
+
+  /**
+    *  @brief Waits until all the data is written, and closes the file
+    */
+  void close() override;
+
+  /**
+    *  @brief Stops the writer thread and closes the file, without
+    *         reporting errors; use after a failure
+    */
+  void abort();
+
+private:
+  static const size_t chunk_size = 1 << 20;
+  static const ui32 num_chunks = 4;
+
+  struct chunk {
+    chunk() : used(0) {}
+    size_t used;
+    std::vector<ui8> data;
+  };
+
+  void run();
+
+private:
+  FILE *fh;
+  const char *fname;
+  chunk chunks[num_chunks];
+  spsc_queue<chunk*> full;            //!<to the writer thread
+  spsc_queue<chunk*> empty;           //!<from the writer thread
+  chunk *cur;                         //!<the chunk being filled
+  si64 total;                         //!<bytes written so far
+  std::atomic<bool> failed;           //!<set by the writer thread
+  std::thread thread;
+};
+
+} // !pipeline namespace
+} // !ojph namespace
+
+#endif // !OJPH_PIPELINE_H
@@ -0,0 +1,727 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_bench.cpp
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+// Encodes and decodes synthetic images in memory, repeatedly, and reports
+// throughput, per-frame latency percentiles and the peak memory of the
+// process.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+  #include <windows.h>
+  #include <psapi.h>
+#else
+  #include <sys/resource.h>
+#endif
+
+#include "ojph_arch.h"
+#include "ojph_arg.h"
+#include "ojph_mem.h"
+#include "ojph_file.h"
+#include "ojph_codestream.h"
+#include "ojph_executor.h"
+#include "ojph_params.h"
+#include "ojph_message.h"
+#include "ojph_trace.h"
+
+/////////////////////////////////////////////////////////////////////////////
+struct size_interpreter : public ojph::cli_interpreter::arg_inter_base
+{
+  size_interpreter(ojph::size& val) : val(val) {}
+  virtual void operate(const char *str)
+  {
+    const char *next_char = str;
+    if (*next_char != '{')
+      throw "size must start with {";
+    next_char++;
+    char *endptr;
+    val.w = (ojph::ui32)strtoul(next_char, &endptr, 10);
+    if (endptr == next_char)
+      throw "size number is improperly formatted";
+    next_char = endptr;
+    if (*next_char != ',')
+      throw "size must have a "","" between the two numbers";
+    next_char++;
+    val.h = (ojph::ui32)strtoul(next_char, &endptr, 10);
+    if (endptr == next_char)
+      throw "number is improperly formatted";
+    next_char = endptr;
+    if (*next_char != '}')
+      throw "size must end with }";
+    next_char++;
+    if (*next_char != '\0') //must be end of string
+      throw "size has extra characters";
+  }
+  ojph::size& val;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// everything that defines a benchmark run
+struct bench_config
+{
+  bench_config()
+  : dims(1920, 1080), tile_size(0, 0), block_size(64, 64),
+    num_comps(3), bit_depth(8), noise_bits(4), num_decompositions(5),
+    reversible(true), quantization_step(-1.0f), colour_transform(true),
+    iterations(20), warmup(2), num_threads(0)
+  {}
+
+  ojph::size dims;
+  ojph::size tile_size;          // (0, 0) for a single tile
+  ojph::size block_size;
+  ojph::ui32 num_comps;
+  ojph::ui32 bit_depth;
+  ojph::ui32 noise_bits;         // entropy of the noise added to samples
+  ojph::ui32 num_decompositions;
+  bool reversible;
+  float quantization_step;       // -1 for the library's default
+  bool colour_transform;         // only used with 3 or more components
+  ojph::ui32 iterations;
+  ojph::ui32 warmup;
+  ojph::ui32 num_threads;        // 0 for no executor
+};
+
+/////////////////////////////////////////////////////////////////////////////
+static bool apply_preset(const char* name, bench_config& cfg)
+{
+  cfg = bench_config();
+  if (strcmp(name, "lossless") == 0)
+    ; // the defaults
+  else if (strcmp(name, "lossy") == 0)
+  {
+    cfg.reversible = false;
+    cfg.quantization_step = 1.0f / 256.0f;
+  }
+  else if (strcmp(name, "video4k") == 0)
+  {
+    cfg.dims = ojph::size(3840, 2160);
+    cfg.bit_depth = 10;
+    cfg.noise_bits = 5;
+    cfg.reversible = false;
+    cfg.quantization_step = 1.0f / 1024.0f;
+    cfg.iterations = 30;
+  }
+  else if (strcmp(name, "gigapixel") == 0)
+  {
+    cfg.dims = ojph::size(32768, 32768);
+    cfg.tile_size = ojph::size(4096, 4096);
+    cfg.num_comps = 1;
+    cfg.iterations = 2;
+    cfg.warmup = 0;
+  }
+  else
+    return false;
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+static
+bool get_arguments(int argc, char *argv[], bench_config& cfg,
+                   char *&preset, bool& verify, char *&trace_name)
+{
+  ojph::cli_interpreter interpreter;
+  interpreter.init(argc, argv);
+
+  // the preset sets the defaults of all other options
+  interpreter.reinterpret("-preset", preset);
+  if (!apply_preset(preset, cfg)) {
+    printf("Unknown preset %s; use one of lossless, lossy, video4k or "
+           "gigapixel.\n", preset);
+    return false;
+  }
+  verify = true;
+
+  size_interpreter dims(cfg.dims);
+  size_interpreter tile_size(cfg.tile_size);
+  size_interpreter block_size(cfg.block_size);
+  interpreter.reinterpret("-dims", &dims);
+  interpreter.reinterpret("-tile_size", &tile_size);
+  interpreter.reinterpret("-block_size", &block_size);
+  interpreter.reinterpret("-num_comps", cfg.num_comps);
+  interpreter.reinterpret("-bit_depth", cfg.bit_depth);
+  interpreter.reinterpret("-noise_bits", cfg.noise_bits);
+  interpreter.reinterpret("-num_decomps", cfg.num_decompositions);
+  interpreter.reinterpret("-reversible", cfg.reversible);
+  interpreter.reinterpret("-qstep", cfg.quantization_step);
+  interpreter.reinterpret("-colour_trans", cfg.colour_transform);
+  interpreter.reinterpret("-iterations", cfg.iterations);
+  interpreter.reinterpret("-warmup", cfg.warmup);
+  interpreter.reinterpret("-num_threads", cfg.num_threads);
+  interpreter.reinterpret("-verify", verify);
+  interpreter.reinterpret("-trace", trace_name);
+
+  if (interpreter.is_exhausted() == false) {
+    printf("The following arguments were not interpreted:\n");
+    ojph::argument t = interpreter.get_argument_zero();
+    t = interpreter.get_next_avail_argument(t);
+    while (t.is_valid()) {
+      printf("%s\n", t.arg);
+      t = interpreter.get_next_avail_argument(t);
+    }
+    return false;
+  }
+
+  if (cfg.dims.w == 0 || cfg.dims.h == 0 || cfg.num_comps == 0 ||
+      cfg.num_comps > 16384 || cfg.bit_depth == 0 || cfg.bit_depth > 30 ||
+      cfg.iterations == 0)
+  {
+    printf("Image dimensions, the number of components, the bit depth, "
+           "and the number\nof iterations must be positive; bit depths "
+           "can be up to 30.\n");
+    return false;
+  }
+  if (cfg.noise_bits > cfg.bit_depth)
+    cfg.noise_bits = cfg.bit_depth;
+  if (!cfg.reversible)
+    verify = false;
+  return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+//
+//                          synthetic image source
+//
+//
+/////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////
+// The image is built from a pool of precomputed rows per component, so
+// that large images need little memory and producing a row costs no more
+// than a copy.  Each row is a smooth pattern, which wavelets compact
+// well, plus uniform noise of noise_bits bits, which they cannot; the
+// noise controls the entropy of the image.  The number of rows in the
+// pool is prime, so rows do not repeat with the period of codeblocks.
+class synthetic_image
+{
+public:
+  static const ojph::ui32 pool_rows = 67;
+
+  void init(const bench_config& cfg)
+  {
+    width = cfg.dims.w;
+    num_comps = cfg.num_comps;
+    rows.resize((size_t)num_comps * pool_rows * width);
+
+    ojph::ui32 state = 0x9E3779B9;
+    const double max_val = (double)((1u << cfg.bit_depth) - 1);
+    const double amplitude = max_val / 4.0;
+    const double two_pi = 6.283185307179586;
+    const ojph::si32 noise_range = 1 << cfg.noise_bits;
+    for (ojph::ui32 c = 0; c < num_comps; ++c)
+      for (ojph::ui32 r = 0; r < pool_rows; ++r)
+      {
+        ojph::si32 *dp = get_row(c, r);
+        double phase = two_pi * (r / (double)pool_rows + c / 7.0);
+        for (ojph::ui32 x = 0; x < width; ++x)
+        {
+          double v = max_val / 2.0 + amplitude *
+            (sin(two_pi * x / 509.0 + phase) + sin(two_pi * x / 61.0));
+          if (cfg.noise_bits) {
+            state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+            v += (double)((ojph::si32)(state % (ojph::ui32)noise_range)
+              - noise_range / 2);
+          }
+          v = v < 0.0 ? 0.0 : (v > max_val ? max_val : v);
+          dp[x] = (ojph::si32)v;
+        }
+      }
+  }
+
+  const ojph::si32* get_line(ojph::ui32 comp, ojph::ui32 y) const
+  { return rows.data() + ((size_t)comp * pool_rows + y % pool_rows) * width; }
+
+private:
+  ojph::si32* get_row(ojph::ui32 comp, ojph::ui32 r)
+  { return rows.data() + ((size_t)comp * pool_rows + r) * width; }
+
+  std::vector<ojph::si32> rows;
+  ojph::ui32 width;
+  ojph::ui32 num_comps;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+//
+//
+//                          encoding and decoding
+//
+//
+/////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////
+// collects the per-stage statistics, the trace events, and the memory
+// footprint of timed frames
+struct frame_probe
+{
+  frame_probe() : trace(NULL)
+  {
+    memset(&stats, 0, sizeof(stats));
+    memset(&memory, 0, sizeof(memory));
+    memset(&estimate, 0, sizeof(estimate));
+  }
+
+  // attaches the trace, if any, to a codestream before it is used
+  void attach(ojph::codestream& codestream)
+  {
+    if (trace)
+      codestream.set_trace_sink(trace);
+  }
+
+  // adds the per-stage statistics of a codestream that has finished, and
+  // keeps its memory footprint
+  void add(const ojph::codestream& codestream)
+  {
+    memory = codestream.get_memory_report();
+    const ojph::codestream_stats& cs = codestream.get_stats();
+    stats.enabled = cs.enabled;
+    for (ojph::ui32 i = 0; i < ojph::codestream_stats::NUM_STAGES; ++i)
+    {
+      stats.time_ns[i] += cs.time_ns[i];
+      stats.num_calls[i] += cs.num_calls[i];
+    }
+  }
+
+  ojph::codestream_stats stats;
+  ojph::codestream_memory memory;
+  ojph::codestream_memory estimate; // only for decoding
+  ojph::trace_sink* trace;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// encodes a frame into out, and returns the size of its codestream; probe
+// is NULL for frames that are not timed, and exec is NULL for encoding in
+// the calling thread only
+static size_t encode_frame(const bench_config& cfg,
+                           const synthetic_image& img,
+                           ojph::mem_outfile& out,
+                           frame_probe* probe, ojph::executor* exec)
+{
+  ojph::codestream codestream;
+  if (probe)
+    probe->attach(codestream);
+  codestream.set_executor(exec);
+
+  ojph::param_siz siz = codestream.access_siz();
+  siz.set_image_extent(ojph::point(cfg.dims.w, cfg.dims.h));
+  siz.set_num_components(cfg.num_comps);
+  for (ojph::ui32 c = 0; c < cfg.num_comps; ++c)
+    siz.set_component(c, ojph::point(1, 1), cfg.bit_depth, false);
+  siz.set_image_offset(ojph::point(0, 0));
+  siz.set_tile_size(cfg.tile_size);
+  siz.set_tile_offset(ojph::point(0, 0));
+
+  ojph::param_cod cod = codestream.access_cod();
+  cod.set_num_decomposition(cfg.num_decompositions);
+  cod.set_block_dims(cfg.block_size.w, cfg.block_size.h);
+  cod.set_color_transform(cfg.colour_transform && cfg.num_comps >= 3);
+  cod.set_reversible(cfg.reversible);
+  if (!cfg.reversible && cfg.quantization_step > 0.0f)
+    codestream.access_qcd().set_irrev_quant(cfg.quantization_step);
+  codestream.set_planar(false);
+
+  out.open();
+  codestream.write_headers(&out);
+
+  ojph::ui32 next_comp;
+  ojph::line_buf* cur_line = codestream.exchange(NULL, next_comp);
+  for (ojph::ui32 y = 0; y < cfg.dims.h; ++y)
+    for (ojph::ui32 c = 0; c < cfg.num_comps; ++c)
+    {
+      memcpy(cur_line->i32, img.get_line(next_comp, y),
+        cfg.dims.w * sizeof(ojph::si32));
+      cur_line = codestream.exchange(cur_line, next_comp);
+    }
+
+  codestream.flush();
+  size_t codestream_bytes = (size_t)out.tell();
+  if (probe)
+    probe->add(codestream);
+  codestream.close();
+  return codestream_bytes;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// compares a decoded line with the source line; returns the number of
+// samples that differ
+static size_t compare_line(const ojph::line_buf* line, const ojph::si32* sp,
+                           ojph::ui32 width)
+{
+  size_t num_diffs = 0;
+  if ((line->flags & ojph::line_buf::LFT_INTEGER) == 0)
+    return width;
+  if (line->flags & ojph::line_buf::LFT_16BIT) {
+    for (ojph::ui32 x = 0; x < width; ++x)
+      num_diffs += line->i16[x] != sp[x];
+  }
+  else if (line->flags & ojph::line_buf::LFT_64BIT) {
+    for (ojph::ui32 x = 0; x < width; ++x)
+      num_diffs += line->i64[x] != sp[x];
+  }
+  else {
+    for (ojph::ui32 x = 0; x < width; ++x)
+      num_diffs += line->i32[x] != sp[x];
+  }
+  return num_diffs;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// decodes a frame; if img is not NULL, returns the number of decoded
+// samples that differ from those of img
+static size_t decode_frame(const bench_config& cfg,
+                           const std::vector<ojph::ui8>& data,
+                           const synthetic_image* img,
+                           frame_probe* probe, ojph::executor* exec)
+{
+  ojph::mem_infile in;
+  in.open(data.data(), data.size());
+
+  ojph::codestream codestream;
+  if (probe)
+    probe->attach(codestream);
+  codestream.read_headers(&in);
+  if (probe)
+    probe->estimate = codestream.estimate_memory(data.size());
+  codestream.set_executor(exec);
+  codestream.set_planar(false);
+  codestream.create();
+
+  size_t num_diffs = 0;
+  for (ojph::ui32 y = 0; y < cfg.dims.h; ++y)
+    for (ojph::ui32 c = 0; c < cfg.num_comps; ++c)
+    {
+      ojph::ui32 comp_num;
+      ojph::line_buf *line = codestream.pull(comp_num);
+      if (img)
+        num_diffs += compare_line(line, img->get_line(comp_num, y),
+          cfg.dims.w);
+    }
+
+  if (probe)
+    probe->add(codestream);
+  codestream.close();
+  return num_diffs;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+//
+//                          measurements
+//
+//
+/////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////
+// peak resident memory of the process, in bytes
+static size_t get_peak_memory()
+{
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS pmc;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    return (size_t)pmc.PeakWorkingSetSize;
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+  #ifdef __APPLE__
+    return (size_t)usage.ru_maxrss;         // in bytes
+  #else
+    return (size_t)usage.ru_maxrss * 1024;  // in kilobytes
+  #endif
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// the nearest-rank percentile p of sorted values
+static double percentile(const std::vector<double>& sorted, double p)
+{
+  size_t rank = (size_t)ceil(p * (double)sorted.size());
+  return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+/////////////////////////////////////////////////////////////////////////////
+static void report(const char* stage, const bench_config& cfg,
+                   std::vector<double>& times, size_t codestream_bytes)
+{
+  double total = 0.0;
+  for (size_t i = 0; i < times.size(); ++i)
+    total += times[i];
+  std::sort(times.begin(), times.end());
+
+  double pixels = (double)cfg.dims.w * (double)cfg.dims.h;
+  double raw_bytes = pixels * cfg.num_comps * ((cfg.bit_depth + 7) >> 3);
+  double frames = (double)times.size();
+  printf("%-8s %8zu %11.2f %11.2f %11.2f %9.2f %9.2f\n", stage,
+    times.size(), pixels * frames / total * 1e-6,
+    raw_bytes * frames / total * 1e-6,
+    (double)codestream_bytes * frames / total * 1e-6,
+    percentile(times, 0.5) * 1e3, percentile(times, 0.99) * 1e3);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// prints the per-frame time of each stage; only available when the library
+// is built with OJPH_ENABLE_STATS
+static void report_stats(const char* stage,
+                         const ojph::codestream_stats& stats,
+                         size_t frames)
+{
+  if (!stats.enabled || frames == 0)
+    return;
+  printf("\n%s stages, per frame:\n", stage);
+  printf("  %-16s %10s %12s\n", "stage", "ms", "calls");
+  for (ojph::ui32 i = 0; i < ojph::codestream_stats::NUM_STAGES; ++i)
+  {
+    if (stats.num_calls[i] == 0)
+      continue;
+    char name[32];
+    if (i >= ojph::codestream_stats::DWT)
+      snprintf(name, sizeof(name), "%s (res %u)",
+        ojph::codestream_stats::get_stage_name(i),
+        i - ojph::codestream_stats::DWT);
+    else
+      snprintf(name, sizeof(name), "%s",
+        ojph::codestream_stats::get_stage_name(i));
+    printf("  %-16s %10.3f %12.0f\n", name,
+      (double)stats.time_ns[i] * 1e-6 / (double)frames,
+      (double)stats.num_calls[i] / (double)frames);
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// a steady_clock time point in the nanoseconds of trace_sink::now_ns()
+static ojph::ui64 to_ns(std::chrono::steady_clock::time_point t)
+{
+  return (ojph::ui64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    t.time_since_epoch()).count();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+//
+//                          main
+//
+//
+/////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////
+int main(int argc, char *argv[]) {
+
+  char default_preset[] = "lossless";
+  char *preset = default_preset;
+  bench_config cfg;
+  bool verify = true;
+  char *trace_name = NULL;
+
+  if (argc <= 1) {
+    std::printf(
+    "\nThe following arguments are options:\n"
+    " -preset       lossless, lossy, video4k, or gigapixel; sets the\n"
+    "               defaults of all the options below (default lossless).\n"
+    "                 lossless:  1920x1080, 3 components, 8 bits, "
+    "reversible\n"
+    "                 lossy:     as lossless, but irreversible, with\n"
+    "                            qstep 1/256\n"
+    "                 video4k:   3840x2160, 3 components, 10 bits, "
+    "irreversible\n"
+    "                 gigapixel: 32768x32768, 1 component, 8 bits, "
+    "4096x4096\n"
+    "                            tiles, reversible\n"
+    " -dims         {width,height} of the synthetic image.\n"
+    " -num_comps    number of components.\n"
+    " -bit_depth    bit depth of the unsigned samples, up to 30.\n"
+    " -noise_bits   the number of bits of uniform noise added to a smooth\n"
+    "               pattern; 0 gives an easily compressed image, while\n"
+    "               the bit depth gives pure noise.\n"
+    " -tile_size    {width,height} of tiles; {0,0} for no tiling.\n"
+    " -block_size   {width,height} of codeblocks.\n"
+    " -num_decomps  number of wavelet decompositions.\n"
+    " -reversible   <true | false> reversible (lossless) coding.\n"
+    " -qstep        quantization step size for irreversible coding.\n"
+    " -colour_trans <true | false> employ the colour transform when the\n"
+    "               image has 3 or more components.\n"
+    " -iterations   number of timed frames for each of encoding and\n"
+    "               decoding.\n"
+    " -warmup       number of untimed frames run before the timed ones.\n"
+    " -num_threads  number of threads, in addition to the calling one,\n"
+    "               that encode and decode the codeblocks of each frame;\n"
+    "               the default, 0, uses the calling thread only.\n"
+    " -verify       <true | false> check that a decoded frame matches the\n"
+    "               source; only for reversible coding, where it is the\n"
+    "               default.\n"
+    " -trace        <string> records the timed frames into this file, in\n"
+    "               the Chrome trace JSON format, which can be opened in\n"
+    "               Perfetto (ui.perfetto.dev); the library must be built\n"
+    "               with OJPH_ENABLE_STATS for events within frames.\n"
+    "\nFrames are encoded to, and decoded from, memory.  Times are wall-"
+    "clock times\nper frame; throughput is reported in millions of pixels, "
+    "of uncompressed\nbytes, and of codestream bytes per second.\n\n");
+  }
+
+  try {
+    if (!get_arguments(argc, argv, cfg, preset, verify, trace_name))
+      return -1;
+
+    ojph::trace_sink trace;
+    frame_probe enc_probe, dec_probe;
+    if (trace_name)
+    {
+      if (!trace.open(trace_name))
+        OJPH_ERROR(0x000F0003, "Could not create trace file %s", trace_name);
+      trace.set_thread_name("main");
+      enc_probe.trace = dec_probe.trace = &trace;
+    }
+
+    synthetic_image img;
+    img.init(cfg);
+
+    ojph::thds::thread_pool pool;
+    ojph::thread_pool_executor executor(&pool);
+    ojph::executor* exec = NULL;
+    if (cfg.num_threads)
+    {
+      pool.set_trace_sink(trace_name ? &trace : NULL);
+      pool.init(cfg.num_threads);
+      exec = &executor;
+    }
+
+    printf("preset %s: %ux%u, %u component(s), %u bits, noise %u bits, ",
+      preset, cfg.dims.w, cfg.dims.h, cfg.num_comps, cfg.bit_depth,
+      cfg.noise_bits);
+    if (cfg.tile_size.w && cfg.tile_size.h)
+      printf("%ux%u tiles, ", cfg.tile_size.w, cfg.tile_size.h);
+    printf("%s", cfg.reversible ? "reversible" : "irreversible");
+    if (cfg.num_threads)
+      printf(", %u extra thread(s)", cfg.num_threads);
+    printf("\n");
+
+    // encoding; the encoded frame is kept for decoding
+    ojph::mem_outfile out;
+    std::vector<double> times;
+    size_t codestream_bytes = 0;
+    for (ojph::ui32 i = 0; i < cfg.warmup + cfg.iterations; ++i)
+    {
+      std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+      codestream_bytes = encode_frame(cfg, img, out,
+        i >= cfg.warmup ? &enc_probe : NULL, exec);
+      if (i >= cfg.warmup)
+        times.push_back(seconds_since(start));
+      if (i >= cfg.warmup && trace_name)
+        trace.add_event("encode frame", to_ns(start), trace.now_ns());
+    }
+    std::vector<ojph::ui8> data(out.get_data(),
+      out.get_data() + codestream_bytes);
+
+    double bpp = 8.0 * (double)codestream_bytes /
+      ((double)cfg.dims.w * (double)cfg.dims.h);
+    printf("codestream: %zu bytes per frame, %.3f bits per pixel\n\n",
+      codestream_bytes, bpp);
+    printf("%-8s %8s %11s %11s %11s %9s %9s\n", "stage", "frames",
+      "Mpixels/s", "MB/s", "j2c MB/s", "p50 ms", "p99 ms");
+    report("encode", cfg, times, codestream_bytes);
+
+    // decoding; the verification frame is not timed
+    size_t num_diffs = 0;
+    if (verify)
+      num_diffs = decode_frame(cfg, data, &img, NULL, exec);
+    times.clear();
+    for (ojph::ui32 i = 0; i < cfg.warmup + cfg.iterations; ++i)
+    {
+      std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+      decode_frame(cfg, data, NULL, i >= cfg.warmup ? &dec_probe : NULL,
+        exec);
+      if (i >= cfg.warmup)
+        times.push_back(seconds_since(start));
+      if (i >= cfg.warmup && trace_name)
+        trace.add_event("decode frame", to_ns(start), trace.now_ns());
+    }
+    report("decode", cfg, times, codestream_bytes);
+    report_stats("encode", enc_probe.stats, cfg.iterations);
+    report_stats("decode", dec_probe.stats, cfg.iterations);
+    trace.close();
+
+    const double MiB = 1024.0 * 1024.0;
+    printf("\npeak memory: %.1f MiB\n", (double)get_peak_memory() / MiB);
+    printf("codestream memory, encode: %.2f MiB fixed + %.2f MiB in %zu "
+      "elastic chunks\n", (double)enc_probe.memory.fixed_bytes / MiB,
+      (double)enc_probe.memory.elastic_bytes / MiB,
+      enc_probe.memory.num_elastic_chunks);
+    printf("codestream memory, decode: %.2f MiB fixed + %.2f MiB in %zu "
+      "elastic chunks\n", (double)dec_probe.memory.fixed_bytes / MiB,
+      (double)dec_probe.memory.elastic_bytes / MiB,
+      dec_probe.memory.num_elastic_chunks);
+    printf("  estimated before create(): %.2f MiB fixed + %.2f MiB "
+      "elastic\n", (double)dec_probe.estimate.fixed_bytes / MiB,
+      (double)dec_probe.estimate.elastic_bytes / MiB);
+    if (verify) {
+      if (num_diffs == 0)
+        printf("verification: decoded samples match the source\n");
+      else {
+        printf("verification: %zu decoded samples differ from the "
+               "source\n", num_diffs);
+        return 1;
+      }
+    }
+  }
+  catch (const std::exception& e)
+  {
+    const char *p = e.what();
+    if (strncmp(p, "ojph error", 10) != 0)
+      printf("%s\n", p);
+    exit(-1);
+  }
+  catch (const char *p)
+  {
+    printf("%s\n", p);
+    exit(-1);
+  }
+
+  return 0;
+}
@@ -38,6 +38,8 @@
 
 #include <ctime>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include "ojph_arg.h"
 #include "ojph_mem.h"
@@ -46,6 +48,8 @@
 #include "ojph_codestream.h"
 #include "ojph_params.h"
 #include "ojph_message.h"
+#include "ojph_batch.h"
+#include "ojph_pipeline.h"
 
 /////////////////////////////////////////////////////////////////////////////
 struct size_list_interpreter : public ojph::cli_interpreter::arg_inter_base
@@ -372,7 +376,10 @@ bool get_arguments(int argc, char *argv[], char *&input_filename,
                    ojph::ui32& num_bit_depths, ojph::ui32*& bit_depth,
                    ojph::ui32& num_is_signed, ojph::si32*& is_signed,
                    bool& tlm_marker, bool& tileparts_at_resolutions,
-                   bool& tileparts_at_components, char *&com_string)
+                   bool& tileparts_at_components, char *&com_string,
+                   bool& fixed_point, char *&list_filename,
+                   ojph::ui32& first_frame, ojph::ui32& num_frames,
+                   ojph::ui32& num_threads, bool& pipeline)
 {
   ojph::cli_interpreter interpreter;
   interpreter.init(argc, argv);
@@ -388,6 +395,12 @@ bool get_arguments(int argc, char *argv[], char *&input_filename,
   interpreter.reinterpret("-num_comps", num_comps);
   interpreter.reinterpret("-tlm_marker", tlm_marker);
   interpreter.reinterpret("-com", com_string);
+  interpreter.reinterpret("-fixed_point", fixed_point);
+  interpreter.reinterpret("-list", list_filename);
+  interpreter.reinterpret("-first_frame", first_frame);
+  interpreter.reinterpret("-num_frames", num_frames);
+  interpreter.reinterpret("-num_threads", num_threads);
+  interpreter.reinterpret("-pipeline", pipeline);
 
   size_interpreter block_interpreter(block_size);
   size_interpreter dims_interpreter(dims);
@@ -480,6 +493,806 @@ bool is_matching(const char *ref, const char *other)
   return true;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// The command-line settings, which apply to every image
+struct compress_settings
+{
+  char *prog_order;
+  char *profile_string;
+  char *com_string;
+  ojph::ui32 num_decompositions;
+  float quantization_step;
+  bool reversible;
+  int employ_color_transform;
+  int num_precincts;
+  ojph::size *precinct_size;
+  ojph::size block_size;
+  ojph::size dims;
+  ojph::size tile_size;
+  ojph::point tile_offset;
+  ojph::point image_offset;
+  ojph::ui32 num_components;
+  ojph::ui32 num_is_signed;
+  ojph::si32 *is_signed;
+  ojph::ui32 num_bit_depths;
+  ojph::ui32 *bit_depth;
+  ojph::ui32 num_comp_downsamps;
+  ojph::point *comp_downsampling;
+  bool tlm_marker;
+  bool tileparts_at_resolutions;
+  bool tileparts_at_components;
+  bool fixed_point;
+  bool pipeline;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// One reader for each supported file type
+struct image_readers
+{
+  void close()
+  {
+    ppm.close(); pfm.close(); yuv.close(); raw.close(); dpx.close();
+    v210.close(); p010.close();
+#ifdef OJPH_ENABLE_TIFF_SUPPORT
+    tif.close();
+#endif // !OJPH_ENABLE_TIFF_SUPPORT
+  }
+
+  ojph::ppm_in ppm;
+  ojph::pfm_in pfm;
+  ojph::yuv_in yuv;
+  ojph::raw_in raw;
+  ojph::dpx_in dpx;
+  ojph::v210_in v210;
+  ojph::p010_in p010;
+#ifdef OJPH_ENABLE_TIFF_SUPPORT
+  ojph::tif_in tif;
+#endif // !OJPH_ENABLE_TIFF_SUPPORT
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// A reader thread ahead of the encoder and a writer thread behind it
+struct pipeline_stages
+{
+  ojph::pipeline::line_reader reader;
+  ojph::pipeline::async_outfile writer;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Compresses one image; codestream must be new or restarted.  The image
+// is read, encoded and written on three threads if stages is not NULL,
+// or on the calling thread otherwise; the codestream is the same.
+static
+void compress_image(const compress_settings& s, const char *input_filename,
+                    const char *output_filename,
+                    ojph::codestream& codestream, image_readers& readers,
+                    pipeline_stages *stages,
+                    ojph::batch::image_stats& stats)
+{
+  ojph::ppm_in& ppm = readers.ppm;
+  ojph::pfm_in& pfm = readers.pfm;
+  ojph::yuv_in& yuv = readers.yuv;
+  ojph::raw_in& raw = readers.raw;
+  ojph::dpx_in& dpx = readers.dpx;
+  ojph::v210_in& v210 = readers.v210;
+  ojph::p010_in& p010 = readers.p010;
+#ifdef OJPH_ENABLE_TIFF_SUPPORT
+  ojph::tif_in& tif = readers.tif;
+#endif // !OJPH_ENABLE_TIFF_SUPPORT
+
+  ojph::image_in_base *base = NULL;
+  const char *v = get_file_extension(input_filename);
+
+  if (v)
+  {
+    if (is_matching(".pgm", v))
+    {
+      ppm.open(input_filename);
+      ojph::param_siz siz = codestream.access_siz();
+      siz.set_image_extent(ojph::point(s.image_offset.x + ppm.get_width(),
+        s.image_offset.y + ppm.get_height()));
+      ojph::ui32 num_comps = ppm.get_num_components();
+      assert(num_comps == 1);
+      siz.set_num_components(num_comps);
+      for (ojph::ui32 c = 0; c < num_comps; ++c)
+        siz.set_component(c, ppm.get_comp_subsampling(c),
+          ppm.get_bit_depth(c), ppm.get_is_signed(c));
+      siz.set_image_offset(s.image_offset);
+      siz.set_tile_size(s.tile_size);
+      siz.set_tile_offset(s.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(s.num_decompositions);
+      cod.set_block_dims(s.block_size.w, s.block_size.h);
+      if (s.num_precincts != -1)
+        cod.set_precinct_size(s.num_precincts, s.precinct_size);
+      cod.set_progression_order(s.prog_order);
+      cod.set_color_transform(false);
+      cod.set_reversible(s.reversible);
+      if (!s.reversible && s.quantization_step != -1.0f)
+        codestream.access_qcd().set_irrev_quant(s.quantization_step);
+      if (s.profile_string[0] != '\0')
+        codestream.set_profile(s.profile_string);
+      codestream.set_tilepart_divisions(s.tileparts_at_resolutions,
+                                        s.tileparts_at_components);
+      codestream.request_tlm_marker(s.tlm_marker);
+
+      if (s.employ_color_transform != -1)
+        OJPH_WARN(0x01000001,
+          "-colour_trans option is not needed and was not used\n");
+      if (s.dims.w != 0 || s.dims.h != 0)
+        OJPH_WARN(0x01000002,
+          "-dims option is not needed and was not used\n");
+      if (s.num_components != 0)
+        OJPH_WARN(0x01000003,
+          "-num_comps is not needed and was not used\n");
+      if (s.is_signed[0] != -1)
+        OJPH_WARN(0x01000004,
+          "-signed is not needed and was not used\n");
+      if (s.bit_depth[0] != 0)
+        OJPH_WARN(0x01000005,
+          "-bit_depth is not needed and was not used\n");
+      if (s.comp_downsampling[0].x != 0 || s.comp_downsampling[0].y != 0)
+        OJPH_WARN(0x01000006,
+          "-downsamp is not needed and was not used\n");
+
+      base = &ppm;
+    }
+    else if (is_matching(".ppm", v))
+    {
+      ppm.open(input_filename);
+      ojph::param_siz siz = codestream.access_siz();
+      siz.set_image_extent(ojph::point(s.image_offset.x + ppm.get_width(),
+        s.image_offset.y + ppm.get_height()));
+      ojph::ui32 num_comps = ppm.get_num_components();
+      assert(num_comps == 3);
+      siz.set_num_components(num_comps);
+      for (ojph::ui32 c = 0; c < num_comps; ++c)
+        siz.set_component(c, ppm.get_comp_subsampling(c),
+          ppm.get_bit_depth(c), ppm.get_is_signed(c));
+      siz.set_image_offset(s.image_offset);
+      siz.set_tile_size(s.tile_size);
+      siz.set_tile_offset(s.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(s.num_decompositions);
+      cod.set_block_dims(s.block_size.w, s.block_size.h);
+      if (s.num_precincts != -1)
+        cod.set_precinct_size(s.num_precincts, s.precinct_size);
+      cod.set_progression_order(s.prog_order);
+      if (s.employ_color_transform == -1)
+        cod.set_color_transform(true);
+      else
+        cod.set_color_transform(s.employ_color_transform == 1);
+      cod.set_reversible(s.reversible);
+      if (!s.reversible && s.quantization_step != -1.0f)
+        codestream.access_qcd().set_irrev_quant(s.quantization_step);
+      codestream.set_planar(false);
+      if (s.profile_string[0] != '\0')
+        codestream.set_profile(s.profile_string);
+      codestream.set_tilepart_divisions(s.tileparts_at_resolutions,
+                                        s.tileparts_at_components);
+      codestream.request_tlm_marker(s.tlm_marker);
+
+      if (s.dims.w != 0 || s.dims.h != 0)
+        OJPH_WARN(0x01000011,
+          "-dims option is not needed and was not used\n");
+      if (s.num_components != 0)
+        OJPH_WARN(0x01000012,
+          "-num_comps is not needed and was not used\n");
+      if (s.is_signed[0] != -1)
+        OJPH_WARN(0x01000013,
+          "-signed is not needed and was not used\n");
+      if (s.bit_depth[0] != 0)
+        OJPH_WARN(0x01000014,
+          "-bit_depth is not needed and was not used\n");
+      if (s.comp_downsampling[0].x != 0 || s.comp_downsampling[0].y != 0)
+        OJPH_WARN(0x01000015,
+          "-downsamp is not needed and was not used\n");
+
+      base = &ppm;
+    }
+    else if (is_matching(".pfm", v))
+    {
+      pfm.open(input_filename);
+      ojph::param_siz siz = codestream.access_siz();
+      siz.set_image_extent(ojph::point(s.image_offset.x + pfm.get_width(),
+        s.image_offset.y + pfm.get_height()));
+      ojph::ui32 num_comps = pfm.get_num_components();
+      assert(num_comps == 1 || num_comps == 3);
+      siz.set_num_components(num_comps);
+
+      // a local copy, because the settings are shared by all images
+      ojph::ui32 bit_depth[3];
+      for (ojph::ui32 c = 0; c < num_comps; ++c)
+        bit_depth[c] = s.bit_depth[c];
+      if (bit_depth[0] != 0)               // one was set
+        if (s.num_bit_depths < num_comps)  // but if not enough, repeat
+          for (ojph::ui32 c = s.num_bit_depths; c < num_comps; ++c)
+            bit_depth[c] = bit_depth[s.num_bit_depths - 1];
+
+      bool all_the_same = true;
+      if (num_comps == 3)
+        all_the_same = all_the_same 
+          && bit_depth[0] == bit_depth[1] 
+          && bit_depth[1] == bit_depth[2];
+
+      for (ojph::ui32 c = 0; c < num_comps; ++c) {
+        if (bit_depth[c] == 0)
+          bit_depth[c] = 32;
+        siz.set_component(c, ojph::point(1,1), bit_depth[c], true);
+      }
+      pfm.configure(bit_depth);
+
+      siz.set_image_offset(s.image_offset);
+      siz.set_tile_size(s.tile_size);
+      siz.set_tile_offset(s.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(s.num_decompositions);
+      cod.set_block_dims(s.block_size.w, s.block_size.h);
+      if (s.num_precincts != -1)
+        cod.set_precinct_size(s.num_precincts, s.precinct_size);
+      cod.set_progression_order(s.prog_order);
+      if (num_comps == 1)
+      {
+        if (s.employ_color_transform != -1)
+          OJPH_WARN(0x01000091,
+            "-colour_trans option is not needed and was not used; "
+            "this is because the image has one component only\n");
+      }
+      else
+      {
+        if (s.employ_color_transform == -1)
+          cod.set_color_transform(true);
+        else
+          cod.set_color_transform(s.employ_color_transform == 1);
+      }
+      cod.set_reversible(s.reversible);
+      if (!s.reversible) {
+        const float min_step = 1.0f / 16384.0f;
+        float quantization_step = s.quantization_step;
+        if (quantization_step == -1.0f)
+          quantization_step = min_step;
+        else
+          quantization_step = ojph_max(quantization_step, min_step);
+        codestream.access_qcd().set_irrev_quant(quantization_step);
+      }
+
+      // Note: Even if only ALL_COMPS is set to 
+      // OJPH_NLT_BINARY_COMPLEMENT_NLT, the library can decide if
+      // one ALL_COMPS NLT marker segment is needed, or multiple 
+      // per component NLT marker segments are needed (when the components
+      // have different bit depths or signedness).
+      // Of course for .pfm images all components should have the same
+      // bit depth and signedness.
+      ojph::param_nlt nlt = codestream.access_nlt();
+      if (all_the_same)
+        nlt.set_nonlinear_transform(ojph::param_nlt::ALL_COMPS, 
+          ojph::param_nlt::OJPH_NLT_BINARY_COMPLEMENT_NLT);
+      else
+        for (ojph::ui32 c = 0; c < num_comps; ++c)
+          nlt.set_nonlinear_transform(c, 
+            ojph::param_nlt::OJPH_NLT_BINARY_COMPLEMENT_NLT);
+
+      codestream.set_planar(false);
+      if (s.profile_string[0] != '\0')
+        codestream.set_profile(s.profile_string);
+      codestream.set_tilepart_divisions(s.tileparts_at_resolutions,
+                                        s.tileparts_at_components);
+      codestream.request_tlm_marker(s.tlm_marker);
+
+      if (s.dims.w != 0 || s.dims.h != 0)
+        OJPH_WARN(0x01000092,
+          "-dims option is not needed and was not used\n");
+      if (s.num_components != 0)
+        OJPH_WARN(0x01000093,
+          "-num_comps is not needed and was not used\n");
+      if (s.is_signed[0] != -1)
+        OJPH_WARN(0x01000094,
+          "-signed is not needed and was not used\n");            
+      if (s.comp_downsampling[0].x != 0 || s.comp_downsampling[0].y != 0)
+        OJPH_WARN(0x01000095,
+          "-downsamp is not needed and was not used\n");
+
+      base = &pfm;
+    }
+#ifdef OJPH_ENABLE_TIFF_SUPPORT
+    else if (is_matching(".tif", v) || is_matching(".tiff", v))
+    {
+      tif.open(input_filename);
+      ojph::param_siz siz = codestream.access_siz();
+      siz.set_image_extent(ojph::point(s.image_offset.x + tif.get_size().w,
+        s.image_offset.y + tif.get_size().h));
+      ojph::ui32 num_comps = tif.get_num_components();
+      siz.set_num_components(num_comps);
+      if(s.num_bit_depths > 0 )
+        tif.set_bit_depth(s.num_bit_depths, s.bit_depth);
+      for (ojph::ui32 c = 0; c < num_comps; ++c)
+        siz.set_component(c, tif.get_comp_subsampling(c),
+          tif.get_bit_depth(c), tif.get_is_signed(c));
+      siz.set_image_offset(s.image_offset);
+      siz.set_tile_size(s.tile_size);
+      siz.set_tile_offset(s.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(s.num_decompositions);
+      cod.set_block_dims(s.block_size.w, s.block_size.h);
+      if (s.num_precincts != -1)
+        cod.set_precinct_size(s.num_precincts, s.precinct_size);
+      cod.set_progression_order(s.prog_order);
+      if (s.employ_color_transform == -1 && num_comps >= 3)
+        cod.set_color_transform(true);
+      else
+        cod.set_color_transform(s.employ_color_transform == 1);
+      cod.set_reversible(s.reversible);
+      if (!s.reversible && s.quantization_step != -1)
+        codestream.access_qcd().set_irrev_quant(s.quantization_step);
+      codestream.set_planar(false);
+      if (s.profile_string[0] != '\0')
+        codestream.set_profile(s.profile_string);
+      codestream.set_tilepart_divisions(s.tileparts_at_resolutions,
+                                        s.tileparts_at_components);
+      codestream.request_tlm_marker(s.tlm_marker);
+
+      if (s.dims.w != 0 || s.dims.h != 0)
+        OJPH_WARN(0x01000061,
+          "-dims option is not needed and was not used\n");
+      if (s.num_components != 0)
+        OJPH_WARN(0x01000062,
+          "-num_comps is not needed and was not used\n");
+      if (s.is_signed[0] != -1)
+        OJPH_WARN(0x01000063,
+          "-signed is not needed and was not used\n");
+      if (s.comp_downsampling[0].x != 0 || s.comp_downsampling[0].y != 0)
+        OJPH_WARN(0x01000065,
+          "-downsamp is not needed and was not used\n");
+
+      base = &tif;
+    }
+#endif // !OJPH_ENABLE_TIFF_SUPPORT
+    else if (is_matching(".yuv", v))
+    {
+      ojph::param_siz siz = codestream.access_siz();
+      if (s.dims.w == 0 || s.dims.h == 0)
+        OJPH_ERROR(0x01000021,
+          "-dims option must have positive dimensions\n");
+      siz.set_image_extent(ojph::point(s.image_offset.x + s.dims.w,
+        s.image_offset.y + s.dims.h));
+      if (s.num_components <= 0)
+        OJPH_ERROR(0x01000022,
+          "-num_comps option is missing and must be provided\n");
+      if (s.num_is_signed <= 0)
+        OJPH_ERROR(0x01000023,
+          "-signed option is missing and must be provided\n");
+      if (s.num_bit_depths <= 0)
+        OJPH_ERROR(0x01000024,
+          "-bit_depth option is missing and must be provided\n");
+      if (s.num_comp_downsamps <= 0)
+        OJPH_ERROR(0x01000025,
+          "-downsamp option is missing and must be provided\n");
+
+      yuv.set_img_props(s.dims, s.num_components, s.num_comp_downsamps,
+        s.comp_downsampling);
+      yuv.set_bit_depth(s.num_bit_depths, s.bit_depth);
+
+      ojph::ui32 last_signed_idx = 0, last_bit_depth_idx = 0;
+      ojph::ui32 last_downsamp_idx = 0;
+      siz.set_num_components(s.num_components);
+      for (ojph::ui32 c = 0; c < s.num_components; ++c)
+      {
+        ojph::point cp_ds = s.comp_downsampling
+            [c < s.num_comp_downsamps ? c : last_downsamp_idx];
+        last_downsamp_idx += last_downsamp_idx+1 < s.num_comp_downsamps ? 1:0;
+        ojph::ui32 bd =
+          s.bit_depth[c < s.num_bit_depths ? c : last_bit_depth_idx];
+        last_bit_depth_idx += last_bit_depth_idx + 1 < s.num_bit_depths ? 1:0;
+        int is = s.is_signed[c < s.num_is_signed ? c : last_signed_idx];
+        last_signed_idx += last_signed_idx + 1 < s.num_is_signed ? 1 : 0;
+        siz.set_component(c, cp_ds, bd, is == 1);
+      }
+      siz.set_image_offset(s.image_offset);
+      siz.set_tile_size(s.tile_size);
+      siz.set_tile_offset(s.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(s.num_decompositions);
+      cod.set_block_dims(s.block_size.w, s.block_size.h);
+      if (s.num_precincts != -1)
+        cod.set_precinct_size(s.num_precincts, s.precinct_size);
+      cod.set_progression_order(s.prog_order);
+      if (s.employ_color_transform == -1)
+        cod.set_color_transform(false);
+      else
+        OJPH_ERROR(0x01000031,
+          "We currently do not support color transform on raw(yuv) files."
+          " In any case, this not a normal usage scenario.  The OpenJPH "
+          "library however does support that, but ojph_compress.cpp must be "
+          "modified to send all lines from one component before moving to "
+          "the next component;  this requires buffering components outside"
+          " of the OpenJPH library");
+      cod.set_reversible(s.reversible);
+      if (!s.reversible && s.quantization_step != -1.0f)
+        codestream.access_qcd().set_irrev_quant(s.quantization_step);
+      codestream.set_planar(true);
+      if (s.profile_string[0] != '\0')
+        codestream.set_profile(s.profile_string);
+      codestream.set_tilepart_divisions(s.tileparts_at_resolutions,
+                                        s.tileparts_at_components);
+      codestream.request_tlm_marker(s.tlm_marker);
+
+      yuv.open(input_filename);
+      base = &yuv;
+    }
+    else if (is_matching(".raw", v))
+    {
+      ojph::param_siz siz = codestream.access_siz();
+      if (s.dims.w == 0 || s.dims.h == 0)
+        OJPH_ERROR(0x01000081,
+          "-dims option must have positive dimensions\n");
+      siz.set_image_extent(ojph::point(s.image_offset.x + s.dims.w,
+        s.image_offset.y + s.dims.h));
+      if (s.num_components != 1)
+        OJPH_ERROR(0x01000082,
+          "-num_comps must be 1\n");
+      if (s.num_is_signed <= 0)
+        OJPH_ERROR(0x01000083,
+          "-signed option is missing and must be provided\n");
+      if (s.num_bit_depths <= 0)
+        OJPH_ERROR(0x01000084,
+          "-bit_depth option is missing and must be provided\n");
+      if (s.num_comp_downsamps <= 0)
+        OJPH_ERROR(0x01000085,
+          "-downsamp option is missing and must be provided\n");
+
+      raw.set_img_props(s.dims, s.bit_depth[0], s.is_signed[0] != 0);
+
+      siz.set_num_components(s.num_components);
+      siz.set_component(0, s.comp_downsampling[0], s.bit_depth[0],
+        s.is_signed[0]);
+      siz.set_image_offset(s.image_offset);
+      siz.set_tile_size(s.tile_size);
+      siz.set_tile_offset(s.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(s.num_decompositions);
+      cod.set_block_dims(s.block_size.w, s.block_size.h);
+      if (s.num_precincts != -1)
+        cod.set_precinct_size(s.num_precincts, s.precinct_size);
+      cod.set_progression_order(s.prog_order);
+      if (s.employ_color_transform != -1)
+        OJPH_ERROR(0x01000086,
+          "color transform is meaningless since .raw files are single "
+          "component files");
+      cod.set_reversible(s.reversible);
+      if (!s.reversible && s.quantization_step != -1.0f)
+        codestream.access_qcd().set_irrev_quant(s.quantization_step);
+      codestream.set_planar(true);
+      if (s.profile_string[0] != '\0')
+        codestream.set_profile(s.profile_string);
+      codestream.set_tilepart_divisions(s.tileparts_at_resolutions,
+                                        s.tileparts_at_components);
+      codestream.request_tlm_marker(s.tlm_marker);
+
+      raw.open(input_filename);
+      base = &raw;
+    }
+    else if (is_matching(".v210", v))
+    {
+      ojph::param_siz siz = codestream.access_siz();
+      if (s.dims.w == 0 || s.dims.h == 0)
+        OJPH_ERROR(0x010000B1,
+          "-dims option must have positive dimensions\n");
+      if (s.image_offset.x & 1)
+        OJPH_ERROR(0x010000B2,
+          "-image_offset must be even horizontally for .v210 files, "
+          "since Cb and Cr are downsampled by 2");
+      siz.set_image_extent(ojph::point(s.image_offset.x + s.dims.w,
+        s.image_offset.y + s.dims.h));
+
+      v210.set_img_props(s.dims);
+
+      // Y, Cb and Cr, with Cb and Cr downsampled as the format requires
+      ojph::ui32 num_comps = v210.get_num_components();
+      siz.set_num_components(num_comps);
+      for (ojph::ui32 c = 0; c < num_comps; ++c)
+        siz.set_component(c, v210.get_comp_subsampling(c),
+          v210.get_bit_depth(), false);
+      siz.set_image_offset(s.image_offset);
+      siz.set_tile_size(s.tile_size);
+      siz.set_tile_offset(s.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(s.num_decompositions);
+      cod.set_block_dims(s.block_size.w, s.block_size.h);
+      if (s.num_precincts != -1)
+        cod.set_precinct_size(s.num_precincts, s.precinct_size);
+      cod.set_progression_order(s.prog_order);
+      if (s.employ_color_transform == 1)
+        OJPH_ERROR(0x010000B3,
+          "color transform cannot be used with .v210 files, because their "
+          "components are Y'CbCr with downsampled chroma");
+      cod.set_color_transform(false);
+      cod.set_reversible(s.reversible);
+      if (!s.reversible && s.quantization_step != -1.0f)
+        codestream.access_qcd().set_irrev_quant(s.quantization_step);
+      codestream.set_planar(false);
+      if (s.profile_string[0] != '\0')
+        codestream.set_profile(s.profile_string);
+      codestream.set_tilepart_divisions(s.tileparts_at_resolutions,
+                                        s.tileparts_at_components);
+      codestream.request_tlm_marker(s.tlm_marker);
+
+      if (s.num_components != 0)
+        OJPH_WARN(0x010000B4,
+          "-num_comps is not needed and was not used\n");
+      if (s.is_signed[0] != -1)
+        OJPH_WARN(0x010000B5,
+          "-signed is not needed and was not used\n");
+      if (s.num_bit_depths != 0)
+        OJPH_WARN(0x010000B6,
+          "-bit_depth is not needed and was not used\n");
+      if (s.comp_downsampling[0].x != 0 || s.comp_downsampling[0].y != 0)
+        OJPH_WARN(0x010000B7,
+          "-downsamp is not needed and was not used\n");
+
+      v210.open(input_filename);
+      base = &v210;
+    }
+    else if (is_matching(".p010", v))
+    {
+      ojph::param_siz siz = codestream.access_siz();
+      if (s.dims.w == 0 || s.dims.h == 0)
+        OJPH_ERROR(0x010000C1,
+          "-dims option must have positive dimensions\n");
+      if ((s.image_offset.x & 1) || (s.image_offset.y & 1))
+        OJPH_ERROR(0x010000C2,
+          "-image_offset must be even for .p010 files, since Cb and "
+          "Cr are downsampled by 2");
+      siz.set_image_extent(ojph::point(s.image_offset.x + s.dims.w,
+        s.image_offset.y + s.dims.h));
+
+      p010.set_img_props(s.dims);
+
+      // Y, Cb and Cr, with Cb and Cr downsampled as the format requires
+      ojph::ui32 num_comps = p010.get_num_components();
+      siz.set_num_components(num_comps);
+      for (ojph::ui32 c = 0; c < num_comps; ++c)
+        siz.set_component(c, p010.get_comp_subsampling(c),
+          p010.get_bit_depth(), false);
+      siz.set_image_offset(s.image_offset);
+      siz.set_tile_size(s.tile_size);
+      siz.set_tile_offset(s.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(s.num_decompositions);
+      cod.set_block_dims(s.block_size.w, s.block_size.h);
+      if (s.num_precincts != -1)
+        cod.set_precinct_size(s.num_precincts, s.precinct_size);
+      cod.set_progression_order(s.prog_order);
+      if (s.employ_color_transform == 1)
+        OJPH_ERROR(0x010000C3,
+          "color transform cannot be used with .p010 files, because their "
+          "components are Y'CbCr with downsampled chroma");
+      cod.set_color_transform(false);
+      cod.set_reversible(s.reversible);
+      if (!s.reversible && s.quantization_step != -1.0f)
+        codestream.access_qcd().set_irrev_quant(s.quantization_step);
+      codestream.set_planar(true);
+      if (s.profile_string[0] != '\0')
+        codestream.set_profile(s.profile_string);
+      codestream.set_tilepart_divisions(s.tileparts_at_resolutions,
+                                        s.tileparts_at_components);
+      codestream.request_tlm_marker(s.tlm_marker);
+
+      if (s.num_components != 0)
+        OJPH_WARN(0x010000C4,
+          "-num_comps is not needed and was not used\n");
+      if (s.is_signed[0] != -1)
+        OJPH_WARN(0x010000C5,
+          "-signed is not needed and was not used\n");
+      if (s.num_bit_depths != 0)
+        OJPH_WARN(0x010000C6,
+          "-bit_depth is not needed and was not used\n");
+      if (s.comp_downsampling[0].x != 0 || s.comp_downsampling[0].y != 0)
+        OJPH_WARN(0x010000C7,
+          "-downsamp is not needed and was not used\n");
+
+      p010.open(input_filename);
+      base = &p010;
+    }
+    else if (is_matching(".dpx", v))
+    {
+      dpx.open(input_filename);
+      ojph::param_siz siz = codestream.access_siz();
+      siz.set_image_extent(ojph::point(s.image_offset.x + dpx.get_size().w,
+        s.image_offset.y + dpx.get_size().h));
+      ojph::ui32 num_comps = dpx.get_num_components();
+      siz.set_num_components(num_comps);
+      //if (num_bit_depths > 0)
+      //  dpx.set_bit_depth(num_bit_depths, bit_depth);
+      for (ojph::ui32 c = 0; c < num_comps; ++c)
+        siz.set_component(c, dpx.get_comp_subsampling(c),
+          dpx.get_bit_depth(c), dpx.get_is_signed(c));
+      siz.set_image_offset(s.image_offset);
+      siz.set_tile_size(s.tile_size);
+      siz.set_tile_offset(s.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(s.num_decompositions);
+      cod.set_block_dims(s.block_size.w, s.block_size.h);
+      if (s.num_precincts != -1)
+        cod.set_precinct_size(s.num_precincts, s.precinct_size);
+      cod.set_progression_order(s.prog_order);
+      if (s.employ_color_transform == -1 && num_comps >= 3)
+        cod.set_color_transform(true);
+      else
+        cod.set_color_transform(s.employ_color_transform == 1);
+      cod.set_reversible(s.reversible);
+      if (!s.reversible && s.quantization_step != -1)
+        codestream.access_qcd().set_irrev_quant(s.quantization_step);
+      codestream.set_planar(false);
+      if (s.profile_string[0] != '\0')
+        codestream.set_profile(s.profile_string);
+      codestream.set_tilepart_divisions(s.tileparts_at_resolutions,
+        s.tileparts_at_components);
+      codestream.request_tlm_marker(s.tlm_marker);
+
+      if (s.dims.w != 0 || s.dims.h != 0)
+        OJPH_WARN(0x01000071,
+          "-dims option is not needed and was not used\n");
+      if (s.num_components != 0)
+        OJPH_WARN(0x01000072,
+          "-num_comps is not needed and was not used\n");
+      if (s.is_signed[0] != -1)
+        OJPH_WARN(0x01000073,
+          "-signed is not needed and was not used\n");
+      if (s.comp_downsampling[0].x != 0 || s.comp_downsampling[0].y != 0)
+        OJPH_WARN(0x01000075,
+          "-downsamp is not needed and was not used\n");
+
+      base = &dpx;
+    }
+    else
+#if defined( OJPH_ENABLE_TIFF_SUPPORT)
+      OJPH_ERROR(0x01000041,
+        "unknown input file extension; only pgm, ppm, dpx, tif(f),"
+        " v210, p010, or raw(yuv) are supported\n");
+#else
+      OJPH_ERROR(0x01000041,
+        "unknown input file extension; only pgm, ppm, dpx, v210,"
+        " p010, or raw(yuv) are supported\n");
+#endif // !OJPH_ENABLE_TIFF_SUPPORT 
+  }
+  else
+    OJPH_ERROR(0x01000051,
+      "Please supply a proper input filename with a proper three-letter "
+      "extension\n");
+
+  ojph::comment_exchange com_ex;
+  if (s.com_string)
+    com_ex.set_string(s.com_string);
+  codestream.set_irv_fixed_point(s.fixed_point);
+
+  // the number of lines of each component, in the order exchange() asks
+  // for them
+  ojph::param_siz siz = codestream.access_siz();
+  ojph::ui32 num_comps = siz.get_num_components();
+  std::vector<ojph::ui32> heights(num_comps);
+  for (ojph::ui32 c = 0; c < num_comps; ++c)
+  {
+    if (codestream.is_planar())
+    {
+      ojph::point p = siz.get_downsampling(c);
+      heights[c] = ojph_div_ceil(siz.get_image_extent().y, p.y);
+      heights[c] -= ojph_div_ceil(siz.get_image_offset().y, p.y);
+    }
+    else
+      heights[c] = siz.get_image_extent().y - siz.get_image_offset().y;
+  }
+
+  ojph::j2c_outfile j2c_file;
+  ojph::outfile_base *outfile = &j2c_file;
+  ojph::image_in_base *source = base;
+  if (stages)
+  {
+    stages->writer.open(output_filename);
+    outfile = &stages->writer;
+  }
+  else
+    j2c_file.open(output_filename);
+
+  try {
+    codestream.write_headers(outfile, &com_ex, s.com_string ? 1 : 0);
+    if (stages)
+    {
+      ojph::ui32 max_width =
+        siz.get_image_extent().x - siz.get_image_offset().x;
+      stages->reader.start(base, num_comps, heights.data(), max_width,
+                           codestream.is_planar());
+      source = &stages->reader;
+    }
+
+    ojph::ui32 next_comp;
+    ojph::line_buf* cur_line = codestream.exchange(NULL, next_comp);
+    if (codestream.is_planar())
+    {
+      for (ojph::ui32 c = 0; c < num_comps; ++c)
+      {
+        for (ojph::ui32 i = heights[c]; i > 0; --i)
+        {
+          assert(c == next_comp);
+          source->read(cur_line, next_comp);
+          cur_line = codestream.exchange(cur_line, next_comp);
+        }
+      }
+    }
+    else
+    {
+      for (ojph::ui32 i = 0; i < heights[0]; ++i)
+      {
+        for (ojph::ui32 c = 0; c < num_comps; ++c)
+        {
+          assert(c == next_comp);
+          source->read(cur_line, next_comp);
+          cur_line = codestream.exchange(cur_line, next_comp);
+        }
+      }
+    }
+
+    codestream.flush();
+    stats.coded_bytes = (ojph::ui64)outfile->tell();
+    for (ojph::ui32 c = 0; c < num_comps; ++c)
+      stats.num_samples += (ojph::ui64)siz.get_recon_width(c)
+                         * siz.get_recon_height(c);
+    if (stages)
+      stages->reader.finish();
+    codestream.close();
+  }
+  catch (...)
+  {
+    if (stages)
+    {
+      stages->reader.finish();
+      stages->writer.abort();
+    }
+    throw;
+  }
+  base->close();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Compresses the images of a batch, reusing its codestream and readers
+class compress_worker : public ojph::batch::worker
+{
+public:
+  compress_worker(const compress_settings& s) : s(s), first(true) {}
+
+  virtual void process(const char *input_filename, char *output_filename,
+                       ojph::batch::image_stats& stats)
+  {
+    if (!first)
+      codestream.restart();
+    first = false;
+    try {
+      compress_image(s, input_filename, output_filename, codestream,
+                     readers, s.pipeline ? &stages : NULL, stats);
+    }
+    catch (...)
+    {
+      readers.close();  // so that the next image can be opened
+      throw;
+    }
+  }
+
+private:
+  const compress_settings& s;
+  bool first;
+  ojph::codestream codestream;
+  image_readers readers;
+  pipeline_stages stages;  // destroyed before the readers
+};
+
 //////////////////////////////////////////////////////////////////////////////
 // main
 //////////////////////////////////////////////////////////////////////////////
@@ -521,14 +1334,22 @@ int main(int argc, char * argv[]) {
   bool tlm_marker = false;
   bool tileparts_at_resolutions = false;
   bool tileparts_at_components = false;
+  bool fixed_point = false;
+  char *list_filename = NULL;
+  ojph::ui32 first_frame = 0;
+  ojph::ui32 num_frames = 0;
+  ojph::ui32 num_threads = 0;
+  bool pipeline = true;
 
   if (argc <= 1) {
     std::cout <<
     "\nThe following arguments are necessary:\n"
 #ifdef OJPH_ENABLE_TIFF_SUPPORT
-    " -i input file name (either pgm, ppm, pfm, tif(f), or raw(yuv))\n"
+    " -i input file name (either pgm, ppm, pfm, tif(f), dpx, v210, p010,\n"
+    "    or raw(yuv))\n"
 #else
-    " -i input file name (either pgm, ppm, pfm, or raw(yuv))\n"
+    " -i input file name (either pgm, ppm, pfm, dpx, v210, p010, or\n"
+    "    raw(yuv))\n"
 #endif // !OJPH_ENABLE_TIFF_SUPPORT
     " -o output file name\n\n"
 
@@ -575,6 +1396,16 @@ int main(int argc, char * argv[]) {
     " -com          (None) if set, inserts a COM marker with the specified\n"
     "               string. If the string has spaces, please use\n"
     "               double quotes, as in -com \"This is a comment\".\n"
+    " -fixed_point  <true | false> if 'true', the irreversible path uses\n"
+    "               16-bit fixed-point arithmetic for components with a bit\n"
+    "               depth of 8 or less; this is faster, but the output is\n"
+    "               slightly different from the default floating-point\n"
+    "               path. Default value is false.\n"
+    " -pipeline     <true | false> if 'true', the image is read on one\n"
+    "               thread, encoded on another, and the codestream is\n"
+    "               written on a third, so that file access overlaps\n"
+    "               encoding; the codestream is the same either way.\n"
+    "               Default value is true.\n"
     "\n"
 
     "When the input file is a YUV file, these arguments need to be \n"
@@ -589,6 +1420,12 @@ int main(int argc, char * argv[]) {
     "            component; for example {1,1},{2,2},{2,2}\n\n"
     "\n"
 
+    ".v210 files hold 4:2:2 10-bit Y'CbCr, packed 6 pixels to 16 bytes,\n"
+    "and .p010 files hold 4:2:0 10-bit Y'CbCr, with a Y plane followed by\n"
+    "an interleaved CbCr plane.  Both are coded as three components with\n"
+    "Cb and Cr downsampled by {2,1} or {2,2}; only -dims is needed.\n"
+    "\n"
+
     ".pfm files receive special treatment. Currently, lossy compression\n"
     "with these files is not supported, only lossless. When these files are\n"
     "used, the NLT segment marker is automatically inserted into the\n"
@@ -612,7 +1449,18 @@ int main(int argc, char * argv[]) {
     "            are shifted to the right, keeping only the specified\n"
     "            number of bits. Up to 32 bits (which is the default) are\n"
     "            supported.\n"
+    "\n"
 
+    "Batch mode compresses many images in one run, on several threads;\n"
+    "each thread keeps its codestream and image reader objects from one\n"
+    "image to the next.  The aggregate throughput is reported at the end.\n"
+    " -num_frames  the number of images; -i and -o are then printf-style\n"
+    "              patterns with one integer conversion, such as\n"
+    "              -i in_%05d.dpx -o out_%05d.j2c\n"
+    " -first_frame (0) the number substituted for the first image\n"
+    " -list        a text file, where each line holds an input and an\n"
+    "              output file name; -i and -o are then not needed\n"
+    " -num_threads (number of CPUs) the number of threads\n"
     "\n";
     return -1;
   }
@@ -625,535 +1473,88 @@ int main(int argc, char * argv[]) {
                      num_comp_downsamps, comp_downsampling,
                      num_bit_depths, bit_depth, num_is_signed, is_signed,
                      tlm_marker, tileparts_at_resolutions,
-                     tileparts_at_components, com_string))
+                     tileparts_at_components, com_string, fixed_point,
+                     list_filename, first_frame, num_frames, num_threads,
+                     pipeline))
   {
     return -1;
   }
 
+  bool batch_mode = list_filename != NULL || num_frames != 0;
+  size_t num_failed = 0;
   clock_t begin = clock();
 
   try
   {
-    ojph::codestream codestream;
-
-    ojph::ppm_in ppm;
-    ojph::pfm_in pfm;
-    ojph::yuv_in yuv;
-    ojph::raw_in raw;
-    ojph::dpx_in dpx;
-#ifdef OJPH_ENABLE_TIFF_SUPPORT
-    ojph::tif_in tif;
-#endif // !OJPH_ENABLE_TIFF_SUPPORT
-
-    ojph::image_in_base *base = NULL;
-    if (input_filename == NULL)
+    if (list_filename != NULL && num_frames != 0)
+      OJPH_ERROR(0x010000A1, "-list and -num_frames cannot be used "
+        "together");
+    if (input_filename == NULL && list_filename == NULL)
       OJPH_ERROR(0x01000007, "please specify an input file name using"
         " the -i command line option");
-    if (output_filename == NULL)
+    if (output_filename == NULL && list_filename == NULL)
       OJPH_ERROR(0x01000008, "please specify an output file name using"
         " the -o command line option");
-    const char *v = get_file_extension(input_filename);
 
-    if (v)
+    compress_settings s;
+    s.prog_order = prog_order;
+    s.profile_string = profile_string;
+    s.com_string = com_string;
+    s.num_decompositions = num_decompositions;
+    s.quantization_step = quantization_step;
+    s.reversible = reversible;
+    s.employ_color_transform = employ_color_transform;
+    s.num_precincts = num_precincts;
+    s.precinct_size = precinct_size;
+    s.block_size = block_size;
+    s.dims = dims;
+    s.tile_size = tile_size;
+    s.tile_offset = tile_offset;
+    s.image_offset = image_offset;
+    s.num_components = num_components;
+    s.num_is_signed = num_is_signed;
+    s.is_signed = is_signed;
+    s.num_bit_depths = num_bit_depths;
+    s.bit_depth = bit_depth;
+    s.num_comp_downsamps = num_comp_downsamps;
+    s.comp_downsampling = comp_downsampling;
+    s.tlm_marker = tlm_marker;
+    s.tileparts_at_resolutions = tileparts_at_resolutions;
+    s.tileparts_at_components = tileparts_at_components;
+    s.fixed_point = fixed_point;
+    s.pipeline = pipeline;
+
+    if (batch_mode)
     {
-      if (is_matching(".pgm", v))
-      {
-        ppm.open(input_filename);
-        ojph::param_siz siz = codestream.access_siz();
-        siz.set_image_extent(ojph::point(image_offset.x + ppm.get_width(),
-          image_offset.y + ppm.get_height()));
-        ojph::ui32 num_comps = ppm.get_num_components();
-        assert(num_comps == 1);
-        siz.set_num_components(num_comps);
-        for (ojph::ui32 c = 0; c < num_comps; ++c)
-          siz.set_component(c, ppm.get_comp_subsampling(c),
-            ppm.get_bit_depth(c), ppm.get_is_signed(c));
-        siz.set_image_offset(image_offset);
-        siz.set_tile_size(tile_size);
-        siz.set_tile_offset(tile_offset);
-
-        ojph::param_cod cod = codestream.access_cod();
-        cod.set_num_decomposition(num_decompositions);
-        cod.set_block_dims(block_size.w, block_size.h);
-        if (num_precincts != -1)
-          cod.set_precinct_size(num_precincts, precinct_size);
-        cod.set_progression_order(prog_order);
-        cod.set_color_transform(false);
-        cod.set_reversible(reversible);
-        if (!reversible && quantization_step != -1.0f)
-          codestream.access_qcd().set_irrev_quant(quantization_step);
-        if (profile_string[0] != '\0')
-          codestream.set_profile(profile_string);
-        codestream.set_tilepart_divisions(tileparts_at_resolutions, 
-                                          tileparts_at_components);
-        codestream.request_tlm_marker(tlm_marker);
-
-        if (employ_color_transform != -1)
-          OJPH_WARN(0x01000001,
-            "-colour_trans option is not needed and was not used\n");
-        if (dims.w != 0 || dims.h != 0)
-          OJPH_WARN(0x01000002,
-            "-dims option is not needed and was not used\n");
-        if (num_components != 0)
-          OJPH_WARN(0x01000003,
-            "-num_comps is not needed and was not used\n");
-        if (is_signed[0] != -1)
-          OJPH_WARN(0x01000004,
-            "-signed is not needed and was not used\n");
-        if (bit_depth[0] != 0)
-          OJPH_WARN(0x01000005,
-            "-bit_depth is not needed and was not used\n");
-        if (comp_downsampling[0].x != 0 || comp_downsampling[0].y != 0)
-          OJPH_WARN(0x01000006,
-            "-downsamp is not needed and was not used\n");
-
-        base = &ppm;
-      }
-      else if (is_matching(".ppm", v))
-      {
-        ppm.open(input_filename);
-        ojph::param_siz siz = codestream.access_siz();
-        siz.set_image_extent(ojph::point(image_offset.x + ppm.get_width(),
-          image_offset.y + ppm.get_height()));
-        ojph::ui32 num_comps = ppm.get_num_components();
-        assert(num_comps == 3);
-        siz.set_num_components(num_comps);
-        for (ojph::ui32 c = 0; c < num_comps; ++c)
-          siz.set_component(c, ppm.get_comp_subsampling(c),
-            ppm.get_bit_depth(c), ppm.get_is_signed(c));
-        siz.set_image_offset(image_offset);
-        siz.set_tile_size(tile_size);
-        siz.set_tile_offset(tile_offset);
-
-        ojph::param_cod cod = codestream.access_cod();
-        cod.set_num_decomposition(num_decompositions);
-        cod.set_block_dims(block_size.w, block_size.h);
-        if (num_precincts != -1)
-          cod.set_precinct_size(num_precincts, precinct_size);
-        cod.set_progression_order(prog_order);
-        if (employ_color_transform == -1)
-          cod.set_color_transform(true);
-        else
-          cod.set_color_transform(employ_color_transform == 1);
-        cod.set_reversible(reversible);
-        if (!reversible && quantization_step != -1.0f)
-          codestream.access_qcd().set_irrev_quant(quantization_step);
-        codestream.set_planar(false);
-        if (profile_string[0] != '\0')
-          codestream.set_profile(profile_string);
-        codestream.set_tilepart_divisions(tileparts_at_resolutions, 
-                                          tileparts_at_components);
-        codestream.request_tlm_marker(tlm_marker);          
-
-        if (dims.w != 0 || dims.h != 0)
-          OJPH_WARN(0x01000011,
-            "-dims option is not needed and was not used\n");
-        if (num_components != 0)
-          OJPH_WARN(0x01000012,
-            "-num_comps is not needed and was not used\n");
-        if (is_signed[0] != -1)
-          OJPH_WARN(0x01000013,
-            "-signed is not needed and was not used\n");
-        if (bit_depth[0] != 0)
-          OJPH_WARN(0x01000014,
-            "-bit_depth is not needed and was not used\n");
-        if (comp_downsampling[0].x != 0 || comp_downsampling[0].y != 0)
-          OJPH_WARN(0x01000015,
-            "-downsamp is not needed and was not used\n");
-
-        base = &ppm;
-      }
-      else if (is_matching(".pfm", v))
-      {
-        pfm.open(input_filename);
-        ojph::param_siz siz = codestream.access_siz();
-        siz.set_image_extent(ojph::point(image_offset.x + pfm.get_width(),
-          image_offset.y + pfm.get_height()));
-        ojph::ui32 num_comps = pfm.get_num_components();
-        assert(num_comps == 1 || num_comps == 3);
-        siz.set_num_components(num_comps);
-
-        if (bit_depth[0] != 0)             // one was set
-          if (num_bit_depths < num_comps)  // but if not enough, repeat
-            for (ojph::ui32 c = num_bit_depths; c < num_comps; ++c)
-              bit_depth[c] = bit_depth[num_bit_depths - 1];
-
-        bool all_the_same = true;
-        if (num_comps == 3)
-          all_the_same = all_the_same 
-            && bit_depth[0] == bit_depth[1] 
-            && bit_depth[1] == bit_depth[2];
-
-        for (ojph::ui32 c = 0; c < num_comps; ++c) {
-          if (bit_depth[c] == 0)
-            bit_depth[c] = 32;
-          siz.set_component(c, ojph::point(1,1), bit_depth[c], true);
-        }
-        pfm.configure(bit_depth);
-
-        siz.set_image_offset(image_offset);
-        siz.set_tile_size(tile_size);
-        siz.set_tile_offset(tile_offset);
-
-        ojph::param_cod cod = codestream.access_cod();
-        cod.set_num_decomposition(num_decompositions);
-        cod.set_block_dims(block_size.w, block_size.h);
-        if (num_precincts != -1)
-          cod.set_precinct_size(num_precincts, precinct_size);
-        cod.set_progression_order(prog_order);
-        if (num_comps == 1)
-        {
-          if (employ_color_transform != -1)
-            OJPH_WARN(0x01000091,
-              "-colour_trans option is not needed and was not used; "
-              "this is because the image has one component only\n");
-        }
-        else
-        {
-          if (employ_color_transform == -1)
-            cod.set_color_transform(true);
-          else
-            cod.set_color_transform(employ_color_transform == 1);
-        }
-        cod.set_reversible(reversible);
-        if (!reversible) {
-          const float min_step = 1.0f / 16384.0f;
-          if (quantization_step == -1.0f)
-            quantization_step = min_step;
-          else
-            quantization_step = ojph_max(quantization_step, min_step);
-          codestream.access_qcd().set_irrev_quant(quantization_step);
-        }
-
-        // Note: Even if only ALL_COMPS is set to 
-        // OJPH_NLT_BINARY_COMPLEMENT_NLT, the library can decide if
-        // one ALL_COMPS NLT marker segment is needed, or multiple 
-        // per component NLT marker segments are needed (when the components
-        // have different bit depths or signedness).
-        // Of course for .pfm images all components should have the same
-        // bit depth and signedness.
-        ojph::param_nlt nlt = codestream.access_nlt();
-        if (all_the_same)
-          nlt.set_nonlinear_transform(ojph::param_nlt::ALL_COMPS, 
-            ojph::param_nlt::OJPH_NLT_BINARY_COMPLEMENT_NLT);
-        else
-          for (ojph::ui32 c = 0; c < num_comps; ++c)
-            nlt.set_nonlinear_transform(c, 
-              ojph::param_nlt::OJPH_NLT_BINARY_COMPLEMENT_NLT);
-
-        codestream.set_planar(false);
-        if (profile_string[0] != '\0')
-          codestream.set_profile(profile_string);
-        codestream.set_tilepart_divisions(tileparts_at_resolutions, 
-                                          tileparts_at_components);
-        codestream.request_tlm_marker(tlm_marker);          
-
-        if (dims.w != 0 || dims.h != 0)
-          OJPH_WARN(0x01000092,
-            "-dims option is not needed and was not used\n");
-        if (num_components != 0)
-          OJPH_WARN(0x01000093,
-            "-num_comps is not needed and was not used\n");
-        if (is_signed[0] != -1)
-          OJPH_WARN(0x01000094,
-            "-signed is not needed and was not used\n");            
-        if (comp_downsampling[0].x != 0 || comp_downsampling[0].y != 0)
-          OJPH_WARN(0x01000095,
-            "-downsamp is not needed and was not used\n");
-
-        base = &pfm;
-      }
-#ifdef OJPH_ENABLE_TIFF_SUPPORT
-      else if (is_matching(".tif", v) || is_matching(".tiff", v))
-      {
-        tif.open(input_filename);
-        ojph::param_siz siz = codestream.access_siz();
-        siz.set_image_extent(ojph::point(image_offset.x + tif.get_size().w,
-          image_offset.y + tif.get_size().h));
-        ojph::ui32 num_comps = tif.get_num_components();
-        siz.set_num_components(num_comps);
-        if(num_bit_depths > 0 )
-          tif.set_bit_depth(num_bit_depths, bit_depth);
-        for (ojph::ui32 c = 0; c < num_comps; ++c)
-          siz.set_component(c, tif.get_comp_subsampling(c),
-            tif.get_bit_depth(c), tif.get_is_signed(c));
-        siz.set_image_offset(image_offset);
-        siz.set_tile_size(tile_size);
-        siz.set_tile_offset(tile_offset);
-
-        ojph::param_cod cod = codestream.access_cod();
-        cod.set_num_decomposition(num_decompositions);
-        cod.set_block_dims(block_size.w, block_size.h);
-        if (num_precincts != -1)
-          cod.set_precinct_size(num_precincts, precinct_size);
-        cod.set_progression_order(prog_order);
-        if (employ_color_transform == -1 && num_comps >= 3)
-          cod.set_color_transform(true);
-        else
-          cod.set_color_transform(employ_color_transform == 1);
-        cod.set_reversible(reversible);
-        if (!reversible && quantization_step != -1)
-          codestream.access_qcd().set_irrev_quant(quantization_step);
-        codestream.set_planar(false);
-        if (profile_string[0] != '\0')
-          codestream.set_profile(profile_string);
-        codestream.set_tilepart_divisions(tileparts_at_resolutions, 
-                                          tileparts_at_components);
-        codestream.request_tlm_marker(tlm_marker);
-
-        if (dims.w != 0 || dims.h != 0)
-          OJPH_WARN(0x01000061,
-            "-dims option is not needed and was not used\n");
-        if (num_components != 0)
-          OJPH_WARN(0x01000062,
-            "-num_comps is not needed and was not used\n");
-        if (is_signed[0] != -1)
-          OJPH_WARN(0x01000063,
-            "-signed is not needed and was not used\n");
-        if (comp_downsampling[0].x != 0 || comp_downsampling[0].y != 0)
-          OJPH_WARN(0x01000065,
-            "-downsamp is not needed and was not used\n");
-
-        base = &tif;
-      }
-#endif // !OJPH_ENABLE_TIFF_SUPPORT
-      else if (is_matching(".yuv", v))
-      {
-        ojph::param_siz siz = codestream.access_siz();
-        if (dims.w == 0 || dims.h == 0)
-          OJPH_ERROR(0x01000021,
-            "-dims option must have positive dimensions\n");
-        siz.set_image_extent(ojph::point(image_offset.x + dims.w,
-          image_offset.y + dims.h));
-        if (num_components <= 0)
-          OJPH_ERROR(0x01000022,
-            "-num_comps option is missing and must be provided\n");
-        if (num_is_signed <= 0)
-          OJPH_ERROR(0x01000023,
-            "-signed option is missing and must be provided\n");
-        if (num_bit_depths <= 0)
-          OJPH_ERROR(0x01000024,
-            "-bit_depth option is missing and must be provided\n");
-        if (num_comp_downsamps <= 0)
-          OJPH_ERROR(0x01000025,
-            "-downsamp option is missing and must be provided\n");
-
-        yuv.set_img_props(dims, num_components, num_comp_downsamps,
-          comp_downsampling);
-        yuv.set_bit_depth(num_bit_depths, bit_depth);
-
-        ojph::ui32 last_signed_idx = 0, last_bit_depth_idx = 0;
-        ojph::ui32 last_downsamp_idx = 0;
-        siz.set_num_components(num_components);
-        for (ojph::ui32 c = 0; c < num_components; ++c)
-        {
-          ojph::point cp_ds = comp_downsampling
-              [c < num_comp_downsamps ? c : last_downsamp_idx];
-          last_downsamp_idx += last_downsamp_idx+1 < num_comp_downsamps ? 1:0;
-          ojph::ui32 bd = bit_depth[c<num_bit_depths ? c : last_bit_depth_idx];
-          last_bit_depth_idx += last_bit_depth_idx + 1 < num_bit_depths ? 1:0;
-          int is = is_signed[c < num_is_signed ? c : last_signed_idx];
-          last_signed_idx += last_signed_idx + 1 < num_is_signed ? 1 : 0;
-          siz.set_component(c, cp_ds, bd, is == 1);
-        }
-        siz.set_image_offset(image_offset);
-        siz.set_tile_size(tile_size);
-        siz.set_tile_offset(tile_offset);
-
-        ojph::param_cod cod = codestream.access_cod();
-        cod.set_num_decomposition(num_decompositions);
-        cod.set_block_dims(block_size.w, block_size.h);
-        if (num_precincts != -1)
-          cod.set_precinct_size(num_precincts, precinct_size);
-        cod.set_progression_order(prog_order);
-        if (employ_color_transform == -1)
-          cod.set_color_transform(false);
-        else
-          OJPH_ERROR(0x01000031,
-            "We currently do not support color transform on raw(yuv) files."
-            " In any case, this not a normal usage scenario.  The OpenJPH "
-            "library however does support that, but ojph_compress.cpp must be "
-            "modified to send all lines from one component before moving to "
-            "the next component;  this requires buffering components outside"
-            " of the OpenJPH library");
-        cod.set_reversible(reversible);
-        if (!reversible && quantization_step != -1.0f)
-          codestream.access_qcd().set_irrev_quant(quantization_step);
-        codestream.set_planar(true);
-        if (profile_string[0] != '\0')
-          codestream.set_profile(profile_string);
-        codestream.set_tilepart_divisions(tileparts_at_resolutions, 
-                                          tileparts_at_components);
-        codestream.request_tlm_marker(tlm_marker);          
-
-        yuv.open(input_filename);
-        base = &yuv;
-      }
-      else if (is_matching(".raw", v))
-      {
-        ojph::param_siz siz = codestream.access_siz();
-        if (dims.w == 0 || dims.h == 0)
-          OJPH_ERROR(0x01000081,
-            "-dims option must have positive dimensions\n");
-        siz.set_image_extent(ojph::point(image_offset.x + dims.w,
-          image_offset.y + dims.h));
-        if (num_components != 1)
-          OJPH_ERROR(0x01000082,
-            "-num_comps must be 1\n");
-        if (num_is_signed <= 0)
-          OJPH_ERROR(0x01000083,
-            "-signed option is missing and must be provided\n");
-        if (num_bit_depths <= 0)
-          OJPH_ERROR(0x01000084,
-            "-bit_depth option is missing and must be provided\n");
-        if (num_comp_downsamps <= 0)
-          OJPH_ERROR(0x01000085,
-            "-downsamp option is missing and must be provided\n");
-
-        raw.set_img_props(dims, bit_depth[0], is_signed);
-
-        siz.set_num_components(num_components);
-        siz.set_component(0, comp_downsampling[0], bit_depth[0], is_signed[0]);
-        siz.set_image_offset(image_offset);
-        siz.set_tile_size(tile_size);
-        siz.set_tile_offset(tile_offset);
-
-        ojph::param_cod cod = codestream.access_cod();
-        cod.set_num_decomposition(num_decompositions);
-        cod.set_block_dims(block_size.w, block_size.h);
-        if (num_precincts != -1)
-          cod.set_precinct_size(num_precincts, precinct_size);
-        cod.set_progression_order(prog_order);
-        if (employ_color_transform != -1)
-          OJPH_ERROR(0x01000086,
-            "color transform is meaningless since .raw files are single "
-            "component files");
-        cod.set_reversible(reversible);
-        if (!reversible && quantization_step != -1.0f)
-          codestream.access_qcd().set_irrev_quant(quantization_step);
-        codestream.set_planar(true);
-        if (profile_string[0] != '\0')
-          codestream.set_profile(profile_string);
-        codestream.set_tilepart_divisions(tileparts_at_resolutions, 
-                                          tileparts_at_components);
-        codestream.request_tlm_marker(tlm_marker);
-
-        raw.open(input_filename);
-        base = &raw;
-      }
-      else if (is_matching(".dpx", v))
-      {
-        dpx.open(input_filename);
-        ojph::param_siz siz = codestream.access_siz();
-        siz.set_image_extent(ojph::point(image_offset.x + dpx.get_size().w,
-          image_offset.y + dpx.get_size().h));
-        ojph::ui32 num_comps = dpx.get_num_components();
-        siz.set_num_components(num_comps);
-        //if (num_bit_depths > 0)
-        //  dpx.set_bit_depth(num_bit_depths, bit_depth);
-        for (ojph::ui32 c = 0; c < num_comps; ++c)
-          siz.set_component(c, dpx.get_comp_subsampling(c),
-            dpx.get_bit_depth(c), dpx.get_is_signed(c));
-        siz.set_image_offset(image_offset);
-        siz.set_tile_size(tile_size);
-        siz.set_tile_offset(tile_offset);
-
-        ojph::param_cod cod = codestream.access_cod();
-        cod.set_num_decomposition(num_decompositions);
-        cod.set_block_dims(block_size.w, block_size.h);
-        if (num_precincts != -1)
-          cod.set_precinct_size(num_precincts, precinct_size);
-        cod.set_progression_order(prog_order);
-        if (employ_color_transform == -1 && num_comps >= 3)
-          cod.set_color_transform(true);
-        else
-          cod.set_color_transform(employ_color_transform == 1);
-        cod.set_reversible(reversible);
-        if (!reversible && quantization_step != -1)
-          codestream.access_qcd().set_irrev_quant(quantization_step);
-        codestream.set_planar(false);
-        if (profile_string[0] != '\0')
-          codestream.set_profile(profile_string);
-        codestream.set_tilepart_divisions(tileparts_at_resolutions,
-          tileparts_at_components);
-        codestream.request_tlm_marker(tlm_marker);
-
-        if (dims.w != 0 || dims.h != 0)
-          OJPH_WARN(0x01000071,
-            "-dims option is not needed and was not used\n");
-        if (num_components != 0)
-          OJPH_WARN(0x01000072,
-            "-num_comps is not needed and was not used\n");
-        if (is_signed[0] != -1)
-          OJPH_WARN(0x01000073,
-            "-signed is not needed and was not used\n");
-        if (comp_downsampling[0].x != 0 || comp_downsampling[0].y != 0)
-          OJPH_WARN(0x01000075,
-            "-downsamp is not needed and was not used\n");
-
-        base = &dpx;
-      }
+      ojph::batch::job_list jobs;
+      if (list_filename)
+        jobs.init_from_file(list_filename);
       else
-#if defined( OJPH_ENABLE_TIFF_SUPPORT)
-        OJPH_ERROR(0x01000041,
-          "unknown input file extension; only pgm, ppm, dpx, tif(f),"
-          " or raw(yuv) are supported\n");
-#else
-        OJPH_ERROR(0x01000041,
-          "unknown input file extension; only pgm, ppm, dpx,"
-          " or raw(yuv) are supported\n");
-#endif // !OJPH_ENABLE_TIFF_SUPPORT 
-    }
-    else
-      OJPH_ERROR(0x01000051,
-        "Please supply a proper input filename with a proper three-letter "
-        "extension\n");
-
-    ojph::comment_exchange com_ex;
-    if (com_string)
-      com_ex.set_string(com_string);
-    ojph::j2c_outfile j2c_file;
-    j2c_file.open(output_filename);
-    codestream.write_headers(&j2c_file, &com_ex, com_string ? 1 : 0);
-
-    ojph::ui32 next_comp;
-    ojph::line_buf* cur_line = codestream.exchange(NULL, next_comp);
-    if (codestream.is_planar())
-    {
-      ojph::param_siz siz = codestream.access_siz();
-      for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
-      {
-        ojph::point p = siz.get_downsampling(c);
-        ojph::ui32 height = ojph_div_ceil(siz.get_image_extent().y, p.y);
-        height -= ojph_div_ceil(siz.get_image_offset().y, p.y);
-        for (ojph::ui32 i = height; i > 0; --i)
-        {
-          assert(c == next_comp);
-          base->read(cur_line, next_comp);
-          cur_line = codestream.exchange(cur_line, next_comp);
-        }
-      }
+        jobs.init_from_patterns(input_filename, output_filename,
+                                first_frame, num_frames);
+      if (num_threads == 0)
+        num_threads = ojph_max(std::thread::hardware_concurrency(), 1u);
+      num_threads = (ojph::ui32)ojph_min((size_t)num_threads,
+                                         ojph_max(jobs.get_num_jobs(),
+                                                  (size_t)1));
+
+      std::vector<ojph::batch::worker*> workers(num_threads);
+      for (ojph::ui32 i = 0; i < num_threads; ++i)
+        workers[i] = new compress_worker(s);
+      num_failed = ojph::batch::run(jobs, workers.data(), num_threads);
+      for (ojph::ui32 i = 0; i < num_threads; ++i)
+        delete workers[i];
     }
     else
     {
-      ojph::param_siz siz = codestream.access_siz();
-      ojph::ui32 height = siz.get_image_extent().y; 
-      height -= siz.get_image_offset().y;
-      for (ojph::ui32 i = 0; i < height; ++i)
-      {
-        for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
-        {
-          assert(c == next_comp);
-          base->read(cur_line, next_comp);
-          cur_line = codestream.exchange(cur_line, next_comp);
-        }
-      }
+      ojph::codestream codestream;
+      image_readers readers;
+      pipeline_stages stages;  // destroyed before the readers
+      ojph::batch::image_stats stats;
+      compress_image(s, input_filename, output_filename, codestream,
+                     readers, s.pipeline ? &stages : NULL, stats);
     }
 
-    codestream.flush();
-    codestream.close();
-    base->close();
-
     if (max_num_comps != initial_num_comps)
     {
       delete[] comp_downsampling;
@@ -1169,6 +1570,9 @@ int main(int argc, char * argv[]) {
     exit(-1);
   }
 
+  if (batch_mode)
+    return num_failed ? -1 : 0;
+
   clock_t end = clock();
   double elapsed_secs = double(end - begin) / CLOCKS_PER_SEC;
   printf("Elapsed time = %f\n", elapsed_secs);
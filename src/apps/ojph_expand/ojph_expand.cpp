@@ -38,6 +38,8 @@
 #include <ctime>
 #include <iostream>
 #include <cstdlib>
+#include <thread>
+#include <vector>
 
 #include "ojph_arg.h"
 #include "ojph_mem.h"
@@ -46,6 +48,7 @@
 #include "ojph_codestream.h"
 #include "ojph_params.h"
 #include "ojph_message.h"
+#include "ojph_batch.h"
 
 /////////////////////////////////////////////////////////////////////////////
 struct ui32_list_interpreter : public ojph::cli_interpreter::arg_inter_base
@@ -95,7 +98,9 @@ bool get_arguments(int argc, char *argv[],
                    char *&input_filename, char *&output_filename,
                    ojph::ui32& skipped_res_for_read, 
                    ojph::ui32& skipped_res_for_recon,
-                   bool& resilient)
+                   bool& resilient, char *&list_filename,
+                   ojph::ui32& first_frame, ojph::ui32& num_frames,
+                   ojph::ui32& num_threads)
 {
   ojph::cli_interpreter interpreter;
   interpreter.init(argc, argv);
@@ -108,6 +113,10 @@ bool get_arguments(int argc, char *argv[],
   interpreter.reinterpret("-o", output_filename);
   interpreter.reinterpret("-skip_res", &ilist);
   interpreter.reinterpret("-resilient", resilient);
+  interpreter.reinterpret("-list", list_filename);
+  interpreter.reinterpret("-first_frame", first_frame);
+  interpreter.reinterpret("-num_frames", num_frames);
+  interpreter.reinterpret("-num_threads", num_threads);
 
   //interpret skipped_string
   if (num_skipped_res > 0)
@@ -161,6 +170,371 @@ bool is_matching(const char *ref, const char *other)
   return true;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// The command-line settings, which apply to every file
+struct expand_settings
+{
+  ojph::ui32 skipped_res_for_read;
+  ojph::ui32 skipped_res_for_recon;
+  bool resilient;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// One writer for each supported file type
+struct image_writers
+{
+  void close()
+  {
+    ppm.close(); pfm.close(); yuv.close(); raw.close();
+    v210.close(); p010.close(); dpx.close();
+#ifdef OJPH_ENABLE_TIFF_SUPPORT
+    tif.close();
+#endif // !OJPH_ENABLE_TIFF_SUPPORT
+  }
+
+  ojph::ppm_out ppm;
+  ojph::pfm_out pfm;
+#ifdef OJPH_ENABLE_TIFF_SUPPORT
+  ojph::tif_out tif;
+#endif // !OJPH_ENABLE_TIFF_SUPPORT
+  ojph::yuv_out yuv;
+  ojph::raw_out raw;
+  ojph::v210_out v210;
+  ojph::p010_out p010;
+  ojph::dpx_out dpx;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Decompresses one file; codestream must be new or restarted
+static
+void expand_image(const expand_settings& s, const char *input_filename,
+                  char *output_filename, ojph::codestream& codestream,
+                  image_writers& writers, ojph::batch::image_stats& stats)
+{
+  ojph::j2c_infile j2c_file;
+  j2c_file.open(input_filename);
+
+  ojph::ppm_out& ppm = writers.ppm;
+  ojph::pfm_out& pfm = writers.pfm;
+  #ifdef OJPH_ENABLE_TIFF_SUPPORT
+  ojph::tif_out& tif = writers.tif;
+  #endif /* OJPH_ENABLE_TIFF_SUPPORT */
+  ojph::yuv_out& yuv = writers.yuv;
+  ojph::raw_out& raw = writers.raw;
+  ojph::v210_out& v210 = writers.v210;
+  ojph::p010_out& p010 = writers.p010;
+  ojph::dpx_out& dpx = writers.dpx;
+  ojph::image_out_base *base = NULL;
+  const char *v = get_file_extension(output_filename);
+  if (v)
+  {
+    if (s.resilient)
+      codestream.enable_resilience();
+    codestream.read_headers(&j2c_file);
+    codestream.restrict_input_resolution(s.skipped_res_for_read,
+      s.skipped_res_for_recon);
+    ojph::param_siz siz = codestream.access_siz();
+
+    if (is_matching(".pgm", v))
+    {
+
+      if (siz.get_num_components() != 1)
+        OJPH_ERROR(0x02000002,
+          "The file has more than one color component, but .pgm can "
+          "contain only one color component\n");
+      ppm.configure(siz.get_recon_width(0), siz.get_recon_height(0),
+                    siz.get_num_components(), siz.get_bit_depth(0));
+      ppm.open(output_filename);
+      base = &ppm;
+    }
+    else if (is_matching(".ppm", v))
+    {
+      codestream.set_planar(false);
+      ojph::param_siz siz = codestream.access_siz();
+
+      if (siz.get_num_components() != 3)
+        OJPH_ERROR(0x02000003,
+          "The file has %d color components; this cannot be saved to"
+          " a .ppm file\n", siz.get_num_components());
+      bool all_same = true;
+      ojph::point p = siz.get_downsampling(0);
+      for (ojph::ui32 i = 1; i < siz.get_num_components(); ++i)
+      {
+        ojph::point p1 = siz.get_downsampling(i);
+        all_same = all_same && (p1.x == p.x) && (p1.y == p.y);
+      }
+      if (!all_same)
+        OJPH_ERROR(0x02000004,
+          "To save an image to ppm, all the components must have the "
+          "same downsampling ratio\n");
+      ppm.configure(siz.get_recon_width(0), siz.get_recon_height(0),
+                    siz.get_num_components(), siz.get_bit_depth(0));
+      ppm.open(output_filename);
+      base = &ppm;
+    }
+    else if (is_matching(".pfm", v))
+    {
+      OJPH_INFO(0x02000010, "Note: The .pfm implementation is "
+        "experimental.  Here, we are assuming that the original data is "
+        "floating-point numbers.");
+
+      codestream.set_planar(false);
+      ojph::param_siz siz = codestream.access_siz();
+
+      ojph::ui32 num_comps = siz.get_num_components();
+      if (num_comps != 3 && num_comps != 1)
+        OJPH_ERROR(0x0200000C,
+          "The file has %d color components; this cannot be saved to"
+          " a .pfm file", num_comps);
+      bool all_same = true;
+      ojph::point p = siz.get_downsampling(0);
+      for (ojph::ui32 i = 1; i < siz.get_num_components(); ++i) {
+        ojph::point p1 = siz.get_downsampling(i);
+        all_same = all_same && (p1.x == p.x) && (p1.y == p.y);
+      }
+      if (!all_same)
+        OJPH_ERROR(0x0200000D,
+          "To save an image to ppm, all the components must have the "
+          "same downsampling ratio");
+      ojph::ui32 bit_depth[3];
+      for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
+        bit_depth[c] = siz.get_bit_depth(c);
+      pfm.configure(siz.get_recon_width(0), siz.get_recon_height(0),
+        siz.get_num_components(), -1.0f, bit_depth);
+      pfm.open(output_filename);
+      base = &pfm;
+    }
+#ifdef OJPH_ENABLE_TIFF_SUPPORT
+    else if (is_matching(".tif", v) || is_matching(".tiff", v))
+    {
+      codestream.set_planar(false);
+      ojph::param_siz siz = codestream.access_siz();
+
+      bool all_same = true;
+      ojph::point p = siz.get_downsampling(0);
+      for (unsigned int i = 1; i < siz.get_num_components(); ++i)
+      {
+        ojph::point p1 = siz.get_downsampling(i);
+        all_same = all_same && (p1.x == p.x) && (p1.y == p.y);
+      }
+      if (!all_same)
+        OJPH_ERROR(0x02000005,
+          "To save an image to tif(f), all the components must have the "
+          "same downsampling ratio\n");
+      ojph::ui32 bit_depths[4] = { 0, 0, 0, 0 };
+      for (ojph::ui32 c = 0; c < siz.get_num_components(); c++)
+      {
+        bit_depths[c] = siz.get_bit_depth(c);
+      }
+      tif.configure(siz.get_recon_width(0), siz.get_recon_height(0),
+        siz.get_num_components(), bit_depths);
+      tif.open(output_filename);
+      base = &tif;
+    }
+#endif // !OJPH_ENABLE_TIFF_SUPPORT
+    else if (is_matching(".yuv", v))
+    {
+      codestream.set_planar(true);
+      ojph::param_siz siz = codestream.access_siz();
+
+      if (siz.get_num_components() != 3 && siz.get_num_components() != 1)
+        OJPH_ERROR(0x02000006,
+          "The file has %d color components; this cannot be saved to"
+           " .yuv file\n", siz.get_num_components());
+      ojph::param_cod cod = codestream.access_cod();
+      if (cod.is_using_color_transform())
+        OJPH_ERROR(0x02000007,
+          "The current implementation of yuv file object does not"
+          " support saving file when conversion from yuv to rgb is"
+          " needed; in any case, this is not the normal usage of yuv"
+          "file.");
+      ojph::ui32 comp_widths[3];
+      ojph::ui32 max_bit_depth = 0;
+      for (ojph::ui32 i = 0; i < siz.get_num_components(); ++i)
+      {
+        comp_widths[i] = siz.get_recon_width(i);
+        max_bit_depth = ojph_max(max_bit_depth, siz.get_bit_depth(i));
+      }
+      codestream.set_planar(true);
+      yuv.configure(max_bit_depth, siz.get_num_components(), comp_widths);
+      yuv.open(output_filename);
+      base = &yuv;
+    }
+    else if (is_matching(".raw", v))
+    {
+      ojph::param_siz siz = codestream.access_siz();
+
+      if (siz.get_num_components() != 1)
+        OJPH_ERROR(0x02000008,
+          "The file has %d color components; this cannot be saved to"
+          " .raw file (only one component is allowed).\n", 
+          siz.get_num_components());
+      bool is_signed = siz.is_signed(0);
+      ojph::ui32 width = siz.get_recon_width(0);
+      ojph::ui32 bit_depth = siz.get_bit_depth(0);
+      raw.configure(is_signed, bit_depth, width);
+      raw.open(output_filename);
+      base = &raw;
+    }
+    else if (is_matching(".v210", v) || is_matching(".p010", v))
+    {
+      // Y, Cb and Cr of 10 bits, with Cb and Cr downsampled by {2,1} for
+      // v210 and by {2,2} for p010
+      bool is_v210 = is_matching(".v210", v);
+      ojph::ui32 chroma_ds_y = is_v210 ? 1 : 2;
+      ojph::param_siz siz = codestream.access_siz();
+      if (siz.get_num_components() != 3)
+        OJPH_ERROR(0x02000013,
+          "The file has %d color components; this cannot be saved to"
+          " a %s file\n", siz.get_num_components(), v);
+      bool matching = true;
+      for (ojph::ui32 c = 0; c < 3; ++c)
+      {
+        ojph::point ds = siz.get_downsampling(c);
+        ojph::point ref(c ? 2 : 1, c ? chroma_ds_y : 1);
+        matching = matching && ds.x == ref.x && ds.y == ref.y
+          && siz.get_bit_depth(c) == 10 && !siz.is_signed(c);
+      }
+      ojph::ui32 width = siz.get_recon_width(0);
+      ojph::ui32 height = siz.get_recon_height(0);
+      matching = matching && siz.get_recon_width(1) == (width + 1) / 2
+        && siz.get_recon_height(1) == (height + chroma_ds_y - 1) / chroma_ds_y;
+      if (!matching)
+        OJPH_ERROR(0x02000014,
+          "To save an image to %s, the components must be unsigned 10-bit "
+          "Y, Cb and Cr, with Cb and Cr downsampled by %s, and the image "
+          "offset must be even\n", v, is_v210 ? "{2,1}" : "{2,2}");
+      if (codestream.access_cod().is_using_color_transform())
+        OJPH_ERROR(0x02000015,
+          "The file uses a color transform; this cannot be saved to a %s "
+          "file, which holds Y'CbCr\n", v);
+      if (is_v210)
+      {
+        codestream.set_planar(false);
+        v210.configure(width, height);
+        v210.open(output_filename);
+        base = &v210;
+      }
+      else
+      {
+        codestream.set_planar(true);
+        p010.configure(width, height);
+        p010.open(output_filename);
+        base = &p010;
+      }
+    }
+    else if (is_matching(".dpx", v))
+    {
+      codestream.set_planar(false);
+      ojph::param_siz siz = codestream.access_siz();
+
+      if (siz.get_num_components() != 3)
+        OJPH_ERROR(0x02000016,
+          "The file has %d color components; this cannot be saved to"
+          " a .dpx file\n", siz.get_num_components());
+      bool matching = true;
+      for (ojph::ui32 c = 0; c < 3; ++c)
+      {
+        ojph::point ds = siz.get_downsampling(c);
+        matching = matching && ds.x == 1 && ds.y == 1
+          && siz.get_bit_depth(c) == 10 && !siz.is_signed(c);
+      }
+      if (!matching)
+        OJPH_ERROR(0x02000017,
+          "To save an image to dpx, the components must be unsigned 10-bit "
+          "samples without downsampling\n");
+      dpx.configure(siz.get_recon_width(0), siz.get_recon_height(0));
+      dpx.open(output_filename);
+      base = &dpx;
+    }
+    else
+#ifdef OJPH_ENABLE_TIFF_SUPPORT
+      OJPH_ERROR(0x02000009,
+        "unknown output file extension; only pgm, ppm, tif(f), dpx, v210,"
+        " p010 and raw(yuv) are supported\n");
+#else
+      OJPH_ERROR(0x0200000A,
+        "unknown output file extension; only pgm, ppm, dpx, v210, p010, and"
+        " raw(yuv) are supported\n");
+#endif // !OJPH_ENABLE_TIFF_SUPPORT
+  }
+  else
+    OJPH_ERROR(0x0200000B,
+      "Please supply a proper output filename with a proper extension\n");
+
+  codestream.create();
+
+  if (codestream.is_planar())
+  {
+    ojph::param_siz siz = codestream.access_siz();
+    for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
+    {
+      ojph::ui32 height = siz.get_recon_height(c);
+      for (ojph::ui32 i = height; i > 0; --i)
+      {
+        ojph::ui32 comp_num;
+        ojph::line_buf *line = codestream.pull(comp_num);
+        assert(comp_num == c);
+        base->write(line, comp_num);
+      }
+    }
+  }
+  else
+  {
+    ojph::param_siz siz = codestream.access_siz();
+    ojph::ui32 height = siz.get_recon_height(0);
+    for (ojph::ui32 i = 0; i < height; ++i)
+    {
+      for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
+      {
+        ojph::ui32 comp_num;
+        ojph::line_buf *line = codestream.pull(comp_num);
+        assert(comp_num == c);
+        base->write(line, comp_num);
+      }
+    }
+  }
+
+  base->close();
+  stats.coded_bytes = (ojph::ui64)j2c_file.tell();
+  ojph::param_siz siz = codestream.access_siz();
+  for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
+    stats.num_samples += (ojph::ui64)siz.get_recon_width(c)
+                       * siz.get_recon_height(c);
+  codestream.close();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Decompresses the files of a batch, reusing its codestream and writers
+class expand_worker : public ojph::batch::worker
+{
+public:
+  expand_worker(const expand_settings& s) : s(s), first(true) {}
+
+  virtual void process(const char *input_filename, char *output_filename,
+                       ojph::batch::image_stats& stats)
+  {
+    if (!first)
+      codestream.restart();
+    first = false;
+    try {
+      expand_image(s, input_filename, output_filename, codestream,
+                   writers, stats);
+    }
+    catch (...)
+    {
+      writers.close();  // so that the next file can be opened
+      throw;
+    }
+  }
+
+private:
+  const expand_settings& s;
+  bool first;
+  ojph::codestream codestream;
+  image_writers writers;
+};
+
 /////////////////////////////////////////////////////////////////////////////
 int main(int argc, char *argv[]) {
 
@@ -169,15 +543,21 @@ int main(int argc, char *argv[]) {
   ojph::ui32 skipped_res_for_read = 0;
   ojph::ui32 skipped_res_for_recon = 0;
   bool resilient = false;
+  char *list_filename = NULL;
+  ojph::ui32 first_frame = 0;
+  ojph::ui32 num_frames = 0;
+  ojph::ui32 num_threads = 0;
 
   if (argc <= 1) {
     std::cout <<
     "\nThe following arguments are necessary:\n"
     " -i <input file name>\n"
 #ifdef OJPH_ENABLE_TIFF_SUPPORT
-    " -o <output file name> (either pgm, ppm, tif(f), or raw(yuv))\n\n"
+    " -o <output file name> (either pgm, ppm, tif(f), dpx, v210, p010, or\n"
+    "    raw(yuv))\n\n"
 #else
-    " -o <output file name> (either pgm, ppm, or raw(yuv))\n\n"
+    " -o <output file name> (either pgm, ppm, dpx, v210, p010, or\n"
+    "    raw(yuv))\n\n"
 #endif // !OJPH_ENABLE_TIFF_SUPPORT
     "The following arguments are optional:\n"
     " -skip_res  x,y a comma-separated list of two elements containing the\n"
@@ -191,236 +571,77 @@ int main(int argc, char *argv[]) {
     "            running into recoverable errors in the codestream.\n"
     "            Default: 'false'.\n"
     "\n"
+    "Batch mode decompresses many files in one run, on several threads;\n"
+    "each thread keeps its codestream and image writer objects from one\n"
+    "file to the next.  The aggregate throughput is reported at the end.\n"
+    " -num_frames  the number of files; -i and -o are then printf-style\n"
+    "              patterns with one integer conversion, such as\n"
+    "              -i in_%05d.j2c -o out_%05d.ppm\n"
+    " -first_frame (0) the number substituted for the first file\n"
+    " -list        a text file, where each line holds an input and an\n"
+    "              output file name; -i and -o are then not needed\n"
+    " -num_threads (number of CPUs) the number of threads\n"
+    "\n"
     ;
     return -1;
   }
   if (!get_arguments(argc, argv, input_filename, output_filename,
                      skipped_res_for_read, skipped_res_for_recon,
-                     resilient))
+                     resilient, list_filename, first_frame, num_frames,
+                     num_threads))
   {
     return -1;
   }
 
+  bool batch_mode = list_filename != NULL || num_frames != 0;
+  size_t num_failed = 0;
   clock_t begin = clock();
 
   try {
-    if (output_filename == NULL)
+    if (list_filename != NULL && num_frames != 0)
+      OJPH_ERROR(0x02000011, "-list and -num_frames cannot be used "
+        "together");
+    if (input_filename == NULL && list_filename == NULL)
+      OJPH_ERROR(0x02000012,
+                 "Please provide an input file using the -i option\n");
+    if (output_filename == NULL && list_filename == NULL)
       OJPH_ERROR(0x02000001,
                  "Please provide an output file using the -o option\n");
 
-    ojph::j2c_infile j2c_file;
-    j2c_file.open(input_filename);
-    ojph::codestream codestream;
-
-    ojph::ppm_out ppm;
-    ojph::pfm_out pfm;
-    #ifdef OJPH_ENABLE_TIFF_SUPPORT
-    ojph::tif_out tif;
-    #endif /* OJPH_ENABLE_TIFF_SUPPORT */
-    ojph::yuv_out yuv;
-    ojph::raw_out raw;
-    ojph::image_out_base *base = NULL;
-    const char *v = get_file_extension(output_filename);
-    if (v)
-    {
-      if (resilient)
-        codestream.enable_resilience();
-      codestream.read_headers(&j2c_file);
-      codestream.restrict_input_resolution(skipped_res_for_read, 
-        skipped_res_for_recon);
-      ojph::param_siz siz = codestream.access_siz();
-
-      if (is_matching(".pgm", v))
-      {
+    expand_settings s;
+    s.skipped_res_for_read = skipped_res_for_read;
+    s.skipped_res_for_recon = skipped_res_for_recon;
+    s.resilient = resilient;
 
-        if (siz.get_num_components() != 1)
-          OJPH_ERROR(0x02000002,
-            "The file has more than one color component, but .pgm can "
-            "contain only one color component\n");
-        ppm.configure(siz.get_recon_width(0), siz.get_recon_height(0),
-                      siz.get_num_components(), siz.get_bit_depth(0));
-        ppm.open(output_filename);
-        base = &ppm;
-      }
-      else if (is_matching(".ppm", v))
-      {
-        codestream.set_planar(false);
-        ojph::param_siz siz = codestream.access_siz();
-
-        if (siz.get_num_components() != 3)
-          OJPH_ERROR(0x02000003,
-            "The file has %d color components; this cannot be saved to"
-            " a .ppm file\n", siz.get_num_components());
-        bool all_same = true;
-        ojph::point p = siz.get_downsampling(0);
-        for (ojph::ui32 i = 1; i < siz.get_num_components(); ++i)
-        {
-          ojph::point p1 = siz.get_downsampling(i);
-          all_same = all_same && (p1.x == p.x) && (p1.y == p.y);
-        }
-        if (!all_same)
-          OJPH_ERROR(0x02000004,
-            "To save an image to ppm, all the components must have the "
-            "same downsampling ratio\n");
-        ppm.configure(siz.get_recon_width(0), siz.get_recon_height(0),
-                      siz.get_num_components(), siz.get_bit_depth(0));
-        ppm.open(output_filename);
-        base = &ppm;
-      }
-      else if (is_matching(".pfm", v))
-      {
-        OJPH_INFO(0x02000010, "Note: The .pfm implementation is "
-          "experimental.  Here, we are assuming that the original data is "
-          "floating-point numbers.");
-
-        codestream.set_planar(false);
-        ojph::param_siz siz = codestream.access_siz();
-
-        ojph::ui32 num_comps = siz.get_num_components();
-        if (num_comps != 3 && num_comps != 1)
-          OJPH_ERROR(0x0200000C,
-            "The file has %d color components; this cannot be saved to"
-            " a .pfm file", num_comps);
-        bool all_same = true;
-        ojph::point p = siz.get_downsampling(0);
-        for (ojph::ui32 i = 1; i < siz.get_num_components(); ++i) {
-          ojph::point p1 = siz.get_downsampling(i);
-          all_same = all_same && (p1.x == p.x) && (p1.y == p.y);
-        }
-        if (!all_same)
-          OJPH_ERROR(0x0200000D,
-            "To save an image to ppm, all the components must have the "
-            "same downsampling ratio");
-        ojph::ui32 bit_depth[3];
-        for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
-          bit_depth[c] = siz.get_bit_depth(c);
-        pfm.configure(siz.get_recon_width(0), siz.get_recon_height(0),
-          siz.get_num_components(), -1.0f, bit_depth);
-        pfm.open(output_filename);
-        base = &pfm;
-      }
-#ifdef OJPH_ENABLE_TIFF_SUPPORT
-      else if (is_matching(".tif", v) || is_matching(".tiff", v))
-      {
-        codestream.set_planar(false);
-        ojph::param_siz siz = codestream.access_siz();
-
-        bool all_same = true;
-        ojph::point p = siz.get_downsampling(0);
-        for (unsigned int i = 1; i < siz.get_num_components(); ++i)
-        {
-          ojph::point p1 = siz.get_downsampling(i);
-          all_same = all_same && (p1.x == p.x) && (p1.y == p.y);
-        }
-        if (!all_same)
-          OJPH_ERROR(0x02000005,
-            "To save an image to tif(f), all the components must have the "
-            "same downsampling ratio\n");
-        ojph::ui32 bit_depths[4] = { 0, 0, 0, 0 };
-        for (ojph::ui32 c = 0; c < siz.get_num_components(); c++)
-        {
-          bit_depths[c] = siz.get_bit_depth(c);
-        }
-        tif.configure(siz.get_recon_width(0), siz.get_recon_height(0),
-          siz.get_num_components(), bit_depths);
-        tif.open(output_filename);
-        base = &tif;
-      }
-#endif // !OJPH_ENABLE_TIFF_SUPPORT
-      else if (is_matching(".yuv", v))
-      {
-        codestream.set_planar(true);
-        ojph::param_siz siz = codestream.access_siz();
-
-        if (siz.get_num_components() != 3 && siz.get_num_components() != 1)
-          OJPH_ERROR(0x02000006,
-            "The file has %d color components; this cannot be saved to"
-             " .yuv file\n", siz.get_num_components());
-        ojph::param_cod cod = codestream.access_cod();
-        if (cod.is_using_color_transform())
-          OJPH_ERROR(0x02000007,
-            "The current implementation of yuv file object does not"
-            " support saving file when conversion from yuv to rgb is"
-            " needed; in any case, this is not the normal usage of yuv"
-            "file.");
-        ojph::ui32 comp_widths[3];
-        ojph::ui32 max_bit_depth = 0;
-        for (ojph::ui32 i = 0; i < siz.get_num_components(); ++i)
-        {
-          comp_widths[i] = siz.get_recon_width(i);
-          max_bit_depth = ojph_max(max_bit_depth, siz.get_bit_depth(i));
-        }
-        codestream.set_planar(true);
-        yuv.configure(max_bit_depth, siz.get_num_components(), comp_widths);
-        yuv.open(output_filename);
-        base = &yuv;
-      }
-      else if (is_matching(".raw", v))
-      {
-        ojph::param_siz siz = codestream.access_siz();
-
-        if (siz.get_num_components() != 1)
-          OJPH_ERROR(0x02000008,
-            "The file has %d color components; this cannot be saved to"
-            " .raw file (only one component is allowed).\n", 
-            siz.get_num_components());
-        bool is_signed = siz.is_signed(0);
-        ojph::ui32 width = siz.get_recon_width(0);
-        ojph::ui32 bit_depth = siz.get_bit_depth(0);
-        raw.configure(is_signed, bit_depth, width);
-        raw.open(output_filename);
-        base = &raw;
-      }
-      else
-#ifdef OJPH_ENABLE_TIFF_SUPPORT
-        OJPH_ERROR(0x02000009,
-          "unknown output file extension; only pgm, ppm, tif(f) and raw(yuv))"
-          " are supported\n");
-#else
-        OJPH_ERROR(0x0200000A,
-          "unknown output file extension; only pgm, ppm, and raw(yuv) are"
-          " supported\n");
-#endif // !OJPH_ENABLE_TIFF_SUPPORT
-    }
-    else
-      OJPH_ERROR(0x0200000B,
-        "Please supply a proper output filename with a proper extension\n");
-
-    codestream.create();
-
-    if (codestream.is_planar())
+    if (batch_mode)
     {
-      ojph::param_siz siz = codestream.access_siz();
-      for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
-      {
-        ojph::ui32 height = siz.get_recon_height(c);
-        for (ojph::ui32 i = height; i > 0; --i)
-        {
-          ojph::ui32 comp_num;
-          ojph::line_buf *line = codestream.pull(comp_num);
-          assert(comp_num == c);
-          base->write(line, comp_num);
-        }
-      }
+      ojph::batch::job_list jobs;
+      if (list_filename)
+        jobs.init_from_file(list_filename);
+      else
+        jobs.init_from_patterns(input_filename, output_filename,
+                                first_frame, num_frames);
+      if (num_threads == 0)
+        num_threads = ojph_max(std::thread::hardware_concurrency(), 1u);
+      num_threads = (ojph::ui32)ojph_min((size_t)num_threads,
+                                         ojph_max(jobs.get_num_jobs(),
+                                                  (size_t)1));
+
+      std::vector<ojph::batch::worker*> workers(num_threads);
+      for (ojph::ui32 i = 0; i < num_threads; ++i)
+        workers[i] = new expand_worker(s);
+      num_failed = ojph::batch::run(jobs, workers.data(), num_threads);
+      for (ojph::ui32 i = 0; i < num_threads; ++i)
+        delete workers[i];
     }
     else
     {
-      ojph::param_siz siz = codestream.access_siz();
-      ojph::ui32 height = siz.get_recon_height(0);
-      for (ojph::ui32 i = 0; i < height; ++i)
-      {
-        for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
-        {
-          ojph::ui32 comp_num;
-          ojph::line_buf *line = codestream.pull(comp_num);
-          assert(comp_num == c);
-          base->write(line, comp_num);
-        }
-      }
+      ojph::codestream codestream;
+      image_writers writers;
+      ojph::batch::image_stats stats;
+      expand_image(s, input_filename, output_filename, codestream,
+                   writers, stats);
     }
-
-    base->close();
-    codestream.close();
   }
   catch (const std::exception& e)
   {
@@ -430,6 +651,9 @@ int main(int argc, char *argv[]) {
     exit(-1);
   }
 
+  if (batch_mode)
+    return num_failed ? -1 : 0;
+
   clock_t end = clock();
   double elapsed_secs = double(end - begin) / CLOCKS_PER_SEC;
   printf("Elapsed time = %f\n", elapsed_secs);
@@ -0,0 +1,1759 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_kernel_bench.cpp
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+// Runs every SIMD implementation of the function-pointer kernels (codeblock
+// transfer and coding, wavelet lifting, and colour conversion) that the
+// build contains and the CPU supports, checks that each produces the same
+// bits as the generic implementation, and reports its throughput.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "ojph_arch.h"
+#include "ojph_arg.h"
+#include "ojph_defs.h"
+#include "ojph_mem.h"
+#include "ojph_params.h"
+#include "ojph_params_local.h"
+#include "ojph_codeblock_fun.h"
+#include "ojph_codeblock_fun_local.h"
+#include "ojph_block_decoder.h"
+#include "ojph_block_encoder.h"
+#include "ojph_transform.h"
+#include "ojph_transform_local.h"
+#include "ojph_colour.h"
+#include "ojph_colour_local.h"
+
+using namespace ojph;
+using namespace ojph::local;
+
+//////////////////////////////////////////////////////////////////////////////
+// Implementations are registered only when they are compiled in; these
+// macros mirror the conditions of the init functions of the library
+#if !defined(OJPH_DISABLE_SIMD) && \
+  (defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
+  #define OJPH_KB_X86
+#endif
+
+#if defined(OJPH_KB_X86) && !defined(OJPH_DISABLE_SSE)
+  #define ADD_SSE(k, f)    (k)->add("sse", X86_CPU_EXT_LEVEL_SSE, f)
+#else
+  #define ADD_SSE(k, f) ((void)(k))
+#endif
+#if defined(OJPH_KB_X86) && !defined(OJPH_DISABLE_SSE2)
+  #define ADD_SSE2(k, f)   (k)->add("sse2", X86_CPU_EXT_LEVEL_SSE2, f)
+#else
+  #define ADD_SSE2(k, f) ((void)(k))
+#endif
+#if defined(OJPH_KB_X86) && !defined(OJPH_DISABLE_SSSE3)
+  #define ADD_SSSE3(k, f)  (k)->add("ssse3", X86_CPU_EXT_LEVEL_SSSE3, f)
+#else
+  #define ADD_SSSE3(k, f) ((void)(k))
+#endif
+#if defined(OJPH_KB_X86) && !defined(OJPH_DISABLE_AVX)
+  #define ADD_AVX(k, f)    (k)->add("avx", X86_CPU_EXT_LEVEL_AVX, f)
+#else
+  #define ADD_AVX(k, f) ((void)(k))
+#endif
+#if defined(OJPH_KB_X86) && !defined(OJPH_DISABLE_AVX2)
+  #define ADD_AVX2(k, f)   (k)->add("avx2", X86_CPU_EXT_LEVEL_AVX2, f)
+#else
+  #define ADD_AVX2(k, f) ((void)(k))
+#endif
+#if defined(OJPH_KB_X86) && defined(OJPH_ARCH_X86_64) && \
+  !defined(OJPH_DISABLE_AVX512)
+  #define ADD_AVX512(k, f) (k)->add("avx512", X86_CPU_EXT_LEVEL_AVX512, f)
+#else
+  #define ADD_AVX512(k, f) ((void)(k))
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// deterministic pseudo-random numbers, so that runs are comparable
+class rand_gen
+{
+public:
+  rand_gen(ui32 seed = 0x12345678) : state(seed) {}
+
+  ui32 next()
+  {
+    state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+    return state;
+  }
+  // a value in [lo, hi]
+  si64 uniform(si64 lo, si64 hi)
+  { return lo + (si64)(next() % (ui64)(hi - lo + 1)); }
+  // a value in [-0.5, 0.5)
+  float uniform_float()
+  { return (float)(next() >> 8) * (1.0f / 16777216.0f) - 0.5f; }
+  // a laplacian-distributed magnitude, resembling wavelet coefficients
+  ui64 laplacian(double scale, ui64 max_val)
+  {
+    double u = ((double)(next() >> 8) + 0.5) * (1.0 / 16777216.0);
+    double v = -std::log(u) * scale;
+    return v >= (double)max_val ? max_val : (ui64)v;
+  }
+
+private:
+  ui32 state;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// a zero-initialized buffer whose data is 64-byte aligned, with 64 bytes
+// of room before and after the data for kernels that extend lines
+class aligned_buf
+{
+public:
+  aligned_buf() : store(NULL), data(NULL), num_bytes(0) {}
+  ~aligned_buf() { free(store); }
+
+  void alloc(size_t bytes)
+  {
+    free(store);
+    store = (ui8*)calloc(bytes + 192, 1);
+    if (store == NULL)
+      OJPH_ERROR(0x000F0001, "Failed to allocate %zu bytes", bytes);
+    data = (ui8*)(((size_t)store + 63) & ~(size_t)63) + 64;
+    num_bytes = bytes;
+  }
+
+  template<typename T>
+  T* get() const { return (T*)data; }
+  size_t get_size() const { return num_bytes; }
+
+private:
+  aligned_buf(const aligned_buf&);
+  aligned_buf& operator=(const aligned_buf&);
+
+  ui8* store;
+  ui8* data;
+  size_t num_bytes;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// a line_buf with its own storage
+enum line_type { LT_I16, LT_I32, LT_I64, LT_F32 };
+
+class test_line
+{
+public:
+  void init(line_type type, ui32 width)
+  {
+    static const size_t sizes[] = { 2, 4, 8, 4 };
+    buf.alloc(sizes[type] * width);
+    if (type == LT_I16)
+      line.wrap(buf.get<si16>(), width, 1);
+    else if (type == LT_I32)
+      line.wrap(buf.get<si32>(), width, 1);
+    else if (type == LT_I64)
+      line.wrap(buf.get<si64>(), width, 1);
+    else
+      line.wrap(buf.get<float>(), width, 1);
+    this->type = type;
+    this->width = width;
+  }
+
+  // fills the line with integers in [lo, hi], or floats in [-0.5, 0.5)
+  void fill(rand_gen& rng, si64 lo, si64 hi)
+  {
+    for (ui32 i = 0; i < width; ++i)
+      if (type == LT_I16)
+        line.i16[i] = (si16)rng.uniform(lo, hi);
+      else if (type == LT_I32)
+        line.i32[i] = (si32)rng.uniform(lo, hi);
+      else if (type == LT_I64)
+        line.i64[i] = rng.uniform(lo, hi);
+      else
+        line.f32[i] = rng.uniform_float();
+  }
+
+  void copy_from(const test_line& src)
+  { memcpy(buf.get<ui8>(), src.buf.get<ui8>(), buf.get_size()); }
+
+  void append_to(std::vector<ui8>& out) const
+  {
+    const ui8* p = buf.get<ui8>();
+    out.insert(out.end(), p, p + buf.get_size());
+  }
+
+  line_buf line;
+  aligned_buf buf;
+  line_type type;
+  ui32 width;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+static void append_bytes(std::vector<ui8>& out, const void* p, size_t bytes)
+{
+  const ui8* sp = (const ui8*)p;
+  out.insert(out.end(), sp, sp + bytes);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//
+//                            kernel interface
+//
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+class kernel
+{
+public:
+  kernel(const char* name, size_t num_samples)
+  : name(name), num_samples(num_samples), float_output(false) {}
+  virtual ~kernel() {}
+
+  // restores inputs that a kernel modifies; called before every check,
+  // and before every timed call when is_in_place() is true
+  virtual void prepare() {}
+  virtual bool is_in_place() const { return false; }
+
+  // runs implementation idx once
+  virtual void run(size_t idx) = 0;
+  // appends the output of the last run, for cross-checking
+  virtual void get_output(std::vector<ui8>& out) = 0;
+
+  const char* get_name() const { return name; }
+  size_t get_num_samples() const { return num_samples; }
+  size_t get_num_impls() const { return isas.size(); }
+  const char* get_isa(size_t idx) const { return isas[idx]; }
+  bool has_float_output() const { return float_output; }
+
+protected:
+  const char* name;
+  size_t num_samples;      // samples processed by one call
+  bool float_output;       // output is all floats, see check_kernel
+  std::vector<const char*> isas;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+template<typename FUN>
+class kernel_fun : public kernel
+{
+public:
+  kernel_fun(const char* name, size_t num_samples)
+  : kernel(name, num_samples) {}
+
+  // registers an implementation, if the CPU supports it
+  void add(const char* isa, int level, FUN f)
+  {
+    if (get_cpu_ext_level() >= level) {
+      isas.push_back(isa);
+      funs.push_back(f);
+    }
+  }
+
+protected:
+  std::vector<FUN> funs;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//
+//                            codeblock kernels
+//
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+class mem_clear_kernel : public kernel_fun<mem_clear_fun>
+{
+public:
+  mem_clear_kernel(const char* name, size_t num_bytes)
+  : kernel_fun<mem_clear_fun>(name, num_bytes / sizeof(ui32))
+  { buf.alloc(num_bytes); }
+
+  virtual void prepare()
+  { memset(buf.get<ui8>(), 0xA5, buf.get_size()); }
+  virtual void run(size_t idx)
+  { funs[idx](buf.get<ui8>(), buf.get_size()); }
+  virtual void get_output(std::vector<ui8>& out)
+  { append_bytes(out, buf.get<ui8>(), buf.get_size()); }
+
+private:
+  aligned_buf buf;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// the accumulators hold 256 bits; the generic kernels use only the first
+// element, so the other elements hold subsets of its bits
+template<typename T, typename FUN>
+class find_max_val_kernel : public kernel_fun<FUN>
+{
+public:
+  find_max_val_kernel(const char* name, rand_gen& rng)
+  : kernel_fun<FUN>(name, 32 / sizeof(T)), result(0)
+  {
+    buf.alloc(64);
+    T* p = buf.get<T>();
+    p[0] = (T)rng.next() << (sizeof(T) * 8 - 32) | rng.next();
+    for (size_t i = 1; i < 32 / sizeof(T); ++i)
+      p[i] = p[0] & ((T)rng.next() << (sizeof(T) * 8 - 32) | rng.next());
+  }
+
+  virtual void run(size_t idx) { result = this->funs[idx](buf.get<T>()); }
+  virtual void get_output(std::vector<ui8>& out)
+  { append_bytes(out, &result, sizeof(result)); }
+
+private:
+  aligned_buf buf;
+  T result;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// transfer from subband lines to codeblocks, quantizing irreversible data
+template<typename T, typename FUN>
+class tx_to_cb_kernel : public kernel_fun<FUN>
+{
+public:
+  tx_to_cb_kernel(const char* name, rand_gen& rng, line_type type,
+                  ui32 count, ui32 K_max, float delta_inv)
+  : kernel_fun<FUN>(name, count), K_max(K_max), delta_inv(delta_inv)
+  {
+    si64 lim = ((si64)1 << K_max) - 1;
+    src.init(type, count);
+    if (type == LT_I16)
+      src.fill(rng, -(lim < 32767 ? lim : 32767), lim < 32767 ? lim : 32767);
+    else if (type == LT_F32)
+      src.fill(rng, 0, 0);
+    else
+      src.fill(rng, -lim, lim);
+    dst.alloc(count * sizeof(T));
+    max_val.alloc(64);
+  }
+
+  virtual void run(size_t idx)
+  {
+    memset(max_val.get<ui8>(), 0, 64);
+    this->funs[idx](src.buf.get<ui8>(), dst.get<T>(), K_max, delta_inv,
+                    (ui32)this->num_samples, max_val.get<T>());
+  }
+  virtual void get_output(std::vector<ui8>& out)
+  {
+    append_bytes(out, dst.get<ui8>(), dst.get_size());
+    // the layout of the accumulator differs among implementations
+    T m = 0;
+    for (size_t i = 0; i < 32 / sizeof(T); ++i)
+      m |= max_val.get<T>()[i];
+    append_bytes(out, &m, sizeof(m));
+  }
+
+private:
+  test_line src;
+  aligned_buf dst, max_val;
+  ui32 K_max;
+  float delta_inv;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// transfer from codeblocks to subband lines, dequantizing irreversible data
+template<typename T, typename FUN>
+class tx_from_cb_kernel : public kernel_fun<FUN>
+{
+public:
+  tx_from_cb_kernel(const char* name, rand_gen& rng, line_type type,
+                    ui32 count, ui32 K_max, float delta)
+  : kernel_fun<FUN>(name, count), K_max(K_max), delta(delta)
+  {
+    const ui32 bits = sizeof(T) * 8;
+    src.alloc(count * sizeof(T));
+    T* sp = src.get<T>();
+    for (ui32 i = 0; i < count; ++i) {
+      T mag = (T)rng.uniform(0, ((si64)1 << (K_max < 16 ? K_max : 15)) - 1);
+      T sign = (T)(rng.next() & 1) << (bits - 1);
+      sp[i] = sign | (mag << (bits - 1 - K_max));
+    }
+    dst.init(type, count);
+    this->float_output = type == LT_F32;
+  }
+
+  virtual void run(size_t idx)
+  {
+    this->funs[idx](src.get<T>(), dst.buf.get<ui8>(), K_max, delta, 1.0f,
+                    (ui32)this->num_samples);
+  }
+  virtual void get_output(std::vector<ui8>& out) { dst.append_to(out); }
+
+private:
+  aligned_buf src;
+  test_line dst;
+  ui32 K_max;
+  float delta;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// fills a codeblock with laplacian-distributed sign-magnitude samples, as
+// tx_to_cb would
+template<typename T>
+static void fill_codeblock(rand_gen& rng, T* buf, ui32 width, ui32 height,
+                           ui32 stride, ui32 K_max)
+{
+  const ui32 bits = sizeof(T) * 8;
+  const ui64 max_mag = ((ui64)1 << K_max) - 1;
+  const double scale = (double)((ui64)1 << (K_max - 5));
+  for (ui32 y = 0; y < height; ++y)
+    for (ui32 x = 0; x < width; ++x) {
+      T mag = (T)rng.laplacian(scale, max_mag);
+      T sign = mag ? (T)(rng.next() & 1) << (bits - 1) : 0;
+      buf[y * stride + x] = sign | (mag << (bits - 1 - K_max));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+template<typename T, typename FUN>
+class encoder_kernel : public kernel_fun<FUN>
+{
+public:
+  encoder_kernel(const char* name, rand_gen& rng, ui32 width, ui32 height,
+                 ui32 K_max)
+  : kernel_fun<FUN>(name, width * height), width(width), height(height),
+    K_max(K_max), elastic(NULL), coded(NULL)
+  {
+    stride = (width + 15) & ~15u;
+    // the coders process pairs of rows, and may touch the row after an
+    // odd-height codeblock
+    buf.alloc(stride * (height + 1) * sizeof(T));
+    fill_codeblock(rng, buf.get<T>(), width, height, stride, K_max);
+  }
+  virtual ~encoder_kernel() { delete elastic; }
+
+  virtual void run(size_t idx)
+  {
+    // the allocator only grows, so it is renewed for every call
+    delete elastic;
+    elastic = new mem_elastic_allocator(1 << 16);
+    coded = NULL;
+    lengths[0] = lengths[1] = 0;
+    this->funs[idx](buf.get<T>(), K_max - 1, 1, width, height, stride,
+                    lengths, elastic, coded);
+  }
+  virtual void get_output(std::vector<ui8>& out)
+  {
+    append_bytes(out, lengths, sizeof(lengths));
+    append_bytes(out, coded->buf, lengths[0] + lengths[1]);
+  }
+
+  // the codestream of the last run, used as input to the decoders
+  const ui8* get_coded() const { return coded->buf; }
+  const ui32* get_lengths() const { return lengths; }
+
+private:
+  aligned_buf buf;
+  ui32 width, height, stride, K_max;
+  mem_elastic_allocator* elastic;
+  coded_lists* coded;
+  ui32 lengths[2];
+};
+
+//////////////////////////////////////////////////////////////////////////////
+template<typename T, typename FUN>
+class decoder_kernel : public kernel_fun<FUN>
+{
+public:
+  decoder_kernel(const char* name, const ui8* coded_data,
+                 const ui32* lengths, ui32 width, ui32 height, ui32 K_max)
+  : kernel_fun<FUN>(name, width * height), width(width), height(height),
+    K_max(K_max)
+  {
+    this->lengths[0] = lengths[0];
+    this->lengths[1] = lengths[1];
+    stride = (width + 15) & ~15u;
+    // the decoders may read a little before and after the codestream
+    ui32 num_bytes = lengths[0] + lengths[1];
+    coded.alloc(num_bytes + prefix_size + suffix_size);
+    pristine.alloc(num_bytes + prefix_size + suffix_size);
+    memcpy(pristine.get<ui8>() + prefix_size, coded_data, num_bytes);
+    buf.alloc(stride * (height + 1) * sizeof(T));
+  }
+
+  virtual bool is_in_place() const { return true; }
+  virtual void prepare()
+  {
+    memcpy(coded.get<ui8>(), pristine.get<ui8>(), coded.get_size());
+    memset(buf.get<ui8>(), 0, buf.get_size());
+  }
+  virtual void run(size_t idx)
+  {
+    bool result = this->funs[idx](coded.get<ui8>() + prefix_size,
+      buf.get<T>(), K_max - 1, 1, lengths[0], lengths[1], width, height,
+      stride, false);
+    if (!result)
+      OJPH_ERROR(0x000F0002, "%s failed to decode its codeblock",
+        this->name);
+  }
+  virtual void get_output(std::vector<ui8>& out)
+  { append_bytes(out, buf.get<ui8>(), stride * height * sizeof(T)); }
+
+private:
+  static const ui32 prefix_size = 8;
+  static const ui32 suffix_size = 16;
+  aligned_buf coded, pristine, buf;
+  ui32 width, height, stride, K_max;
+  ui32 lengths[2];
+};
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//
+//                            wavelet kernels
+//
+//
+//////////////////////////////////////////////////////////////////////////////
+
+typedef void (*vert_step_fun)(const lifting_step* s, const line_buf* sig,
+  const line_buf* other, const line_buf* aug, ui32 repeat, bool synthesis);
+typedef void (*vert_times_K_fun)(float K, const line_buf* aug, ui32 repeat);
+typedef void (*horz_ana_fun)(const param_atk* atk, const line_buf* ldst,
+  const line_buf* hdst, const line_buf* src, ui32 width, bool even);
+typedef void (*horz_syn_fun)(const param_atk* atk, const line_buf* dst,
+  const line_buf* lsrc, const line_buf* hsrc, ui32 width, bool even);
+typedef void (*irv_horz_syn_fun)(const param_atk* atk, const line_buf* dst,
+  const line_buf* lsrc, const line_buf* hsrc, ui32 width, bool even,
+  bool scale_low);
+
+//////////////////////////////////////////////////////////////////////////////
+// integer data ranges of lines that hold coefficients of a given type
+static void coeff_range(line_type type, si64& lo, si64& hi)
+{
+  hi = type == LT_I16 ? 2047 : (type == LT_I32 ? 65535 : 0);
+  lo = -hi;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+class vert_step_kernel : public kernel_fun<vert_step_fun>
+{
+public:
+  vert_step_kernel(const char* name, rand_gen& rng, line_type type,
+                   ui32 width, const lifting_step* step, bool synthesis)
+  : kernel_fun<vert_step_fun>(name, width), step(step),
+    synthesis(synthesis)
+  {
+    si64 lo, hi;
+    coeff_range(type, lo, hi);
+    sig.init(type, width);   sig.fill(rng, lo, hi);
+    other.init(type, width); other.fill(rng, lo, hi);
+    aug.init(type, width);
+    pristine.init(type, width); pristine.fill(rng, lo, hi);
+    float_output = type == LT_F32;
+  }
+
+  virtual bool is_in_place() const { return true; }
+  virtual void prepare() { aug.copy_from(pristine); }
+  virtual void run(size_t idx)
+  {
+    funs[idx](step, &sig.line, &other.line, &aug.line,
+      (ui32)num_samples, synthesis);
+  }
+  virtual void get_output(std::vector<ui8>& out) { aug.append_to(out); }
+
+private:
+  test_line sig, other, aug, pristine;
+  const lifting_step* step;
+  bool synthesis;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class vert_times_K_kernel : public kernel_fun<vert_times_K_fun>
+{
+public:
+  vert_times_K_kernel(const char* name, rand_gen& rng, line_type type,
+                      ui32 width, float K)
+  : kernel_fun<vert_times_K_fun>(name, width), K(K)
+  {
+    si64 lo, hi;
+    coeff_range(type, lo, hi);
+    aug.init(type, width);
+    pristine.init(type, width); pristine.fill(rng, lo, hi);
+    float_output = type == LT_F32;
+  }
+
+  virtual bool is_in_place() const { return true; }
+  virtual void prepare() { aug.copy_from(pristine); }
+  virtual void run(size_t idx)
+  { funs[idx](K, &aug.line, (ui32)num_samples); }
+  virtual void get_output(std::vector<ui8>& out) { aug.append_to(out); }
+
+private:
+  test_line aug, pristine;
+  float K;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class horz_ana_kernel : public kernel_fun<horz_ana_fun>
+{
+public:
+  horz_ana_kernel(const char* name, rand_gen& rng, line_type type,
+                  ui32 width, const param_atk* atk)
+  : kernel_fun<horz_ana_fun>(name, width), atk(atk)
+  {
+    si64 lo, hi;
+    coeff_range(type, lo, hi);
+    src.init(type, width);  src.fill(rng, lo, hi);
+    ldst.init(type, (width + 1) >> 1);
+    hdst.init(type, width >> 1);
+    float_output = type == LT_F32;
+  }
+
+  virtual void run(size_t idx)
+  {
+    funs[idx](atk, &ldst.line, &hdst.line, &src.line,
+      (ui32)num_samples, true);
+  }
+  virtual void get_output(std::vector<ui8>& out)
+  { ldst.append_to(out); hdst.append_to(out); }
+
+private:
+  test_line src, ldst, hdst;
+  const param_atk* atk;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// irv_horz_syn is timed with scale_low set, as for lines from a child
+// resolution
+static inline void call_horz_syn(horz_syn_fun f, const param_atk* atk,
+  const line_buf* dst, const line_buf* lsrc, const line_buf* hsrc,
+  ui32 width)
+{ f(atk, dst, lsrc, hsrc, width, true); }
+static inline void call_horz_syn(irv_horz_syn_fun f, const param_atk* atk,
+  const line_buf* dst, const line_buf* lsrc, const line_buf* hsrc,
+  ui32 width)
+{ f(atk, dst, lsrc, hsrc, width, true, true); }
+
+//////////////////////////////////////////////////////////////////////////////
+// the synthesis kernels lift lsrc and hsrc in place
+template<typename FUN>
+class horz_syn_kernel_t : public kernel_fun<FUN>
+{
+public:
+  horz_syn_kernel_t(const char* name, rand_gen& rng, line_type type,
+                    ui32 width, const param_atk* atk)
+  : kernel_fun<FUN>(name, width), atk(atk)
+  {
+    si64 lo, hi;
+    coeff_range(type, lo, hi);
+    ui32 lwidth = (width + 1) >> 1, hwidth = width >> 1;
+    dst.init(type, width);
+    lsrc.init(type, lwidth);   hsrc.init(type, hwidth);
+    lpristine.init(type, lwidth); lpristine.fill(rng, lo, hi);
+    hpristine.init(type, hwidth); hpristine.fill(rng, lo, hi);
+    this->float_output = type == LT_F32;
+  }
+
+  virtual bool is_in_place() const { return true; }
+  virtual void prepare()
+  { lsrc.copy_from(lpristine); hsrc.copy_from(hpristine); }
+  virtual void run(size_t idx)
+  {
+    call_horz_syn(this->funs[idx], atk, &dst.line, &lsrc.line, &hsrc.line,
+      (ui32)this->num_samples);
+  }
+  virtual void get_output(std::vector<ui8>& out) { dst.append_to(out); }
+
+private:
+  test_line dst, lsrc, hsrc, lpristine, hpristine;
+  const param_atk* atk;
+};
+typedef horz_syn_kernel_t<horz_syn_fun> horz_syn_kernel;
+typedef horz_syn_kernel_t<irv_horz_syn_fun> irv_horz_syn_kernel;
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//
+//                            colour kernels
+//
+//
+//////////////////////////////////////////////////////////////////////////////
+
+typedef void (*rev_convert_fun)(const line_buf *src_line,
+  const ui32 src_line_offset, line_buf *dst_line,
+  const ui32 dst_line_offset, si64 shift, ui32 width);
+typedef void (*to_float_fun)(const line_buf *src_line,
+  ui32 src_line_offset, line_buf *dst_line, ui32 bit_depth, bool is_signed,
+  ui32 width);
+typedef void (*to_integer_fun)(const line_buf *src_line,
+  line_buf *dst_line, ui32 dst_line_offset, ui32 bit_depth, bool is_signed,
+  ui32 width);
+typedef void (*rct_fun)(const line_buf *r, const line_buf *g,
+  const line_buf *b, line_buf *y, line_buf *cb, line_buf *cr, ui32 repeat);
+typedef void (*ict_fun)(const float *r, const float *g, const float *b,
+  float *y, float *cb, float *cr, ui32 repeat);
+typedef void (*ict_fix16_fun)(const si16 *r, const si16 *g, const si16 *b,
+  si16 *y, si16 *cb, si16 *cr, ui32 repeat);
+typedef void (*fused_rev_fwd_fun)(const line_buf *r, const line_buf *g,
+  const line_buf *b, ui32 src_line_offset, line_buf *y, line_buf *cb,
+  line_buf *cr, si64 shift, ui32 repeat);
+typedef void (*fused_rev_bwd_fun)(const line_buf *y, const line_buf *cb,
+  const line_buf *cr, line_buf *r, line_buf *g, line_buf *b,
+  ui32 dst_line_offset, si64 shift, ui32 repeat);
+typedef void (*fused_irv_fwd_fun)(const line_buf *r, const line_buf *g,
+  const line_buf *b, ui32 src_line_offset, line_buf *y, line_buf *cb,
+  line_buf *cr, ui32 bit_depth, bool is_signed, ui32 repeat);
+typedef void (*fused_irv_bwd_fun)(const line_buf *y, const line_buf *cb,
+  const line_buf *cr, line_buf *r, line_buf *g, line_buf *b,
+  ui32 dst_line_offset, ui32 bit_depth, bool is_signed, ui32 repeat);
+
+// the bit depth of the samples fed to the colour kernels
+static const ui32 colour_bit_depth = 10;
+
+//////////////////////////////////////////////////////////////////////////////
+// image samples of colour_bit_depth bits, signed or unsigned
+static void fill_samples(rand_gen& rng, test_line& line, bool is_signed)
+{
+  si64 half = (si64)1 << (colour_bit_depth - 1);
+  if (is_signed)
+    line.fill(rng, -half, half - 1);
+  else
+    line.fill(rng, 0, 2 * half - 1);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+class rev_convert_kernel : public kernel_fun<rev_convert_fun>
+{
+public:
+  rev_convert_kernel(const char* name, rand_gen& rng, line_type dst_type,
+                     ui32 width, bool is_signed, bool nlt_type3)
+  : kernel_fun<rev_convert_fun>(name, width)
+  {
+    src.init(LT_I32, width); fill_samples(rng, src, is_signed);
+    dst.init(dst_type, width);
+    shift = (si64)1 << (colour_bit_depth - 1);
+    if (nlt_type3)
+      shift += 1;
+    else
+      shift = is_signed ? 0 : -shift;
+  }
+
+  virtual void run(size_t idx)
+  { funs[idx](&src.line, 0, &dst.line, 0, shift, (ui32)num_samples); }
+  virtual void get_output(std::vector<ui8>& out) { dst.append_to(out); }
+
+private:
+  test_line src, dst;
+  si64 shift;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class to_float_kernel : public kernel_fun<to_float_fun>
+{
+public:
+  to_float_kernel(const char* name, rand_gen& rng, line_type dst_type,
+                  ui32 width, bool is_signed)
+  : kernel_fun<to_float_fun>(name, width), is_signed(is_signed)
+  {
+    src.init(LT_I32, width); fill_samples(rng, src, is_signed);
+    dst.init(dst_type, width);
+    float_output = dst_type == LT_F32;
+  }
+
+  virtual void run(size_t idx)
+  {
+    funs[idx](&src.line, 0, &dst.line, colour_bit_depth, is_signed,
+      (ui32)num_samples);
+  }
+  virtual void get_output(std::vector<ui8>& out) { dst.append_to(out); }
+
+private:
+  test_line src, dst;
+  bool is_signed;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// whether a float sample lands halfway between two integers once scaled to
+// colour_bit_depth bits; the SIMD kernels round these to even, and the
+// generic ones away from zero, so the float inputs of the conversions to
+// integer are moved off them by tie_nudge, one step of uniform_float()
+static bool is_rounding_tie(float v)
+{
+  float t = v * (float)(1u << colour_bit_depth);
+  return t - std::floor(t) == 0.5f;
+}
+static const float tie_nudge = 1.0f / 16777216.0f;
+
+//////////////////////////////////////////////////////////////////////////////
+class to_integer_kernel : public kernel_fun<to_integer_fun>
+{
+public:
+  to_integer_kernel(const char* name, rand_gen& rng, ui32 width,
+                    bool is_signed)
+  : kernel_fun<to_integer_fun>(name, width), is_signed(is_signed)
+  {
+    src.init(LT_F32, width); src.fill(rng, 0, 0);
+    dst.init(LT_I32, width);
+    for (ui32 i = 0; i < width; ++i)
+      while (is_rounding_tie(src.line.f32[i]))
+        src.line.f32[i] += tie_nudge;
+  }
+
+  virtual void run(size_t idx)
+  {
+    funs[idx](&src.line, &dst.line, 0, colour_bit_depth, is_signed,
+      (ui32)num_samples);
+  }
+  virtual void get_output(std::vector<ui8>& out) { dst.append_to(out); }
+
+private:
+  test_line src, dst;
+  bool is_signed;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class rct_kernel : public kernel_fun<rct_fun>
+{
+public:
+  rct_kernel(const char* name, rand_gen& rng, line_type src_type,
+             line_type dst_type, ui32 width)
+  : kernel_fun<rct_fun>(name, width)
+  {
+    for (int c = 0; c < 3; ++c) {
+      src[c].init(src_type, width);
+      if (src_type == LT_I16) // the output of an inverse wavelet
+        src[c].fill(rng, -1024, 1023);
+      else
+        fill_samples(rng, src[c], true);
+      dst[c].init(dst_type, width);
+    }
+  }
+
+  virtual void run(size_t idx)
+  {
+    funs[idx](&src[0].line, &src[1].line, &src[2].line,
+      &dst[0].line, &dst[1].line, &dst[2].line, (ui32)num_samples);
+  }
+  virtual void get_output(std::vector<ui8>& out)
+  { for (int c = 0; c < 3; ++c) dst[c].append_to(out); }
+
+private:
+  test_line src[3], dst[3];
+};
+
+//////////////////////////////////////////////////////////////////////////////
+template<typename T, typename FUN>
+class ict_kernel : public kernel_fun<FUN>
+{
+public:
+  ict_kernel(const char* name, rand_gen& rng, line_type type, ui32 width)
+  : kernel_fun<FUN>(name, width)
+  {
+    si64 lo, hi;
+    coeff_range(type, lo, hi);
+    for (int c = 0; c < 3; ++c) {
+      src[c].init(type, width); src[c].fill(rng, lo, hi);
+      dst[c].init(type, width);
+    }
+    this->float_output = type == LT_F32;
+  }
+
+  virtual void run(size_t idx)
+  {
+    this->funs[idx](src[0].buf.get<T>(), src[1].buf.get<T>(),
+      src[2].buf.get<T>(), dst[0].buf.get<T>(), dst[1].buf.get<T>(),
+      dst[2].buf.get<T>(), (ui32)this->num_samples);
+  }
+  virtual void get_output(std::vector<ui8>& out)
+  { for (int c = 0; c < 3; ++c) dst[c].append_to(out); }
+
+private:
+  test_line src[3], dst[3];
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class fused_rev_fwd_kernel : public kernel_fun<fused_rev_fwd_fun>
+{
+public:
+  fused_rev_fwd_kernel(const char* name, rand_gen& rng, line_type dst_type,
+                       ui32 width)
+  : kernel_fun<fused_rev_fwd_fun>(name, width)
+  {
+    for (int c = 0; c < 3; ++c) {
+      src[c].init(LT_I32, width); fill_samples(rng, src[c], false);
+      dst[c].init(dst_type, width);
+    }
+    shift = -((si64)1 << (colour_bit_depth - 1));
+  }
+
+  virtual void run(size_t idx)
+  {
+    funs[idx](&src[0].line, &src[1].line, &src[2].line, 0,
+      &dst[0].line, &dst[1].line, &dst[2].line, shift, (ui32)num_samples);
+  }
+  virtual void get_output(std::vector<ui8>& out)
+  { for (int c = 0; c < 3; ++c) dst[c].append_to(out); }
+
+private:
+  test_line src[3], dst[3];
+  si64 shift;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class fused_rev_bwd_kernel : public kernel_fun<fused_rev_bwd_fun>
+{
+public:
+  fused_rev_bwd_kernel(const char* name, rand_gen& rng, line_type src_type,
+                       ui32 width)
+  : kernel_fun<fused_rev_bwd_fun>(name, width)
+  {
+    for (int c = 0; c < 3; ++c) {
+      src[c].init(src_type, width); src[c].fill(rng, -1024, 1023);
+      dst[c].init(LT_I32, width);
+    }
+    shift = (si64)1 << (colour_bit_depth - 1);
+  }
+
+  virtual void run(size_t idx)
+  {
+    funs[idx](&src[0].line, &src[1].line, &src[2].line,
+      &dst[0].line, &dst[1].line, &dst[2].line, 0, shift,
+      (ui32)num_samples);
+  }
+  virtual void get_output(std::vector<ui8>& out)
+  { for (int c = 0; c < 3; ++c) dst[c].append_to(out); }
+
+private:
+  test_line src[3], dst[3];
+  si64 shift;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class fused_irv_fwd_kernel : public kernel_fun<fused_irv_fwd_fun>
+{
+public:
+  fused_irv_fwd_kernel(const char* name, rand_gen& rng, ui32 width)
+  : kernel_fun<fused_irv_fwd_fun>(name, width)
+  {
+    for (int c = 0; c < 3; ++c) {
+      src[c].init(LT_I32, width); fill_samples(rng, src[c], false);
+      dst[c].init(LT_F32, width);
+    }
+    float_output = true;
+  }
+
+  virtual void run(size_t idx)
+  {
+    funs[idx](&src[0].line, &src[1].line, &src[2].line, 0,
+      &dst[0].line, &dst[1].line, &dst[2].line, colour_bit_depth, false,
+      (ui32)num_samples);
+  }
+  virtual void get_output(std::vector<ui8>& out)
+  { for (int c = 0; c < 3; ++c) dst[c].append_to(out); }
+
+private:
+  test_line src[3], dst[3];
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class fused_irv_bwd_kernel : public kernel_fun<fused_irv_bwd_fun>
+{
+public:
+  fused_irv_bwd_kernel(const char* name, rand_gen& rng, ui32 width)
+  : kernel_fun<fused_irv_bwd_fun>(name, width)
+  {
+    for (int c = 0; c < 3; ++c) {
+      src[c].init(LT_F32, width); src[c].fill(rng, 0, 0);
+      dst[c].init(LT_I32, width);
+    }
+    // as in to_integer_kernel, the colours must not land on rounding ties
+    for (ui32 i = 0; i < width; ++i)
+      for (;;) {
+        float y = src[0].line.f32[i];
+        float cb = src[1].line.f32[i], cr = src[2].line.f32[i];
+        float g = y - CT_CNST::GAMMA_CR2G * cr - CT_CNST::GAMMA_CB2G * cb;
+        float r = y + CT_CNST::GAMMA_CR2R * cr;
+        float b = y + CT_CNST::GAMMA_CB2B * cb;
+        if (!is_rounding_tie(r) && !is_rounding_tie(g)
+            && !is_rounding_tie(b))
+          break;
+        src[0].line.f32[i] += tie_nudge;
+      }
+  }
+
+  virtual void run(size_t idx)
+  {
+    funs[idx](&src[0].line, &src[1].line, &src[2].line,
+      &dst[0].line, &dst[1].line, &dst[2].line, 0, colour_bit_depth, false,
+      (ui32)num_samples);
+  }
+  virtual void get_output(std::vector<ui8>& out)
+  { for (int c = 0; c < 3; ++c) dst[c].append_to(out); }
+
+private:
+  test_line src[3], dst[3];
+};
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//
+//                            kernel registry
+//
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+static void add_codeblock_kernels(std::vector<kernel*>& ks, rand_gen& rng,
+                                  ui32 width, ui32 cb_width,
+                                  ui32 cb_height)
+{
+  // K_max and step sizes that keep the quantized samples within range
+  const ui32 K_max = 12, K_max64 = 36;
+  const float delta_inv = (float)(1u << (31 - K_max)) * 1024.0f;
+  const float delta = 1.0f / delta_inv;
+  ui32 cb_stride = (cb_width + 15) & ~15u;
+
+  {
+    mem_clear_kernel* k = new mem_clear_kernel("mem_clear",
+      cb_stride * cb_height * sizeof(ui32));
+    k->add("generic", 0, gen_mem_clear);
+    ADD_SSE(k, sse_mem_clear);
+    ADD_AVX(k, avx_mem_clear);
+    ks.push_back(k);
+  }
+  {
+    find_max_val_kernel<ui32, find_max_val_fun32>* k =
+      new find_max_val_kernel<ui32, find_max_val_fun32>(
+        "find_max_val32", rng);
+    k->add("generic", 0, gen_find_max_val32);
+    ADD_SSE2(k, sse2_find_max_val32);
+    ADD_AVX2(k, avx2_find_max_val32);
+    ks.push_back(k);
+  }
+  {
+    find_max_val_kernel<ui64, find_max_val_fun64>* k =
+      new find_max_val_kernel<ui64, find_max_val_fun64>(
+        "find_max_val64", rng);
+    k->add("generic", 0, gen_find_max_val64);
+    ADD_SSE2(k, sse2_find_max_val64);
+    ADD_AVX2(k, avx2_find_max_val64);
+    ks.push_back(k);
+  }
+
+  typedef tx_to_cb_kernel<ui32, tx_to_cb_fun32> to_cb32;
+  typedef tx_to_cb_kernel<ui64, tx_to_cb_fun64> to_cb64;
+  {
+    to_cb32* k = new to_cb32("rev_tx_to_cb16", rng, LT_I16, width, K_max,
+      delta_inv);
+    k->add("generic", 0, gen_rev_tx_to_cb16);
+    ADD_SSE2(k, sse2_rev_tx_to_cb16);
+    ADD_AVX2(k, avx2_rev_tx_to_cb16);
+    ADD_AVX512(k, avx512_rev_tx_to_cb16);
+    ks.push_back(k);
+  }
+  {
+    to_cb32* k = new to_cb32("rev_tx_to_cb32", rng, LT_I32, width, K_max,
+      delta_inv);
+    k->add("generic", 0, gen_rev_tx_to_cb32);
+    ADD_SSE2(k, sse2_rev_tx_to_cb32);
+    ADD_AVX2(k, avx2_rev_tx_to_cb32);
+    ADD_AVX512(k, avx512_rev_tx_to_cb32);
+    ks.push_back(k);
+  }
+  {
+    to_cb64* k = new to_cb64("rev_tx_to_cb64", rng, LT_I64, width, K_max64,
+      delta_inv);
+    k->add("generic", 0, gen_rev_tx_to_cb64);
+    ADD_SSE2(k, sse2_rev_tx_to_cb64);
+    ADD_AVX2(k, avx2_rev_tx_to_cb64);
+    ADD_AVX512(k, avx512_rev_tx_to_cb64);
+    ks.push_back(k);
+  }
+  {
+    // fixed-point samples, with IRV_FIX_FRAC_BITS fractional bits
+    to_cb32* k = new to_cb32("irv_tx_to_cb16", rng, LT_I16, width,
+      IRV_FIX_FRAC_BITS - 1, delta_inv);
+    k->add("generic", 0, gen_irv_tx_to_cb16);
+    ADD_AVX2(k, avx2_irv_tx_to_cb16);
+    ks.push_back(k);
+  }
+  {
+    to_cb32* k = new to_cb32("irv_tx_to_cb32", rng, LT_F32, width, K_max,
+      delta_inv);
+    k->add("generic", 0, gen_irv_tx_to_cb32);
+    ADD_SSE2(k, sse2_irv_tx_to_cb32);
+    ADD_AVX2(k, avx2_irv_tx_to_cb32);
+    ADD_AVX512(k, avx512_irv_tx_to_cb32);
+    ks.push_back(k);
+  }
+
+  typedef tx_from_cb_kernel<ui32, tx_from_cb_fun32> from_cb32;
+  typedef tx_from_cb_kernel<ui64, tx_from_cb_fun64> from_cb64;
+  {
+    from_cb32* k = new from_cb32("rev_tx_from_cb16", rng, LT_I16, width,
+      K_max, delta);
+    k->add("generic", 0, gen_rev_tx_from_cb16);
+    ADD_SSE2(k, sse2_rev_tx_from_cb16);
+    ADD_AVX2(k, avx2_rev_tx_from_cb16);
+    ADD_AVX512(k, avx512_rev_tx_from_cb16);
+    ks.push_back(k);
+  }
+  {
+    from_cb32* k = new from_cb32("rev_tx_from_cb32", rng, LT_I32, width,
+      K_max, delta);
+    k->add("generic", 0, gen_rev_tx_from_cb32);
+    ADD_SSE2(k, sse2_rev_tx_from_cb32);
+    ADD_AVX2(k, avx2_rev_tx_from_cb32);
+    ADD_AVX512(k, avx512_rev_tx_from_cb32);
+    ks.push_back(k);
+  }
+  {
+    from_cb64* k = new from_cb64("rev_tx_from_cb64", rng, LT_I64, width,
+      K_max64, delta);
+    k->add("generic", 0, gen_rev_tx_from_cb64);
+    ADD_SSE2(k, sse2_rev_tx_from_cb64);
+    ADD_AVX2(k, avx2_rev_tx_from_cb64);
+    ADD_AVX512(k, avx512_rev_tx_from_cb64);
+    ks.push_back(k);
+  }
+  {
+    from_cb32* k = new from_cb32("irv_tx_from_cb32", rng, LT_F32, width,
+      K_max, delta);
+    k->add("generic", 0, gen_irv_tx_from_cb32);
+    ADD_SSE2(k, sse2_irv_tx_from_cb32);
+    ADD_AVX2(k, avx2_irv_tx_from_cb32);
+    ADD_AVX512(k, avx512_irv_tx_from_cb32);
+    ks.push_back(k);
+  }
+
+  // the encoders and decoders; the decoders consume what the generic
+  // encoder produces
+  {
+    typedef encoder_kernel<ui32, cb_encoder_fun32> enc32;
+    typedef decoder_kernel<ui32, cb_decoder_fun32> dec32;
+    enc32* e = new enc32("encode_cb32", rng, cb_width, cb_height, K_max);
+    e->add("generic", 0, ojph_encode_codeblock32);
+    ADD_AVX2(e, ojph_encode_codeblock_avx2);
+    ADD_AVX512(e, ojph_encode_codeblock_avx512);
+    ks.push_back(e);
+    e->run(0);
+
+    dec32* d = new dec32("decode_cb32", e->get_coded(), e->get_lengths(),
+      cb_width, cb_height, K_max);
+    d->add("generic", 0, ojph_decode_codeblock32);
+    ADD_SSSE3(d, ojph_decode_codeblock_ssse3);
+    ADD_AVX2(d, ojph_decode_codeblock_avx2);
+    ks.push_back(d);
+  }
+  {
+    typedef encoder_kernel<ui64, cb_encoder_fun64> enc64;
+    typedef decoder_kernel<ui64, cb_decoder_fun64> dec64;
+    enc64* e = new enc64("encode_cb64", rng, cb_width, cb_height, K_max64);
+    e->add("generic", 0, ojph_encode_codeblock64);
+    ks.push_back(e);
+    e->run(0);
+
+    dec64* d = new dec64("decode_cb64", e->get_coded(), e->get_lengths(),
+      cb_width, cb_height, K_max64);
+    d->add("generic", 0, ojph_decode_codeblock64);
+    ks.push_back(d);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+static void add_wavelet_kernels(std::vector<kernel*>& ks, rand_gen& rng,
+                                ui32 width, const param_atk* rev53,
+                                const param_atk* irv97)
+{
+  static const char* vert_names[2][2] = {
+    { "rev_vert_step16_ana", "rev_vert_step16_syn" },
+    { "rev_vert_step32_ana", "rev_vert_step32_syn" } };
+  static const char* ana_names[2] = { "rev_horz_ana16", "rev_horz_ana32" };
+  static const char* syn_names[2] = { "rev_horz_syn16", "rev_horz_syn32" };
+  static const line_type rev_types[2] = { LT_I16, LT_I32 };
+
+  for (int t = 0; t < 2; ++t)
+  {
+    for (int s = 0; s < 2; ++s)
+    {
+      vert_step_kernel* k = new vert_step_kernel(vert_names[t][s], rng,
+        rev_types[t], width, rev53->get_step(0), s == 1);
+      k->add("generic", 0, gen_rev_vert_step);
+      ADD_SSE2(k, sse2_rev_vert_step);
+      ADD_AVX2(k, avx2_rev_vert_step);
+      if (t == 1) // not dispatched by the library
+        ADD_AVX512(k, avx512_rev_vert_step);
+      ks.push_back(k);
+    }
+    {
+      horz_ana_kernel* k = new horz_ana_kernel(ana_names[t], rng,
+        rev_types[t], width, rev53);
+      k->add("generic", 0, gen_rev_horz_ana);
+      ADD_SSE2(k, sse2_rev_horz_ana);
+      ADD_AVX2(k, avx2_rev_horz_ana);
+      if (t == 1)
+        ADD_AVX512(k, avx512_rev_horz_ana);
+      ks.push_back(k);
+    }
+    {
+      horz_syn_kernel* k = new horz_syn_kernel(syn_names[t], rng,
+        rev_types[t], width, rev53);
+      k->add("generic", 0, gen_rev_horz_syn);
+      ADD_SSE2(k, sse2_rev_horz_syn);
+      ADD_AVX2(k, avx2_rev_horz_syn);
+      if (t == 1)
+        ADD_AVX512(k, avx512_rev_horz_syn);
+      ks.push_back(k);
+    }
+  }
+
+  static const char* irv_vert_names[2] =
+    { "irv_vert_step_ana", "irv_vert_step_syn" };
+  for (int s = 0; s < 2; ++s)
+  {
+    vert_step_kernel* k = new vert_step_kernel(irv_vert_names[s], rng,
+      LT_F32, width, irv97->get_step(0), s == 1);
+    k->add("generic", 0, gen_irv_vert_step);
+    ADD_SSE(k, sse_irv_vert_step);
+    ADD_AVX(k, avx_irv_vert_step);
+    ADD_AVX512(k, avx512_irv_vert_step);
+    ks.push_back(k);
+  }
+  {
+    vert_times_K_kernel* k = new vert_times_K_kernel("irv_vert_times_K",
+      rng, LT_F32, width, irv97->get_K());
+    k->add("generic", 0, gen_irv_vert_times_K);
+    ADD_SSE(k, sse_irv_vert_times_K);
+    ADD_AVX(k, avx_irv_vert_times_K);
+    ADD_AVX512(k, avx512_irv_vert_times_K);
+    ks.push_back(k);
+  }
+  {
+    horz_ana_kernel* k = new horz_ana_kernel("irv_horz_ana", rng, LT_F32,
+      width, irv97);
+    k->add("generic", 0, gen_irv_horz_ana);
+    ADD_SSE(k, sse_irv_horz_ana);
+    ADD_AVX(k, avx_irv_horz_ana);
+    ADD_AVX512(k, avx512_irv_horz_ana);
+    ks.push_back(k);
+  }
+  {
+    irv_horz_syn_kernel* k = new irv_horz_syn_kernel("irv_horz_syn", rng,
+      LT_F32, width, irv97);
+    k->add("generic", 0, gen_irv_horz_syn);
+    ADD_SSE(k, sse_irv_horz_syn);
+    ADD_AVX(k, avx_irv_horz_syn);
+    ADD_AVX512(k, avx512_irv_horz_syn);
+    ks.push_back(k);
+  }
+
+  // the fixed-point path is only used for analysis
+  {
+    vert_step_kernel* k = new vert_step_kernel("irv_fix_vert_step", rng,
+      LT_I16, width, irv97->get_step(0), false);
+    k->add("generic", 0, gen_irv_fix_vert_step);
+    ADD_AVX2(k, avx2_irv_fix_vert_step);
+    ks.push_back(k);
+  }
+  {
+    vert_times_K_kernel* k = new vert_times_K_kernel(
+      "irv_fix_vert_times_K", rng, LT_I16, width, irv97->get_K());
+    k->add("generic", 0, gen_irv_fix_vert_times_K);
+    ADD_AVX2(k, avx2_irv_fix_vert_times_K);
+    ks.push_back(k);
+  }
+  {
+    horz_ana_kernel* k = new horz_ana_kernel("irv_fix_horz_ana", rng,
+      LT_I16, width, irv97);
+    k->add("generic", 0, gen_irv_fix_horz_ana);
+    ADD_AVX2(k, avx2_irv_fix_horz_ana);
+    ks.push_back(k);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+static void add_colour_kernels(std::vector<kernel*>& ks, rand_gen& rng,
+                               ui32 width)
+{
+  static const char* rev_names[2][2] = {
+    { "rev_convert16", "rev_convert32" },
+    { "rev_convert_nlt_type3_16", "rev_convert_nlt_type3_32" } };
+  static const line_type rev_types[2] = { LT_I16, LT_I32 };
+  for (int n = 0; n < 2; ++n)
+    for (int t = 0; t < 2; ++t)
+    {
+      rev_convert_kernel* k = new rev_convert_kernel(rev_names[n][t], rng,
+        rev_types[t], width, n == 1, n == 1);
+      if (n == 0) {
+        k->add("generic", 0, gen_rev_convert);
+        ADD_SSE2(k, sse2_rev_convert);
+        ADD_AVX2(k, avx2_rev_convert);
+      }
+      else {
+        k->add("generic", 0, gen_rev_convert_nlt_type3);
+        ADD_SSE2(k, sse2_rev_convert_nlt_type3);
+        ADD_AVX2(k, avx2_rev_convert_nlt_type3);
+      }
+      ks.push_back(k);
+    }
+
+  {
+    to_float_kernel* k = new to_float_kernel("irv_convert_to_float", rng,
+      LT_F32, width, false);
+    k->add("generic", 0, gen_irv_convert_to_float);
+    ADD_SSE2(k, sse2_irv_convert_to_float);
+    ADD_AVX2(k, avx2_irv_convert_to_float);
+    ks.push_back(k);
+  }
+  {
+    to_float_kernel* k = new to_float_kernel(
+      "irv_convert_to_float_nlt_type3", rng, LT_F32, width, true);
+    k->add("generic", 0, gen_irv_convert_to_float_nlt_type3);
+    ADD_SSE2(k, sse2_irv_convert_to_float_nlt_type3);
+    ADD_AVX2(k, avx2_irv_convert_to_float_nlt_type3);
+    ks.push_back(k);
+  }
+  {
+    to_integer_kernel* k = new to_integer_kernel("irv_convert_to_integer",
+      rng, width, false);
+    k->add("generic", 0, gen_irv_convert_to_integer);
+    ADD_SSE2(k, sse2_irv_convert_to_integer);
+    ADD_AVX2(k, avx2_irv_convert_to_integer);
+    ks.push_back(k);
+  }
+  {
+    to_integer_kernel* k = new to_integer_kernel(
+      "irv_convert_to_integer_nlt_type3", rng, width, true);
+    k->add("generic", 0, gen_irv_convert_to_integer_nlt_type3);
+    ADD_SSE2(k, sse2_irv_convert_to_integer_nlt_type3);
+    ADD_AVX2(k, avx2_irv_convert_to_integer_nlt_type3);
+    ks.push_back(k);
+  }
+  {
+    to_float_kernel* k = new to_float_kernel("irv_convert_to_fix16", rng,
+      LT_I16, width, false);
+    k->add("generic", 0, gen_irv_convert_to_fix16);
+    ADD_AVX2(k, avx2_irv_convert_to_fix16);
+    ks.push_back(k);
+  }
+
+  static const char* rct_names[2][2] = {
+    { "rct_forward16", "rct_forward32" },
+    { "rct_backward16", "rct_backward32" } };
+  for (int d = 0; d < 2; ++d)
+    for (int t = 0; t < 2; ++t)
+    {
+      line_type src_type = d == 0 ? LT_I32 : rev_types[t];
+      line_type dst_type = d == 0 ? rev_types[t] : LT_I32;
+      rct_kernel* k = new rct_kernel(rct_names[d][t], rng, src_type,
+        dst_type, width);
+      if (d == 0) {
+        k->add("generic", 0, gen_rct_forward);
+        ADD_SSE2(k, sse2_rct_forward);
+        ADD_AVX2(k, avx2_rct_forward);
+      }
+      else {
+        k->add("generic", 0, gen_rct_backward);
+        ADD_SSE2(k, sse2_rct_backward);
+        ADD_AVX2(k, avx2_rct_backward);
+      }
+      ks.push_back(k);
+    }
+
+  {
+    ict_kernel<float, ict_fun>* k = new ict_kernel<float, ict_fun>(
+      "ict_forward", rng, LT_F32, width);
+    k->add("generic", 0, gen_ict_forward);
+    ADD_SSE(k, sse_ict_forward);
+    ADD_AVX(k, avx_ict_forward);
+    ks.push_back(k);
+  }
+  {
+    ict_kernel<float, ict_fun>* k = new ict_kernel<float, ict_fun>(
+      "ict_backward", rng, LT_F32, width);
+    k->add("generic", 0, gen_ict_backward);
+    ADD_SSE(k, sse_ict_backward);
+    ADD_AVX(k, avx_ict_backward);
+    ks.push_back(k);
+  }
+  {
+    ict_kernel<si16, ict_fix16_fun>* k =
+      new ict_kernel<si16, ict_fix16_fun>("ict_forward_fix16", rng,
+        LT_I16, width);
+    k->add("generic", 0, gen_ict_forward_fix16);
+    ADD_AVX2(k, avx2_ict_forward_fix16);
+    ks.push_back(k);
+  }
+
+  static const char* fused_fwd_names[2] =
+    { "rev_convert_rct_forward16", "rev_convert_rct_forward32" };
+  static const char* fused_bwd_names[2] =
+    { "rct_backward_rev_convert16", "rct_backward_rev_convert32" };
+  for (int t = 0; t < 2; ++t)
+  {
+    fused_rev_fwd_kernel* f = new fused_rev_fwd_kernel(fused_fwd_names[t],
+      rng, rev_types[t], width);
+    f->add("generic", 0, gen_rev_convert_rct_forward);
+    ADD_SSE2(f, sse2_rev_convert_rct_forward);
+    ADD_AVX2(f, avx2_rev_convert_rct_forward);
+    ks.push_back(f);
+
+    fused_rev_bwd_kernel* b = new fused_rev_bwd_kernel(fused_bwd_names[t],
+      rng, rev_types[t], width);
+    b->add("generic", 0, gen_rct_backward_rev_convert);
+    ADD_SSE2(b, sse2_rct_backward_rev_convert);
+    ADD_AVX2(b, avx2_rct_backward_rev_convert);
+    ks.push_back(b);
+  }
+  {
+    fused_irv_fwd_kernel* k = new fused_irv_fwd_kernel(
+      "irv_convert_ict_forward", rng, width);
+    k->add("generic", 0, gen_irv_convert_ict_forward);
+    ADD_SSE2(k, sse2_irv_convert_ict_forward);
+    ADD_AVX2(k, avx2_irv_convert_ict_forward);
+    ks.push_back(k);
+  }
+  {
+    fused_irv_bwd_kernel* k = new fused_irv_bwd_kernel(
+      "ict_backward_irv_convert", rng, width);
+    k->add("generic", 0, gen_ict_backward_irv_convert);
+    ADD_SSE2(k, sse2_ict_backward_irv_convert);
+    ADD_AVX2(k, avx2_ict_backward_irv_convert);
+    ks.push_back(k);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//
+//                            checking and timing
+//
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+enum check_result { CHECK_EXACT, CHECK_APPROX, CHECK_MISMATCH };
+
+//////////////////////////////////////////////////////////////////////////////
+// floating-point kernels that use fused multiply-add round differently
+// from the generic ones; their outputs need only agree to a few ulps
+static bool floats_close(const std::vector<ui8>& a, const std::vector<ui8>& b)
+{
+  const float tolerance = 1e-5f;
+  if (a.size() != b.size())
+    return false;
+  for (size_t i = 0; i + sizeof(float) <= a.size(); i += sizeof(float))
+  {
+    float x, y;
+    memcpy(&x, &a[i], sizeof(float));
+    memcpy(&y, &b[i], sizeof(float));
+    if (!(fabsf(x - y) <= tolerance * ojph_max(1.0f, fabsf(x))))
+      return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// runs every implementation of k on fresh inputs and compares its output
+// with that of the generic implementation; returns the number of
+// implementations that differ, and sets results[i] for each of them
+static int check_kernel(kernel* k, std::vector<check_result>& results)
+{
+  std::vector<ui8> ref, out;
+  int num_mismatches = 0;
+  results.assign(k->get_num_impls(), CHECK_EXACT);
+  for (size_t i = 0; i < k->get_num_impls(); ++i)
+  {
+    k->prepare();
+    k->run(i);
+    std::vector<ui8>& dst = i == 0 ? ref : out;
+    dst.clear();
+    k->get_output(dst);
+    if (i > 0 && out != ref) {
+      if (k->has_float_output() && floats_close(ref, out))
+        results[i] = CHECK_APPROX;
+      else {
+        results[i] = CHECK_MISMATCH;
+        ++num_mismatches;
+      }
+    }
+  }
+  return num_mismatches;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+static double time_batch(kernel* k, size_t idx, ui32 reps, bool call)
+{
+  bool in_place = k->is_in_place();
+  std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  for (ui32 r = reps; r > 0; --r) {
+    if (in_place)
+      k->prepare();
+    if (call)
+      k->run(idx);
+  }
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// returns the seconds one call of implementation idx takes, the best of
+// three batches each running for about min_time seconds; for kernels
+// that work in place, the time needed to restore the inputs is deducted
+static double time_kernel(kernel* k, size_t idx, double min_time)
+{
+  ui32 reps = 1;
+  double t = time_batch(k, idx, reps, true);
+  while (t < min_time * 0.25 && reps < 0x40000000u) {
+    reps *= 2;
+    t = time_batch(k, idx, reps, true);
+  }
+  if (t < min_time)
+    reps = (ui32)ojph_min((double)0x7FFFFFFF, reps * min_time / t);
+
+  double best = 1e30, best_prep = 1e30;
+  for (int i = 0; i < 3; ++i) {
+    best = ojph_min(best, time_batch(k, idx, reps, true));
+    if (k->is_in_place())
+      best_prep = ojph_min(best_prep, time_batch(k, idx, reps, false));
+  }
+  if (k->is_in_place())
+    best = ojph_max(best - best_prep, 0.0);
+  return best / reps;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+static bool name_matches(const char* name, char** filters, int num_filters)
+{
+  if (num_filters == 0)
+    return true;
+  for (int i = 0; i < num_filters; ++i)
+    if (strstr(name, filters[i]) != NULL)
+      return true;
+  return false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// builds all kernels for the given sizes
+static void build_kernels(std::vector<kernel*>& ks, ui32 width,
+                          ui32 cb_width, ui32 cb_height,
+                          const param_atk* rev53, const param_atk* irv97)
+{
+  rand_gen rng;
+  add_codeblock_kernels(ks, rng, width, cb_width, cb_height);
+  add_wavelet_kernels(ks, rng, width, rev53, irv97);
+  add_colour_kernels(ks, rng, width);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+static void free_kernels(std::vector<kernel*>& ks)
+{
+  for (size_t i = 0; i < ks.size(); ++i)
+    delete ks[i];
+  ks.clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//
+//                            main
+//
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+struct size_interpreter : public ojph::cli_interpreter::arg_inter_base
+{
+  size_interpreter(ui32& w, ui32& h) : w(w), h(h) {}
+  virtual void operate(const char *str)
+  {
+    unsigned int tw, th;
+    if (sscanf(str, "{%u,%u}", &tw, &th) != 2)
+      throw "could not interpret size; use {width,height}";
+    w = tw; h = th;
+  }
+  ui32& w;
+  ui32& h;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+static bool get_arguments(int argc, char *argv[], ui32& width,
+                          ui32& cb_width, ui32& cb_height,
+                          ui32& time_ms, bool& check_only,
+                          char** filters, int& num_filters,
+                          int max_filters)
+{
+  ojph::cli_interpreter interpreter;
+  interpreter.init(argc, argv);
+
+  size_interpreter block_size(cb_width, cb_height);
+  interpreter.reinterpret("-width", width);
+  interpreter.reinterpret("-block_size", &block_size);
+  interpreter.reinterpret("-time", time_ms);
+  interpreter.reinterpret("-check_only", check_only);
+
+  // the remaining arguments select kernels by name
+  num_filters = 0;
+  ojph::argument t = interpreter.get_argument_zero();
+  t = interpreter.get_next_avail_argument(t);
+  while (t.is_valid()) {
+    if (t.arg[0] == '-' || num_filters >= max_filters) {
+      printf("The following argument was not interpreted: %s\n", t.arg);
+      return false;
+    }
+    filters[num_filters++] = t.arg;
+    t = interpreter.get_next_avail_argument(t);
+  }
+
+  if (width < 2 || cb_width < 1 || cb_height < 1 ||
+      cb_width * cb_height > 4096 || cb_width > 1024 || cb_height > 1024)
+  {
+    printf("Line widths must be at least 2, and codeblocks can have at\n"
+           "most 4096 samples, with a side of at most 1024.\n");
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+int main(int argc, char *argv[])
+{
+  ui32 width = 1920;
+  ui32 cb_width = 64, cb_height = 64;
+  ui32 time_ms = 50;
+  bool check_only = false;
+  const int max_filters = 64;
+  char* filters[max_filters];
+  int num_filters = 0;
+
+  if (argc <= 1)
+    printf(
+    "\nThe following arguments are options:\n"
+    " -width       line width of line kernels (default 1920).\n"
+    " -block_size  {width,height} of codeblocks (default {64,64}).\n"
+    " -time        minimum time, in milliseconds, of each measurement\n"
+    "              (default 50).\n"
+    " -check_only  <true | false> if true, only cross-check kernels\n"
+    "              without timing them.\n"
+    "Other arguments select the kernels whose names contain them; all\n"
+    "kernels are run when none is given.  The output of every SIMD\n"
+    "implementation is compared, bit for bit, with that of the generic\n"
+    "implementation, and the program returns 1 if any differ; floating-\n"
+    "point outputs that agree to within rounding are reported as approx.\n"
+    "\n");
+
+  try {
+    if (!get_arguments(argc, argv, width, cb_width, cb_height, time_ms,
+                       check_only, filters, num_filters, max_filters))
+      return -1;
+
+    param_atk rev53, irv97;
+    rev53.init_rev53();
+    irv97.init_irv97();
+    initialize_block_encoder_tables();
+#if defined(OJPH_KB_X86) && !defined(OJPH_DISABLE_AVX2)
+    if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_AVX2)
+      initialize_block_encoder_tables_avx2();
+#endif
+#if defined(OJPH_KB_X86) && defined(OJPH_ARCH_X86_64) && \
+  !defined(OJPH_DISABLE_AVX512)
+    if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_AVX512)
+      initialize_block_encoder_tables_avx512();
+#endif
+
+    // cross-check first at sizes that exercise the tails of the SIMD
+    // loops, then at the benchmark sizes
+    std::vector<kernel*> ks;
+    std::vector<check_result> results;
+    int num_mismatches = 0;
+    build_kernels(ks, 333, 37, 21, &rev53, &irv97);
+    for (size_t i = 0; i < ks.size(); ++i)
+    {
+      if (!name_matches(ks[i]->get_name(), filters, num_filters))
+        continue;
+      if (check_kernel(ks[i], results) > 0)
+        for (size_t j = 1; j < results.size(); ++j)
+          if (results[j] == CHECK_MISMATCH) {
+            printf("%s/%s differs from generic at odd sizes\n",
+              ks[i]->get_name(), ks[i]->get_isa(j));
+            ++num_mismatches;
+          }
+    }
+    free_kernels(ks);
+
+    build_kernels(ks, width, cb_width, cb_height, &rev53, &irv97);
+    printf("%-34s %-8s %12s %8s  %s\n", "kernel", "isa", "Msamples/s",
+      "speedup", "check");
+    for (size_t i = 0; i < ks.size(); ++i)
+    {
+      kernel* k = ks[i];
+      if (!name_matches(k->get_name(), filters, num_filters))
+        continue;
+      num_mismatches += check_kernel(k, results);
+      double ref_time = 0.0;
+      for (size_t j = 0; j < k->get_num_impls(); ++j)
+      {
+        static const char* check_names[] = { "exact", "approx", "DIFF" };
+        const char* check = j == 0 ? "ref" : check_names[results[j]];
+        if (check_only) {
+          printf("%-34s %-8s %12s %8s  %s\n", k->get_name(),
+            k->get_isa(j), "-", "-", check);
+          continue;
+        }
+        double t = time_kernel(k, j, time_ms * 0.001);
+        if (j == 0)
+          ref_time = t;
+        double rate = t > 0.0 ?
+          (double)k->get_num_samples() / t * 1e-6 : 0.0;
+        double speedup = t > 0.0 ? ref_time / t : 0.0;
+        printf("%-34s %-8s %12.1f %8.2f  %s\n", k->get_name(),
+          k->get_isa(j), rate, speedup, check);
+      }
+    }
+    free_kernels(ks);
+
+    if (num_mismatches > 0) {
+      printf("%d implementation(s) differ from the generic ones\n",
+        num_mismatches);
+      return 1;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    const char *p = e.what();
+    if (strncmp(p, "ojph error", 10) != 0)
+      printf("%s\n", p);
+    exit(-1);
+  }
+  catch (const char* p)
+  {
+    printf("%s\n", p);
+    exit(-1);
+  }
+
+  return 0;
+}
@@ -0,0 +1,522 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_stream_compress.cpp
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "ojph_arg.h"
+#include "ojph_codestream.h"
+#include "ojph_file.h"
+#include "ojph_mem.h"
+#include "ojph_message.h"
+#include "ojph_params.h"
+#include "ojph_sockets.h"
+#include "stream_compress_support.h"
+
+#ifdef OJPH_OS_WINDOWS
+
+#else
+  #include <arpa/inet.h>
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+struct size_interpreter : public ojph::cli_interpreter::arg_inter_base
+{
+  size_interpreter(ojph::size& val) : val(val) {}
+  virtual void operate(const char *str)
+  {
+    const char *next_char = str;
+    if (*next_char != '{')
+      throw "size must start with {";
+    next_char++;
+    char *endptr;
+    val.w = (ojph::ui32)strtoul(next_char, &endptr, 10);
+    if (endptr == next_char)
+      throw "size number is improperly formatted";
+    next_char = endptr;
+    if (*next_char != ',')
+      throw "size must have a "","" between the two numbers";
+    next_char++;
+    val.h = (ojph::ui32)strtoul(next_char, &endptr, 10);
+    if (endptr == next_char)
+      throw "number is improperly formatted";
+    next_char = endptr;
+    if (*next_char != '}')
+      throw "size must end with }";
+    next_char++;
+    if (*next_char != '\0') //must be end of string
+      throw "size has extra characters";
+  }
+  ojph::size& val;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+struct point_interpreter : public ojph::cli_interpreter::arg_inter_base
+{
+  point_interpreter(ojph::point& val) : val(val) {}
+  virtual void operate(const char *str)
+  {
+    const char *next_char = str;
+    if (*next_char != '{')
+      throw "size must start with {";
+    next_char++;
+    char *endptr;
+    val.x = (ojph::ui32)strtoul(next_char, &endptr, 10);
+    if (endptr == next_char)
+      throw "size number is improperly formatted";
+    next_char = endptr;
+    if (*next_char != ',')
+      throw "size must have a "","" between the two numbers";
+    next_char++;
+    val.y = (ojph::ui32)strtoul(next_char, &endptr, 10);
+    if (endptr == next_char)
+      throw "number is improperly formatted";
+    next_char = endptr;
+    if (*next_char != '}')
+      throw "size must end with }";
+    next_char++;
+    if (*next_char != '\0') //must be end of string
+      throw "size has extra characters";
+  }
+  ojph::point& val;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+static
+bool get_arguments(int argc, char *argv[], char *&input_filename,
+                   ojph::size& dims, ojph::ui32& num_comps,
+                   ojph::point& downsampling, ojph::ui32& bit_depth,
+                   bool& reversible, float& quantization_step,
+                   ojph::ui32& num_decompositions, ojph::size& block_size,
+                   char *&dest_addr, char *&dest_port,
+                   ojph::ui32& packet_size, ojph::ui32& batch_size,
+                   ojph::ui32& payload_type, float& fps, float& bitrate,
+                   ojph::ui32& num_frames, bool& quiet)
+{
+  ojph::cli_interpreter interpreter;
+  interpreter.init(argc, argv);
+
+  interpreter.reinterpret("-i", input_filename);
+  interpreter.reinterpret("-num_comps", num_comps);
+  interpreter.reinterpret("-bit_depth", bit_depth);
+  interpreter.reinterpret("-reversible", reversible);
+  interpreter.reinterpret("-qstep", quantization_step);
+  interpreter.reinterpret("-num_decomps", num_decompositions);
+  interpreter.reinterpret("-addr", dest_addr);
+  interpreter.reinterpret("-port", dest_port);
+  interpreter.reinterpret("-packet_size", packet_size);
+  interpreter.reinterpret("-batch", batch_size);
+  interpreter.reinterpret("-pt", payload_type);
+  interpreter.reinterpret("-fps", fps);
+  interpreter.reinterpret("-bitrate", bitrate);
+  interpreter.reinterpret("-num_frames", num_frames);
+
+  quiet = interpreter.reinterpret("-quiet");
+
+  size_interpreter dims_interpreter(dims);
+  point_interpreter downsamp_interpreter(downsampling);
+  size_interpreter block_interpreter(block_size);
+  try
+  {
+    interpreter.reinterpret("-dims", &dims_interpreter);
+    interpreter.reinterpret("-downsamp", &downsamp_interpreter);
+    interpreter.reinterpret("-block_size", &block_interpreter);
+  }
+  catch (const char *s)
+  {
+    printf("%s\n",s);
+    return false;
+  }
+
+  if (interpreter.is_exhausted() == false) {
+    printf("The following arguments were not interpreted:\n");
+    ojph::argument t = interpreter.get_argument_zero();
+    t = interpreter.get_next_avail_argument(t);
+    while (t.is_valid()) {
+      printf("%s\n", t.arg);
+      t = interpreter.get_next_avail_argument(t);
+    }
+    return false;
+  }
+
+  if (input_filename == NULL)
+  {
+    printf("Please use \"-i\" to provide an input file name.\n");
+    return false;
+  }
+  if (dims.w == 0 || dims.h == 0)
+  {
+    printf("Please use \"-dims\" to provide the image dimensions.\n");
+    return false;
+  }
+  if (num_comps != 1 && num_comps != 3)
+  {
+    printf("Please set \"-num_comps\" to 1 or 3.\n");
+    return false;
+  }
+  if (downsampling.x == 0 || downsampling.y == 0)
+  {
+    printf("Please set \"-downsamp\" to 1 or more in each direction.\n");
+    return false;
+  }
+  if (bit_depth < 1 || bit_depth > 16)
+  {
+    printf("Please set \"-bit_depth\" to a number from 1 to 16.\n");
+    return false;
+  }
+  if (dest_addr == NULL)
+  {
+    printf("Please use \"-addr\" to provide a destination address, "
+      "\"localhost\" or an IPv4 address.\n");
+    return false;
+  }
+  if (dest_port == NULL)
+  {
+    printf("Please use \"-port\" to provide a port number.\n");
+    return false;
+  }
+  ojph::ui32 header_size = ojph::stco::rtp_packetizer::header_size;
+  if (packet_size <= header_size || packet_size > 2048)
+  {
+    printf("Please set \"-packet_size\" to a number larger than %d, and "
+      "not larger than 2048, the largest packet ojph_stream_expand "
+      "accepts.\n", header_size);
+    return false;
+  }
+  if (batch_size < 1)
+  {
+    printf("Please set \"-batch\" to 1 or more.\n");
+    return false;
+  }
+  if (payload_type > 127)
+  {
+    printf("Please set \"-pt\" to a number from 0 to 127.\n");
+    return false;
+  }
+  if (fps <= 0.0f)
+  {
+    printf("Please set \"-fps\" to a positive number.\n");
+    return false;
+  }
+  if (bitrate < 0.0f)
+  {
+    printf("Please set \"-bitrate\" to 0 or a positive number.\n");
+    return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// sets the parameters of a codestream that is fresh from restart()
+static
+void set_params(ojph::codestream& codestream, const ojph::size& dims,
+                ojph::ui32 num_comps, const ojph::point& downsampling,
+                ojph::ui32 bit_depth, bool reversible,
+                float quantization_step, ojph::ui32 num_decompositions,
+                const ojph::size& block_size)
+{
+  ojph::param_siz siz = codestream.access_siz();
+  siz.set_image_extent(ojph::point(dims.w, dims.h));
+  siz.set_num_components(num_comps);
+  for (ojph::ui32 c = 0; c < num_comps; ++c)
+    siz.set_component(c, c == 0 ? ojph::point(1, 1) : downsampling,
+                      bit_depth, false);
+
+  ojph::param_cod cod = codestream.access_cod();
+  cod.set_num_decomposition(num_decompositions);
+  cod.set_block_dims(block_size.w, block_size.h);
+  cod.set_reversible(reversible);
+  cod.set_color_transform(false);
+  if (!reversible && quantization_step > 0.0f)
+    codestream.access_qcd().set_irrev_quant(quantization_step);
+  codestream.set_planar(true);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// encodes one planar frame, with samples of 1 byte for bit depths up to 8
+// and of 2 bytes otherwise, into j2c_file, returning the main header size
+static
+size_t encode_frame(ojph::codestream& codestream, const ojph::ui8* frame,
+                    ojph::ui32 bytes_per_sample, ojph::mem_outfile& j2c_file)
+{
+  j2c_file.open();
+  codestream.write_headers(&j2c_file);
+  size_t main_header_size = (size_t)j2c_file.tell();
+
+  ojph::param_siz siz = codestream.access_siz();
+  ojph::ui32 next_comp;
+  ojph::line_buf* cur_line = codestream.exchange(NULL, next_comp);
+  for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
+  {
+    ojph::ui32 width = siz.get_recon_width(c);
+    ojph::ui32 height = siz.get_recon_height(c);
+    for (ojph::ui32 i = height; i > 0; --i)
+    {
+      ojph::si32* dp = cur_line->i32;
+      if (bytes_per_sample == 1)
+        for (ojph::ui32 x = width; x > 0; --x)
+          *dp++ = (ojph::si32)*frame++;
+      else
+      {
+        const ojph::ui16* sp = (const ojph::ui16*)frame;
+        for (ojph::ui32 x = width; x > 0; --x)
+          *dp++ = (ojph::si32)*sp++;
+        frame += 2 * (size_t)width;
+      }
+      cur_line = codestream.exchange(cur_line, next_comp);
+    }
+  }
+  codestream.flush();
+  codestream.close(); // closes j2c_file, keeping its data
+  return main_header_size;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[]) {
+  char *input_filename = NULL;
+  ojph::size dims(0, 0);
+  ojph::ui32 num_comps = 3;
+  ojph::point downsampling(1, 1);
+  ojph::ui32 bit_depth = 8;
+  bool reversible = false;
+  float quantization_step = -1.0f;
+  ojph::ui32 num_decompositions = 5;
+  ojph::size block_size(64, 64);
+  char *dest_addr = NULL;
+  char *dest_port = NULL;
+  ojph::ui32 packet_size = 1400;
+  ojph::ui32 batch_size = 32;
+  ojph::ui32 payload_type = 96;
+  float fps = 30.0f;
+  float bitrate = 0.0f;
+  ojph::ui32 num_frames = 0;
+  bool quiet = false;
+
+  if (argc <= 1) {
+    printf(
+    "\nThe following arguments are necessary:\n"
+    " -i             <string> input file name, a raw file of planar frames,\n"
+    "                such as yuv; samples are 1 byte for bit depths up to\n"
+    "                8, and 2 bytes, in the machine's byte order,\n"
+    "                otherwise.  The whole file is read into memory before\n"
+    "                sending starts.\n"
+    " -dims          {x,y} image dimensions, for example {1920,1080}\n"
+    " -addr          <string> destination IPv4 address, \"localhost\" or\n"
+    "                the address of the receiving machine.\n"
+    " -port          <integer> destination port number.\n"
+    "\n"
+    "The following arguments are options:\n"
+    " -num_comps     <integer> 1 or 3 components; the default is 3.\n"
+    " -downsamp      {x,y} downsampling of components 1 and 2; for\n"
+    "                example, {2,2} for 4:2:0 and {2,1} for 4:2:2.  The\n"
+    "                default is {1,1}.\n"
+    " -bit_depth     <integer> bit depth of the samples; the default is 8.\n"
+    " -reversible    <true | false> true for reversible coding; the\n"
+    "                default is false.\n"
+    " -qstep         <float> quantization step size for irreversible\n"
+    "                coding; the default is the library's.\n"
+    " -num_decomps   <integer> number of decompositions; the default is 5.\n"
+    " -block_size    {x,y} codeblock dimensions; the default is {64,64}.\n"
+    " -fps           <float> frame rate; frames are sent at this rate, and\n"
+    "                time stamps, of the 90 kHz RTP clock, follow it.  The\n"
+    "                default is 30.\n"
+    " -bitrate       <float> rate, in Mbit/s, at which packets are paced;\n"
+    "                it should be larger than the bitrate of the\n"
+    "                codestreams.  The default of 0 sends each frame's\n"
+    "                packets as fast as possible.\n"
+    " -num_frames    <integer> number of frames to send, cycling through\n"
+    "                the input; the default, 0, sends each input frame\n"
+    "                once.\n"
+    " -packet_size   <integer> largest packet size in bytes, including\n"
+    "                the 20 bytes of RTP and payload headers; the default\n"
+    "                is 1400.\n"
+    " -batch         <integer> largest number of packets sent at once, with\n"
+    "                one sendmmsg call on Linux; the default is 32.\n"
+    " -pt            <integer> RTP payload type; the default is 96.\n"
+    " -quiet         use to stop printing informative messages.\n"
+    "\n"
+    );
+    exit(-1);
+  }
+  if (!get_arguments(argc, argv, input_filename, dims, num_comps,
+                     downsampling, bit_depth, reversible, quantization_step,
+                     num_decompositions, block_size, dest_addr, dest_port,
+                     packet_size, batch_size, payload_type, fps, bitrate,
+                     num_frames, quiet))
+  {
+    exit(-1);
+  }
+
+  try {
+    // read the whole input, so that reading does not delay frames
+    ojph::ui32 bytes_per_sample = bit_depth > 8 ? 2 : 1;
+    size_t frame_size = (size_t)dims.w * dims.h;
+    if (num_comps == 3)
+      frame_size += 2 * (size_t)ojph_div_ceil(dims.w, downsampling.x)
+                  * ojph_div_ceil(dims.h, downsampling.y);
+    frame_size *= bytes_per_sample;
+    std::vector<ojph::ui8> source;
+    {
+      FILE *f = fopen(input_filename, "rb");
+      if (f == NULL)
+        OJPH_ERROR(0x04000001, "Unable to open file %s", input_filename);
+      ojph::ojph_fseek(f, 0, SEEK_END);
+      ojph::si64 file_size = ojph::ojph_ftell(f);
+      ojph::ojph_fseek(f, 0, SEEK_SET);
+      size_t num_src = file_size > 0 ? (size_t)file_size / frame_size : 0;
+      source.resize(num_src * frame_size);
+      if (num_src == 0 || fread(source.data(), 1, source.size(), f)
+                          != source.size())
+      {
+        fclose(f);
+        OJPH_ERROR(0x04000002, "File %s does not have a complete frame "
+          "of %zu bytes", input_filename, frame_size);
+      }
+      fclose(f);
+    }
+    ojph::ui32 num_src_frames = (ojph::ui32)(source.size() / frame_size);
+    if (num_frames == 0)
+      num_frames = num_src_frames;
+
+    ojph::net::socket_manager smanager;
+
+    // destination address/port
+    struct sockaddr_in dest;
+    memset(&dest, 0, sizeof(dest));
+    {
+      dest.sin_family = AF_INET;
+      const char *p = dest_addr;
+      const char localhost[] = "127.0.0.1";
+      if (strcmp(dest_addr, "localhost") == 0)
+        p = localhost;
+      int result = inet_pton(AF_INET, p, &dest.sin_addr);
+      if (result != 1)
+        OJPH_ERROR(0x04000003, "Please provide a valid IPv4 address when "
+          "using \"-addr,\" the provided address %s is not valid",
+          dest_addr);
+      ojph::ui16 port_number = (ojph::ui16)atoi(dest_port);
+      if (port_number == 0)
+        OJPH_ERROR(0x04000004, "Please provide a valid port number. "
+            "The number you provided is %s", dest_port);
+      dest.sin_port = htons(port_number);
+    }
+
+    // create a socket
+    ojph::net::socket s;
+    s = smanager.create_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s.intern() == OJPH_INVALID_SOCKET)
+    {
+      std::string err = smanager.get_last_error_message();
+      OJPH_ERROR(0x04000005, "Could not create socket: %s", err.data());
+    }
+
+    // RTP time stamps and sequence numbers start from the clock
+    ojph::ui64 start = ojph::stco::get_steady_time_ns();
+    ojph::ui32 first_time_stamp = (ojph::ui32)(start / 100000 * 9);
+    ojph::stco::rtp_packetizer packetizer;
+    packetizer.init(payload_type, (ojph::ui32)(start >> 20),
+      packet_size - ojph::stco::rtp_packetizer::header_size,
+      (ojph::ui32)start);
+    ojph::stco::paced_sender sender;
+    sender.init(s.intern(), dest, batch_size, (double)bitrate * 1e6);
+
+    if (!quiet)
+      printf("Sending %d frames of %d x %d to %s, port %d\n", num_frames,
+        dims.w, dims.h, dest_addr, ntohs(dest.sin_port));
+
+    ojph::codestream codestream;
+    ojph::mem_outfile j2c_file;
+    double frame_period = 1e9 / (double)fps;
+    ojph::ui32 late_frames = 0, period_frames = 0;
+    ojph::ui64 encode_time = 0, period_start = start, period_bytes = 0;
+    for (ojph::ui32 i = 0; i < num_frames; ++i)
+    {
+      ojph::ui64 due = start + (ojph::ui64)((double)i * frame_period);
+      ojph::ui64 t0 = ojph::stco::get_steady_time_ns();
+      const ojph::ui8* frame = source.data()
+                             + (size_t)(i % num_src_frames) * frame_size;
+      set_params(codestream, dims, num_comps, downsampling, bit_depth,
+        reversible, quantization_step, num_decompositions, block_size);
+      size_t main_header_size =
+        encode_frame(codestream, frame, bytes_per_sample, j2c_file);
+      codestream.restart();
+      ojph::ui64 t1 = ojph::stco::get_steady_time_ns();
+      encode_time += t1 - t0;
+
+      // send the frame when it is due; a frame finished after its
+      // successor is due is late
+      if (t1 < due)
+        ojph::stco::sleep_until_ns(due);
+      else if (t1 > due + (ojph::ui64)frame_period)
+        ++late_frames;
+      ojph::ui32 time_stamp = first_time_stamp
+        + (ojph::ui32)((double)i * 90000.0 / (double)fps);
+      packetizer.packetize(j2c_file.get_data(), j2c_file.get_used_size(),
+        main_header_size, time_stamp);
+      ojph::ui64 bytes_before = sender.get_bytes_sent();
+      if (!sender.send(packetizer))
+      {
+        std::string err = smanager.get_last_error_message();
+        OJPH_ERROR(0x04000006, "Failed to send data: %s", err.data());
+      }
+      period_bytes += sender.get_bytes_sent() - bytes_before;
+      ++period_frames;
+
+      ojph::ui64 now = ojph::stco::get_steady_time_ns();
+      if (!quiet && (now - period_start >= 1000000000 || i + 1 == num_frames))
+      {
+        double secs = (double)(now - period_start) / 1e9;
+        printf("Frames sent %d, %.2f Mbit/s, encoding %.2f ms/frame, "
+          "late frames %d\n", i + 1, (double)period_bytes * 8e-6 / secs,
+          (double)encode_time / 1e6 / period_frames, late_frames);
+        period_start = now;
+        period_bytes = encode_time = 0;
+        period_frames = 0;
+      }
+    }
+    s.close();
+  }
+  catch (const std::exception& e)
+  {
+    const char *p = e.what();
+    if (strncmp(p, "ojph error", 10) != 0)
+      printf("%s\n", p);
+    exit(-1);
+  }
+
+  return 0;
+}
@@ -0,0 +1,255 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: stream_compress_support.cpp
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#include <cassert>
+#include <cstring>
+#include "stream_compress_support.h"
+
+#ifdef OJPH_OS_LINUX
+  #include <sys/socket.h>
+#endif
+
+namespace ojph
+{
+namespace stco
+{
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+void rtp_packetizer::init(ui32 payload_type, ui32 ssrc, ui32 max_payload,
+                          ui32 first_seq_num)
+{
+  assert(payload_type < 128 && max_payload > 0);
+  this->payload_type = payload_type;
+  this->ssrc = ssrc;
+  this->max_payload = max_payload;
+  this->seq_num = first_seq_num & 0xFFFFFF;
+  num_packets = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+ui32 rtp_packetizer::packetize(const ui8* data, size_t size,
+                               size_t main_header_size, ui32 time_stamp)
+{
+  assert(main_header_size <= size);
+  size_t num_main = (main_header_size + max_payload - 1) / max_payload;
+  size_t body_size = size - main_header_size;
+  size_t num_body = (body_size + max_payload - 1) / max_payload;
+  size_t total = num_main + num_body;
+  size_t stride = header_size + max_payload;
+  if (store.size() < total * stride)
+    store.resize(total * stride);
+  if (sizes.size() < total)
+    sizes.resize(total);
+
+  num_packets = 0;
+  for (size_t i = 0; i < num_main; ++i)
+  {
+    size_t bytes = main_header_size - i * max_payload;
+    bytes = bytes < max_payload ? bytes : max_payload;
+    ui32 type;
+    if (i + 1 < num_main)
+      type = 1; // main packet followed by main
+    else if (num_body)
+      type = 2; // main packet followed by body
+    else
+      type = 3; // the codestream is in one main packet
+    add_packet(type, i + 1 == total, time_stamp, data, (ui32)bytes);
+    data += bytes;
+  }
+  for (size_t i = 0; i < num_body; ++i)
+  {
+    size_t bytes = body_size - i * max_payload;
+    bytes = bytes < max_payload ? bytes : max_payload;
+    add_packet(0, num_main + i + 1 == total, time_stamp, data, (ui32)bytes);
+    data += bytes;
+  }
+  return num_packets;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void rtp_packetizer::add_packet(ui32 type, bool marked, ui32 time_stamp,
+                                const ui8* data, ui32 size)
+{
+  ui8* p = store.data() + (size_t)num_packets * (header_size + max_payload);
+
+  // RTP header; version 2, with no padding, extension, or CSRCs
+  p[0] = 0x80;
+  p[1] = (ui8)((marked ? 0x80 : 0) | payload_type);
+  p[2] = (ui8)(seq_num >> 8);
+  p[3] = (ui8)seq_num;
+  p[4] = (ui8)(time_stamp >> 24);
+  p[5] = (ui8)(time_stamp >> 16);
+  p[6] = (ui8)(time_stamp >> 8);
+  p[7] = (ui8)time_stamp;
+  p[8] = (ui8)(ssrc >> 24);
+  p[9] = (ui8)(ssrc >> 16);
+  p[10] = (ui8)(ssrc >> 8);
+  p[11] = (ui8)ssrc;
+
+  // payload header; type, TP = 0 (progressive), ORDH or RES = 0
+  p[12] = (ui8)(type << 6);
+  // for main packets, P = 1 (PTSTAMP is used) and XTRAC = 0; for body
+  // packets, ORDB = 0 and QUAL = 0
+  ui32 ptstamp = time_stamp & 0xFFF;
+  p[13] = (ui8)((type != 0 ? 0x80 : 0) | (ptstamp >> 8));
+  p[14] = (ui8)ptstamp;
+  p[15] = (ui8)(seq_num >> 16); // ESEQ
+  // for main packets, no reusable header, colorimetry, caching, or RANGE;
+  // for body packets, POS and PID are 0
+  p[16] = p[17] = p[18] = p[19] = 0;
+
+  memcpy(p + header_size, data, size);
+  sizes[num_packets++] = header_size + size;
+  seq_num = (seq_num + 1) & 0xFFFFFF;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+paced_sender::paced_sender()
+{
+  s = OJPH_INVALID_SOCKET;
+  memset(&dest, 0, sizeof(dest));
+  batch_size = 0;
+  ns_per_byte = 0.0;
+  next_time = 0;
+  bytes_sent = 0;
+#ifdef OJPH_OS_LINUX
+  msgs = NULL;
+  iovecs = NULL;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+paced_sender::~paced_sender()
+{
+#ifdef OJPH_OS_LINUX
+  if (msgs) delete[] msgs;
+  if (iovecs) delete[] iovecs;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void paced_sender::init(ojph_socket s, const sockaddr_in& dest,
+                        ui32 batch_size, double bits_per_second)
+{
+  assert(this->batch_size == 0 && batch_size > 0);
+  this->s = s;
+  this->dest = dest;
+  this->batch_size = batch_size;
+  ns_per_byte = bits_per_second > 0.0 ? 8e9 / bits_per_second : 0.0;
+#ifdef OJPH_OS_LINUX
+  msgs = new struct mmsghdr[batch_size];
+  iovecs = new struct iovec[batch_size];
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool paced_sender::send(const rtp_packetizer& packets)
+{
+  ui32 num_packets = packets.get_num_packets();
+  for (ui32 first = 0; first < num_packets; )
+  {
+    ui32 count = num_packets - first;
+    count = count < batch_size ? count : batch_size;
+    ui64 bytes = 0;
+    for (ui32 i = 0; i < count; ++i)
+      bytes += packets.get_packet_size(first + i);
+
+    if (ns_per_byte > 0.0)
+    {
+      // time left unused while idle is not saved for later bursts
+      ui64 now = get_steady_time_ns();
+      if (next_time < now)
+        next_time = now;
+      else
+        sleep_until_ns(next_time);
+      next_time += (ui64)((double)bytes * ns_per_byte);
+    }
+
+#ifdef OJPH_OS_LINUX
+    memset(msgs, 0, count * sizeof(struct mmsghdr));
+    for (ui32 i = 0; i < count; ++i)
+    {
+      iovecs[i].iov_base = (void*)packets.get_packet(first + i);
+      iovecs[i].iov_len = packets.get_packet_size(first + i);
+      msgs[i].msg_hdr.msg_iov = iovecs + i;
+      msgs[i].msg_hdr.msg_iovlen = 1;
+      msgs[i].msg_hdr.msg_name = &dest;
+      msgs[i].msg_hdr.msg_namelen = sizeof(dest);
+    }
+    ui32 sent = 0;
+    while (sent < count)
+    {
+      int num = sendmmsg(s, msgs + sent, count - sent, 0);
+      if (num == -1) {
+        if (errno == EINTR)
+          continue;
+        return false;
+      }
+      sent += (ui32)num;
+    }
+#else
+    for (ui32 i = 0; i < count; ++i)
+    {
+      int num = (int)sendto(s, (const char*)packets.get_packet(first + i),
+                            (int)packets.get_packet_size(first + i), 0,
+                            (const sockaddr*)&dest, sizeof(dest));
+      if (num < 0)
+        return false;
+    }
+#endif
+    bytes_sent += bytes;
+    first += count;
+  }
+  return true;
+}
+
+} // !stco namespace
+} // !ojph namespace
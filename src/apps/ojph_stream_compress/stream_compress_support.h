@@ -0,0 +1,239 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: stream_compress_support.h
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#ifndef OJPH_STR_CO_SUPPORT_H
+#define OJPH_STR_CO_SUPPORT_H
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "ojph_base.h"
+#include "ojph_sockets.h"
+
+namespace ojph
+{
+namespace stco // stream compress
+{
+
+/*****************************************************************************/
+/** @brief returns the time of a steady clock in nanoseconds; used for
+ *         frame timing and packet pacing.
+ */
+inline ui64 get_steady_time_ns()
+{
+  using namespace std::chrono;
+  return (ui64)duration_cast<nanoseconds>(
+    steady_clock::now().time_since_epoch()).count();
+}
+
+/*****************************************************************************/
+/** @brief sleeps until get_steady_time_ns() reaches time_ns
+ */
+inline void sleep_until_ns(ui64 time_ns)
+{
+  using namespace std::chrono;
+  std::this_thread::sleep_until(
+    steady_clock::time_point(
+      duration_cast<steady_clock::duration>(nanoseconds(time_ns))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*****************************************************************************/
+/** @brief Splits j2k codestreams into RTP packets.
+ *
+ *  This object produces the packets that ojph_stream_expand's rtp_packet
+ *  interprets, following RFC 9828 (draft-ietf-avtcore-rtp-j2k-scl).  The
+ *  codestream main header is carried in main packets, and the rest of the
+ *  codestream in body packets; the last packet of a codestream is marked.
+ *  ORDH is 0, meaning that no particular ordering of body packets is
+ *  signalled, and therefore the RES, QUAL, POS and PID fields of body
+ *  packets are 0.  PTSTAMP holds the 12 least-significant bits of the time
+ *  stamp, and sequence numbers are 24 bits, extended by ESEQ.
+ */
+class rtp_packetizer
+{
+public:
+  static constexpr ui32 header_size = 20; //!<RTP header + payload header
+
+public:
+  /**
+   *  @brief default constructor
+   */
+  rtp_packetizer()
+  {
+    payload_type = ssrc = max_payload = seq_num = num_packets = 0;
+  }
+
+public:
+  /**
+   *  @brief call this function to initialize this object
+   *
+   *  @param payload_type the RTP payload type, a dynamic type in 96-127
+   *  @param ssrc the RTP synchronization source identifier
+   *  @param max_payload the largest number of codestream bytes in a
+   *         packet, excluding the header_size header bytes
+   *  @param first_seq_num the sequence number of the first packet
+   */
+  void init(ui32 payload_type, ui32 ssrc, ui32 max_payload,
+            ui32 first_seq_num);
+
+  /**
+   *  @brief call this function to split one codestream into packets,
+   *         replacing the packets of the previous codestream
+   *
+   *  @param data the codestream
+   *  @param size the number of bytes in the codestream
+   *  @param main_header_size the number of bytes in the main header
+   *  @param time_stamp the RTP time stamp of the codestream
+   *  @return the number of packets
+   */
+  ui32 packetize(const ui8* data, size_t size, size_t main_header_size,
+                 ui32 time_stamp);
+
+  /**
+   *  @brief returns the number of packets of the last codestream
+   */
+  ui32 get_num_packets() const { return num_packets; }
+
+  /**
+   *  @brief returns a pointer to packet i of the last codestream
+   */
+  const ui8* get_packet(ui32 i) const
+  { return store.data() + (size_t)i * (header_size + max_payload); }
+
+  /**
+   *  @brief returns the number of bytes in packet i of the last codestream
+   */
+  ui32 get_packet_size(ui32 i) const { return sizes[i]; }
+
+private:
+  /**
+   *  @brief adds a packet, with its headers, to store
+   */
+  void add_packet(ui32 type, bool marked, ui32 time_stamp,
+                  const ui8* data, ui32 size);
+
+private:
+  ui32 payload_type;        //!<RTP payload type
+  ui32 ssrc;                //!<RTP synchronization source identifier
+  ui32 max_payload;         //!<largest number of codestream bytes a packet
+  ui32 seq_num;             //!<sequence number of the next packet
+  ui32 num_packets;         //!<number of packets of the last codestream
+  std::vector<ui8> store;   //!<packets, header_size + max_payload apart
+  std::vector<ui32> sizes;  //!<number of bytes in each packet
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*****************************************************************************/
+/** @brief Sends packets to one destination at a target bitrate.
+ *
+ *  Packets are sent in batches, using one sendmmsg call per batch on
+ *  Linux, and one sendto call per packet elsewhere.  Before each batch,
+ *  the object sleeps until the batch is due at the target bitrate, so that
+ *  packets leave evenly spaced instead of in bursts that overflow switch
+ *  and receiver buffers.  Time left unused, because there was nothing to
+ *  send, is not saved for later bursts.
+ */
+class paced_sender
+{
+public:
+  /**
+   *  @brief default constructor
+   */
+  paced_sender();
+  /**
+   *  @brief default destructor
+   */
+  ~paced_sender();
+
+public:
+  /**
+   *  @brief call this function to initialize this object
+   *
+   *  @param s the socket through which packets are sent
+   *  @param dest the destination address and port
+   *  @param batch_size the largest number of packets sent at once
+   *  @param bits_per_second the target bitrate, or 0 for sending packets
+   *         as fast as possible
+   */
+  void init(ojph_socket s, const sockaddr_in& dest, ui32 batch_size,
+            double bits_per_second);
+
+  /**
+   *  @brief call this function to send all the packets of a codestream
+   *
+   *  @param packets the packets
+   *  @return returns false on error, with the error in errno, or
+   *          GetLastError() on Windows
+   */
+  bool send(const rtp_packetizer& packets);
+
+  /**
+   *  @brief returns the number of bytes sent so far
+   */
+  ui64 get_bytes_sent() const { return bytes_sent; }
+
+private:
+  ojph_socket s;            //!<the sending socket
+  sockaddr_in dest;         //!<the destination
+  ui32 batch_size;          //!<the largest number of packets in a batch
+  double ns_per_byte;       //!<the time a byte takes at the target rate
+  ui64 next_time;           //!<steady clock time at which the next batch
+                            //!<is due, in nanoseconds
+  ui64 bytes_sent;          //!<number of bytes sent so far
+#ifdef OJPH_OS_LINUX
+  struct mmsghdr* msgs;     //!<one message header per packet
+  struct iovec* iovecs;     //!<one buffer descriptor per packet
+#endif
+};
+
+} // !stco namespace
+} // !ojph namespace
+
+#endif // !OJPH_STR_CO_SUPPORT_H
@@ -35,11 +35,14 @@
 // Date: 17 April 2024
 //***************************************************************************/
 
+#include <ctime>
 #include <iostream>
+#include <vector>
 #include "ojph_message.h"
 #include "ojph_arg.h"
 #include "ojph_sockets.h"
 #include "ojph_threads.h"
+#include "ojph_trace.h"
 #include "stream_expand_support.h"
 
 #ifdef OJPH_OS_WINDOWS
@@ -56,7 +59,10 @@ bool get_arguments(int argc, char *argv[],
                    char *&target_name, ojph::ui32& num_threads, 
                    ojph::ui32& num_inflight_packets,
                    ojph::ui32& recvfrm_buf_size, bool& blocking,
-                   bool& quiet)
+                   bool& quiet, char *&trace_name, bool& decode,
+                   ojph::ui32& deadline_ms, ojph::ui32& batch_size,
+                   bool& timestamps, ojph::ui32& reorder_packets,
+                   ojph::ui32& reorder_us)
 {
   ojph::cli_interpreter interpreter;
   interpreter.init(argc, argv);
@@ -69,9 +75,16 @@ bool get_arguments(int argc, char *argv[],
   interpreter.reinterpret("-num_threads", num_threads);
   interpreter.reinterpret("-num_packets", num_inflight_packets);
   interpreter.reinterpret("-recv_buf_size", recvfrm_buf_size);
+  interpreter.reinterpret("-trace", trace_name);
+  interpreter.reinterpret("-deadline", deadline_ms);
+  interpreter.reinterpret("-batch", batch_size);
+  interpreter.reinterpret("-reorder_packets", reorder_packets);
+  interpreter.reinterpret("-reorder_us", reorder_us);
 
   blocking = interpreter.reinterpret("-blocking");
   quiet = interpreter.reinterpret("-quiet");
+  decode = interpreter.reinterpret("-decode");
+  timestamps = interpreter.reinterpret("-timestamps");
 
   if (interpreter.is_exhausted() == false) {
     printf("The following arguments were not interpreted:\n");
@@ -105,10 +118,109 @@ bool get_arguments(int argc, char *argv[],
     printf("Please set \"-num_packets\" to 1 or more.\n");
     return false;
   }
+  if (batch_size < 1)
+  {
+    printf("Please set \"-batch\" to 1 or more.\n");
+    return false;
+  }
+#ifndef OJPH_OS_LINUX
+  if (batch_size > 1 || timestamps)
+  {
+    printf("\"-batch\" and \"-timestamps\" are only available on Linux.\n");
+    return false;
+  }
+#endif
+  if (timestamps && batch_size < 2)
+  {
+    printf("\"-timestamps\" needs \"-batch\" of 2 or more.\n");
+    return false;
+  }
 
   return true;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// returns true if the packet came from the source set by -src_addr and
+// -src_port, printing the source otherwise
+static
+bool is_expected_source(ojph::net::socket_manager& smanager,
+                        const struct sockaddr_in& si_other,
+                        const char *src_addr, ojph::ui32 saddr,
+                        const char *src_port, ojph::ui16 sport)
+{
+  if ((src_addr && saddr != smanager.get_addr(si_other)) ||
+    (src_port && sport != si_other.sin_port)) {
+    constexpr int buf_size = 128;
+    char buf[buf_size];
+    ojph::ui32 addr = smanager.get_addr(si_other);
+    const char* t = inet_ntop(AF_INET, &addr, buf, buf_size);
+    if (t == NULL) {
+      std::string err = smanager.get_last_error_message();
+      OJPH_INFO(0x02000004,
+        "Error converting source address: %s", err.data());
+    }
+    printf("Source mismatch %s, port %d\n",
+      t, ntohs(si_other.sin_port));
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+static
+void print_source(ojph::net::socket_manager& smanager,
+                  const struct sockaddr_in& si_other)
+{
+  constexpr int buf_size = 128;
+  char buf[buf_size];
+  ojph::ui32 addr = smanager.get_addr(si_other);
+  const char* t = inet_ntop(AF_INET, &addr, buf, buf_size);
+  if (t == NULL) {
+    std::string err = smanager.get_last_error_message();
+    OJPH_INFO(0x02000005, 
+      "Error converting source address: %s", err.data());
+  }
+  printf("Receiving data from %s, port %d\n",
+    t, ntohs(si_other.sin_port));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// max_delay_ms is printed when it is not negative
+static
+void print_stats(const ojph::stex::packets_handler& packets_handler,
+                 ojph::stex::frames_handler& frames_handler, bool decode,
+                 double max_delay_ms)
+{
+  ojph::ui32 lost_packets = packets_handler.get_num_lost_packets();
+  ojph::ui32 total_frames = 0, trunc_frames = 0, lost_frames = 0;
+  frames_handler.get_stats(total_frames, trunc_frames, lost_frames);
+
+  printf("Total frame %d, truncated frames %d, lost frames %d, "
+    "packets lost %d",
+    total_frames, trunc_frames, lost_frames, lost_packets);
+  if (decode) {
+    ojph::ui32 decoded = 0, failed = 0, misses = 0;
+    frames_handler.get_decode_stats(decoded, failed, misses);
+    printf(", decoded %d, failed %d, deadline misses %d",
+      decoded, failed, misses);
+  }
+  if (max_delay_ms >= 0.0)
+    printf(", max socket delay %.3f ms", max_delay_ms);
+  printf("\n");
+}
+
+#ifdef OJPH_OS_LINUX
+//////////////////////////////////////////////////////////////////////////////
+// the clock of SO_TIMESTAMPNS
+static
+ojph::ui64 get_wall_time_ns()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return (ojph::ui64)ts.tv_sec * 1000000000 + (ojph::ui64)ts.tv_nsec;
+}
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
@@ -122,6 +234,13 @@ int main(int argc, char* argv[])
   ojph::ui32 recvfrm_buf_size = 65536;
   bool blocking = false;
   bool quiet = false;
+  char *trace_name = NULL;
+  bool decode = false;
+  ojph::ui32 deadline_ms = 0;
+  ojph::ui32 batch_size = 1;
+  bool timestamps = false;
+  ojph::ui32 reorder_packets = 0;
+  ojph::ui32 reorder_us = 0;
 	
   if (argc <= 1) {
     printf(
@@ -160,29 +279,75 @@ int main(int argc, char* argv[])
     "                number of threads + 1\n"
     " -num_packets   <integer> number of in-flight packets; this is a\n"
     "                window of packets in which packets can be re-ordered.\n"
+    " -reorder_packets <integer> a packet that arrives after this window\n"
+    "                is normally lost, truncating its frame.  With this\n"
+    "                option, the frame waits for the packet, and puts it\n"
+    "                in place if it arrives within this number of packets\n"
+    "                of the one it should precede.  The default is 0, for\n"
+    "                no waiting unless \"-reorder_us\" is given.\n"
+    " -reorder_us    <integer> the same as \"-reorder_packets\", but the\n"
+    "                frame waits up to this number of microseconds; when\n"
+    "                both are given, the wait ends with the first limit.\n"
     " -o             <string> target file name without extension; the same\n"
     "                printf formating can be used. For example,\n"
     "                output_%%05d. An extension will be added, either .j2c\n"
-    "                for original frames, or .ppm for decoded images.\n"
-    " -quiet         use to stop printing informative messages.\n."
+    "                for original frames, or .yuv for decoded images.\n"
+    " -decode        decodes each frame as it is completed, using the\n"
+    "                threads; the decoded images are saved only if \"-o\"\n"
+    "                is given, as planar raw samples, of 8 bits for bit\n"
+    "                depths up to 8, and of 16 bits otherwise.  Decoded\n"
+    "                frames and deadline misses are added to the printed\n"
+    "                statistics.\n"
+    " -deadline      <integer> time in milliseconds, from the completion of\n"
+    "                a frame's reception, within which it must be decoded;\n"
+    "                the default is the number of threads times the frame\n"
+    "                period.\n"
+    " -batch         <integer> (Linux only) number of packets received\n"
+    "                with one recvmmsg call; the default is 1, which uses\n"
+    "                recvfrom.  With 2 or more, the thread sleeps in poll\n"
+    "                when no packets are waiting, regardless of\n"
+    "                \"-blocking\".  Numbers such as 32 or 64 reduce the\n"
+    "                system call cost of high-rate streams.\n"
+    " -timestamps    (Linux only) captures the kernel receive time of\n"
+    "                packets, and prints the largest time a packet waited\n"
+    "                in the receive buffer with the statistics; this needs\n"
+    "                \"-batch\".\n"
+    " -quiet         use to stop printing informative messages.\n"
+    " -trace         <string> records the work of the worker threads into\n"
+    "                this file, in the Chrome trace JSON format, which\n"
+    "                can be opened in Perfetto (ui.perfetto.dev).\n"
     "\n"
     );
     exit(-1);
   }
   if (!get_arguments(argc, argv, recv_addr, recv_port, src_addr, src_port,
                      target_name, num_threads, num_inflight_packets,
-                     recvfrm_buf_size, blocking, quiet))
+                     recvfrm_buf_size, blocking, quiet, trace_name,
+                     decode, deadline_ms, batch_size, timestamps,
+                     reorder_packets, reorder_us))
   {
     exit(-1);
   }
 
   try {
+    ojph::trace_sink trace;     // must outlive the thread pool
     ojph::thds::thread_pool thread_pool;
+    if (trace_name)
+    {
+      if (!trace.open(trace_name))
+        OJPH_ERROR(0x02000007, "Could not create trace file %s",
+          trace_name);
+      trace.set_thread_name("receiver");
+      thread_pool.set_trace_sink(&trace);
+    }
     thread_pool.init(num_threads);
     ojph::stex::frames_handler frames_handler;
-    frames_handler.init(quiet, target_name, &thread_pool);
+    frames_handler.init(quiet, target_name, decode, deadline_ms,
+      &thread_pool);
+    frames_handler.set_reorder_window(reorder_packets, reorder_us);
     ojph::stex::packets_handler packets_handler;
-    packets_handler.init(quiet, num_inflight_packets, &frames_handler);
+    packets_handler.init(quiet, num_inflight_packets, &frames_handler,
+      batch_size);
     ojph::net::socket_manager smanager;
 
     // listening address/port
@@ -280,11 +445,70 @@ int main(int argc, char* argv[])
     }
 
     // listen to incoming data, and forward it to packet_handler
+    bool src_printed = false;
+    ojph::ui32 last_time_stamp = 0;
+#ifdef OJPH_OS_LINUX
+    if (batch_size > 1)
+    {
+      ojph::stex::batch_receiver receiver;
+      if (!receiver.init(s.intern(), batch_size, timestamps))
+      {
+        std::string err = smanager.get_last_error_message();
+        OJPH_ERROR(0x0200000A,
+          "Could not configure socket for batched reception: %s",
+          err.data());
+      }
+      std::vector<ojph::stex::rtp_packet*> slots(batch_size);
+      ojph::ui64 max_delay = 0; // largest time a packet waited in the kernel
+      while (1)
+      {
+        ojph::ui32 num_slots =
+          packets_handler.reserve_packets(slots.data(), batch_size);
+        int num = receiver.receive(slots.data(), num_slots, 100);
+        if (num < 0)
+        {
+          std::string err = smanager.get_last_error_message();
+          OJPH_INFO(0x02000006, "Failed to receive data: %s", err.data());
+          num = 0;
+        }
+
+        ojph::ui64 now = timestamps ? get_wall_time_ns() : 0;
+        ojph::ui32 time_stamp = last_time_stamp;
+        for (int i = 0; i < num; ++i)
+        {
+          ojph::stex::rtp_packet* packet = slots[(size_t)i];
+          const sockaddr_in& source = receiver.get_source((ojph::ui32)i);
+          if (!is_expected_source(smanager, source, src_addr, saddr,
+                                  src_port, sport)) {
+            packet->num_bytes = 0;
+            continue;
+          }
+          if (!quiet && !src_printed) {
+            print_source(smanager, source);
+            src_printed = true;
+          }
+          if (packet->rx_time != 0 && now > packet->rx_time)
+            max_delay = ojph_max(max_delay, now - packet->rx_time);
+          time_stamp = packet->get_time_stamp();
+          if (last_time_stamp == 0)
+            last_time_stamp = time_stamp;
+        }
+        packets_handler.push_packets(slots.data(), num_slots);
+
+        if (!quiet)
+          if (time_stamp >= last_time_stamp + 45000)
+          { // One second is 90000
+            last_time_stamp = time_stamp;
+            print_stats(packets_handler, frames_handler, decode,
+              timestamps ? (double)max_delay / 1e6 : -1.0);
+            max_delay = 0;
+          }
+      }
+    }
+#endif
     struct sockaddr_in si_other;
     socklen_t socklen = sizeof(si_other);
-    bool src_printed = false;
     ojph::stex::rtp_packet* packet = NULL;
-    ojph::ui32 last_time_stamp = 0;
     while (1)
     {
       if (packet == NULL || packet->num_bytes != 0)
@@ -308,21 +532,9 @@ int main(int argc, char* argv[])
         continue; // if we wish to continue
       }
 
-      if ((src_addr && saddr != smanager.get_addr(si_other)) ||
-        (src_port && sport != si_other.sin_port)) {
-        constexpr int buf_size = 128;
-        char buf[buf_size];
-        ojph::ui32 addr = smanager.get_addr(si_other);
-        const char* t = inet_ntop(AF_INET, &addr, buf, buf_size);
-        if (t == NULL) {
-          std::string err = smanager.get_last_error_message();
-          OJPH_INFO(0x02000004,
-            "Error converting source address: %s", err.data());
-        }
-        printf("Source mismatch %s, port %d\n",
-          t, ntohs(si_other.sin_port));
+      if (!is_expected_source(smanager, si_other, src_addr, saddr,
+                              src_port, sport))
         continue;
-      }
 
       packet->num_bytes = (ojph::ui32)num_bytes;
 
@@ -331,17 +543,7 @@ int main(int argc, char* argv[])
 
       if (!quiet && !src_printed)
       {
-        constexpr int buf_size = 128;
-        char buf[buf_size];
-        ojph::ui32 addr = smanager.get_addr(si_other);
-        const char* t = inet_ntop(AF_INET, &addr, buf, buf_size);
-        if (t == NULL) {
-          std::string err = smanager.get_last_error_message();
-          OJPH_INFO(0x02000005, 
-            "Error converting source address: %s", err.data());
-        }
-        printf("Receiving data from %s, port %d\n",
-          t, ntohs(si_other.sin_port));
+        print_source(smanager, si_other);
         src_printed = true;
       }
 
@@ -349,13 +551,7 @@ int main(int argc, char* argv[])
         if (packet->get_time_stamp() >= last_time_stamp + 45000)
         { // One second is 90000
           last_time_stamp = packet->get_time_stamp();
-          ojph::ui32 lost_packets = packets_handler.get_num_lost_packets();
-          ojph::ui32 total_frames = 0, trunc_frames = 0, lost_frames = 0;
-          frames_handler.get_stats(total_frames, trunc_frames, lost_frames);
-
-          printf("Total frame %d, truncated frames %d, lost frames %d, "
-            "packets lost %d\n",
-            total_frames, trunc_frames, lost_frames, lost_packets);
+          print_stats(packets_handler, frames_handler, decode, -1.0);
         }
     }
     s.close();    
@@ -37,10 +37,16 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstring>
 #include "ojph_threads.h"
 #include "threaded_frame_processors.h"
 #include "stream_expand_support.h"
 
+#ifdef OJPH_OS_LINUX
+  #include <poll.h>
+  #include <sys/socket.h>
+#endif
+
 namespace ojph
 {
 namespace stex
@@ -103,9 +109,10 @@ static inline ui32 clip_seq_num(ui32 n) { return (n & 0xFFFFFF); }
 
 ///////////////////////////////////////////////////////////////////////////////
 void packets_handler::init(bool quiet, ui32 num_packets,
-                           frames_handler* frames)
+                           frames_handler* frames, ui32 batch_size)
 { 
-  assert(this->num_packets == 0);
+  assert(this->num_packets == 0 && batch_size > 0);
+  num_packets += batch_size - 1;
   avail = packet_store = new rtp_packet[num_packets];
   ui32 i = 0;
   for (; i < num_packets - 1; ++i)
@@ -124,75 +131,8 @@ rtp_packet* packets_handler::exchange(rtp_packet* p)
   if (p != NULL) {
     if (p->num_bytes == 0)
       return p;
-
-    if (last_seq_num == 0) // initialization
-      last_seq_num = clip_seq_num(p->get_seq_num() - 1);
-
-    // packet is old, and is ignored -- no need to included it in the 
-    // lost packets, because this packet was considered lost previously.
-    // This also captures the case where the previous packet and this packet
-    // has the same sequence number, which is rather weird but possible
-    // if some intermediate network unit retransmits packets.
-    if (is_smaller24(p->get_seq_num(), clip_seq_num(last_seq_num + 1)))
+    if (!process_packet())
       return p;
-    else if (p->get_seq_num() == clip_seq_num(last_seq_num + 1))
-    {
-      consume_packet();
-      // see if we can push one packet from the top of the buffer
-      if (in_use && in_use->get_seq_num() == clip_seq_num(last_seq_num + 1))
-        consume_packet();
-    }
-    else // sequence larger than expected
-    {
-      // Place the packet in the in_use queue according to its sequence
-      // number; we may have to move it down the queue. The in_use queue is 
-      // always arranged in an ascending order, where the top of the queue 
-      // (pointed to by in_use) has the smallest sequence number.
-      if (in_use->next != NULL) // we have more than 1 packet in queue
-      { 
-        rtp_packet* t = in_use;
-        while (t->next != NULL && 
-          is_greater24(p->get_seq_num(), t->next->get_seq_num()))
-          t = t->next;
-
-        if (t->next != NULL && p->get_seq_num() == t->next->get_seq_num())
-        { // this is a repeated packet and must be removed
-          in_use = in_use->next;
-          p->next = avail;
-          avail = p;
-        }
-        else {
-          if (t == in_use) // at front of queue -- exactly where it should be
-          { } // do nothing
-          else if (t->next == NULL) { // at the end of queue
-            in_use = in_use->next; // remove p from the queue
-            t->next = p;
-            p->next = NULL;
-          }
-          else { // in the middle of the queue
-            in_use = in_use->next; // p removed from the start of queue
-            p->next = t->next;
-            t->next = p;
-          }
-        }
-      }
-
-      // If avail == NULL, all packets are being used (in_use), meaning 
-      // the queue is already full. We push packets from to the top of in_use
-      // queue.
-      // If avail != NULL, we push one packet from the top of the buffer, 
-      // if it has the correct sequence number.
-      if (avail == NULL || 
-          in_use->get_seq_num() == clip_seq_num(last_seq_num + 1))
-      {
-        if (avail == NULL)
-          lost_packets += 
-            in_use->get_seq_num() - clip_seq_num(last_seq_num + 1);
-        consume_packet();
-        if (in_use && in_use->get_seq_num() == clip_seq_num(last_seq_num + 1))
-            consume_packet();
-      }
-    }
   }
 
   // move from avail to in_use -- there must be at least one packet in avail
@@ -204,6 +144,120 @@ rtp_packet* packets_handler::exchange(rtp_packet* p)
   return p;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+ui32 packets_handler::reserve_packets(rtp_packet** slots, ui32 count)
+{
+  ui32 i = 0;
+  for (; i < count && avail != NULL; ++i)
+  {
+    slots[i] = avail;
+    avail = avail->next;
+    slots[i]->next = NULL;
+    slots[i]->num_bytes = 0;
+    slots[i]->rx_time = 0;
+  }
+  return i;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void packets_handler::push_packets(rtp_packet** slots, ui32 count)
+{
+  for (ui32 i = 0; i < count; ++i)
+  {
+    rtp_packet* p = slots[i];
+    p->next = in_use;
+    in_use = p;
+    if (p->num_bytes == 0 || !process_packet())
+    { // not used; move it back to avail
+      in_use = p->next;
+      p->next = avail;
+      avail = p;
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool packets_handler::process_packet()
+{
+  rtp_packet* p = in_use;
+  if (last_seq_num == 0) // initialization
+    last_seq_num = clip_seq_num(p->get_seq_num() - 1);
+
+  // packet is old, and is ignored -- no need to included it in the 
+  // lost packets, because this packet was considered lost previously.
+  // This also captures the case where the previous packet and this packet
+  // has the same sequence number, which is rather weird but possible
+  // if some intermediate network unit retransmits packets.
+  // The frames handler may still be waiting for it, if it has a reordering
+  // window, in which case it is no longer lost.
+  if (is_smaller24(p->get_seq_num(), clip_seq_num(last_seq_num + 1)))
+  {
+    if (frames->push_late(p) && lost_packets > 0)
+      --lost_packets;
+    return false;
+  }
+  else if (p->get_seq_num() == clip_seq_num(last_seq_num + 1))
+  {
+    consume_packet();
+    // see if we can push one packet from the top of the buffer
+    if (in_use && in_use->get_seq_num() == clip_seq_num(last_seq_num + 1))
+      consume_packet();
+  }
+  else // sequence larger than expected
+  {
+    // Place the packet in the in_use queue according to its sequence
+    // number; we may have to move it down the queue. The in_use queue is 
+    // always arranged in an ascending order, where the top of the queue 
+    // (pointed to by in_use) has the smallest sequence number.
+    if (in_use->next != NULL) // we have more than 1 packet in queue
+    { 
+      rtp_packet* t = in_use;
+      while (t->next != NULL && 
+        is_greater24(p->get_seq_num(), t->next->get_seq_num()))
+        t = t->next;
+
+      if (t->next != NULL && p->get_seq_num() == t->next->get_seq_num())
+      { // this is a repeated packet and must be removed
+        in_use = in_use->next;
+        p->next = avail;
+        avail = p;
+      }
+      else {
+        if (t == in_use) // at front of queue -- exactly where it should be
+        { } // do nothing
+        else if (t->next == NULL) { // at the end of queue
+          in_use = in_use->next; // remove p from the queue
+          t->next = p;
+          p->next = NULL;
+        }
+        else { // in the middle of the queue
+          in_use = in_use->next; // p removed from the start of queue
+          p->next = t->next;
+          t->next = p;
+        }
+      }
+    }
+
+    // If avail == NULL, all packets are being used (in_use), meaning 
+    // the queue is already full. We push packets from to the top of in_use
+    // queue.
+    // If avail != NULL, we push one packet from the top of the buffer, 
+    // if it has the correct sequence number.
+    if (avail == NULL || 
+        in_use->get_seq_num() == clip_seq_num(last_seq_num + 1))
+    {
+      if (avail == NULL)
+        lost_packets += 
+          in_use->get_seq_num() - clip_seq_num(last_seq_num + 1);
+      consume_packet();
+      if (in_use && in_use->get_seq_num() == clip_seq_num(last_seq_num + 1))
+          consume_packet();
+    }
+  }
+
+  return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void packets_handler::flush()
 {
@@ -237,6 +291,112 @@ void packets_handler::consume_packet()
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#ifdef OJPH_OS_LINUX
+
+///////////////////////////////////////////////////////////////////////////////
+// room for one SCM_TIMESTAMPNS message
+static const size_t control_size = CMSG_SPACE(sizeof(struct timespec));
+
+///////////////////////////////////////////////////////////////////////////////
+batch_receiver::~batch_receiver()
+{
+  if (msgs) delete[] msgs;
+  if (iovecs) delete[] iovecs;
+  if (sources) delete[] sources;
+  if (controls) delete[] controls;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool batch_receiver::init(ojph_socket s, ui32 batch_size, bool timestamps)
+{
+  assert(this->batch_size == 0 && batch_size > 0);
+  this->s = s;
+  this->batch_size = batch_size;
+  this->timestamps = timestamps;
+  msgs = new struct mmsghdr[batch_size];
+  iovecs = new struct iovec[batch_size];
+  sources = new sockaddr_in[batch_size];
+  controls = new ui8[batch_size * control_size];
+
+  int flags = fcntl(s, F_GETFL, 0);
+  if (flags == -1 || fcntl(s, F_SETFL, flags | O_NONBLOCK) == -1)
+    return false;
+  if (timestamps) {
+    int enable = 1;
+    if (setsockopt(s, SOL_SOCKET, SO_TIMESTAMPNS,
+                   &enable, sizeof(enable)) == -1)
+      return false;
+  }
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int batch_receiver::receive(rtp_packet** slots, ui32 count, int timeout_ms)
+{
+  assert(count <= batch_size);
+  memset(msgs, 0, count * sizeof(struct mmsghdr));
+  for (ui32 i = 0; i < count; ++i)
+  {
+    iovecs[i].iov_base = slots[i]->data;
+    iovecs[i].iov_len = rtp_packet::max_size;
+    msgs[i].msg_hdr.msg_iov = iovecs + i;
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_name = sources + i;
+    msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    if (timestamps) {
+      msgs[i].msg_hdr.msg_control = controls + i * control_size;
+      msgs[i].msg_hdr.msg_controllen = control_size;
+    }
+  }
+
+  int num = recvmmsg(s, msgs, count, 0, NULL);
+  if (num == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+  { // sleep until a packet arrives, instead of spinning
+    struct pollfd pfd;
+    pfd.fd = s;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    int r = poll(&pfd, 1, timeout_ms);
+    if (r == 0 || (r == -1 && errno == EINTR))
+      return 0;
+    if (r == -1)
+      return -1;
+    num = recvmmsg(s, msgs, count, 0, NULL);
+    if (num == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      return 0;
+  }
+  if (num == -1)
+    return (errno == EINTR) ? 0 : -1;
+
+  for (int i = 0; i < num; ++i)
+  {
+    slots[i]->num_bytes = msgs[i].msg_len;
+    slots[i]->rx_time = 0;
+    if (!timestamps)
+      continue;
+    struct msghdr* h = &msgs[i].msg_hdr;
+    for (struct cmsghdr* c = CMSG_FIRSTHDR(h); c != NULL;
+         c = CMSG_NXTHDR(h, c))
+      if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_TIMESTAMPNS)
+      {
+        struct timespec ts;
+        memcpy(&ts, CMSG_DATA(c), sizeof(ts));
+        slots[i]->rx_time = (ui64)ts.tv_sec * 1000000000 + (ui64)ts.tv_nsec;
+      }
+  }
+  return num;
+}
+
+#endif // !OJPH_OS_LINUX
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
 ///////////////////////////////////////////////////////////////////////////////
 void stex_file::notify_file_completion()
 { 
@@ -258,32 +418,40 @@ frames_handler::~frames_handler()
 { 
   if (storers_store)
     delete[] storers_store;
+  if (decoders_store)
+    delete[] decoders_store;
   if (files_store) 
     delete[] files_store; 
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void frames_handler::init(bool quiet, const char *target_name, 
-                          thds::thread_pool* thread_pool)
+void frames_handler::init(bool quiet, const char *target_name, bool decode,
+                          ui32 deadline_ms, thds::thread_pool* thread_pool)
 {
   this->quiet = quiet;
   this->num_threads = (ui32)thread_pool->get_num_threads();
   this->target_name = target_name;
+  this->decode = decode;
+  this->deadline_ns = (ui64)deadline_ms * 1000000;
   num_files = num_threads + 1;
   avail = files_store = new stex_file[num_files];
   storers_store = new j2k_frame_storer[num_files];
+  decoders_store = new j2k_frame_decoder[num_files];
   ui32 i = 0;
   for (; i < num_files - 1; ++i) {
     files_store[i].f.open(2 << 20, false); 
     files_store[i].f.close();
     files_store[i].init(this, files_store + i + 1, storers_store + i,
-      target_name);
+      decoders_store + i, target_name);
     storers_store[i].init(files_store + i, target_name);
+    decoders_store[i].init(files_store + i, target_name);
   }
   files_store[i].f.open(2 << 20, false); 
   files_store[i].f.close();
-  files_store[i].init(this, NULL, storers_store + i, target_name);
+  files_store[i].init(this, NULL, storers_store + i, decoders_store + i,
+    target_name);
   storers_store[i].init(files_store + i, target_name);
+  decoders_store[i].init(files_store + i, target_name);
   this->thread_pool = thread_pool;
 }
 
@@ -297,8 +465,22 @@ void frames_handler::push(rtp_packet* p)
   // check if any of the frames processed in other threads are done
   check_files_in_processing();
 
+  // truncate frames that have waited long enough for late packets
+  if (waiting || (in_use && !in_use->holes.empty()))
+    check_expired_holes(p->get_seq_num());
+
   // process newly received packet
-  if (p->get_packet_type() != rtp_packet::PT_BODY)
+  if (p->get_packet_type() != rtp_packet::PT_BODY && in_use != NULL
+      && in_use->holes.empty()
+      && p->get_time_stamp() == in_use->time_stamp
+      && p->get_seq_num() == clip_seq_num(in_use->last_seen_seq + 1))
+  { // main header that spans more than one main packet
+    in_use->last_seen_seq = p->get_seq_num();
+    write_packet(in_use, p);
+    if (p->is_marked())
+      complete_frame();
+  }
+  else if (p->get_packet_type() != rtp_packet::PT_BODY)
   { // main packet payload
 
     // The existence of a previous frame means we did not get the marked
@@ -326,6 +508,14 @@ void frames_handler::push(rtp_packet* p)
     else
       ++lost_frames;
 
+    // the smallest difference is the frame period, since frames can be lost
+    if (total_frames > 0 && is_greater32(p->get_time_stamp(), last_time_stamp))
+    {
+      ui32 period = p->get_time_stamp() - last_time_stamp;
+      if (frame_period_ts == 0 || period < frame_period_ts)
+        frame_period_ts = period;
+    }
+
     ++total_frames;
     last_time_stamp = p->get_time_stamp();
   }
@@ -335,12 +525,13 @@ void frames_handler::push(rtp_packet* p)
     {
       if (p->get_time_stamp() == in_use->time_stamp)
       { // this is a continuation of a previous frame
-        if (p->get_seq_num() == clip_seq_num(in_use->last_seen_seq + 1))
+        if (p->get_seq_num() == clip_seq_num(in_use->last_seen_seq + 1)
+            || add_holes(p->get_seq_num()))
         {
           in_use->last_seen_seq = p->get_seq_num();
-          in_use->f.write(p->get_data(), p->get_data_size());
+          write_packet(in_use, p);
           if (p->is_marked())
-            send_to_processing();
+            complete_frame();
         }
         else {
           // we must have missed packets
@@ -382,12 +573,89 @@ void frames_handler::get_stats(ui32& total_frames, ui32& trunc_frames,
   lost_frames = this->lost_frames;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void frames_handler::get_decode_stats(ui32& decoded_frames,
+                                      ui32& failed_frames,
+                                      ui32& deadline_misses)
+{
+  decoded_frames = (ui32)this->decoded_frames.load(std::memory_order_relaxed);
+  failed_frames = (ui32)this->failed_frames.load(std::memory_order_relaxed);
+  deadline_misses =
+    (ui32)this->deadline_misses.load(std::memory_order_relaxed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void frames_handler::report_decoded_frame(bool success, ui64 deadline)
+{
+  if (success)
+    decoded_frames.fetch_add(1, std::memory_order_relaxed);
+  else
+    failed_frames.fetch_add(1, std::memory_order_relaxed);
+  if (deadline != 0 && get_steady_time_ns() > deadline)
+    deadline_misses.fetch_add(1, std::memory_order_relaxed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void frames_handler::set_reorder_window(ui32 max_packets, ui32 max_us)
+{
+  reorder_packets = max_packets;
+  reorder_ns = (ui64)max_us * 1000;
+  reorder = max_packets != 0 || max_us != 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool frames_handler::push_late(rtp_packet* p)
+{
+  // the frame is either in_use or waiting
+  stex_file* file = in_use;
+  if (file == NULL || file->time_stamp != p->get_time_stamp())
+  {
+    file = waiting;
+    while (file != NULL && file->time_stamp != p->get_time_stamp())
+      file = file->next;
+  }
+  if (file == NULL)
+    return false;
+
+  for (size_t i = 0; i < file->holes.size(); ++i)
+    if (file->holes[i].seq == p->get_seq_num())
+    {
+      fill_hole(file, i, p);
+      if (file != in_use && file->holes.empty())
+      { // all packets of a waiting frame are here; remove it from waiting
+        if (file == waiting)
+          waiting = file->next;
+        else {
+          stex_file* t = waiting;
+          while (t->next != file)
+            t = t->next;
+          t->next = file->next;
+        }
+        send_file_to_processing(file);
+      }
+      return true;
+    }
+  return false; // a repeated packet, or one we gave up on
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 bool frames_handler::flush()
 {
   // check if any of the frames processed in other threads are done
   check_files_in_processing();
 
+  // give up on late packets
+  while (waiting != NULL)
+  {
+    stex_file* f = waiting;
+    waiting = waiting->next;
+    f->holes.clear();
+    f->tail.clear();
+    f->f.close();
+    f->next = avail;
+    avail = f;
+  }
+
   // check the file in in_use and terminate it
   if (in_use != NULL)
   {
@@ -446,18 +714,152 @@ void frames_handler::check_files_in_processing()
 ///////////////////////////////////////////////////////////////////////////////
 void frames_handler::send_to_processing()
 {
-  in_use->f.close();
-  if (target_name) {
-    in_use->next = processing;
-    processing = in_use;
-    in_use->done.store(1, std::memory_order_relaxed);
-    thread_pool->add_task(in_use->storer);
+  send_file_to_processing(in_use);
+  in_use = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void frames_handler::send_file_to_processing(stex_file* file)
+{
+  // unfilled holes truncate the frame at the first of them
+  file->holes.clear();
+  file->tail.clear();
+
+  file->f.close();
+  if (decode) {
+    // a frame must be decoded before the ones that follow it use up all
+    // the threads; the RTP clock for video is 90kHz
+    ui64 allowance = deadline_ns;
+    if (allowance == 0)
+      allowance = (ui64)frame_period_ts * num_threads * 1000000000 / 90000;
+    file->deadline = allowance ? get_steady_time_ns() + allowance : 0;
+    file->next = processing;
+    processing = file;
+    file->done.store(1, std::memory_order_relaxed);
+    thread_pool->add_task(file->decoder);
+  }
+  else if (target_name) {
+    file->next = processing;
+    processing = file;
+    file->done.store(1, std::memory_order_relaxed);
+    thread_pool->add_task(file->storer);
   }
   else {
-    in_use->next = avail;
-    avail = in_use;
+    file->next = avail;
+    avail = file;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void frames_handler::complete_frame()
+{
+  if (in_use->holes.empty())
+    send_to_processing();
+  else
+  { // wait for the missing packets
+    in_use->next = waiting;
+    waiting = in_use;
+    in_use = NULL;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool frames_handler::add_holes(ui32 seq)
+{
+  const ui32 max_holes = reorder_packets ? reorder_packets : 256;
+  if (!reorder)
+    return false;
+
+  ui32 first = clip_seq_num(in_use->last_seen_seq + 1);
+  ui32 num_missing = clip_seq_num(seq - first);
+  if (in_use->holes.size() + num_missing > max_holes)
+    return false;
+
+  if (in_use->holes.empty())
+    in_use->hole_deadline = reorder_ns ? get_steady_time_ns() + reorder_ns : 0;
+  for (ui32 i = 0; i < num_missing; ++i) {
+    stex_file::hole h;
+    h.seq = clip_seq_num(first + i);
+    h.pos = in_use->tail.size();
+    in_use->holes.push_back(h);
+  }
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void frames_handler::write_packet(stex_file* file, rtp_packet* p)
+{
+  if (file->holes.empty())
+    file->f.write(p->get_data(), p->get_data_size());
+  else
+    file->tail.insert(file->tail.end(), p->get_data(),
+      p->get_data() + p->get_data_size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void frames_handler::fill_hole(stex_file* file, size_t idx, rtp_packet* p)
+{
+  std::vector<stex_file::hole>& holes = file->holes;
+  std::vector<ui8>& tail = file->tail;
+
+  size_t num_bytes = p->get_data_size();
+  tail.insert(tail.begin() + (std::ptrdiff_t)holes[idx].pos, p->get_data(),
+    p->get_data() + num_bytes);
+  for (size_t i = idx + 1; i < holes.size(); ++i)
+    holes[i].pos += num_bytes;
+  holes.erase(holes.begin() + (std::ptrdiff_t)idx);
+
+  if (idx == 0)
+  { // the data up to the next hole is complete, and can move to f
+    size_t complete = holes.empty() ? tail.size() : holes[0].pos;
+    file->f.write(tail.data(), complete);
+    tail.erase(tail.begin(), tail.begin() + (std::ptrdiff_t)complete);
+    for (size_t i = 0; i < holes.size(); ++i)
+      holes[i].pos -= complete;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool frames_handler::holes_expired(const stex_file* file, ui32 seq,
+                                   ui64 now)
+{
+  bool expired = reorder_ns && now > file->hole_deadline;
+  if (reorder_packets) {
+    ui32 limit = clip_seq_num(file->holes.back().seq + reorder_packets);
+    expired = expired || !is_smaller24(seq, limit);
+  }
+  return expired;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void frames_handler::check_expired_holes(ui32 seq)
+{
+  ui64 now = reorder_ns ? get_steady_time_ns() : 0;
+  if (in_use && !in_use->holes.empty() && holes_expired(in_use, seq, now))
+  { // the rest of this frame is of no use
+    ++trunc_frames;
+    send_to_processing();
+  }
+
+  stex_file* f = waiting, *pf = NULL;
+  while (f != NULL)
+  {
+    if (holes_expired(f, seq, now))
+    {
+      ++trunc_frames;
+      stex_file* t = f;
+      f = f->next;
+      if (pf == NULL)
+        waiting = f;
+      else
+        pf->next = f;
+      send_file_to_processing(t);
+    }
+    else {
+      pf = f;
+      f = f->next;
+    }
   }
-  in_use = NULL;
 }
 
 } // !stex namespace
@@ -40,6 +40,8 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
+#include <vector>
 #include "ojph_base.h"
 #include "ojph_file.h"
 #include "ojph_sockets.h"
@@ -58,6 +60,18 @@ class frames_handler;
 
 // defined elsewhere
 struct j2k_frame_storer;
+struct j2k_frame_decoder;
+
+/*****************************************************************************/
+/** @brief returns the time of a steady clock in nanoseconds; used for
+ *         decoding deadlines.
+ */
+inline ui64 get_steady_time_ns()
+{
+  using namespace std::chrono;
+  return (ui64)duration_cast<nanoseconds>(
+    steady_clock::now().time_since_epoch()).count();
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 //
@@ -92,7 +106,7 @@ public:
   /**
    *  @brief default constructor
    */
-  rtp_packet() { num_bytes = 0; next = NULL; }
+  rtp_packet() { num_bytes = 0; rx_time = 0; next = NULL; }
 
   /**
    *  @brief Call this to link packets.
@@ -207,6 +221,8 @@ public:
                                         // ethernet packet are only 1500
   ui8 data[max_size];                   //!<data in the packet
   ui32 num_bytes;                       //!<number of bytes 
+  ui64 rx_time;                         //!<kernel receive time in ns since
+                                        // the epoch, or 0 if not captured
   rtp_packet* next;                     //!<used for linking packets
 };
 
@@ -276,8 +292,13 @@ public:
    *  @param num_packets the number of packets in the chain
    *  @param frames a pointer to the frames_handler object that will be 
    *         receive the packets
+   *  @param batch_size the largest number of packets that are obtained
+   *         at once using reserve_packets(); the chain is extended by
+   *         batch_size - 1 packets, so that the re-ordering window is the
+   *         same as when exchange() is used
    */
-  void init(bool quiet, ui32 num_packets, frames_handler* frames);
+  void init(bool quiet, ui32 num_packets, frames_handler* frames,
+            ui32 batch_size = 1);
 
   /**
    *  @brief Call this function to get a packet from the packet chain.
@@ -293,6 +314,31 @@ public:
    */
   rtp_packet* exchange(rtp_packet* p);
 
+  /**
+   *  @brief Call this function to get up to count empty packets, for
+   *         receiving a batch of packets at once.
+   *
+   *  The packets must be returned by calling push_packets(), before
+   *  calling this function again.  This function and push_packets()
+   *  should not be mixed with exchange().
+   *
+   *  @param  slots receives pointers to the packets
+   *  @param  count the number of needed packets, at most batch_size
+   *  @return returns the number of packets stored in slots
+   */
+  ui32 reserve_packets(rtp_packet** slots, ui32 count);
+
+  /**
+   *  @brief Call this function to pass packets obtained from
+   *         reserve_packets(), in the order they were received.
+   *
+   *  Packets with num_bytes of 0 are not used, and are simply returned.
+   *
+   *  @param  slots pointers to the packets
+   *  @param  count the number of packets in slots
+   */
+  void push_packets(rtp_packet** slots, ui32 count);
+
   /**
    *  @brief This function provides information about the observed number 
    *          of lost packets
@@ -315,6 +361,16 @@ private:
    */
   void consume_packet();
 
+  /**
+   *  @brief This function places a newly received packet, which must be
+   *         at the top of in_use, where it belongs in the queue, sending
+   *         packets to the frames handler when possible.
+   *
+   *  @return returns false if the packet is old, in which case it remains
+   *          at the top of in_use
+   */
+  bool process_packet();
+
 private:
   bool quiet;                //!<no informational info is printed when true
   rtp_packet* avail;         //!<start of available packets chain
@@ -327,6 +383,90 @@ private:
   rtp_packet* packet_store;  //!<address of packet memory allocation
 };
 
+#ifdef OJPH_OS_LINUX
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*****************************************************************************/
+/** @brief Receives a batch of packets with one recvmmsg call (Linux only)
+ *
+ *  The packets are obtained from packets_handler::reserve_packets().  When
+ *  no packets are waiting, the object sleeps in poll() until one arrives,
+ *  instead of spinning on a non-blocking socket.  Optionally, the kernel
+ *  receive time of each packet (SO_TIMESTAMPNS) is stored in
+ *  rtp_packet::rx_time.
+ */
+class batch_receiver
+{
+public:
+  /**
+   *  @brief default constructor
+   */
+  batch_receiver()
+  {
+    batch_size = 0;
+    timestamps = false;
+    msgs = NULL;
+    iovecs = NULL;
+    sources = NULL;
+    controls = NULL;
+  }
+  /**
+   *  @brief default destructor
+   */
+  ~batch_receiver();
+
+public:
+  /**
+   *  @brief call this function to initialize this object
+   *
+   *  @param s the socket from which packets are received; the socket is
+   *         set to non-blocking mode
+   *  @param batch_size the largest number of packets received at once
+   *  @param timestamps when true, kernel receive time is captured
+   *  @return returns false if the socket could not be configured; the
+   *          error is in errno
+   */
+  bool init(ojph_socket s, ui32 batch_size, bool timestamps);
+
+  /**
+   *  @brief call this function to receive up to count packets
+   *
+   *  The function waits up to timeout_ms for the first packet, then takes
+   *  all the packets that are waiting, up to count.
+   *
+   *  @param slots the packets, from packets_handler::reserve_packets();
+   *         num_bytes and rx_time are set for the received ones
+   *  @param count the number of packets in slots, at most batch_size
+   *  @param timeout_ms the longest time to wait, in milliseconds
+   *  @return returns the number of received packets, or -1 on error, with
+   *          the error in errno
+   */
+  int receive(rtp_packet** slots, ui32 count, int timeout_ms);
+
+  /**
+   *  @brief returns the source address of packet i of the last batch
+   */
+  const sockaddr_in& get_source(ui32 i) const { return sources[i]; }
+
+private:
+  ojph_socket s;             //!<the receiving socket
+  ui32 batch_size;           //!<the largest number of packets in a batch
+  bool timestamps;           //!<true if kernel receive time is captured
+  struct mmsghdr* msgs;      //!<one message header per packet
+  struct iovec* iovecs;      //!<one buffer descriptor per packet
+  sockaddr_in* sources;      //!<source address of each packet
+  ui8* controls;             //!<ancillary data buffer of each packet
+};
+
+#endif // !OJPH_OS_LINUX
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 //
@@ -363,6 +503,9 @@ public:
     parent = NULL;
     name_template = NULL;
     storer = NULL;
+    decoder = NULL;
+    deadline = 0;
+    hole_deadline = 0;
     next = NULL; 
   }
 
@@ -376,15 +519,17 @@ public:
    *         frames_handler
    *  @param next is used to chain files
    *  @param storer this object is used to store j2k codestreams
+   *  @param decoder this object is used to decode j2k codestreams
    *  @param name_template file name template to use for storeing files
    */
   void init(frames_handler* parent, stex_file* next, j2k_frame_storer *storer,
-            const char *name_template)
+            j2k_frame_decoder *decoder, const char *name_template)
   {
     this->parent = parent;
     this->name_template = name_template;
     this->next = next;
     this->storer = storer;
+    this->decoder = decoder;
   }
 
   /**
@@ -407,6 +552,20 @@ public:
 
   const char *name_template; //!<name template for saved files
   j2k_frame_storer* storer;  //!<stores a j2k frame using another thread
+  j2k_frame_decoder* decoder;//!<decodes a j2k frame using another thread
+  ui64 deadline;             //!<get_steady_time_ns() by which decoding
+                             //!<should finish, or 0 for no deadline
+
+  /** @brief a packet that is missing from the frame */
+  struct hole {
+    ui32 seq;   //!<the sequence number of the missing packet
+    size_t pos; //!<where its data goes in tail
+  };
+  std::vector<hole> holes;   //!<missing packets, in sequence order
+  std::vector<ui8> tail;     //!<data of the packets that follow the first
+                             //!<hole; it moves to f when the hole is filled
+  ui64 hole_deadline;        //!<get_steady_time_ns() after which holes are
+                             //!<considered lost, or 0 for no limit
 
   stex_file* next;        //!<used to create files chain
 };
@@ -439,10 +598,20 @@ public:
     num_files = 0;
     last_seq_number = last_time_stamp = 0;
     total_frames = trunc_frames = lost_frames = 0;
-    files_store = in_use = avail = processing = NULL;
+    files_store = in_use = avail = processing = waiting = NULL;
+    reorder_packets = 0;
+    reorder_ns = 0;
+    reorder = false;
     num_complete_files.store(0);
     thread_pool = NULL;
     storers_store = NULL;
+    decoders_store = NULL;
+    decode = false;
+    deadline_ns = 0;
+    frame_period_ts = 0;
+    decoded_frames.store(0);
+    failed_frames.store(0);
+    deadline_misses.store(0);
   }
   /**
    *  @brief default destructor
@@ -458,12 +627,17 @@ public:
    *  @param quiet when true, no messages are printed -- as of this writing
    *         the object prints no messages
    *  @param target_name a template for the saved file names
+   *  @param decode when true, frames are decoded, and target_name, if
+   *         not NULL, is used for saving decoded images
+   *  @param deadline_ms time in milliseconds, from the arrival of a frame,
+   *         within which it should be decoded; when 0, the deadline is
+   *         the number of threads times the frame period
    *  @param thread_pool a thread pool for processing j2k codestreams
-   *         (saving)
+   *         (saving or decoding)
    * 
    */
-  void init(bool quiet, const char *target_name, 
-            thds::thread_pool* thread_pool);
+  void init(bool quiet, const char *target_name, bool decode,
+            ui32 deadline_ms, thds::thread_pool* thread_pool);
 
   /**
    *  @brief call this function to push rtp_packets to this object
@@ -489,6 +663,58 @@ public:
    */
   void get_stats(ui32& total_frames, ui32& trunc_frames, ui32& lost_frames);
 
+  /**
+   *  @brief call this function to collect statistics about decoding
+   *
+   *  @param decoded_frames returns the number of decoded frames
+   *  @param failed_frames returns the number of frames that could not
+   *                       be decoded
+   *  @param deadline_misses returns the number of frames that finished
+   *                         decoding after their deadline
+   */
+  void get_decode_stats(ui32& decoded_frames, ui32& failed_frames,
+                        ui32& deadline_misses);
+
+  /**
+   *  @brief decoding threads call this function when they finish a frame
+   *
+   *  @param success true if the frame was decoded
+   *  @param deadline the frame's deadline; see stex_file::deadline
+   */
+  void report_decoded_frame(bool success, ui64 deadline);
+
+  /**
+   *  @brief call this function to set a reordering window, in which late
+   *         packets are put back into their frames.
+   *
+   *  Packets reach this object in sequence order, but packets_handler
+   *  gives up on a missing packet when its own window is full.  Without a
+   *  reordering window, a frame with a missing packet is truncated.  With
+   *  it, the frame keeps the packets that follow the missing one aside,
+   *  and waits for the missing packet, which is put in its place if it
+   *  arrives in time; see push_late().  The wait ends when a packet that
+   *  is max_packets past the newest missing one arrives, or max_us
+   *  microseconds after the first missing packet is detected, whichever
+   *  comes first; the frame is then truncated at the missing packet.
+   *  Only packets missing between two received packets of a frame are
+   *  waited for; a frame that lacks its last (marked) packet is truncated.
+   *
+   *  @param max_packets the window in packets, or 0 for no limit; this is
+   *         also the largest number of packets a frame can wait for,
+   *         which is 256 when there is no limit
+   *  @param max_us the window in microseconds, or 0 for no limit
+   */
+  void set_reorder_window(ui32 max_packets, ui32 max_us);
+
+  /**
+   *  @brief call this function to push an rtp_packet that is older than
+   *         the last pushed packet.
+   *
+   *  @param p a pointer to the packet
+   *  @return true if the packet filled a hole in one of the frames
+   */
+  bool push_late(rtp_packet* p);
+
   /**
    *  @brief This function is not used, and therefore it is not clear how to
    *         use it.
@@ -526,6 +752,51 @@ private:
    */
   void send_to_processing();
 
+  /**
+   *  @brief Moves a file to processing or to avail; see
+   *         send_to_processing()
+   */
+  void send_file_to_processing(stex_file* file);
+
+  /**
+   *  @brief Handles a frame whose last packet has been received, sending
+   *         it to processing, or to waiting if it has holes
+   */
+  void complete_frame();
+
+  /**
+   *  @brief Records holes for the packets missing before seq in in_use.
+   *
+   *  @return returns false if the packets cannot be waited for, because
+   *          there is no reordering window or there would be too many
+   */
+  bool add_holes(ui32 seq);
+
+  /**
+   *  @brief Puts the data of a packet in file; it goes to tail if the
+   *         file has holes
+   */
+  void write_packet(stex_file* file, rtp_packet* p);
+
+  /**
+   *  @brief Fills hole number idx of file with the data of packet p
+   */
+  void fill_hole(stex_file* file, size_t idx, rtp_packet* p);
+
+  /**
+   *  @brief Returns true if the reordering window of the holes in file
+   *         has passed; seq is the sequence number of the newest packet,
+   *         and now is get_steady_time_ns(), if reorder_ns is not 0
+   */
+  bool holes_expired(const stex_file* file, ui32 seq, ui64 now);
+
+  /**
+   *  @brief Truncates in_use and the frames in waiting, whose reordering
+   *         window has passed; seq is the sequence number of the newest
+   *         packet
+   */
+  void check_expired_holes(ui32 seq);
+
 private:
   bool quiet;               //!<no informational info is printed when true
   ui32 num_threads;         //!<number of threads used for saving
@@ -540,12 +811,28 @@ private:
   stex_file* in_use;        //!<the frame that is being filled with data
   stex_file* avail;         //!<available frames structures
   stex_file* processing;    //!<frames that are being saved
+  stex_file* waiting;       //!<complete frames waiting for late packets
+  ui32 reorder_packets;     //!<reordering window in packets, 0 for none
+  ui64 reorder_ns;          //!<reordering window in ns, 0 for none
+  bool reorder;             //!<true if there is a reordering window
   std::atomic_int32_t 
     num_complete_files;     //<!num. of files for which processing is complete
   thds::thread_pool* 
     thread_pool;            //!<thread pool for processing frames
   j2k_frame_storer* 
     storers_store;          //!<address for allocated frame storers
+  j2k_frame_decoder*
+    decoders_store;         //!<address for allocated frame decoders
+  bool decode;              //!<frames are decoded when true
+  ui64 deadline_ns;         //!<decoding deadline, or 0 for the default
+  ui32 frame_period_ts;     //!<smallest observed time stamp difference
+                            //!<between frames, or 0 if not known yet
+  std::atomic_int32_t
+    decoded_frames;         //!<number of decoded frames
+  std::atomic_int32_t
+    failed_frames;          //!<number of frames that failed to decode
+  std::atomic_int32_t
+    deadline_misses;        //!<number of frames decoded after deadline
 };
 
 } // !stex namespace
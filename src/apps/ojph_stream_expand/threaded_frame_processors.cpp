@@ -35,6 +35,14 @@
 // Date: 23 April 2024
 //***************************************************************************/
 
+#include <cstdio>
+#include <exception>
+#include <vector>
+#include "ojph_codestream.h"
+#include "ojph_file.h"
+#include "ojph_mem.h"
+#include "ojph_message.h"
+#include "ojph_params.h"
 #include "threaded_frame_processors.h"
 
 namespace ojph
@@ -60,5 +68,105 @@ void j2k_frame_storer::execute()
   file->notify_file_completion();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+void j2k_frame_decoder::execute()
+{
+  // reused by all the frames this thread decodes
+  static thread_local ojph::codestream codestream;
+  static thread_local std::vector<ui8> image;
+  static thread_local std::vector<size_t> next_pos; // next row of each comp
+
+  bool success = true;
+  ojph::mem_infile infile;
+  try {
+    infile.open(file->f.get_data(), file->f.get_used_size());
+    codestream.enable_resilience();
+    codestream.read_headers(&infile);
+    codestream.create();
+
+    // planar layout; bytes_per_sample is 1 or 2
+    ojph::param_siz siz = codestream.access_siz();
+    ui32 num_comps = siz.get_num_components();
+    ui32 bytes_per_sample = 1;
+    size_t image_size = 0;
+    for (ui32 c = 0; c < num_comps; ++c) {
+      if (siz.get_bit_depth(c) > 8)
+        bytes_per_sample = 2;
+      image_size += (size_t)siz.get_recon_width(c) * siz.get_recon_height(c);
+    }
+    image_size *= bytes_per_sample;
+    if (image.size() < image_size)
+      image.resize(image_size);
+
+    next_pos.resize(num_comps);
+    size_t pos = 0;
+    for (ui32 c = 0; c < num_comps; ++c) {
+      next_pos[c] = pos;
+      pos += (size_t)siz.get_recon_width(c) * siz.get_recon_height(c)
+        * bytes_per_sample;
+    }
+
+    ui32 num_lines = 0;
+    for (ui32 c = 0; c < num_comps; ++c)
+      num_lines += siz.get_recon_height(c);
+    for (ui32 i = 0; i < num_lines; ++i)
+    {
+      ui32 c;
+      ojph::line_buf* line = codestream.pull(c);
+      ui32 w = siz.get_recon_width(c);
+      ui32 bit_depth = siz.get_bit_depth(c);
+      si32 offset = 0;
+      if (siz.is_signed(c))
+        offset = (si32)(1u << (ojph_min(bit_depth, 31u) - 1));
+      si32 max_val = (si32)((1u << ojph_min(bit_depth, 16u)) - 1);
+      const si32* sp = line->i32;
+      if (bytes_per_sample == 2) {
+        ui16* dp = (ui16*)(image.data() + next_pos[c]);
+        for (ui32 x = 0; x < w; ++x) {
+          si32 val = *sp++ + offset;
+          *dp++ = (ui16)ojph_max(0, ojph_min(val, max_val));
+        }
+      }
+      else {
+        ui8* dp = image.data() + next_pos[c];
+        for (ui32 x = 0; x < w; ++x) {
+          si32 val = *sp++ + offset;
+          *dp++ = (ui8)ojph_max(0, ojph_min(val, max_val));
+        }
+      }
+      next_pos[c] += w * bytes_per_sample;
+    }
+
+    if (name_template)
+    {
+      char buf[128], name[128];
+      snprintf(buf, 128, "%s.yuv", name_template);
+      snprintf(name, 128, buf, file->frame_idx);
+      FILE *fh = fopen(name, "wb");
+      if (fh == NULL)
+        OJPH_ERROR(0x02000008, "failed to open %s for writing", name);
+      size_t written = fwrite(image.data(), 1, image_size, fh);
+      fclose(fh);
+      if (written != image_size)
+        OJPH_ERROR(0x02000009, "failed writing to %s", name);
+    }
+  }
+  catch (const std::exception&) {
+    success = false;
+  }
+  codestream.close();
+  codestream.restart();
+
+  file->parent->report_decoded_frame(success, file->deadline);
+  file->notify_file_completion();
+}
+
 } // !stex namespace
-} // !ojph namespace
\ No newline at end of file
+} // !ojph namespace
\ No newline at end of file
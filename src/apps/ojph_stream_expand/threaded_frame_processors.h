@@ -101,7 +101,66 @@ private:
   const char* name_template;  //!<a template for the target file name
 };
 
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*****************************************************************************/
+/** @brief Decodes a j2k frame in memory, optionally saving the decoded
+ *         image to disk.
+ *
+ *  Each thread of the thread_pool keeps its own codestream and image
+ *  buffer, which are reused from one frame to the next.  The image is
+ *  saved as planar raw/yuv, one component after the other, with samples
+ *  clipped to 8 bits if the bit depth is 8 or less, or to 16 bits
+ *  otherwise.
+ */
+struct j2k_frame_decoder : public thds::worker_thread_base
+{
+public:
+  /**
+   * @brief default construction
+   */
+  j2k_frame_decoder() {
+    file = NULL;
+    name_template = NULL;
+  }
+  /**
+   * @brief default destructor doing nothing
+   */
+  ~j2k_frame_decoder() override {}
+
+public:
+  /**
+   *  @brief call this function to initialize its members
+   *
+   *  @param file is a stex_file holding the j2k codestream with other
+   *         variables.
+   *  @param name_template holds the a filename template, or NULL if the
+   *         decoded images are not to be saved
+   */
+  void init(stex_file* file, const char* name_template)
+  {
+    this->file = file;
+    this->name_template = name_template;
+  }
+
+  /**
+   * @brief A thread from the thread_pool call this function to execute
+   *        the task
+   */
+  void execute() override;
+
+private:
+  stex_file* file;            //!<a j2k codestream file with other variables
+  const char* name_template;  //!<a template for the target file name
+};
+
 } // !stex namespace
 } // !ojph namespace
 
-#endif // !THREADED_FRAME_PROCESSOR_H
\ No newline at end of file
+#endif // !THREADED_FRAME_PROCESSOR_H
\ No newline at end of file
@@ -0,0 +1,252 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_batch.cpp
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+#include "ojph_arch.h"
+#include "ojph_batch.h"
+#include "ojph_threads.h"
+#include "ojph_message.h"
+
+namespace ojph
+{
+namespace batch
+{
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Finds the single integer conversion of a pattern; returns its
+  // conversion character, or 0 if there is none, or more than one.
+  static char find_conversion(const char *name)
+  {
+    char conversion = 0;
+    for (const char *p = name; *p; ++p)
+    {
+      if (*p != '%')
+        continue;
+      ++p;
+      if (*p == '%')
+        continue;
+      while (*p == '0' || *p == '-' || *p == '+' || *p == ' ')
+        ++p;
+      while (*p >= '0' && *p <= '9')
+        ++p;
+      if ((*p != 'd' && *p != 'i' && *p != 'u') || conversion != 0)
+        return 0;
+      conversion = *p;
+    }
+    return conversion;
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  bool job_list::is_pattern(const char *name)
+  {
+    return strchr(name, '%') != NULL && find_conversion(name) != 0;
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  static std::string expand(const char *pattern, char conversion, ui32 n)
+  {
+    std::vector<char> buf(strlen(pattern) + 32);
+    if (conversion == 'u')
+      snprintf(buf.data(), buf.size(), pattern, n);
+    else
+      snprintf(buf.data(), buf.size(), pattern, (int)n);
+    return std::string(buf.data());
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  void job_list::init_from_patterns(const char *in_pattern,
+                                    const char *out_pattern,
+                                    ui32 first_frame, ui32 num_frames)
+  {
+    char in_conv = find_conversion(in_pattern);
+    char out_conv = find_conversion(out_pattern);
+    if (in_conv == 0 || out_conv == 0)
+      OJPH_ERROR(0x000B0001, "in batch mode, the input and output file "
+        "names must each contain one integer conversion, such as %%05d; "
+        "they are \"%s\" and \"%s\"", in_pattern, out_pattern);
+
+    inputs.clear();
+    outputs.clear();
+    inputs.reserve(num_frames);
+    outputs.reserve(num_frames);
+    for (ui32 i = 0; i < num_frames; ++i)
+    {
+      inputs.push_back(expand(in_pattern, in_conv, first_frame + i));
+      outputs.push_back(expand(out_pattern, out_conv, first_frame + i));
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  void job_list::init_from_file(const char *filename)
+  {
+    FILE *fh = fopen(filename, "r");
+    if (fh == NULL)
+      OJPH_ERROR(0x000B0002, "unable to open list file %s", filename);
+
+    inputs.clear();
+    outputs.clear();
+    char line[4096];
+    ui32 line_num = 0;
+    while (fgets(line, sizeof(line), fh))
+    {
+      ++line_num;
+      const char *sep = " \t\r\n";
+      char *save = NULL;
+#ifdef OJPH_OS_WINDOWS
+      char *in = strtok_s(line, sep, &save);
+      char *out = in ? strtok_s(NULL, sep, &save) : NULL;
+      char *extra = out ? strtok_s(NULL, sep, &save) : NULL;
+#else
+      char *in = strtok_r(line, sep, &save);
+      char *out = in ? strtok_r(NULL, sep, &save) : NULL;
+      char *extra = out ? strtok_r(NULL, sep, &save) : NULL;
+#endif
+      if (in == NULL || in[0] == '#')
+        continue;
+      if (out == NULL || extra != NULL)
+      {
+        fclose(fh);
+        OJPH_ERROR(0x000B0003, "line %d of list file %s must hold an "
+          "input and an output file name", line_num, filename);
+      }
+      inputs.push_back(in);
+      outputs.push_back(out);
+    }
+    fclose(fh);
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ///////////////////////////////////////////////////////////////////////////
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Runs one worker until the jobs are exhausted
+  struct worker_task : public thds::worker_thread_base
+  {
+    worker_task() : w(NULL), jobs(NULL), next_job(NULL), num_images(0),
+                    num_failed(0) {}
+
+    virtual void execute()
+    {
+      std::string out_name;
+      size_t num_jobs = jobs->get_num_jobs();
+      for (size_t i = (*next_job)++; i < num_jobs; i = (*next_job)++)
+      {
+        out_name = jobs->get_output(i);
+        image_stats s;
+        try {
+          w->process(jobs->get_input(i), &out_name[0], s);
+          ++num_images;
+          stats.num_samples += s.num_samples;
+          stats.coded_bytes += s.coded_bytes;
+        }
+        catch (const std::exception& e)
+        {
+          const char *p = e.what();
+          if (strncmp(p, "ojph error", 10) != 0)
+            printf("%s\n", p);
+          printf("failed to process %s\n", jobs->get_input(i));
+          ++num_failed;
+        }
+      }
+    }
+
+    worker *w;
+    const job_list *jobs;
+    std::atomic<size_t> *next_job;
+    size_t num_images, num_failed;
+    image_stats stats;
+  };
+
+  ///////////////////////////////////////////////////////////////////////////
+  size_t run(const job_list& jobs, worker **workers, ui32 num_workers)
+  {
+    assert(num_workers > 0);
+    std::chrono::steady_clock::time_point begin =
+      std::chrono::steady_clock::now();
+
+    std::atomic<size_t> next_job(0);
+    std::vector<worker_task> tasks(num_workers);
+    thds::thread_pool pool;
+    pool.init(num_workers - 1);
+    thds::task_group group(&pool);
+    for (ui32 i = 0; i < num_workers; ++i)
+    {
+      tasks[i].w = workers[i];
+      tasks[i].jobs = &jobs;
+      tasks[i].next_job = &next_job;
+      if (i > 0)
+        group.add_task(tasks.data() + i);
+    }
+    tasks[0].execute();
+    group.wait();
+
+    std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - begin;
+
+    size_t num_images = 0, num_failed = 0;
+    image_stats total;
+    for (ui32 i = 0; i < num_workers; ++i)
+    {
+      num_images += tasks[i].num_images;
+      num_failed += tasks[i].num_failed;
+      total.num_samples += tasks[i].stats.num_samples;
+      total.coded_bytes += tasks[i].stats.coded_bytes;
+    }
+
+    double secs = elapsed.count() > 0.0 ? elapsed.count() : 1e-9;
+    printf("Processed %zu images, %zu failed, using %u thread(s), "
+      "in %f seconds\n", num_images, num_failed, num_workers, secs);
+    printf("Throughput = %.2f images/s, %.2f Msamples/s, "
+      "%.2f MB/s of codestream data (%.2f MB in total)\n",
+      (double)num_images / secs, (double)total.num_samples / secs * 1e-6,
+      (double)total.coded_bytes / secs * 1e-6,
+      (double)total.coded_bytes * 1e-6);
+
+    return num_failed;
+  }
+
+} // !batch namespace
+} // !ojph namespace
@@ -36,9 +36,20 @@
 //***************************************************************************/
 
 
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 
+#include "ojph_arch.h"
+#ifdef OJPH_OS_WINDOWS
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
 #include "ojph_file.h"
 #include "ojph_img_io.h"
 #include "ojph_mem.h"
@@ -232,6 +243,350 @@ namespace ojph {
     }
   }
 
+  void gen_cvrt_32b1c_to_p010_1c(const line_buf *ln0, const line_buf *ln1,
+                                 const line_buf *ln2, void *dp,
+                                 ui32 bit_depth, ui32 count)
+  {
+    ojph_unused(ln1);
+    ojph_unused(ln2);
+    int max_val = (1<<bit_depth) - 1;
+    ui32 shift = 16 - bit_depth;
+    const si32 *sp = ln0->i32;
+    ui16* p = (ui16*)dp;
+    for (; count > 0; --count)
+    {
+      int val = *sp++;
+      val = val >= 0 ? val : 0;
+      val = val <= max_val ? val : max_val;
+      *p++ = (ui16)(val << shift);
+    }
+  }
+
+  void gen_cvrt_32b1c_to_p010_2c(const line_buf *ln0, const line_buf *ln1,
+                                 const line_buf *ln2, void *dp,
+                                 ui32 bit_depth, ui32 count)
+  {
+    ojph_unused(ln1);
+    ojph_unused(ln2);
+    int max_val = (1<<bit_depth) - 1;
+    ui32 shift = 16 - bit_depth;
+    const si32 *sp = ln0->i32;
+    ui16* p = (ui16*)dp;
+    for (; count > 0; --count, p += 2)
+    {
+      int val = *sp++;
+      val = val >= 0 ? val : 0;
+      val = val <= max_val ? val : max_val;
+      *p = (ui16)(val << shift);
+    }
+  }
+
+  void gen_cvrt_32b3c_to_v210(const line_buf *ln0, const line_buf *ln1,
+                              const line_buf *ln2, void *dp,
+                              ui32 bit_depth, ui32 count)
+  {
+    int max_val = (1<<bit_depth) - 1;
+    const si32 *sp0 = ln0->i32;
+    const si32 *sp1 = ln1->i32;
+    const si32 *sp2 = ln2->i32;
+    ui32 chroma_count = (count + 1) >> 1;
+    ui32* p = (ui32*)dp;
+    // each block of 4 words holds 6 luma samples and 3 of each chroma;
+    // samples past the end of the line are set to 0
+    for (ui32 x = 0; x < count; x += 6, p += 4)
+    {
+      ui32 y[6] = { 0 }, cb[3] = { 0 }, cr[3] = { 0 };
+      ui32 n = ojph_min(count - x, 6u);
+      for (ui32 i = 0; i < n; ++i)
+      {
+        int val = sp0[x + i];
+        val = val >= 0 ? val : 0;
+        val = val <= max_val ? val : max_val;
+        y[i] = (ui32)val;
+      }
+      ui32 c = x >> 1;
+      n = ojph_min(chroma_count - c, 3u);
+      for (ui32 i = 0; i < n; ++i)
+      {
+        int val = sp1[c + i];
+        val = val >= 0 ? val : 0;
+        val = val <= max_val ? val : max_val;
+        cb[i] = (ui32)val;
+        val = sp2[c + i];
+        val = val >= 0 ? val : 0;
+        val = val <= max_val ? val : max_val;
+        cr[i] = (ui32)val;
+      }
+      p[0] = cb[0] | (y[0] << 10) | (cr[0] << 20);
+      p[1] = y[1] | (cb[1] << 10) | (y[2] << 20);
+      p[2] = cr[1] | (y[3] << 10) | (cb[2] << 20);
+      p[3] = y[4] | (cr[2] << 10) | (y[5] << 20);
+    }
+  }
+
+  void gen_cvrt_32b3c_to_dpx10_be(const line_buf *ln0, const line_buf *ln1,
+                                  const line_buf *ln2, void *dp,
+                                  ui32 bit_depth, ui32 count)
+  {
+    int max_val = (1<<bit_depth) - 1;
+    const si32 *sp0 = ln0->i32;
+    const si32 *sp1 = ln1->i32;
+    const si32 *sp2 = ln2->i32;
+    ui32* p = (ui32*)dp;
+    for (; count > 0; --count)
+    {
+      int r = *sp0++, g = *sp1++, b = *sp2++;
+      r = r >= 0 ? r : 0;
+      r = r <= max_val ? r : max_val;
+      g = g >= 0 ? g : 0;
+      g = g <= max_val ? g : max_val;
+      b = b >= 0 ? b : 0;
+      b = b <= max_val ? b : max_val;
+      *p++ = be2le(((ui32)r << 22) | ((ui32)g << 12) | ((ui32)b << 2));
+    }
+  }
+
+  // The unpackers below read bytes rather than ui16s, because samples in
+  // a mapped file need not be aligned.  For 3c, sp points to the first
+  // sample of the component, and every third sample is taken.
+
+  void gen_cvrt_8ub1c_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for (; count > 0; --count)
+      *dp++ = (si32)*p++;
+  }
+
+  void gen_cvrt_8sb1c_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const si8 *p = (const si8 *)sp;
+    for (; count > 0; --count)
+      *dp++ = (si32)*p++;
+  }
+
+  void gen_cvrt_8ub3c_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for (; count > 0; --count, p += 3)
+      *dp++ = (si32)*p;
+  }
+
+  void gen_cvrt_16ub1c_le_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for (; count > 0; --count, p += 2)
+      *dp++ = (si32)(p[0] | (p[1] << 8));
+  }
+
+  void gen_cvrt_16sb1c_le_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for (; count > 0; --count, p += 2)
+      *dp++ = (si32)(si16)(p[0] | (p[1] << 8));
+  }
+
+  void gen_cvrt_16ub1c_be_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for (; count > 0; --count, p += 2)
+      *dp++ = (si32)((p[0] << 8) | p[1]);
+  }
+
+  void gen_cvrt_16ub3c_be_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for (; count > 0; --count, p += 6)
+      *dp++ = (si32)((p[0] << 8) | p[1]);
+  }
+
+  void gen_cvrt_p010_1c_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for (; count > 0; --count, p += 2)
+      *dp++ = (si32)((p[0] | (p[1] << 8)) >> 6);
+  }
+
+  void gen_cvrt_p010_2c_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for (; count > 0; --count, p += 4)
+      *dp++ = (si32)((p[0] | (p[1] << 8)) >> 6);
+  }
+
+  void gen_cvrt_v210_to_32b3c(const void *sp, si32 *dp0, si32 *dp1,
+                              si32 *dp2, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    ui32 chroma_count = (count + 1) >> 1;
+    // a line always holds whole blocks, so a block can be read in full
+    for (ui32 x = 0; x < count; x += 6, p += 16)
+    {
+      ui32 w[4];
+      for (int i = 0; i < 4; ++i)
+        w[i] = (ui32)p[4*i] | ((ui32)p[4*i+1] << 8)
+             | ((ui32)p[4*i+2] << 16) | ((ui32)p[4*i+3] << 24);
+      si32 y[6], cb[3], cr[3];
+      cb[0] = (si32)(w[0] & 0x3FF);
+      y[0]  = (si32)((w[0] >> 10) & 0x3FF);
+      cr[0] = (si32)((w[0] >> 20) & 0x3FF);
+      y[1]  = (si32)(w[1] & 0x3FF);
+      cb[1] = (si32)((w[1] >> 10) & 0x3FF);
+      y[2]  = (si32)((w[1] >> 20) & 0x3FF);
+      cr[1] = (si32)(w[2] & 0x3FF);
+      y[3]  = (si32)((w[2] >> 10) & 0x3FF);
+      cb[2] = (si32)((w[2] >> 20) & 0x3FF);
+      y[4]  = (si32)(w[3] & 0x3FF);
+      cr[2] = (si32)((w[3] >> 10) & 0x3FF);
+      y[5]  = (si32)((w[3] >> 20) & 0x3FF);
+
+      ui32 n = ojph_min(count - x, 6u);
+      for (ui32 i = 0; i < n; ++i)
+        dp0[x + i] = y[i];
+      ui32 c = x >> 1;
+      n = ojph_min(chroma_count - c, 3u);
+      for (ui32 i = 0; i < n; ++i)
+      {
+        dp1[c + i] = cb[i];
+        dp2[c + i] = cr[i];
+      }
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Picks the fastest unpacker for samples of bytes_per_sample bytes (1 or
+  // 2); num_comps is 1 or 3.  Big-endian samples are unsigned, and
+  // interleaved samples are unsigned and big-endian, which is what the
+  // readers need.
+  static
+  unpack_fun select_unpacker(ui32 bytes_per_sample, ui32 num_comps,
+                             bool is_signed, bool big_endian)
+  {
+    assert(bytes_per_sample == 1 || bytes_per_sample == 2);
+    assert(num_comps == 1 || num_comps == 3);
+    assert(!big_endian || !is_signed);
+    assert(num_comps == 1 || (!is_signed && (big_endian ||
+           bytes_per_sample == 1)));
+
+    unpack_fun f;
+    if (bytes_per_sample == 1)
+      f = num_comps == 3 ? gen_cvrt_8ub3c_to_32b1c
+        : is_signed ? gen_cvrt_8sb1c_to_32b1c : gen_cvrt_8ub1c_to_32b1c;
+    else if (big_endian)
+      f = num_comps == 3 ? gen_cvrt_16ub3c_be_to_32b1c
+        : gen_cvrt_16ub1c_be_to_32b1c;
+    else
+      f = is_signed ? gen_cvrt_16sb1c_le_to_32b1c
+        : gen_cvrt_16ub1c_le_to_32b1c;
+
+#if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
+  #ifndef OJPH_DISABLE_SIMD
+
+    #if (defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
+
+      #ifndef OJPH_DISABLE_AVX2
+        if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_AVX2) {
+          if (bytes_per_sample == 1)
+            f = num_comps == 3 ? avx2_cvrt_8ub3c_to_32b1c
+              : is_signed ? avx2_cvrt_8sb1c_to_32b1c
+              : avx2_cvrt_8ub1c_to_32b1c;
+          else if (big_endian)
+            f = num_comps == 3 ? avx2_cvrt_16ub3c_be_to_32b1c
+              : avx2_cvrt_16ub1c_be_to_32b1c;
+          else
+            f = is_signed ? avx2_cvrt_16sb1c_le_to_32b1c
+              : avx2_cvrt_16ub1c_le_to_32b1c;
+        }
+      #endif // !OJPH_DISABLE_AVX2
+
+      #ifndef OJPH_DISABLE_AVX512
+        if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_AVX512) {
+          if (bytes_per_sample == 1)
+            f = num_comps == 3 ? avx512_cvrt_8ub3c_to_32b1c
+              : is_signed ? avx512_cvrt_8sb1c_to_32b1c
+              : avx512_cvrt_8ub1c_to_32b1c;
+          else if (big_endian)
+            f = num_comps == 3 ? avx512_cvrt_16ub3c_be_to_32b1c
+              : avx512_cvrt_16ub1c_be_to_32b1c;
+          else
+            f = is_signed ? avx512_cvrt_16sb1c_le_to_32b1c
+              : avx512_cvrt_16ub1c_le_to_32b1c;
+        }
+      #endif // !OJPH_DISABLE_AVX512
+
+    #endif // !(defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
+
+  #endif // !OJPH_DISABLE_SIMD
+#endif // !OJPH_ENABLE_WASM_SIMD
+
+    return f;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////////////////
+  bool mapped_file::open(const char *filename)
+  {
+    assert(data == NULL);
+#ifdef OJPH_OS_WINDOWS
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+      OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+      return false;
+    LARGE_INTEGER file_size;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0
+        && (ui64)file_size.QuadPart <= (ui64)SIZE_MAX)
+      mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping != NULL)
+    {
+      data = (const ui8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle(mapping);  // the view keeps the mapping alive
+    }
+    CloseHandle(file);
+    if (data == NULL)
+      return false;
+    size = (ui64)file_size.QuadPart;
+#else
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0
+        && (ui64)st.st_size <= (ui64)SIZE_MAX)
+    {
+      void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED)
+      {
+        data = (const ui8*)p;
+        size = (ui64)st.st_size;
+        madvise(p, (size_t)size, MADV_SEQUENTIAL);
+      }
+    }
+    ::close(fd);  // the mapping stays valid
+#endif
+    return data != NULL;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void mapped_file::close()
+  {
+    if (data == NULL)
+      return;
+#ifdef OJPH_OS_WINDOWS
+    UnmapViewOfFile(data);
+#else
+    munmap((void*)data, (size_t)size);
+#endif
+    data = NULL;
+    size = 0;
+  }
+
 
   ////////////////////////////////////////////////////////////////////////////
   //
@@ -320,6 +675,9 @@ namespace ojph {
       }
     }
     cur_line = 0;
+
+    map.open(filename);       // otherwise, lines are read with fread
+    unpacker = select_unpacker(bytes_per_sample, num_comps, false, true);
   }
 
   /////////////////////////////////////////////////////////////////////////////
@@ -342,35 +700,37 @@ namespace ojph {
 
     if (planar || comp_num == 0)
     {
-      size_t result = fread(
-        temp_buf, bytes_per_sample, num_ele_per_line, fh);
-      if (result != num_ele_per_line)
+      ui64 line_bytes = (ui64)bytes_per_sample * num_ele_per_line;
+      if (map.is_open())
       {
-        close();
-        OJPH_ERROR(0x03000011, "not enough data in file %s", fname);
+        ui64 offset = (ui64)start_of_data + cur_line * line_bytes;
+        if (offset + line_bytes > map.get_size())
+        {
+          close();
+          OJPH_ERROR(0x03000011, "not enough data in file %s", fname);
+        }
+        line_data = map.get_data() + offset;
+      }
+      else
+      {
+        size_t result = fread(
+          temp_buf, bytes_per_sample, num_ele_per_line, fh);
+        if (result != num_ele_per_line)
+        {
+          close();
+          OJPH_ERROR(0x03000011, "not enough data in file %s", fname);
+        }
+        line_data = (const ui8*)temp_buf;
       }
       if (++cur_line >= height)
       {
         cur_line = 0;
-        ojph_fseek(fh, start_of_data, SEEK_SET); //handles plannar reading
+        if (!map.is_open()) //handles plannar reading
+          ojph_fseek(fh, start_of_data, SEEK_SET);
       }
     }
 
-    if (bytes_per_sample == 1)
-    {
-      const ui8* sp = (ui8*)temp_buf + comp_num;
-      si32* dp = line->i32;
-      for (ui32 i = width; i > 0; --i, sp+=num_comps)
-        *dp++ = (si32)*sp;
-    }
-    else
-    {
-      const ui16* sp = (ui16*)temp_buf + comp_num;
-      si32* dp = line->i32;
-      for (ui32 i = width; i > 0; --i, sp+=num_comps)
-        *dp++ = (si32)be2le(*sp);
-    }
-
+    unpacker(line_data + comp_num * bytes_per_sample, line->i32, width);
     return width;
   }
 
@@ -385,7 +745,7 @@ namespace ojph {
   ////////////////////////////////////////////////////////////////////////////
   void ppm_out::open(char* filename)
   {
-    assert(fh == NULL && buffer == NULL);
+    assert(fh == NULL);
     if (num_components == 1)
     {
       size_t len = strlen(filename);
@@ -408,8 +768,11 @@ namespace ojph {
           "unable to open file %s for writing", filename);
 
       fprintf(fh, "P5\n%d %d\n%d\n", width, height, (1 << bit_depth) - 1);
-      buffer_size = (size_t)width * bytes_per_sample;
-      buffer = (ui8*)malloc(buffer_size);
+      size_t needed = (size_t)width * bytes_per_sample;
+      if (buffer_size < needed) { // the buffer is kept for the next image
+        buffer_size = needed;
+        buffer = (ui8*)realloc(buffer, buffer_size);
+      }
     }
     else
     {
@@ -435,8 +798,11 @@ namespace ojph {
         fprintf(fh, "P6\n%d %d\n%d\n", width, height, (1 << bit_depth) - 1);
       if (result == 0)
         OJPH_ERROR(0x03000027, "error writing to file %s", filename);
-      buffer_size = (size_t)width * num_components * (size_t)bytes_per_sample;
-      buffer = (ui8*)malloc(buffer_size);
+      size_t needed = (size_t)width * num_components * bytes_per_sample;
+      if (buffer_size < needed) { // the buffer is kept for the next image
+        buffer_size = needed;
+        buffer = (ui8*)realloc(buffer, buffer_size);
+      }
     }
     fname = filename;
     cur_line = 0;
@@ -725,7 +1091,7 @@ namespace ojph {
   ////////////////////////////////////////////////////////////////////////////
   void pfm_out::open(char* filename)
   {
-    assert(fh == NULL && buffer == NULL);
+    assert(fh == NULL);
     fh = fopen(filename, "wb");
     if (fh == NULL)
       OJPH_ERROR(0x03000071,
@@ -735,8 +1101,11 @@ namespace ojph {
         num_components > 1 ? 'F' : 'f', width, height, scale);
     if (result == 0)
       OJPH_ERROR(0x03000072, "error writing to file %s", filename);
-    buffer_size = (size_t)width * num_components * sizeof(float);
-    buffer = (float*)malloc(buffer_size);
+    size_t needed = (size_t)width * num_components * sizeof(float);
+    if (buffer_size < needed) { // the buffer is kept for the next image
+      buffer_size = needed;
+      buffer = (float*)realloc(buffer, buffer_size);
+    }
     fname = filename;
     cur_line = 0;
     start_of_data = ojph_ftell(fh);
@@ -850,6 +1219,8 @@ namespace ojph {
       bytes_per_line = TIFFScanlineSize64(tiff_handle);
     }
     // allocate linebuffer to hold a line of image data
+    if (line_buffer)   // left from a previous file
+      free(line_buffer);
     line_buffer = malloc(bytes_per_line);
     if (NULL == line_buffer)
       OJPH_ERROR(0x03000092, "Unable to allocate %d bytes for line_buffer[] "
@@ -900,6 +1271,16 @@ namespace ojph {
 
     // allocate intermediate linebuffers to hold a line of a single component 
     // of image data
+    if (line_buffer_for_planar_support_uint8)  // left from a previous file
+    {
+      free(line_buffer_for_planar_support_uint8);
+      line_buffer_for_planar_support_uint8 = NULL;
+    }
+    if (line_buffer_for_planar_support_uint16)
+    {
+      free(line_buffer_for_planar_support_uint16);
+      line_buffer_for_planar_support_uint16 = NULL;
+    }
     if (tiff_planar_configuration == PLANARCONFIG_SEPARATE && 
         bytes_per_sample == 1)
     {
@@ -1083,14 +1464,18 @@ namespace ojph {
         "num_components=1 to 4");
     }
 
-    assert(tiff_handle == NULL && buffer == NULL);
+    assert(tiff_handle == NULL);
     if ((tiff_handle = TIFFOpen(filename, "w")) == NULL)
     {
       OJPH_ERROR(0x030000B3, "unable to open file %s for writing", filename);
     }
 
-    buffer_size = width * (size_t)num_components * (size_t)bytes_per_sample;
-    buffer = (ui8*)malloc(buffer_size);
+    size_t needed =
+      width * (size_t)num_components * (size_t)bytes_per_sample;
+    if (buffer_size < needed) { // the buffer is kept for the next image
+      buffer_size = needed;
+      buffer = (ui8*)realloc(buffer, buffer_size);
+    }
     fname = filename;
     cur_line = 0;
 
@@ -1313,37 +1698,45 @@ namespace ojph {
       comp_address[i] += width[i-1] * height[i-1] * bytes_per_sample[i-1];
       max_byte_width = ojph_max(max_byte_width, width[i]*bytes_per_sample[i]);
     }
+    if (temp_buf)      // left from a previous file
+      free(temp_buf);
     temp_buf = malloc(max_byte_width);
     fname = filename;
+
+    map.open(filename);       // otherwise, lines are read with fread
+    map_offset = 0;
+    for (ui32 i = 0; i < num_com; ++i)
+      unpacker[i] = select_unpacker(bytes_per_sample[i], 1, false, false);
   }
 
   ////////////////////////////////////////////////////////////////////////////
   ui32 yuv_in::read(const line_buf* line, ui32 comp_num)
   {
     assert(comp_num < num_com);
-    size_t result = fread(temp_buf, bytes_per_sample[comp_num],
-                          width[comp_num], fh);
-    if (result != width[comp_num])
+    const void *sp = temp_buf;
+    if (map.is_open())
     {
-      close();
-      OJPH_ERROR(0x030000E1, "not enough data in file %s", fname);
-    }
-
-    if (bytes_per_sample[comp_num] == 1)
-    {
-      const ui8* sp = (ui8*)temp_buf;
-      si32* dp = line->i32;
-      for (ui32 i = width[comp_num]; i > 0; --i, ++sp)
-        *dp++ = (si32)*sp;
+      ui64 line_bytes = (ui64)bytes_per_sample[comp_num] * width[comp_num];
+      if (map_offset + line_bytes > map.get_size())
+      {
+        close();
+        OJPH_ERROR(0x030000E1, "not enough data in file %s", fname);
+      }
+      sp = map.get_data() + map_offset;
+      map_offset += line_bytes;
     }
     else
     {
-      const ui16* sp = (ui16*)temp_buf;
-      si32* dp = line->i32;
-      for (ui32 i = width[comp_num]; i > 0; --i, ++sp)
-        *dp++ = (si32)*sp;
+      size_t result = fread(temp_buf, bytes_per_sample[comp_num],
+                            width[comp_num], fh);
+      if (result != width[comp_num])
+      {
+        close();
+        OJPH_ERROR(0x030000E1, "not enough data in file %s", fname);
+      }
     }
 
+    unpacker[comp_num](sp, line->i32, width[comp_num]);
     return width[comp_num];
   }
 
@@ -1431,6 +1824,8 @@ namespace ojph {
     assert(fh == NULL);
     this->num_components = num_components;
     this->bit_depth = bit_depth;
+    if (this->comp_width)   // left from a previous configuration
+      delete[] this->comp_width;
     this->comp_width = new ui32[num_components];
     ui32 tw = 0;
     for (ui32 i = 0; i < num_components; ++i)
@@ -1439,8 +1834,11 @@ namespace ojph {
       tw = ojph_max(tw, this->comp_width[i]);
     }
     this->width = tw;
-    buffer_size = tw * (bit_depth > 8 ? 2 : 1);
-    buffer = (ui8*)malloc(buffer_size);
+    ui32 needed = tw * (bit_depth > 8 ? 2 : 1);
+    if (buffer_size < needed) { // the buffer is kept for the next image
+      buffer_size = needed;
+      buffer = (ui8*)realloc(buffer, buffer_size);
+    }
   }
 
   ////////////////////////////////////////////////////////////////////////////
@@ -1501,9 +1899,17 @@ namespace ojph {
 
     cur_line = 0;
     bytes_per_sample = (bit_depth + 7) >> 3;
-    buffer_size = (size_t)width * bytes_per_sample;
-    buffer = (ui8*)malloc(buffer_size);
+    size_t needed = (size_t)width * bytes_per_sample;
+    if (buffer_size < needed) { // the buffer is kept for the next image
+      buffer_size = needed;
+      buffer = realloc(buffer, buffer_size);
+    }
     fname = filename;
+
+    map.open(filename);       // otherwise, lines are read with fread
+    map_offset = 0;
+    if (bytes_per_sample <= 2)
+      unpacker = select_unpacker(bytes_per_sample, 1, is_signed, false);
   }
 
   ////////////////////////////////////////////////////////////////////////////
@@ -1511,78 +1917,61 @@ namespace ojph {
   {
     ojph_unused(comp_num);
     assert(comp_num == 0);
-    size_t result = fread(buffer, bytes_per_sample, width, fh);
-    if (result != width)
+    const void *src = buffer;
+    if (map.is_open())
     {
-      close();
-      OJPH_ERROR(0x03000132, "not enough data in file %s", fname);
+      ui64 line_bytes = (ui64)bytes_per_sample * width;
+      if (map_offset + line_bytes > map.get_size())
+      {
+        close();
+        OJPH_ERROR(0x03000132, "not enough data in file %s", fname);
+      }
+      src = map.get_data() + map_offset;
+      map_offset += line_bytes;
+    }
+    else
+    {
+      size_t result = fread(buffer, bytes_per_sample, width, fh);
+      if (result != width)
+      {
+        close();
+        OJPH_ERROR(0x03000132, "not enough data in file %s", fname);
+      }
     }
 
     if (bytes_per_sample > 3)
     {
       si32* dp = line->i32;
       if (is_signed) {
-        const si32* sp = (si32*)buffer;
+        const si32* sp = (const si32*)src;
         for (ui32 i = width; i > 0; --i, ++sp)
           *dp++ = *sp;
       }
       else {
-        si32* dp = line->i32;
-        const ui32* sp = (ui32*)buffer;
+        const ui32* sp = (const ui32*)src;
         for (ui32 i = width; i > 0; --i, ++sp)
           *dp++ = (si32)*sp;
       }
     }
     else if (bytes_per_sample > 2)
     {
+      // little-endian samples; reading bytes does not go past the line
       si32* dp = line->i32;
+      const ui8* sp = (const ui8*)src;
       if (is_signed) {
-        const si32* sp = (si32*)buffer;
-        for (ui32 i = width; i > 0; --i) {
-          si32 val = *sp & 0xFFFFFF;
-          val |= (val & 0x800000) ? 0xFF000000 : 0;
+        for (ui32 i = width; i > 0; --i, sp += 3) {
+          si32 val = (si32)(sp[0] | (sp[1] << 8) | (sp[2] << 16));
+          val |= (val & 0x800000) ? (si32)0xFF000000 : 0;
           *dp++ = val;
-          // this only works for little endian architecture
-          sp = (si32*)((si8*)sp + 3);
-        }
-      }
-      else {
-        const ui32* sp = (ui32*)buffer;
-        for (ui32 i = width; i > 0; --i) {
-          *dp++ = (si32)(*sp & 0xFFFFFFu);
-          // this only works for little endian architecture
-          sp = (ui32*)((ui8*)sp + 3);
         }
       }
-    }
-    else if (bytes_per_sample > 1)
-    {
-      si32* dp = line->i32;
-      if (is_signed) {
-        const si16* sp = (si16*)buffer;
-        for (ui32 i = width; i > 0; --i, ++sp)
-          *dp++ = *sp;
-      }
       else {
-        const ui16* sp = (ui16*)buffer;
-        for (ui32 i = width; i > 0; --i, ++sp)
-          *dp++ = (si32)*sp;
+        for (ui32 i = width; i > 0; --i, sp += 3)
+          *dp++ = (si32)(sp[0] | (sp[1] << 8) | (sp[2] << 16));
       }
     }
     else
-    {
-      si32* dp = line->i32;
-      if (is_signed) {
-        const si8* sp = (si8*)buffer;
-        for (ui32 i = width; i > 0; --i, ++sp)
-          *dp++ = *sp;
-      }
-      else {
-        const ui8* sp = (ui8*)buffer;
-        for (ui32 i = width; i > 0; --i, ++sp)
-          *dp++ = (si32)*sp;
-      }
-    }
+      unpacker(src, line->i32, width);
 
     return width;
   }
@@ -1645,8 +2034,11 @@ namespace ojph {
     }
 
     bytes_per_sample = (bit_depth + 7) >> 3;
-    buffer_size = width * bytes_per_sample;
-    buffer = (ui8*)malloc(buffer_size);
+    ui32 needed = width * bytes_per_sample;
+    if (buffer_size < needed) { // the buffer is kept for the next image
+      buffer_size = needed;
+      buffer = (ui8*)realloc(buffer, buffer_size);
+    }
   }
 
   ////////////////////////////////////////////////////////////////////////////
@@ -2014,7 +2406,12 @@ namespace ojph {
 
     cur_line = 0;
 
-    // allocate linebuffer to hold a line of image data from the file
+    // allocate linebuffer to hold a line of image data from the file;
+    // buffers left from a previous file are released first
+    if (line_buffer)
+      free(line_buffer);
+    if (line_buffer_16bit_samples)
+      free(line_buffer_16bit_samples);
     line_buffer = malloc(number_of_32_bit_words_per_line * sizeof(ui32) );
     if (NULL == line_buffer)
       OJPH_ERROR(0x03000178, "Unable to allocate %d bytes for line_buffer[] "
@@ -2122,4 +2519,418 @@ namespace ojph {
     return width;
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////////////////
+  void v210_in::set_img_props(const size& s)
+  {
+    assert(fh == NULL);
+    width = s.w;
+    height = s.h;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void v210_in::open(const char* filename)
+  {
+    assert(fh == NULL);
+    fh = fopen(filename, "rb");
+    if (fh == NULL)
+      OJPH_ERROR(0x030001A1, "Unable to open file %s", filename);
+    fname = filename;
+
+    // 48 pixels occupy 128 bytes, and each line is padded to that size
+    bytes_per_line = ((width + 47) / 48) * 128;
+    ui32 chroma_width = (width + 1) >> 1;
+    size_t needed = (size_t)width + 2 * (size_t)chroma_width;
+    if (buffer_size < needed) { // the buffers are kept for the next image
+      buffer_size = needed;
+      samples = (si32*)realloc(samples, buffer_size * sizeof(si32));
+      line_data = (ui8*)realloc(line_data, bytes_per_line);
+    }
+    cur_line[2] = cur_line[1] = cur_line[0] = 0;
+    unpacked_line = height;
+    file_pos = 0;
+
+    map.open(filename);       // otherwise, lines are read with fread
+
+    unpacker = gen_cvrt_v210_to_32b3c;
+#if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
+  #if !defined(OJPH_DISABLE_SIMD) && !defined(OJPH_DISABLE_AVX2)
+    #if (defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
+      if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_AVX2)
+        unpacker = avx2_cvrt_v210_to_32b3c;
+    #endif
+  #endif
+#endif // !OJPH_ENABLE_WASM_SIMD
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  ui32 v210_in::read(const line_buf* line, ui32 comp_num)
+  {
+    assert(comp_num < 3);
+    ui32 y = cur_line[comp_num]++;
+    if (y != unpacked_line)
+    {
+      // all components of a line are unpacked together
+      const ui8 *sp = line_data;
+      ui64 offset = (ui64)y * bytes_per_line;
+      if (y >= height)
+        OJPH_ERROR(0x030001A2, "reading past the end of file %s", fname);
+      if (map.is_open())
+      {
+        if (offset + bytes_per_line > map.get_size())
+          OJPH_ERROR(0x030001A3, "not enough data in file %s", fname);
+        sp = map.get_data() + offset;
+      }
+      else
+      {
+        if (offset != file_pos && ojph_fseek(fh, (si64)offset, SEEK_SET))
+          OJPH_ERROR(0x030001A4, "unable to seek in file %s", fname);
+        if (fread(line_data, 1, bytes_per_line, fh) != bytes_per_line)
+          OJPH_ERROR(0x030001A3, "not enough data in file %s", fname);
+        file_pos = offset + bytes_per_line;
+      }
+      ui32 chroma_width = (width + 1) >> 1;
+      unpacker(sp, samples, samples + width,
+               samples + width + chroma_width, width);
+      unpacked_line = y;
+    }
+
+    ui32 chroma_width = (width + 1) >> 1;
+    if (comp_num == 0) {
+      memcpy(line->i32, samples, width * sizeof(si32));
+      return width;
+    }
+    else {
+      const si32 *sp = samples + width + (comp_num - 1) * chroma_width;
+      memcpy(line->i32, sp, chroma_width * sizeof(si32));
+      return chroma_width;
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////////////////
+  void v210_out::open(char* filename)
+  {
+    assert(fh == NULL); //configure before open
+    fh = fopen(filename, "wb");
+    if (fh == NULL)
+      OJPH_ERROR(0x030001B1, "Unable to open file %s", filename);
+    fname = filename;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void v210_out::configure(ui32 width, ui32 height)
+  {
+    assert(fh == NULL);
+    this->width = width;
+    this->height = height;
+    bytes_per_line = ((width + 47) / 48) * 128;
+    if (buffer_size < bytes_per_line) { // the buffer is kept for next image
+      buffer_size = bytes_per_line;
+      buffer = (ui8*)realloc(buffer, buffer_size);
+    }
+    memset(buffer, 0, bytes_per_line); // the padding is never written to
+
+    converter = gen_cvrt_32b3c_to_v210;
+#if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
+  #if !defined(OJPH_DISABLE_SIMD) && !defined(OJPH_DISABLE_AVX2)
+    #if (defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
+      if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_AVX2)
+        converter = avx2_cvrt_32b3c_to_v210;
+    #endif
+  #endif
+#endif // !OJPH_ENABLE_WASM_SIMD
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  ui32 v210_out::write(const line_buf* line, ui32 comp_num)
+  {
+    assert(fh);
+    assert(comp_num < 3);
+
+    lptr[comp_num] = line;
+    if (comp_num == 2)
+    {
+      converter(lptr[0], lptr[1], lptr[2], buffer, 10, width);
+      if (fwrite(buffer, 1, bytes_per_line, fh) != bytes_per_line)
+        OJPH_ERROR(0x030001B2, "error writing to file %s", fname);
+    }
+    return 0;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////////////////
+  void p010_in::set_img_props(const size& s)
+  {
+    assert(fh == NULL);
+    width = s.w;
+    height = s.h;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void p010_in::open(const char* filename)
+  {
+    assert(fh == NULL);
+    fh = fopen(filename, "rb");
+    if (fh == NULL)
+      OJPH_ERROR(0x030001C1, "Unable to open file %s", filename);
+    fname = filename;
+
+    // a line of the CbCr plane is as long as a line of Y, plus padding
+    // for an odd width
+    size_t needed = (size_t)((width + 1) >> 1) * 4;
+    if (buffer_size < needed) { // the buffer is kept for the next image
+      buffer_size = needed;
+      line_data = (ui8*)realloc(line_data, buffer_size);
+    }
+    cur_line[2] = cur_line[1] = cur_line[0] = 0;
+    file_pos = 0;
+
+    map.open(filename);       // otherwise, lines are read with fread
+
+    unpacker[0] = gen_cvrt_p010_1c_to_32b1c;
+    unpacker[1] = gen_cvrt_p010_2c_to_32b1c;
+#if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
+  #if !defined(OJPH_DISABLE_SIMD) && !defined(OJPH_DISABLE_AVX2)
+    #if (defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
+      if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_AVX2) {
+        unpacker[0] = avx2_cvrt_p010_1c_to_32b1c;
+        unpacker[1] = avx2_cvrt_p010_2c_to_32b1c;
+      }
+    #endif
+  #endif
+#endif // !OJPH_ENABLE_WASM_SIMD
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  ui32 p010_in::read(const line_buf* line, ui32 comp_num)
+  {
+    assert(comp_num < 3);
+    ui32 y = cur_line[comp_num]++;
+    ui32 w = width, h = height;
+    ui64 offset = 0;                // of the line in the file
+    ui32 line_bytes = width * 2;
+    if (comp_num > 0) {
+      w = (width + 1) >> 1;
+      h = (height + 1) >> 1;
+      offset = (ui64)width * height * 2;
+      line_bytes = w * 4;
+    }
+    offset += (ui64)y * line_bytes;
+    if (y >= h)
+      OJPH_ERROR(0x030001C2, "reading past the end of file %s", fname);
+
+    const ui8 *sp = line_data;
+    if (map.is_open())
+    {
+      if (offset + line_bytes > map.get_size())
+        OJPH_ERROR(0x030001C3, "not enough data in file %s", fname);
+      sp = map.get_data() + offset;
+    }
+    else
+    {
+      // Cb and Cr share lines, so the CbCr plane is read twice when the
+      // components are read one after the other
+      if (offset != file_pos && ojph_fseek(fh, (si64)offset, SEEK_SET))
+        OJPH_ERROR(0x030001C4, "unable to seek in file %s", fname);
+      if (fread(line_data, 1, line_bytes, fh) != line_bytes)
+        OJPH_ERROR(0x030001C3, "not enough data in file %s", fname);
+      file_pos = offset + line_bytes;
+    }
+
+    if (comp_num == 0)
+      unpacker[0](sp, line->i32, w);
+    else
+      unpacker[1](sp + 2 * (comp_num - 1), line->i32, w);
+    return w;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////////////////
+  void p010_out::open(char* filename)
+  {
+    assert(fh == NULL); //configure before open
+    fh = fopen(filename, "wb");
+    if (fh == NULL)
+      OJPH_ERROR(0x030001D1, "Unable to open file %s", filename);
+    fname = filename;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void p010_out::configure(ui32 width, ui32 height)
+  {
+    assert(fh == NULL);
+    this->width = width;
+    this->height = height;
+    cur_line[2] = cur_line[1] = cur_line[0] = 0;
+    size_t needed = (size_t)width
+      + (size_t)((width + 1) >> 1) * 2 * ((height + 1) >> 1);
+    if (buffer_size < needed) { // the buffer is kept for the next image
+      buffer_size = needed;
+      buffer = (ui16*)realloc(buffer, buffer_size * sizeof(ui16));
+    }
+
+    converter[0] = gen_cvrt_32b1c_to_p010_1c;
+    converter[1] = gen_cvrt_32b1c_to_p010_2c;
+#if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
+  #if !defined(OJPH_DISABLE_SIMD) && !defined(OJPH_DISABLE_AVX2)
+    #if (defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
+      if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_AVX2) {
+        converter[0] = avx2_cvrt_32b1c_to_p010_1c;
+        converter[1] = avx2_cvrt_32b1c_to_p010_2c;
+      }
+    #endif
+  #endif
+#endif // !OJPH_ENABLE_WASM_SIMD
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  ui32 p010_out::write(const line_buf* line, ui32 comp_num)
+  {
+    assert(fh);
+    assert(comp_num < 3);
+
+    ui32 y = cur_line[comp_num]++;
+    if (comp_num == 0)
+    {
+      converter[0](line, NULL, NULL, buffer, 10, width);
+      if (fwrite(buffer, sizeof(ui16), width, fh) != width)
+        OJPH_ERROR(0x030001D2, "error writing to file %s", fname);
+      return 0;
+    }
+
+    ui32 chroma_width = (width + 1) >> 1;
+    ui32 chroma_height = (height + 1) >> 1;
+    assert(y < chroma_height);
+    ui16 *plane = buffer + width;
+    ui16 *dp = plane + (size_t)y * chroma_width * 2 + (comp_num - 1);
+    converter[1](line, NULL, NULL, dp, 10, chroma_width);
+    if (comp_num == 2 && y + 1 == chroma_height)
+    {
+      size_t plane_size = (size_t)chroma_width * 2 * chroma_height;
+      if (fwrite(plane, sizeof(ui16), plane_size, fh) != plane_size)
+        OJPH_ERROR(0x030001D2, "error writing to file %s", fname);
+    }
+    return 0;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////////////////
+  static inline void store_be32(ui8 *p, ui32 v)
+  { p[0] = (ui8)(v >> 24); p[1] = (ui8)(v >> 16);
+    p[2] = (ui8)(v >> 8);  p[3] = (ui8)v; }
+
+  ////////////////////////////////////////////////////////////////////////////
+  static inline void store_be16(ui8 *p, ui16 v)
+  { p[0] = (ui8)(v >> 8); p[1] = (ui8)v; }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void dpx_out::open(char* filename)
+  {
+    assert(fh == NULL); //configure before open
+    fh = fopen(filename, "wb");
+    if (fh == NULL)
+      OJPH_ERROR(0x030001E1, "Unable to open file %s", filename);
+    fname = filename;
+
+    // the file and image information headers, holding the fields that
+    // dpx_in reads; the rest are left as 0
+    const ui32 header_size = 2048;
+    ui8 header[header_size];
+    memset(header, 0, header_size);
+    memcpy(header, "SDPX", 4);                  // magic number
+    store_be32(header + 4, header_size);        // offset to image data
+    memcpy(header + 8, "V2.0", 4);              // version
+    store_be32(header + 16,                     // file size
+      header_size + width * height * (ui32)sizeof(ui32));
+    store_be32(header + 24, 1664);              // generic header size
+    store_be32(header + 28, 384);               // industry header size
+    store_be16(header + 768, 0);                // orientation
+    store_be16(header + 770, 1);                // number of elements
+    store_be32(header + 772, width);            // pixels per line
+    store_be32(header + 776, height);           // lines per element
+    store_be32(header + 780, 0);                // unsigned samples
+    store_be32(header + 792, 1023);             // reference high data code
+    header[800] = 50;                           // descriptor: RGB
+    header[803] = 10;                           // bit depth
+    store_be16(header + 804, 1);                // packing: filled, method A
+    store_be16(header + 806, 0);                // no encoding
+    store_be32(header + 808, header_size);      // offset to data
+    if (fwrite(header, 1, header_size, fh) != header_size)
+      OJPH_ERROR(0x030001E2, "error writing to file %s", fname);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void dpx_out::configure(ui32 width, ui32 height)
+  {
+    assert(fh == NULL);
+    this->width = width;
+    this->height = height;
+    if (buffer_size < width) { // the buffer is kept for the next image
+      buffer_size = width;
+      buffer = (ui32*)realloc(buffer, buffer_size * sizeof(ui32));
+    }
+
+    converter = gen_cvrt_32b3c_to_dpx10_be;
+#if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
+  #if !defined(OJPH_DISABLE_SIMD) && !defined(OJPH_DISABLE_AVX2)
+    #if (defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
+      if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_AVX2)
+        converter = avx2_cvrt_32b3c_to_dpx10_be;
+    #endif
+  #endif
+#endif // !OJPH_ENABLE_WASM_SIMD
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  ui32 dpx_out::write(const line_buf* line, ui32 comp_num)
+  {
+    assert(fh);
+    assert(comp_num < 3);
+
+    lptr[comp_num] = line;
+    if (comp_num == 2)
+    {
+      converter(lptr[0], lptr[1], lptr[2], buffer, 10, width);
+      if (fwrite(buffer, sizeof(ui32), width, fh) != width)
+        OJPH_ERROR(0x030001E2, "error writing to file %s", fname);
+    }
+    return 0;
+  }
+
 } 
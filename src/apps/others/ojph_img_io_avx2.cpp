@@ -353,6 +353,372 @@ namespace ojph {
       *p++ = be2le((ui16) val);
     }    
   }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_8ub1c_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for ( ; count >= 16; count -= 16, p += 16, dp += 16)
+    {
+      __m128i a = _mm_loadu_si128((__m128i*)p);
+      _mm256_storeu_si256((__m256i*)dp, _mm256_cvtepu8_epi32(a));
+      a = _mm_srli_si128(a, 8);
+      _mm256_storeu_si256((__m256i*)dp + 1, _mm256_cvtepu8_epi32(a));
+    }
+    gen_cvrt_8ub1c_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_8sb1c_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for ( ; count >= 16; count -= 16, p += 16, dp += 16)
+    {
+      __m128i a = _mm_loadu_si128((__m128i*)p);
+      _mm256_storeu_si256((__m256i*)dp, _mm256_cvtepi8_epi32(a));
+      a = _mm_srli_si128(a, 8);
+      _mm256_storeu_si256((__m256i*)dp + 1, _mm256_cvtepi8_epi32(a));
+    }
+    gen_cvrt_8sb1c_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_8ub3c_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    // each 128-bit lane takes 4 samples, 3 bytes apart, from 16 bytes
+    __m256i mask = _mm256_set_epi64x((si64)0xFFFFFF09FFFFFF06,
+                                     (si64)0xFFFFFF03FFFFFF00,
+                                     (si64)0xFFFFFF09FFFFFF06,
+                                     (si64)0xFFFFFF03FFFFFF00);
+    const ui8 *p = (const ui8 *)sp;
+    // 28 bytes are loaded for 8 samples, which the next 2 samples cover
+    for ( ; count >= 10; count -= 8, p += 24, dp += 8)
+    {
+      __m128i lo = _mm_loadu_si128((__m128i*)p);
+      __m128i hi = _mm_loadu_si128((__m128i*)(p + 12));
+      __m256i a = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+      _mm256_storeu_si256((__m256i*)dp, _mm256_shuffle_epi8(a, mask));
+    }
+    gen_cvrt_8ub3c_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_16ub1c_le_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for ( ; count >= 16; count -= 16, p += 32, dp += 16)
+    {
+      __m128i a = _mm_loadu_si128((__m128i*)p);
+      __m128i b = _mm_loadu_si128((__m128i*)p + 1);
+      _mm256_storeu_si256((__m256i*)dp, _mm256_cvtepu16_epi32(a));
+      _mm256_storeu_si256((__m256i*)dp + 1, _mm256_cvtepu16_epi32(b));
+    }
+    gen_cvrt_16ub1c_le_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_16sb1c_le_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for ( ; count >= 16; count -= 16, p += 32, dp += 16)
+    {
+      __m128i a = _mm_loadu_si128((__m128i*)p);
+      __m128i b = _mm_loadu_si128((__m128i*)p + 1);
+      _mm256_storeu_si256((__m256i*)dp, _mm256_cvtepi16_epi32(a));
+      _mm256_storeu_si256((__m256i*)dp + 1, _mm256_cvtepi16_epi32(b));
+    }
+    gen_cvrt_16sb1c_le_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_16ub1c_be_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    __m128i swap = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,
+                                 9, 8, 11, 10, 13, 12, 15, 14);
+    const ui8 *p = (const ui8 *)sp;
+    for ( ; count >= 16; count -= 16, p += 32, dp += 16)
+    {
+      __m128i a = _mm_loadu_si128((__m128i*)p);
+      __m128i b = _mm_loadu_si128((__m128i*)p + 1);
+      a = _mm_shuffle_epi8(a, swap);
+      b = _mm_shuffle_epi8(b, swap);
+      _mm256_storeu_si256((__m256i*)dp, _mm256_cvtepu16_epi32(a));
+      _mm256_storeu_si256((__m256i*)dp + 1, _mm256_cvtepu16_epi32(b));
+    }
+    gen_cvrt_16ub1c_be_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_16ub3c_be_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    __m256i idx = _mm256_setr_epi32(0, 6, 12, 18, 24, 30, 36, 42);
+    __m256i mask = _mm256_set_epi64x((si64)0xFFFF0C0DFFFF0809,
+                                     (si64)0xFFFF0405FFFF0001,
+                                     (si64)0xFFFF0C0DFFFF0809,
+                                     (si64)0xFFFF0405FFFF0001);
+    const ui8 *p = (const ui8 *)sp;
+    // the gather reads 2 bytes past 8 samples, which the next sample covers
+    for ( ; count > 8; count -= 8, p += 48, dp += 8)
+    {
+      __m256i a = _mm256_i32gather_epi32((const int*)p, idx, 1);
+      _mm256_storeu_si256((__m256i*)dp, _mm256_shuffle_epi8(a, mask));
+    }
+    gen_cvrt_16ub3c_be_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_p010_1c_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for ( ; count >= 16; count -= 16, p += 32, dp += 16)
+    {
+      __m256i a = _mm256_loadu_si256((__m256i*)p);
+      a = _mm256_srli_epi16(a, 6);
+      __m128i lo = _mm256_castsi256_si128(a);
+      __m128i hi = _mm256_extracti128_si256(a, 1);
+      _mm256_storeu_si256((__m256i*)dp, _mm256_cvtepu16_epi32(lo));
+      _mm256_storeu_si256((__m256i*)dp + 1, _mm256_cvtepu16_epi32(hi));
+    }
+    gen_cvrt_p010_1c_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_p010_2c_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    // each 32-bit word holds the sample in its lower half; for Cr, the
+    // 2 bytes read past 8 samples belong to the next sample
+    __m256i mask = _mm256_set1_epi32(0x3FF);
+    const ui8 *p = (const ui8 *)sp;
+    for ( ; count > 8; count -= 8, p += 32, dp += 8)
+    {
+      __m256i a = _mm256_loadu_si256((__m256i*)p);
+      a = _mm256_and_si256(_mm256_srli_epi32(a, 6), mask);
+      _mm256_storeu_si256((__m256i*)dp, a);
+    }
+    gen_cvrt_p010_2c_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_v210_to_32b3c(const void *sp, si32 *dp0, si32 *dp1,
+                               si32 *dp2, ui32 count)
+  {
+    // the 4 words of a block are copied to both lanes; luma takes
+    // 6 fields, while chroma takes Cb from the lower lane and Cr from
+    // the upper lane
+    __m256i y_idx = _mm256_setr_epi32(0, 1, 1, 2, 3, 3, 0, 0);
+    __m256i y_shift = _mm256_setr_epi32(10, 0, 20, 10, 0, 20, 0, 0);
+    __m256i c_idx = _mm256_setr_epi32(0, 1, 2, 0, 0, 2, 3, 0);
+    __m256i c_shift = _mm256_setr_epi32(0, 10, 20, 0, 20, 0, 10, 0);
+    __m256i mask = _mm256_set1_epi32(0x3FF);
+    const ui8 *p = (const ui8 *)sp;
+    ui32 x = 0;
+    // 8 luma and 4 of each chroma are stored, but only 6 and 3 advance
+    for ( ; x + 8 <= count; x += 6, p += 16)
+    {
+      __m128i w = _mm_loadu_si128((__m128i*)p);
+      __m256i a = _mm256_broadcastsi128_si256(w);
+      __m256i t = _mm256_permutevar8x32_epi32(a, y_idx);
+      t = _mm256_and_si256(_mm256_srlv_epi32(t, y_shift), mask);
+      _mm256_storeu_si256((__m256i*)(dp0 + x), t);
+      t = _mm256_permutevar8x32_epi32(a, c_idx);
+      t = _mm256_and_si256(_mm256_srlv_epi32(t, c_shift), mask);
+      _mm_storeu_si128((__m128i*)(dp1 + (x >> 1)),
+                       _mm256_castsi256_si128(t));
+      _mm_storeu_si128((__m128i*)(dp2 + (x >> 1)),
+                       _mm256_extracti128_si256(t, 1));
+    }
+    gen_cvrt_v210_to_32b3c(p, dp0 + x, dp1 + (x >> 1), dp2 + (x >> 1),
+                           count - x);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_32b1c_to_p010_1c(const line_buf *ln0, const line_buf *ln1,
+                                  const line_buf *ln2, void *dp,
+                                  ui32 bit_depth, ui32 count)
+  {
+    ojph_unused(ln1);
+    ojph_unused(ln2);
+
+    __m256i max_val_vec = _mm256_set1_epi32((1 << bit_depth) - 1);
+    __m256i zero = _mm256_setzero_si256();
+    int shift = 16 - (int)bit_depth;
+    const si32 *sp = ln0->i32;
+    ui16* p = (ui16 *)dp;
+
+    // 16 entries in each loop
+    for ( ; count >= 16; count -= 16, sp += 16, p += 16)
+    {
+      __m256i a, b;
+      a = _mm256_load_si256((__m256i*)sp);
+      a = _mm256_min_epi32(_mm256_max_epi32(a, zero), max_val_vec);
+      b = _mm256_load_si256((__m256i*)sp + 1);
+      b = _mm256_min_epi32(_mm256_max_epi32(b, zero), max_val_vec);
+      a = _mm256_packus_epi32(a, b);
+      a = _mm256_sll_epi16(a, _mm_cvtsi32_si128(shift));
+      a = _mm256_permute4x64_epi64(a, 0xD8);
+      _mm256_storeu_si256((__m256i*)p, a);
+    }
+
+    int max_val = (1<<bit_depth) - 1;
+    for ( ; count > 0; --count)
+    {
+      int val = *sp++;
+      val = val >= 0 ? val : 0;
+      val = val <= max_val ? val : max_val;
+      *p++ = (ui16)(val << shift);
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_32b1c_to_p010_2c(const line_buf *ln0, const line_buf *ln1,
+                                  const line_buf *ln2, void *dp,
+                                  ui32 bit_depth, ui32 count)
+  {
+    ojph_unused(ln1);
+    ojph_unused(ln2);
+
+    __m256i max_val_vec = _mm256_set1_epi32((1 << bit_depth) - 1);
+    __m256i zero = _mm256_setzero_si256();
+    int shift = 16 - (int)bit_depth;
+    const si32 *sp = ln0->i32;
+    ui16* p = (ui16 *)dp;
+
+    // the lower halves of 8 words are replaced, keeping the other
+    // component; the last word reaches into the next sample
+    for ( ; count > 8; count -= 8, sp += 8, p += 16)
+    {
+      __m256i a = _mm256_loadu_si256((__m256i*)sp);
+      a = _mm256_min_epi32(_mm256_max_epi32(a, zero), max_val_vec);
+      a = _mm256_sll_epi32(a, _mm_cvtsi32_si128(shift));
+      __m256i t = _mm256_loadu_si256((__m256i*)p);
+      t = _mm256_blend_epi16(t, a, 0x55);
+      _mm256_storeu_si256((__m256i*)p, t);
+    }
+
+    int max_val = (1<<bit_depth) - 1;
+    for ( ; count > 0; --count, p += 2)
+    {
+      int val = *sp++;
+      val = val >= 0 ? val : 0;
+      val = val <= max_val ? val : max_val;
+      *p = (ui16)(val << shift);
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // packs 6 luma and 3 of each chroma samples into 4 words; ch holds Cb
+  // in its lower lane and Cr in its upper lane
+  static inline
+  __m128i v210_pack_block(__m256i y, __m256i ch)
+  {
+    // the fields at bits 0, 10 and 20 of the 4 words
+    const __m256i y_idx0 = _mm256_setr_epi32(0, 1, 0, 4, 0, 0, 0, 0);
+    const __m256i c_idx0 = _mm256_setr_epi32(0, 0, 5, 0, 0, 0, 0, 0);
+    const __m256i y_idx1 = _mm256_setr_epi32(0, 0, 3, 0, 0, 0, 0, 0);
+    const __m256i c_idx1 = _mm256_setr_epi32(0, 1, 0, 6, 0, 0, 0, 0);
+    const __m256i y_idx2 = _mm256_setr_epi32(0, 2, 0, 5, 0, 0, 0, 0);
+    const __m256i c_idx2 = _mm256_setr_epi32(4, 0, 2, 0, 0, 0, 0, 0);
+    __m256i f0 = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(ch, c_idx0),
+                   _mm256_permutevar8x32_epi32(y, y_idx0), 0xA);
+    __m256i f1 = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(ch, c_idx1),
+                   _mm256_permutevar8x32_epi32(y, y_idx1), 0x5);
+    __m256i f2 = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(ch, c_idx2),
+                   _mm256_permutevar8x32_epi32(y, y_idx2), 0xA);
+    f0 = _mm256_or_si256(f0, _mm256_slli_epi32(f1, 10));
+    f0 = _mm256_or_si256(f0, _mm256_slli_epi32(f2, 20));
+    return _mm256_castsi256_si128(f0);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_32b3c_to_v210(const line_buf *ln0, const line_buf *ln1,
+                               const line_buf *ln2, void *dp,
+                               ui32 bit_depth, ui32 count)
+  {
+    __m256i max_val_vec = _mm256_set1_epi32((1 << bit_depth) - 1);
+    __m256i zero = _mm256_setzero_si256();
+    const si32 *sp0 = ln0->i32;
+    const si32 *sp1 = ln1->i32;
+    const si32 *sp2 = ln2->i32;
+    ui32 chroma_count = (count + 1) >> 1;
+    ui8* p = (ui8 *)dp;
+
+    // 8 luma and 4 of each chroma are loaded, but only 6 and 3 are used
+    ui32 x = 0;
+    for ( ; x + 8 <= count; x += 6, p += 16)
+    {
+      __m256i y = _mm256_loadu_si256((__m256i*)(sp0 + x));
+      __m128i cb = _mm_loadu_si128((__m128i*)(sp1 + (x >> 1)));
+      __m128i cr = _mm_loadu_si128((__m128i*)(sp2 + (x >> 1)));
+      __m256i ch = _mm256_inserti128_si256(_mm256_castsi128_si256(cb), cr, 1);
+      y = _mm256_min_epi32(_mm256_max_epi32(y, zero), max_val_vec);
+      ch = _mm256_min_epi32(_mm256_max_epi32(ch, zero), max_val_vec);
+      _mm_storeu_si128((__m128i*)p, v210_pack_block(y, ch));
+    }
+
+    // the remaining blocks are copied out, so that samples past the end
+    // of the line are 0
+    for ( ; x < count; x += 6, p += 16)
+    {
+      si32 ty[8] = { 0 }, tc[8] = { 0 };
+      ui32 n = ojph_min(count - x, 6u);
+      memcpy(ty, sp0 + x, n * sizeof(si32));
+      n = ojph_min(chroma_count - (x >> 1), 3u);
+      memcpy(tc, sp1 + (x >> 1), n * sizeof(si32));
+      memcpy(tc + 4, sp2 + (x >> 1), n * sizeof(si32));
+      __m256i y = _mm256_loadu_si256((__m256i*)ty);
+      __m256i ch = _mm256_loadu_si256((__m256i*)tc);
+      y = _mm256_min_epi32(_mm256_max_epi32(y, zero), max_val_vec);
+      ch = _mm256_min_epi32(_mm256_max_epi32(ch, zero), max_val_vec);
+      _mm_storeu_si128((__m128i*)p, v210_pack_block(y, ch));
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_32b3c_to_dpx10_be(const line_buf *ln0, const line_buf *ln1,
+                                   const line_buf *ln2, void *dp,
+                                   ui32 bit_depth, ui32 count)
+  {
+    __m256i max_val_vec = _mm256_set1_epi32((1 << bit_depth) - 1);
+    __m256i zero = _mm256_setzero_si256();
+    __m256i swap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,
+                                    11, 10, 9, 8, 15, 14, 13, 12,
+                                    3, 2, 1, 0, 7, 6, 5, 4,
+                                    11, 10, 9, 8, 15, 14, 13, 12);
+    const si32 *sp0 = ln0->i32;
+    const si32 *sp1 = ln1->i32;
+    const si32 *sp2 = ln2->i32;
+    ui32* p = (ui32 *)dp;
+
+    // 8 entries in each loop
+    for ( ; count >= 8; count -= 8, sp0 += 8, sp1 += 8, sp2 += 8, p += 8)
+    {
+      __m256i r, g, b;
+      r = _mm256_load_si256((__m256i*)sp0);
+      r = _mm256_min_epi32(_mm256_max_epi32(r, zero), max_val_vec);
+      g = _mm256_load_si256((__m256i*)sp1);
+      g = _mm256_min_epi32(_mm256_max_epi32(g, zero), max_val_vec);
+      b = _mm256_load_si256((__m256i*)sp2);
+      b = _mm256_min_epi32(_mm256_max_epi32(b, zero), max_val_vec);
+      r = _mm256_or_si256(_mm256_slli_epi32(r, 22), _mm256_slli_epi32(g, 12));
+      r = _mm256_or_si256(r, _mm256_slli_epi32(b, 2));
+      _mm256_storeu_si256((__m256i*)p, _mm256_shuffle_epi8(r, swap));
+    }
+
+    int max_val = (1<<bit_depth) - 1;
+    for ( ; count > 0; --count)
+    {
+      int r = *sp0++, g = *sp1++, b = *sp2++;
+      r = r >= 0 ? r : 0;
+      r = r <= max_val ? r : max_val;
+      g = g >= 0 ? g : 0;
+      g = g <= max_val ? g : max_val;
+      b = b >= 0 ? b : 0;
+      b = b <= max_val ? b : max_val;
+      ui32 v = ((ui32)r << 22) | ((ui32)g << 12) | ((ui32)b << 2);
+      *p++ = (v >> 24) | ((v >> 8) & 0xFF00)
+           | ((v << 8) & 0xFF0000) | (v << 24);
+    }
+  }
 }
 
 #endif
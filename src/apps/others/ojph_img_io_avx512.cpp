@@ -0,0 +1,155 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2019, Aous Naman
+// Copyright (c) 2019, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2019, The University of New South Wales, Australia
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_img_io_avx512.cpp
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#include "ojph_arch.h"
+#if defined(OJPH_ARCH_I386) || defined(OJPH_ARCH_X86_64)
+
+#include <immintrin.h>
+
+#include "ojph_img_io.h"
+
+namespace ojph {
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx512_cvrt_8ub1c_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for ( ; count >= 16; count -= 16, p += 16, dp += 16)
+    {
+      __m128i a = _mm_loadu_si128((__m128i*)p);
+      _mm512_storeu_si512(dp, _mm512_cvtepu8_epi32(a));
+    }
+    gen_cvrt_8ub1c_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx512_cvrt_8sb1c_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for ( ; count >= 16; count -= 16, p += 16, dp += 16)
+    {
+      __m128i a = _mm_loadu_si128((__m128i*)p);
+      _mm512_storeu_si512(dp, _mm512_cvtepi8_epi32(a));
+    }
+    gen_cvrt_8sb1c_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx512_cvrt_8ub3c_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    __m512i idx = _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21,
+                                    24, 27, 30, 33, 36, 39, 42, 45);
+    __m512i mask = _mm512_set1_epi32(0xFF);
+    const ui8 *p = (const ui8 *)sp;
+    // the gather reads 3 bytes past 16 samples, which the next sample
+    // covers
+    for ( ; count > 16; count -= 16, p += 48, dp += 16)
+    {
+      __m512i a = _mm512_i32gather_epi32(idx, p, 1);
+      _mm512_storeu_si512(dp, _mm512_and_si512(a, mask));
+    }
+    gen_cvrt_8ub3c_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx512_cvrt_16ub1c_le_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for ( ; count >= 16; count -= 16, p += 32, dp += 16)
+    {
+      __m256i a = _mm256_loadu_si256((__m256i*)p);
+      _mm512_storeu_si512(dp, _mm512_cvtepu16_epi32(a));
+    }
+    gen_cvrt_16ub1c_le_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx512_cvrt_16sb1c_le_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for ( ; count >= 16; count -= 16, p += 32, dp += 16)
+    {
+      __m256i a = _mm256_loadu_si256((__m256i*)p);
+      _mm512_storeu_si512(dp, _mm512_cvtepi16_epi32(a));
+    }
+    gen_cvrt_16sb1c_le_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // exchanges the two low bytes of each 32-bit entry, which must have its
+  // two high bytes set to zero
+  static inline
+  __m512i swap_bytes(__m512i a)
+  {
+    __m512i lo = _mm512_and_si512(_mm512_srli_epi32(a, 8),
+                                  _mm512_set1_epi32(0xFF));
+    __m512i hi = _mm512_and_si512(_mm512_slli_epi32(a, 8),
+                                  _mm512_set1_epi32(0xFF00));
+    return _mm512_or_si512(lo, hi);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx512_cvrt_16ub1c_be_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    const ui8 *p = (const ui8 *)sp;
+    for ( ; count >= 16; count -= 16, p += 32, dp += 16)
+    {
+      __m256i a = _mm256_loadu_si256((__m256i*)p);
+      _mm512_storeu_si512(dp, swap_bytes(_mm512_cvtepu16_epi32(a)));
+    }
+    gen_cvrt_16ub1c_be_to_32b1c(p, dp, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx512_cvrt_16ub3c_be_to_32b1c(const void *sp, si32 *dp, ui32 count)
+  {
+    __m512i idx = _mm512_setr_epi32(0, 6, 12, 18, 24, 30, 36, 42,
+                                    48, 54, 60, 66, 72, 78, 84, 90);
+    const ui8 *p = (const ui8 *)sp;
+    // the gather reads 2 bytes past 16 samples, which the next sample
+    // covers
+    for ( ; count > 16; count -= 16, p += 96, dp += 16)
+    {
+      __m512i a = _mm512_i32gather_epi32(idx, p, 1);
+      _mm512_storeu_si512(dp, swap_bytes(a));
+    }
+    gen_cvrt_16ub3c_be_to_32b1c(p, dp, count);
+  }
+}
+
+#endif
@@ -0,0 +1,265 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_pipeline.cpp
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#include <cassert>
+#include <cstring>
+
+#include "ojph_pipeline.h"
+#include "ojph_message.h"
+
+namespace ojph
+{
+namespace pipeline
+{
+
+  ///////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ///////////////////////////////////////////////////////////////////////////
+
+  ///////////////////////////////////////////////////////////////////////////
+  void line_reader::start(image_in_base *source, ui32 num_comps,
+                          const ui32 *height, ui32 max_width, bool planar)
+  {
+    assert(!thread.joinable());
+    this->source = source;
+    this->num_comps = num_comps;
+    this->height.assign(height, height + num_comps);
+    this->max_width = max_width;
+    this->planar = planar;
+    error = nullptr;
+
+    filled.init(num_batches);
+    empty.init(num_batches);
+    for (ui32 i = 0; i < num_batches; ++i)
+    {
+      batch& b = batches[i];
+      if (b.store.size() < (size_t)lines_per_batch * max_width)
+        b.store.resize((size_t)lines_per_batch * max_width);
+      for (ui32 j = 0; j < lines_per_batch; ++j)
+        b.lines[j].wrap(b.store.data() + (size_t)j * max_width,
+                        max_width, 0);
+      empty.push(&b);
+    }
+    cur = NULL;
+    cur_idx = 0;
+    thread = std::thread(&line_reader::run, this);
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  void line_reader::run()
+  {
+    batch *b = NULL;
+    try {
+      // the order of the lines follows the encoder's calls to exchange()
+      ui32 outer = planar ? num_comps : height[0];
+      for (ui32 i = 0; i < outer; ++i)
+      {
+        ui32 inner = planar ? height[i] : num_comps;
+        for (ui32 j = 0; j < inner; ++j)
+        {
+          ui32 comp_num = planar ? i : j;
+          if (b == NULL)
+          {
+            if (!empty.pop(b))
+              return;                         // finish() was called
+            b->num_lines = 0;
+          }
+          ui32 n = b->num_lines;
+          b->widths[n] = source->read(b->lines + n, comp_num);
+          b->comp_nums[n] = comp_num;
+          if (++b->num_lines == lines_per_batch)
+          {
+            if (!filled.push(b))
+              return;
+            b = NULL;
+          }
+        }
+      }
+      if (b != NULL)
+        filled.push(b);
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+    filled.close();
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  ui32 line_reader::read(const line_buf *line, ui32 comp_num)
+  {
+    if (cur == NULL || cur_idx == cur->num_lines)
+    {
+      if (cur != NULL)
+        empty.push(cur);
+      cur_idx = 0;
+      if (!filled.pop(cur))
+      {
+        cur = NULL;
+        finish();
+        if (error)
+          std::rethrow_exception(error);
+        OJPH_ERROR(0x000C0001, "the encoder asked for more lines than the "
+          "image has");
+      }
+    }
+    assert(cur->comp_nums[cur_idx] == comp_num);
+    ojph_unused(comp_num);
+    ui32 width = cur->widths[cur_idx];
+    memcpy(line->i32, cur->lines[cur_idx].i32, width * sizeof(si32));
+    ++cur_idx;
+    return width;
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  void line_reader::finish()
+  {
+    if (thread.joinable())
+    {
+      filled.close();
+      empty.close();
+      thread.join();
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ///////////////////////////////////////////////////////////////////////////
+
+  ///////////////////////////////////////////////////////////////////////////
+  void async_outfile::open(const char *filename)
+  {
+    assert(fh == NULL);
+    fh = fopen(filename, "wb");
+    if (fh == NULL)
+      OJPH_ERROR(0x000C0002, "failed to open %s for writing", filename);
+    fname = filename;
+    total = 0;
+    failed = false;
+
+    full.init(num_chunks);
+    empty.init(num_chunks);
+    for (ui32 i = 0; i < num_chunks; ++i)
+    {
+      chunks[i].data.resize(chunk_size);
+      chunks[i].used = 0;
+      empty.push(chunks + i);
+    }
+    empty.pop(cur);
+    thread = std::thread(&async_outfile::run, this);
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  void async_outfile::run()
+  {
+    chunk *c;
+    while (full.pop(c))
+    {
+      if (!failed && fwrite(c->data.data(), 1, c->used, fh) != c->used)
+        failed = true;                        // reported by close()
+      c->used = 0;
+      empty.push(c);
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  size_t async_outfile::write(const void *ptr, size_t size)
+  {
+    assert(fh != NULL);
+    const ui8 *p = (const ui8*)ptr;
+    size_t remaining = size;
+    while (remaining)
+    {
+      size_t n = ojph_min(remaining, chunk_size - cur->used);
+      memcpy(cur->data.data() + cur->used, p, n);
+      cur->used += n;
+      p += n;
+      remaining -= n;
+      if (cur->used == chunk_size)
+      {
+        full.push(cur);
+        empty.pop(cur);
+      }
+    }
+    total += (si64)size;
+    return size;
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  void async_outfile::flush()
+  {
+    if (fh != NULL && cur->used > 0)
+    {
+      full.push(cur);
+      empty.pop(cur);
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  void async_outfile::close()
+  {
+    if (fh == NULL)
+      return;
+    flush();
+    full.close();
+    thread.join();
+    bool write_failed = failed || fclose(fh) != 0;
+    fh = NULL;
+    if (write_failed)
+      OJPH_ERROR(0x000C0003, "failed to write to %s", fname);
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  void async_outfile::abort()
+  {
+    if (fh == NULL)
+      return;
+    full.close();
+    empty.close();
+    thread.join();
+    fclose(fh);
+    fh = NULL;
+  }
+
+} // !pipeline namespace
+} // !ojph namespace
@@ -0,0 +1,119 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_block_scheduler.cpp
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#include "ojph_mem.h"
+#include "ojph_params.h"
+#include "ojph_codestream_local.h"
+#include "ojph_block_scheduler.h"
+#include "ojph_codeblock.h"
+
+namespace ojph {
+
+  namespace local {
+
+    //////////////////////////////////////////////////////////////////////////
+    block_scheduler::block_scheduler(executor* exec)
+    {
+      this->exec = exec;
+      group = exec->create_group();
+      max_tasks = ojph_max(exec->get_concurrency(), 1u);
+      tasks = new row_task[max_tasks];
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    block_scheduler::~block_scheduler()
+    {
+      delete group;
+      delete[] tasks;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void block_scheduler::encode_row(codeblock* blocks, ui32 num_blocks,
+                                     mem_elastic_allocator* elastic)
+    {
+      run_row(blocks, num_blocks, elastic);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void block_scheduler::decode_row(codeblock* blocks, ui32 num_blocks)
+    {
+      run_row(blocks, num_blocks, NULL);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void block_scheduler::run_row(codeblock* blocks, ui32 num_blocks,
+                                  mem_elastic_allocator* elastic)
+    {
+      ui32 num_tasks = ojph_min(num_blocks, max_tasks);
+      ui32 first = 0;
+      for (ui32 t = 0; t < num_tasks; ++t)
+      {
+        // spread the codeblocks evenly over the runs
+        ui32 last = (ui32)((ui64)num_blocks * (t + 1) / num_tasks);
+        tasks[t].blocks = blocks + first;
+        tasks[t].num_blocks = last - first;
+        tasks[t].elastic = elastic;
+        tasks[t].error = NULL;
+        first = last;
+      }
+
+      for (ui32 t = 0; t + 1 < num_tasks; ++t)
+        exec->submit(tasks + t, group);
+      tasks[num_tasks - 1].execute();
+      exec->wait(group);
+
+      for (ui32 t = 0; t < num_tasks; ++t)
+        if (tasks[t].error)
+          std::rethrow_exception(tasks[t].error);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void block_scheduler::row_task::execute()
+    {
+      try {
+        if (elastic)
+          for (ui32 i = 0; i < num_blocks; ++i)
+            blocks[i].encode(elastic);
+        else
+          for (ui32 i = 0; i < num_blocks; ++i)
+            blocks[i].decode();
+      }
+      catch (...) {
+        error = std::current_exception();
+      }
+    }
+
+  }
+}
@@ -0,0 +1,96 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_block_scheduler.h
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+
+#ifndef OJPH_BLOCK_SCHEDULER_H
+#define OJPH_BLOCK_SCHEDULER_H
+
+#include <exception>
+#include "ojph_defs.h"
+#include "ojph_executor.h"
+
+namespace ojph {
+
+  ////////////////////////////////////////////////////////////////////////////
+  //defined elsewhere
+  class mem_elastic_allocator;
+
+  namespace local {
+
+    //////////////////////////////////////////////////////////////////////////
+    //defined elsewhere
+    class codeblock;
+
+    //////////////////////////////////////////////////////////////////////////
+    // Encodes or decodes the codeblocks of a row through an executor.  The
+    // row is split into up to executor::get_concurrency() runs of
+    // neighbouring codeblocks; the calling thread executes the last run,
+    // and waits for the others.  Exceptions thrown by a run, such as those
+    // of OJPH_ERROR, are thrown again in the calling thread.
+    class block_scheduler
+    {
+    public:
+      block_scheduler(executor* exec);
+      ~block_scheduler();
+
+      void encode_row(codeblock* blocks, ui32 num_blocks,
+                      mem_elastic_allocator* elastic);
+      void decode_row(codeblock* blocks, ui32 num_blocks);
+
+    private:
+      struct row_task : public thds::worker_thread_base
+      {
+        void execute() override;
+
+        codeblock* blocks;               // the first codeblock of the run
+        ui32 num_blocks;                 // codeblocks in the run
+        mem_elastic_allocator* elastic;  // NULL for decoding
+        std::exception_ptr error;        // the exception of the run
+      };
+
+      void run_row(codeblock* blocks, ui32 num_blocks,
+                   mem_elastic_allocator* elastic);
+
+    private:
+      executor* exec;
+      executor::group* group;
+      row_task* tasks;
+      ui32 max_tasks;
+    };
+
+  }
+}
+
+#endif // !OJPH_BLOCK_SCHEDULER_H
@@ -98,6 +98,7 @@ namespace ojph {
       this->cur_line = 0;
       this->delta = parent->get_delta();
       this->delta_inv = 1.0f / this->delta;
+      this->gain = parent->get_gain();
       this->K_max = K_max;
       for (int i = 0; i < 4; ++i)
         this->max_val64[i] = 0;
@@ -117,11 +118,20 @@ namespace ojph {
       // convert to sign and magnitude and keep max_val      
       if (precision == BUF32)
       {
-        assert(line->flags & line_buf::LFT_32BIT);
-        const si32 *sp = line->i32 + line_offset;
         ui32 *dp = buf32 + cur_line * stride;
-        this->codeblock_functions.tx_to_cb32(sp, dp, K_max, delta_inv, 
-                                             cb_size.w, max_val32);
+        if (line->flags & line_buf::LFT_16BIT)
+        {
+          const si16 *sp = line->i16 + line_offset;
+          this->codeblock_functions.tx_to_cb16(sp, dp, K_max, delta_inv,
+                                               cb_size.w, max_val32);
+        }
+        else
+        {
+          assert(line->flags & line_buf::LFT_32BIT);
+          const si32 *sp = line->i32 + line_offset;
+          this->codeblock_functions.tx_to_cb32(sp, dp, K_max, delta_inv, 
+                                               cb_size.w, max_val32);
+        }
         ++cur_line;
       }
       else 
@@ -230,16 +240,31 @@ namespace ojph {
       //convert to sign and magnitude
       if (precision == BUF32)
       {
-        assert(line->flags & line_buf::LFT_32BIT);
-        si32 *dp = line->i32 + line_offset;
-        if (!zero_block)
+        if (line->flags & line_buf::LFT_16BIT)
         {
-          const ui32 *sp = buf32 + cur_line * stride;
-          this->codeblock_functions.tx_from_cb32(sp, dp, K_max, delta, 
-                                                 cb_size.w);
+          si16 *dp = line->i16 + line_offset;
+          if (!zero_block)
+          {
+            const ui32 *sp = buf32 + cur_line * stride;
+            this->codeblock_functions.tx_from_cb16(sp, dp, K_max, delta,
+                                                   gain, cb_size.w);
+          }
+          else
+            this->codeblock_functions.mem_clear(dp, cb_size.w * sizeof(*dp));
         }
         else
-          this->codeblock_functions.mem_clear(dp, cb_size.w * sizeof(ui32));
+        {
+          assert(line->flags & line_buf::LFT_32BIT);
+          si32 *dp = line->i32 + line_offset;
+          if (!zero_block)
+          {
+            const ui32 *sp = buf32 + cur_line * stride;
+            this->codeblock_functions.tx_from_cb32(sp, dp, K_max, delta,
+                                                   gain, cb_size.w);
+          }
+          else
+            this->codeblock_functions.mem_clear(dp, cb_size.w * sizeof(ui32));
+        }
       }
       else
       {
@@ -250,7 +275,7 @@ namespace ojph {
         {
           const ui64 *sp = buf64 + cur_line * stride;
           this->codeblock_functions.tx_from_cb64(sp, dp, K_max, delta, 
-                                                 cb_size.w);
+                                                 gain, cb_size.w);
         }
         else
           this->codeblock_functions.mem_clear(dp, cb_size.w * sizeof(*dp));
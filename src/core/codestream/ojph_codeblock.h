@@ -98,6 +98,7 @@ namespace ojph {
       int line_offset;
       ui32 cur_line;
       float delta, delta_inv;
+      float gain;              // applied after delta, see subband::gain
       ui32 K_max;
       bool reversible;
       bool resilient;
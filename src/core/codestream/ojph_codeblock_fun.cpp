@@ -45,6 +45,7 @@
 #include "ojph_codestream.h"
 #include "ojph_codestream_local.h"
 #include "ojph_codeblock_fun.h"
+#include "ojph_codeblock_fun_local.h"
 
 #include "../transform/ojph_colour.h"
 #include "../transform/ojph_transform.h"
@@ -57,76 +58,6 @@ namespace ojph {
   {
 
     //////////////////////////////////////////////////////////////////////////
-    void gen_mem_clear(void* addr, size_t count);
-    void sse_mem_clear(void* addr, size_t count);
-    void avx_mem_clear(void* addr, size_t count);
-    void wasm_mem_clear(void* addr, size_t count);
-
-    //////////////////////////////////////////////////////////////////////////
-    ui32  gen_find_max_val32(ui32* address);
-    ui32 sse2_find_max_val32(ui32* address);
-    ui32 avx2_find_max_val32(ui32* address);
-    ui32 wasm_find_max_val32(ui32* address);
-    ui64  gen_find_max_val64(ui64* address);
-    ui64 sse2_find_max_val64(ui64* address);
-    ui64 avx2_find_max_val64(ui64* address);
-    ui64 wasm_find_max_val64(ui64* address);
-
-
-    //////////////////////////////////////////////////////////////////////////
-    void  gen_rev_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max,
-                             float delta_inv, ui32 count, ui32* max_val);
-    void sse2_rev_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max,
-                             float delta_inv, ui32 count, ui32* max_val);
-    void avx2_rev_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max,
-                             float delta_inv, ui32 count, ui32* max_val);
-    void  gen_irv_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max,
-                             float delta_inv, ui32 count, ui32* max_val);
-    void sse2_irv_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max,
-                             float delta_inv, ui32 count, ui32* max_val);
-    void avx2_irv_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max,
-                             float delta_inv, ui32 count, ui32* max_val);
-    void wasm_rev_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max,
-                             float delta_inv, ui32 count, ui32* max_val);
-    void wasm_irv_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max,
-                             float delta_inv, ui32 count, ui32* max_val);
-
-    void  gen_rev_tx_to_cb64(const void *sp, ui64 *dp, ui32 K_max,
-                             float delta_inv, ui32 count, ui64* max_val);
-    void sse2_rev_tx_to_cb64(const void *sp, ui64 *dp, ui32 K_max,
-                             float delta_inv, ui32 count, ui64* max_val);
-    void avx2_rev_tx_to_cb64(const void *sp, ui64 *dp, ui32 K_max,
-                             float delta_inv, ui32 count, ui64* max_val);
-    void wasm_rev_tx_to_cb64(const void *sp, ui64 *dp, ui32 K_max,
-                             float delta_inv, ui32 count, ui64* max_val);
-
-    //////////////////////////////////////////////////////////////////////////
-    void  gen_rev_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max,
-                               float delta, ui32 count);
-    void sse2_rev_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max,
-                               float delta, ui32 count);
-    void avx2_rev_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max,
-                               float delta, ui32 count);
-    void  gen_irv_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max,
-                               float delta, ui32 count);
-    void sse2_irv_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max,
-                               float delta, ui32 count);
-    void avx2_irv_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max,
-                               float delta, ui32 count);
-    void wasm_rev_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max,
-                               float delta, ui32 count);
-    void wasm_irv_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max,
-                               float delta, ui32 count);
-
-    void  gen_rev_tx_from_cb64(const ui64 *sp, void *dp, ui32 K_max,
-                               float delta, ui32 count);
-    void sse2_rev_tx_from_cb64(const ui64 *sp, void *dp, ui32 K_max,
-                               float delta, ui32 count);
-    void avx2_rev_tx_from_cb64(const ui64 *sp, void *dp, ui32 K_max,
-                               float delta, ui32 count);
-    void wasm_rev_tx_from_cb64(const ui64 *sp, void *dp, ui32 K_max,
-                               float delta, ui32 count);                               
-
     void codeblock_fun::init(bool reversible) {
 
 #if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
@@ -136,11 +67,15 @@ namespace ojph {
       find_max_val32 = gen_find_max_val32;
       mem_clear = gen_mem_clear;
       if (reversible) {
+        tx_to_cb16 = gen_rev_tx_to_cb16;
+        tx_from_cb16 = gen_rev_tx_from_cb16;
         tx_to_cb32 = gen_rev_tx_to_cb32;
         tx_from_cb32 = gen_rev_tx_from_cb32;
       }
       else
       {
+        tx_to_cb16 = gen_irv_tx_to_cb16;   // fixed-point lines
+        tx_from_cb16 = NULL;
         tx_to_cb32 = gen_irv_tx_to_cb32;
         tx_from_cb32 = gen_irv_tx_from_cb32;
       }
@@ -175,6 +110,8 @@ namespace ojph {
         if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_SSE2) {
           find_max_val32 = sse2_find_max_val32;
           if (reversible) {
+            tx_to_cb16 = sse2_rev_tx_to_cb16;
+            tx_from_cb16 = sse2_rev_tx_from_cb16;
             tx_to_cb32 = sse2_rev_tx_to_cb32;
             tx_from_cb32 = sse2_rev_tx_from_cb32;
           }
@@ -210,10 +147,13 @@ namespace ojph {
           decode_cb32 = ojph_decode_codeblock_avx2;
           find_max_val32 = avx2_find_max_val32;
           if (reversible) {
+            tx_to_cb16 = avx2_rev_tx_to_cb16;
+            tx_from_cb16 = avx2_rev_tx_from_cb16;
             tx_to_cb32 = avx2_rev_tx_to_cb32;
             tx_from_cb32 = avx2_rev_tx_from_cb32;
           }
           else {
+            tx_to_cb16 = avx2_irv_tx_to_cb16;
             tx_to_cb32 = avx2_irv_tx_to_cb32;
             tx_from_cb32 = avx2_irv_tx_from_cb32;
           }
@@ -236,9 +176,24 @@ namespace ojph {
 
       #if (defined(OJPH_ARCH_X86_64) && !defined(OJPH_DISABLE_AVX512))
         if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_AVX512) {
+          if (reversible) {
+            tx_to_cb16 = avx512_rev_tx_to_cb16;
+            tx_from_cb16 = avx512_rev_tx_from_cb16;
+            tx_to_cb32 = avx512_rev_tx_to_cb32;
+            tx_from_cb32 = avx512_rev_tx_from_cb32;
+          }
+          else {
+            tx_to_cb32 = avx512_irv_tx_to_cb32;
+            tx_from_cb32 = avx512_irv_tx_from_cb32;
+          }
           encode_cb32 = ojph_encode_codeblock_avx512;
           bool result = initialize_block_encoder_tables_avx512();
           assert(result); ojph_unused(result);
+
+          if (reversible) {
+            tx_to_cb64 = avx512_rev_tx_to_cb64;
+            tx_from_cb64 = avx512_rev_tx_from_cb64;
+          }
         }
       #endif // !OJPH_DISABLE_AVX512
 
@@ -254,6 +209,8 @@ namespace ojph {
       decode_cb32 = ojph_decode_codeblock_wasm;
       find_max_val32 = wasm_find_max_val32;
       mem_clear = wasm_mem_clear;
+      tx_to_cb16 = NULL;   // 16-bit lines are not used with WASM SIMD
+      tx_from_cb16 = NULL;
       if (reversible) {
         tx_to_cb32 = wasm_rev_tx_to_cb32;
         tx_from_cb32 = wasm_rev_tx_from_cb32;
@@ -62,12 +62,15 @@ namespace ojph {
     typedef void (*tx_to_cb_fun64)(const void *sp, ui64 *dp, ui32 K_max,
                                    float delta_inv, ui32 count, ui64* max_val);
 
-    // define line transfer function signature from codeblock to subband
+    // define line transfer function signature from codeblock to subband;
+    // irreversible samples are multiplied by delta and then by gain, which
+    // carries the first synthesis step's normalisation; reversible
+    // samples ignore both
     typedef void (*tx_from_cb_fun32)(const ui32 *sp, void *dp, ui32 K_max,
-                                     float delta, ui32 count);
+                                     float delta, float gain, ui32 count);
 
     typedef void (*tx_from_cb_fun64)(const ui64 *sp, void *dp, ui32 K_max,
-                                     float delta, ui32 count);
+                                     float delta, float gain, ui32 count);
 
     // define the block decoder function signature
     typedef bool (*cb_decoder_fun32)(ui8* coded_data, ui32* decoded_data,
@@ -102,10 +105,12 @@ namespace ojph {
       find_max_val_fun64 find_max_val64;
      
       // a pointer to function transferring samples from subbands to codeblocks
+      tx_to_cb_fun32 tx_to_cb16; // 16-bit lines (fixed-point if irv), 32-bit cb
       tx_to_cb_fun32 tx_to_cb32;
       tx_to_cb_fun64 tx_to_cb64;
      
       // a pointer to function transferring samples from codeblocks to subbands
+      tx_from_cb_fun32 tx_from_cb16; // 32-bit codeblock buffer, 16-bit lines
       tx_from_cb_fun32 tx_from_cb32;
       tx_from_cb_fun64 tx_from_cb64;
      
@@ -54,6 +54,18 @@ namespace ojph {
   //
   ////////////////////////////////////////////////////////////////////////////
 
+  ////////////////////////////////////////////////////////////////////////////
+  const char* codestream_stats::get_stage_name(ui32 stage)
+  {
+    static const char* names[] = { "colour", "cb_transfer", "cb_encode",
+      "cb_decode", "precinct_write", "precinct_parse", "file_io" };
+    if (stage < DWT)
+      return names[stage];
+    else if (stage < NUM_STAGES)
+      return "dwt";
+    return "unknown";
+  }
+
   ////////////////////////////////////////////////////////////////////////////
   codestream::~codestream()
   {
@@ -69,24 +81,28 @@ namespace ojph {
   ////////////////////////////////////////////////////////////////////////////
   param_siz codestream::access_siz()
   {
+    state->validated = false;
     return param_siz(&state->siz);
   }
 
   ////////////////////////////////////////////////////////////////////////////
   param_cod codestream::access_cod()
   {
+    state->validated = false;
     return param_cod(&state->cod);
   }
 
   ////////////////////////////////////////////////////////////////////////////
   param_qcd codestream::access_qcd()
   {
+    state->validated = false;
     return param_qcd(&state->qcd);
   }
 
   ////////////////////////////////////////////////////////////////////////////
   param_nlt codestream::access_nlt()
   {
+    state->validated = false;
     return param_nlt(&state->nlt);
   }
 
@@ -140,12 +156,64 @@ namespace ojph {
     return state->is_tlm_needed();
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  void codestream::set_irv_fixed_point(bool enable)
+  {
+    state->set_irv_fixed_point(enable);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void codestream::set_executor(executor* exec)
+  {
+    state->set_executor(exec);
+  }
+
   ////////////////////////////////////////////////////////////////////////////
   bool codestream::is_planar() const
   {
     return state->is_planar();
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  bool codestream::is_irv_fixed_point() const
+  {
+    return state->is_irv_fixed_point();
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  const codestream_stats& codestream::get_stats() const
+  {
+    return state->get_stats_collector()->get();
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void codestream::reset_stats()
+  {
+    state->get_stats_collector()->reset();
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void codestream::set_trace_sink(trace_sink* sink)
+  {
+    state->get_stats_collector()->set_trace(sink);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  codestream_memory codestream::get_memory_report() const
+  {
+    codestream_memory report;
+    state->get_memory_report(report);
+    return report;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  codestream_memory codestream::estimate_memory(size_t coded_bytes)
+  {
+    codestream_memory estimate;
+    state->estimate_memory(coded_bytes, estimate);
+    return estimate;
+  }
+
   ////////////////////////////////////////////////////////////////////////////
   void codestream::write_headers(outfile_base *file, 
                                  const comment_exchange* comments,
@@ -186,6 +254,30 @@ namespace ojph {
     return state->pull(comp_num);
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  void codestream::pull_region(const image_region& region)
+  {
+    state->pull_region(region);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void codestream::set_decode_target(const image_region* target)
+  {
+    state->set_decode_target(target);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void codestream::set_pyramid_output(ui32 num_levels, pyramid_sink* sink)
+  {
+    state->set_pyramid_output(num_levels, sink);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  size codestream::get_pyramid_size(ui32 level, ui32 comp_num) const
+  {
+    return state->get_pyramid_size(level, comp_num);
+  }
+
 
   ////////////////////////////////////////////////////////////////////////////
   void codestream::flush()
@@ -199,10 +291,25 @@ namespace ojph {
     state->close();
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  void codestream::restart()
+  {
+    local::codestream* fresh = new local::codestream;
+    fresh->take_memory(state);
+    delete state;
+    state = fresh;
+  }
+
   ////////////////////////////////////////////////////////////////////////////
   line_buf* codestream::exchange(line_buf* line, ui32& next_component)
   {
     return state->exchange(line, next_component);
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  void codestream::push_region(const image_region& region)
+  {
+    state->push_region(region);
+  }
+
 }
@@ -80,6 +80,46 @@ namespace ojph {
       return t;
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_rev_tx_to_cb16(const void *sp, ui32 *dp, ui32 K_max, 
+                             float delta_inv, ui32 count, ui32* max_val)
+    {
+      ojph_unused(delta_inv);
+
+      // convert to sign and magnitude and keep max_val      
+      ui32 shift = 31 - K_max;
+      __m256i m0 = _mm256_set1_epi32(INT_MIN);
+      __m256i tmax = _mm256_loadu_si256((__m256i*)max_val);
+      const si16 *p = (const si16*)sp;
+      for ( ; count >= 8; count -= 8, p += 8, dp += 8)
+      {
+        __m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*)p));
+        __m256i sign = _mm256_and_si256(v, m0);
+        __m256i val = _mm256_abs_epi32(v);
+        val = _mm256_slli_epi32(val, (int)shift);
+        tmax = _mm256_or_si256(tmax, val);
+        val = _mm256_or_si256(val, sign);
+        _mm256_storeu_si256((__m256i*)dp, val);
+      }
+      if (count)
+      {
+        __m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*)p));
+        __m256i sign = _mm256_and_si256(v, m0);
+        __m256i val = _mm256_abs_epi32(v);
+        val = _mm256_slli_epi32(val, (int)shift);
+
+        __m256i c = _mm256_set1_epi32((si32)count);
+        __m256i idx = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        __m256i mask = _mm256_cmpgt_epi32(c, idx);
+        c = _mm256_and_si256(val, mask);
+        tmax = _mm256_or_si256(tmax, c);
+
+        val = _mm256_or_si256(val, sign);
+        _mm256_storeu_si256((__m256i*)dp, val);
+      }
+      _mm256_storeu_si256((__m256i*)max_val, tmax);
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void avx2_rev_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max, 
                              float delta_inv, ui32 count, ui32* max_val)
@@ -120,6 +160,54 @@ namespace ojph {
       _mm256_storeu_si256((__m256i*)max_val, tmax);
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_irv_tx_to_cb16(const void *sp, ui32 *dp, ui32 K_max,
+                             float delta_inv, ui32 count, ui32* max_val)
+    {
+      ojph_unused(K_max);
+
+      //quantize and convert to sign and magnitude and keep max_val;
+      //samples are fixed-point numbers with IRV_FIX_FRAC_BITS fractional 
+      //bits
+      __m256 d = _mm256_set1_ps(
+        delta_inv * (1.0f / (float)(1 << IRV_FIX_FRAC_BITS)));
+      __m256i m0 = _mm256_set1_epi32(INT_MIN);
+      __m256i tmax = _mm256_loadu_si256((__m256i*)max_val);
+      const si16 *p = (const si16*)sp;
+
+      for ( ; count >= 8; count -= 8, p += 8, dp += 8)
+      {
+        __m256i t = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*)p));
+        __m256 vf = _mm256_cvtepi32_ps(t);
+        vf = _mm256_mul_ps(vf, d);                // multiply
+        __m256i val = _mm256_cvtps_epi32(vf);     // convert to int
+        __m256i sign = _mm256_and_si256(val, m0); // get sign
+        val = _mm256_abs_epi32(val);
+        tmax = _mm256_or_si256(tmax, val);
+        val = _mm256_or_si256(val, sign);
+        _mm256_storeu_si256((__m256i*)dp, val);
+      }
+      if (count)
+      {
+        __m256i t = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*)p));
+        __m256 vf = _mm256_cvtepi32_ps(t);
+        vf = _mm256_mul_ps(vf, d);                // multiply
+        __m256i val = _mm256_cvtps_epi32(vf);     // convert to int
+        __m256i sign = _mm256_and_si256(val, m0); // get sign
+        val = _mm256_abs_epi32(val);
+
+        __m256i c = _mm256_set1_epi32((si32)count);
+        __m256i idx = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        __m256i mask = _mm256_cmpgt_epi32(c, idx);
+        c = _mm256_and_si256(val, mask);
+        tmax = _mm256_or_si256(tmax, c);
+
+        val = _mm256_or_si256(val, sign);
+        _mm256_storeu_si256((__m256i*)dp, val);
+      }
+      _mm256_storeu_si256((__m256i*)max_val, tmax);
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void avx2_irv_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max,
                              float delta_inv, ui32 count, ui32* max_val)
@@ -163,11 +251,40 @@ namespace ojph {
       _mm256_storeu_si256((__m256i*)max_val, tmax);
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_rev_tx_from_cb16(const ui32 *sp, void *dp, ui32 K_max, 
+                               float delta, float gain, ui32 count)
+    {
+      ojph_unused(delta);
+      ojph_unused(gain);
+      ui32 shift = 31 - K_max;
+      __m256i m1 = _mm256_set1_epi32(INT_MAX);
+      si16 *p = (si16*)dp;
+      for (ui32 i = 0; i < count; i += 16, sp += 16, p += 16)
+      {
+        __m256i v = _mm256_load_si256((__m256i*)sp);
+        __m256i val = _mm256_and_si256(v, m1);
+        val = _mm256_srli_epi32(val, (int)shift);
+        __m256i lo = _mm256_sign_epi32(val, v);
+
+        v = _mm256_load_si256((__m256i*)sp + 1);
+        val = _mm256_and_si256(v, m1);
+        val = _mm256_srli_epi32(val, (int)shift);
+        __m256i hi = _mm256_sign_epi32(val, v);
+
+        // packs works on 128-bit lanes; permute to restore sample order
+        val = _mm256_packs_epi32(lo, hi);
+        val = _mm256_permute4x64_epi64(val, 0xD8);
+        _mm256_storeu_si256((__m256i*)p, val);
+      }
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void avx2_rev_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max, 
-                               float delta, ui32 count)
+                               float delta, float gain, ui32 count)
     {
       ojph_unused(delta);
+      ojph_unused(gain);
       ui32 shift = 31 - K_max;
       __m256i m1 = _mm256_set1_epi32(INT_MAX);
       si32 *p = (si32*)dp;
@@ -183,18 +300,19 @@ namespace ojph {
 
     //////////////////////////////////////////////////////////////////////////
     void avx2_irv_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max, 
-                               float delta, ui32 count)
+                               float delta, float gain, ui32 count)
     {
       ojph_unused(K_max);
       __m256i m1 = _mm256_set1_epi32(INT_MAX);
       __m256 d = _mm256_set1_ps(delta);
+      __m256 g = _mm256_set1_ps(gain);
       float *p = (float*)dp;
       for (ui32 i = 0; i < count; i += 8, sp += 8, p += 8)
       {
         __m256i v = _mm256_load_si256((__m256i*)sp);
         __m256i vali = _mm256_and_si256(v, m1);
         __m256  valf = _mm256_cvtepi32_ps(vali);
-        valf = _mm256_mul_ps(valf, d);
+        valf = _mm256_mul_ps(_mm256_mul_ps(valf, d), g);
         __m256i sign = _mm256_andnot_si256(m1, v);
         valf = _mm256_or_ps(valf, _mm256_castsi256_ps(sign));
         _mm256_storeu_ps(p, valf);
@@ -251,9 +369,10 @@ namespace ojph {
 
     //////////////////////////////////////////////////////////////////////////
     void avx2_rev_tx_from_cb64(const ui64 *sp, void *dp, ui32 K_max, 
-                               float delta, ui32 count)
+                               float delta, float gain, ui32 count)
     {
       ojph_unused(delta);
+      ojph_unused(gain);
       
       ui32 shift = 63 - K_max;
       __m256i m1 = _mm256_set1_epi64x(LLONG_MAX);
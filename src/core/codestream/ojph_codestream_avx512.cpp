@@ -0,0 +1,343 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2022, Aous Naman
+// Copyright (c) 2022, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2022, The University of New South Wales, Australia
+// Copyright (c) 2026, OpenJPH Project
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// 
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_codestream_avx512.cpp
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#include "ojph_arch.h"
+#if defined(OJPH_ARCH_X86_64)
+
+#include <climits>
+#include <immintrin.h>
+#include "ojph_defs.h"
+
+namespace ojph {
+  namespace local {
+
+    //////////////////////////////////////////////////////////////////////////
+    static inline 
+    __m512i avx512_load_max_val(const void* max_val)
+    {
+      __m256i t = _mm256_loadu_si256((__m256i*)max_val);
+      return _mm512_inserti64x4(_mm512_setzero_si512(), t, 0);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // The codeblock keeps a 256-bit max_val buffer; we accumulate in 512 
+    // bits and fold the upper half into the lower half before storing it,
+    // so that find_max_val32/64 of lower ISAs remain valid.
+    static inline 
+    void avx512_store_max_val(void* max_val, __m512i tmax)
+    {
+      __m256i lo = _mm512_castsi512_si256(tmax);
+      __m256i hi = _mm512_extracti64x4_epi64(tmax, 1);
+      _mm256_storeu_si256((__m256i*)max_val, _mm256_or_si256(lo, hi));
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx512_rev_tx_to_cb16(const void *sp, ui32 *dp, ui32 K_max, 
+                               float delta_inv, ui32 count, ui32* max_val)
+    {
+      ojph_unused(delta_inv);
+
+      // convert to sign and magnitude and keep max_val      
+      ui32 shift = 31 - K_max;
+      __m512i m0 = _mm512_set1_epi32(INT_MIN);
+      __m512i tmax = avx512_load_max_val(max_val);
+      const si16 *p = (const si16*)sp;
+      for ( ; count >= 16; count -= 16, p += 16, dp += 16)
+      {
+        __m512i v = _mm512_cvtepi16_epi32(_mm256_loadu_si256((__m256i*)p));
+        __m512i sign = _mm512_and_si512(v, m0);
+        __m512i val = _mm512_abs_epi32(v);
+        val = _mm512_slli_epi32(val, shift);
+        tmax = _mm512_or_si512(tmax, val);
+        val = _mm512_or_si512(val, sign);
+        _mm512_storeu_si512(dp, val);
+      }
+      if (count)
+      {
+        // 16-bit masked loads need AVX512BW; lines are padded, so we
+        // load a full vector and clear the unused lanes after widening
+        __mmask16 mask = (__mmask16)((1u << count) - 1);
+        __m512i v = _mm512_cvtepi16_epi32(_mm256_loadu_si256((__m256i*)p));
+        v = _mm512_maskz_mov_epi32(mask, v);
+        __m512i sign = _mm512_and_si512(v, m0);
+        __m512i val = _mm512_abs_epi32(v);
+        val = _mm512_slli_epi32(val, shift);
+        tmax = _mm512_or_si512(tmax, val); // masked-out lanes are zero
+        val = _mm512_or_si512(val, sign);
+        _mm512_mask_storeu_epi32(dp, mask, val);
+      }
+      avx512_store_max_val(max_val, tmax);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx512_rev_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max, 
+                               float delta_inv, ui32 count, ui32* max_val)
+    {
+      ojph_unused(delta_inv);
+
+      // convert to sign and magnitude and keep max_val      
+      ui32 shift = 31 - K_max;
+      __m512i m0 = _mm512_set1_epi32(INT_MIN);
+      __m512i tmax = avx512_load_max_val(max_val);
+      const si32 *p = (const si32*)sp;
+      for ( ; count >= 16; count -= 16, p += 16, dp += 16)
+      {
+        __m512i v = _mm512_loadu_si512(p);
+        __m512i sign = _mm512_and_si512(v, m0);
+        __m512i val = _mm512_abs_epi32(v);
+        val = _mm512_slli_epi32(val, shift);
+        tmax = _mm512_or_si512(tmax, val);
+        val = _mm512_or_si512(val, sign);
+        _mm512_storeu_si512(dp, val);
+      }
+      if (count)
+      {
+        __mmask16 mask = (__mmask16)((1u << count) - 1);
+        __m512i v = _mm512_maskz_loadu_epi32(mask, p);
+        __m512i sign = _mm512_and_si512(v, m0);
+        __m512i val = _mm512_abs_epi32(v);
+        val = _mm512_slli_epi32(val, shift);
+        tmax = _mm512_or_si512(tmax, val); // masked-out lanes are zero
+        val = _mm512_or_si512(val, sign);
+        _mm512_mask_storeu_epi32(dp, mask, val);
+      }
+      avx512_store_max_val(max_val, tmax);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx512_irv_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max,
+                               float delta_inv, ui32 count, ui32* max_val)
+    {
+      ojph_unused(K_max);
+
+      //quantize and convert to sign and magnitude and keep max_val
+      __m512 d = _mm512_set1_ps(delta_inv);
+      __m512i m0 = _mm512_set1_epi32(INT_MIN);
+      __m512i tmax = avx512_load_max_val(max_val);
+      const float *p = (const float*)sp;
+      for ( ; count >= 16; count -= 16, p += 16, dp += 16)
+      {
+        __m512 vf = _mm512_loadu_ps(p);
+        vf = _mm512_mul_ps(vf, d);                // multiply
+        __m512i val = _mm512_cvtps_epi32(vf);     // convert to int
+        __m512i sign = _mm512_and_si512(val, m0); // get sign
+        val = _mm512_abs_epi32(val);
+        tmax = _mm512_or_si512(tmax, val);
+        val = _mm512_or_si512(val, sign);
+        _mm512_storeu_si512(dp, val);
+      }
+      if (count)
+      {
+        __mmask16 mask = (__mmask16)((1u << count) - 1);
+        __m512 vf = _mm512_maskz_loadu_ps(mask, p);
+        vf = _mm512_mul_ps(vf, d);                // multiply
+        __m512i val = _mm512_cvtps_epi32(vf);     // convert to int
+        __m512i sign = _mm512_and_si512(val, m0); // get sign
+        val = _mm512_abs_epi32(val);
+        tmax = _mm512_or_si512(tmax, val); // masked-out lanes are zero
+        val = _mm512_or_si512(val, sign);
+        _mm512_mask_storeu_epi32(dp, mask, val);
+      }
+      avx512_store_max_val(max_val, tmax);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx512_rev_tx_from_cb16(const ui32 *sp, void *dp, ui32 K_max, 
+                                 float delta, float gain, ui32 count)
+    {
+      ojph_unused(delta);
+      ojph_unused(gain);
+      ui32 shift = 31 - K_max;
+      __m512i m1 = _mm512_set1_epi32(INT_MAX);
+      __m512i zero = _mm512_setzero_si512();
+      si16 *p = (si16*)dp;
+      for ( ; count >= 16; count -= 16, sp += 16, p += 16)
+      {
+        __m512i v = _mm512_load_si512(sp);
+        __m512i val = _mm512_and_si512(v, m1);
+        val = _mm512_srli_epi32(val, shift);
+        __mmask16 sign = _mm512_cmplt_epi32_mask(v, zero);
+        val = _mm512_mask_sub_epi32(val, sign, zero, val);
+        _mm256_storeu_si256((__m256i*)p, _mm512_cvtepi32_epi16(val));
+      }
+      if (count)
+      {
+        __mmask16 mask = (__mmask16)((1u << count) - 1);
+        __m512i v = _mm512_load_si512(sp); // sp rows are 64-byte multiples
+        __m512i val = _mm512_and_si512(v, m1);
+        val = _mm512_srli_epi32(val, shift);
+        __mmask16 sign = _mm512_cmplt_epi32_mask(v, zero);
+        val = _mm512_mask_sub_epi32(val, sign, zero, val);
+        _mm512_mask_cvtepi32_storeu_epi16(p, mask, val);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx512_rev_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max, 
+                                 float delta, float gain, ui32 count)
+    {
+      ojph_unused(delta);
+      ojph_unused(gain);
+      ui32 shift = 31 - K_max;
+      __m512i m1 = _mm512_set1_epi32(INT_MAX);
+      __m512i zero = _mm512_setzero_si512();
+      si32 *p = (si32*)dp;
+      for ( ; count >= 16; count -= 16, sp += 16, p += 16)
+      {
+        __m512i v = _mm512_load_si512(sp);
+        __m512i val = _mm512_and_si512(v, m1);
+        val = _mm512_srli_epi32(val, shift);
+        __mmask16 sign = _mm512_cmplt_epi32_mask(v, zero);
+        val = _mm512_mask_sub_epi32(val, sign, zero, val);
+        _mm512_storeu_si512(p, val);
+      }
+      if (count)
+      {
+        __mmask16 mask = (__mmask16)((1u << count) - 1);
+        __m512i v = _mm512_load_si512(sp); // sp rows are 64-byte multiples
+        __m512i val = _mm512_and_si512(v, m1);
+        val = _mm512_srli_epi32(val, shift);
+        __mmask16 sign = _mm512_cmplt_epi32_mask(v, zero);
+        val = _mm512_mask_sub_epi32(val, sign, zero, val);
+        _mm512_mask_storeu_epi32(p, mask, val);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx512_irv_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max, 
+                                 float delta, float gain, ui32 count)
+    {
+      ojph_unused(K_max);
+      __m512i m1 = _mm512_set1_epi32(INT_MAX);
+      __m512 d = _mm512_set1_ps(delta);
+      __m512 g = _mm512_set1_ps(gain);
+      float *p = (float*)dp;
+      for ( ; count >= 16; count -= 16, sp += 16, p += 16)
+      {
+        __m512i v = _mm512_load_si512(sp);
+        __m512i vali = _mm512_and_si512(v, m1);
+        __m512  valf = _mm512_cvtepi32_ps(vali);
+        valf = _mm512_mul_ps(_mm512_mul_ps(valf, d), g);
+        __m512i sign = _mm512_andnot_si512(m1, v);
+        valf = _mm512_castsi512_ps(
+          _mm512_or_si512(_mm512_castps_si512(valf), sign));
+        _mm512_storeu_ps(p, valf);
+      }
+      if (count)
+      {
+        __mmask16 mask = (__mmask16)((1u << count) - 1);
+        __m512i v = _mm512_load_si512(sp); // sp rows are 64-byte multiples
+        __m512i vali = _mm512_and_si512(v, m1);
+        __m512  valf = _mm512_cvtepi32_ps(vali);
+        valf = _mm512_mul_ps(_mm512_mul_ps(valf, d), g);
+        __m512i sign = _mm512_andnot_si512(m1, v);
+        valf = _mm512_castsi512_ps(
+          _mm512_or_si512(_mm512_castps_si512(valf), sign));
+        _mm512_mask_storeu_ps(p, mask, valf);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx512_rev_tx_to_cb64(const void *sp, ui64 *dp, ui32 K_max, 
+                               float delta_inv, ui32 count, ui64* max_val)
+    {
+      ojph_unused(delta_inv);
+
+      // convert to sign and magnitude and keep max_val      
+      ui32 shift = 63 - K_max;
+      __m512i m0 = _mm512_set1_epi64(LLONG_MIN);
+      __m512i tmax = avx512_load_max_val(max_val);
+      const si64 *p = (const si64*)sp;
+      for ( ; count >= 8; count -= 8, p += 8, dp += 8)
+      {
+        __m512i v = _mm512_loadu_si512(p);
+        __m512i sign = _mm512_and_si512(v, m0);
+        __m512i val = _mm512_abs_epi64(v);
+        val = _mm512_slli_epi64(val, shift);
+        tmax = _mm512_or_si512(tmax, val);
+        val = _mm512_or_si512(val, sign);
+        _mm512_storeu_si512(dp, val);
+      }
+      if (count)
+      {
+        __mmask8 mask = (__mmask8)((1u << count) - 1);
+        __m512i v = _mm512_maskz_loadu_epi64(mask, p);
+        __m512i sign = _mm512_and_si512(v, m0);
+        __m512i val = _mm512_abs_epi64(v);
+        val = _mm512_slli_epi64(val, shift);
+        tmax = _mm512_or_si512(tmax, val); // masked-out lanes are zero
+        val = _mm512_or_si512(val, sign);
+        _mm512_mask_storeu_epi64(dp, mask, val);
+      }
+      avx512_store_max_val(max_val, tmax);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx512_rev_tx_from_cb64(const ui64 *sp, void *dp, ui32 K_max, 
+                                 float delta, float gain, ui32 count)
+    {
+      ojph_unused(delta);
+      ojph_unused(gain);
+      ui32 shift = 63 - K_max;
+      __m512i m1 = _mm512_set1_epi64(LLONG_MAX);
+      __m512i zero = _mm512_setzero_si512();
+      si64 *p = (si64*)dp;
+      for ( ; count >= 8; count -= 8, sp += 8, p += 8)
+      {
+        __m512i v = _mm512_load_si512(sp);
+        __m512i val = _mm512_and_si512(v, m1);
+        val = _mm512_srli_epi64(val, shift);
+        __mmask8 sign = _mm512_cmplt_epi64_mask(v, zero);
+        val = _mm512_mask_sub_epi64(val, sign, zero, val);
+        _mm512_storeu_si512(p, val);
+      }
+      if (count)
+      {
+        __mmask8 mask = (__mmask8)((1u << count) - 1);
+        __m512i v = _mm512_load_si512(sp); // sp rows are 64-byte multiples
+        __m512i val = _mm512_and_si512(v, m1);
+        val = _mm512_srli_epi64(val, shift);
+        __mmask8 sign = _mm512_cmplt_epi64_mask(v, zero);
+        val = _mm512_mask_sub_epi64(val, sign, zero, val);
+        _mm512_mask_storeu_epi64(p, mask, val);
+      }
+    }
+  }
+}
+
+#endif
@@ -55,6 +55,28 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     ui64 gen_find_max_val64(ui64* addr) { return addr[0]; }
 
+    //////////////////////////////////////////////////////////////////////////
+    void gen_rev_tx_to_cb16(const void *sp, ui32 *dp, ui32 K_max, 
+                            float delta_inv, ui32 count, 
+                            ui32* max_val)
+    {
+      ojph_unused(delta_inv);
+      ui32 shift = 31 - K_max;
+      // convert to sign and magnitude and keep max_val
+      ui32 tmax = *max_val;
+      si16 *p = (si16*)sp;
+      for (ui32 i = count; i > 0; --i)
+      {
+        si32 v = *p++;
+        ui32 sign = v >= 0 ? 0U : 0x80000000U;
+        ui32 val = (ui32)(v >= 0 ? v : -v);
+        val <<= shift;
+        *dp++ = sign | val;
+        tmax |= val; // it is more efficient to use or than max
+      }
+      *max_val = tmax;
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void gen_rev_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max, 
                             float delta_inv, ui32 count, 
@@ -99,6 +121,30 @@ namespace ojph {
       *max_val = tmax;
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void gen_irv_tx_to_cb16(const void *sp, ui32 *dp, ui32 K_max,
+                            float delta_inv, ui32 count, 
+                            ui32* max_val)
+    {
+      ojph_unused(K_max);
+      //quantize and convert to sign and magnitude and keep max_val;
+      //samples are fixed-point numbers with IRV_FIX_FRAC_BITS fractional 
+      //bits
+      float d = delta_inv * (1.0f / (float)(1 << IRV_FIX_FRAC_BITS));
+      ui32 tmax = *max_val;
+      const si16 *p = (const si16*)sp;
+      for (ui32 i = count; i > 0; --i)
+      {
+        float v = (float)*p++;
+        si32 t = ojph_trunc(v * d);
+        ui32 sign = t >= 0 ? 0U : 0x80000000U;
+        ui32 val = (ui32)(t >= 0 ? t : -t);
+        *dp++ = sign | val;
+        tmax |= val; // it is more efficient to use or than max
+      }
+      *max_val = tmax;
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void gen_irv_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max,
                             float delta_inv, ui32 count, 
@@ -120,11 +166,29 @@ namespace ojph {
       *max_val = tmax;
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void gen_rev_tx_from_cb16(const ui32 *sp, void *dp, ui32 K_max,
+                              float delta, float gain, ui32 count)
+    {
+      ojph_unused(delta);
+      ojph_unused(gain);
+      ui32 shift = 31 - K_max;
+      //convert to sign and magnitude
+      si16 *p = (si16*)dp;
+      for (ui32 i = count; i > 0; --i)
+      {
+        ui32 v = *sp++;
+        si32 val = (v & 0x7FFFFFFFU) >> shift;
+        *p++ = (si16)((v & 0x80000000U) ? -val : val);
+      }
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void gen_rev_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max,
-                              float delta, ui32 count)
+                              float delta, float gain, ui32 count)
     {
       ojph_unused(delta);
+      ojph_unused(gain);
       ui32 shift = 31 - K_max;
       //convert to sign and magnitude
       si32 *p = (si32*)dp;
@@ -138,9 +202,10 @@ namespace ojph {
 
     //////////////////////////////////////////////////////////////////////////
     void gen_rev_tx_from_cb64(const ui64 *sp, void *dp, ui32 K_max,
-                              float delta, ui32 count)
+                              float delta, float gain, ui32 count)
     {
       ojph_unused(delta);
+      ojph_unused(gain);
       ui32 shift = 63 - K_max;
       //convert to sign and magnitude
       si64 *p = (si64*)dp;
@@ -154,7 +219,7 @@ namespace ojph {
 
     //////////////////////////////////////////////////////////////////////////
     void gen_irv_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max,
-                              float delta, ui32 count)
+                              float delta, float gain, ui32 count)
     {
       ojph_unused(K_max);
       //convert to sign and magnitude
@@ -162,7 +227,7 @@ namespace ojph {
       for (ui32 i = count; i > 0; --i)
       {
         ui32 v = *sp++;
-        float val = (float)(v & 0x7FFFFFFFU) * delta;
+        float val = (float)(v & 0x7FFFFFFFU) * delta * gain;
         *p++ = (v & 0x80000000U) ? -val : val;
       }
     }
@@ -38,11 +38,13 @@
 
 #include <climits>
 #include <cmath>
+#include <cstring>
 
 #include "ojph_mem.h"
 #include "ojph_params.h"
 #include "ojph_codestream_local.h"
 #include "ojph_tile.h"
+#include "ojph_block_scheduler.h"
 
 #include "../transform/ojph_colour.h"
 #include "../transform/ojph_transform.h"
@@ -58,11 +60,13 @@ namespace ojph {
     {
       tiles = NULL;
       lines = NULL;
+      target_lines = NULL;
       comp_size = NULL;
       recon_comp_size = NULL;
       allocator = NULL;
       outfile = NULL;
       infile = NULL;
+      scheduler = NULL;
 
       num_comps = 0;
       employ_color_transform = false;
@@ -70,11 +74,20 @@ namespace ojph {
       profile = OJPH_PN_UNDEFINED;
       tilepart_div = OJPH_TILEPART_NO_DIVISIONS;
       need_tlm = false;
+      irv_fixed_point = false;
+      validated = false;
 
       cur_comp = 0;
       cur_line = 0;
       cur_tile_row = 0;
       resilient = false;
+      memset(&decode_target, 0, sizeof(decode_target));
+      target_first_line = 0;
+      pyramid_levels = 0;
+      pyramid = NULL;
+      pyr_rings = NULL;
+      pyr_sizes = NULL;
+      pyr_done = pyr_sent = NULL;
       skipped_res_for_read = skipped_res_for_recon = 0;
 
       precinct_scratch_needed_bytes = 0;
@@ -99,6 +112,36 @@ namespace ojph {
         delete allocator;
       if (elastic_alloc)
         delete elastic_alloc;
+      if (scheduler)
+        delete scheduler;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::set_executor(executor* exec)
+    {
+      if (tiles != NULL)
+        OJPH_ERROR(0x00030101, "set_executor() must be called before "
+          "write_headers() or create()");
+      if (scheduler)
+        delete scheduler;
+      scheduler = exec ? new block_scheduler(exec) : NULL;
+      elastic_alloc->set_concurrent(exec != NULL);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::take_memory(codestream* other)
+    {
+      // exchange allocators, so that other deletes the unused ones
+      mem_fixed_allocator* a = allocator;
+      allocator = other->allocator;
+      other->allocator = a;
+      mem_elastic_allocator* e = elastic_alloc;
+      elastic_alloc = other->elastic_alloc;
+      other->elastic_alloc = e;
+      elastic_alloc->set_concurrent(scheduler != NULL);
+      other->elastic_alloc->set_concurrent(other->scheduler != NULL);
+      allocator->restart();
+      elastic_alloc->restart();
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -166,9 +209,38 @@ namespace ojph {
       allocator->pre_alloc_obj<size>(num_comps); //for *recon_comp_size
       for (ui32 i = 0; i < num_comps; ++i)
         allocator->pre_alloc_data<si32>(siz.get_recon_width(i), 0);
+      if (infile != NULL)
+        allocator->pre_alloc_obj<line_buf>(num_comps); //for *target_lines
+
+      //allocate lines for the lower resolutions of a pyramid output
+      if (pyramid_levels > 0)
+      {
+        for (ui32 i = 0; i < num_comps; ++i)
+        {
+          ui32 num_decomps = get_coc(i)->get_num_decompositions();
+          if (skipped_res_for_recon + pyramid_levels > num_decomps)
+            OJPH_ERROR(0x000300F3, "A pyramid of %d levels is not possible "
+              "when %d resolutions are skipped for reconstruction, because "
+              "component %d has only %d decompositions", pyramid_levels,
+              skipped_res_for_recon, i, num_decomps);
+        }
+        ui32 num_rings = pyramid_levels * num_comps;
+        allocator->pre_alloc_obj<line_buf*>(num_rings);
+        allocator->pre_alloc_obj<size>(num_rings);
+        allocator->pre_alloc_obj<ui32>(num_rings);
+        allocator->pre_alloc_obj<ui32>(num_rings);
+        for (ui32 l = 1; l <= pyramid_levels; ++l)
+          for (ui32 i = 0; i < num_comps; ++i)
+          {
+            ui32 depth = get_pyramid_depth();
+            allocator->pre_alloc_obj<line_buf>(depth);
+            for (ui32 j = 0; j < depth; ++j)
+              allocator->pre_alloc_data<si32>(siz.get_recon_size(i, l).x, 0);
+          }
+      }
 
       //allocate tlm
-      if (outfile != NULL && need_tlm)
+      if (infile == NULL && need_tlm)  // encoding
         allocator->pre_alloc_obj<param_tlm::Ttlm_Ptlm_pair>(num_tileparts);
 
       //precinct scratch buffer
@@ -206,6 +278,29 @@ namespace ojph {
       precinct_scratch = 
         allocator->post_alloc_obj<ui8>(precinct_scratch_needed_bytes);
 
+      //allocate lines for the lower resolutions of a pyramid output;
+      //these are needed by the tiles
+      if (pyramid_levels > 0)
+      {
+        ui32 num_comps = siz.get_num_components();
+        ui32 num_rings = pyramid_levels * num_comps;
+        pyr_rings = allocator->post_alloc_obj<line_buf*>(num_rings);
+        pyr_sizes = allocator->post_alloc_obj<size>(num_rings);
+        pyr_done = allocator->post_alloc_obj<ui32>(num_rings);
+        pyr_sent = allocator->post_alloc_obj<ui32>(num_rings);
+        for (ui32 l = 1, k = 0; l <= pyramid_levels; ++l)
+          for (ui32 i = 0; i < num_comps; ++i, ++k)
+          {
+            pyr_sizes[k] = get_pyramid_size(l, i);
+            pyr_done[k] = pyr_sent[k] = 0;
+            ui32 depth = get_pyramid_depth(), cw = pyr_sizes[k].w;
+            pyr_rings[k] = allocator->post_alloc_obj<line_buf>(depth);
+            for (ui32 j = 0; j < depth; ++j)
+              pyr_rings[k][j].wrap(
+                allocator->post_alloc_data<si32>(cw, 0), cw, 0);
+          }
+      }
+
       //get tiles
       tiles = this->allocator->post_alloc_obj<tile>((size_t)num_tiles.area());
 
@@ -258,17 +353,71 @@ namespace ojph {
         recon_comp_size[i].h = siz.get_recon_height(i);
         lines[i].wrap(allocator->post_alloc_data<si32>(cw, 0), cw, 0);        
       }
+      if (infile != NULL)
+        target_lines = allocator->post_alloc_obj<line_buf>(this->num_comps);
 
       cur_comp = 0;
       cur_line = 0;
 
       //allocate tlm
-      if (outfile != NULL && need_tlm)
+      if (infile == NULL && need_tlm)  // encoding
         tlm.init(num_tileparts,
           allocator->post_alloc_obj<param_tlm::Ttlm_Ptlm_pair>(num_tileparts));
     }
 
 
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::get_memory_report(codestream_memory& report)
+    {
+      // the fixed arena is allocated by finalize_alloc(), with the tiles,
+      // and is kept by restart()
+      report.fixed_bytes = allocator->get_capacity();
+      report.elastic_bytes = elastic_alloc->get_total_allocated();
+      report.num_elastic_chunks = elastic_alloc->get_num_chunks();
+      report.coded_bytes = elastic_alloc->get_total_used();
+      report.peak_bytes = report.fixed_bytes + report.elastic_bytes;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::estimate_memory(size_t coded_bytes,
+                                     codestream_memory& estimate)
+    {
+      if (tiles)
+        estimate.fixed_bytes = allocator->get_size();
+      else
+      {
+        if (infile == NULL) // encoding, before write_headers()
+          check_validity();
+
+        // pre_alloc() only adds up sizes; direct it to a scratch allocator
+        mem_fixed_allocator scratch;
+        mem_fixed_allocator* saved = allocator;
+        allocator = &scratch;
+        try {
+          pre_alloc();
+        }
+        catch (...) {
+          allocator = saved;
+          throw;
+        }
+        allocator = saved;
+        estimate.fixed_bytes = scratch.get_size();
+      }
+
+      // Coded data is stored in buffers, one or more per codeblock, each
+      // with a small header, and a chunk's tail is wasted when the next
+      // buffer does not fit; allow a sixteenth more than the coded data for
+      // these, together with the precinct headers produced by encoding.
+      size_t chunk_size = elastic_alloc->get_chunk_size();
+      size_t needed = coded_bytes + (coded_bytes >> 4);
+      estimate.num_elastic_chunks =
+        ojph_max((size_t)1, ojph_div_ceil(needed, chunk_size));
+      estimate.elastic_bytes = estimate.num_elastic_chunks
+        * elastic_alloc->get_chunk_footprint();
+      estimate.coded_bytes = coded_bytes;
+      estimate.peak_bytes = estimate.fixed_bytes + estimate.elastic_bytes;
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void codestream::check_imf_validity()
     {
@@ -533,9 +682,7 @@ namespace ojph {
     }
 
     //////////////////////////////////////////////////////////////////////////
-    void codestream::write_headers(outfile_base *file, 
-                                   const comment_exchange* comments,
-                                   ui32 num_comments)
+    void codestream::check_validity()
     {
       //finalize
       siz.check_validity(cod);
@@ -589,6 +736,16 @@ namespace ojph {
           "has been corrected by removing tilepart divisions at the "
           "resolution level.");
       }
+      validated = true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::write_headers(outfile_base *file, 
+                                   const comment_exchange* comments,
+                                   ui32 num_comments)
+    {
+      if (!validated) // estimate_memory() may have validated already
+        check_validity();
 
       if (planar == -1) //not initialized
         planar = cod.is_employing_color_transform() ? 1 : 0;
@@ -606,6 +763,10 @@ namespace ojph {
         assert(0);
 
       assert(this->outfile == NULL);
+#ifdef OJPH_ENABLE_STATS
+      stats_out.wrap(file, &stats);
+      file = &stats_out;
+#endif
       this->outfile = file;
       this->pre_alloc();
       this->finalize_alloc();
@@ -731,6 +892,10 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void codestream::read_headers(infile_base *file)
     {
+#ifdef OJPH_ENABLE_STATS
+      stats_in.wrap(file, &stats);
+      file = &stats_in;
+#endif
       ui16 marker_list[20] = { SOC, SIZ, CAP, PRF, CPF, COD, COC, QCD, QCC,
         RGN, POC, PPM, TLM, PLM, CRG, COM, DFS, ATK, NLT, SOT };
       find_marker(file, marker_list, 1); //find SOC
@@ -1087,12 +1252,14 @@ namespace ojph {
         profile = OJPH_PN_IMF;
       else
         OJPH_ERROR(0x000300A1, "unkownn or unsupported profile");
+      validated = false;
     }
 
     //////////////////////////////////////////////////////////////////////////
     void codestream::set_tilepart_divisions(ui32 value)
     {
-      tilepart_div = value;      
+      tilepart_div = value;
+      validated = false;
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -1101,6 +1268,32 @@ namespace ojph {
       need_tlm = needed;
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    bool codestream::uses_irv_fixed_point(ui32 comp_num)
+    {
+      if (!irv_fixed_point || infile != NULL) // encoding only
+        return false;
+
+      // when the colour transform is employed, the first three components
+      // must all take the same path
+      ui32 first = comp_num, last = comp_num;
+      if (comp_num < 3 && cod.is_employing_color_transform())
+      { first = 0; last = 2; }
+
+      for (ui32 c = first; c <= last; ++c)
+      {
+        if (get_coc(c)->is_reversible())
+          return false;
+        ui8 bd, nlt_type; bool is;
+        if (nlt.get_nonlinear_transform(c, bd, is, nlt_type) &&
+            nlt_type == param_nlt::nonlinearity::OJPH_NLT_BINARY_COMPLEMENT_NLT)
+          return false;
+        if (!use_fix16_irv_path(siz.get_bit_depth(c)))
+          return false;
+      }
+      return true;
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void codestream::flush()
     {
@@ -1123,6 +1316,7 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void codestream::close()
     {
+      decode_target.data = NULL;
       if (infile)
         infile->close();
       if (outfile)
@@ -1134,6 +1328,9 @@ namespace ojph {
     {
       if (line)
       {
+        // tiles can hold on to our own lines for components 0 and 1 until
+        // component 2 arrives, but not on lines that belong to the caller
+        bool owned = line == lines + cur_comp;
         bool success = false;
         while (!success)
         {
@@ -1141,7 +1338,7 @@ namespace ojph {
           for (ui32 i = 0; i < num_tiles.w; ++i)
           {
             ui32 idx = i + cur_tile_row * num_tiles.w;
-            if ((success &= tiles[idx].push(line, cur_comp)) == false)
+            if ((success &= tiles[idx].push(line, cur_comp, owned)) == false)
               break;
           }
           cur_tile_row += success == false ? 1 : 0;
@@ -1183,6 +1380,26 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     line_buf* codestream::pull(ui32 &comp_num)
     {
+      // the tiles write the rows of an S32 target with contiguous samples
+      // themselves; rows of other targets are converted from our lines
+      line_buf* tgt_lines = lines;
+      bool in_target = decode_target.data != NULL &&
+        cur_line - target_first_line < decode_target.num_rows;
+      bool direct = in_target && decode_target.type == image_region::S32
+        && decode_target.sample_stride == (si64)sizeof(si32);
+      if (direct)
+      {
+        ui8* row = (ui8*)decode_target.data
+          + (si64)(cur_line - target_first_line) * decode_target.row_stride;
+        ui32 first = planar ? cur_comp : 0;
+        ui32 last = planar ? cur_comp + 1 : num_comps;
+        for (ui32 c = first; c < last; ++c)
+          target_lines[c].wrap(
+            (si32*)(row + (si64)c * decode_target.comp_stride),
+            recon_comp_size[c].w, 0);
+        tgt_lines = target_lines;
+      }
+
       bool success = false;
       while (!success)
       {
@@ -1190,8 +1407,11 @@ namespace ojph {
         for (ui32 i = 0; i < num_tiles.w; ++i)
         {
           ui32 idx = i + cur_tile_row * num_tiles.w;
-          if ((success &= tiles[idx].pull(lines + cur_comp, cur_comp)) == false)
+          if ((success &= tiles[idx].pull(tgt_lines, cur_comp, direct))
+              == false)
             break;
+          if (pyramid_levels > 0)
+            tiles[idx].pull_pyramid(cur_comp);
         }
         cur_tile_row += success == false ? 1 : 0;
         if (cur_tile_row >= num_tiles.h)
@@ -1199,6 +1419,13 @@ namespace ojph {
       }
       comp_num = cur_comp;
 
+      if (pyramid_levels > 0)
+        push_pyramid_lines();
+
+      if (in_target && !direct)
+        line_to_region_row(lines + comp_num, decode_target, comp_num,
+          cur_line - target_first_line);
+
       if (planar) //process one component at a time
       {
         if (++cur_line >= recon_comp_size[cur_comp].h)
@@ -1225,7 +1452,88 @@ namespace ojph {
         }
       }
 
-      return lines + comp_num;
+      return tgt_lines + comp_num;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::set_pyramid_output(ui32 num_levels, pyramid_sink* sink)
+    {
+      if (infile == NULL || tiles != NULL)
+        OJPH_ERROR(0x000300F1, "set_pyramid_output can only be used for "
+          "decoding, after read_headers() and before create()");
+      if (num_levels > 0 && sink == NULL)
+        OJPH_ERROR(0x000300F2, "set_pyramid_output needs a sink to deliver "
+          "%d levels to", num_levels);
+      pyramid_levels = num_levels;
+      pyramid = sink;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    size codestream::get_pyramid_size(ui32 level, ui32 comp_num) const
+    {
+      point p = siz.get_recon_size(comp_num, level);
+      return size(p.x, p.y);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    ui32 codestream::get_pyramid_depth() const
+    {
+      // Each lifting step delays the vertical synthesis of a resolution by
+      // one row, so n rows of its output consume at most (n + S + 1) / 2
+      // rows of the resolution below it, where S is the number of steps,
+      // and at least n / 2 - 1 / 2; horizontal-only levels consume one row
+      // per row.  For t rows of the image, a level l therefore completes
+      // between t / 2^l - 1 and t / 2^l + S + 1 rows, whatever l is.  A
+      // row is sent once all components have it, and the components are
+      // at most one image row apart, so no more than S + 3 completed rows
+      // are waiting to be sent at any level
+      ui32 max_steps = 0;
+      for (ui32 c = 0; c < siz.get_num_components(); ++c)
+        max_steps = ojph_max(max_steps,
+          cod.get_coc(c)->access_atk()->get_num_steps());
+      return max_steps + 3;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::push_pyramid_lines()
+    {
+      for (ui32 l = 1, k0 = 0; l <= pyramid_levels; ++l, k0 += num_comps)
+      {
+        ui32 depth = get_pyramid_depth();
+        for (ui32 c = 0; c < num_comps; ++c)
+          assert(pyr_done[k0 + c] <= pyr_sent[k0 + c] + depth);
+
+        if (planar) // rows of one component at a time, as in pull()
+        {
+          for (ui32 c = 0; c < num_comps; ++c)
+            for (ui32 k = k0 + c; pyr_sent[k] < pyr_done[k]; ++pyr_sent[k])
+              pyramid->push_line(l, c, pyr_sent[k],
+                pyr_rings[k] + pyr_sent[k] % depth);
+          continue;
+        }
+
+        // send a row only when all the components that have it are done
+        for (;;)
+        {
+          ui32 row = 0xFFFFFFFF;
+          for (ui32 c = 0; c < num_comps; ++c)
+            if (pyr_sent[k0 + c] < pyr_sizes[k0 + c].h)
+              row = ojph_min(row, pyr_sent[k0 + c]);
+          bool complete = row != 0xFFFFFFFF;
+          for (ui32 c = 0; complete && c < num_comps; ++c)
+            if (row < pyr_sizes[k0 + c].h)
+              complete = pyr_done[k0 + c] > row;
+          if (!complete)
+            break;
+          for (ui32 c = 0; c < num_comps; ++c)
+          {
+            ui32 k = k0 + c;
+            if (row < pyr_sizes[k].h)
+              pyramid->push_line(l, c, pyr_sent[k]++,
+                pyr_rings[k] + row % depth);
+          }
+        }
+      }
     }
 
   }
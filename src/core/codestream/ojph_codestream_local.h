@@ -40,7 +40,9 @@
 #define OJPH_CODESTREAM_LOCAL_H
 
 #include "ojph_defs.h"
+#include "ojph_codestream.h"
 #include "ojph_params_local.h"
+#include "ojph_stats_local.h"
 
 namespace ojph {
 
@@ -50,6 +52,7 @@ namespace ojph {
   class mem_fixed_allocator;
   class mem_elastic_allocator;
   class codestream;
+  class executor;
 
   namespace local {
 
@@ -63,6 +66,7 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     //defined elsewhere
     class tile;
+    class block_scheduler;
 
     //////////////////////////////////////////////////////////////////////////
     class codestream
@@ -75,6 +79,8 @@ namespace ojph {
 
       void pre_alloc();
       void finalize_alloc();
+      void get_memory_report(codestream_memory& report);
+      void estimate_memory(size_t coded_bytes, codestream_memory& estimate);
 
       ojph::param_siz access_siz()            //return externally wrapped siz
       { return ojph::param_siz(&siz); }
@@ -94,9 +100,12 @@ namespace ojph {
       { return &nlt; }
       mem_fixed_allocator* get_allocator() { return allocator; }
       mem_elastic_allocator* get_elastic_alloc() { return elastic_alloc; }
+      void take_memory(codestream* other);
       outfile_base* get_file() { return outfile; }
+      stats_collector* get_stats_collector() { return &stats; }
 
       line_buf* exchange(line_buf* line, ui32& next_component);
+      void push_region(const image_region& region);
       void write_headers(outfile_base *file, const comment_exchange* comments,
                          ui32 num_comments);
       void enable_resilience();
@@ -109,7 +118,18 @@ namespace ojph {
       void set_profile(const char *s);
       void set_tilepart_divisions(ui32 value);
       void request_tlm_marker(bool needed);
+      void set_irv_fixed_point(bool enable) { irv_fixed_point = enable; }
+      void set_executor(executor* exec);
+      block_scheduler* get_block_scheduler() { return scheduler; }
       line_buf* pull(ui32 &comp_num);
+      void pull_region(const image_region& region);
+      void set_decode_target(const image_region* target);
+      void set_pyramid_output(ui32 num_levels, pyramid_sink* sink);
+      size get_pyramid_size(ui32 level, ui32 comp_num) const;
+      ui32 get_pyramid_levels() const { return pyramid_levels; }
+      ui32 get_pyramid_depth() const;
+      line_buf** get_pyramid_rings() { return pyr_rings; }
+      ui32* get_pyramid_done() { return pyr_done; }
       void flush();
       void close();
 
@@ -117,7 +137,10 @@ namespace ojph {
       si32 get_profile() const { return profile; };
       ui32 get_tilepart_div() const { return tilepart_div; };
       bool is_tlm_needed() const { return need_tlm; };
+      bool is_irv_fixed_point() const { return irv_fixed_point; }
+      bool uses_irv_fixed_point(ui32 comp_num);
 
+      void check_validity();
       void check_imf_validity();
       void check_broadcast_validity();
 
@@ -127,6 +150,18 @@ namespace ojph {
       ui32 get_skipped_res_for_read()
       { return skipped_res_for_read; }
 
+    private:
+      void push_pyramid_lines();
+
+    private: // defined in ojph_codestream_region.cpp
+      void check_region(const image_region& region, const size* comp_dims,
+                        const char* name);
+      void region_row_to_line(const image_region& region, ui32 comp_num,
+                              ui32 row, line_buf* line);
+      void line_to_region_row(const line_buf* line,
+                              const image_region& region, ui32 comp_num,
+                              ui32 row);
+
     private:
       ui32 precinct_scratch_needed_bytes;
       ui8* precinct_scratch;
@@ -137,6 +172,16 @@ namespace ojph {
       ui32 cur_tile_row;
       bool resilient;
       ui32 skipped_res_for_read, skipped_res_for_recon;
+      image_region decode_target; // data is NULL when there is no target
+      line_buf* target_lines;     // a decode target's rows, for the tiles
+      ui32 target_first_line;     // cur_line when the target was set
+      ui32 pyramid_levels;        // lower resolutions sent to pyramid
+      pyramid_sink* pyramid;
+      // the following are per level and component
+      line_buf** pyr_rings;       // rows waiting to be sent to pyramid
+      size* pyr_sizes;
+      ui32* pyr_done;             // number of rows completed by the tiles
+      ui32* pyr_sent;             // number of rows sent to pyramid
 
     private:
       size num_tiles;
@@ -150,6 +195,8 @@ namespace ojph {
       int profile;
       ui32 tilepart_div;     // tilepart division value
       bool need_tlm;         // true if tlm markers are needed
+      bool irv_fixed_point;  // true if fixed-point irv path is requested
+      bool validated;        // check_validity() ran after the last change
       
     private:
       param_siz siz;         // image and tile size
@@ -167,8 +214,16 @@ namespace ojph {
     private:
       mem_fixed_allocator *allocator;
       mem_elastic_allocator *elastic_alloc;
+      block_scheduler *scheduler; // NULL unless there is an executor
       outfile_base *outfile;
       infile_base *infile;
+
+    private:
+      stats_collector stats;   // zeroed unless OJPH_ENABLE_STATS is defined
+#ifdef OJPH_ENABLE_STATS
+      stats_outfile stats_out; // wrap the user's file to time file access
+      stats_infile stats_in;
+#endif
     };
 
   }
@@ -0,0 +1,307 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// 
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_codestream_region.cpp
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "ojph_mem.h"
+#include "ojph_params.h"
+#include "ojph_codestream.h"
+#include "ojph_message.h"
+#include "ojph_codestream_local.h"
+
+namespace ojph {
+
+  namespace local
+  {
+
+    //////////////////////////////////////////////////////////////////////////
+    //
+    //
+    //                     row conversion, one per sample type
+    //
+    //
+    //////////////////////////////////////////////////////////////////////////
+
+    //////////////////////////////////////////////////////////////////////////
+    // The contiguous case is kept as a separate loop, so that the compiler
+    // can vectorize it
+    template<typename T>
+    static void int_row_to_line(const ui8* sp, si64 stride, si32* dp,
+                                ui32 width)
+    {
+      if (stride == (si64)sizeof(T))
+      {
+        const T* p = (const T*)sp;
+        for (ui32 x = 0; x < width; ++x)
+          dp[x] = (si32)p[x];
+      }
+      else
+        for (ui32 x = 0; x < width; ++x, sp += stride)
+          dp[x] = (si32)*(const T*)sp;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    static void line_to_int_row(const si32* sp, ui8* dp, si64 stride,
+                                ui32 width)
+    {
+      const si32 lo = (si32)std::numeric_limits<T>::min();
+      const si32 hi = (si32)std::numeric_limits<T>::max();
+      if (stride == (si64)sizeof(T))
+      {
+        T* p = (T*)dp;
+        for (ui32 x = 0; x < width; ++x)
+          p[x] = (T)ojph_max(lo, ojph_min(hi, sp[x]));
+      }
+      else
+        for (ui32 x = 0; x < width; ++x, dp += stride)
+          *(T*)dp = (T)ojph_max(lo, ojph_min(hi, sp[x]));
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // maps normalized floats to integers; for unsigned components, [0, 1]
+    // maps to [0, 2^B - 1], and for signed, [-0.5, 0.5) to
+    // [-2^(B-1), 2^(B-1) - 1]
+    static void float_row_to_line(const ui8* sp, si64 stride, si32* dp,
+                                  ui32 width, ui32 bit_depth, bool is_signed)
+    {
+      double scale = is_signed ? ldexp(1.0, (int)bit_depth)
+                               : ldexp(1.0, (int)bit_depth) - 1.0;
+      double lo = is_signed ? -ldexp(1.0, (int)bit_depth - 1) : 0.0;
+      double hi = is_signed ? ldexp(1.0, (int)bit_depth - 1) - 1.0 : scale;
+      if (stride == (si64)sizeof(float) && bit_depth < 32)
+      {
+        // clamping first, the shifted value is not negative, and it fits
+        // in si32, so truncation rounds it as floor() does; this leaves a
+        // loop that the compiler can vectorize
+        const float* p = (const float*)sp;
+        si32 i_lo = (si32)lo;
+        for (ui32 x = 0; x < width; ++x)
+        {
+          double v = ojph_max(lo, ojph_min(hi, (double)p[x] * scale));
+          dp[x] = (si32)(v - lo + 0.5) + i_lo;
+        }
+      }
+      else
+        for (ui32 x = 0; x < width; ++x, sp += stride)
+        {
+          double v = floor((double)*(const float*)sp * scale + 0.5);
+          dp[x] = (si32)ojph_max(lo, ojph_min(hi, v));
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    static void line_to_float_row(const si32* sp, ui8* dp, si64 stride,
+                                  ui32 width, ui32 bit_depth, bool is_signed)
+    {
+      double scale = is_signed ? ldexp(1.0, (int)bit_depth)
+                               : ldexp(1.0, (int)bit_depth) - 1.0;
+      float inv_scale = (float)(1.0 / scale);
+      if (stride == (si64)sizeof(float))
+      {
+        float* p = (float*)dp;
+        for (ui32 x = 0; x < width; ++x)
+          p[x] = (float)sp[x] * inv_scale;
+      }
+      else
+        for (ui32 x = 0; x < width; ++x, dp += stride)
+          *(float*)dp = (float)sp[x] * inv_scale;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    //
+    //
+    //                               codestream
+    //
+    //
+    //////////////////////////////////////////////////////////////////////////
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::check_region(const image_region& region,
+                                  const size* comp_dims, const char* name)
+    {
+      if (region.data == NULL || region.type > image_region::F32)
+        OJPH_ERROR(0x000300E1, "%s: the region has no data or an unknown "
+          "sample type", name);
+      for (ui32 c = 1; c < num_comps; ++c)
+        if (comp_dims[c].w != comp_dims[0].w ||
+            comp_dims[c].h != comp_dims[0].h)
+          OJPH_ERROR(0x000300E2, "%s requires all components to have the "
+            "same dimensions; use per-line calls for downsampled "
+            "components", name);
+      if (cur_comp != 0 || (planar && cur_line != 0))
+        OJPH_ERROR(0x000300E3, "%s must start at the beginning of a row of "
+          "component 0", name);
+      if (planar && region.num_rows != comp_dims[0].h)
+        OJPH_ERROR(0x000300E4, "%s: in planar mode, the region must hold "
+          "all %u rows of the image", name, comp_dims[0].h);
+      if (!planar && cur_line + region.num_rows > comp_dims[0].h)
+        OJPH_ERROR(0x000300E5, "%s: the region extends %u rows past the "
+          "end of the image", name,
+          cur_line + region.num_rows - comp_dims[0].h);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::region_row_to_line(const image_region& region,
+                                        ui32 comp_num, ui32 row,
+                                        line_buf* line)
+    {
+      const ui8* sp = (const ui8*)region.data
+        + (si64)row * region.row_stride
+        + (si64)comp_num * region.comp_stride;
+      si64 stride = region.sample_stride;
+      ui32 width = comp_size[comp_num].w;
+      switch (region.type)
+      {
+      case image_region::U8:
+        int_row_to_line<ui8>(sp, stride, line->i32, width); break;
+      case image_region::U16:
+        int_row_to_line<ui16>(sp, stride, line->i32, width); break;
+      case image_region::S16:
+        int_row_to_line<si16>(sp, stride, line->i32, width); break;
+      case image_region::S32:
+        int_row_to_line<si32>(sp, stride, line->i32, width); break;
+      case image_region::F32:
+        float_row_to_line(sp, stride, line->i32, width,
+          siz.get_bit_depth(comp_num), siz.is_signed(comp_num));
+        break;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::line_to_region_row(const line_buf* line,
+                                        const image_region& region,
+                                        ui32 comp_num, ui32 row)
+    {
+      ui8* dp = (ui8*)region.data
+        + (si64)row * region.row_stride
+        + (si64)comp_num * region.comp_stride;
+      si64 stride = region.sample_stride;
+      ui32 width = recon_comp_size[comp_num].w;
+      switch (region.type)
+      {
+      case image_region::U8:
+        line_to_int_row<ui8>(line->i32, dp, stride, width); break;
+      case image_region::U16:
+        line_to_int_row<ui16>(line->i32, dp, stride, width); break;
+      case image_region::S16:
+        line_to_int_row<si16>(line->i32, dp, stride, width); break;
+      case image_region::S32:
+        line_to_int_row<si32>(line->i32, dp, stride, width); break;
+      case image_region::F32:
+        line_to_float_row(line->i32, dp, stride, width,
+          siz.get_bit_depth(comp_num), siz.is_signed(comp_num));
+        break;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::push_region(const image_region& region)
+    {
+      if (outfile == NULL)
+        OJPH_ERROR(0x000300E6, "push_region can only be used for encoding, "
+          "after write_headers()");
+      check_region(region, comp_size, "push_region");
+
+      ui32 next_comp;
+      line_buf* line = exchange(NULL, next_comp);
+      if (planar)
+        for (ui32 c = 0; c < num_comps; ++c)
+          for (ui32 y = 0; y < region.num_rows; ++y)
+          {
+            assert(next_comp == c);
+            region_row_to_line(region, c, y, line);
+            line = exchange(line, next_comp);
+          }
+      else
+        for (ui32 y = 0; y < region.num_rows; ++y)
+          for (ui32 c = 0; c < num_comps; ++c)
+          {
+            assert(next_comp == c);
+            region_row_to_line(region, c, y, line);
+            line = exchange(line, next_comp);
+          }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::pull_region(const image_region& region)
+    {
+      if (infile == NULL || tiles == NULL)
+        OJPH_ERROR(0x000300E7, "pull_region can only be used for decoding, "
+          "after create()");
+      check_region(region, recon_comp_size, "pull_region");
+
+      ui32 comp_num;
+      if (planar)
+        for (ui32 c = 0; c < num_comps; ++c)
+          for (ui32 y = 0; y < region.num_rows; ++y)
+          {
+            line_buf* line = pull(comp_num);
+            assert(comp_num == c);
+            line_to_region_row(line, region, c, y);
+          }
+      else
+        for (ui32 y = 0; y < region.num_rows; ++y)
+          for (ui32 c = 0; c < num_comps; ++c)
+          {
+            line_buf* line = pull(comp_num);
+            assert(comp_num == c);
+            line_to_region_row(line, region, c, y);
+          }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::set_decode_target(const image_region* target)
+    {
+      if (target == NULL) {
+        // the tiles may have stored the rest of this row in the target
+        if (decode_target.data != NULL && !planar && cur_comp != 0)
+          OJPH_ERROR(0x000300E9, "set_decode_target: the target can only "
+            "be removed at the beginning of a row of component 0");
+        decode_target.data = NULL;
+        return;
+      }
+      if (infile == NULL || tiles == NULL)
+        OJPH_ERROR(0x000300E8, "set_decode_target can only be used for "
+          "decoding, after create()");
+      check_region(*target, recon_comp_size, "set_decode_target");
+      decode_target = *target;
+      target_first_line = cur_line;
+    }
+
+  }
+}
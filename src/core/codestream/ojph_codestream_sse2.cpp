@@ -77,6 +77,56 @@ namespace ojph {
       // return t;
     }    
 
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_rev_tx_to_cb16(const void *sp, ui32 *dp, ui32 K_max, 
+                             float delta_inv, ui32 count, ui32* max_val)
+    {
+      ojph_unused(delta_inv);
+
+      // convert to sign and magnitude and keep max_val      
+      ui32 shift = 31 - K_max;
+      __m128i m0 = _mm_set1_epi32(INT_MIN);
+      __m128i zero = _mm_setzero_si128();
+      __m128i one = _mm_set1_epi32(1);
+      __m128i tmax = _mm_loadu_si128((__m128i*)max_val);
+      const si16 *p = (const si16*)sp;
+      for ( ; count >= 4; count -= 4, p += 4, dp += 4)
+      {
+        __m128i v = _mm_loadl_epi64((__m128i*)p);
+        v = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16); // sign extend
+        __m128i sign = _mm_cmplt_epi32(v, zero);
+        __m128i val = _mm_xor_si128(v, sign); // negate 1's complement
+        __m128i ones = _mm_and_si128(sign, one);
+        val = _mm_add_epi32(val, ones);        // 2's complement
+        sign = _mm_and_si128(sign, m0);
+        val = _mm_slli_epi32(val, (int)shift);
+        tmax = _mm_or_si128(tmax, val);
+        val = _mm_or_si128(val, sign);
+        _mm_storeu_si128((__m128i*)dp, val);
+      }
+      if (count)
+      {
+        __m128i v = _mm_loadl_epi64((__m128i*)p);
+        v = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16); // sign extend
+        __m128i sign = _mm_cmplt_epi32(v, zero);
+        __m128i val = _mm_xor_si128(v, sign); // negate 1's complement
+        __m128i ones = _mm_and_si128(sign, one);
+        val = _mm_add_epi32(val, ones);        // 2's complement
+        sign = _mm_and_si128(sign, m0);
+        val = _mm_slli_epi32(val, (int)shift);
+
+        __m128i c = _mm_set1_epi32((si32)count);
+        __m128i idx = _mm_set_epi32(3, 2, 1, 0);
+        __m128i mask = _mm_cmpgt_epi32(c, idx);
+        c = _mm_and_si128(val, mask);
+        tmax = _mm_or_si128(tmax, c);
+
+        val = _mm_or_si128(val, sign);
+        _mm_storeu_si128((__m128i*)dp, val);
+      }
+      _mm_storeu_si128((__m128i*)max_val, tmax);
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void sse2_rev_tx_to_cb32(const void *sp, ui32 *dp, ui32 K_max, 
                              float delta_inv, ui32 count, ui32* max_val)
@@ -175,11 +225,45 @@ namespace ojph {
       _mm_storeu_si128((__m128i*)max_val, tmax);
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_rev_tx_from_cb16(const ui32 *sp, void *dp, ui32 K_max, 
+                               float delta, float gain, ui32 count)
+    {
+      ojph_unused(delta);
+      ojph_unused(gain);
+      ui32 shift = 31 - K_max;
+      __m128i m1 = _mm_set1_epi32(INT_MAX);
+      __m128i zero = _mm_setzero_si128();
+      __m128i one = _mm_set1_epi32(1);
+      si16 *p = (si16*)dp;
+      for (ui32 i = 0; i < count; i += 8, sp += 8, p += 8)
+      {
+        __m128i v = _mm_load_si128((__m128i*)sp);
+        __m128i val = _mm_and_si128(v, m1);
+        val = _mm_srli_epi32(val, (int)shift);
+        __m128i sign = _mm_cmplt_epi32(v, zero);
+        val = _mm_xor_si128(val, sign); // negate 1's complement
+        __m128i ones = _mm_and_si128(sign, one);
+        __m128i lo = _mm_add_epi32(val, ones); // 2's complement
+
+        v = _mm_load_si128((__m128i*)sp + 1);
+        val = _mm_and_si128(v, m1);
+        val = _mm_srli_epi32(val, (int)shift);
+        sign = _mm_cmplt_epi32(v, zero);
+        val = _mm_xor_si128(val, sign); // negate 1's complement
+        ones = _mm_and_si128(sign, one);
+        __m128i hi = _mm_add_epi32(val, ones); // 2's complement
+
+        _mm_storeu_si128((__m128i*)p, _mm_packs_epi32(lo, hi));
+      }
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void sse2_rev_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max, 
-                               float delta, ui32 count)
+                               float delta, float gain, ui32 count)
     {
       ojph_unused(delta);
+      ojph_unused(gain);
       ui32 shift = 31 - K_max;
       __m128i m1 = _mm_set1_epi32(INT_MAX);
       __m128i zero = _mm_setzero_si128();
@@ -200,18 +284,19 @@ namespace ojph {
 
     //////////////////////////////////////////////////////////////////////////
     void sse2_irv_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max, 
-                               float delta, ui32 count)
+                               float delta, float gain, ui32 count)
     {
       ojph_unused(K_max);
       __m128i m1 = _mm_set1_epi32(INT_MAX);
       __m128 d = _mm_set1_ps(delta);
+      __m128 g = _mm_set1_ps(gain);
       float *p = (float*)dp;
       for (ui32 i = 0; i < count; i += 4, sp += 4, p += 4)
       {
         __m128i v = _mm_load_si128((__m128i*)sp);
         __m128i vali = _mm_and_si128(v, m1);
         __m128  valf = _mm_cvtepi32_ps(vali);
-        valf = _mm_mul_ps(valf, d);
+        valf = _mm_mul_ps(_mm_mul_ps(valf, d), g);
         __m128i sign = _mm_andnot_si128(m1, v);
         valf = _mm_or_ps(valf, _mm_castsi128_ps(sign));
         _mm_storeu_ps(p, valf);
@@ -268,9 +353,10 @@ namespace ojph {
 
     //////////////////////////////////////////////////////////////////////////
     void sse2_rev_tx_from_cb64(const ui64 *sp, void *dp, ui32 K_max, 
-                               float delta, ui32 count)
+                               float delta, float gain, ui32 count)
     {
       ojph_unused(delta);
+      ojph_unused(gain);
       ui32 shift = 63 - K_max;
       __m128i m1 = _mm_set1_epi64x(LLONG_MAX);
       __m128i zero = _mm_setzero_si128();
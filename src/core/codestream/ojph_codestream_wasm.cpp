@@ -175,9 +175,10 @@ namespace ojph {
 
     //////////////////////////////////////////////////////////////////////////
     void wasm_rev_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max, 
-                               float delta, ui32 count)
+                               float delta, float gain, ui32 count)
     {
       ojph_unused(delta);
+      ojph_unused(gain);
       ui32 shift = 31 - K_max;
       v128_t m1 = wasm_i32x4_splat(INT_MAX);
       v128_t zero = wasm_i32x4_splat(0);
@@ -198,18 +199,19 @@ namespace ojph {
 
     //////////////////////////////////////////////////////////////////////////
     void wasm_irv_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max, 
-                               float delta, ui32 count)
+                               float delta, float gain, ui32 count)
     {
       ojph_unused(K_max);
       v128_t m1 = wasm_i32x4_splat(INT_MAX);
       v128_t d = wasm_f32x4_splat(delta);
+      v128_t g = wasm_f32x4_splat(gain);
       float *p = (float*)dp;
       for (ui32 i = 0; i < count; i += 4, sp += 4, p += 4)
       {
         v128_t v = wasm_v128_load((v128_t*)sp);
         v128_t vali = wasm_v128_and(v, m1);
         v128_t  valf = wasm_f32x4_convert_i32x4(vali);
-        valf = wasm_f32x4_mul(valf, d);
+        valf = wasm_f32x4_mul(wasm_f32x4_mul(valf, d), g);
         v128_t sign = wasm_v128_andnot(v, m1);
         valf = wasm_v128_or(valf, sign);
         wasm_v128_store(p, valf);
@@ -265,9 +267,10 @@ namespace ojph {
 
     //////////////////////////////////////////////////////////////////////////
     void wasm_rev_tx_from_cb64(const ui64 *sp, void *dp, ui32 K_max, 
-                               float delta, ui32 count)
+                               float delta, float gain, ui32 count)
     {
       ojph_unused(delta);
+      ojph_unused(gain);
       ui32 shift = 63 - K_max;
       v128_t m1 = wasm_i64x2_splat(LLONG_MAX);
       v128_t zero = wasm_i64x2_splat(0);
@@ -748,15 +748,17 @@ namespace ojph {
     }
 
     //////////////////////////////////////////////////////////////////////////
-    point param_siz::get_recon_downsampling(ui32 comp_num) const
+    point param_siz::get_recon_downsampling(ui32 comp_num,
+                                            ui32 levels) const
     {
       assert(comp_num < get_num_components());
 
-      point factor(1u << skipped_resolutions, 1u << skipped_resolutions);
+      ui32 skipped = skipped_resolutions + levels;
+      point factor(1u << skipped, 1u << skipped);
       const param_cod* cdp = cod->get_coc(comp_num);
       if (dfs && cdp && cdp->is_dfs_defined()) {
         const param_dfs* d = dfs->get_dfs(cdp->get_dfs_index());
-        factor = d->get_res_downsamp(skipped_resolutions);
+        factor = d->get_res_downsamp(skipped);
       }
       factor.x *= (ui32)cptr[comp_num].XRsiz;
       factor.y *= (ui32)cptr[comp_num].YRsiz;
@@ -764,11 +766,11 @@ namespace ojph {
     }
 
     //////////////////////////////////////////////////////////////////////////
-    point param_siz::get_recon_size(ui32 comp_num) const
+    point param_siz::get_recon_size(ui32 comp_num, ui32 levels) const
     {
       assert(comp_num < get_num_components());
 
-      point factor = get_recon_downsampling(comp_num);
+      point factor = get_recon_downsampling(comp_num, levels);
       point r;
       r.x = ojph_div_ceil(Xsiz, factor.x) - ojph_div_ceil(XOsiz, factor.x);
       r.y = ojph_div_ceil(Ysiz, factor.y) - ojph_div_ceil(YOsiz, factor.y);
@@ -278,8 +278,10 @@ namespace ojph {
         return t;
       }
 
-      point get_recon_downsampling(ui32 comp_num) const;
-      point get_recon_size(ui32 comp_num) const;
+      // levels are resolutions dropped beyond the skipped ones, for the
+      // lower resolutions of a pyramid output
+      point get_recon_downsampling(ui32 comp_num, ui32 levels = 0) const;
+      point get_recon_size(ui32 comp_num, ui32 levels = 0) const;
       ui32 get_recon_width(ui32 comp_num) const
       { return get_recon_size(comp_num).x; }
       ui32 get_recon_height(ui32 comp_num) const
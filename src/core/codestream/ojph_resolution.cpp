@@ -213,7 +213,13 @@ namespace ojph {
         ui32 width = res_rect.siz.w + 1;
         if (reversible)
         {
-          if (precision <= 32) {
+          if (use_16bit_rev_path(precision)) {
+            for (ui32 i = 0; i < num_steps; ++i)
+              allocator->pre_alloc_data<si16>(width, 1);
+            allocator->pre_alloc_data<si16>(width, 1);
+            allocator->pre_alloc_data<si16>(width, 1);
+          }
+          else if (precision <= 32) {
             for (ui32 i = 0; i < num_steps; ++i)
               allocator->pre_alloc_data<si32>(width, 1);
             allocator->pre_alloc_data<si32>(width, 1);
@@ -227,6 +233,12 @@ namespace ojph {
             allocator->pre_alloc_data<si64>(width, 1);
           }
         }
+        else if (codestream->uses_irv_fixed_point(comp_num)) {
+          for (ui32 i = 0; i < num_steps; ++i)
+            allocator->pre_alloc_data<si16>(width, 1);
+          allocator->pre_alloc_data<si16>(width, 1);
+          allocator->pre_alloc_data<si16>(width, 1);
+        }
         else {
           for (ui32 i = 0; i < num_steps; ++i)
             allocator->pre_alloc_data<float>(width, 1);
@@ -247,10 +259,17 @@ namespace ojph {
     {
       mem_fixed_allocator* allocator = codestream->get_allocator();
       elastic = codestream->get_elastic_alloc();
+#ifdef OJPH_ENABLE_STATS
+      stats = codestream->get_stats_collector();
+#endif
       const param_cod* cdp = codestream->get_coc(comp_num);
       ui32 t, num_decomps = cdp->get_num_decompositions();
       t = num_decomps - codestream->get_skipped_res_for_recon();
       skipped_res_for_recon = res_num > t;
+      pyramid_level = 0;
+      if (res_num < t &&
+          t - res_num <= parent_tile_comp->get_tile()->get_num_pyramid_levels())
+        pyramid_level = t - res_num;
       t = num_decomps - codestream->get_skipped_res_for_read();
       skipped_res_for_read = res_num > t;
 
@@ -487,7 +506,17 @@ namespace ojph {
         ui32 width = res_rect.siz.w + 1;
         if (this->reversible)
         {
-          if (precision <= 32)
+          if (use_16bit_rev_path(precision))
+          {
+            for (ui32 i = 0; i < num_steps; ++i)
+              ssp[i].line->wrap(
+                allocator->post_alloc_data<si16>(width, 1), width, 1);
+            sig->line->wrap(
+              allocator->post_alloc_data<si16>(width, 1), width, 1);
+            aug->line->wrap(
+              allocator->post_alloc_data<si16>(width, 1), width, 1);
+          }
+          else if (precision <= 32)
           {
             for (ui32 i = 0; i < num_steps; ++i)
               ssp[i].line->wrap(
@@ -508,6 +537,16 @@ namespace ojph {
               allocator->post_alloc_data<si64>(width, 1), width, 1);
           }
         }
+        else if (codestream->uses_irv_fixed_point(comp_num))
+        {
+            for (ui32 i = 0; i < num_steps; ++i)
+              ssp[i].line->wrap(
+                allocator->post_alloc_data<si16>(width, 1), width, 1);
+            sig->line->wrap(
+              allocator->post_alloc_data<si16>(width, 1), width, 1);
+            aug->line->wrap(
+              allocator->post_alloc_data<si16>(width, 1), width, 1);
+        }
         else 
         {
             for (ui32 i = 0; i < num_steps; ++i)
@@ -526,6 +565,134 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    // The vertical lifting steps needed to produce a pair of lines depend 
+    // only on which lines are active, not on sample values.  They are 
+    // therefore recorded first, and then applied to one column strip at a
+    // time, so that the strips of all involved lines stay in cache for all
+    // steps; applying each step to whole lines streams wide lines through
+    // the cache once per step.  A strip is 4kB of each line, so that the 
+    // six lines of the 9/7 wavelet take 24kB, and is a multiple of the 
+    // widest SIMD vector, so that no kernel writes beyond its strip.  Lines
+    // that are only a few strips wide stay in cache anyway; for them, the
+    // steps are applied to whole lines.
+    static const ui32 vert_strip_bytes = 4096;
+    static const ui32 max_fused_steps = 8;
+
+    //////////////////////////////////////////////////////////////////////////
+    static inline 
+    void get_strip(line_buf& dst, const line_buf* src, ui32 x)
+    {
+      dst = *src;
+      if (src->flags & line_buf::LFT_16BIT)
+        dst.i16 = src->i16 + x;
+      else if (src->flags & line_buf::LFT_32BIT)
+        dst.i32 = src->i32 + x;
+      else
+      {
+        assert(src->flags & line_buf::LFT_64BIT);
+        dst.i64 = src->i64 + x;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void resolution::vert_lift(ui32 width, bool synthesis)
+    {
+      void (*vert_step)(const lifting_step*, const line_buf*,
+        const line_buf*, const line_buf*, ui32, bool);
+      void (*vert_times_K)(float, const line_buf*, ui32) = NULL;
+      if (reversible)
+        vert_step = rev_vert_step;
+      else if (aug->line->flags & line_buf::LFT_16BIT) { // fixed-point
+        vert_step = irv_fix_vert_step;
+        vert_times_K = irv_fix_vert_times_K;
+      }
+      else {
+        vert_step = irv_vert_step;
+        vert_times_K = irv_vert_times_K;
+      }
+
+      struct lift_op {
+        const lifting_step* s;
+        const line_buf *sp1, *sp2, *dp;
+      };
+      lift_op ops[max_fused_steps];
+      ui32 num_ops = 0;
+      ui32 strip_size = vert_strip_bytes 
+        / (aug->line->flags & line_buf::LFT_SIZE_MASK);
+      bool fuse = width > 4 * strip_size && num_steps <= max_fused_steps;
+
+      for (ui32 i = 0; i < num_steps; ++i)
+      {
+        if (aug->active && (sig->active || ssp[i].active))
+        {
+          line_buf* dp = aug->line;
+          line_buf* sp1 = sig->active ? sig->line : ssp[i].line;
+          line_buf* sp2 = ssp[i].active ? ssp[i].line : sig->line;
+          const lifting_step* s = 
+            atk->get_step(synthesis ? i : num_steps - i - 1);
+          if (fuse) {
+            lift_op& op = ops[num_ops++];
+            op.s = s; op.sp1 = sp1; op.sp2 = sp2; op.dp = dp;
+          }
+          else
+            vert_step(s, sp1, sp2, dp, width, synthesis);
+        }
+        lifting_buf t = *aug; *aug = ssp[i]; ssp[i] = *sig; *sig = t;
+      }
+
+      // for analysis, the irreversible path normalizes the produced lines;
+      // this is done here to fuse it with the lifting steps
+      bool scale = !reversible && !synthesis;
+      const float K = scale ? atk->get_K() : 1.0f;
+      const float K_inv = 1.0f / K;
+
+      if (!fuse)
+      {
+        if (scale && aug->active)
+          vert_times_K(K, aug->line, width);
+        if (scale && sig->active)
+          vert_times_K(K_inv, sig->line, width);
+        return;
+      }
+
+      for (ui32 x = 0; x < width; x += strip_size)
+      {
+        ui32 w = ojph_min(strip_size, width - x);
+        line_buf sp1, sp2, dp;
+        for (ui32 i = 0; i < num_ops; ++i)
+        {
+          get_strip(sp1, ops[i].sp1, x);
+          get_strip(sp2, ops[i].sp2, x);
+          get_strip(dp, ops[i].dp, x);
+          vert_step(ops[i].s, &sp1, &sp2, &dp, w, synthesis);
+        }
+        if (scale && aug->active) {
+          get_strip(dp, aug->line, x);
+          vert_times_K(K, &dp, w);
+        }
+        if (scale && sig->active) {
+          get_strip(dp, sig->line, x);
+          vert_times_K(K_inv, &dp, w);
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    float resolution::get_band_gain(ui32 band_num) const
+    {
+      // irv_horz_syn multiplies its low-pass input by K and its high-pass
+      // input by 1/K; for bands 1 to 3 this is done when they are
+      // dequantised, which saves a pass over their samples.  Band 0 comes
+      // from the child resolution, and horz_syn still scales it.
+      if (band_num == 0 || skipped_res_for_recon)
+        return 1.0f;
+      if (!(transform_flags & HORZ_TRX) || res_rect.siz.w <= 1)
+        return 1.0f;
+      const float K = atk->get_K();
+      return (band_num & 1) ? 1.0f / K : K;
+    }
+
     //////////////////////////////////////////////////////////////////////////
     line_buf* resolution::get_line()
     { 
@@ -554,6 +721,8 @@ namespace ojph {
         return;
       }
 
+      OJPH_STATS_SCOPE(stats, codestream_stats::DWT + res_num);
+      OJPH_TRACE_SCOPE(stats, "dwt", -1, (si32)comp_num, (si32)res_num, -1);
       ui32 width = res_rect.siz.w;
       if (width == 0)
         return;
@@ -569,18 +738,7 @@ namespace ojph {
           do
           {
             //vertical transform
-            for (ui32 i = 0; i < num_steps; ++i)
-            {
-              if (aug->active && (sig->active || ssp[i].active))
-              {
-                line_buf* dp = aug->line;
-                line_buf* sp1 = sig->active ? sig->line : ssp[i].line;
-                line_buf* sp2 = ssp[i].active ? ssp[i].line : sig->line;
-                const lifting_step* s = atk->get_step(num_steps - i - 1);
-                rev_vert_step(s, sp1, sp2, dp, width, false);
-              }
-              lifting_buf t = *aug; *aug = ssp[i]; ssp[i] = *sig; *sig = t;
-            }
+            vert_lift(width, false);
 
             if (aug->active) {
               rev_horz_ana(atk, bands[2].get_line(),
@@ -613,7 +771,13 @@ namespace ojph {
           else
           {
             // vertical transform
-            if (aug->line->flags & line_buf::LFT_32BIT)
+            if (aug->line->flags & line_buf::LFT_16BIT)
+            {
+              si16* sp = aug->line->i16;
+              for (ui32 i = width; i > 0; --i, ++sp)
+                *sp = (si16)(*sp << 1);
+            }
+            else if (aug->line->flags & line_buf::LFT_32BIT)
             {
               si32* sp = aug->line->i32;
               for (ui32 i = width; i > 0; --i)
@@ -636,6 +800,12 @@ namespace ojph {
       }
       else
       {
+        // 16-bit lines carry fixed-point samples
+        bool fix16 = (aug->line->flags & line_buf::LFT_16BIT) != 0;
+        void (*horz_ana)(const param_atk*, const line_buf*, const line_buf*,
+          const line_buf*, ui32, bool)
+          = fix16 ? irv_fix_horz_ana : irv_horz_ana;
+
         if (res_rect.siz.h > 1)
         {
           if (!vert_even && cur_line < res_rect.siz.h) {
@@ -645,25 +815,11 @@ namespace ojph {
 
           do
           {
-            //vertical transform
-            for (ui32 i = 0; i < num_steps; ++i)
-            {
-              if (aug->active && (sig->active || ssp[i].active))
-              {
-                line_buf* dp = aug->line;
-                line_buf* sp1 = sig->active ? sig->line : ssp[i].line;
-                line_buf* sp2 = ssp[i].active ? ssp[i].line : sig->line;
-                const lifting_step* s = atk->get_step(num_steps - i - 1);
-                irv_vert_step(s, sp1, sp2, dp, width, false);
-              }
-              lifting_buf t = *aug; *aug = ssp[i]; ssp[i] = *sig; *sig = t;
-            }
+            //vertical transform, including normalization
+            vert_lift(width, false);
 
             if (aug->active) {
-              const float K = atk->get_K();
-              irv_vert_times_K(K, aug->line, width);
-
-              irv_horz_ana(atk, bands[2].get_line(),
+              horz_ana(atk, bands[2].get_line(),
                 bands[3].get_line(), aug->line, width, horz_even);
               bands[2].push_line();
               bands[3].push_line();
@@ -671,10 +827,7 @@ namespace ojph {
               --rows_to_produce;
             }
             if (sig->active) {
-              const float K_inv = 1.0f / atk->get_K();
-              irv_vert_times_K(K_inv, sig->line, width);
-
-              irv_horz_ana(atk, child_res->get_line(),
+              horz_ana(atk, child_res->get_line(),
                 bands[1].get_line(), sig->line, width, horz_even);
               bands[1].push_line();
               child_res->push_line();
@@ -688,7 +841,7 @@ namespace ojph {
         {
           if (vert_even) {
             // horizontal transform
-            irv_horz_ana(atk, child_res->get_line(),
+            horz_ana(atk, child_res->get_line(),
               bands[1].get_line(), sig->line, width, horz_even);
             bands[1].push_line();
             child_res->push_line();
@@ -696,11 +849,20 @@ namespace ojph {
           else
           {
             // vertical transform
-            float* sp = aug->line->f32;
-            for (ui32 i = width; i > 0; --i)
-              *sp++ *= 2.0f;
+            if (fix16)
+            {
+              si16* sp = aug->line->i16;
+              for (ui32 i = width; i > 0; --i, ++sp)
+                *sp = (si16)ojph_max(-32768, ojph_min(32767, *sp * 2));
+            }
+            else
+            {
+              float* sp = aug->line->f32;
+              for (ui32 i = width; i > 0; --i)
+                *sp++ *= 2.0f;
+            }
             // horizontal transform
-            irv_horz_ana(atk, bands[2].get_line(),
+            horz_ana(atk, bands[2].get_line(),
               bands[3].get_line(), aug->line, width, horz_even);
             bands[2].push_line();
             bands[3].push_line();
@@ -711,6 +873,16 @@ namespace ojph {
 
     //////////////////////////////////////////////////////////////////////////
     line_buf* resolution::pull_line()
+    {
+      line_buf* line = synthesize_line();
+      if (pyramid_level != 0 && line != NULL)
+        parent_comp->get_tile()->push_pyramid_line(pyramid_level, comp_num,
+          line);
+      return line;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    line_buf* resolution::synthesize_line()
     {
       if (res_num == 0)
       {
@@ -721,6 +893,8 @@ namespace ojph {
       if (skipped_res_for_recon == true)
         return child_res->pull_line();
 
+      OJPH_STATS_SCOPE(stats, codestream_stats::DWT + res_num);
+      OJPH_TRACE_SCOPE(stats, "dwt", -1, (si32)comp_num, (si32)res_num, -1);
       ui32 width = res_rect.siz.w;
       if (width == 0)
         return NULL;
@@ -768,18 +942,7 @@ namespace ojph {
               }
 
               //vertical transform
-              for (ui32 i = 0; i < num_steps; ++i)
-              {
-                if (aug->active && (sig->active || ssp[i].active))
-                {
-                  line_buf* dp = aug->line;
-                  line_buf* sp1 = sig->active ? sig->line : ssp[i].line;
-                  line_buf* sp2 = ssp[i].active ? ssp[i].line : sig->line;
-                  const lifting_step* s = atk->get_step(i);
-                  rev_vert_step(s, sp1, sp2, dp, width, true);
-                }
-                lifting_buf t = *aug; *aug = ssp[i]; ssp[i] = *sig; *sig = t;
-              }
+              vert_lift(width, true);
 
               if (aug->active) {
                 aug->active = false;
@@ -811,7 +974,13 @@ namespace ojph {
                 memcpy(aug->line->p, bands[2].pull_line()->p,
                   (size_t)width 
                   * (aug->line->flags & line_buf::LFT_SIZE_MASK));
-              if (aug->line->flags & line_buf::LFT_32BIT)
+              if (aug->line->flags & line_buf::LFT_16BIT)
+              {
+                si16* sp = aug->line->i16;
+                for (ui32 i = width; i > 0; --i, ++sp)
+                  *sp = (si16)(*sp >> 1);
+              }
+              else if (aug->line->flags & line_buf::LFT_32BIT)
               {
                 si32* sp = aug->line->i32;                
                 for (ui32 i = width; i > 0; --i)
@@ -844,7 +1013,7 @@ namespace ojph {
                 if (vert_even) { // even
                   if (transform_flags & HORZ_TRX)
                     irv_horz_syn(atk, aug->line, child_res->pull_line(), 
-                      bands[1].pull_line(), width, horz_even);
+                      bands[1].pull_line(), width, horz_even, true);
                   else 
                     memcpy(aug->line->f32, child_res->pull_line()->f32,
                       width * sizeof(float));
@@ -860,7 +1029,7 @@ namespace ojph {
                 else {
                   if (transform_flags & HORZ_TRX)
                     irv_horz_syn(atk, sig->line, bands[2].pull_line(), 
-                      bands[3].pull_line(), width, horz_even);
+                      bands[3].pull_line(), width, horz_even, false);
                   else
                     memcpy(sig->line->f32, bands[2].pull_line()->f32,
                       width * sizeof(float));
@@ -874,18 +1043,7 @@ namespace ojph {
               }
 
               //vertical transform
-              for (ui32 i = 0; i < num_steps; ++i)
-              {
-                if (aug->active && (sig->active || ssp[i].active))
-                {
-                  line_buf* dp = aug->line;
-                  line_buf* sp1 = sig->active ? sig->line : ssp[i].line;
-                  line_buf* sp2 = ssp[i].active ? ssp[i].line : sig->line;
-                  const lifting_step* s = atk->get_step(i);
-                  irv_vert_step(s, sp1, sp2, dp, width, true);
-                }
-                lifting_buf t = *aug; *aug = ssp[i]; ssp[i] = *sig; *sig = t;
-              }
+              vert_lift(width, true);
 
               if (aug->active) {
                 aug->active = false;
@@ -902,7 +1060,7 @@ namespace ojph {
             if (vert_even) {
               if (transform_flags & HORZ_TRX)
                 irv_horz_syn(atk, aug->line, child_res->pull_line(),
-                  bands[1].pull_line(), width, horz_even);
+                  bands[1].pull_line(), width, horz_even, true);
               else
                 memcpy(aug->line->f32, child_res->pull_line()->f32,
                   width * sizeof(float));
@@ -911,7 +1069,7 @@ namespace ojph {
             {
               if (transform_flags & HORZ_TRX)
                 irv_horz_syn(atk, aug->line, bands[2].pull_line(),
-                  bands[3].pull_line(), width, horz_even);
+                  bands[3].pull_line(), width, horz_even, false);
              else
                 memcpy(aug->line->f32, bands[2].pull_line()->f32,
                   width * sizeof(float));
@@ -939,7 +1097,7 @@ namespace ojph {
         {
           if (transform_flags & HORZ_TRX)
             irv_horz_syn(atk, aug->line, child_res->pull_line(),
-              bands[1].pull_line(), width, horz_even);
+              bands[1].pull_line(), width, horz_even, true);
           else
             memcpy(aug->line->f32, child_res->pull_line()->f32,
               width * sizeof(float));
@@ -966,9 +1124,14 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void resolution::write_precincts(outfile_base* file)
     {
+      OJPH_TRACE_SCOPE(stats, "precincts write", -1, (si32)comp_num,
+        (si32)res_num, -1);
       precinct* p = precincts;
       for (si32 i = 0; i < (si32)num_precincts.area(); ++i)
+      {
+        OJPH_STATS_SCOPE(stats, codestream_stats::PRECINCT_WRITE);
         p[i].write(file);
+      }
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -988,7 +1151,12 @@ namespace ojph {
     {
       ui32 idx = cur_precinct_loc.x + cur_precinct_loc.y * num_precincts.w;
       assert(idx < num_precincts.area());
-      precincts[idx].write(file);
+      {
+        OJPH_STATS_SCOPE(stats, codestream_stats::PRECINCT_WRITE);
+        OJPH_TRACE_SCOPE(stats, "precincts write", -1, (si32)comp_num,
+          (si32)res_num, -1);
+        precincts[idx].write(file);
+      }
 
       if (++cur_precinct_loc.x >= num_precincts.w)
       {
@@ -1000,14 +1168,19 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void resolution::parse_all_precincts(ui32& data_left, infile_base* file)
     {
+      OJPH_TRACE_SCOPE(stats, "precincts parse", -1, (si32)comp_num,
+        (si32)res_num, -1);
       precinct* p = precincts;
       ui32 idx = cur_precinct_loc.x + cur_precinct_loc.y * num_precincts.w;
       for (ui32 i = idx; i < num_precincts.area(); ++i)
       {
         if (data_left == 0)
           break;
-        p[i].parse(tag_tree_size, level_index, elastic, data_left, file,
-          skipped_res_for_read);
+        {
+          OJPH_STATS_SCOPE(stats, codestream_stats::PRECINCT_PARSE);
+          p[i].parse(tag_tree_size, level_index, elastic, data_left, file,
+            skipped_res_for_read);
+        }
         if (++cur_precinct_loc.x >= num_precincts.w)
         {
           cur_precinct_loc.x = 0;
@@ -1025,8 +1198,13 @@ namespace ojph {
       if (data_left == 0)
         return;
       precinct* p = precincts + idx;
-      p->parse(tag_tree_size, level_index, elastic, data_left, file,
-        skipped_res_for_read);
+      {
+        OJPH_STATS_SCOPE(stats, codestream_stats::PRECINCT_PARSE);
+        OJPH_TRACE_SCOPE(stats, "precincts parse", -1, (si32)comp_num,
+          (si32)res_num, -1);
+        p->parse(tag_tree_size, level_index, elastic, data_left, file,
+          skipped_res_for_read);
+      }
       if (++cur_precinct_loc.x >= num_precincts.w)
       {
         cur_precinct_loc.x = 0;
@@ -56,6 +56,7 @@ namespace ojph {
     class tile_comp;
     struct precinct;
     class subband;
+    class stats_collector;
 
     //////////////////////////////////////////////////////////////////////////
     class resolution
@@ -83,6 +84,7 @@ namespace ojph {
       ui32 get_comp_num() { return comp_num; }
       bool has_horz_transform() { return (transform_flags & HORZ_TRX) != 0; }
       bool has_vert_transform() { return (transform_flags & VERT_TRX) != 0; }
+      float get_band_gain(ui32 band_num) const;
 
       ui32 prepare_precinct();
       void write_precincts(outfile_base *file);
@@ -95,6 +97,10 @@ namespace ojph {
       ui32 get_num_bytes() const { return num_bytes; }
       ui32 get_num_bytes(ui32 resolution_num) const;
 
+    private:
+      line_buf* synthesize_line();
+      void vert_lift(ui32 width, bool synthesis);
+
     private:
       bool reversible, skipped_res_for_read, skipped_res_for_recon;
       ui32 num_steps;
@@ -125,6 +131,10 @@ namespace ojph {
       ui32 rows_to_produce;
       bool vert_even, horz_even;
       mem_elastic_allocator *elastic;
+      ui32 pyramid_level;      // non-zero if our lines go to a pyramid
+#ifdef OJPH_ENABLE_STATS
+      stats_collector *stats;
+#endif
     };
 
   }
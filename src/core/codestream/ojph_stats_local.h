@@ -0,0 +1,246 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// 
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_stats_local.h
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+
+#ifndef OJPH_STATS_LOCAL_H
+#define OJPH_STATS_LOCAL_H
+
+#include <cstring>
+
+#include "ojph_defs.h"
+#include "ojph_file.h"
+#include "ojph_codestream.h"
+#include "ojph_trace.h"
+
+namespace ojph {
+  namespace local {
+
+    //////////////////////////////////////////////////////////////////////////
+    // Accumulates per-stage time for a codestream.  Only one stage is
+    // active at any time; entering a stage charges the time elapsed so far
+    // to the stage that was active, and leaving it charges the elapsed time
+    // to the stage being left and reactivates the previous one.  This way,
+    // times are exclusive, and nesting needs no bookkeeping by the callers.
+    //
+    // The collector also holds the trace sink, if any, that receives the
+    // events recorded with OJPH_TRACE_SCOPE.
+    //
+    // When OJPH_ENABLE_STATS is not defined, only the (zeroed) statistics
+    // are kept, and OJPH_STATS_SCOPE and OJPH_TRACE_SCOPE expand to
+    // nothing.
+    class stats_collector
+    {
+    public:
+      enum : ui32 { NO_STAGE = codestream_stats::NUM_STAGES };
+
+    public:
+#ifdef OJPH_ENABLE_STATS
+      stats_collector() : trace(NULL) { reset(); }
+#else
+      stats_collector() { reset(); }
+#endif
+
+      void reset()
+      {
+        memset(&stats, 0, sizeof(stats));
+#ifdef OJPH_ENABLE_STATS
+        stats.enabled = true;
+        cur_stage = NO_STAGE;
+        last_ns = 0;
+#endif
+      }
+
+      const codestream_stats& get() const { return stats; }
+
+#ifdef OJPH_ENABLE_STATS
+      void set_trace(trace_sink* trace) { this->trace = trace; }
+      trace_sink* get_trace() const { return trace; }
+
+      ui32 enter(ui32 stage)
+      {
+        charge();
+        ui32 prev_stage = cur_stage;
+        cur_stage = stage;
+        ++stats.num_calls[stage];
+        return prev_stage;
+      }
+
+      void leave(ui32 prev_stage)
+      {
+        charge();
+        cur_stage = prev_stage;
+      }
+
+    private:
+      void charge()
+      {
+        ui64 now = trace_sink::now_ns();
+        if (cur_stage != NO_STAGE)
+          stats.time_ns[cur_stage] += now - last_ns;
+        last_ns = now;
+      }
+
+    private:
+      ui32 cur_stage;
+      ui64 last_ns;
+      trace_sink* trace;
+#else
+      void set_trace(trace_sink*) {}
+#endif
+
+    private:
+      codestream_stats stats;
+    };
+
+#ifdef OJPH_ENABLE_STATS
+
+    //////////////////////////////////////////////////////////////////////////
+    // Charges the time between construction and destruction to one stage
+    class stats_scope
+    {
+    public:
+      stats_scope(stats_collector* collector, ui32 stage)
+      : collector(collector), prev_stage(collector->enter(stage)) {}
+      ~stats_scope() { collector->leave(prev_stage); }
+
+    private:
+      stats_collector* collector;
+      ui32 prev_stage;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    // Records one trace event spanning its lifetime, if there is a sink
+    class trace_scope
+    {
+    public:
+      trace_scope(stats_collector* collector, const char* name, si32 tile,
+                  si32 comp, si32 res, si32 row)
+      : trace(collector->get_trace()), name(name), tile(tile), comp(comp),
+        res(res), row(row)
+      { begin_ns = trace ? trace_sink::now_ns() : 0; }
+      ~trace_scope()
+      {
+        if (trace)
+          trace->add_event(name, begin_ns, trace_sink::now_ns(),
+            tile, comp, res, row);
+      }
+
+    private:
+      trace_sink* trace;
+      const char* name;
+      si32 tile, comp, res, row;
+      ui64 begin_ns;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    // Wraps the user's outfile so that writing is charged to FILE_IO
+    class stats_outfile : public outfile_base
+    {
+    public:
+      stats_outfile() : file(NULL), collector(NULL) {}
+      void wrap(outfile_base* file, stats_collector* collector)
+      { this->file = file; this->collector = collector; }
+
+      size_t write(const void *ptr, size_t size) override
+      {
+        stats_scope s(collector, codestream_stats::FILE_IO);
+        return file->write(ptr, size);
+      }
+      si64 tell() override { return file->tell(); }
+      int seek(si64 offset, enum outfile_base::seek origin) override
+      {
+        stats_scope s(collector, codestream_stats::FILE_IO);
+        return file->seek(offset, origin);
+      }
+      void flush() override
+      {
+        stats_scope s(collector, codestream_stats::FILE_IO);
+        file->flush();
+      }
+      void close() override { file->close(); }
+
+    private:
+      outfile_base* file;
+      stats_collector* collector;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    // Wraps the user's infile so that reading is charged to FILE_IO
+    class stats_infile : public infile_base
+    {
+    public:
+      stats_infile() : file(NULL), collector(NULL) {}
+      void wrap(infile_base* file, stats_collector* collector)
+      { this->file = file; this->collector = collector; }
+
+      size_t read(void *ptr, size_t size) override
+      {
+        stats_scope s(collector, codestream_stats::FILE_IO);
+        return file->read(ptr, size);
+      }
+      int seek(si64 offset, enum infile_base::seek origin) override
+      {
+        stats_scope s(collector, codestream_stats::FILE_IO);
+        return file->seek(offset, origin);
+      }
+      si64 tell() override { return file->tell(); }
+      bool eof() override { return file->eof(); }
+      void close() override { file->close(); }
+
+    private:
+      infile_base* file;
+      stats_collector* collector;
+    };
+
+#define OJPH_STATS_CONCAT_(a, b) a##b
+#define OJPH_STATS_CONCAT(a, b) OJPH_STATS_CONCAT_(a, b)
+#define OJPH_STATS_SCOPE(collector, stage)                                   \
+  ojph::local::stats_scope OJPH_STATS_CONCAT(ojph_stats_scope_, __LINE__)    \
+    (collector, stage)
+#define OJPH_TRACE_SCOPE(collector, name, tile, comp, res, row)              \
+  ojph::local::trace_scope OJPH_STATS_CONCAT(ojph_trace_scope_, __LINE__)    \
+    (collector, name, tile, comp, res, row)
+
+#else // !OJPH_ENABLE_STATS
+
+#define OJPH_STATS_SCOPE(collector, stage)
+#define OJPH_TRACE_SCOPE(collector, name, tile, comp, res, row)
+
+#endif // !OJPH_ENABLE_STATS
+
+  }
+}
+
+#endif // !OJPH_STATS_LOCAL_H
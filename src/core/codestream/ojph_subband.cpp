@@ -47,6 +47,9 @@
 #include "ojph_resolution.h"
 #include "ojph_codeblock.h"
 #include "ojph_precinct.h"
+#include "ojph_block_scheduler.h"
+
+#include "../transform/ojph_transform.h"
 
 namespace ojph {
 
@@ -104,11 +107,15 @@ namespace ojph {
       ui32 width = band_rect.siz.w + 1;
       if (reversible)
       {
-        if (precision <= 32)
+        if (use_16bit_rev_path(precision))
+          allocator->pre_alloc_data<si16>(width, 1);
+        else if (precision <= 32)
           allocator->pre_alloc_data<si32>(width, 1);
         else
           allocator->pre_alloc_data<si64>(width, 1);
       }
+      else if (codestream->uses_irv_fixed_point(comp_num))
+        allocator->pre_alloc_data<si16>(width, 1);
       else
         allocator->pre_alloc_data<float>(width, 1);
     }
@@ -121,6 +128,10 @@ namespace ojph {
     {
       mem_fixed_allocator* allocator = codestream->get_allocator();
       elastic = codestream->get_elastic_alloc();
+      scheduler = codestream->get_block_scheduler();
+#ifdef OJPH_ENABLE_STATS
+      stats = codestream->get_stats_collector();
+#endif
 
       this->res_num = res_num;
       this->band_num = subband_num;
@@ -160,6 +171,7 @@ namespace ojph {
         d /= (float)(1u << (31 - this->K_max));
         delta = d;
         delta_inv = (1.0f/d);
+        gain = parent->get_band_gain(subband_num);
       }
       ui32 precision = qcd->propose_precision(cdp);
 
@@ -210,11 +222,15 @@ namespace ojph {
       ui32 width = band_rect.siz.w + 1;
       if (reversible)
       {
-        if (precision <= 32)      
+        if (use_16bit_rev_path(precision))
+          lines->wrap(allocator->post_alloc_data<si16>(width, 1), width, 1);
+        else if (precision <= 32)      
           lines->wrap(allocator->post_alloc_data<si32>(width, 1), width, 1);
         else
           lines->wrap(allocator->post_alloc_data<si64>(width, 1), width, 1);
       }
+      else if (codestream->uses_irv_fixed_point(comp_num))
+        lines->wrap(allocator->post_alloc_data<si16>(width, 1), width, 1);
       else
         lines->wrap(allocator->post_alloc_data<float>(width, 1), width, 1);
     }
@@ -293,13 +309,27 @@ namespace ojph {
       if (empty)
         return;
 
+      OJPH_STATS_SCOPE(stats, codestream_stats::CB_TRANSFER);
       //push to codeblocks
       for (ui32 i = 0; i < num_blocks.w; ++i)
         blocks[i].push(lines + 0);
       if (++cur_line >= cur_cb_height)
       {
-        for (ui32 i = 0; i < num_blocks.w; ++i)
-          blocks[i].encode(elastic);
+        {
+          OJPH_TRACE_SCOPE(stats, "cb row encode", -1,
+            (si32)parent->get_comp_num(), (si32)res_num, (si32)cur_cb_row);
+          if (scheduler && num_blocks.w > 1)
+          {
+            OJPH_STATS_SCOPE(stats, codestream_stats::CB_ENCODE);
+            scheduler->encode_row(blocks, num_blocks.w, elastic);
+          }
+          else
+            for (ui32 i = 0; i < num_blocks.w; ++i)
+            {
+              OJPH_STATS_SCOPE(stats, codestream_stats::CB_ENCODE);
+              blocks[i].encode(elastic);
+            }
+        }
 
         if (++cur_cb_row < num_blocks.h)
         {
@@ -337,11 +367,14 @@ namespace ojph {
       if (empty)
         return lines;
 
+      OJPH_STATS_SCOPE(stats, codestream_stats::CB_TRANSFER);
       //pull from codeblocks
       if (--cur_line <= 0)
       {
         if (cur_cb_row < num_blocks.h)
         {
+          OJPH_TRACE_SCOPE(stats, "cb row decode", -1,
+            (si32)parent->get_comp_num(), (si32)res_num, (si32)cur_cb_row);
           ui32 tbx0 = band_rect.org.x;
           ui32 tby0 = band_rect.org.y;
           ui32 tbx1 = band_rect.org.x + band_rect.siz.w;
@@ -363,7 +396,16 @@ namespace ojph {
             cb_size.w = cbx1 - cbx0;
             blocks[i].recreate(cb_size,
                                coded_cbs + i + cur_cb_row * num_blocks.w);
-            blocks[i].decode();
+            if (scheduler == NULL || num_blocks.w == 1)
+            {
+              OJPH_STATS_SCOPE(stats, codestream_stats::CB_DECODE);
+              blocks[i].decode();
+            }
+          }
+          if (scheduler && num_blocks.w > 1)
+          {
+            OJPH_STATS_SCOPE(stats, codestream_stats::CB_DECODE);
+            scheduler->decode_row(blocks, num_blocks.w);
           }
           ++cur_cb_row;
         }
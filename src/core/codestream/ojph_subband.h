@@ -56,6 +56,8 @@ namespace ojph {
     class resolution;
     struct precinct;
     class codeblock;
+    class stats_collector;
+    class block_scheduler;
     struct coded_cb_header;
   
   //////////////////////////////////////////////////////////////////////////
@@ -75,9 +77,11 @@ namespace ojph {
         cur_line = 0;
         cur_cb_height = 0;
         delta = delta_inv = 0.0f;
+        gain = 1.0f;
         K_max = 0;
         coded_cbs = NULL;
         elastic = NULL;
+        scheduler = NULL;
       }
 
       static void pre_alloc(codestream *codestream, const rect& band_rect,
@@ -91,6 +95,7 @@ namespace ojph {
 
       void get_cb_indices(const size& num_precincts, precinct *precincts);
       float get_delta() { return delta; }
+      float get_gain() { return gain; }
       bool exists() { return !empty; }
 
       line_buf* pull_line();
@@ -113,9 +118,15 @@ namespace ojph {
       int cur_line;
       int cur_cb_height;
       float delta, delta_inv;
+      float gain;                  // the first synthesis step's K or 1/K,
+                                   // applied when dequantising
       ui32 K_max;
       coded_cb_header *coded_cbs;
       mem_elastic_allocator *elastic;
+      block_scheduler *scheduler;  // runs codeblocks on an executor, or NULL
+#ifdef OJPH_ENABLE_STATS
+      stats_collector *stats;
+#endif
     };
 
   }
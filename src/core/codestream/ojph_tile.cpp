@@ -38,6 +38,7 @@
 
 #include <climits>
 #include <cmath>
+#include <cstring>
 
 #include "ojph_mem.h"
 #include "ojph_params.h"
@@ -46,6 +47,7 @@
 #include "ojph_tile_comp.h"
 
 #include "../transform/ojph_colour.h"
+#include "../transform/ojph_colour_local.h"
 
 namespace ojph {
 
@@ -71,6 +73,11 @@ namespace ojph {
       allocator->pre_alloc_obj<ui8>(num_comps);  //for nlt_type3
       allocator->pre_alloc_obj<ui32>(num_comps); //for cur_line
 
+      ui32 num_pyr_levels = codestream->get_pyramid_levels();
+      allocator->pre_alloc_obj<point>(num_pyr_levels * num_comps);
+      allocator->pre_alloc_obj<ui32>(num_pyr_levels * num_comps);
+      allocator->pre_alloc_obj<ui32>(num_pyr_levels * num_comps);
+
       {
         ui32 tilepart_div = codestream->get_tilepart_div();
         ui32 t = tilepart_div & OJPH_TILEPART_MASK;
@@ -161,9 +168,39 @@ namespace ojph {
         if (reversible[0])
           for (int i = 0; i < 3; ++i)
             allocator->pre_alloc_data<si32>(width, 0);
+        else if (codestream->uses_irv_fixed_point(0))
+          for (int i = 0; i < 3; ++i)
+            allocator->pre_alloc_data<si16>(width, 0);
         else
           for (int i = 0; i < 3; ++i)
             allocator->pre_alloc_data<float>(width, 0);
+
+        if (num_pyr_levels > 0)
+        {
+          allocator->pre_alloc_obj<line_buf*>(num_pyr_levels * 3);
+          allocator->pre_alloc_obj<ui32>(num_pyr_levels);
+          allocator->pre_alloc_obj<line_buf>(3);
+          for (ui32 l = 1; l <= num_pyr_levels; ++l)
+          {
+            ui32 depth = codestream->get_pyramid_depth();
+            for (ui32 i = 0; i < 3; ++i)
+            {
+              point ds = szp->get_recon_downsampling(i, l);
+              ui32 w = ojph_div_ceil(tx1, ds.x) - ojph_div_ceil(tx0, ds.x);
+              allocator->pre_alloc_obj<line_buf>(depth);
+              for (ui32 j = 0; j < depth; ++j)
+                if (reversible[0])
+                  allocator->pre_alloc_data<si32>(w, 0);
+                else
+                  allocator->pre_alloc_data<float>(w, 0);
+            }
+          }
+          for (int i = 0; i < 3; ++i)
+            if (reversible[0])
+              allocator->pre_alloc_data<si32>(width, 0);
+            else
+              allocator->pre_alloc_data<float>(width, 0);
+        }
       }
     }
 
@@ -183,6 +220,9 @@ namespace ojph {
       const param_nlt *nlp = codestream->get_nlt();
 
       this->num_bytes = 0;
+#ifdef OJPH_ENABLE_STATS
+      stats = codestream->get_stats_collector();
+#endif
       num_comps = szp->get_num_components();
       skipped_res_for_read = codestream->get_skipped_res_for_read();
       comps = allocator->post_alloc_obj<tile_comp>(num_comps);
@@ -195,6 +235,17 @@ namespace ojph {
       nlt_type3 = allocator->post_alloc_obj<ui8>(num_comps);
       cur_line = allocator->post_alloc_obj<ui32>(num_comps);
 
+      num_pyr_levels = codestream->get_pyramid_levels();
+      pyr_depth = codestream->get_pyramid_depth();
+      pyr_rings = codestream->get_pyramid_rings();
+      pyr_done = codestream->get_pyramid_done();
+      pyr_org = allocator->post_alloc_obj<point>(num_pyr_levels * num_comps);
+      pyr_widths = allocator->post_alloc_obj<ui32>(num_pyr_levels * num_comps);
+      pyr_rows = allocator->post_alloc_obj<ui32>(num_pyr_levels * num_comps);
+      pyr_raw = NULL;
+      pyr_colour_rows = NULL;
+      pyr_colour = NULL;
+
       profile = codestream->get_profile();
       tilepart_div = codestream->get_tilepart_div();
       need_tlm = codestream->is_tlm_needed();
@@ -235,6 +286,7 @@ namespace ojph {
       ui32 tx1 = tile_rect.org.x + tile_rect.siz.w;
       ui32 ty1 = tile_rect.org.y + tile_rect.siz.h;
 
+      ui32 image_y0 = codestream->access_siz().get_image_offset().y;
       ui32 width = 0;
       for (ui32 i = 0; i < num_comps; ++i)
       {
@@ -263,12 +315,26 @@ namespace ojph {
         recon_comp_rects[i].siz.w = recon_tcx1 - recon_tcx0;
         recon_comp_rects[i].siz.h = recon_tcy1 - recon_tcy0;
 
+        for (ui32 l = 0; l < num_pyr_levels; ++l)
+        {
+          point ds = szp->get_recon_downsampling(i, l + 1);
+          ui32 k = l * num_comps + i;
+          ui32 x0 = ojph_div_ceil(tx0, ds.x);
+          ui32 y0 = ojph_div_ceil(ty0, ds.y);
+          pyr_org[k].x = x0 - ojph_div_ceil(tx0 - offset, ds.x);
+          pyr_org[k].y = y0 - ojph_div_ceil(image_y0, ds.y);
+          pyr_widths[k] = ojph_div_ceil(tx1, ds.x) - x0;
+          pyr_rows[k] = 0;
+        }
+
         comps[i].finalize_alloc(codestream, this, i, comp_rects[i], 
           recon_comp_rects[i]);
         width = ojph_max(width, recon_comp_rects[i].siz.w);
 
         num_bits[i] = szp->get_bit_depth(i);
         is_signed[i] = szp->is_signed(i);
+        // left unchanged when there is no NLT marker segment
+        nlt_type3[i] = param_nlt::nonlinearity::OJPH_NLT_NO_NLT;
         bool result = nlp->get_nonlinear_transform(i, bd, is, nlt_type3[i]);
         if (result == true && (bd != num_bits[i] || is != is_signed[i]))
           OJPH_ERROR(0x000300A1, "Mismatch between Ssiz (bit_depth = %d, "
@@ -293,21 +359,78 @@ namespace ojph {
           for (int i = 0; i < 3; ++i)
             lines[i].wrap(
               allocator->post_alloc_data<si32>(width, 0), width, 0);
+        else if (codestream->uses_irv_fixed_point(0))
+          for (int i = 0; i < 3; ++i)
+            lines[i].wrap(
+              allocator->post_alloc_data<si16>(width, 0), width, 0);
         else
           for (int i = 0; i < 3; ++i)
             lines[i].wrap(
               allocator->post_alloc_data<float>(width, 0), width, 0);
+
+        if (num_pyr_levels > 0)
+        {
+          pyr_raw = allocator->post_alloc_obj<line_buf*>(num_pyr_levels * 3);
+          pyr_colour_rows = allocator->post_alloc_obj<ui32>(num_pyr_levels);
+          pyr_colour = allocator->post_alloc_obj<line_buf>(3);
+          for (ui32 l = 0; l < num_pyr_levels; ++l)
+          {
+            pyr_colour_rows[l] = 0;
+            for (ui32 i = 0; i < 3; ++i)
+            {
+              ui32 w = pyr_widths[l * num_comps + i];
+              line_buf* ring = allocator->post_alloc_obj<line_buf>(
+                pyr_depth);
+              for (ui32 j = 0; j < pyr_depth; ++j)
+                if (reversible[0])
+                  ring[j].wrap(allocator->post_alloc_data<si32>(w, 0), w, 0);
+                else
+                  ring[j].wrap(allocator->post_alloc_data<float>(w, 0), w, 0);
+              pyr_raw[l * 3 + i] = ring;
+            }
+          }
+          for (int i = 0; i < 3; ++i)
+            if (reversible[0])
+              pyr_colour[i].wrap(
+                allocator->post_alloc_data<si32>(width, 0), width, 0);
+            else
+              pyr_colour[i].wrap(
+                allocator->post_alloc_data<float>(width, 0), width, 0);
+        }
       }
       else
       {
         lines = NULL;
         num_lines = 0;
       }
+
+      // The first three components can be converted and colour transformed
+      // in one pass, moving samples directly between the codestream lines
+      // and the transform lines, when they share the same sample format
+      // and geometry.  Components 0 and 1 are then held until component 2
+      // arrives (encoding), or all three are produced together (decoding)
+      fuse_colour = employ_color_transform && !codestream->is_planar()
+        && rev_convert_rct_forward != NULL
+        && !codestream->uses_irv_fixed_point(0);
+      for (ui32 i = 0; fuse_colour && i < 3; ++i)
+      {
+        constexpr ui8 type3 = 
+          param_nlt::nonlinearity::OJPH_NLT_BINARY_COMPLEMENT_NLT;
+        const param_qcd* qp = codestream->access_qcd()->get_qcc(i);
+        fuse_colour = num_bits[i] == num_bits[0]
+          && is_signed[i] == is_signed[0]
+          && nlt_type3[i] != type3
+          && line_offsets[i] == line_offsets[0]
+          && comp_rects[i].siz.w == comp_rects[0].siz.w
+          && recon_comp_rects[i].siz.w == recon_comp_rects[0].siz.w
+          && qp->propose_precision(cdp) <= 32;
+      }
+      fused_src_lines[0] = fused_src_lines[1] = NULL;
       next_tile_part = 0;
     }
 
     //////////////////////////////////////////////////////////////////////////
-    bool tile::push(line_buf *line, ui32 comp_num)
+    bool tile::push(line_buf *line, ui32 comp_num, bool owned)
     {
       constexpr ui8 type3 = 
         param_nlt::nonlinearity::OJPH_NLT_BINARY_COMPLEMENT_NLT;
@@ -316,6 +439,9 @@ namespace ojph {
       if (cur_line[comp_num] >= comp_rects[comp_num].siz.h)
         return false;
       cur_line[comp_num]++;
+      OJPH_STATS_SCOPE(stats, codestream_stats::COLOUR);
+      OJPH_TRACE_SCOPE(stats, "tile push", sot.get_tile_index(),
+        (si32)comp_num, -1, -1);
 
       //converts to signed representation
       //employs color transform if there is a need
@@ -338,7 +464,10 @@ namespace ojph {
         }
         else
         {
-          if (nlt_type3[comp_num] == type3)
+          if (tc->flags & line_buf::LFT_16BIT) // fixed-point path
+            irv_convert_to_fix16(line, line_offsets[comp_num],
+              tc, num_bits[comp_num], is_signed[comp_num], comp_width);
+          else if (nlt_type3[comp_num] == type3)
             irv_convert_to_float_nlt_type3(line, line_offsets[comp_num],
               tc, num_bits[comp_num], is_signed[comp_num], comp_width);
           else
@@ -349,50 +478,37 @@ namespace ojph {
       }
       else
       {
-        si64 shift = (si64)1 << (num_bits[comp_num] - 1);
-        ui32 comp_width = comp_rects[comp_num].siz.w;
-        if (reversible[comp_num])
+        // components 0 and 1 are held until component 2 arrives, which
+        // is only possible for our codestream's own lines; a row that
+        // starts with caller memory is converted one component at a time
+        bool fuse = fuse_colour
+          && (comp_num == 0 ? owned : fused_src_lines[comp_num - 1] != NULL)
+          && (comp_num == 2 || owned);
+        if (comp_num == 1 && !fuse && fused_src_lines[0] != NULL)
+          push_colour_line(fused_src_lines[0], 0);
+        if (comp_num < 2)
+          fused_src_lines[comp_num] = fuse ? line : NULL;
+        if (!fuse)
+          push_colour_line(line, comp_num);
+        else if (comp_num == 2)
         {
-          if (is_signed[comp_num] && nlt_type3[comp_num] == type3)
-            rev_convert_nlt_type3(line, line_offsets[comp_num], 
-              lines + comp_num, 0, shift + 1, comp_width);            
-          else {
-            shift = is_signed[comp_num] ? 0 : -shift;
-            rev_convert(line, line_offsets[comp_num], lines + comp_num, 0, 
-              shift, comp_width);
-          }
-
-          if (comp_num == 2)
-          { // reversible color transform
-            rct_forward(lines + 0, lines + 1, lines + 2,
-                        comps[0].get_line(),
-                        comps[1].get_line(),
-                        comps[2].get_line(), comp_width);
-                        comps[0].push_line();
-                        comps[1].push_line();
-                        comps[2].push_line();
+          ui32 comp_width = comp_rects[0].siz.w;
+          if (reversible[0])
+          {
+            si64 shift = (si64)1 << (num_bits[0] - 1);
+            shift = is_signed[0] ? 0 : -shift;
+            rev_convert_rct_forward(fused_src_lines[0], fused_src_lines[1],
+              line, line_offsets[0], comps[0].get_line(), 
+              comps[1].get_line(), comps[2].get_line(), shift, comp_width);
           }
-        }
-        else
-        {
-          if (nlt_type3[comp_num] == type3)
-            irv_convert_to_float_nlt_type3(line, line_offsets[comp_num],
-              lines + comp_num, num_bits[comp_num], is_signed[comp_num], 
-              comp_width);
           else
-            irv_convert_to_float(line, line_offsets[comp_num],
-              lines + comp_num, num_bits[comp_num], is_signed[comp_num], 
-              comp_width);
-          if (comp_num == 2)
-          { // irreversible color transform
-            ict_forward(lines[0].f32, lines[1].f32, lines[2].f32,
-                        comps[0].get_line()->f32,
-                        comps[1].get_line()->f32,
-                        comps[2].get_line()->f32, comp_width);
-                        comps[0].push_line();
-                        comps[1].push_line();
-                        comps[2].push_line();
-          }
+            irv_convert_ict_forward(fused_src_lines[0], fused_src_lines[1],
+              line, line_offsets[0], comps[0].get_line(), 
+              comps[1].get_line(), comps[2].get_line(), num_bits[0], 
+              is_signed[0], comp_width);
+          comps[0].push_line();
+          comps[1].push_line();
+          comps[2].push_line();
         }
       }
 
@@ -400,43 +516,125 @@ namespace ojph {
     }
 
     //////////////////////////////////////////////////////////////////////////
-    bool tile::pull(line_buf* tgt_line, ui32 comp_num)
+    void tile::push_colour_line(line_buf *line, ui32 comp_num)
     {
       constexpr ui8 type3 = 
         param_nlt::nonlinearity::OJPH_NLT_BINARY_COMPLEMENT_NLT;
 
+      si64 shift = (si64)1 << (num_bits[comp_num] - 1);
+      ui32 comp_width = comp_rects[comp_num].siz.w;
+      if (reversible[comp_num])
+      {
+        if (is_signed[comp_num] && nlt_type3[comp_num] == type3)
+          rev_convert_nlt_type3(line, line_offsets[comp_num], 
+            lines + comp_num, 0, shift + 1, comp_width);            
+        else {
+          shift = is_signed[comp_num] ? 0 : -shift;
+          rev_convert(line, line_offsets[comp_num], lines + comp_num, 0, 
+            shift, comp_width);
+        }
+
+        if (comp_num == 2)
+        { // reversible color transform
+          rct_forward(lines + 0, lines + 1, lines + 2,
+                      comps[0].get_line(),
+                      comps[1].get_line(),
+                      comps[2].get_line(), comp_width);
+                      comps[0].push_line();
+                      comps[1].push_line();
+                      comps[2].push_line();
+        }
+      }
+      else if (lines[0].flags & line_buf::LFT_16BIT) // fixed-point path
+      {
+        irv_convert_to_fix16(line, line_offsets[comp_num],
+          lines + comp_num, num_bits[comp_num], is_signed[comp_num], 
+          comp_width);
+        if (comp_num == 2)
+        { // irreversible color transform
+          ict_forward_fix16(lines[0].i16, lines[1].i16, lines[2].i16,
+                            comps[0].get_line()->i16,
+                            comps[1].get_line()->i16,
+                            comps[2].get_line()->i16, comp_width);
+                            comps[0].push_line();
+                            comps[1].push_line();
+                            comps[2].push_line();
+        }
+      }
+      else
+      {
+        if (nlt_type3[comp_num] == type3)
+          irv_convert_to_float_nlt_type3(line, line_offsets[comp_num],
+            lines + comp_num, num_bits[comp_num], is_signed[comp_num], 
+            comp_width);
+        else
+          irv_convert_to_float(line, line_offsets[comp_num],
+            lines + comp_num, num_bits[comp_num], is_signed[comp_num], 
+            comp_width);
+        if (comp_num == 2)
+        { // irreversible color transform
+          ict_forward(lines[0].f32, lines[1].f32, lines[2].f32,
+                      comps[0].get_line()->f32,
+                      comps[1].get_line()->f32,
+                      comps[2].get_line()->f32, comp_width);
+                      comps[0].push_line();
+                      comps[1].push_line();
+                      comps[2].push_line();
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    bool tile::pull(line_buf* tgt_lines, ui32 comp_num, bool exact)
+    {
       assert(comp_num < num_comps);
       if (cur_line[comp_num] >= recon_comp_rects[comp_num].siz.h)
         return false;
 
       cur_line[comp_num]++;
+      OJPH_STATS_SCOPE(stats, codestream_stats::COLOUR);
+      OJPH_TRACE_SCOPE(stats, "tile pull", sot.get_tile_index(),
+        (si32)comp_num, -1, -1);
 
+      line_buf* tgt_line = tgt_lines + comp_num;
       if (!employ_color_transform || num_comps == 1)
+        convert_line(comps[comp_num].pull_line(), tgt_line, comp_num, exact);
+      else if (fuse_colour && comp_num < 3)
       {
-        line_buf *src_line = comps[comp_num].pull_line();
-        ui32 comp_width = recon_comp_rects[comp_num].siz.w;
-        if (reversible[comp_num])
+        // all three lines are produced with component 0
+        if (comp_num == 0)
         {
-          si64 shift = (si64)1 << (num_bits[comp_num] - 1);
-          if (is_signed[comp_num] && nlt_type3[comp_num] == type3)
-            rev_convert_nlt_type3(src_line, 0, tgt_line, 
-              line_offsets[comp_num], shift + 1, comp_width);
-          else {
-            shift = is_signed[comp_num] ? 0 : shift;
-            rev_convert(src_line, 0, tgt_line, 
-              line_offsets[comp_num], shift, comp_width);
+          const line_buf* src[3] = { comps[0].pull_line(),
+            comps[1].pull_line(), comps[2].pull_line() };
+          ui32 width = recon_comp_rects[0].siz.w;
+          ui32 whole = exact ? width & ~(vector_samples - 1) : width;
+          ui32 offset = line_offsets[0];
+          si64 shift = (si64)1 << (num_bits[0] - 1);
+          shift = is_signed[0] ? 0 : shift;
+          if (whole > 0)
+          {
+            if (reversible[0])
+              rct_backward_rev_convert(src[0], src[1], src[2], tgt_lines,
+                tgt_lines + 1, tgt_lines + 2, offset, shift, whole);
+            else
+              ict_backward_irv_convert(src[0], src[1], src[2], tgt_lines,
+                tgt_lines + 1, tgt_lines + 2, offset, num_bits[0],
+                is_signed[0], whole);
+          }
+          if (whole < width)
+          {
+            line_buf tail[3];
+            for (ui32 c = 0; c < 3; ++c)
+              tail[c] = skip_samples(src[c], whole);
+            if (reversible[0])
+              gen_rct_backward_rev_convert(tail, tail + 1, tail + 2,
+                tgt_lines, tgt_lines + 1, tgt_lines + 2, offset + whole,
+                shift, width - whole);
+            else
+              gen_ict_backward_irv_convert(tail, tail + 1, tail + 2,
+                tgt_lines, tgt_lines + 1, tgt_lines + 2, offset + whole,
+                num_bits[0], is_signed[0], width - whole);
           }
-        }
-        else
-        {
-          if (nlt_type3[comp_num] == type3)
-            irv_convert_to_integer_nlt_type3(src_line, tgt_line, 
-              line_offsets[comp_num], num_bits[comp_num], 
-              is_signed[comp_num], comp_width);
-          else
-            irv_convert_to_integer(src_line, tgt_line, 
-              line_offsets[comp_num], num_bits[comp_num], 
-              is_signed[comp_num], comp_width);
         }
       }
       else
@@ -454,42 +652,172 @@ namespace ojph {
               comps[2].pull_line()->f32, lines[0].f32, lines[1].f32,
               lines[2].f32, comp_width);
         }
-        if (reversible[comp_num])
+        if (comp_num < 3)
+          convert_line(lines + comp_num, tgt_line, comp_num, exact);
+        else
+          convert_line(comps[comp_num].pull_line(), tgt_line, comp_num,
+            exact);
+      }
+
+      return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    line_buf tile::skip_samples(const line_buf* line, ui32 count)
+    {
+      line_buf t = *line;
+      if (t.flags & line_buf::LFT_64BIT)
+        t.i64 += count;
+      else if (t.flags & line_buf::LFT_32BIT)
+        t.i32 += count; // also advances f32
+      else
+        t.i16 += count;
+      t.size -= count;
+      return t;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void tile::convert_line(const line_buf* src_line, line_buf* tgt_line,
+                            ui32 comp_num, bool exact)
+    {
+      constexpr ui8 type3 =
+        param_nlt::nonlinearity::OJPH_NLT_BINARY_COMPLEMENT_NLT;
+
+      // The dispatched kernels write whole vectors, past the end of the
+      // samples; when the target is the caller's memory, they convert the
+      // whole vectors only, and the generic kernels convert the rest
+      ui32 width = recon_comp_rects[comp_num].siz.w;
+      ui32 whole = exact ? width & ~(vector_samples - 1) : width;
+      ui32 offset = line_offsets[comp_num];
+      if (reversible[comp_num])
+      {
+        si64 shift = (si64)1 << (num_bits[comp_num] - 1);
+        if (is_signed[comp_num] && nlt_type3[comp_num] == type3)
         {
-          si64 shift = (si64)1 << (num_bits[comp_num] - 1);
-          line_buf* src_line;
-          if (comp_num < 3)
-            src_line = lines + comp_num;
-          else
-            src_line = comps[comp_num].pull_line();
-          if (is_signed[comp_num] && nlt_type3[comp_num] == type3)
-            rev_convert_nlt_type3(src_line, 0, tgt_line, 
-              line_offsets[comp_num], shift + 1, comp_width);
-          else {
-            shift = is_signed[comp_num] ? 0 : shift;
-            rev_convert(src_line, 0, tgt_line, 
-              line_offsets[comp_num], shift, comp_width);
-          }
+          if (whole > 0)
+            rev_convert_nlt_type3(src_line, 0, tgt_line, offset, shift + 1,
+              whole);
+          if (whole < width)
+            gen_rev_convert_nlt_type3(src_line, whole, tgt_line,
+              offset + whole, shift + 1, width - whole);
         }
         else
         {
-          line_buf* lbp;
-          if (comp_num < 3)
-            lbp = lines + comp_num;
+          shift = is_signed[comp_num] ? 0 : shift;
+          if (whole > 0)
+            rev_convert(src_line, 0, tgt_line, offset, shift, whole);
+          if (whole < width)
+            gen_rev_convert(src_line, whole, tgt_line, offset + whole,
+              shift, width - whole);
+        }
+      }
+      else
+      {
+        ui32 bit_depth = num_bits[comp_num];
+        bool sign = is_signed[comp_num];
+        if (whole > 0)
+        {
+          if (nlt_type3[comp_num] == type3)
+            irv_convert_to_integer_nlt_type3(src_line, tgt_line, offset,
+              bit_depth, sign, whole);
           else
-            lbp = comps[comp_num].pull_line();            
+            irv_convert_to_integer(src_line, tgt_line, offset, bit_depth,
+              sign, whole);
+        }
+        if (whole < width)
+        {
+          line_buf tail = skip_samples(src_line, whole);
           if (nlt_type3[comp_num] == type3)
-            irv_convert_to_integer_nlt_type3(lbp, tgt_line, 
-              line_offsets[comp_num], num_bits[comp_num], 
-              is_signed[comp_num], comp_width);
+            gen_irv_convert_to_integer_nlt_type3(&tail, tgt_line,
+              offset + whole, bit_depth, sign, width - whole);
           else
-            irv_convert_to_integer(lbp, tgt_line, 
-              line_offsets[comp_num], num_bits[comp_num], 
-              is_signed[comp_num], comp_width);
+            gen_irv_convert_to_integer(&tail, tgt_line, offset + whole,
+              bit_depth, sign, width - whole);
         }
       }
+    }
 
-      return true;
+    //////////////////////////////////////////////////////////////////////////
+    void tile::push_pyramid_line(ui32 level, ui32 comp_num, line_buf *line)
+    {
+      ui32 l = level - 1, k = l * num_comps + comp_num;
+      ui32 row = pyr_rows[k]++, width = pyr_widths[k];
+      if (employ_color_transform && comp_num < 3)
+      {
+        // kept until the same row of all three components is available;
+        // the resolution reuses its line for the next row
+        line_buf* raw = pyr_raw[l * 3 + comp_num] + row % pyr_depth;
+        if (reversible[comp_num])
+          rev_convert(line, 0, raw, 0, 0, width);
+        else
+          memcpy(raw->f32, line->f32, width * sizeof(float));
+      }
+      else
+        convert_pyramid_line(line, k, row);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void tile::pull_pyramid(ui32 comp_num)
+    {
+      // all three colour components are produced with component 0
+      if (!employ_color_transform || comp_num != 0)
+        return;
+
+      OJPH_STATS_SCOPE(stats, codestream_stats::COLOUR);
+      for (ui32 l = 0; l < num_pyr_levels; ++l)
+      {
+        ui32 k = l * num_comps;
+        ui32 rows = ojph_min(pyr_rows[k],
+          ojph_min(pyr_rows[k + 1], pyr_rows[k + 2]));
+        for (; pyr_colour_rows[l] < rows; ++pyr_colour_rows[l])
+        {
+          ui32 row = pyr_colour_rows[l], j = row % pyr_depth;
+          line_buf** raw = pyr_raw + l * 3;
+          if (reversible[0])
+            rct_backward(raw[0] + j, raw[1] + j, raw[2] + j,
+              pyr_colour + 0, pyr_colour + 1, pyr_colour + 2,
+              pyr_widths[k]);
+          else
+            ict_backward(raw[0][j].f32, raw[1][j].f32, raw[2][j].f32,
+              pyr_colour[0].f32, pyr_colour[1].f32, pyr_colour[2].f32,
+              pyr_widths[k]);
+          for (ui32 c = 0; c < 3; ++c)
+            convert_pyramid_line(pyr_colour + c, k + c, row);
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void tile::convert_pyramid_line(line_buf *src_line, ui32 k, ui32 row)
+    {
+      constexpr ui8 type3 =
+        param_nlt::nonlinearity::OJPH_NLT_BINARY_COMPLEMENT_NLT;
+
+      ui32 comp_num = k % num_comps, width = pyr_widths[k];
+      ui32 g = pyr_org[k].y + row; // row within the level
+      line_buf *tgt_line = pyr_rings[k] + g % pyr_depth;
+      ui32 tgt_offset = pyr_org[k].x;
+      if (reversible[comp_num])
+      {
+        si64 shift = (si64)1 << (num_bits[comp_num] - 1);
+        if (is_signed[comp_num] && nlt_type3[comp_num] == type3)
+          rev_convert_nlt_type3(src_line, 0, tgt_line, tgt_offset,
+            shift + 1, width);
+        else {
+          shift = is_signed[comp_num] ? 0 : shift;
+          rev_convert(src_line, 0, tgt_line, tgt_offset, shift, width);
+        }
+      }
+      else
+      {
+        if (nlt_type3[comp_num] == type3)
+          irv_convert_to_integer_nlt_type3(src_line, tgt_line, tgt_offset,
+            num_bits[comp_num], is_signed[comp_num], width);
+        else
+          irv_convert_to_integer(src_line, tgt_line, tgt_offset,
+            num_bits[comp_num], is_signed[comp_num], width);
+      }
+      pyr_done[k] = ojph_max(pyr_done[k], g + 1);
     }
 
 
@@ -559,6 +887,7 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void tile::flush(outfile_base *file)
     {
+      OJPH_TRACE_SCOPE(stats, "tile write", sot.get_tile_index(), -1, -1, -1);
       ui32 max_decompositions = 0;
       for (ui32 c = 0; c < num_comps; ++c)
         max_decompositions = ojph_max(max_decompositions,
@@ -753,6 +1082,7 @@ namespace ojph {
     void tile::parse_tile_header(const param_sot &sot, infile_base *file,
                                  const ui64& tile_start_location)
     {
+      OJPH_TRACE_SCOPE(stats, "tile parse", sot.get_tile_index(), -1, -1, -1);
       if (sot.get_tile_part_index() != next_tile_part)
       {
         if (resilient)
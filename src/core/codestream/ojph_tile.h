@@ -55,6 +55,7 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     //defined here
     class tile_comp;
+    class stats_collector;
 
     //////////////////////////////////////////////////////////////////////////
     class tile
@@ -65,15 +66,32 @@ namespace ojph {
       void finalize_alloc(codestream *codestream, const rect& tile_rect,
                           ui32 tile_idx, ui32& offset, ui32 &num_tileparts);
 
-      bool push(line_buf *line, ui32 comp_num);
+      // owned is false when line is caller memory, which may be reused
+      // as soon as push returns
+      bool push(line_buf *line, ui32 comp_num, bool owned = true);
       void prepare_for_flush();
       void fill_tlm(param_tlm* tlm);
       void flush(outfile_base *file);
       void parse_tile_header(const param_sot& sot, infile_base *file,
                              const ui64& tile_start_location);
-      bool pull(line_buf *, ui32 comp_num);
+      // a line per comp; exact is true when tgt_lines are caller memory,
+      // which must not be written past the tile's samples
+      bool pull(line_buf *tgt_lines, ui32 comp_num, bool exact = false);
+      void pull_pyramid(ui32 comp_num);
+      void push_pyramid_line(ui32 level, ui32 comp_num, line_buf *line);
+      ui32 get_num_pyramid_levels() const { return num_pyr_levels; }
       rect get_tile_rect() { return tile_rect; }
 
+    private:
+      void convert_line(const line_buf *src_line, line_buf *tgt_line,
+                        ui32 comp_num, bool exact);
+      static line_buf skip_samples(const line_buf *line, ui32 count);
+      void push_colour_line(line_buf *line, ui32 comp_num);
+      void convert_pyramid_line(line_buf *src_line, ui32 k, ui32 row);
+
+      // samples in the widest vector that a conversion kernel writes
+      static const ui32 vector_samples = byte_alignment / sizeof(si32);
+
     private:
       //codestream *parent;
       rect tile_rect;
@@ -82,6 +100,8 @@ namespace ojph {
       ui32 num_lines;
       line_buf* lines;
       bool employ_color_transform, resilient;
+      bool fuse_colour;                 // fused conversion and transform
+      line_buf* fused_src_lines[2];     // components 0 and 1, when fused
       bool *reversible;
       rect *comp_rects, *recon_comp_rects;
       ui32 *line_offsets;
@@ -93,6 +113,19 @@ namespace ojph {
       ui8 *nlt_type3;
       int prog_order;
 
+      // pyramid output; unless noted, arrays are per level and component
+      ui32 num_pyr_levels;
+      ui32 pyr_depth;                   // rows in each ring
+      line_buf **pyr_rings;             // the codestream's rings
+      ui32 *pyr_done;                   // the codestream's completed rows
+      point *pyr_org;                   // our position in the rings
+      ui32 *pyr_widths;
+      ui32 *pyr_rows;                   // number of rows we produced
+      line_buf **pyr_raw;               // per level, and colour component;
+                                        // rings before the colour transform
+      ui32 *pyr_colour_rows;            // per level, rows colour transformed
+      line_buf *pyr_colour;             // for the inverse colour transform
+
     private:
       param_sot sot;
       int next_tile_part;
@@ -104,6 +137,9 @@ namespace ojph {
 
       ui32 num_bytes; // number of bytes in this tile
                       // used for tile length
+#ifdef OJPH_ENABLE_STATS
+      stats_collector *stats;
+#endif
     };
     
   }
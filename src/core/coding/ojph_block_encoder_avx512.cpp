@@ -220,16 +220,17 @@ namespace ojph {
     }
 
     /////////////////////////////////////////////////////////////////////////
-    static bool tables_initialized = false;
+    static bool init_tables() {
+      memset(vlc_tbl0, 0, 2048 * sizeof(ui32));
+      memset(vlc_tbl1, 0, 2048 * sizeof(ui32));
+      bool result = vlc_init_tables();
+      return result && uvlc_init_tables();
+    }
 
     /////////////////////////////////////////////////////////////////////////
     bool initialize_block_encoder_tables_avx512() {
-      if (!tables_initialized) {
-        memset(vlc_tbl0, 0, 2048 * sizeof(ui32));
-        memset(vlc_tbl1, 0, 2048 * sizeof(ui32));
-        tables_initialized = vlc_init_tables();
-        tables_initialized = tables_initialized && uvlc_init_tables();
-      }
+      // initialized exactly once, even when called from several threads
+      static bool tables_initialized = init_tables();
       return tables_initialized;
     }
 
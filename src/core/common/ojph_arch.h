@@ -125,6 +125,20 @@ namespace ojph {
   OJPH_EXPORT
   int get_cpu_ext_level();
 
+  // Limits the level returned by get_cpu_ext_level(), and therefore the
+  // SIMD implementations that are selected, to at most max_level, which
+  // is one of the X86_CPU_EXT_LEVEL_* or ARM_CPU_EXT_LEVEL_* values below.
+  // By default, or after a call with a negative max_level, the limit is
+  // read from the OJPH_MAX_CPU_EXT_LEVEL environment variable, which holds
+  // either a level number or a name, such as "generic", "sse2", "avx2" or
+  // "avx512"; there is no limit when the variable is not set.  The
+  // variable is read only once, on the first call to get_cpu_ext_level(),
+  // so setting it later, with setenv() for example, has no effect.
+  // Wavelet and colour transform implementations are selected once per
+  // process, so this should be called before any codestream is created.
+  OJPH_EXPORT
+  void set_max_cpu_ext_level(int max_level);
+
   enum : int {
     X86_CPU_EXT_LEVEL_GENERIC = 0,
     X86_CPU_EXT_LEVEL_MMX = 1,
@@ -61,9 +61,134 @@ namespace ojph {
   class comment_exchange;
   class mem_fixed_allocator;
   struct point;
+  struct size;
   class line_buf;
   class outfile_base;
   class infile_base;
+  class trace_sink;
+  class executor;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /**
+   *  @brief Wall time and number of calls spent in each stage of the
+   *         codec, as accumulated by a codestream object.
+   *
+   *  Times are exclusive; time spent in a stage that is entered from
+   *  within another stage, such as reading the file while parsing a
+   *  precinct, is charged to the inner stage only.  The statistics are
+   *  collected only when the library is built with OJPH_ENABLE_STATS;
+   *  otherwise, enabled is false and all entries are zero.
+   *
+   *  The DWT entries are indexed by resolution, DWT + r is the time
+   *  spent in the transform level that produces (or consumes) resolution
+   *  r, with r = 0 being the lowest resolution, which has no transform.
+   */
+  struct OJPH_EXPORT codestream_stats
+  {
+    enum stage : ui32 {
+      COLOUR = 0,         // sample shifting, colour transform, and NLT
+      CB_TRANSFER = 1,    // quantization and copying to/from codeblocks
+      CB_ENCODE = 2,      // codeblock encoding
+      CB_DECODE = 3,      // codeblock decoding
+      PRECINCT_WRITE = 4, // writing precinct headers and codeblock data
+      PRECINCT_PARSE = 5, // parsing precinct headers and codeblock data
+      FILE_IO = 6,        // reading from and writing to the file
+      DWT = 7,            // DWT + r for resolution r
+      NUM_STAGES = DWT + 33
+    };
+
+    /**
+     * @brief Returns a short printable name for a stage; all DWT
+     *        entries are named "dwt".
+     */
+    static const char* get_stage_name(ui32 stage);
+
+    bool enabled;                 // true if statistics are collected
+    ui64 time_ns[NUM_STAGES];     // accumulated time in nanoseconds
+    ui64 num_calls[NUM_STAGES];   // number of times a stage was entered
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /**
+   *  @brief Memory held by a codestream object, as reported by
+   *         codestream::get_memory_report() or predicted by
+   *         codestream::estimate_memory().
+   *
+   *  A codestream obtains its memory from two arenas, which are released
+   *  only when the codestream is destroyed; restart() keeps them for the
+   *  next image.  The fixed arena is allocated once, and holds the tiles,
+   *  lines, and codeblock state; its size depends only on the SIZ and COD
+   *  parameters.  The elastic arena grows
+   *  in chunks as coded data is produced or read; its size depends on the
+   *  size of the coded data.  Because neither arena shrinks, peak_bytes
+   *  is their sum.
+   */
+  struct OJPH_EXPORT codestream_memory
+  {
+    size_t fixed_bytes;         // size of the fixed arena
+    size_t elastic_bytes;       // size of all elastic chunks
+    size_t num_elastic_chunks;  // number of elastic chunks
+    size_t coded_bytes;         // coded data and headers held in the chunks
+    size_t peak_bytes;          // high-water mark of the two arenas
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /**
+   *  @brief Describes a caller-owned buffer of samples, for
+   *         codestream::push_region(), codestream::pull_region(), and
+   *         codestream::set_decode_target().
+   *
+   *  Sample x of row y of component c is at byte offset
+   *  y * row_stride + x * sample_stride + c * comp_stride from data.  For
+   *  interleaved samples, sample_stride is the number of components times
+   *  the sample size, and comp_stride is the sample size; for planar
+   *  samples, sample_stride is the sample size, and comp_stride is the size
+   *  of a plane.  Strides can be negative, to flip the image for example.
+   *
+   *  Integer samples are used as they are; float samples are normalized,
+   *  where [0, 1] maps to the full range of an unsigned component, and
+   *  [-0.5, 0.5) to that of a signed component.
+   */
+  struct OJPH_EXPORT image_region
+  {
+    enum sample_type : ui32 {
+      U8 = 0,   // unsigned 8-bit integer
+      U16 = 1,  // unsigned 16-bit integer, in native byte order
+      S16 = 2,  // signed 16-bit integer, in native byte order
+      S32 = 3,  // signed 32-bit integer, in native byte order
+      F32 = 4,  // normalized 32-bit float
+    };
+
+    void* data;          // the first sample of component 0 in the first row
+    sample_type type;    // type of all samples
+    ui32 num_rows;       // number of rows of each component in the buffer
+    si64 row_stride;     // bytes between rows
+    si64 sample_stride;  // bytes between samples of one component in a row
+    si64 comp_stride;    // bytes between components
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /**
+   *  @brief Receives the lower resolutions of an image, as they are
+   *         produced during decoding; see codestream::set_pyramid_output().
+   *
+   *  Level l is the image at 2^l times lower resolution than the one
+   *  returned by codestream::pull().  For each level, rows arrive in order,
+   *  and, within a row, components arrive in order; for a planar
+   *  codestream, all the rows of one component arrive before those of the
+   *  next.  Rows of different levels are interleaved.  Samples are in the
+   *  same form as those returned by codestream::pull(); for irreversible
+   *  codestreams, they can differ by one from those of a separate decode
+   *  at the lower resolution, because of rounding.  The line_buf is only
+   *  valid during the call.
+   */
+  class OJPH_EXPORT pyramid_sink
+  {
+  public:
+    virtual ~pyramid_sink() {}
+    virtual void push_line(ui32 level, ui32 comp_num, ui32 row,
+                           const line_buf* line) = 0;
+  };
 
   ////////////////////////////////////////////////////////////////////////////
   /**
@@ -193,6 +318,42 @@ namespace ojph {
     
     bool is_tlm_requested();
 
+    /**
+     *  @brief Requests the fixed-point implementation of the irreversible
+     *  path for encoding.
+     *
+     *  When enabled, irreversible components with a bit depth of 8 or less
+     *  are colour transformed, wavelet transformed, and handed to the
+     *  quantizer as 16-bit fixed-point numbers instead of floats.  This 
+     *  speeds up these stages on SIMD machines, but the resulting 
+     *  codestream is not bit-exact with the one produced by the 
+     *  floating-point path; the difference is well below the quantization
+     *  step size of typical lossy encodes.  The option is 
+     *  ignored for reversible components, for components with NLT type 3,
+     *  for decoding, and on platforms that do not support it.  Call this
+     *  function before ojph::codestream::write_headers().
+     *
+     *  @param enable true to use the fixed-point path when possible.
+     */
+    void set_irv_fixed_point(bool enable);
+
+    /**
+     *  @brief Runs the codestream's parallel work through exec.
+     *
+     *  The codeblocks of a row of each subband are encoded or decoded as
+     *  tasks of exec, while the calling thread drives the rest of the
+     *  codestream, including the wavelet and colour transforms, as usual;
+     *  the output is identical to that without an executor.  An executor
+     *  can be shared by many codestreams, so that an application with
+     *  many concurrent codestreams runs them on one set of threads.
+     *  Call this function before ojph::codestream::write_headers() or
+     *  ojph::codestream::create(); restart() forgets the executor.
+     *
+     *  @param exec an executor that outlives the codestream, or NULL to
+     *              do all the work in the calling thread, the default.
+     */
+    void set_executor(executor* exec);
+
     /** 
      *  @brief Writes codestream headers when the codestream is used for
      *  writing.  This function should be called after setting all the 
@@ -237,6 +398,23 @@ namespace ojph {
     
     line_buf* exchange(line_buf* line, ui32& next_component);
 
+    /**
+     *  @brief Sends the next region.num_rows rows of all components to the
+     *         library, converting them from the caller's layout and sample
+     *         type; this replaces the corresponding calls to exchange().
+     *
+     *  All components must have the same dimensions, i.e., no
+     *  downsampling.  Rows continue from where the last push_region() or
+     *  exchange() call stopped, which must be at the start of a row of
+     *  component 0.  For a planar codestream (see set_planar()), the
+     *  region must hold the whole image, since components are consumed one
+     *  at a time.  Float samples are clamped to the range of each
+     *  component's bit depth; integer samples are used as they are.
+     *
+     *  @param region the caller's buffer; see image_region.
+     */
+    void push_region(const image_region& region);
+
     /**
      * @brief This is the last call to a writing (encoding) codestream.
      *        This will write encoded bitstream data to the file.  This
@@ -295,6 +473,29 @@ namespace ojph {
      */
     void create(); 
 
+    /**
+     * @brief Produces the num_levels lower resolutions of the image in the
+     *        same decoding pass, delivering them to sink, while pull()
+     *        continues to return the full (or restricted) resolution.
+     *
+     * The lower resolutions are by-products of the inverse wavelet
+     * transform, so they cost only their colour transform and conversion.
+     * Call this after restrict_input_resolution() and before create().
+     * The number of levels, added to the resolutions skipped for
+     * reconstruction, cannot exceed the number of decompositions of any
+     * component.
+     *
+     * @param num_levels number of lower resolutions; 0 disables the output.
+     * @param sink the object receiving the lines; see pyramid_sink.
+     */
+    void set_pyramid_output(ui32 num_levels, pyramid_sink* sink);
+
+    /**
+     * @brief Returns the width and height of a component at a pyramid
+     *        level; level 0 is the resolution returned by pull().
+     */
+    size get_pyramid_size(ui32 level, ui32 comp_num) const;
+
     /**
      * @brief This call is to pull one row from the codestream, being
      *        decoded.  The returned line_buf object holds one row from
@@ -308,6 +509,41 @@ namespace ojph {
      */
     line_buf* pull(ui32 &comp_num);
 
+    /**
+     * @brief Reads the next region.num_rows rows of all components from
+     *        the library into the caller's buffer, converting them to its
+     *        layout and sample type; this replaces the corresponding calls
+     *        to pull().
+     *
+     * The same constraints as push_region() apply.  Samples that do not
+     * fit the sample type are saturated.
+     *
+     * @param region the caller's buffer; see image_region.
+     */
+    void pull_region(const image_region& region);
+
+    /**
+     * @brief Registers a caller framebuffer into which subsequent pull()
+     *        calls store their rows, converted to its layout and sample
+     *        type, as part of decoding.
+     *
+     * This removes the copy an application would otherwise make from the
+     * returned line_buf; the line_buf is still returned, and remains valid.
+     * For S32 samples with a sample_stride of 4 bytes, the final sample
+     * conversion and inverse colour transform write directly into the
+     * target, and the returned line_buf refers to the target's row; other
+     * sample types and layouts are converted from the codestream's own
+     * row.  Row 0 of the target receives the next row to be pulled; rows
+     * past target->num_rows are not stored.  The same constraints as
+     * pull_region() apply, the target can be replaced or removed only at
+     * the beginning of a row, and it must remain valid until it is
+     * replaced, removed, or the codestream is closed.
+     *
+     * @param target the caller's framebuffer, which is copied; NULL
+     *               removes the current target.
+     */
+    void set_decode_target(const image_region* target);
+
     /**
      * @brief Call this function to close the underlying file; works for both
      *        encoding and decoding codestreams.
@@ -315,6 +551,18 @@ namespace ojph {
      */
     void close();
 
+    /**
+     * @brief Returns the codestream to the state it had just after
+     *        construction, so that it can encode or decode another image.
+     *
+     * All settings and markers are forgotten, but the memory obtained
+     * for the previous image is kept, and is reused when the next image
+     * is of the same size or smaller; this avoids repeated allocation
+     * when many images are processed one after another, such as the
+     * frames of a video.  Call close() first if a file is attached.
+     */
+    void restart();
+
     /**
      * @brief Returns the underlying SIZ marker segment object
      * 
@@ -361,6 +609,72 @@ namespace ojph {
      */
     bool is_planar() const;
 
+    /**
+     * @brief Query if the fixed-point irreversible path was requested.
+     * See the documentation for ojph::codestream::set_irv_fixed_point()
+     *
+     * @return true if it was requested
+     */
+    bool is_irv_fixed_point() const;
+
+    /**
+     * @brief Returns the per-stage timing accumulated since this object
+     *        was created or since the last call to reset_stats().
+     *
+     * See ojph::codestream_stats; all entries are zero unless the library
+     * is built with OJPH_ENABLE_STATS.  Collection is not thread-safe;
+     * query the statistics from the thread that drives the codestream.
+     *
+     * @return a reference to the internal statistics, which remains
+     *         valid for the lifetime of this object.
+     */
+    const codestream_stats& get_stats() const;
+
+    /**
+     * @brief Clears the statistics returned by get_stats().
+     */
+    void reset_stats();
+
+    /**
+     * @brief Records the work of this codestream into a trace.
+     *
+     * Events are recorded for each line pushed to or pulled from a tile,
+     * each DWT line of each resolution, each row of codeblocks encoded or
+     * decoded, precincts written or parsed, and tiles written or parsed.
+     * Nothing is recorded unless the library is built with
+     * OJPH_ENABLE_STATS.
+     *
+     * @param sink an open trace_sink that outlives the codestream's work,
+     *             or NULL to stop recording.
+     */
+    void set_trace_sink(trace_sink* sink);
+
+    /**
+     * @brief Returns the memory this codestream holds now.
+     *
+     * The fixed arena is reported once it is allocated, by write_headers()
+     * when encoding, or by create() when decoding.
+     */
+    codestream_memory get_memory_report() const;
+
+    /**
+     * @brief Predicts the memory that this codestream will hold.
+     *
+     * Call this after the SIZ and COD parameters are set for encoding, or
+     * after read_headers() and restrict_input_resolution() for decoding.
+     * The fixed arena is computed exactly from these parameters, without
+     * allocating it.  The elastic arena is predicted from coded_bytes,
+     * including an allowance for the headers and unused tails of its
+     * chunks.  When encoding, the parameters are validated here, and
+     * write_headers() does not validate them again unless they are
+     * accessed or changed in between.
+     *
+     * @param coded_bytes the expected size of the codestream; when
+     *                    decoding, the file size is a good choice.
+     * @return the predicted footprint.
+     */
+    codestream_memory estimate_memory(size_t coded_bytes);
+
   private:
     local::codestream* state;
   };
@@ -66,6 +66,12 @@ typedef int64_t si64;
 // All numbers are in the range of [-0.5, 0.5)
 const int NUM_FRAC_BITS = 13;
 
+/////////////////////////////////////////////////////////////////////////////
+// number of fractional bits of the 16 bit fixed-point representation used
+// by the optional fixed-point irreversible path; the 3 remaining integer
+// bits accommodate the growth of 9/7 wavelet coefficients
+const int IRV_FIX_FRAC_BITS = 12;
+
 /////////////////////////////////////////////////////////////////////////////
 #define ojph_div_ceil(a, b) (((a) + (b) - 1) / (b))
 
@@ -0,0 +1,139 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_executor.h
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+
+#ifndef OJPH_EXECUTOR_H
+#define OJPH_EXECUTOR_H
+
+#include "ojph_arch.h"
+#include "ojph_defs.h"
+#include "ojph_threads.h"
+
+namespace ojph {
+
+  ////////////////////////////////////////////////////////////////////////////
+  /**
+   *  @brief An interface through which a codestream runs its internal
+   *         tasks on threads supplied by the application.
+   *
+   *  A codestream given an executor (see codestream::set_executor())
+   *  splits work that can proceed in parallel, such as the codeblocks of a
+   *  row, into tasks, submits them as a group, and waits for the group.
+   *  Applications that own a thread pool derive from this class so that
+   *  many codestreams share their threads, instead of each creating its
+   *  own; thread_pool_executor is an implementation on the bundled
+   *  thds::thread_pool.
+   *
+   *  An executor can be shared by codestreams used from different threads,
+   *  and therefore its functions must be thread safe.  wait() can be
+   *  called from a task of the same executor, when a codestream is itself
+   *  processed in a task; an implementation should then run queued tasks
+   *  while it waits, or ensure that another thread is free to run them.
+   */
+  class OJPH_EXPORT executor
+  {
+  public:
+    /**
+     *  @brief State that an executor keeps for a group of tasks; derived
+     *         executors derive from this class too
+     */
+    class group
+    {
+    public:
+      virtual ~group() { }
+    };
+
+  public:
+    virtual ~executor() { }
+
+    /**
+     *  @brief Returns the number of tasks that can usefully run at once,
+     *         counting the thread that calls wait(); a codestream splits
+     *         work into no more than this number of tasks
+     */
+    virtual ui32 get_concurrency() = 0;
+
+    /**
+     *  @brief Creates a group, which the caller deletes when no longer
+     *         needed; a group is used for one batch of tasks at a time
+     */
+    virtual group* create_group() = 0;
+
+    /**
+     *  @brief Queues a task, as part of group g; the task is owned by the
+     *         caller, and lives until wait() returns
+     */
+    virtual void submit(thds::worker_thread_base* task, group* g) = 0;
+
+    /**
+     *  @brief Returns when all the tasks submitted to group g have
+     *         executed
+     */
+    virtual void wait(group* g) = 0;
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /**
+   *  @brief The executor of the bundled thread pool.
+   */
+  class OJPH_EXPORT thread_pool_executor : public executor
+  {
+  public:
+    /**
+     *  @brief Uses pool, which must outlive this object
+     */
+    explicit thread_pool_executor(thds::thread_pool* pool)
+    : pool(pool), own_pool(NULL) { }
+
+    /**
+     *  @brief Creates and uses a pool of num_threads threads
+     */
+    explicit thread_pool_executor(size_t num_threads);
+
+    ~thread_pool_executor() override;
+
+    ui32 get_concurrency() override;
+    group* create_group() override;
+    void submit(thds::worker_thread_base* task, group* g) override;
+    void wait(group* g) override;
+
+  private:
+    thds::thread_pool* pool;       // the pool in use
+    thds::thread_pool* own_pool;   // the pool created by this object
+  };
+
+}
+
+#endif // !OJPH_EXECUTOR_H
@@ -197,6 +197,14 @@ namespace ojph {
      */
     const ui8* get_data() const { return buf; }
 
+    /**
+     *  @brief Call this function to know the number of bytes of data in
+     *         the file; this can be larger than tell() after a seek.
+     *
+     *  @return the number of bytes written to the file.
+     */
+    size_t get_used_size() const { return used_size; }
+
     /** 
      *  @brief Call this function to write the memory file data to a file
 	   *
@@ -42,6 +42,7 @@
 #include <cstdlib>
 #include <cassert>
 #include <cstring>
+#include <mutex>
 #include <type_traits>
 
 #include "ojph_arch.h"
@@ -56,6 +57,7 @@ namespace ojph {
     {
       avail_obj = avail_data = store = NULL;
       avail_size_obj = avail_size_data = size_obj = size_data = 0;
+      capacity = 0;
     }
     ~mem_fixed_allocator()
     {
@@ -74,10 +76,20 @@ namespace ojph {
       pre_alloc_local<T, object_alignment>(num_ele, 0, size_obj);
     }
 
+    // the number of bytes that alloc() allocates, or has allocated
+    size_t get_size() const { return size_data + size_obj; }
+    size_t get_capacity() const { return capacity; }
+
     void alloc()
     {
-      assert(store == NULL);
-      avail_obj = store = malloc(size_data + size_obj);
+      assert(avail_obj == NULL);
+      if (store == NULL || capacity < size_data + size_obj)
+      {
+        if (store) free(store);
+        capacity = size_data + size_obj;
+        store = malloc(capacity);
+      }
+      avail_obj = store;
       avail_data = (ui8*)store + size_obj;
       if (store == NULL)
         throw "malloc failed";
@@ -85,6 +97,13 @@ namespace ojph {
       avail_size_data = size_data;
     }
 
+    // forgets all allocations, keeping the memory for the next alloc()
+    void restart()
+    {
+      avail_obj = avail_data = NULL;
+      avail_size_obj = avail_size_data = size_obj = size_data = 0;
+    }
+
     template<typename T>
     T* post_alloc_data(size_t num_ele, ui32 pre_size)
     {
@@ -103,7 +122,7 @@ namespace ojph {
     template<typename T, int N>
     void pre_alloc_local(size_t num_ele, ui32 pre_size, size_t& sz)
     {
-      assert(store == NULL);
+      assert(avail_obj == NULL);
       num_ele = calc_aligned_size<T, N>(num_ele);
       size_t total = (num_ele + pre_size) * sizeof(T);
       total += 2*N - 1;
@@ -115,7 +134,7 @@ namespace ojph {
     T* post_alloc_local(size_t num_ele, ui32 pre_size,
                         size_t& avail_sz, void*& avail_p)
     {
-      assert(store != NULL);
+      assert(avail_obj != NULL);
       num_ele = calc_aligned_size<T, N>(num_ele);
       size_t total = (num_ele + pre_size) * sizeof(T);
       total += 2*N - 1;
@@ -129,6 +148,7 @@ namespace ojph {
 
     void *store, *avail_data, *avail_obj;
     size_t size_data, size_obj, avail_size_obj, avail_size_data;
+    size_t capacity;         // bytes obtained from malloc
   };
 
   /////////////////////////////////////////////////////////////////////////////
@@ -139,7 +159,7 @@ namespace ojph {
       LFT_UNDEFINED  = 0x00, // Type is undefined/uninitialized
                              // These flags reflects data size in bytes
       LFT_BYTE       = 0x01, // Set when data is 1 byte  (not used)
-      LFT_16BIT      = 0x02, // Set when data is 2 bytes (not used)
+      LFT_16BIT      = 0x02, // Set when data is 2 bytes
       LFT_32BIT      = 0x04, // Set when data is 4 bytes
       LFT_64BIT      = 0x08, // Set when data is 8 bytes
       LFT_INTEGER    = 0x10, // Set when data is an integer, in other words
@@ -157,6 +177,7 @@ namespace ojph {
     ui32 pre_size;
     ui32 flags;
     union {
+      si16* i16;  // 16bit integer type, used for low bit-depth lossless
       si32* i32;  // 32bit integer type, used for lossless compression
       si64* i64;  // 64bit integer type, used for lossless compression
       float* f32; // float type, used for lossy compression
@@ -198,7 +219,11 @@ namespace ojph {
   public:
     mem_elastic_allocator(ui32 chunk_size)
     : chunk_size(chunk_size)
-    { cur_store = store = NULL; total_allocated = 0; }
+    {
+      cur_store = store = NULL; total_allocated = 0;
+      num_stores = 0; total_used = 0;
+      concurrent = false;
+    }
 
     ~mem_elastic_allocator()
     {
@@ -211,13 +236,39 @@ namespace ojph {
 
     void get_buffer(ui32 needed_bytes, coded_lists*& p);
 
+    // get_buffer() takes a lock only when concurrent is true, that is,
+    // when codeblocks are encoded by the threads of an executor
+    void set_concurrent(bool concurrent) { this->concurrent = concurrent; }
+
+    // forgets all buffers, keeping the chunks for the next get_buffer()
+    void restart()
+    {
+      for (stores_list* s = store; s != NULL; s = s->next_store)
+        s->restart();
+      cur_store = store;
+      total_used = 0;
+    }
+
+    ui32 get_chunk_size() const { return chunk_size; }
+    // bytes obtained from malloc for a chunk, including its header
+    ui32 get_chunk_footprint() const
+    { return stores_list::eval_store_bytes(chunk_size); }
+    size_t get_total_allocated() const { return total_allocated; }
+    size_t get_num_chunks() const { return num_stores; }
+    size_t get_total_used() const { return total_used; }
+
   private:
     struct stores_list
     {
       stores_list(ui32 available_bytes)
       {
         this->next_store = NULL;
-        this->available = available_bytes;
+        this->size = available_bytes;
+        restart();
+      }
+      void restart()
+      {
+        this->available = size;
         this->data = (ui8*)this + sizeof(stores_list);
       }
       static ui32 eval_store_bytes(ui32 available_bytes) 
@@ -225,13 +276,18 @@ namespace ojph {
         return available_bytes + (ui32)sizeof(stores_list);
       }
       stores_list *next_store;
+      ui32 size;
       ui32 available;
       ui8* data;
     };
 
     stores_list *store, *cur_store;
-    size_t total_allocated;
+    size_t total_allocated;  // bytes obtained from malloc
+    size_t num_stores;       // number of chunks obtained from malloc
+    size_t total_used;       // bytes handed out by get_buffer()
     const ui32 chunk_size;
+    bool concurrent;         // get_buffer() may be called by many threads
+    std::mutex mutex;        // used by get_buffer() if concurrent
   };
 
 
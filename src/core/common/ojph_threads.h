@@ -0,0 +1,285 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2024, Aous Naman
+// Copyright (c) 2024, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2024, The University of New South Wales, Australia
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_threads.h
+// Author: Aous Naman
+// Date: 22 April 2024
+//***************************************************************************/
+
+#ifndef OJPH_THREADS_H
+#define OJPH_THREADS_H
+
+#include <cstddef>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <type_traits>
+#include <utility>
+
+#include "ojph_arch.h"
+#include "ojph_defs.h"
+
+namespace ojph
+{
+class trace_sink;
+
+namespace thds
+{
+
+// defined here
+class thread_pool;
+
+// defined in ojph_threads.cpp
+namespace local {
+  class thread_pool;
+}
+
+/*****************************************************************************/
+/** @brief A base object for queuing tasks in the thread_pool
+ *
+ *  Tasks run in the thread_pool must derive from this function and define
+ *  \"execute\".  Derived objects can include their own member variables.
+ *
+ */
+class worker_thread_base
+{
+public:
+  /**
+   *  @brief virtual construction is a necessity to deconstruct derived
+   *  objects.
+   */
+  virtual ~worker_thread_base() { }
+
+  /**
+   *  @brief Derived functions must define this function to execute its work
+   */
+  virtual void execute() = 0;
+};
+
+/*****************************************************************************/
+/** @brief Task priorities; a thread looks for a high priority task in all
+ *         queues before it takes a normal one, and so on.
+ */
+enum task_priority : ui32
+{
+  PRIORITY_HIGH   = 0,
+  PRIORITY_NORMAL = 1,
+  PRIORITY_LOW    = 2,
+  NUM_PRIORITIES  = 3
+};
+
+/*****************************************************************************/
+/**
+ *  @brief Counts the tasks of a batch, so that their completion can be
+ *         awaited; this provides fork-join parallelism.
+ *
+ *  Tasks are added with add_task() (or by passing the group to
+ *  thread_pool::add_task() and thread_pool::submit()), and wait() returns
+ *  when all of them have executed.  While waiting, the calling thread
+ *  executes queued tasks of the thread pool, so that a task can wait for
+ *  the tasks it forks without tying up a worker thread.  A task_group can
+ *  be reused once wait() returns.
+ */
+class OJPH_EXPORT task_group
+{
+public:
+  /**
+   *  @brief constructor
+   *
+   *  @param pool the thread pool that executes the tasks of this group
+   */
+  task_group(thread_pool* pool) : pool(pool), pending(0) {}
+
+  /**
+   *  @brief default destructor; tasks must have completed by then
+   */
+  ~task_group() { wait(); }
+
+public:
+  /**
+   *  @brief Adds a task to the thread pool, as part of this group
+   *
+   *  @param task the task to add, must be derived from worker_thread_base
+   *  @param priority the priority of the task
+   */
+  void add_task(worker_thread_base* task,
+                task_priority priority = PRIORITY_NORMAL);
+
+  /**
+   *  @brief Returns when all the tasks of this group have executed
+   */
+  void wait();
+
+private:
+  friend class local::thread_pool;
+  void task_added();
+  void task_done();
+
+private:
+  thread_pool* pool;                  //!<the pool that runs the tasks
+  ui32 pending;                       //!<tasks yet to complete, guarded
+                                      //!<by mutex
+  std::mutex mutex;
+  std::condition_variable condition;  //!<notified when a task of this
+                                      //!<group is queued or completes
+};
+
+/*****************************************************************************/
+/**
+ *  @brief Implements a pool of threads, and can queue tasks.
+ *
+ *  Each thread has its own task queues, one for each priority.  A thread
+ *  takes the newest task from its own queues, and, when they are empty,
+ *  steals the oldest task of another thread, so that threads seldom
+ *  contend for one lock.  Tasks added by a thread of the pool go to its
+ *  own queues, and tasks added by other threads are spread over the
+ *  queues in turn.  Idle threads sleep until a task is added.
+ */
+class OJPH_EXPORT thread_pool
+{
+public:
+  /**
+   *  @brief default constructor
+   */
+  thread_pool();
+
+  /**
+   *  @brief default destructor; tasks that have not started are dropped
+   */
+  ~thread_pool();
+
+public:
+  /**
+   *  @brief Initializes the thread pool
+   *
+   *  @param num_threads the number of threads the thread pool holds; with
+   *         0 threads, tasks execute only in run_one() and
+   *         task_group::wait()
+   *  @param pin_threads if true, thread i is bound to logical CPU i,
+   *         modulo the number of CPUs; this is supported on Linux and
+   *         Windows, and ignored elsewhere
+   */
+  void init(size_t num_threads, bool pin_threads = false);
+
+  /**
+   *  @brief Records each task into a trace, on the track of the worker
+   *         that executed it; call before init() so that workers are named.
+   *
+   *  @param sink an open trace_sink that outlives the thread pool, or NULL
+   */
+  void set_trace_sink(trace_sink* sink);
+
+  /**
+   *  @brief Adds a task to the thread pool; the task is owned by the
+   *         caller, and must live until it is executed
+   *
+   *  @param task the task to added, must be derived from worker_thread_base
+   *  @param priority the priority of the task
+   *  @param group the group the task belongs to, or NULL
+   */
+  void add_task(worker_thread_base* task,
+                task_priority priority = PRIORITY_NORMAL,
+                task_group* group = NULL);
+
+  /**
+   *  @brief Adds a callable object, such as a lambda, to the thread pool,
+   *         and returns a future that receives its result, or the
+   *         exception it throws
+   *
+   *  @param f the callable object, taking no arguments
+   *  @param priority the priority of the task
+   *  @param group the group the task belongs to, or NULL
+   *  @return a future of the result of f
+   */
+  template <typename F>
+  std::future<decltype(std::declval<F&>()())>
+  submit(F f, task_priority priority = PRIORITY_NORMAL,
+         task_group* group = NULL)
+  {
+    typedef decltype(std::declval<F&>()()) R;
+    std::packaged_task<R()> t(std::move(f));
+    std::future<R> result = t.get_future();
+    queue_task(new packaged_task_adapter<R>(std::move(t)), priority,
+               group, true);
+    return result;
+  }
+
+  /**
+   *  @brief Executes one queued task in the calling thread, if there is
+   *         one
+   *
+   *  @return true if a task was executed
+   */
+  bool run_one();
+
+  /**
+   *  @brief Returns the number of threads in the thread pool
+   *
+   *  @retuen number of threads in the thread pool
+   */
+  size_t get_num_threads();
+
+private:
+  /** @brief Wraps a std::packaged_task, for submit() */
+  template <typename R>
+  class packaged_task_adapter : public worker_thread_base
+  {
+  public:
+    explicit packaged_task_adapter(std::packaged_task<R()>&& t)
+    : task(std::move(t)) {}
+    void execute() override { task(); }
+  private:
+    std::packaged_task<R()> task;
+  };
+
+private:
+  friend class task_group;
+
+  /**
+   *  @brief Queues a task, and wakes a sleeping thread
+   */
+  void queue_task(worker_thread_base* task, task_priority priority,
+                  task_group* group, bool owned);
+
+  /**
+   *  @brief Returns true if tasks are queued, of any group
+   */
+  bool has_queued_tasks();
+
+private:
+  local::thread_pool* state;              //!<the threads and their queues
+};
+
+} // !thds namespace
+} // !ojph namespace
+
+#endif // !OJPH_THREADS_H
@@ -0,0 +1,130 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// 
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_trace.h
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+
+#ifndef OJPH_TRACE_H
+#define OJPH_TRACE_H
+
+#include "ojph_arch.h"
+#include "ojph_defs.h"
+
+namespace ojph {
+
+  ////////////////////////////////////////////////////////////////////////////
+  //local prototyping
+  namespace local {
+    struct trace_state;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /**
+   *  @brief Records timed events into a file in the Chrome trace event
+   *         format, which can be opened in Perfetto (ui.perfetto.dev) or
+   *         chrome://tracing.
+   *
+   *  Each event has a begin and an end time, and is shown on the track of
+   *  the thread that recorded it; events recorded inside others on the same
+   *  thread are shown nested.  The object is thread-safe, so one sink can
+   *  be shared by many codestreams and by the worker threads that run them.
+   *
+   *  A codestream records events when given a sink through
+   *  ojph::codestream::set_trace_sink(); this requires the library to be
+   *  built with OJPH_ENABLE_STATS.  Applications can record their own
+   *  events through add_event().
+   */
+  class OJPH_EXPORT trace_sink
+  {
+  public:
+    trace_sink();
+    ~trace_sink();
+
+    /**
+     * @brief Creates the file and starts the trace; timestamps are
+     *        relative to this call.
+     *
+     * @param filename the name of the JSON file to write.
+     * @return true on success.
+     */
+    bool open(const char* filename);
+
+    /**
+     * @brief Completes the JSON document and closes the file.  Events
+     *        recorded after this call are dropped.
+     */
+    void close();
+
+    /**
+     * @brief Returns true between a successful open() and close().
+     */
+    bool is_open() const;
+
+    /**
+     * @brief Names the track of the calling thread, for example,
+     *        "worker 3".
+     */
+    void set_thread_name(const char* name);
+
+    /**
+     * @brief Records an event on the track of the calling thread.
+     *
+     * The ids identify what the event worked on; negative ids are
+     * omitted from the trace.
+     *
+     * @param name a short name for the event; must be a literal or
+     *             otherwise safe to embed in JSON without escaping.
+     * @param begin_ns begin time, as returned by now_ns().
+     * @param end_ns end time, as returned by now_ns().
+     * @param tile tile index.
+     * @param comp component number.
+     * @param res resolution number.
+     * @param row codeblock row.
+     */
+    void add_event(const char* name, ui64 begin_ns, ui64 end_ns,
+                   si32 tile = -1, si32 comp = -1, si32 res = -1,
+                   si32 row = -1);
+
+    /**
+     * @brief Returns a monotonic time in nanoseconds, for use with
+     *        add_event().
+     */
+    static ui64 now_ns();
+
+  private:
+    local::trace_state* state;
+  };
+
+}
+
+#endif // !OJPH_TRACE_H
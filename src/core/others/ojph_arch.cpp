@@ -35,9 +35,14 @@
 // Date: 28 August 2019
 //***************************************************************************/
 
+#include <atomic>
 #include <cassert>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 
 #include "ojph_arch.h"
+#include "ojph_message.h"
 
 namespace ojph {
 
@@ -239,12 +244,70 @@ namespace ojph {
   ////////////////////////////////////////////////////////////////////////////
   static int cpu_level;
   static bool cpu_level_initialized = init_cpu_ext_level(cpu_level);
+  // set by set_max_cpu_ext_level(), possibly while another thread reads it
+  static std::atomic<int> max_cpu_level(-1);
+
+  ////////////////////////////////////////////////////////////////////////////
+  // reads the limit from the OJPH_MAX_CPU_EXT_LEVEL environment variable
+  static int read_max_cpu_ext_level()
+  {
+    struct level_name { const char* name; int level; };
+    static const level_name names[] = {
+  #if defined(OJPH_ARCH_ARM)
+      { "generic", ARM_CPU_EXT_LEVEL_GENERIC },
+      { "neon", ARM_CPU_EXT_LEVEL_NEON },
+      { "asimd", ARM_CPU_EXT_LEVEL_ASIMD },
+      { "sve", ARM_CPU_EXT_LEVEL_SVE },
+      { "sve2", ARM_CPU_EXT_LEVEL_SVE2 },
+  #else
+      { "generic", X86_CPU_EXT_LEVEL_GENERIC },
+      { "mmx", X86_CPU_EXT_LEVEL_MMX },
+      { "sse", X86_CPU_EXT_LEVEL_SSE },
+      { "sse2", X86_CPU_EXT_LEVEL_SSE2 },
+      { "sse3", X86_CPU_EXT_LEVEL_SSE3 },
+      { "ssse3", X86_CPU_EXT_LEVEL_SSSE3 },
+      { "sse41", X86_CPU_EXT_LEVEL_SSE41 },
+      { "sse42", X86_CPU_EXT_LEVEL_SSE42 },
+      { "avx", X86_CPU_EXT_LEVEL_AVX },
+      { "avx2", X86_CPU_EXT_LEVEL_AVX2 },
+      { "avx2fma", X86_CPU_EXT_LEVEL_AVX2FMA },
+      { "avx512", X86_CPU_EXT_LEVEL_AVX512 },
+  #endif
+    };
+
+    const char* str = getenv("OJPH_MAX_CPU_EXT_LEVEL");
+    if (str == NULL || str[0] == '\0')
+      return INT_MAX;
+
+    char* end;
+    long val = strtol(str, &end, 10);
+    if (*end == '\0' && val >= 0 && val <= INT_MAX)
+      return (int)val;
+    for (size_t i = 0; i < sizeof(names) / sizeof(level_name); ++i)
+      if (strcmp(str, names[i].name) == 0)
+        return names[i].level;
+
+    OJPH_WARN(0x00090001, "OJPH_MAX_CPU_EXT_LEVEL is set to %s, which is "
+      "neither a number nor a known instruction set; it is ignored", str);
+    return INT_MAX;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void set_max_cpu_ext_level(int max_level)
+  {
+    max_cpu_level.store(max_level);
+  }
 
   ////////////////////////////////////////////////////////////////////////////
   int get_cpu_ext_level()
   {
     assert(cpu_level_initialized);
-    return cpu_level;
+    // the environment is read once, on the first call; changing the
+    // variable after that has no effect
+    static int env_max_level = read_max_cpu_ext_level();
+    int limit = max_cpu_level.load();
+    int max_level = limit >= 0 ? limit : env_max_level;
+    return cpu_level < max_level ? cpu_level : max_level;
   }
 
 }
@@ -0,0 +1,88 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_executor.cpp
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#include "ojph_executor.h"
+
+namespace ojph {
+
+  ////////////////////////////////////////////////////////////////////////////
+  // a task group of the bundled thread pool
+  class pool_group : public executor::group
+  {
+  public:
+    explicit pool_group(thds::thread_pool* pool) : tasks(pool) { }
+    thds::task_group tasks;
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  thread_pool_executor::thread_pool_executor(size_t num_threads)
+  {
+    own_pool = pool = new thds::thread_pool;
+    pool->init(num_threads);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  thread_pool_executor::~thread_pool_executor()
+  {
+    if (own_pool)
+      delete own_pool;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  ui32 thread_pool_executor::get_concurrency()
+  {
+    return (ui32)pool->get_num_threads() + 1;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  executor::group* thread_pool_executor::create_group()
+  {
+    return new pool_group(pool);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void thread_pool_executor::submit(thds::worker_thread_base* task,
+                                    group* g)
+  {
+    static_cast<pool_group*>(g)->tasks.add_task(task);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void thread_pool_executor::wait(group* g)
+  {
+    static_cast<pool_group*>(g)->tasks.wait();
+  }
+
+}
@@ -49,6 +49,16 @@ namespace ojph {
   //
   ////////////////////////////////////////////////////////////////////////////
 
+  ////////////////////////////////////////////////////////////////////////////
+  template<>
+  void line_buf::wrap(si16 *buffer, size_t num_ele, ui32 pre_size)
+  {
+    this->i16 = buffer;
+    this->size = num_ele;
+    this->pre_size = pre_size;
+    this->flags = LFT_16BIT | LFT_INTEGER;
+  }
+
   ////////////////////////////////////////////////////////////////////////////
   template<>
   void line_buf::wrap(si32 *buffer, size_t num_ele, ui32 pre_size)
@@ -90,6 +100,9 @@ namespace ojph {
   ////////////////////////////////////////////////////////////////////////////
   void mem_elastic_allocator::get_buffer(ui32 needed_bytes, coded_lists* &p)
   {
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    if (concurrent)
+      lock.lock();
     ui32 extended_bytes = needed_bytes + (ui32)sizeof(coded_lists);
 
     if (store == NULL)
@@ -99,18 +112,29 @@ namespace ojph {
       store = (stores_list*)malloc(store_bytes);
       cur_store = store = new (store) stores_list(bytes);
       total_allocated += store_bytes;
+      ++num_stores;
     }
 
     if (cur_store->available < extended_bytes)
     {
-      ui32 bytes = ojph_max(extended_bytes, chunk_size);
-      ui32 store_bytes = stores_list::eval_store_bytes(bytes);
-      cur_store->next_store = (stores_list*)malloc(store_bytes);
-      cur_store = new (cur_store->next_store) stores_list(bytes);
-      total_allocated += store_bytes;
+      // after a restart, the next store may already be there
+      stores_list* next = cur_store->next_store;
+      if (next != NULL && next->available >= extended_bytes)
+        cur_store = next;
+      else
+      {
+        ui32 bytes = ojph_max(extended_bytes, chunk_size);
+        ui32 store_bytes = stores_list::eval_store_bytes(bytes);
+        cur_store->next_store = (stores_list*)malloc(store_bytes);
+        cur_store = new (cur_store->next_store) stores_list(bytes);
+        cur_store->next_store = next;
+        total_allocated += store_bytes;
+        ++num_stores;
+      }
     }
 
     p = new (cur_store->data) coded_lists(needed_bytes);
+    total_used += needed_bytes;
 
     assert(cur_store->available >= extended_bytes);
     cur_store->available -= extended_bytes;
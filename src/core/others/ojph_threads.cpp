@@ -0,0 +1,479 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2024, Aous Naman
+// Copyright (c) 2024, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2024, The University of New South Wales, Australia
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_threads.cpp
+// Author: Aous Naman
+// Date: 22 April 2024
+//***************************************************************************/
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include "ojph_threads.h"
+#include "ojph_message.h"
+#include "ojph_trace.h"
+
+#ifdef OJPH_OS_LINUX
+  #include <pthread.h>
+  #include <sched.h>
+#elif defined(OJPH_OS_WINDOWS)
+  #include <windows.h>
+#endif
+
+namespace ojph
+{
+namespace thds
+{
+namespace local
+{
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/** @brief A queued task */
+struct entry {
+  worker_thread_base* task; //!<the task
+  task_group* group;        //!<the group of the task, or NULL
+  bool owned;               //!<true if the pool deletes the task
+};
+
+/** @brief The task queues of one thread */
+struct worker_queue {
+  worker_queue()
+  {
+    for (ui32 i = 0; i < NUM_PRIORITIES; ++i)
+      sizes[i].store(0, std::memory_order_relaxed);
+  }
+  std::mutex mutex;                         //!<guards tasks
+  std::deque<entry> tasks[NUM_PRIORITIES];  //!<one queue per priority
+  std::atomic<size_t> sizes[NUM_PRIORITIES];//!<sizes of tasks, read
+                                            //!<without the mutex
+};
+
+/*****************************************************************************/
+/**
+ *  @brief The threads of a thds::thread_pool, and their task queues
+ */
+class thread_pool
+{
+public:
+  thread_pool();
+  ~thread_pool();
+
+  void init(size_t num_threads, bool pin_threads);
+  void queue_task(worker_thread_base* task, task_priority priority,
+                  task_group* group, bool owned);
+  bool run_one();
+
+  /**
+   *  @brief Takes the highest priority task, preferring the newest task
+   *         in queue self, and the oldest task in other queues
+   *
+   *  @return true if a task was taken
+   */
+  bool take_task(size_t self, entry& e);
+
+  /**
+   *  @brief Executes a task taken by take_task
+   */
+  void execute(entry& e);
+
+  /**
+   *  @brief Binds thread i to logical CPU i, modulo the number of CPUs
+   */
+  void bind_to_cpus();
+
+  /**
+   *  @brief A static function to start a thread
+   *
+   *  @param tp a pointer to the thread pool
+   *  @param thread_idx the index of the thread, used to name it in traces
+   */
+  static void start_thread(thread_pool* tp, size_t thread_idx);
+
+public:
+  std::vector<std::thread> threads;
+  worker_queue* queues;                   //!<one per thread, or one if
+                                          //!<there are no threads
+  size_t num_queues;                      //!<number of entries in queues
+  std::atomic<size_t> num_queued;         //!<tasks in all queues
+  std::atomic<size_t> next_queue;         //!<queue of the next task added
+                                          //!<by a thread outside the pool
+  std::atomic<ui32> num_sleeping;         //!<threads waiting for tasks
+  std::mutex mutex;                       //!<used with condition
+  std::condition_variable condition;      //!<wakes sleeping threads
+  std::atomic_bool stop;
+  trace_sink* trace;
+};
+
+// the pool whose worker is the calling thread, and the worker's index
+static thread_local thread_pool* current_pool = NULL;
+static thread_local size_t current_idx = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+thread_pool::thread_pool() : queues(NULL), num_queues(0), trace(NULL)
+{
+  num_queued.store(0, std::memory_order_relaxed);
+  next_queue.store(0, std::memory_order_relaxed);
+  num_sleeping.store(0, std::memory_order_relaxed);
+  stop.store(false, std::memory_order_relaxed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+thread_pool::~thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop.store(true, std::memory_order_release);
+  }
+  condition.notify_all();
+  for (size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+
+  // drop the tasks that have not started
+  for (size_t q = 0; q < num_queues; ++q)
+    for (ui32 p = 0; p < NUM_PRIORITIES; ++p)
+      for (size_t i = 0; i < queues[q].tasks[p].size(); ++i)
+      {
+        entry& e = queues[q].tasks[p][i];
+        if (e.group)
+          e.group->task_done();
+        if (e.owned)
+          delete e.task;
+      }
+  delete[] queues;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void thread_pool::init(size_t num_threads, bool pin_threads)
+{
+  assert(queues == NULL);
+  num_queues = num_threads > 0 ? num_threads : 1;
+  queues = new worker_queue[num_queues];
+
+  threads.resize(num_threads);
+  for (size_t i = 0; i < num_threads; ++i)
+    threads[i] = std::thread(start_thread, this, i);
+
+  if (pin_threads && num_threads > 0)
+    bind_to_cpus();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void thread_pool::bind_to_cpus()
+{
+  size_t num_threads = threads.size();
+  size_t num_cpus = std::thread::hardware_concurrency();
+  num_cpus = num_cpus > 0 ? num_cpus : 1;
+  bool pinned = true;
+#ifdef OJPH_OS_LINUX
+  for (size_t i = 0; i < num_threads; ++i)
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(i % num_cpus, &set);
+    pinned = pinned && pthread_setaffinity_np(threads[i].native_handle(),
+                         sizeof(set), &set) == 0;
+  }
+#elif defined(OJPH_OS_WINDOWS)
+  size_t max_cpus = sizeof(DWORD_PTR) * 8;
+  num_cpus = num_cpus < max_cpus ? num_cpus : max_cpus;
+  for (size_t i = 0; i < num_threads; ++i)
+  {
+    DWORD_PTR mask = (DWORD_PTR)1 << (i % num_cpus);
+    pinned = pinned && SetThreadAffinityMask(
+      (HANDLE)threads[i].native_handle(), mask) != 0;
+  }
+#else
+  ojph_unused(num_threads);
+  pinned = false;
+#endif
+  if (!pinned)
+    OJPH_INFO(0x000A0001, "Could not bind the threads of the thread "
+      "pool to CPUs");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool thread_pool::run_one()
+{
+  entry e;
+  size_t self = current_pool == this ? current_idx : 0;
+  if (!take_task(self, e))
+    return false;
+  execute(e);
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void thread_pool::queue_task(worker_thread_base* task,
+                             task_priority priority,
+                             task_group* group, bool owned)
+{
+  assert(queues != NULL && priority < NUM_PRIORITIES);
+
+  size_t q;
+  if (current_pool == this)
+    q = current_idx;
+  else
+    q = next_queue.fetch_add(1, std::memory_order_relaxed) % num_queues;
+  // A sleeping thread counts itself in num_sleeping before it checks
+  // num_queued; with sequentially consistent operations, either it sees
+  // this task, or this thread sees it sleeping and wakes it.  num_queued
+  // is incremented first, so that it never drops below 0, and before
+  // the group is told, so that a thread waiting for the group finds
+  // num_queued non-zero when it wakes up
+  num_queued.fetch_add(1, std::memory_order_seq_cst);
+  if (group)
+    group->task_added();
+  worker_queue& wq = queues[q];
+  entry e = { task, group, owned };
+  wq.mutex.lock();
+  wq.tasks[priority].push_back(e);
+  wq.sizes[priority].store(wq.tasks[priority].size(),
+                           std::memory_order_relaxed);
+  wq.mutex.unlock();
+
+  if (num_sleeping.load(std::memory_order_seq_cst) != 0)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    condition.notify_one();
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool thread_pool::take_task(size_t self, entry& e)
+{
+  if (num_queued.load(std::memory_order_acquire) == 0)
+    return false;
+
+  for (ui32 p = 0; p < NUM_PRIORITIES; ++p)
+    for (size_t i = 0; i < num_queues; ++i)
+    {
+      size_t q = self + i < num_queues ? self + i : self + i - num_queues;
+      worker_queue& wq = queues[q];
+      if (wq.sizes[p].load(std::memory_order_relaxed) == 0)
+        continue;
+
+      std::lock_guard<std::mutex> lock(wq.mutex);
+      std::deque<entry>& tasks = wq.tasks[p];
+      if (tasks.empty())
+        continue;
+      if (i == 0) { // own queue, newest first
+        e = tasks.back();
+        tasks.pop_back();
+      }
+      else { // steal, oldest first
+        e = tasks.front();
+        tasks.pop_front();
+      }
+      wq.sizes[p].store(tasks.size(), std::memory_order_relaxed);
+      num_queued.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void thread_pool::execute(entry& e)
+{
+  if (trace)
+  {
+    ui64 begin_ns = trace_sink::now_ns();
+    e.task->execute();
+    trace->add_event("task", begin_ns, trace_sink::now_ns());
+  }
+  else
+    e.task->execute();
+  if (e.owned)
+    delete e.task;
+  if (e.group)
+    e.group->task_done();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void thread_pool::start_thread(thread_pool* tp, size_t thread_idx)
+{
+  current_pool = tp;
+  current_idx = thread_idx;
+  if (tp->trace)
+  {
+    char name[32];
+    snprintf(name, sizeof(name), "worker %zu", thread_idx);
+    tp->trace->set_thread_name(name);
+  }
+
+  while (!tp->stop.load(std::memory_order_acquire))
+  {
+    entry e;
+    if (tp->take_task(thread_idx, e))
+    {
+      tp->execute(e);
+      continue;
+    }
+
+    // sleep until a task is added
+    std::unique_lock<std::mutex> lock(tp->mutex);
+    tp->num_sleeping.fetch_add(1, std::memory_order_seq_cst);
+    while (!tp->stop.load(std::memory_order_acquire) &&
+           tp->num_queued.load(std::memory_order_seq_cst) == 0)
+      tp->condition.wait(lock);
+    tp->num_sleeping.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+} // !local namespace
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+void task_group::add_task(worker_thread_base* task, task_priority priority)
+{
+  pool->add_task(task, priority, this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void task_group::wait()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (pending != 0)
+  {
+    lock.unlock();
+    bool ran = pool->run_one();
+    lock.lock();
+    // task_added() and task_done() notify the condition, so we sleep
+    // until a task can be executed here, or the last task completes
+    if (!ran)
+      condition.wait(lock, [this]
+        { return pending == 0 || pool->has_queued_tasks(); });
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void task_group::task_added()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  ++pending;
+  condition.notify_all();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void task_group::task_done()
+{
+  // the mutex is held until notification, so that wait() cannot return,
+  // and the group be destroyed, before this function is done with it
+  std::lock_guard<std::mutex> lock(mutex);
+  assert(pending > 0);
+  if (--pending == 0)
+    condition.notify_all();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+thread_pool::thread_pool() : state(new local::thread_pool)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+thread_pool::~thread_pool()
+{
+  delete state;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void thread_pool::init(size_t num_threads, bool pin_threads)
+{
+  state->init(num_threads, pin_threads);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void thread_pool::set_trace_sink(trace_sink* sink)
+{
+  state->trace = sink;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void thread_pool::add_task(worker_thread_base* task, task_priority priority,
+                           task_group* group)
+{
+  state->queue_task(task, priority, group, false);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool thread_pool::run_one()
+{
+  return state->run_one();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t thread_pool::get_num_threads()
+{
+  return state->threads.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void thread_pool::queue_task(worker_thread_base* task,
+                             task_priority priority,
+                             task_group* group, bool owned)
+{
+  state->queue_task(task, priority, group, owned);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool thread_pool::has_queued_tasks()
+{
+  return state->num_queued.load(std::memory_order_seq_cst) != 0;
+}
+
+} // !thds namespace
+} // !ojph namespace
@@ -0,0 +1,177 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// 
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_trace.cpp
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ojph_trace.h"
+
+namespace ojph {
+
+  namespace local {
+
+    //////////////////////////////////////////////////////////////////////////
+    struct trace_state
+    {
+      trace_state() : fh(NULL), origin_ns(0), num_events(0) {}
+
+      // returns the track of the calling thread; mutex must be held
+      size_t get_thread_index()
+      {
+        std::thread::id id = std::this_thread::get_id();
+        for (size_t i = 0; i < threads.size(); ++i)
+          if (threads[i] == id)
+            return i;
+        threads.push_back(id);
+        return threads.size() - 1;
+      }
+
+      // starts a new event in the JSON array; mutex must be held
+      void separate()
+      {
+        fputs(num_events++ ? ",\n" : "\n", fh);
+      }
+
+      FILE *fh;
+      ui64 origin_ns;
+      ui64 num_events;
+      std::vector<std::thread::id> threads;
+      std::mutex mutex;
+    };
+
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  trace_sink::trace_sink()
+  {
+    state = new local::trace_state;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  trace_sink::~trace_sink()
+  {
+    close();
+    delete state;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  bool trace_sink::open(const char* filename)
+  {
+    close();
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->fh = fopen(filename, "wb");
+    if (state->fh == NULL)
+      return false;
+    state->origin_ns = now_ns();
+    state->num_events = 0;
+    state->threads.clear();
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", state->fh);
+    return true;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void trace_sink::close()
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (state->fh == NULL)
+      return;
+    fputs("\n]}\n", state->fh);
+    fclose(state->fh);
+    state->fh = NULL;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  bool trace_sink::is_open() const
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->fh != NULL;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void trace_sink::set_thread_name(const char* name)
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (state->fh == NULL)
+      return;
+    size_t tid = state->get_thread_index();
+    state->separate();
+    fprintf(state->fh, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+      "\"tid\":%zu,\"args\":{\"name\":\"%s\"}}", tid, name);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void trace_sink::add_event(const char* name, ui64 begin_ns, ui64 end_ns,
+                             si32 tile, si32 comp, si32 res, si32 row)
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (state->fh == NULL)
+      return;
+    size_t tid = state->get_thread_index();
+    // events that began before open() are clipped to the trace start
+    ui64 origin = state->origin_ns;
+    begin_ns = begin_ns > origin ? begin_ns - origin : 0;
+    end_ns = end_ns > origin ? end_ns - origin : 0;
+    ui64 dur_ns = end_ns > begin_ns ? end_ns - begin_ns : 0;
+
+    // timestamps are in microseconds
+    state->separate();
+    fprintf(state->fh, "{\"name\":\"%s\",\"cat\":\"ojph\",\"ph\":\"X\","
+      "\"pid\":1,\"tid\":%zu,\"ts\":%llu.%03u,\"dur\":%llu.%03u,\"args\":{",
+      name, tid, (unsigned long long)(begin_ns / 1000),
+      (unsigned)(begin_ns % 1000), (unsigned long long)(dur_ns / 1000),
+      (unsigned)(dur_ns % 1000));
+    const char* arg_names[4] = { "tile", "comp", "res", "row" };
+    si32 arg_values[4] = { tile, comp, res, row };
+    const char* sep = "";
+    for (int i = 0; i < 4; ++i)
+      if (arg_values[i] >= 0)
+      {
+        fprintf(state->fh, "%s\"%s\":%d", sep, arg_names[i], arg_values[i]);
+        sep = ",";
+      }
+    fputs("}}", state->fh);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  ui64 trace_sink::now_ns()
+  {
+    return (ui64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+}
@@ -105,14 +105,42 @@ namespace ojph {
        float *r, float *g, float *b, ui32 repeat) = NULL;
 
     //////////////////////////////////////////////////////////////////////////
-    static bool colour_transform_functions_initialized = false;
+    void (*irv_convert_to_fix16) (
+      const line_buf *src_line, ui32 src_line_offset,
+      line_buf *dst_line, ui32 bit_depth, bool is_signed, ui32 width) = NULL;
 
     //////////////////////////////////////////////////////////////////////////
-    void init_colour_transform_functions()
-    {
-      if (colour_transform_functions_initialized)
-        return;
+    void (*ict_forward_fix16)
+      (const si16 *r, const si16 *g, const si16 *b,
+       si16 *y, si16 *cb, si16 *cr, ui32 repeat) = NULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    void (*rev_convert_rct_forward)
+      (const line_buf *r, const line_buf *g, const line_buf *b,
+       ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+       si64 shift, ui32 repeat) = NULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    void (*rct_backward_rev_convert)
+      (const line_buf *y, const line_buf *cb, const line_buf *cr,
+       line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+       si64 shift, ui32 repeat) = NULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    void (*irv_convert_ict_forward)
+      (const line_buf *r, const line_buf *g, const line_buf *b,
+       ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+       ui32 bit_depth, bool is_signed, ui32 repeat) = NULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    void (*ict_backward_irv_convert)
+      (const line_buf *y, const line_buf *cb, const line_buf *cr,
+       line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+       ui32 bit_depth, bool is_signed, ui32 repeat) = NULL;
 
+    //////////////////////////////////////////////////////////////////////////
+    static bool set_colour_transform_functions()
+    {
 #if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
 
       rev_convert = gen_rev_convert;
@@ -125,6 +153,12 @@ namespace ojph {
       rct_backward = gen_rct_backward;
       ict_forward = gen_ict_forward;
       ict_backward = gen_ict_backward;
+      irv_convert_to_fix16 = gen_irv_convert_to_fix16;
+      ict_forward_fix16 = gen_ict_forward_fix16;
+      rev_convert_rct_forward = gen_rev_convert_rct_forward;
+      rct_backward_rev_convert = gen_rct_backward_rev_convert;
+      irv_convert_ict_forward = gen_irv_convert_ict_forward;
+      ict_backward_irv_convert = gen_ict_backward_irv_convert;
 
   #ifndef OJPH_DISABLE_SIMD
 
@@ -151,6 +185,10 @@ namespace ojph {
             sse2_irv_convert_to_float_nlt_type3;
           rct_forward = sse2_rct_forward;
           rct_backward = sse2_rct_backward;
+          rev_convert_rct_forward = sse2_rev_convert_rct_forward;
+          rct_backward_rev_convert = sse2_rct_backward_rev_convert;
+          irv_convert_ict_forward = sse2_irv_convert_ict_forward;
+          ict_backward_irv_convert = sse2_ict_backward_irv_convert;
         }
       #endif // !OJPH_DISABLE_SSE2
 
@@ -175,6 +213,12 @@ namespace ojph {
             avx2_irv_convert_to_float_nlt_type3;
           rct_forward = avx2_rct_forward;
           rct_backward = avx2_rct_backward;
+          irv_convert_to_fix16 = avx2_irv_convert_to_fix16;
+          ict_forward_fix16 = avx2_ict_forward_fix16;
+          rev_convert_rct_forward = avx2_rev_convert_rct_forward;
+          rct_backward_rev_convert = avx2_rct_backward_rev_convert;
+          irv_convert_ict_forward = avx2_irv_convert_ict_forward;
+          ict_backward_irv_convert = avx2_ict_backward_irv_convert;
         }
       #endif // !OJPH_DISABLE_AVX2
 
@@ -199,7 +243,16 @@ namespace ojph {
 
 #endif // !OJPH_ENABLE_WASM_SIMD
 
-      colour_transform_functions_initialized = true;
+      return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void init_colour_transform_functions()
+    {
+      // a function-local static is initialized exactly once, even when
+      // codestreams are created on several threads at the same time
+      static bool initialized = set_colour_transform_functions();
+      ojph_unused(initialized);
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -214,6 +267,11 @@ namespace ojph {
       float(2.0*double(ALPHA_RF)*(1.0-double(ALPHA_RF))/double(ALPHA_GF));
     const float CT_CNST::GAMMA_CB2B = float(2.0 * (1.0 - double(ALPHA_BF)));
     const float CT_CNST::GAMMA_CR2R = float(2.0 * (1.0 - double(ALPHA_RF)));
+    const si16 CT_CNST::ALPHA_RQ15 = (si16)(0.299 * 32768.0 + 0.5);
+    const si16 CT_CNST::ALPHA_GQ15 = (si16)(0.587 * 32768.0 + 0.5);
+    const si16 CT_CNST::ALPHA_BQ15 = (si16)(0.114 * 32768.0 + 0.5);
+    const si16 CT_CNST::BETA_CbQ15 = (si16)(0.5/(1-0.114) * 32768.0 + 0.5);
+    const si16 CT_CNST::BETA_CrQ15 = (si16)(0.5/(1-0.299) * 32768.0 + 0.5);
 
     //////////////////////////////////////////////////////////////////////////
 
@@ -235,6 +293,14 @@ namespace ojph {
           for (ui32 i = width; i > 0; --i)
             *dp++ = *sp++ + s;
         }
+        else if (dst_line->flags & line_buf::LFT_16BIT)
+        {
+          const si32 *sp = src_line->i32 + src_line_offset;
+          si16 *dp = dst_line->i16 + dst_line_offset;
+          si32 s = (si32)shift;
+          for (ui32 i = width; i > 0; --i)
+            *dp++ = (si16)(*sp++ + s);
+        }
         else
         {
           const si32 *sp = src_line->i32 + src_line_offset;
@@ -243,6 +309,15 @@ namespace ojph {
             *dp++ = *sp++ + shift;
         }
       }
+      else if (src_line->flags & line_buf::LFT_16BIT)
+      {
+        assert(dst_line->flags & line_buf::LFT_32BIT);
+        const si16 *sp = src_line->i16 + src_line_offset;
+        si32 *dp = dst_line->i32 + dst_line_offset;
+        si32 s = (si32)shift;
+        for (ui32 i = width; i > 0; --i)
+          *dp++ = *sp++ + s;
+      }
       else
       {
         assert(src_line->flags & line_buf::LFT_64BIT);
@@ -272,6 +347,16 @@ namespace ojph {
             *dp++ = v >= 0 ? v : (- v - s);
           }
         }
+        else if (dst_line->flags & line_buf::LFT_16BIT)
+        {
+          const si32 *sp = src_line->i32 + src_line_offset;
+          si16 *dp = dst_line->i16 + dst_line_offset;
+          si32 s = (si32)shift;
+          for (ui32 i = width; i > 0; --i) {
+            const si32 v = *sp++;
+            *dp++ = (si16)(v >= 0 ? v : (- v - s));
+          }
+        }
         else
         {
           const si32 *sp = src_line->i32 + src_line_offset;
@@ -282,6 +367,17 @@ namespace ojph {
           }
         }
       }
+      else if (src_line->flags & line_buf::LFT_16BIT)
+      {
+        assert(dst_line->flags & line_buf::LFT_32BIT);
+        const si16 *sp = src_line->i16 + src_line_offset;
+        si32 *dp = dst_line->i32 + dst_line_offset;
+        si32 s = (si32)shift;
+        for (ui32 i = width; i > 0; --i) {
+          const si32 v = *sp++;
+          *dp++ = v >= 0 ? v : (- v - s);
+        }
+      }
       else
       {
         assert(src_line->flags & line_buf::LFT_64BIT);
@@ -454,6 +550,24 @@ namespace ojph {
           *crp++ = (rr - gg);
         }
       }
+      else if (y->flags & line_buf::LFT_16BIT)
+      {
+        assert((y->flags  & line_buf::LFT_16BIT) &&
+               (cb->flags & line_buf::LFT_16BIT) &&
+               (cr->flags & line_buf::LFT_16BIT) &&
+               (r->flags  & line_buf::LFT_32BIT) &&
+               (g->flags  & line_buf::LFT_32BIT) &&
+               (b->flags  & line_buf::LFT_32BIT));
+        const si32 *rp = r->i32, *gp = g->i32, *bp = b->i32;
+        si16 *yp = y->i16, *cbp = cb->i16, *crp = cr->i16;
+        for (ui32 i = repeat; i > 0; --i)
+        {
+          si32 rr = *rp++, gg = *gp++, bb = *bp++;
+          *yp++ = (si16)((rr + (gg << 1) + bb) >> 2);
+          *cbp++ = (si16)(bb - gg);
+          *crp++ = (si16)(rr - gg);
+        }
+      }
       else
       {
         assert((y->flags  & line_buf::LFT_64BIT) &&
@@ -505,6 +619,25 @@ namespace ojph {
           *bp++ = cbb + gg;
         }
       }
+      else if (y->flags & line_buf::LFT_16BIT)
+      {
+        assert((y->flags  & line_buf::LFT_16BIT) &&
+               (cb->flags & line_buf::LFT_16BIT) &&
+               (cr->flags & line_buf::LFT_16BIT) &&
+               (r->flags  & line_buf::LFT_32BIT) &&
+               (g->flags  & line_buf::LFT_32BIT) &&
+               (b->flags  & line_buf::LFT_32BIT));
+        const si16 *yp = y->i16, *cbp = cb->i16, *crp = cr->i16;
+        si32 *rp = r->i32, *gp = g->i32, *bp = b->i32;
+        for (ui32 i = repeat; i > 0; --i)
+        {
+          si32 yy = *yp++, cbb = *cbp++, crr = *crp++;
+          si32 gg = yy - ((cbb + crr) >> 2);
+          *rp++ = crr + gg;
+          *gp++ = gg;
+          *bp++ = cbb + gg;
+        }
+      }
       else
       {
         assert((y->flags  & line_buf::LFT_64BIT) &&
@@ -552,6 +685,221 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void gen_irv_convert_to_fix16(const line_buf *src_line,
+      ui32 src_line_offset, line_buf *dst_line,
+      ui32 bit_depth, bool is_signed, ui32 width)
+    {
+      assert((src_line->flags & line_buf::LFT_32BIT) &&
+             (src_line->flags & line_buf::LFT_INTEGER) &&
+             (dst_line->flags & line_buf::LFT_16BIT));
+
+      assert(bit_depth <= IRV_FIX_FRAC_BITS);
+      const si32 mul = 1 << (IRV_FIX_FRAC_BITS - bit_depth);
+
+      const si32* sp = src_line->i32 + src_line_offset;
+      si16* dp = dst_line->i16;
+      const si32 half = is_signed ? 0 : (si32)(1ULL << (bit_depth - 1));
+      for (int i = (int)width; i > 0; --i)
+        *dp++ = (si16)((*sp++ - half) * mul);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // rounded Q15 multiplication, identical to _mm_mulhrs_epi16
+    static inline si16 gen_fix_mul(si16 v, si16 f)
+    {
+      return (si16)(((si32)v * f + 0x4000) >> 15);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    static inline si16 gen_fix_sat(si32 v)
+    {
+      return (si16)(v < -32768 ? -32768 : (v > 32767 ? 32767 : v));
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_ict_forward_fix16(const si16 *r, const si16 *g, const si16 *b,
+                               si16 *y, si16 *cb, si16 *cr, ui32 repeat)
+    {
+      for (ui32 i = repeat; i > 0; --i)
+      {
+        si16 t = gen_fix_sat(gen_fix_mul(*r, CT_CNST::ALPHA_RQ15)
+                           + gen_fix_mul(*g++, CT_CNST::ALPHA_GQ15));
+        *y = gen_fix_sat(t + gen_fix_mul(*b, CT_CNST::ALPHA_BQ15));
+        *cb++ = gen_fix_mul(gen_fix_sat(*b++ - *y), CT_CNST::BETA_CbQ15);
+        *cr++ = gen_fix_mul(gen_fix_sat(*r++ - *y++), CT_CNST::BETA_CrQ15);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_rev_convert_rct_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      si64 shift, ui32 repeat)
+    {
+      assert((r->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) &&
+             (cb->flags & line_buf::LFT_INTEGER) &&
+             (cr->flags & line_buf::LFT_INTEGER));
+
+      const si32 *rp = r->i32 + src_line_offset;
+      const si32 *gp = g->i32 + src_line_offset;
+      const si32 *bp = b->i32 + src_line_offset;
+      si32 s = (si32)shift;
+      if (y->flags & line_buf::LFT_32BIT)
+      {
+        si32 *yp = y->i32, *cbp = cb->i32, *crp = cr->i32;
+        for (ui32 i = repeat; i > 0; --i)
+        {
+          si32 rr = *rp++ + s, gg = *gp++ + s, bb = *bp++ + s;
+          *yp++ = (rr + (gg << 1) + bb) >> 2;
+          *cbp++ = (bb - gg);
+          *crp++ = (rr - gg);
+        }
+      }
+      else
+      {
+        assert(y->flags & line_buf::LFT_16BIT);
+        si16 *yp = y->i16, *cbp = cb->i16, *crp = cr->i16;
+        for (ui32 i = repeat; i > 0; --i)
+        {
+          si32 rr = *rp++ + s, gg = *gp++ + s, bb = *bp++ + s;
+          *yp++ = (si16)((rr + (gg << 1) + bb) >> 2);
+          *cbp++ = (si16)(bb - gg);
+          *crp++ = (si16)(rr - gg);
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_rct_backward_rev_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      si64 shift, ui32 repeat)
+    {
+      assert((y->flags  & line_buf::LFT_INTEGER) &&
+             (cb->flags & line_buf::LFT_INTEGER) &&
+             (cr->flags & line_buf::LFT_INTEGER) &&
+             (r->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_32BIT));
+
+      si32 *rp = r->i32 + dst_line_offset;
+      si32 *gp = g->i32 + dst_line_offset;
+      si32 *bp = b->i32 + dst_line_offset;
+      si32 s = (si32)shift;
+      if (y->flags & line_buf::LFT_32BIT)
+      {
+        const si32 *yp = y->i32, *cbp = cb->i32, *crp = cr->i32;
+        for (ui32 i = repeat; i > 0; --i)
+        {
+          si32 yy = *yp++, cbb = *cbp++, crr = *crp++;
+          si32 gg = yy - ((cbb + crr) >> 2);
+          *rp++ = crr + gg + s;
+          *gp++ = gg + s;
+          *bp++ = cbb + gg + s;
+        }
+      }
+      else
+      {
+        assert(y->flags & line_buf::LFT_16BIT);
+        const si16 *yp = y->i16, *cbp = cb->i16, *crp = cr->i16;
+        for (ui32 i = repeat; i > 0; --i)
+        {
+          si32 yy = *yp++, cbb = *cbp++, crr = *crp++;
+          si32 gg = yy - ((cbb + crr) >> 2);
+          *rp++ = crr + gg + s;
+          *gp++ = gg + s;
+          *bp++ = cbb + gg + s;
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_irv_convert_ict_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      ui32 bit_depth, bool is_signed, ui32 repeat)
+    {
+      assert((r->flags  & line_buf::LFT_32BIT) &&
+             (r->flags  & line_buf::LFT_INTEGER) &&
+             (y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) == 0);
+
+      assert(bit_depth <= 32);
+      float mul = (float)(1.0 / (double)(1ULL << bit_depth));
+      const si32 half = is_signed ? 0 : (si32)(1ULL << (bit_depth - 1));
+
+      const si32 *rp = r->i32 + src_line_offset;
+      const si32 *gp = g->i32 + src_line_offset;
+      const si32 *bp = b->i32 + src_line_offset;
+      float *yp = y->f32, *cbp = cb->f32, *crp = cr->f32;
+      for (ui32 i = repeat; i > 0; --i)
+      {
+        float rr = (float)(*rp++ - half) * mul;
+        float gg = (float)(*gp++ - half) * mul;
+        float bb = (float)(*bp++ - half) * mul;
+        float yy = CT_CNST::ALPHA_RF * rr
+                 + CT_CNST::ALPHA_GF * gg
+                 + CT_CNST::ALPHA_BF * bb;
+        *yp++ = yy;
+        *cbp++ = CT_CNST::BETA_CbF * (bb - yy);
+        *crp++ = CT_CNST::BETA_CrF * (rr - yy);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // same as the conversion in local_gen_irv_convert_to_integer
+    static inline si32 gen_float_to_si32(float t, float fl_low_lim, 
+      float fl_up_lim, si32 s32_low_lim, si32 s32_up_lim)
+    {
+      si32 v = ojph_round(t);
+      v = t >= fl_low_lim ? v : s32_low_lim;
+      v = t <  fl_up_lim  ? v : s32_up_lim;
+      return v;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_ict_backward_irv_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      ui32 bit_depth, bool is_signed, ui32 repeat)
+    {
+      assert((y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) == 0 &&
+             (r->flags  & line_buf::LFT_32BIT) &&
+             (r->flags  & line_buf::LFT_INTEGER));
+
+      assert(bit_depth <= 32);
+      si32 neg_limit = (si32)INT_MIN >> (32 - bit_depth);
+      float mul = (float)(1ull << bit_depth);
+      float fl_up_lim = -(float)neg_limit; // val < upper
+      float fl_low_lim = (float)neg_limit; // val >= lower
+      si32 s32_up_lim = INT_MAX >> (32 - bit_depth);
+      si32 s32_low_lim = INT_MIN >> (32 - bit_depth);
+      const si32 half = is_signed ? 0 : (si32)(1ULL << (bit_depth - 1));
+
+      const float *yp = y->f32, *cbp = cb->f32, *crp = cr->f32;
+      si32 *rp = r->i32 + dst_line_offset;
+      si32 *gp = g->i32 + dst_line_offset;
+      si32 *bp = b->i32 + dst_line_offset;
+      for (ui32 i = repeat; i > 0; --i)
+      {
+        float yy = *yp++, cbb = *cbp++, crr = *crp++;
+        float gg = yy - CT_CNST::GAMMA_CR2G * crr - CT_CNST::GAMMA_CB2G * cbb;
+        float rr = yy + CT_CNST::GAMMA_CR2R * crr;
+        float bb = yy + CT_CNST::GAMMA_CB2B * cbb;
+        *rp++ = gen_float_to_si32(rr * mul, fl_low_lim, fl_up_lim,
+                                  s32_low_lim, s32_up_lim) + half;
+        *gp++ = gen_float_to_si32(gg * mul, fl_low_lim, fl_up_lim,
+                                  s32_low_lim, s32_up_lim) + half;
+        *bp++ = gen_float_to_si32(bb * mul, fl_low_lim, fl_up_lim,
+                                  s32_low_lim, s32_up_lim) + half;
+      }
+    }
+
 #endif // !OJPH_ENABLE_WASM_SIMD
 
   }
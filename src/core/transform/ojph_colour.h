@@ -101,6 +101,51 @@ namespace ojph {
   extern void (*ict_backward)
     (const float *y, const float *cb, const float *cr,
      float *r, float *g, float *b, ui32 repeat);
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Fused conversion and colour transform; these combine the DC level
+  // shift (or integer/float conversion) with the colour transform, moving
+  // samples directly between the codestream lines and the first
+  // resolution lines.  The transform lines must be 16- or 32-bit.
+  ////////////////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*rev_convert_rct_forward)
+    (const line_buf *r, const line_buf *g, const line_buf *b,
+     ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+     si64 shift, ui32 repeat);
+
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*rct_backward_rev_convert)
+    (const line_buf *y, const line_buf *cb, const line_buf *cr,
+     line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+     si64 shift, ui32 repeat);
+
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*irv_convert_ict_forward)
+    (const line_buf *r, const line_buf *g, const line_buf *b,
+     ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+     ui32 bit_depth, bool is_signed, ui32 repeat);
+
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*ict_backward_irv_convert)
+    (const line_buf *y, const line_buf *cb, const line_buf *cr,
+     line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+     ui32 bit_depth, bool is_signed, ui32 repeat);
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Fixed-point irreversible path, see ojph_transform.h; encoding only
+  ////////////////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*irv_convert_to_fix16) (
+    const line_buf *src_line, ui32 src_line_offset,
+    line_buf *dst_line, ui32 bit_depth, bool is_signed, ui32 width);
+
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*ict_forward_fix16)
+    (const si16 *r, const si16 *g, const si16 *b,
+     si16 *y, si16 *cb, si16 *cr, ui32 repeat);
   }
 }
 
@@ -44,6 +44,7 @@
 #include "ojph_defs.h"
 #include "ojph_mem.h"
 #include "ojph_colour.h"
+#include "ojph_colour_local.h"
 
 #include <immintrin.h>
 
@@ -63,6 +64,15 @@ namespace ojph {
       return result;
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    static inline
+    __m128i avx2_packs_epi32(__m256i a)
+    {
+      // narrows 8 32bit integers to 16bit, with saturation
+      return _mm_packs_epi32(_mm256_castsi256_si128(a),
+                             _mm256_extracti128_si256(a, 1));
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void avx2_rev_convert(const line_buf *src_line,
                           const ui32 src_line_offset,
@@ -84,6 +94,18 @@ namespace ojph {
             _mm256_storeu_si256((__m256i*)dp, s);
           }
         }
+        else if (dst_line->flags & line_buf::LFT_16BIT)
+        {
+          const si32 *sp = src_line->i32 + src_line_offset;
+          si16 *dp = dst_line->i16 + dst_line_offset;
+          __m256i sh = _mm256_set1_epi32((si32)shift);
+          for (int i = (width + 7) >> 3; i > 0; --i, sp+=8, dp+=8)
+          {
+            __m256i s = _mm256_loadu_si256((__m256i*)sp);
+            s = _mm256_add_epi32(s, sh);
+            _mm_storeu_si128((__m128i*)dp, avx2_packs_epi32(s));
+          }
+        }
         else
         {
           const si32 *sp = src_line->i32 + src_line_offset;
@@ -104,6 +126,19 @@ namespace ojph {
           }
         }
       }
+      else if (src_line->flags & line_buf::LFT_16BIT)
+      {
+        assert(dst_line->flags & line_buf::LFT_32BIT);
+        const si16 *sp = src_line->i16 + src_line_offset;
+        si32 *dp = dst_line->i32 + dst_line_offset;
+        __m256i sh = _mm256_set1_epi32((si32)shift);
+        for (int i = (width + 7) >> 3; i > 0; --i, sp+=8, dp+=8)
+        {
+          __m256i s = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*)sp));
+          s = _mm256_add_epi32(s, sh);
+          _mm256_storeu_si256((__m256i*)dp, s);
+        }
+      }
       else
       {
         assert(src_line->flags | line_buf::LFT_64BIT);
@@ -161,6 +196,23 @@ namespace ojph {
             _mm256_storeu_si256((__m256i*)dp, s);
           }
         }
+        else if (dst_line->flags & line_buf::LFT_16BIT)
+        {
+          const si32 *sp = src_line->i32 + src_line_offset;
+          si16 *dp = dst_line->i16 + dst_line_offset;
+          __m256i sh = _mm256_set1_epi32((si32)(-shift));
+          __m256i zero = _mm256_setzero_si256();
+          for (int i = (width + 7) >> 3; i > 0; --i, sp += 8, dp += 8)
+          {
+            __m256i s = _mm256_loadu_si256((__m256i*)sp);
+            __m256i c = _mm256_cmpgt_epi32(zero, s);  // 0xFFFFFFFF for -ve val
+            __m256i v_m_sh = _mm256_sub_epi32(sh, s); // - shift - value
+            v_m_sh = _mm256_and_si256(c, v_m_sh);     // keep only -shift-val
+            s = _mm256_andnot_si256(c, s);            // keep only +ve or 0
+            s = _mm256_or_si256(s, v_m_sh);           // combine
+            _mm_storeu_si128((__m128i*)dp, avx2_packs_epi32(s));
+          }
+        }
         else
         {
           const si32 *sp = src_line->i32 + src_line_offset;
@@ -197,6 +249,24 @@ namespace ojph {
           }
         }
       }
+      else if (src_line->flags & line_buf::LFT_16BIT)
+      {
+        assert(dst_line->flags & line_buf::LFT_32BIT);
+        const si16 *sp = src_line->i16 + src_line_offset;
+        si32 *dp = dst_line->i32 + dst_line_offset;
+        __m256i sh = _mm256_set1_epi32((si32)(-shift));
+        __m256i zero = _mm256_setzero_si256();
+        for (int i = (width + 7) >> 3; i > 0; --i, sp += 8, dp += 8)
+        {
+          __m256i s = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*)sp));
+          __m256i c = _mm256_cmpgt_epi32(zero, s);  // 0xFFFFFFFF for -ve val
+          __m256i v_m_sh = _mm256_sub_epi32(sh, s); // - shift - value
+          v_m_sh = _mm256_and_si256(c, v_m_sh);     // keep only -shift-val
+          s = _mm256_andnot_si256(c, s);            // keep only +ve or 0
+          s = _mm256_or_si256(s, v_m_sh);           // combine
+          _mm256_storeu_si256((__m256i*)dp, s);
+        }
+      }
       else
       {
         assert(src_line->flags | line_buf::LFT_64BIT);
@@ -457,6 +527,34 @@ namespace ojph {
           yp += 8; cbp += 8; crp += 8;
         }
       }
+      else if (y->flags & line_buf::LFT_16BIT)
+      {
+        assert((y->flags  & line_buf::LFT_16BIT) &&
+               (cb->flags & line_buf::LFT_16BIT) &&
+               (cr->flags & line_buf::LFT_16BIT) &&
+               (r->flags  & line_buf::LFT_32BIT) &&
+               (g->flags  & line_buf::LFT_32BIT) &&
+               (b->flags  & line_buf::LFT_32BIT));
+        const si32 *rp = r->i32, * gp = g->i32, * bp = b->i32;
+        si16 *yp = y->i16, * cbp = cb->i16, * crp = cr->i16;
+        for (int i = (repeat + 7) >> 3; i > 0; --i)
+        {
+          __m256i mr = _mm256_load_si256((__m256i*)rp);
+          __m256i mg = _mm256_load_si256((__m256i*)gp);
+          __m256i mb = _mm256_load_si256((__m256i*)bp);
+          __m256i t = _mm256_add_epi32(mr, mb);
+          t = _mm256_add_epi32(t, _mm256_slli_epi32(mg, 1));
+          t = _mm256_srai_epi32(t, 2);
+          _mm_store_si128((__m128i*)yp, avx2_packs_epi32(t));
+          t = _mm256_sub_epi32(mb, mg);
+          _mm_store_si128((__m128i*)cbp, avx2_packs_epi32(t));
+          t = _mm256_sub_epi32(mr, mg);
+          _mm_store_si128((__m128i*)crp, avx2_packs_epi32(t));
+
+          rp += 8; gp += 8; bp += 8;
+          yp += 8; cbp += 8; crp += 8;
+        }
+      }
       else
       {
         assert((y->flags  & line_buf::LFT_64BIT) &&
@@ -548,6 +646,34 @@ namespace ojph {
           rp += 8; gp += 8; bp += 8;
         }
       }
+      else if (y->flags & line_buf::LFT_16BIT)
+      {
+        assert((y->flags  & line_buf::LFT_16BIT) &&
+               (cb->flags & line_buf::LFT_16BIT) &&
+               (cr->flags & line_buf::LFT_16BIT) &&
+               (r->flags  & line_buf::LFT_32BIT) &&
+               (g->flags  & line_buf::LFT_32BIT) &&
+               (b->flags  & line_buf::LFT_32BIT));
+        const si16 *yp = y->i16, *cbp = cb->i16, *crp = cr->i16;
+        si32 *rp = r->i32, *gp = g->i32, *bp = b->i32;
+        for (int i = (repeat + 7) >> 3; i > 0; --i)
+        {
+          __m256i my  = _mm256_cvtepi16_epi32(_mm_load_si128((__m128i*)yp));
+          __m256i mcb = _mm256_cvtepi16_epi32(_mm_load_si128((__m128i*)cbp));
+          __m256i mcr = _mm256_cvtepi16_epi32(_mm_load_si128((__m128i*)crp));
+
+          __m256i t = _mm256_add_epi32(mcb, mcr);
+          t = _mm256_sub_epi32(my, _mm256_srai_epi32(t, 2));
+          _mm256_store_si256((__m256i*)gp, t);
+          __m256i u = _mm256_add_epi32(mcb, t);
+          _mm256_store_si256((__m256i*)bp, u);
+          u = _mm256_add_epi32(mcr, t);
+          _mm256_store_si256((__m256i*)rp, u);
+
+          yp += 8; cbp += 8; crp += 8;
+          rp += 8; gp += 8; bp += 8;
+        }
+      }
       else
       {
         assert((y->flags  & line_buf::LFT_64BIT) &&
@@ -617,6 +743,298 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_irv_convert_to_fix16(const line_buf *src_line,
+      ui32 src_line_offset, line_buf *dst_line,
+      ui32 bit_depth, bool is_signed, ui32 width)
+    {
+      assert((src_line->flags & line_buf::LFT_32BIT) &&
+             (src_line->flags & line_buf::LFT_INTEGER) &&
+             (dst_line->flags & line_buf::LFT_16BIT));
+
+      assert(bit_depth <= IRV_FIX_FRAC_BITS);
+      int shift = IRV_FIX_FRAC_BITS - (int)bit_depth;
+
+      const si32* sp = src_line->i32 + src_line_offset;
+      si16* dp = dst_line->i16;
+      __m256i half = 
+        _mm256_set1_epi32(is_signed ? 0 : (si32)(1ULL << (bit_depth - 1)));
+      for (int i = (int)width; i > 0; i -= 16, sp += 16, dp += 16) {
+        __m256i t0 = _mm256_loadu_si256((__m256i*)sp);
+        __m256i t1 = _mm256_loadu_si256((__m256i*)sp + 1);
+        t0 = _mm256_slli_epi32(_mm256_sub_epi32(t0, half), shift);
+        t1 = _mm256_slli_epi32(_mm256_sub_epi32(t1, half), shift);
+        // packs works within 128-bit lanes; restore the order
+        __m256i v = _mm256_packs_epi32(t0, t1);
+        v = _mm256_permute4x64_epi64(v, 0xD8);
+        _mm256_storeu_si256((__m256i*)dp, v);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_ict_forward_fix16(const si16 *r, const si16 *g, const si16 *b,
+                                si16 *y, si16 *cb, si16 *cr, ui32 repeat)
+    {
+      __m256i alpha_r = _mm256_set1_epi16(CT_CNST::ALPHA_RQ15);
+      __m256i alpha_g = _mm256_set1_epi16(CT_CNST::ALPHA_GQ15);
+      __m256i alpha_b = _mm256_set1_epi16(CT_CNST::ALPHA_BQ15);
+      __m256i beta_cb = _mm256_set1_epi16(CT_CNST::BETA_CbQ15);
+      __m256i beta_cr = _mm256_set1_epi16(CT_CNST::BETA_CrQ15);
+      for (int i = (int)repeat; i > 0; i -= 16, 
+           r += 16, g += 16, b += 16, y += 16, cb += 16, cr += 16)
+      {
+        __m256i mr = _mm256_loadu_si256((__m256i*)r);
+        __m256i mg = _mm256_loadu_si256((__m256i*)g);
+        __m256i mb = _mm256_loadu_si256((__m256i*)b);
+        __m256i t = _mm256_adds_epi16(_mm256_mulhrs_epi16(mr, alpha_r),
+                                      _mm256_mulhrs_epi16(mg, alpha_g));
+        __m256i my = _mm256_adds_epi16(t, _mm256_mulhrs_epi16(mb, alpha_b));
+        __m256i mcb = _mm256_subs_epi16(mb, my);
+        __m256i mcr = _mm256_subs_epi16(mr, my);
+        _mm256_storeu_si256((__m256i*)y, my);
+        _mm256_storeu_si256((__m256i*)cb, _mm256_mulhrs_epi16(mcb, beta_cb));
+        _mm256_storeu_si256((__m256i*)cr, _mm256_mulhrs_epi16(mcr, beta_cr));
+      }
+    }
+
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_rev_convert_rct_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      si64 shift, ui32 repeat)
+    {
+      assert((r->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) &&
+             (cb->flags & line_buf::LFT_INTEGER) &&
+             (cr->flags & line_buf::LFT_INTEGER));
+
+      const si32 *rp = r->i32 + src_line_offset;
+      const si32 *gp = g->i32 + src_line_offset;
+      const si32 *bp = b->i32 + src_line_offset;
+      __m256i sh = _mm256_set1_epi32((si32)shift);
+      if (y->flags & line_buf::LFT_32BIT)
+      {
+        si32 *yp = y->i32, *cbp = cb->i32, *crp = cr->i32;
+        for (int i = (repeat + 7) >> 3; i > 0; --i)
+        {
+          __m256i mr = _mm256_loadu_si256((__m256i*)rp);
+          __m256i mg = _mm256_loadu_si256((__m256i*)gp);
+          __m256i mb = _mm256_loadu_si256((__m256i*)bp);
+          mr = _mm256_add_epi32(mr, sh);
+          mg = _mm256_add_epi32(mg, sh);
+          mb = _mm256_add_epi32(mb, sh);
+          __m256i t = _mm256_add_epi32(mr, mb);
+          t = _mm256_add_epi32(t, _mm256_slli_epi32(mg, 1));
+          _mm256_store_si256((__m256i*)yp, _mm256_srai_epi32(t, 2));
+          t = _mm256_sub_epi32(mb, mg);
+          _mm256_store_si256((__m256i*)cbp, t);
+          t = _mm256_sub_epi32(mr, mg);
+          _mm256_store_si256((__m256i*)crp, t);
+
+          rp += 8; gp += 8; bp += 8;
+          yp += 8; cbp += 8; crp += 8;
+        }
+      }
+      else
+      {
+        assert(y->flags & line_buf::LFT_16BIT);
+        si16 *yp = y->i16, *cbp = cb->i16, *crp = cr->i16;
+        for (int i = (repeat + 7) >> 3; i > 0; --i)
+        {
+          __m256i mr = _mm256_loadu_si256((__m256i*)rp);
+          __m256i mg = _mm256_loadu_si256((__m256i*)gp);
+          __m256i mb = _mm256_loadu_si256((__m256i*)bp);
+          mr = _mm256_add_epi32(mr, sh);
+          mg = _mm256_add_epi32(mg, sh);
+          mb = _mm256_add_epi32(mb, sh);
+          __m256i t = _mm256_add_epi32(mr, mb);
+          t = _mm256_add_epi32(t, _mm256_slli_epi32(mg, 1));
+          t = _mm256_srai_epi32(t, 2);
+          _mm_store_si128((__m128i*)yp, avx2_packs_epi32(t));
+          t = _mm256_sub_epi32(mb, mg);
+          _mm_store_si128((__m128i*)cbp, avx2_packs_epi32(t));
+          t = _mm256_sub_epi32(mr, mg);
+          _mm_store_si128((__m128i*)crp, avx2_packs_epi32(t));
+
+          rp += 8; gp += 8; bp += 8;
+          yp += 8; cbp += 8; crp += 8;
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_rct_backward_rev_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      si64 shift, ui32 repeat)
+    {
+      assert((y->flags  & line_buf::LFT_INTEGER) &&
+             (cb->flags & line_buf::LFT_INTEGER) &&
+             (cr->flags & line_buf::LFT_INTEGER) &&
+             (r->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_32BIT));
+
+      si32 *rp = r->i32 + dst_line_offset;
+      si32 *gp = g->i32 + dst_line_offset;
+      si32 *bp = b->i32 + dst_line_offset;
+      __m256i sh = _mm256_set1_epi32((si32)shift);
+      if (y->flags & line_buf::LFT_32BIT)
+      {
+        const si32 *yp = y->i32, *cbp = cb->i32, *crp = cr->i32;
+        for (int i = (repeat + 7) >> 3; i > 0; --i)
+        {
+          __m256i my  = _mm256_load_si256((__m256i*)yp);
+          __m256i mcb = _mm256_load_si256((__m256i*)cbp);
+          __m256i mcr = _mm256_load_si256((__m256i*)crp);
+
+          __m256i t = _mm256_add_epi32(mcb, mcr);
+          t = _mm256_sub_epi32(my, _mm256_srai_epi32(t, 2));
+          __m256i u = _mm256_add_epi32(mcb, t);
+          _mm256_storeu_si256((__m256i*)bp, _mm256_add_epi32(u, sh));
+          u = _mm256_add_epi32(mcr, t);
+          _mm256_storeu_si256((__m256i*)rp, _mm256_add_epi32(u, sh));
+          _mm256_storeu_si256((__m256i*)gp, _mm256_add_epi32(t, sh));
+
+          yp += 8; cbp += 8; crp += 8;
+          rp += 8; gp += 8; bp += 8;
+        }
+      }
+      else
+      {
+        assert(y->flags & line_buf::LFT_16BIT);
+        const si16 *yp = y->i16, *cbp = cb->i16, *crp = cr->i16;
+        for (int i = (repeat + 7) >> 3; i > 0; --i)
+        {
+          __m256i my  = _mm256_cvtepi16_epi32(_mm_load_si128((__m128i*)yp));
+          __m256i mcb = _mm256_cvtepi16_epi32(_mm_load_si128((__m128i*)cbp));
+          __m256i mcr = _mm256_cvtepi16_epi32(_mm_load_si128((__m128i*)crp));
+
+          __m256i t = _mm256_add_epi32(mcb, mcr);
+          t = _mm256_sub_epi32(my, _mm256_srai_epi32(t, 2));
+          __m256i u = _mm256_add_epi32(mcb, t);
+          _mm256_storeu_si256((__m256i*)bp, _mm256_add_epi32(u, sh));
+          u = _mm256_add_epi32(mcr, t);
+          _mm256_storeu_si256((__m256i*)rp, _mm256_add_epi32(u, sh));
+          _mm256_storeu_si256((__m256i*)gp, _mm256_add_epi32(t, sh));
+
+          yp += 8; cbp += 8; crp += 8;
+          rp += 8; gp += 8; bp += 8;
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_irv_convert_ict_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      ui32 bit_depth, bool is_signed, ui32 repeat)
+    {
+      assert((r->flags  & line_buf::LFT_32BIT) &&
+             (r->flags  & line_buf::LFT_INTEGER) &&
+             (y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) == 0);
+
+      assert(bit_depth <= 32);
+      __m256 mul = _mm256_set1_ps((float)(1.0 / (double)(1ULL << bit_depth)));
+      __m256i half = 
+        _mm256_set1_epi32(is_signed ? 0 : (si32)(1ULL << (bit_depth - 1)));
+      __m256 alpha_rf = _mm256_set1_ps(CT_CNST::ALPHA_RF);
+      __m256 alpha_gf = _mm256_set1_ps(CT_CNST::ALPHA_GF);
+      __m256 alpha_bf = _mm256_set1_ps(CT_CNST::ALPHA_BF);
+      __m256 beta_cbf = _mm256_set1_ps(CT_CNST::BETA_CbF);
+      __m256 beta_crf = _mm256_set1_ps(CT_CNST::BETA_CrF);
+
+      const si32 *rp = r->i32 + src_line_offset;
+      const si32 *gp = g->i32 + src_line_offset;
+      const si32 *bp = b->i32 + src_line_offset;
+      float *yp = y->f32, *cbp = cb->f32, *crp = cr->f32;
+      for (int i = (repeat + 7) >> 3; i > 0; --i)
+      {
+        __m256i t;
+        t = _mm256_sub_epi32(_mm256_loadu_si256((__m256i*)rp), half);
+        __m256 mr = _mm256_mul_ps(_mm256_cvtepi32_ps(t), mul);
+        t = _mm256_sub_epi32(_mm256_loadu_si256((__m256i*)gp), half);
+        __m256 mg = _mm256_mul_ps(_mm256_cvtepi32_ps(t), mul);
+        t = _mm256_sub_epi32(_mm256_loadu_si256((__m256i*)bp), half);
+        __m256 mb = _mm256_mul_ps(_mm256_cvtepi32_ps(t), mul);
+
+        __m256 my = _mm256_mul_ps(alpha_rf, mr);
+        my = _mm256_add_ps(my, _mm256_mul_ps(alpha_gf, mg));
+        my = _mm256_add_ps(my, _mm256_mul_ps(alpha_bf, mb));
+        _mm256_store_ps(yp, my);
+        _mm256_store_ps(cbp, _mm256_mul_ps(beta_cbf, _mm256_sub_ps(mb, my)));
+        _mm256_store_ps(crp, _mm256_mul_ps(beta_crf, _mm256_sub_ps(mr, my)));
+
+        rp += 8; gp += 8; bp += 8;
+        yp += 8; cbp += 8; crp += 8;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_ict_backward_irv_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      ui32 bit_depth, bool is_signed, ui32 repeat)
+    {
+      assert((y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) == 0 &&
+             (r->flags  & line_buf::LFT_32BIT) &&
+             (r->flags  & line_buf::LFT_INTEGER));
+
+      assert(bit_depth <= 32);
+      si32 neg_limit = (si32)INT_MIN >> (32 - bit_depth);
+      __m256 mul = _mm256_set1_ps((float)(1ull << bit_depth));
+      __m256 fl_up_lim = _mm256_set1_ps(-(float)neg_limit);  // val < upper
+      __m256 fl_low_lim = _mm256_set1_ps((float)neg_limit);  // val >= lower
+      __m256i s32_up_lim = _mm256_set1_epi32(INT_MAX >> (32 - bit_depth));
+      __m256i s32_low_lim = _mm256_set1_epi32(INT_MIN >> (32 - bit_depth));
+      __m256i half = 
+        _mm256_set1_epi32(is_signed ? 0 : (si32)(1ULL << (bit_depth - 1)));
+      __m256 gamma_cr2g = _mm256_set1_ps(CT_CNST::GAMMA_CR2G);
+      __m256 gamma_cb2g = _mm256_set1_ps(CT_CNST::GAMMA_CB2G);
+      __m256 gamma_cr2r = _mm256_set1_ps(CT_CNST::GAMMA_CR2R);
+      __m256 gamma_cb2b = _mm256_set1_ps(CT_CNST::GAMMA_CB2B);
+
+      const float *yp = y->f32, *cbp = cb->f32, *crp = cr->f32;
+      si32 *rp = r->i32 + dst_line_offset;
+      si32 *gp = g->i32 + dst_line_offset;
+      si32 *bp = b->i32 + dst_line_offset;
+      for (int i = (repeat + 7) >> 3; i > 0; --i)
+      {
+        __m256 my = _mm256_load_ps(yp);
+        __m256 mcr = _mm256_load_ps(crp);
+        __m256 mcb = _mm256_load_ps(cbp);
+        __m256 mg = _mm256_sub_ps(my, _mm256_mul_ps(gamma_cr2g, mcr));
+        mg = _mm256_sub_ps(mg, _mm256_mul_ps(gamma_cb2g, mcb));
+        __m256 mr = _mm256_add_ps(my, _mm256_mul_ps(gamma_cr2r, mcr));
+        __m256 mb = _mm256_add_ps(my, _mm256_mul_ps(gamma_cb2b, mcb));
+
+        __m256 t;
+        __m256i u;
+        t = _mm256_mul_ps(mr, mul);
+        u = _mm256_cvtps_epi32(t);
+        u = ojph_mm256_max_ge_epi32(u, s32_low_lim, t, fl_low_lim);
+        u = ojph_mm256_min_lt_epi32(u,  s32_up_lim, t,  fl_up_lim);
+        _mm256_storeu_si256((__m256i*)rp, _mm256_add_epi32(u, half));
+        t = _mm256_mul_ps(mg, mul);
+        u = _mm256_cvtps_epi32(t);
+        u = ojph_mm256_max_ge_epi32(u, s32_low_lim, t, fl_low_lim);
+        u = ojph_mm256_min_lt_epi32(u,  s32_up_lim, t,  fl_up_lim);
+        _mm256_storeu_si256((__m256i*)gp, _mm256_add_epi32(u, half));
+        t = _mm256_mul_ps(mb, mul);
+        u = _mm256_cvtps_epi32(t);
+        u = ojph_mm256_max_ge_epi32(u, s32_low_lim, t, fl_low_lim);
+        u = ojph_mm256_min_lt_epi32(u,  s32_up_lim, t,  fl_up_lim);
+        _mm256_storeu_si256((__m256i*)bp, _mm256_add_epi32(u, half));
+
+        yp += 8; cbp += 8; crp += 8;
+        rp += 8; gp += 8; bp += 8;
+      }
+    }
   }
 }
 
@@ -54,6 +54,13 @@ namespace ojph {
       static const float GAMMA_CB2B;
       static const float GAMMA_CR2G;
       static const float GAMMA_CB2G;
+
+      // Q15 versions for the fixed-point irreversible colour transform
+      static const si16 ALPHA_RQ15;
+      static const si16 ALPHA_GQ15;
+      static const si16 ALPHA_BQ15;
+      static const si16 BETA_CbQ15;
+      static const si16 BETA_CrQ15;
     };
 
     //////////////////////////////////////////////////////////////////////////
@@ -114,6 +121,39 @@ namespace ojph {
     void gen_ict_backward(const float *y, const float *cb, const float *cr,
                           float *r, float *g, float *b, ui32 repeat);
 
+    //////////////////////////////////////////////////////////////////////////
+    void gen_irv_convert_to_fix16(
+      const line_buf *src_line, ui32 src_line_offset,
+      line_buf *dst_line, ui32 bit_depth, bool is_signed, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_ict_forward_fix16(const si16 *r, const si16 *g, const si16 *b,
+                               si16 *y, si16 *cb, si16 *cr, ui32 repeat);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_rev_convert_rct_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      si64 shift, ui32 repeat);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_rct_backward_rev_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      si64 shift, ui32 repeat);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_irv_convert_ict_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      ui32 bit_depth, bool is_signed, ui32 repeat);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_ict_backward_irv_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      ui32 bit_depth, bool is_signed, ui32 repeat);
+
     //////////////////////////////////////////////////////////////////////////
     //
     //
@@ -188,6 +228,30 @@ namespace ojph {
       const line_buf *y, const line_buf *cb, const line_buf *cr,
       line_buf *r, line_buf *g, line_buf *b, ui32 repeat);
 
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_rev_convert_rct_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      si64 shift, ui32 repeat);
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_rct_backward_rev_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      si64 shift, ui32 repeat);
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_irv_convert_ict_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      ui32 bit_depth, bool is_signed, ui32 repeat);
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_ict_backward_irv_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      ui32 bit_depth, bool is_signed, ui32 repeat);
+
     //////////////////////////////////////////////////////////////////////////
     //
     //
@@ -254,6 +318,39 @@ namespace ojph {
       const line_buf *y, const line_buf *cb, const line_buf *cr,
       line_buf *r, line_buf *g, line_buf *b, ui32 repeat);
 
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_irv_convert_to_fix16(
+      const line_buf *src_line, ui32 src_line_offset,
+      line_buf *dst_line, ui32 bit_depth, bool is_signed, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_ict_forward_fix16(const si16 *r, const si16 *g, const si16 *b,
+                                si16 *y, si16 *cb, si16 *cr, ui32 repeat);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_rev_convert_rct_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      si64 shift, ui32 repeat);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_rct_backward_rev_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      si64 shift, ui32 repeat);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_irv_convert_ict_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      ui32 bit_depth, bool is_signed, ui32 repeat);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_ict_backward_irv_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      ui32 bit_depth, bool is_signed, ui32 repeat);
+
     //////////////////////////////////////////////////////////////////////////
     //
     //
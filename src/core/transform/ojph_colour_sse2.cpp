@@ -44,6 +44,7 @@
 #include "ojph_defs.h"
 #include "ojph_mem.h"
 #include "ojph_colour.h"
+#include "ojph_colour_local.h"
 
 #include <emmintrin.h>
 
@@ -223,6 +224,18 @@ namespace ojph {
       return t;
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    static inline __m128i sse2_cvtlo_epi16_epi32(__m128i a)
+    {
+      return _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    static inline __m128i sse2_cvthi_epi16_epi32(__m128i a)
+    {
+      return _mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16);
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void sse2_rev_convert(const line_buf *src_line,
                           const ui32 src_line_offset,
@@ -244,6 +257,20 @@ namespace ojph {
             _mm_storeu_si128((__m128i*)dp, s);
           }
         }
+        else if (dst_line->flags & line_buf::LFT_16BIT)
+        {
+          const si32 *sp = src_line->i32 + src_line_offset;
+          si16 *dp = dst_line->i16 + dst_line_offset;
+          __m128i sh = _mm_set1_epi32((si32)shift);
+          for (int i = (width + 7) >> 3; i > 0; --i, sp+=8, dp+=8)
+          {
+            __m128i s = _mm_loadu_si128((__m128i*)sp);
+            __m128i t = _mm_loadu_si128((__m128i*)sp + 1);
+            s = _mm_add_epi32(s, sh);
+            t = _mm_add_epi32(t, sh);
+            _mm_storeu_si128((__m128i*)dp, _mm_packs_epi32(s, t));
+          }
+        }
         else
         {
           const si32 *sp = src_line->i32 + src_line_offset;
@@ -265,6 +292,21 @@ namespace ojph {
           }
         }
       }
+      else if (src_line->flags & line_buf::LFT_16BIT)
+      {
+        assert(dst_line->flags & line_buf::LFT_32BIT);
+        const si16 *sp = src_line->i16 + src_line_offset;
+        si32 *dp = dst_line->i32 + dst_line_offset;
+        __m128i sh = _mm_set1_epi32((si32)shift);
+        for (int i = (width + 7) >> 3; i > 0; --i, sp+=8, dp+=8)
+        {
+          __m128i s = _mm_loadu_si128((__m128i*)sp);
+          __m128i t = _mm_add_epi32(sse2_cvtlo_epi16_epi32(s), sh);
+          _mm_storeu_si128((__m128i*)dp, t);
+          t = _mm_add_epi32(sse2_cvthi_epi16_epi32(s), sh);
+          _mm_storeu_si128((__m128i*)dp + 1, t);
+        }
+      }
       else
       {
         assert(src_line->flags | line_buf::LFT_64BIT);
@@ -320,6 +362,31 @@ namespace ojph {
             _mm_storeu_si128((__m128i*)dp, s);
           }
         }
+        else if (dst_line->flags & line_buf::LFT_16BIT)
+        {
+          const si32 *sp = src_line->i32 + src_line_offset;
+          si16 *dp = dst_line->i16 + dst_line_offset;
+          __m128i sh = _mm_set1_epi32((si32)(-shift));
+          __m128i zero = _mm_setzero_si128();
+          for (int i = (width + 7) >> 3; i > 0; --i, sp += 8, dp += 8)
+          {
+            __m128i s = _mm_loadu_si128((__m128i*)sp);
+            __m128i c = _mm_cmplt_epi32(s, zero);  // 0xFFFFFFFF for -ve value
+            __m128i v_m_sh = _mm_sub_epi32(sh, s); // - shift - value
+            v_m_sh = _mm_and_si128(c, v_m_sh);     // keep only - shift - value
+            s = _mm_andnot_si128(c, s);            // keep only +ve or 0
+            __m128i lo = _mm_or_si128(s, v_m_sh);  // combine
+
+            s = _mm_loadu_si128((__m128i*)sp + 1);
+            c = _mm_cmplt_epi32(s, zero);          // 0xFFFFFFFF for -ve value
+            v_m_sh = _mm_sub_epi32(sh, s);         // - shift - value
+            v_m_sh = _mm_and_si128(c, v_m_sh);     // keep only - shift - value
+            s = _mm_andnot_si128(c, s);            // keep only +ve or 0
+            __m128i hi = _mm_or_si128(s, v_m_sh);  // combine
+
+            _mm_storeu_si128((__m128i*)dp, _mm_packs_epi32(lo, hi));
+          }
+        }
         else
         {
           const si32 *sp = src_line->i32 + src_line_offset;
@@ -353,6 +420,34 @@ namespace ojph {
           }
         }
       }
+      else if (src_line->flags & line_buf::LFT_16BIT)
+      {
+        assert(dst_line->flags & line_buf::LFT_32BIT);
+        const si16 *sp = src_line->i16 + src_line_offset;
+        si32 *dp = dst_line->i32 + dst_line_offset;
+        __m128i sh = _mm_set1_epi32((si32)(-shift));
+        __m128i zero = _mm_setzero_si128();
+        for (int i = (width + 7) >> 3; i > 0; --i, sp += 8, dp += 8)
+        {
+          __m128i t = _mm_loadu_si128((__m128i*)sp);
+
+          __m128i s = sse2_cvtlo_epi16_epi32(t);
+          __m128i c = _mm_cmplt_epi32(s, zero);  // 0xFFFFFFFF for -ve value
+          __m128i v_m_sh = _mm_sub_epi32(sh, s); // - shift - value
+          v_m_sh = _mm_and_si128(c, v_m_sh);     // keep only - shift - value
+          s = _mm_andnot_si128(c, s);            // keep only +ve or 0
+          s = _mm_or_si128(s, v_m_sh);           // combine
+          _mm_storeu_si128((__m128i*)dp, s);
+
+          s = sse2_cvthi_epi16_epi32(t);
+          c = _mm_cmplt_epi32(s, zero);          // 0xFFFFFFFF for -ve value
+          v_m_sh = _mm_sub_epi32(sh, s);         // - shift - value
+          v_m_sh = _mm_and_si128(c, v_m_sh);     // keep only - shift - value
+          s = _mm_andnot_si128(c, s);            // keep only +ve or 0
+          s = _mm_or_si128(s, v_m_sh);           // combine
+          _mm_storeu_si128((__m128i*)dp + 1, s);
+        }
+      }
       else
       {
         assert(src_line->flags | line_buf::LFT_64BIT);
@@ -502,6 +597,43 @@ namespace ojph {
           yp += 4; cbp += 4; crp += 4;
         }
       }
+      else if (y->flags & line_buf::LFT_16BIT)
+      {
+        assert((y->flags  & line_buf::LFT_16BIT) &&
+               (cb->flags & line_buf::LFT_16BIT) &&
+               (cr->flags & line_buf::LFT_16BIT) &&
+               (r->flags  & line_buf::LFT_32BIT) &&
+               (g->flags  & line_buf::LFT_32BIT) &&
+               (b->flags  & line_buf::LFT_32BIT));
+        const si32 *rp = r->i32, * gp = g->i32, * bp = b->i32;
+        si16 *yp = y->i16, * cbp = cb->i16, * crp = cr->i16;
+        for (int i = (repeat + 7) >> 3; i > 0; --i)
+        {
+          __m128i mr = _mm_load_si128((__m128i*)rp);
+          __m128i mg = _mm_load_si128((__m128i*)gp);
+          __m128i mb = _mm_load_si128((__m128i*)bp);
+          __m128i t = _mm_add_epi32(mr, mb);
+          t = _mm_add_epi32(t, _mm_slli_epi32(mg, 1));
+          __m128i y0 = _mm_srai_epi32(t, 2);
+          __m128i cb0 = _mm_sub_epi32(mb, mg);
+          __m128i cr0 = _mm_sub_epi32(mr, mg);
+
+          mr = _mm_load_si128((__m128i*)rp + 1);
+          mg = _mm_load_si128((__m128i*)gp + 1);
+          mb = _mm_load_si128((__m128i*)bp + 1);
+          t = _mm_add_epi32(mr, mb);
+          t = _mm_add_epi32(t, _mm_slli_epi32(mg, 1));
+          t = _mm_srai_epi32(t, 2);
+          _mm_store_si128((__m128i*)yp, _mm_packs_epi32(y0, t));
+          t = _mm_sub_epi32(mb, mg);
+          _mm_store_si128((__m128i*)cbp, _mm_packs_epi32(cb0, t));
+          t = _mm_sub_epi32(mr, mg);
+          _mm_store_si128((__m128i*)crp, _mm_packs_epi32(cr0, t));
+
+          rp += 8; gp += 8; bp += 8;
+          yp += 8; cbp += 8; crp += 8;
+        }
+      }
       else
       {
         assert((y->flags  & line_buf::LFT_64BIT) &&
@@ -594,6 +726,48 @@ namespace ojph {
           rp += 4; gp += 4; bp += 4;
         }
       }
+      else if (y->flags & line_buf::LFT_16BIT)
+      {
+        assert((y->flags  & line_buf::LFT_16BIT) &&
+               (cb->flags & line_buf::LFT_16BIT) &&
+               (cr->flags & line_buf::LFT_16BIT) &&
+               (r->flags  & line_buf::LFT_32BIT) &&
+               (g->flags  & line_buf::LFT_32BIT) &&
+               (b->flags  & line_buf::LFT_32BIT));
+        const si16 *yp = y->i16, *cbp = cb->i16, *crp = cr->i16;
+        si32 *rp = r->i32, *gp = g->i32, *bp = b->i32;
+        for (int i = (repeat + 7) >> 3; i > 0; --i)
+        {
+          __m128i my16  = _mm_load_si128((__m128i*)yp);
+          __m128i mcb16 = _mm_load_si128((__m128i*)cbp);
+          __m128i mcr16 = _mm_load_si128((__m128i*)crp);
+
+          __m128i my  = sse2_cvtlo_epi16_epi32(my16);
+          __m128i mcb = sse2_cvtlo_epi16_epi32(mcb16);
+          __m128i mcr = sse2_cvtlo_epi16_epi32(mcr16);
+          __m128i t = _mm_add_epi32(mcb, mcr);
+          t = _mm_sub_epi32(my, _mm_srai_epi32(t, 2));
+          _mm_store_si128((__m128i*)gp, t);
+          __m128i u = _mm_add_epi32(mcb, t);
+          _mm_store_si128((__m128i*)bp, u);
+          u = _mm_add_epi32(mcr, t);
+          _mm_store_si128((__m128i*)rp, u);
+
+          my  = sse2_cvthi_epi16_epi32(my16);
+          mcb = sse2_cvthi_epi16_epi32(mcb16);
+          mcr = sse2_cvthi_epi16_epi32(mcr16);
+          t = _mm_add_epi32(mcb, mcr);
+          t = _mm_sub_epi32(my, _mm_srai_epi32(t, 2));
+          _mm_store_si128((__m128i*)gp + 1, t);
+          u = _mm_add_epi32(mcb, t);
+          _mm_store_si128((__m128i*)bp + 1, u);
+          u = _mm_add_epi32(mcr, t);
+          _mm_store_si128((__m128i*)rp + 1, u);
+
+          yp += 8; cbp += 8; crp += 8;
+          rp += 8; gp += 8; bp += 8;
+        }
+      }
       else
       {
         assert((y->flags  & line_buf::LFT_64BIT) &&
@@ -656,6 +830,266 @@ namespace ojph {
         }
       }
     }
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_rev_convert_rct_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      si64 shift, ui32 repeat)
+    {
+      assert((r->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) &&
+             (cb->flags & line_buf::LFT_INTEGER) &&
+             (cr->flags & line_buf::LFT_INTEGER));
+
+      const si32 *rp = r->i32 + src_line_offset;
+      const si32 *gp = g->i32 + src_line_offset;
+      const si32 *bp = b->i32 + src_line_offset;
+      __m128i sh = _mm_set1_epi32((si32)shift);
+      if (y->flags & line_buf::LFT_32BIT)
+      {
+        si32 *yp = y->i32, *cbp = cb->i32, *crp = cr->i32;
+        for (int i = (repeat + 3) >> 2; i > 0; --i)
+        {
+          __m128i mr = _mm_add_epi32(_mm_loadu_si128((__m128i*)rp), sh);
+          __m128i mg = _mm_add_epi32(_mm_loadu_si128((__m128i*)gp), sh);
+          __m128i mb = _mm_add_epi32(_mm_loadu_si128((__m128i*)bp), sh);
+          __m128i t = _mm_add_epi32(mr, mb);
+          t = _mm_add_epi32(t, _mm_slli_epi32(mg, 1));
+          _mm_store_si128((__m128i*)yp, _mm_srai_epi32(t, 2));
+          t = _mm_sub_epi32(mb, mg);
+          _mm_store_si128((__m128i*)cbp, t);
+          t = _mm_sub_epi32(mr, mg);
+          _mm_store_si128((__m128i*)crp, t);
+
+          rp += 4; gp += 4; bp += 4;
+          yp += 4; cbp += 4; crp += 4;
+        }
+      }
+      else
+      {
+        assert(y->flags & line_buf::LFT_16BIT);
+        si16 *yp = y->i16, *cbp = cb->i16, *crp = cr->i16;
+        for (int i = (repeat + 7) >> 3; i > 0; --i)
+        {
+          __m128i mr = _mm_add_epi32(_mm_loadu_si128((__m128i*)rp), sh);
+          __m128i mg = _mm_add_epi32(_mm_loadu_si128((__m128i*)gp), sh);
+          __m128i mb = _mm_add_epi32(_mm_loadu_si128((__m128i*)bp), sh);
+          __m128i t = _mm_add_epi32(mr, mb);
+          t = _mm_add_epi32(t, _mm_slli_epi32(mg, 1));
+          __m128i y0 = _mm_srai_epi32(t, 2);
+          __m128i cb0 = _mm_sub_epi32(mb, mg);
+          __m128i cr0 = _mm_sub_epi32(mr, mg);
+
+          mr = _mm_add_epi32(_mm_loadu_si128((__m128i*)rp + 1), sh);
+          mg = _mm_add_epi32(_mm_loadu_si128((__m128i*)gp + 1), sh);
+          mb = _mm_add_epi32(_mm_loadu_si128((__m128i*)bp + 1), sh);
+          t = _mm_add_epi32(mr, mb);
+          t = _mm_add_epi32(t, _mm_slli_epi32(mg, 1));
+          t = _mm_srai_epi32(t, 2);
+          _mm_store_si128((__m128i*)yp, _mm_packs_epi32(y0, t));
+          t = _mm_sub_epi32(mb, mg);
+          _mm_store_si128((__m128i*)cbp, _mm_packs_epi32(cb0, t));
+          t = _mm_sub_epi32(mr, mg);
+          _mm_store_si128((__m128i*)crp, _mm_packs_epi32(cr0, t));
+
+          rp += 8; gp += 8; bp += 8;
+          yp += 8; cbp += 8; crp += 8;
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_rct_backward_rev_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      si64 shift, ui32 repeat)
+    {
+      assert((y->flags  & line_buf::LFT_INTEGER) &&
+             (cb->flags & line_buf::LFT_INTEGER) &&
+             (cr->flags & line_buf::LFT_INTEGER) &&
+             (r->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_32BIT));
+
+      si32 *rp = r->i32 + dst_line_offset;
+      si32 *gp = g->i32 + dst_line_offset;
+      si32 *bp = b->i32 + dst_line_offset;
+      __m128i sh = _mm_set1_epi32((si32)shift);
+      if (y->flags & line_buf::LFT_32BIT)
+      {
+        const si32 *yp = y->i32, *cbp = cb->i32, *crp = cr->i32;
+        for (int i = (repeat + 3) >> 2; i > 0; --i)
+        {
+          __m128i my  = _mm_load_si128((__m128i*)yp);
+          __m128i mcb = _mm_load_si128((__m128i*)cbp);
+          __m128i mcr = _mm_load_si128((__m128i*)crp);
+
+          __m128i t = _mm_add_epi32(mcb, mcr);
+          t = _mm_sub_epi32(my, _mm_srai_epi32(t, 2));
+          __m128i u = _mm_add_epi32(mcb, t);
+          _mm_storeu_si128((__m128i*)bp, _mm_add_epi32(u, sh));
+          u = _mm_add_epi32(mcr, t);
+          _mm_storeu_si128((__m128i*)rp, _mm_add_epi32(u, sh));
+          _mm_storeu_si128((__m128i*)gp, _mm_add_epi32(t, sh));
+
+          yp += 4; cbp += 4; crp += 4;
+          rp += 4; gp += 4; bp += 4;
+        }
+      }
+      else
+      {
+        assert(y->flags & line_buf::LFT_16BIT);
+        const si16 *yp = y->i16, *cbp = cb->i16, *crp = cr->i16;
+        for (int i = (repeat + 7) >> 3; i > 0; --i)
+        {
+          __m128i my16  = _mm_load_si128((__m128i*)yp);
+          __m128i mcb16 = _mm_load_si128((__m128i*)cbp);
+          __m128i mcr16 = _mm_load_si128((__m128i*)crp);
+
+          __m128i my  = sse2_cvtlo_epi16_epi32(my16);
+          __m128i mcb = sse2_cvtlo_epi16_epi32(mcb16);
+          __m128i mcr = sse2_cvtlo_epi16_epi32(mcr16);
+          __m128i t = _mm_add_epi32(mcb, mcr);
+          t = _mm_sub_epi32(my, _mm_srai_epi32(t, 2));
+          __m128i u = _mm_add_epi32(mcb, t);
+          _mm_storeu_si128((__m128i*)bp, _mm_add_epi32(u, sh));
+          u = _mm_add_epi32(mcr, t);
+          _mm_storeu_si128((__m128i*)rp, _mm_add_epi32(u, sh));
+          _mm_storeu_si128((__m128i*)gp, _mm_add_epi32(t, sh));
+
+          my  = sse2_cvthi_epi16_epi32(my16);
+          mcb = sse2_cvthi_epi16_epi32(mcb16);
+          mcr = sse2_cvthi_epi16_epi32(mcr16);
+          t = _mm_add_epi32(mcb, mcr);
+          t = _mm_sub_epi32(my, _mm_srai_epi32(t, 2));
+          u = _mm_add_epi32(mcb, t);
+          _mm_storeu_si128((__m128i*)bp + 1, _mm_add_epi32(u, sh));
+          u = _mm_add_epi32(mcr, t);
+          _mm_storeu_si128((__m128i*)rp + 1, _mm_add_epi32(u, sh));
+          _mm_storeu_si128((__m128i*)gp + 1, _mm_add_epi32(t, sh));
+
+          yp += 8; cbp += 8; crp += 8;
+          rp += 8; gp += 8; bp += 8;
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_irv_convert_ict_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      ui32 bit_depth, bool is_signed, ui32 repeat)
+    {
+      assert((r->flags  & line_buf::LFT_32BIT) &&
+             (r->flags  & line_buf::LFT_INTEGER) &&
+             (y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) == 0);
+
+      assert(bit_depth <= 32);
+      __m128 mul = _mm_set1_ps((float)(1.0 / (double)(1ULL << bit_depth)));
+      __m128i half = 
+        _mm_set1_epi32(is_signed ? 0 : (si32)(1ULL << (bit_depth - 1)));
+      __m128 alpha_rf = _mm_set1_ps(CT_CNST::ALPHA_RF);
+      __m128 alpha_gf = _mm_set1_ps(CT_CNST::ALPHA_GF);
+      __m128 alpha_bf = _mm_set1_ps(CT_CNST::ALPHA_BF);
+      __m128 beta_cbf = _mm_set1_ps(CT_CNST::BETA_CbF);
+      __m128 beta_crf = _mm_set1_ps(CT_CNST::BETA_CrF);
+
+      const si32 *rp = r->i32 + src_line_offset;
+      const si32 *gp = g->i32 + src_line_offset;
+      const si32 *bp = b->i32 + src_line_offset;
+      float *yp = y->f32, *cbp = cb->f32, *crp = cr->f32;
+      for (int i = (repeat + 3) >> 2; i > 0; --i)
+      {
+        __m128i t;
+        t = _mm_sub_epi32(_mm_loadu_si128((__m128i*)rp), half);
+        __m128 mr = _mm_mul_ps(_mm_cvtepi32_ps(t), mul);
+        t = _mm_sub_epi32(_mm_loadu_si128((__m128i*)gp), half);
+        __m128 mg = _mm_mul_ps(_mm_cvtepi32_ps(t), mul);
+        t = _mm_sub_epi32(_mm_loadu_si128((__m128i*)bp), half);
+        __m128 mb = _mm_mul_ps(_mm_cvtepi32_ps(t), mul);
+
+        __m128 my = _mm_mul_ps(alpha_rf, mr);
+        my = _mm_add_ps(my, _mm_mul_ps(alpha_gf, mg));
+        my = _mm_add_ps(my, _mm_mul_ps(alpha_bf, mb));
+        _mm_store_ps(yp, my);
+        _mm_store_ps(cbp, _mm_mul_ps(beta_cbf, _mm_sub_ps(mb, my)));
+        _mm_store_ps(crp, _mm_mul_ps(beta_crf, _mm_sub_ps(mr, my)));
+
+        rp += 4; gp += 4; bp += 4;
+        yp += 4; cbp += 4; crp += 4;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_ict_backward_irv_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      ui32 bit_depth, bool is_signed, ui32 repeat)
+    {
+      assert((y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) == 0 &&
+             (r->flags  & line_buf::LFT_32BIT) &&
+             (r->flags  & line_buf::LFT_INTEGER));
+
+      assert(bit_depth <= 32);
+      uint32_t rounding_mode = _MM_GET_ROUNDING_MODE();
+      _MM_SET_ROUNDING_MODE(_MM_ROUND_NEAREST);
+
+      si32 neg_limit = (si32)INT_MIN >> (32 - bit_depth);
+      __m128 mul = _mm_set1_ps((float)(1ull << bit_depth));
+      __m128 fl_up_lim = _mm_set1_ps(-(float)neg_limit); // val < upper
+      __m128 fl_low_lim = _mm_set1_ps((float)neg_limit); // val >= lower
+      __m128i s32_up_lim = _mm_set1_epi32(INT_MAX >> (32 - bit_depth));
+      __m128i s32_low_lim = _mm_set1_epi32(INT_MIN >> (32 - bit_depth));
+      __m128i half = 
+        _mm_set1_epi32(is_signed ? 0 : (si32)(1ULL << (bit_depth - 1)));
+      __m128 gamma_cr2g = _mm_set1_ps(CT_CNST::GAMMA_CR2G);
+      __m128 gamma_cb2g = _mm_set1_ps(CT_CNST::GAMMA_CB2G);
+      __m128 gamma_cr2r = _mm_set1_ps(CT_CNST::GAMMA_CR2R);
+      __m128 gamma_cb2b = _mm_set1_ps(CT_CNST::GAMMA_CB2B);
+
+      const float *yp = y->f32, *cbp = cb->f32, *crp = cr->f32;
+      si32 *rp = r->i32 + dst_line_offset;
+      si32 *gp = g->i32 + dst_line_offset;
+      si32 *bp = b->i32 + dst_line_offset;
+      for (int i = (repeat + 3) >> 2; i > 0; --i)
+      {
+        __m128 my = _mm_load_ps(yp);
+        __m128 mcr = _mm_load_ps(crp);
+        __m128 mcb = _mm_load_ps(cbp);
+        __m128 mg = _mm_sub_ps(my, _mm_mul_ps(gamma_cr2g, mcr));
+        mg = _mm_sub_ps(mg, _mm_mul_ps(gamma_cb2g, mcb));
+        __m128 mr = _mm_add_ps(my, _mm_mul_ps(gamma_cr2r, mcr));
+        __m128 mb = _mm_add_ps(my, _mm_mul_ps(gamma_cb2b, mcb));
+
+        __m128 t;
+        __m128i u;
+        t = _mm_mul_ps(mr, mul);
+        u = _mm_cvtps_epi32(t);
+        u = ojph_mm_max_ge_epi32(u, s32_low_lim, t, fl_low_lim);
+        u = ojph_mm_min_lt_epi32(u, s32_up_lim, t, fl_up_lim);
+        _mm_storeu_si128((__m128i*)rp, _mm_add_epi32(u, half));
+        t = _mm_mul_ps(mg, mul);
+        u = _mm_cvtps_epi32(t);
+        u = ojph_mm_max_ge_epi32(u, s32_low_lim, t, fl_low_lim);
+        u = ojph_mm_min_lt_epi32(u, s32_up_lim, t, fl_up_lim);
+        _mm_storeu_si128((__m128i*)gp, _mm_add_epi32(u, half));
+        t = _mm_mul_ps(mb, mul);
+        u = _mm_cvtps_epi32(t);
+        u = ojph_mm_max_ge_epi32(u, s32_low_lim, t, fl_low_lim);
+        u = ojph_mm_min_lt_epi32(u, s32_up_lim, t, fl_up_lim);
+        _mm_storeu_si128((__m128i*)bp, _mm_add_epi32(u, half));
+
+        yp += 4; cbp += 4; crp += 4;
+        rp += 4; gp += 4; bp += 4;
+      }
+
+      _MM_SET_ROUNDING_MODE(rounding_mode);
+    }
   }
 }
 
@@ -91,17 +91,29 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void (*irv_horz_syn)
       (const param_atk* atk, const line_buf* dst, const line_buf* lsrc,
-        const line_buf* hsrc, ui32 width, bool even) = NULL;
+        const line_buf* hsrc, ui32 width, bool even, bool scale_low) = NULL;
+
+    /////////////////////////////////////////////////////////////////////////
+    // Fixed-point irreversible functions
+    /////////////////////////////////////////////////////////////////////////
+
+    /////////////////////////////////////////////////////////////////////////
+    void (*irv_fix_vert_step)
+      (const lifting_step* s, const line_buf* sig, const line_buf* other,
+        const line_buf* aug, ui32 repeat, bool synthesis) = NULL;
+
+    /////////////////////////////////////////////////////////////////////////
+    void (*irv_fix_vert_times_K)
+      (float K, const line_buf* aug, ui32 repeat) = NULL;
 
-    ////////////////////////////////////////////////////////////////////////////
-    static bool wavelet_transform_functions_initialized = false;
+    /////////////////////////////////////////////////////////////////////////
+    void (*irv_fix_horz_ana)
+      (const param_atk* atk, const line_buf* ldst, const line_buf* hdst,
+        const line_buf* src, ui32 width, bool even) = NULL;
 
     //////////////////////////////////////////////////////////////////////////
-    void init_wavelet_transform_functions()
+    static bool set_wavelet_transform_functions()
     {
-      if (wavelet_transform_functions_initialized)
-        return;
-
 #if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
 
       rev_vert_step             = gen_rev_vert_step;
@@ -113,6 +125,10 @@ namespace ojph {
       irv_horz_ana              = gen_irv_horz_ana;
       irv_horz_syn              = gen_irv_horz_syn;
 
+      irv_fix_vert_step         = gen_irv_fix_vert_step;
+      irv_fix_vert_times_K      = gen_irv_fix_vert_times_K;
+      irv_fix_horz_ana          = gen_irv_fix_horz_ana;
+
   #ifndef OJPH_DISABLE_SIMD
 
     #if (defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
@@ -152,6 +168,10 @@ namespace ojph {
           rev_vert_step             = avx2_rev_vert_step;
           rev_horz_ana              = avx2_rev_horz_ana;
           rev_horz_syn              = avx2_rev_horz_syn;
+
+          irv_fix_vert_step         = avx2_irv_fix_vert_step;
+          irv_fix_vert_times_K      = avx2_irv_fix_vert_times_K;
+          irv_fix_horz_ana          = avx2_irv_fix_horz_ana;
         }
       #endif // !OJPH_DISABLE_AVX2
 
@@ -186,13 +206,101 @@ namespace ojph {
         irv_horz_syn              = wasm_irv_horz_syn;
 #endif // !OJPH_ENABLE_WASM_SIMD
 
-      wavelet_transform_functions_initialized = true;
+      return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void init_wavelet_transform_functions()
+    {
+      // a function-local static is initialized exactly once, even when
+      // codestreams are created on several threads at the same time
+      static bool initialized = set_wavelet_transform_functions();
+      ojph_unused(initialized);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    bool use_16bit_rev_path(ui32 precision)
+    {
+#if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
+      // precision includes one spare bit, which covers the sum of two
+      // samples in a lifting step, as is the case for 32-bit lines
+      return precision <= 16;
+#else
+      ojph_unused(precision);
+      return false; // 16-bit kernels are not available for WASM SIMD
+#endif
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    bool use_fix16_irv_path(ui32 bit_depth)
+    {
+#if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
+      // the error bounds of the fixed-point path are only good enough for
+      // low bit-depth samples
+      return bit_depth <= 8;
+#else
+      ojph_unused(bit_depth);
+      return false; // fixed-point kernels are not available for WASM SIMD
+#endif
     }
     
     //////////////////////////////////////////////////////////////////////////
 
 #if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
 
+    /////////////////////////////////////////////////////////////////////////
+    static
+    void gen_rev_vert_step16(const lifting_step* s, const line_buf* sig, 
+                             const line_buf* other, const line_buf* aug, 
+                             ui32 repeat, bool synthesis)
+    {
+      const si32 a = s->rev.Aatk;
+      const si32 b = s->rev.Batk;
+      const ui8 e = s->rev.Eatk;
+
+      // samples are stored in 16 bits, but arithmetic is in 32 bits
+      si16* dst = aug->i16;
+      const si16* src1 = sig->i16, * src2 = other->i16;
+      // The general definition of the wavelet in Part 2 is slightly 
+      // different to part 2, although they are mathematically equivalent
+      // here, we identify the simpler form from Part 1 and employ them
+      if (a == 1)
+      { // 5/3 update and any case with a == 1
+        if (synthesis)
+          for (ui32 i = repeat; i > 0; --i, ++dst)
+            *dst = (si16)(*dst - ((b + *src1++ + *src2++) >> e));
+        else
+          for (ui32 i = repeat; i > 0; --i, ++dst)
+            *dst = (si16)(*dst + ((b + *src1++ + *src2++) >> e));
+      }
+      else if (a == -1 && b == 1 && e == 1)
+      { // 5/3 predict
+        if (synthesis)
+          for (ui32 i = repeat; i > 0; --i, ++dst)
+            *dst = (si16)(*dst + ((*src1++ + *src2++) >> e));
+        else
+          for (ui32 i = repeat; i > 0; --i, ++dst)
+            *dst = (si16)(*dst - ((*src1++ + *src2++) >> e));
+      }
+      else if (a == -1)
+      { // any case with a == -1, which is not 5/3 predict
+        if (synthesis)
+          for (ui32 i = repeat; i > 0; --i, ++dst)
+            *dst = (si16)(*dst - ((b - (*src1++ + *src2++)) >> e));
+        else
+          for (ui32 i = repeat; i > 0; --i, ++dst)
+            *dst = (si16)(*dst + ((b - (*src1++ + *src2++)) >> e));
+      }
+      else { // general case
+        if (synthesis)
+          for (ui32 i = repeat; i > 0; --i, ++dst)
+            *dst = (si16)(*dst - ((b + a * (*src1++ + *src2++)) >> e));
+        else
+          for (ui32 i = repeat; i > 0; --i, ++dst)
+            *dst = (si16)(*dst + ((b + a * (*src1++ + *src2++)) >> e));
+      }
+    }
+
     /////////////////////////////////////////////////////////////////////////
     static
     void gen_rev_vert_step32(const lifting_step* s, const line_buf* sig, 
@@ -302,7 +410,16 @@ namespace ojph {
                            const line_buf* other, const line_buf* aug, 
                            ui32 repeat, bool synthesis)
     {
-      if (((sig != NULL) && (sig->flags & line_buf::LFT_32BIT)) || 
+      if (((sig != NULL) && (sig->flags & line_buf::LFT_16BIT)) || 
+          ((aug != NULL) && (aug->flags & line_buf::LFT_16BIT)) ||
+          ((other != NULL) && (other->flags & line_buf::LFT_16BIT))) 
+      {
+        assert((sig == NULL || sig->flags & line_buf::LFT_16BIT) &&
+               (other == NULL || other->flags & line_buf::LFT_16BIT) && 
+               (aug == NULL || aug->flags & line_buf::LFT_16BIT));
+        gen_rev_vert_step16(s, sig, other, aug, repeat, synthesis);
+      }
+      else if (((sig != NULL) && (sig->flags & line_buf::LFT_32BIT)) || 
           ((aug != NULL) && (aug->flags & line_buf::LFT_32BIT)) ||
           ((other != NULL) && (other->flags & line_buf::LFT_32BIT))) 
       {
@@ -320,6 +437,85 @@ namespace ojph {
       }
     }
 
+    /////////////////////////////////////////////////////////////////////////
+    static
+    void gen_rev_horz_ana16(const param_atk* atk, const line_buf* ldst, 
+                            const line_buf* hdst, const line_buf* src, 
+                            ui32 width, bool even)
+    {
+      if (width > 1)
+      {
+        // combine both lsrc and hsrc into dst
+        si16* dph = hdst->i16;
+        si16* dpl = ldst->i16;
+        si16* sp = src->i16;
+        ui32 w = width;
+        if (!even)
+        {
+          *dph++ = *sp++; --w;
+        }
+        for (; w > 1; w -= 2)
+        {
+          *dpl++ = *sp++; *dph++ = *sp++;
+        }
+        if (w)
+        {
+          *dpl++ = *sp++; --w;
+        }
+
+        si16* hp = hdst->i16, * lp = ldst->i16;
+        ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
+        ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
+        ui32 num_steps = atk->get_num_steps();
+        for (ui32 j = num_steps; j > 0; --j)
+        {
+          // first lifting step
+          const lifting_step* s = atk->get_step(j - 1);
+          const si32 a = s->rev.Aatk;
+          const si32 b = s->rev.Batk;
+          const ui8 e = s->rev.Eatk;
+
+          // extension
+          lp[-1] = lp[0];
+          lp[l_width] = lp[l_width - 1];
+          // lifting step
+          const si16* sp = lp + (even ? 1 : 0);
+          si16* dp = hp;
+          if (a == 1) 
+          { // 5/3 update and any case with a == 1
+            for (ui32 i = h_width; i > 0; --i, sp++, dp++)
+              *dp = (si16)(*dp + ((b + (sp[-1] + sp[0])) >> e));
+          }
+          else if (a == -1 && b == 1 && e == 1)
+          {  // 5/3 predict
+            for (ui32 i = h_width; i > 0; --i, sp++, dp++)
+              *dp = (si16)(*dp - ((sp[-1] + sp[0]) >> e));
+          }
+          else if (a == -1)
+          { // any case with a == -1, which is not 5/3 predict
+            for (ui32 i = h_width; i > 0; --i, sp++, dp++)
+              *dp = (si16)(*dp + ((b - (sp[-1] + sp[0])) >> e));
+          }
+          else {
+            // general case
+            for (ui32 i = h_width; i > 0; --i, sp++, dp++)
+              *dp = (si16)(*dp + ((b + a * (sp[-1] + sp[0])) >> e));
+          }
+
+          // swap buffers
+          si16* t = lp; lp = hp; hp = t;
+          even = !even;
+          ui32 w = l_width; l_width = h_width; h_width = w;
+        }
+      }
+      else {
+        if (even)
+          ldst->i16[0] = src->i16[0];
+        else
+          hdst->i16[0] = (si16)(src->i16[0] << 1);
+      }
+    }
+
     /////////////////////////////////////////////////////////////////////////
     static
     void gen_rev_horz_ana32(const param_atk* atk, const line_buf* ldst, 
@@ -483,7 +679,13 @@ namespace ojph {
                           const line_buf* hdst, const line_buf* src, 
                           ui32 width, bool even)
     {
-      if (src->flags & line_buf::LFT_32BIT) 
+      if (src->flags & line_buf::LFT_16BIT) 
+      {
+        assert((ldst == NULL || ldst->flags & line_buf::LFT_16BIT) &&
+               (hdst == NULL || hdst->flags & line_buf::LFT_16BIT));
+        gen_rev_horz_ana16(atk, ldst, hdst, src, width, even);
+      }
+      else if (src->flags & line_buf::LFT_32BIT) 
       {
         assert((ldst == NULL || ldst->flags & line_buf::LFT_32BIT) &&
                (hdst == NULL || hdst->flags & line_buf::LFT_32BIT));
@@ -498,6 +700,85 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    static
+    void gen_rev_horz_syn16(const param_atk* atk, const line_buf* dst, 
+                            const line_buf* lsrc, const line_buf* hsrc, 
+                            ui32 width, bool even)
+    {
+      if (width > 1)
+      {
+        bool ev = even;
+        si16* oth = hsrc->i16, * aug = lsrc->i16;
+        ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
+        ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
+        ui32 num_steps = atk->get_num_steps();
+        for (ui32 j = 0; j < num_steps; ++j)
+        {
+          const lifting_step* s = atk->get_step(j);
+          const si32 a = s->rev.Aatk;
+          const si32 b = s->rev.Batk;
+          const ui8 e = s->rev.Eatk;
+
+          // extension
+          oth[-1] = oth[0];
+          oth[oth_width] = oth[oth_width - 1];
+          // lifting step
+          const si16* sp = oth + (ev ? 0 : 1);
+          si16* dp = aug;
+          if (a == 1)
+          { // 5/3 update and any case with a == 1
+            for (ui32 i = aug_width; i > 0; --i, sp++, dp++)
+              *dp = (si16)(*dp - ((b + (sp[-1] + sp[0])) >> e));
+          }
+          else if (a == -1 && b == 1 && e == 1)
+          {  // 5/3 predict
+            for (ui32 i = aug_width; i > 0; --i, sp++, dp++)
+              *dp = (si16)(*dp + ((sp[-1] + sp[0]) >> e));
+          }
+          else if (a == -1)
+          { // any case with a == -1, which is not 5/3 predict
+            for (ui32 i = aug_width; i > 0; --i, sp++, dp++)
+              *dp = (si16)(*dp - ((b - (sp[-1] + sp[0])) >> e));
+          }
+          else {
+            // general case
+            for (ui32 i = aug_width; i > 0; --i, sp++, dp++)
+              *dp = (si16)(*dp - ((b + a * (sp[-1] + sp[0])) >> e));
+          }
+
+          // swap buffers
+          si16* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+        }
+
+        // combine both lsrc and hsrc into dst
+        si16* sph = hsrc->i16;
+        si16* spl = lsrc->i16;
+        si16* dp = dst->i16;
+        ui32 w = width;
+        if (!even)
+        {
+          *dp++ = *sph++; --w;
+        }
+        for (; w > 1; w -= 2)
+        {
+          *dp++ = *spl++; *dp++ = *sph++;
+        }
+        if (w)
+        {
+          *dp++ = *spl++; --w;
+        }
+      }
+      else {
+        if (even)
+          dst->i16[0] = lsrc->i16[0];
+        else
+          dst->i16[0] = (si16)(hsrc->i16[0] >> 1);
+      }
+    }
+
     //////////////////////////////////////////////////////////////////////////
     static
     void gen_rev_horz_syn32(const param_atk* atk, const line_buf* dst, 
@@ -661,7 +942,13 @@ namespace ojph {
                           const line_buf* lsrc, const line_buf* hsrc, 
                           ui32 width, bool even)
     {
-      if (dst->flags & line_buf::LFT_32BIT) 
+      if (dst->flags & line_buf::LFT_16BIT) 
+      {
+        assert((lsrc == NULL || lsrc->flags & line_buf::LFT_16BIT) && 
+               (hsrc == NULL || hsrc->flags & line_buf::LFT_16BIT));
+        gen_rev_horz_syn16(atk, dst, lsrc, hsrc, width, even);
+      }
+      else if (dst->flags & line_buf::LFT_32BIT) 
       {
         assert((lsrc == NULL || lsrc->flags & line_buf::LFT_32BIT) && 
                (hsrc == NULL || hsrc->flags & line_buf::LFT_32BIT));
@@ -774,7 +1061,7 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void gen_irv_horz_syn(const param_atk* atk, const line_buf* dst, 
                           const line_buf* lsrc, const line_buf* hsrc, 
-                          ui32 width, bool even)
+                          ui32 width, bool even, bool scale_low)
     {
       if (width > 1)
       {
@@ -783,18 +1070,12 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
 
+        if (scale_low) // bands 1 to 3 are scaled when dequantised
         {
           float K = atk->get_K();
-          float K_inv = 1.0f / K;
-          float* dp;
-
-          dp = aug;
+          float* dp = aug;
           for (ui32 i = aug_width; i > 0; --i)
             *dp++ *= K;
-
-          dp = oth;
-          for (ui32 i = oth_width; i > 0; --i)
-            *dp++ *= K_inv;
         }
 
         ui32 num_steps = atk->get_num_steps();
@@ -838,6 +1119,148 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    static inline si16 gen_fix_sat(si32 v)
+    {
+      return (si16)(v < -32768 ? -32768 : (v > 32767 ? 32767 : v));
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // rounded Q15 multiplication, identical to _mm_mulhrs_epi16
+    static inline si16 gen_fix_mul(si16 v, si16 f)
+    {
+      return (si16)(((si32)v * f + 0x4000) >> 15);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // returns (ai + af / 2^15) * v
+    static inline si16 gen_fix_scale(si16 v, si16 ai, si16 af)
+    {
+      si16 t = gen_fix_mul(v, af);
+      for (si32 k = ai; k > 0; --k)
+        t = gen_fix_sat(t + v);
+      for (si32 k = ai; k < 0; ++k)
+        t = gen_fix_sat(t - v);
+      return t;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // returns (ai + af / 2^15) * (v1 + v2)
+    static inline si16 gen_fix_lift(si16 v1, si16 v2, si16 ai, si16 af)
+    {
+      si16 u = gen_fix_sat(v1 + v2);
+      si16 t = gen_fix_mul(u, af);
+      for (si32 k = ai; k > 0; --k)
+        t = gen_fix_sat(t + u);
+      for (si32 k = ai; k < 0; ++k)
+        t = gen_fix_sat(t - u);
+      return t;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_irv_fix_vert_step(const lifting_step* s, const line_buf* sig, 
+                               const line_buf* other, const line_buf* aug, 
+                               ui32 repeat, bool synthesis)
+    {
+      si16 ai, af;
+      irv_fix_split(s->irv.Aatk, ai, af);
+
+      si16* dst = aug->i16;
+      const si16* src1 = sig->i16, * src2 = other->i16;
+      if (synthesis)
+        for (ui32 i = repeat; i > 0; --i, ++dst)
+          *dst = gen_fix_sat(*dst - gen_fix_lift(*src1++, *src2++, ai, af));
+      else
+        for (ui32 i = repeat; i > 0; --i, ++dst)
+          *dst = gen_fix_sat(*dst + gen_fix_lift(*src1++, *src2++, ai, af));
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_irv_fix_vert_times_K(float K, const line_buf* aug, ui32 repeat)
+    {
+      si16 ki, kf;
+      irv_fix_split(K, ki, kf);
+
+      si16* dst = aug->i16;
+      for (ui32 i = repeat; i > 0; --i, ++dst)
+        *dst = gen_fix_scale(*dst, ki, kf);
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    void gen_irv_fix_horz_ana(const param_atk* atk, const line_buf* ldst, 
+                              const line_buf* hdst, const line_buf* src, 
+                              ui32 width, bool even)
+    {
+      if (width > 1)
+      {
+        // split src into ldst and hdst
+        si16* dph = hdst->i16;
+        si16* dpl = ldst->i16;
+        si16* sp = src->i16;
+        ui32 w = width;
+        if (!even)
+        {
+          *dph++ = *sp++; --w;
+        }
+        for (; w > 1; w -= 2)
+        {
+          *dpl++ = *sp++; *dph++ = *sp++;
+        }
+        if (w)
+        {
+          *dpl++ = *sp++; --w;
+        }
+
+        si16* hp = hdst->i16, * lp = ldst->i16;
+        ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
+        ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
+        ui32 num_steps = atk->get_num_steps();
+        for (ui32 j = num_steps; j > 0; --j)
+        {
+          const lifting_step* s = atk->get_step(j - 1);
+          si16 ai, af;
+          irv_fix_split(s->irv.Aatk, ai, af);
+
+          // extension
+          lp[-1] = lp[0];
+          lp[l_width] = lp[l_width - 1];
+          // lifting step
+          const si16* sp = lp + (even ? 1 : 0);
+          si16* dp = hp;
+          for (ui32 i = h_width; i > 0; --i, sp++, dp++)
+            *dp = gen_fix_sat(*dp + gen_fix_lift(sp[-1], sp[0], ai, af));
+
+          // swap buffers
+          si16* t = lp; lp = hp; hp = t;
+          even = !even;
+          ui32 w = l_width; l_width = h_width; h_width = w;
+        }
+
+        {
+          float K = atk->get_K();
+          float K_inv = 1.0f / K;
+          si16 ki, kf;
+          si16* dp;
+
+          irv_fix_split(K_inv, ki, kf);
+          dp = lp;
+          for (ui32 i = l_width; i > 0; --i, ++dp)
+            *dp = gen_fix_scale(*dp, ki, kf);
+
+          irv_fix_split(K, ki, kf);
+          dp = hp;
+          for (ui32 i = h_width; i > 0; --i, ++dp)
+            *dp = gen_fix_scale(*dp, ki, kf);
+        }
+      }
+      else {
+        if (even)
+          ldst->i16[0] = src->i16[0];
+        else
+          hdst->i16[0] = gen_fix_sat(src->i16[0] * 2);
+      }
+    }
+
 #endif // !OJPH_ENABLE_WASM_SIMD
 
   }
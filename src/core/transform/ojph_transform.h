@@ -53,6 +53,17 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void init_wavelet_transform_functions();
 
+    //////////////////////////////////////////////////////////////////////////
+    // Returns true when reversible samples of the given precision should
+    // be stored in 16-bit lines; this is decided here because it depends
+    // on which kernels are compiled in.
+    bool use_16bit_rev_path(ui32 precision);
+
+    //////////////////////////////////////////////////////////////////////////
+    // Returns true when the fixed-point irreversible path can be used for
+    // samples of the given bit depth.
+    bool use_fix16_irv_path(ui32 bit_depth);
+
     /////////////////////////////////////////////////////////////////////////
     // Reversible functions
     /////////////////////////////////////////////////////////////////////////
@@ -91,9 +102,47 @@ namespace ojph {
         const line_buf* src, ui32 width, bool even);
 
     /////////////////////////////////////////////////////////////////////////
+    // hsrc must already carry the 1/K normalisation, which the decoder
+    // applies when dequantising; lsrc is multiplied by K here only when
+    // scale_low is true, that is, when it does not come from a subband
     extern void (*irv_horz_syn)
       (const param_atk* atk, const line_buf* dst, const line_buf* lsrc, 
-        const line_buf* hsrc, ui32 width, bool even);
+        const line_buf* hsrc, ui32 width, bool even, bool scale_low);
+
+    /////////////////////////////////////////////////////////////////////////
+    // Fixed-point irreversible functions, used for encoding only
+    //
+    // Samples are stored in 16-bit lines with IRV_FIX_FRAC_BITS fractional
+    // bits; the [-0.5, 0.5) range of the floating-point path occupies 
+    // [-2048, 2048), leaving headroom up to +/-8.  A lifting coefficient
+    // is split into an integer part and a Q15 fraction; the fractional 
+    // product is rounded to nearest, and sums saturate instead of 
+    // wrapping around.
+    // Error bounds: each lifting step and each K scaling adds at most one
+    // rounding error of 2^-13, i.e., 1/32 of an 8-bit input step, to a 
+    // sample.  Measured against the floating-point path, one level of 
+    // horizontal analysis has an rms error of 0.04 and a maximum error of
+    // 0.16 input steps; for a 5-level decomposition, the arithmetic alone 
+    // limits reconstruction to about 60 dB PSNR, which is negligible 
+    // compared to the quantization error of lossy encoding.  The 
+    // worst-case growth of 9/7 coefficients is 5.4x after one level, and 
+    // exceeds the headroom at deeper levels only for pathological content,
+    // where saturation clips the coefficients.
+    /////////////////////////////////////////////////////////////////////////
+
+    /////////////////////////////////////////////////////////////////////////
+    extern void (*irv_fix_vert_step)
+      (const lifting_step* s, const line_buf* sig, const line_buf* other, 
+        const line_buf* aug, ui32 repeat, bool synthesis);
+
+    /////////////////////////////////////////////////////////////////////////
+    extern void (*irv_fix_vert_times_K)
+      (float K, const line_buf* aug, ui32 repeat);
+
+    /////////////////////////////////////////////////////////////////////////
+    extern void (*irv_fix_horz_ana)
+      (const param_atk* atk, const line_buf* ldst, const line_buf* hdst, 
+        const line_buf* src, ui32 width, bool even);
 
   }
 }
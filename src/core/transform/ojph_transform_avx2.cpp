@@ -135,6 +135,153 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    static inline
+    void avx2_deinterleave16(si16* dpl, si16* dph, si16* sp, int width)
+    {
+      for (; width > 0; width -= 32, sp += 32, dpl += 16, dph += 16)
+      {
+        __m256i a = _mm256_load_si256((__m256i*)sp);
+        __m256i b = _mm256_load_si256((__m256i*)(sp + 16));
+        // even samples sit in the lower half of each 32-bit lane
+        __m256i c = _mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16);
+        __m256i d = _mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16);
+        __m256i e = _mm256_srai_epi32(a, 16);
+        __m256i f = _mm256_srai_epi32(b, 16);
+        // packs works within 128-bit lanes; restore the order
+        __m256i g = _mm256_permute4x64_epi64(_mm256_packs_epi32(c, d), 0xD8);
+        __m256i h = _mm256_permute4x64_epi64(_mm256_packs_epi32(e, f), 0xD8);
+        _mm256_store_si256((__m256i*)dpl, g);
+        _mm256_store_si256((__m256i*)dph, h);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    static inline
+    void avx2_interleave16(si16* dp, si16* spl, si16* sph, int width)
+    {
+      for (; width > 0; width -= 32, dp += 32, spl += 16, sph += 16)
+      {
+        __m256i a = _mm256_load_si256((__m256i*)spl);
+        __m256i b = _mm256_load_si256((__m256i*)sph);
+        __m256i c = _mm256_unpacklo_epi16(a, b);
+        __m256i d = _mm256_unpackhi_epi16(a, b);
+        __m256i e = _mm256_permute2x128_si256(c, d, (2 << 4) | (0));
+        __m256i f = _mm256_permute2x128_si256(c, d, (3 << 4) | (1));
+        _mm256_store_si256((__m256i*)dp, e);
+        _mm256_store_si256((__m256i*)(dp + 16), f);
+      }
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    static
+    void avx2_rev_vert_step16(const lifting_step* s, const line_buf* sig, 
+                              const line_buf* other, const line_buf* aug, 
+                              ui32 repeat, bool synthesis)
+    {
+      const si32 a = s->rev.Aatk;
+      const si32 b = s->rev.Batk;
+      const ui8 e = s->rev.Eatk;
+      __m256i vb = _mm256_set1_epi16((si16)b);
+
+      si16* dst = aug->i16;
+      const si16* src1 = sig->i16, * src2 = other->i16;
+      // The general definition of the wavelet in Part 2 is slightly 
+      // different to part 2, although they are mathematically equivalent
+      // here, we identify the simpler form from Part 1 and employ them
+      if (a == 1)
+      { // 5/3 update and any case with a == 1
+        int i = (int)repeat;
+        if (synthesis)
+          for (; i > 0; i -= 16, dst += 16, src1 += 16, src2 += 16)
+          {
+            __m256i s1 = _mm256_load_si256((__m256i*)src1);
+            __m256i s2 = _mm256_load_si256((__m256i*)src2);
+            __m256i d = _mm256_load_si256((__m256i*)dst);
+            __m256i t = _mm256_add_epi16(s1, s2);
+            __m256i v = _mm256_add_epi16(vb, t);
+            __m256i w = _mm256_srai_epi16(v, e);
+            d = _mm256_sub_epi16(d, w);
+            _mm256_store_si256((__m256i*)dst, d);
+          }
+        else
+          for (; i > 0; i -= 16, dst += 16, src1 += 16, src2 += 16)
+          {
+            __m256i s1 = _mm256_load_si256((__m256i*)src1);
+            __m256i s2 = _mm256_load_si256((__m256i*)src2);
+            __m256i d = _mm256_load_si256((__m256i*)dst);
+            __m256i t = _mm256_add_epi16(s1, s2);
+            __m256i v = _mm256_add_epi16(vb, t);
+            __m256i w = _mm256_srai_epi16(v, e);
+            d = _mm256_add_epi16(d, w);
+            _mm256_store_si256((__m256i*)dst, d);
+          }
+      }
+      else if (a == -1 && b == 1 && e == 1)
+      { // 5/3 predict
+        int i = (int)repeat;
+        if (synthesis)
+          for (; i > 0; i -= 16, dst += 16, src1 += 16, src2 += 16)
+          {
+            __m256i s1 = _mm256_load_si256((__m256i*)src1);
+            __m256i s2 = _mm256_load_si256((__m256i*)src2);
+            __m256i d = _mm256_load_si256((__m256i*)dst);
+            __m256i t = _mm256_add_epi16(s1, s2);
+            __m256i w = _mm256_srai_epi16(t, e);
+            d = _mm256_add_epi16(d, w);
+            _mm256_store_si256((__m256i*)dst, d);
+          }
+        else
+          for (; i > 0; i -= 16, dst += 16, src1 += 16, src2 += 16)
+          {
+            __m256i s1 = _mm256_load_si256((__m256i*)src1);
+            __m256i s2 = _mm256_load_si256((__m256i*)src2);
+            __m256i d = _mm256_load_si256((__m256i*)dst);
+            __m256i t = _mm256_add_epi16(s1, s2);
+            __m256i w = _mm256_srai_epi16(t, e);
+            d = _mm256_sub_epi16(d, w);
+            _mm256_store_si256((__m256i*)dst, d);
+          }
+      }
+      else if (a == -1)
+      { // any case with a == -1, which is not 5/3 predict
+        int i = (int)repeat;
+        if (synthesis)
+          for (; i > 0; i -= 16, dst += 16, src1 += 16, src2 += 16)
+          {
+            __m256i s1 = _mm256_load_si256((__m256i*)src1);
+            __m256i s2 = _mm256_load_si256((__m256i*)src2);
+            __m256i d = _mm256_load_si256((__m256i*)dst);
+            __m256i t = _mm256_add_epi16(s1, s2);
+            __m256i v = _mm256_sub_epi16(vb, t);
+            __m256i w = _mm256_srai_epi16(v, e);
+            d = _mm256_sub_epi16(d, w);
+            _mm256_store_si256((__m256i*)dst, d);
+          }
+        else
+          for (; i > 0; i -= 16, dst += 16, src1 += 16, src2 += 16)
+          {
+            __m256i s1 = _mm256_load_si256((__m256i*)src1);
+            __m256i s2 = _mm256_load_si256((__m256i*)src2);
+            __m256i d = _mm256_load_si256((__m256i*)dst);
+            __m256i t = _mm256_add_epi16(s1, s2);
+            __m256i v = _mm256_sub_epi16(vb, t);
+            __m256i w = _mm256_srai_epi16(v, e);
+            d = _mm256_add_epi16(d, w);
+            _mm256_store_si256((__m256i*)dst, d);
+          }
+      }
+      else { // general case
+        // a * (x + y) may not fit in 16 bits, so this is done in 32 bits
+        if (synthesis)
+          for (ui32 i = repeat; i > 0; --i, ++dst)
+            *dst = (si16)(*dst - ((b + a * (*src1++ + *src2++)) >> e));
+        else
+          for (ui32 i = repeat; i > 0; --i, ++dst)
+            *dst = (si16)(*dst + ((b + a * (*src1++ + *src2++)) >> e));
+      }
+    }
+
     /////////////////////////////////////////////////////////////////////////
     static
     void avx2_rev_vert_step32(const lifting_step* s, const line_buf* sig, 
@@ -381,7 +528,16 @@ namespace ojph {
                             const line_buf* other, const line_buf* aug, 
                             ui32 repeat, bool synthesis)
     {
-      if (((sig != NULL) && (sig->flags & line_buf::LFT_32BIT)) || 
+      if (((sig != NULL) && (sig->flags & line_buf::LFT_16BIT)) || 
+          ((aug != NULL) && (aug->flags & line_buf::LFT_16BIT)) ||
+          ((other != NULL) && (other->flags & line_buf::LFT_16BIT))) 
+      {
+        assert((sig == NULL || sig->flags & line_buf::LFT_16BIT) &&
+               (other == NULL || other->flags & line_buf::LFT_16BIT) && 
+               (aug == NULL || aug->flags & line_buf::LFT_16BIT));
+        avx2_rev_vert_step16(s, sig, other, aug, repeat, synthesis);
+      }
+      else if (((sig != NULL) && (sig->flags & line_buf::LFT_32BIT)) || 
           ((aug != NULL) && (aug->flags & line_buf::LFT_32BIT)) ||
           ((other != NULL) && (other->flags & line_buf::LFT_32BIT))) 
       {
@@ -399,6 +555,153 @@ namespace ojph {
       }
     }
 
+    /////////////////////////////////////////////////////////////////////////
+    static
+    void avx2_rev_horz_ana16(const param_atk* atk, const line_buf* ldst, 
+                             const line_buf* hdst, const line_buf* src, 
+                             ui32 width, bool even)
+    {
+      if (width > 1)
+      {
+        // split src into ldst and hdst
+        {
+          si16* dpl = even ? ldst->i16 : hdst->i16;
+          si16* dph = even ? hdst->i16 : ldst->i16;
+          si16* sp  = src->i16;
+          int w = (int)width;
+          avx2_deinterleave16(dpl, dph, sp, w);
+        }
+
+        si16* hp = hdst->i16, * lp = ldst->i16;
+        ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
+        ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
+        ui32 num_steps = atk->get_num_steps();
+        for (ui32 j = num_steps; j > 0; --j)
+        {
+          // first lifting step
+          const lifting_step* s = atk->get_step(j - 1);
+          const si32 a = s->rev.Aatk;
+          const si32 b = s->rev.Batk;
+          const ui8 e  = s->rev.Eatk;
+              __m256i vb = _mm256_set1_epi16((si16)b);
+
+          // extension
+          lp[-1] = lp[0];
+          lp[l_width] = lp[l_width - 1];
+          // lifting step
+          const si16* sp = lp;
+          si16* dp = hp;
+          if (a == 1)
+          { // 5/3 update and any case with a == 1
+            int i = (int)h_width;
+            if (even)
+            {
+              for (; i > 0; i -= 16, sp += 16, dp += 16)
+              {
+                __m256i s1 = _mm256_load_si256((__m256i*)sp);
+                __m256i s2 = _mm256_loadu_si256((__m256i*)(sp + 1));
+                __m256i d = _mm256_load_si256((__m256i*)dp);
+                __m256i t = _mm256_add_epi16(s1, s2);
+                __m256i v = _mm256_add_epi16(vb, t);
+                __m256i w = _mm256_srai_epi16(v, e);
+                d = _mm256_add_epi16(d, w);
+                _mm256_store_si256((__m256i*)dp, d);
+              }
+            }
+            else
+            {
+              for (; i > 0; i -= 16, sp += 16, dp += 16)
+              {
+                __m256i s1 = _mm256_load_si256((__m256i*)sp);
+                __m256i s2 = _mm256_loadu_si256((__m256i*)(sp - 1));
+                __m256i d = _mm256_load_si256((__m256i*)dp);
+                __m256i t = _mm256_add_epi16(s1, s2);
+                __m256i v = _mm256_add_epi16(vb, t);
+                __m256i w = _mm256_srai_epi16(v, e);
+                d = _mm256_add_epi16(d, w);
+                _mm256_store_si256((__m256i*)dp, d);
+              }
+            }
+          }
+          else if (a == -1 && b == 1 && e == 1)
+          {  // 5/3 predict
+            int i = (int)h_width;
+            if (even)
+              for (; i > 0; i -= 16, sp += 16, dp += 16)
+              {
+                __m256i s1 = _mm256_load_si256((__m256i*)sp);
+                __m256i s2 = _mm256_loadu_si256((__m256i*)(sp + 1));
+                __m256i d = _mm256_load_si256((__m256i*)dp);
+                __m256i t = _mm256_add_epi16(s1, s2);
+                __m256i w = _mm256_srai_epi16(t, e);
+                d = _mm256_sub_epi16(d, w);
+                _mm256_store_si256((__m256i*)dp, d);
+              }
+            else
+              for (; i > 0; i -= 16, sp += 16, dp += 16)
+              {
+                __m256i s1 = _mm256_load_si256((__m256i*)sp);
+                __m256i s2 = _mm256_loadu_si256((__m256i*)(sp - 1));
+                __m256i d = _mm256_load_si256((__m256i*)dp);
+                __m256i t = _mm256_add_epi16(s1, s2);
+                __m256i w = _mm256_srai_epi16(t, e);
+                d = _mm256_sub_epi16(d, w);
+                _mm256_store_si256((__m256i*)dp, d);
+              }
+          }
+          else if (a == -1)
+          { // any case with a == -1, which is not 5/3 predict
+            int i = (int)h_width;
+            if (even)
+              for (; i > 0; i -= 16, sp += 16, dp += 16)
+              {
+                __m256i s1 = _mm256_load_si256((__m256i*)sp);
+                __m256i s2 = _mm256_loadu_si256((__m256i*)(sp + 1));
+                __m256i d = _mm256_load_si256((__m256i*)dp);
+                __m256i t = _mm256_add_epi16(s1, s2);
+                __m256i v = _mm256_sub_epi16(vb, t);
+                __m256i w = _mm256_srai_epi16(v, e);
+                d = _mm256_add_epi16(d, w);
+                _mm256_store_si256((__m256i*)dp, d);
+              }
+            else
+              for (; i > 0; i -= 16, sp += 16, dp += 16)
+              {
+                __m256i s1 = _mm256_load_si256((__m256i*)sp);
+                __m256i s2 = _mm256_loadu_si256((__m256i*)(sp - 1));
+                __m256i d = _mm256_load_si256((__m256i*)dp);
+                __m256i t = _mm256_add_epi16(s1, s2);
+                __m256i v = _mm256_sub_epi16(vb, t);
+                __m256i w = _mm256_srai_epi16(v, e);
+                d = _mm256_add_epi16(d, w);
+                _mm256_store_si256((__m256i*)dp, d);
+              }
+          }
+          else {
+            // general case
+            // a * (x + y) may not fit in 16 bits, so this is done in 32 bits
+            if (even)
+              for (ui32 i = h_width; i > 0; --i, sp++, dp++)
+                *dp = (si16)(*dp + ((b + a * (sp[0] + sp[1])) >> e));
+            else
+              for (ui32 i = h_width; i > 0; --i, sp++, dp++)
+                *dp = (si16)(*dp + ((b + a * (sp[-1] + sp[0])) >> e));
+          }
+
+          // swap buffers
+          si16* t = lp; lp = hp; hp = t;
+          even = !even;
+          ui32 w = l_width; l_width = h_width; h_width = w;
+        }
+      }
+      else {
+        if (even)
+          ldst->i16[0] = src->i16[0];
+        else
+          hdst->i16[0] = (si16)(src->i16[0] << 1);
+      }
+    }
+
     /////////////////////////////////////////////////////////////////////////
     static
     void avx2_rev_horz_ana32(const param_atk* atk, const line_buf* ldst, 
@@ -721,7 +1024,13 @@ namespace ojph {
                            const line_buf* hdst, const line_buf* src, 
                            ui32 width, bool even)
     {
-      if (src->flags & line_buf::LFT_32BIT) 
+      if (src->flags & line_buf::LFT_16BIT) 
+      {
+        assert((ldst == NULL || ldst->flags & line_buf::LFT_16BIT) &&
+               (hdst == NULL || hdst->flags & line_buf::LFT_16BIT));
+        avx2_rev_horz_ana16(atk, ldst, hdst, src, width, even);
+      }
+      else if (src->flags & line_buf::LFT_32BIT) 
       {
         assert((ldst == NULL || ldst->flags & line_buf::LFT_32BIT) &&
                (hdst == NULL || hdst->flags & line_buf::LFT_32BIT));
@@ -736,6 +1045,153 @@ namespace ojph {
       }
     } 
     
+    //////////////////////////////////////////////////////////////////////////
+    static
+    void avx2_rev_horz_syn16(const param_atk* atk, const line_buf* dst, 
+                             const line_buf* lsrc, const line_buf* hsrc, 
+                             ui32 width, bool even)
+    {
+      if (width > 1)
+      {
+        bool ev = even;
+        si16* oth = hsrc->i16, * aug = lsrc->i16;
+        ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
+        ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
+        ui32 num_steps = atk->get_num_steps();
+        for (ui32 j = 0; j < num_steps; ++j)
+        {
+          const lifting_step* s = atk->get_step(j);
+          const si32 a = s->rev.Aatk;
+          const si32 b = s->rev.Batk;
+          const ui8 e  = s->rev.Eatk;
+              __m256i vb = _mm256_set1_epi16((si16)b);
+
+          // extension
+          oth[-1] = oth[0];
+          oth[oth_width] = oth[oth_width - 1];
+          // lifting step
+          const si16* sp = oth;
+          si16* dp = aug;
+          if (a == 1)
+          { // 5/3 update and any case with a == 1
+            int i = (int)aug_width;
+            if (ev)
+            {
+              for (; i > 0; i -= 16, sp += 16, dp += 16)
+              {
+                __m256i s1 = _mm256_load_si256((__m256i*)sp);
+                __m256i s2 = _mm256_loadu_si256((__m256i*)(sp - 1));
+                __m256i d = _mm256_load_si256((__m256i*)dp);
+                __m256i t = _mm256_add_epi16(s1, s2);
+                __m256i v = _mm256_add_epi16(vb, t);
+                __m256i w = _mm256_srai_epi16(v, e);
+                d = _mm256_sub_epi16(d, w);
+                _mm256_store_si256((__m256i*)dp, d);
+              }
+            }
+            else
+            {
+              for (; i > 0; i -= 16, sp += 16, dp += 16)
+              {
+                __m256i s1 = _mm256_load_si256((__m256i*)sp);
+                __m256i s2 = _mm256_loadu_si256((__m256i*)(sp + 1));
+                __m256i d = _mm256_load_si256((__m256i*)dp);
+                __m256i t = _mm256_add_epi16(s1, s2);
+                __m256i v = _mm256_add_epi16(vb, t);
+                __m256i w = _mm256_srai_epi16(v, e);
+                d = _mm256_sub_epi16(d, w);
+                _mm256_store_si256((__m256i*)dp, d);
+              }
+            }
+          }
+          else if (a == -1 && b == 1 && e == 1)
+          {  // 5/3 predict
+            int i = (int)aug_width;
+            if (ev)
+              for (; i > 0; i -= 16, sp += 16, dp += 16)
+              {
+                __m256i s1 = _mm256_load_si256((__m256i*)sp);
+                __m256i s2 = _mm256_loadu_si256((__m256i*)(sp - 1));
+                __m256i d = _mm256_load_si256((__m256i*)dp);
+                __m256i t = _mm256_add_epi16(s1, s2);
+                __m256i w = _mm256_srai_epi16(t, e);
+                d = _mm256_add_epi16(d, w);
+                _mm256_store_si256((__m256i*)dp, d);
+              }
+            else
+              for (; i > 0; i -= 16, sp += 16, dp += 16)
+              {
+                __m256i s1 = _mm256_load_si256((__m256i*)sp);
+                __m256i s2 = _mm256_loadu_si256((__m256i*)(sp + 1));
+                __m256i d = _mm256_load_si256((__m256i*)dp);
+                __m256i t = _mm256_add_epi16(s1, s2);
+                __m256i w = _mm256_srai_epi16(t, e);
+                d = _mm256_add_epi16(d, w);
+                _mm256_store_si256((__m256i*)dp, d);
+              }
+          }
+          else if (a == -1)
+          { // any case with a == -1, which is not 5/3 predict
+            int i = (int)aug_width;
+            if (ev)
+              for (; i > 0; i -= 16, sp += 16, dp += 16)
+              {
+                __m256i s1 = _mm256_load_si256((__m256i*)sp);
+                __m256i s2 = _mm256_loadu_si256((__m256i*)(sp - 1));
+                __m256i d = _mm256_load_si256((__m256i*)dp);
+                __m256i t = _mm256_add_epi16(s1, s2);
+                __m256i v = _mm256_sub_epi16(vb, t);
+                __m256i w = _mm256_srai_epi16(v, e);
+                d = _mm256_sub_epi16(d, w);
+                _mm256_store_si256((__m256i*)dp, d);
+              }
+            else
+              for (; i > 0; i -= 16, sp += 16, dp += 16)
+              {
+                __m256i s1 = _mm256_load_si256((__m256i*)sp);
+                __m256i s2 = _mm256_loadu_si256((__m256i*)(sp + 1));
+                __m256i d = _mm256_load_si256((__m256i*)dp);
+                __m256i t = _mm256_add_epi16(s1, s2);
+                __m256i v = _mm256_sub_epi16(vb, t);
+                __m256i w = _mm256_srai_epi16(v, e);
+                d = _mm256_sub_epi16(d, w);
+                _mm256_store_si256((__m256i*)dp, d);
+              }
+          }
+          else {
+            // general case
+            // a * (x + y) may not fit in 16 bits, so this is done in 32 bits
+            if (ev)
+              for (ui32 i = aug_width; i > 0; --i, sp++, dp++)
+                *dp = (si16)(*dp - ((b + a * (sp[-1] + sp[0])) >> e));
+            else
+              for (ui32 i = aug_width; i > 0; --i, sp++, dp++)
+                *dp = (si16)(*dp - ((b + a * (sp[0] + sp[1])) >> e));
+          }
+
+          // swap buffers
+          si16* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+        }
+
+        // combine both lsrc and hsrc into dst
+        {
+          si16* dp  = dst->i16;
+          si16* spl = even ? lsrc->i16 : hsrc->i16;
+          si16* sph = even ? hsrc->i16 : lsrc->i16;
+          int w = (int)width;
+          avx2_interleave16(dp, spl, sph, w);
+        }
+      }
+      else {
+        if (even)
+          dst->i16[0] = lsrc->i16[0];
+        else
+          dst->i16[0] = (si16)(hsrc->i16[0] >> 1);
+      }
+    }
+
     //////////////////////////////////////////////////////////////////////////
     static
     void avx2_rev_horz_syn32(const param_atk* atk, const line_buf* dst, 
@@ -1058,7 +1514,13 @@ namespace ojph {
                            const line_buf* lsrc, const line_buf* hsrc, 
                            ui32 width, bool even)
     {
-      if (dst->flags & line_buf::LFT_32BIT) 
+      if (dst->flags & line_buf::LFT_16BIT) 
+      {
+        assert((lsrc == NULL || lsrc->flags & line_buf::LFT_16BIT) && 
+               (hsrc == NULL || hsrc->flags & line_buf::LFT_16BIT));
+        avx2_rev_horz_syn16(atk, dst, lsrc, hsrc, width, even);
+      }
+      else if (dst->flags & line_buf::LFT_32BIT) 
       {
         assert((lsrc == NULL || lsrc->flags & line_buf::LFT_32BIT) && 
                (hsrc == NULL || hsrc->flags & line_buf::LFT_32BIT));
@@ -1073,6 +1535,167 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    // returns (ai + af / 2^15) * v; matches gen_fix_scale
+    static inline 
+    __m256i avx2_fix_scale(__m256i v, si16 ai, __m256i vf)
+    {
+      __m256i t = _mm256_mulhrs_epi16(v, vf);
+      for (si32 k = ai; k > 0; --k)
+        t = _mm256_adds_epi16(t, v);
+      for (si32 k = ai; k < 0; ++k)
+        t = _mm256_subs_epi16(t, v);
+      return t;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // returns (ai + af / 2^15) * (v1 + v2); matches gen_fix_lift
+    static inline 
+    __m256i avx2_fix_lift(__m256i v1, __m256i v2, si16 ai, __m256i vf)
+    {
+      __m256i u = _mm256_adds_epi16(v1, v2);
+      __m256i t = _mm256_mulhrs_epi16(u, vf);
+      for (si32 k = ai; k > 0; --k)
+        t = _mm256_adds_epi16(t, u);
+      for (si32 k = ai; k < 0; ++k)
+        t = _mm256_subs_epi16(t, u);
+      return t;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    static inline 
+    void avx2_fix_multiply_const(si16* p, float K, int width)
+    {
+      si16 ki, kf;
+      irv_fix_split(K, ki, kf);
+      __m256i vf = _mm256_set1_epi16(kf);
+      for (; width > 0; width -= 16, p += 16)
+      {
+        __m256i v = _mm256_load_si256((__m256i*)p);
+        _mm256_store_si256((__m256i*)p, avx2_fix_scale(v, ki, vf));
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_irv_fix_vert_step(const lifting_step* s, const line_buf* sig, 
+                                const line_buf* other, const line_buf* aug, 
+                                ui32 repeat, bool synthesis)
+    {
+      si16 ai, af;
+      irv_fix_split(s->irv.Aatk, ai, af);
+      __m256i vf = _mm256_set1_epi16(af);
+
+      si16* dst = aug->i16;
+      const si16* src1 = sig->i16, * src2 = other->i16;
+      int i = (int)repeat;
+      if (synthesis)
+        for (; i > 0; i -= 16, dst += 16, src1 += 16, src2 += 16)
+        {
+          __m256i s1 = _mm256_load_si256((__m256i*)src1);
+          __m256i s2 = _mm256_load_si256((__m256i*)src2);
+          __m256i d = _mm256_load_si256((__m256i*)dst);
+          d = _mm256_subs_epi16(d, avx2_fix_lift(s1, s2, ai, vf));
+          _mm256_store_si256((__m256i*)dst, d);
+        }
+      else
+        for (; i > 0; i -= 16, dst += 16, src1 += 16, src2 += 16)
+        {
+          __m256i s1 = _mm256_load_si256((__m256i*)src1);
+          __m256i s2 = _mm256_load_si256((__m256i*)src2);
+          __m256i d = _mm256_load_si256((__m256i*)dst);
+          d = _mm256_adds_epi16(d, avx2_fix_lift(s1, s2, ai, vf));
+          _mm256_store_si256((__m256i*)dst, d);
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_irv_fix_vert_times_K(float K, const line_buf* aug, ui32 repeat)
+    {
+      avx2_fix_multiply_const(aug->i16, K, (int)repeat);
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    void avx2_irv_fix_horz_ana(const param_atk* atk, const line_buf* ldst, 
+                               const line_buf* hdst, const line_buf* src, 
+                               ui32 width, bool even)
+    {
+      if (width > 1)
+      {
+        // split src into ldst and hdst
+        {
+          si16* dpl = even ? ldst->i16 : hdst->i16;
+          si16* dph = even ? hdst->i16 : ldst->i16;
+          si16* sp = src->i16;
+          int w = (int)width;
+          avx2_deinterleave16(dpl, dph, sp, w);
+        }
+
+        // the actual horizontal transform
+        si16* hp = hdst->i16, * lp = ldst->i16;
+        ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
+        ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
+        ui32 num_steps = atk->get_num_steps();
+        for (ui32 j = num_steps; j > 0; --j)
+        {
+          const lifting_step* s = atk->get_step(j - 1);
+          si16 ai, af;
+          irv_fix_split(s->irv.Aatk, ai, af);
+          __m256i vf = _mm256_set1_epi16(af);
+
+          // extension
+          lp[-1] = lp[0];
+          lp[l_width] = lp[l_width - 1];
+          // lifting step
+          const si16* sp = lp;
+          si16* dp = hp;
+          int i = (int)h_width;
+          if (even)
+          {
+            for (; i > 0; i -= 16, sp += 16, dp += 16)
+            {
+              __m256i m = _mm256_load_si256((__m256i*)sp);
+              __m256i n = _mm256_loadu_si256((__m256i*)(sp + 1));
+              __m256i p = _mm256_load_si256((__m256i*)dp);
+              p = _mm256_adds_epi16(p, avx2_fix_lift(m, n, ai, vf));
+              _mm256_store_si256((__m256i*)dp, p);
+            }
+          }
+          else
+          {
+            for (; i > 0; i -= 16, sp += 16, dp += 16)
+            {
+              __m256i m = _mm256_load_si256((__m256i*)sp);
+              __m256i n = _mm256_loadu_si256((__m256i*)(sp - 1));
+              __m256i p = _mm256_load_si256((__m256i*)dp);
+              p = _mm256_adds_epi16(p, avx2_fix_lift(n, m, ai, vf));
+              _mm256_store_si256((__m256i*)dp, p);
+            }
+          }
+
+          // swap buffers
+          si16* t = lp; lp = hp; hp = t;
+          even = !even;
+          ui32 w = l_width; l_width = h_width; h_width = w;
+        }
+
+        { // multiply by K or 1/K
+          float K = atk->get_K();
+          float K_inv = 1.0f / K;
+          avx2_fix_multiply_const(lp, K_inv, (int)l_width);
+          avx2_fix_multiply_const(hp, K, (int)h_width);
+        }
+      }
+      else {
+        if (even)
+          ldst->i16[0] = src->i16[0];
+        else
+        {
+          si32 v = src->i16[0] * 2;
+          hdst->i16[0] = (si16)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+        }
+      }
+    }
+
   } // !local
 } // !ojph
 
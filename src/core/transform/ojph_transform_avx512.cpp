@@ -315,7 +315,7 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void avx512_irv_horz_syn(const param_atk* atk, const line_buf* dst, 
                              const line_buf* lsrc, const line_buf* hsrc, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool scale_low)
     {
       if (width > 1)
       {
@@ -324,12 +324,8 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
 
-        { // multiply by K or 1/K
-          float K = atk->get_K();
-          float K_inv = 1.0f / K;
-          avx512_multiply_const(aug, K, (int)aug_width);
-          avx512_multiply_const(oth, K_inv, (int)oth_width);
-        }
+        if (scale_low) // bands 1 to 3 are scaled when dequantised
+          avx512_multiply_const(aug, atk->get_K(), (int)aug_width);
 
         // the actual horizontal transform
         ui32 num_steps = atk->get_num_steps();
@@ -50,6 +50,22 @@ namespace ojph {
     struct param_atk;
     union lifting_step;
 
+    //////////////////////////////////////////////////////////////////////////
+    // Splits a lifting coefficient for the fixed-point irreversible path
+    // into an integer part, ai, and a Q15 fraction, af, such that 
+    // a ~= ai + af / 2^15; all implementations must use this function to 
+    // produce identical results.
+    static inline void irv_fix_split(float a, si16& ai, si16& af)
+    {
+      double t = (double)a;
+      si32 i = (si32)t; // truncates towards zero, so |t - i| < 1
+      double f = (t - i) * 32768.0;
+      si32 q = (si32)(f + (f >= 0.0 ? 0.5 : -0.5));
+      q = q > 32767 ? 32767 : (q < -32767 ? -32767 : q);
+      ai = (si16)i;
+      af = (si16)q;
+    }
+
     //////////////////////////////////////////////////////////////////////////
     //
     //
@@ -78,7 +94,20 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void gen_irv_horz_syn(const param_atk *atk, const line_buf* dst, 
                           const line_buf *lsrc, const line_buf *hsrc, 
-                          ui32 width, bool even);
+                          ui32 width, bool even, bool scale_low);
+
+    /////////////////////////////////////////////////////////////////////////
+    void gen_irv_fix_vert_step(const lifting_step* s, const line_buf* sig, 
+                               const line_buf* other, const line_buf* aug, 
+                               ui32 repeat, bool synthesis);
+
+    /////////////////////////////////////////////////////////////////////////
+    void gen_irv_fix_vert_times_K(float K, const line_buf* aug, ui32 repeat);
+
+    /////////////////////////////////////////////////////////////////////////
+    void gen_irv_fix_horz_ana(const param_atk* atk, const line_buf* ldst, 
+                              const line_buf* hdst, const line_buf* src, 
+                              ui32 width, bool even);
 
     //////////////////////////////////////////////////////////////////////////
     // Reversible functions
@@ -127,7 +156,7 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void sse_irv_horz_syn(const param_atk *atk, const line_buf* dst,
                           const line_buf *lsrc, const line_buf *hsrc, 
-                          ui32 width, bool even);
+                          ui32 width, bool even, bool scale_low);
 
     //////////////////////////////////////////////////////////////////////////
     //
@@ -185,7 +214,7 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void avx_irv_horz_syn(const param_atk *atk, const line_buf* dst,
                           const line_buf *lsrc, const line_buf *hsrc, 
-                          ui32 width, bool even);
+                          ui32 width, bool even, bool scale_low);
 
     //////////////////////////////////////////////////////////////////////////
     //
@@ -214,6 +243,23 @@ namespace ojph {
                            const line_buf* lsrc, const line_buf* hsrc, 
                            ui32 width, bool even);
 
+    //////////////////////////////////////////////////////////////////////////
+    // Fixed-point irreversible functions
+    //////////////////////////////////////////////////////////////////////////
+
+    /////////////////////////////////////////////////////////////////////////
+    void avx2_irv_fix_vert_step(const lifting_step* s, const line_buf* sig, 
+                                const line_buf* other, const line_buf* aug, 
+                                ui32 repeat, bool synthesis);
+
+    /////////////////////////////////////////////////////////////////////////
+    void avx2_irv_fix_vert_times_K(float K, const line_buf* aug, ui32 repeat);
+
+    /////////////////////////////////////////////////////////////////////////
+    void avx2_irv_fix_horz_ana(const param_atk* atk, const line_buf* ldst, 
+                               const line_buf* hdst, const line_buf* src, 
+                               ui32 width, bool even);
+
     //////////////////////////////////////////////////////////////////////////
     //
     //
@@ -242,7 +288,7 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void avx512_irv_horz_syn(const param_atk *atk, const line_buf* dst,
                              const line_buf *lsrc, const line_buf *hsrc, 
-                             ui32 width, bool even);
+                             ui32 width, bool even, bool scale_low);
 
 
     //////////////////////////////////////////////////////////////////////////
@@ -292,7 +338,7 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void wasm_irv_horz_syn(const param_atk *atk, const line_buf* dst,
                            const line_buf *lsrc, const line_buf *hsrc, 
-                           ui32 width, bool even);
+                           ui32 width, bool even, bool scale_low);
 
     //////////////////////////////////////////////////////////////////////////
     // Reversible functions
@@ -126,6 +126,148 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    static inline
+    void sse2_deinterleave16(si16* dpl, si16* dph, si16* sp, int width)
+    {
+      for (; width > 0; width -= 16, sp += 16, dpl += 8, dph += 8)
+      {
+        __m128i a = _mm_load_si128((__m128i*)sp);
+        __m128i b = _mm_load_si128((__m128i*)(sp + 8));
+        // even samples sit in the lower half of each 32-bit lane
+        __m128i c = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+        __m128i d = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+        __m128i e = _mm_srai_epi32(a, 16);
+        __m128i f = _mm_srai_epi32(b, 16);
+        _mm_store_si128((__m128i*)dpl, _mm_packs_epi32(c, d));
+        _mm_store_si128((__m128i*)dph, _mm_packs_epi32(e, f));
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    static inline
+    void sse2_interleave16(si16* dp, si16* spl, si16* sph, int width)
+    {
+      for (; width > 0; width -= 16, dp += 16, spl += 8, sph += 8)
+      {
+        __m128i a = _mm_load_si128((__m128i*)spl);
+        __m128i b = _mm_load_si128((__m128i*)sph);
+        __m128i c = _mm_unpacklo_epi16(a, b);
+        __m128i d = _mm_unpackhi_epi16(a, b);
+        _mm_store_si128((__m128i*)dp, c);
+        _mm_store_si128((__m128i*)(dp + 8), d);
+      }
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    static
+    void sse2_rev_vert_step16(const lifting_step* s, const line_buf* sig, 
+                              const line_buf* other, const line_buf* aug, 
+                              ui32 repeat, bool synthesis)
+    {
+      const si32 a = s->rev.Aatk;
+      const si32 b = s->rev.Batk;
+      const ui8 e = s->rev.Eatk;
+      __m128i vb = _mm_set1_epi16((si16)b);
+
+      si16* dst = aug->i16;
+      const si16* src1 = sig->i16, * src2 = other->i16;
+      // The general definition of the wavelet in Part 2 is slightly 
+      // different to part 2, although they are mathematically equivalent
+      // here, we identify the simpler form from Part 1 and employ them
+      if (a == 1)
+      { // 5/3 update and any case with a == 1
+        int i = (int)repeat;
+        if (synthesis)
+          for (; i > 0; i -= 8, dst += 8, src1 += 8, src2 += 8)
+          {
+            __m128i s1 = _mm_load_si128((__m128i*)src1);
+            __m128i s2 = _mm_load_si128((__m128i*)src2);
+            __m128i d = _mm_load_si128((__m128i*)dst);
+            __m128i t = _mm_add_epi16(s1, s2);
+            __m128i v = _mm_add_epi16(vb, t);
+            __m128i w = _mm_srai_epi16(v, e);
+            d = _mm_sub_epi16(d, w);
+            _mm_store_si128((__m128i*)dst, d);
+          }
+        else
+          for (; i > 0; i -= 8, dst += 8, src1 += 8, src2 += 8)
+          {
+            __m128i s1 = _mm_load_si128((__m128i*)src1);
+            __m128i s2 = _mm_load_si128((__m128i*)src2);
+            __m128i d = _mm_load_si128((__m128i*)dst);
+            __m128i t = _mm_add_epi16(s1, s2);
+            __m128i v = _mm_add_epi16(vb, t);
+            __m128i w = _mm_srai_epi16(v, e);
+            d = _mm_add_epi16(d, w);
+            _mm_store_si128((__m128i*)dst, d);
+          }
+      }
+      else if (a == -1 && b == 1 && e == 1)
+      { // 5/3 predict
+        int i = (int)repeat;
+        if (synthesis)
+          for (; i > 0; i -= 8, dst += 8, src1 += 8, src2 += 8)
+          {
+            __m128i s1 = _mm_load_si128((__m128i*)src1);
+            __m128i s2 = _mm_load_si128((__m128i*)src2);
+            __m128i d = _mm_load_si128((__m128i*)dst);
+            __m128i t = _mm_add_epi16(s1, s2);
+            __m128i w = _mm_srai_epi16(t, e);
+            d = _mm_add_epi16(d, w);
+            _mm_store_si128((__m128i*)dst, d);
+          }
+        else
+          for (; i > 0; i -= 8, dst += 8, src1 += 8, src2 += 8)
+          {
+            __m128i s1 = _mm_load_si128((__m128i*)src1);
+            __m128i s2 = _mm_load_si128((__m128i*)src2);
+            __m128i d = _mm_load_si128((__m128i*)dst);
+            __m128i t = _mm_add_epi16(s1, s2);
+            __m128i w = _mm_srai_epi16(t, e);
+            d = _mm_sub_epi16(d, w);
+            _mm_store_si128((__m128i*)dst, d);
+          }
+      }
+      else if (a == -1)
+      { // any case with a == -1, which is not 5/3 predict
+        int i = (int)repeat;
+        if (synthesis)
+          for (; i > 0; i -= 8, dst += 8, src1 += 8, src2 += 8)
+          {
+            __m128i s1 = _mm_load_si128((__m128i*)src1);
+            __m128i s2 = _mm_load_si128((__m128i*)src2);
+            __m128i d = _mm_load_si128((__m128i*)dst);
+            __m128i t = _mm_add_epi16(s1, s2);
+            __m128i v = _mm_sub_epi16(vb, t);
+            __m128i w = _mm_srai_epi16(v, e);
+            d = _mm_sub_epi16(d, w);
+            _mm_store_si128((__m128i*)dst, d);
+          }
+        else
+          for (; i > 0; i -= 8, dst += 8, src1 += 8, src2 += 8)
+          {
+            __m128i s1 = _mm_load_si128((__m128i*)src1);
+            __m128i s2 = _mm_load_si128((__m128i*)src2);
+            __m128i d = _mm_load_si128((__m128i*)dst);
+            __m128i t = _mm_add_epi16(s1, s2);
+            __m128i v = _mm_sub_epi16(vb, t);
+            __m128i w = _mm_srai_epi16(v, e);
+            d = _mm_add_epi16(d, w);
+            _mm_store_si128((__m128i*)dst, d);
+          }
+      }
+      else { // general case
+        // a * (x + y) may not fit in 16 bits, so this is done in 32 bits
+        if (synthesis)
+          for (ui32 i = repeat; i > 0; --i, ++dst)
+            *dst = (si16)(*dst - ((b + a * (*src1++ + *src2++)) >> e));
+        else
+          for (ui32 i = repeat; i > 0; --i, ++dst)
+            *dst = (si16)(*dst + ((b + a * (*src1++ + *src2++)) >> e));
+      }
+    }
+
     /////////////////////////////////////////////////////////////////////////
     static
     void sse2_rev_vert_step32(const lifting_step* s, const line_buf* sig, 
@@ -352,7 +494,16 @@ namespace ojph {
                             const line_buf* other, const line_buf* aug, 
                             ui32 repeat, bool synthesis)
     {
-      if (((sig != NULL) && (sig->flags & line_buf::LFT_32BIT)) || 
+      if (((sig != NULL) && (sig->flags & line_buf::LFT_16BIT)) || 
+          ((aug != NULL) && (aug->flags & line_buf::LFT_16BIT)) ||
+          ((other != NULL) && (other->flags & line_buf::LFT_16BIT))) 
+      {
+        assert((sig == NULL || sig->flags & line_buf::LFT_16BIT) &&
+               (other == NULL || other->flags & line_buf::LFT_16BIT) && 
+               (aug == NULL || aug->flags & line_buf::LFT_16BIT));
+        sse2_rev_vert_step16(s, sig, other, aug, repeat, synthesis);
+      }
+      else if (((sig != NULL) && (sig->flags & line_buf::LFT_32BIT)) || 
           ((aug != NULL) && (aug->flags & line_buf::LFT_32BIT)) ||
           ((other != NULL) && (other->flags & line_buf::LFT_32BIT))) 
       {
@@ -370,6 +521,153 @@ namespace ojph {
       }
     }
 
+    /////////////////////////////////////////////////////////////////////////
+    static
+    void sse2_rev_horz_ana16(const param_atk* atk, const line_buf* ldst, 
+                             const line_buf* hdst, const line_buf* src, 
+                             ui32 width, bool even)
+    {
+      if (width > 1)
+      {
+        // split src into ldst and hdst
+        {
+          si16* dpl = even ? ldst->i16 : hdst->i16;
+          si16* dph = even ? hdst->i16 : ldst->i16;
+          si16* sp = src->i16;
+          int w = (int)width;
+          sse2_deinterleave16(dpl, dph, sp, w);
+        }
+
+        si16* hp = hdst->i16, * lp = ldst->i16;
+        ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
+        ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
+        ui32 num_steps = atk->get_num_steps();
+        for (ui32 j = num_steps; j > 0; --j)
+        {
+          // first lifting step
+          const lifting_step* s = atk->get_step(j - 1);
+          const si32 a = s->rev.Aatk;
+          const si32 b = s->rev.Batk;
+          const ui8 e = s->rev.Eatk;
+          __m128i vb = _mm_set1_epi16((si16)b);
+
+          // extension
+          lp[-1] = lp[0];
+          lp[l_width] = lp[l_width - 1];
+          // lifting step
+          const si16* sp = lp;
+          si16* dp = hp;
+          if (a == 1)
+          { // 5/3 update and any case with a == 1
+            int i = (int)h_width;
+            if (even)
+            {
+              for (; i > 0; i -= 8, sp += 8, dp += 8)
+              {
+                __m128i s1 = _mm_load_si128((__m128i*)sp);
+                __m128i s2 = _mm_loadu_si128((__m128i*)(sp + 1));
+                __m128i d = _mm_load_si128((__m128i*)dp);
+                __m128i t = _mm_add_epi16(s1, s2);
+                __m128i v = _mm_add_epi16(vb, t);
+                __m128i w = _mm_srai_epi16(v, e);
+                d = _mm_add_epi16(d, w);
+                _mm_store_si128((__m128i*)dp, d);
+              }
+            }
+            else
+            {
+              for (; i > 0; i -= 8, sp += 8, dp += 8)
+              {
+                __m128i s1 = _mm_load_si128((__m128i*)sp);
+                __m128i s2 = _mm_loadu_si128((__m128i*)(sp - 1));
+                __m128i d = _mm_load_si128((__m128i*)dp);
+                __m128i t = _mm_add_epi16(s1, s2);
+                __m128i v = _mm_add_epi16(vb, t);
+                __m128i w = _mm_srai_epi16(v, e);
+                d = _mm_add_epi16(d, w);
+                _mm_store_si128((__m128i*)dp, d);
+              }
+            }
+          }
+          else if (a == -1 && b == 1 && e == 1)
+          {  // 5/3 predict
+            int i = (int)h_width;
+            if (even)
+              for (; i > 0; i -= 8, sp += 8, dp += 8)
+              {
+                __m128i s1 = _mm_load_si128((__m128i*)sp);
+                __m128i s2 = _mm_loadu_si128((__m128i*)(sp + 1));
+                __m128i d = _mm_load_si128((__m128i*)dp);
+                __m128i t = _mm_add_epi16(s1, s2);
+                __m128i w = _mm_srai_epi16(t, e);
+                d = _mm_sub_epi16(d, w);
+                _mm_store_si128((__m128i*)dp, d);
+              }
+            else
+              for (; i > 0; i -= 8, sp += 8, dp += 8)
+              {
+                __m128i s1 = _mm_load_si128((__m128i*)sp);
+                __m128i s2 = _mm_loadu_si128((__m128i*)(sp - 1));
+                __m128i d = _mm_load_si128((__m128i*)dp);
+                __m128i t = _mm_add_epi16(s1, s2);
+                __m128i w = _mm_srai_epi16(t, e);
+                d = _mm_sub_epi16(d, w);
+                _mm_store_si128((__m128i*)dp, d);
+              }
+          }
+          else if (a == -1)
+          { // any case with a == -1, which is not 5/3 predict
+            int i = (int)h_width;
+            if (even)
+              for (; i > 0; i -= 8, sp += 8, dp += 8)
+              {
+                __m128i s1 = _mm_load_si128((__m128i*)sp);
+                __m128i s2 = _mm_loadu_si128((__m128i*)(sp + 1));
+                __m128i d = _mm_load_si128((__m128i*)dp);
+                __m128i t = _mm_add_epi16(s1, s2);
+                __m128i v = _mm_sub_epi16(vb, t);
+                __m128i w = _mm_srai_epi16(v, e);
+                d = _mm_add_epi16(d, w);
+                _mm_store_si128((__m128i*)dp, d);
+              }
+            else
+              for (; i > 0; i -= 8, sp += 8, dp += 8)
+              {
+                __m128i s1 = _mm_load_si128((__m128i*)sp);
+                __m128i s2 = _mm_loadu_si128((__m128i*)(sp - 1));
+                __m128i d = _mm_load_si128((__m128i*)dp);
+                __m128i t = _mm_add_epi16(s1, s2);
+                __m128i v = _mm_sub_epi16(vb, t);
+                __m128i w = _mm_srai_epi16(v, e);
+                d = _mm_add_epi16(d, w);
+                _mm_store_si128((__m128i*)dp, d);
+              }
+          }
+          else {
+            // general case
+            // a * (x + y) may not fit in 16 bits, so this is done in 32 bits
+            if (even)
+              for (ui32 i = h_width; i > 0; --i, sp++, dp++)
+                *dp = (si16)(*dp + ((b + a * (sp[0] + sp[1])) >> e));
+            else
+              for (ui32 i = h_width; i > 0; --i, sp++, dp++)
+                *dp = (si16)(*dp + ((b + a * (sp[-1] + sp[0])) >> e));
+          }
+
+          // swap buffers
+          si16* t = lp; lp = hp; hp = t;
+          even = !even;
+          ui32 w = l_width; l_width = h_width; h_width = w;
+        }
+      }
+      else {
+        if (even)
+          ldst->i16[0] = src->i16[0];
+        else
+          hdst->i16[0] = (si16)(src->i16[0] << 1);
+      }
+    }
+
     /////////////////////////////////////////////////////////////////////////
     static
     void sse2_rev_horz_ana32(const param_atk* atk, const line_buf* ldst, 
@@ -670,7 +968,13 @@ namespace ojph {
                            const line_buf* hdst, const line_buf* src, 
                            ui32 width, bool even)
     {
-      if (src->flags & line_buf::LFT_32BIT) 
+      if (src->flags & line_buf::LFT_16BIT) 
+      {
+        assert((ldst == NULL || ldst->flags & line_buf::LFT_16BIT) &&
+               (hdst == NULL || hdst->flags & line_buf::LFT_16BIT));
+        sse2_rev_horz_ana16(atk, ldst, hdst, src, width, even);
+      }
+      else if (src->flags & line_buf::LFT_32BIT) 
       {
         assert((ldst == NULL || ldst->flags & line_buf::LFT_32BIT) &&
                (hdst == NULL || hdst->flags & line_buf::LFT_32BIT));
@@ -685,6 +989,153 @@ namespace ojph {
       }
     }    
     
+    //////////////////////////////////////////////////////////////////////////
+    static
+    void sse2_rev_horz_syn16(const param_atk* atk, const line_buf* dst, 
+                             const line_buf* lsrc, const line_buf* hsrc, 
+                             ui32 width, bool even)
+    {
+      if (width > 1)
+      {
+        bool ev = even;
+        si16* oth = hsrc->i16, * aug = lsrc->i16;
+        ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
+        ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
+        ui32 num_steps = atk->get_num_steps();
+        for (ui32 j = 0; j < num_steps; ++j)
+        {
+          const lifting_step* s = atk->get_step(j);
+          const si32 a = s->rev.Aatk;
+          const si32 b = s->rev.Batk;
+          const ui8 e = s->rev.Eatk;
+          __m128i vb = _mm_set1_epi16((si16)b);
+
+          // extension
+          oth[-1] = oth[0];
+          oth[oth_width] = oth[oth_width - 1];
+          // lifting step
+          const si16* sp = oth;
+          si16* dp = aug;
+          if (a == 1)
+          { // 5/3 update and any case with a == 1
+            int i = (int)aug_width;
+            if (ev)
+            {
+              for (; i > 0; i -= 8, sp += 8, dp += 8)
+              {
+                __m128i s1 = _mm_load_si128((__m128i*)sp);
+                __m128i s2 = _mm_loadu_si128((__m128i*)(sp - 1));
+                __m128i d = _mm_load_si128((__m128i*)dp);
+                __m128i t = _mm_add_epi16(s1, s2);
+                __m128i v = _mm_add_epi16(vb, t);
+                __m128i w = _mm_srai_epi16(v, e);
+                d = _mm_sub_epi16(d, w);
+                _mm_store_si128((__m128i*)dp, d);
+              }
+            }
+            else
+            {
+              for (; i > 0; i -= 8, sp += 8, dp += 8)
+              {
+                __m128i s1 = _mm_load_si128((__m128i*)sp);
+                __m128i s2 = _mm_loadu_si128((__m128i*)(sp + 1));
+                __m128i d = _mm_load_si128((__m128i*)dp);
+                __m128i t = _mm_add_epi16(s1, s2);
+                __m128i v = _mm_add_epi16(vb, t);
+                __m128i w = _mm_srai_epi16(v, e);
+                d = _mm_sub_epi16(d, w);
+                _mm_store_si128((__m128i*)dp, d);
+              }
+            }
+          }
+          else if (a == -1 && b == 1 && e == 1)
+          {  // 5/3 predict
+            int i = (int)aug_width;
+            if (ev)
+              for (; i > 0; i -= 8, sp += 8, dp += 8)
+              {
+                __m128i s1 = _mm_load_si128((__m128i*)sp);
+                __m128i s2 = _mm_loadu_si128((__m128i*)(sp - 1));
+                __m128i d = _mm_load_si128((__m128i*)dp);
+                __m128i t = _mm_add_epi16(s1, s2);
+                __m128i w = _mm_srai_epi16(t, e);
+                d = _mm_add_epi16(d, w);
+                _mm_store_si128((__m128i*)dp, d);
+              }
+            else
+              for (; i > 0; i -= 8, sp += 8, dp += 8)
+              {
+                __m128i s1 = _mm_load_si128((__m128i*)sp);
+                __m128i s2 = _mm_loadu_si128((__m128i*)(sp + 1));
+                __m128i d = _mm_load_si128((__m128i*)dp);
+                __m128i t = _mm_add_epi16(s1, s2);
+                __m128i w = _mm_srai_epi16(t, e);
+                d = _mm_add_epi16(d, w);
+                _mm_store_si128((__m128i*)dp, d);
+              }
+          }
+          else if (a == -1)
+          { // any case with a == -1, which is not 5/3 predict
+            int i = (int)aug_width;
+            if (ev)
+              for (; i > 0; i -= 8, sp += 8, dp += 8)
+              {
+                __m128i s1 = _mm_load_si128((__m128i*)sp);
+                __m128i s2 = _mm_loadu_si128((__m128i*)(sp - 1));
+                __m128i d = _mm_load_si128((__m128i*)dp);
+                __m128i t = _mm_add_epi16(s1, s2);
+                __m128i v = _mm_sub_epi16(vb, t);
+                __m128i w = _mm_srai_epi16(v, e);
+                d = _mm_sub_epi16(d, w);
+                _mm_store_si128((__m128i*)dp, d);
+              }
+            else
+              for (; i > 0; i -= 8, sp += 8, dp += 8)
+              {
+                __m128i s1 = _mm_load_si128((__m128i*)sp);
+                __m128i s2 = _mm_loadu_si128((__m128i*)(sp + 1));
+                __m128i d = _mm_load_si128((__m128i*)dp);
+                __m128i t = _mm_add_epi16(s1, s2);
+                __m128i v = _mm_sub_epi16(vb, t);
+                __m128i w = _mm_srai_epi16(v, e);
+                d = _mm_sub_epi16(d, w);
+                _mm_store_si128((__m128i*)dp, d);
+              }
+          }
+          else {
+            // general case
+            // a * (x + y) may not fit in 16 bits, so this is done in 32 bits
+            if (ev)
+              for (ui32 i = aug_width; i > 0; --i, sp++, dp++)
+                *dp = (si16)(*dp - ((b + a * (sp[-1] + sp[0])) >> e));
+            else
+              for (ui32 i = aug_width; i > 0; --i, sp++, dp++)
+                *dp = (si16)(*dp - ((b + a * (sp[0] + sp[1])) >> e));
+          }
+
+          // swap buffers
+          si16* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+        }
+
+        // combine both lsrc and hsrc into dst
+        {
+          si16* dp = dst->i16;
+          si16* spl = even ? lsrc->i16 : hsrc->i16;
+          si16* sph = even ? hsrc->i16 : lsrc->i16;
+          int w = (int)width;
+          sse2_interleave16(dp, spl, sph, w);
+        }
+      }
+      else {
+        if (even)
+          dst->i16[0] = lsrc->i16[0];
+        else
+          dst->i16[0] = (si16)(hsrc->i16[0] >> 1);
+      }
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void sse2_rev_horz_syn32(const param_atk* atk, const line_buf* dst, 
                              const line_buf* lsrc, const line_buf* hsrc, 
@@ -985,7 +1436,13 @@ namespace ojph {
                            const line_buf* lsrc, const line_buf* hsrc, 
                            ui32 width, bool even)
     {
-      if (dst->flags & line_buf::LFT_32BIT) 
+      if (dst->flags & line_buf::LFT_16BIT) 
+      {
+        assert((lsrc == NULL || lsrc->flags & line_buf::LFT_16BIT) && 
+               (hsrc == NULL || hsrc->flags & line_buf::LFT_16BIT));
+        sse2_rev_horz_syn16(atk, dst, lsrc, hsrc, width, even);
+      }
+      else if (dst->flags & line_buf::LFT_32BIT) 
       {
         assert((lsrc == NULL || lsrc->flags & line_buf::LFT_32BIT) && 
                (hsrc == NULL || hsrc->flags & line_buf::LFT_32BIT));
@@ -12,6 +12,7 @@ include_directories(../src/core/common)
 set(SOURCES mse_pae.cpp "../src/apps/others/ojph_img_io.cpp" "../src/core/others/ojph_message.cpp" "../src/core/others/ojph_file.cpp" "../src/core/others/ojph_mem.cpp" "../src/core/others/ojph_arch.cpp")
 set(OJPH_IMG_IO_SSE41 "../src/apps/others/ojph_img_io_sse41.cpp")
 set(OJPH_IMG_IO_AVX2 "../src/apps/others/ojph_img_io_avx2.cpp")
+set(OJPH_IMG_IO_AVX512 "../src/apps/others/ojph_img_io_avx512.cpp")
 
 # if SIMD are not disabled
 if (NOT OJPH_DISABLE_SIMD)
@@ -25,13 +26,18 @@ if (NOT OJPH_DISABLE_SIMD)
     if (NOT OJPH_DISABLE_AVX2)
       list(APPEND SOURCES ${OJPH_IMG_IO_AVX2})
     endif()
+    if (NOT OJPH_DISABLE_AVX512)
+      list(APPEND SOURCES ${OJPH_IMG_IO_AVX512})
+    endif()
 
     # Set compilation flags
     if (MSVC)
       set_source_files_properties(../src/apps/others/ojph_img_io_avx2.cpp PROPERTIES COMPILE_FLAGS "/arch:AVX2")
+      set_source_files_properties(../src/apps/others/ojph_img_io_avx512.cpp PROPERTIES COMPILE_FLAGS "/arch:AVX512")
     else()
       set_source_files_properties(../src/apps/others/ojph_img_io_sse41.cpp PROPERTIES COMPILE_FLAGS -msse4.1)
       set_source_files_properties(../src/apps/others/ojph_img_io_avx2.cpp PROPERTIES COMPILE_FLAGS -mavx2)
+      set_source_files_properties(../src/apps/others/ojph_img_io_avx512.cpp PROPERTIES COMPILE_FLAGS -mavx512f)
     endif()
   endif()
 
@@ -0,0 +1,786 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: test_codestream.cpp
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ojph_arch.h"
+#include "ojph_file.h"
+#include "ojph_mem.h"
+#include "ojph_params.h"
+#include "ojph_codestream.h"
+#include "ojph_executor.h"
+#include "ojph_threads.h"
+#include "ojph_trace.h"
+#include "gtest/gtest.h"
+
+using namespace ojph;
+
+////////////////////////////////////////////////////////////////////////////////
+//                                test_image
+////////////////////////////////////////////////////////////////////////////////
+// Describes the synthetic 8-bit unsigned image used by the tests; images
+// of three or more components employ the colour transform
+struct test_image
+{
+  ui32 width, height, num_comps;
+  bool reversible;
+  ui32 num_decomps;
+  size tile_size;   // no tiling if zero
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                         test_sample
+////////////////////////////////////////////////////////////////////////////////
+// Sample x of row y of component c; a ramp with some texture, so that all
+// subbands have data
+static inline
+si32 test_sample(ui32 c, ui32 x, ui32 y)
+{
+  return (si32)((x * 3 + y * 5 + c * 40 + ((x * y) & 7)) & 0xFF);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                         set_params
+////////////////////////////////////////////////////////////////////////////////
+static
+void set_params(codestream& cs, const test_image& im)
+{
+  param_siz siz = cs.access_siz();
+  siz.set_image_extent(point(im.width, im.height));
+  siz.set_num_components(im.num_comps);
+  for (ui32 c = 0; c < im.num_comps; ++c)
+    siz.set_component(c, point(1, 1), 8, false);
+  if (im.tile_size.w != 0)
+    siz.set_tile_size(im.tile_size);
+  param_cod cod = cs.access_cod();
+  cod.set_reversible(im.reversible);
+  cod.set_color_transform(im.num_comps >= 3);
+  cod.set_num_decomposition(im.num_decomps);
+  if (!im.reversible)
+    cs.access_qcd().set_irrev_quant(0.001f);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                         encode_image
+////////////////////////////////////////////////////////////////////////////////
+// Encodes the test image with cs, which may have been configured further
+// by the caller, and stores the codestream in data
+static
+void encode_image(codestream& cs, const test_image& im,
+                  std::vector<ui8>& data)
+{
+  set_params(cs, im);
+  cs.set_planar(false);
+  mem_outfile out;
+  out.open();
+  cs.write_headers(&out);
+  ui32 next_comp;
+  line_buf* line = cs.exchange(NULL, next_comp);
+  for (ui32 y = 0; y < im.height; ++y)
+    for (ui32 c = 0; c < im.num_comps; ++c)
+    {
+      EXPECT_EQ(next_comp, c);
+      for (ui32 x = 0; x < im.width; ++x)
+        line->i32[x] = test_sample(c, x, y);
+      line = cs.exchange(line, next_comp);
+    }
+  cs.flush();
+  data.assign(out.get_data(), out.get_data() + out.tell());
+  cs.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                         decode_image
+////////////////////////////////////////////////////////////////////////////////
+// Decodes data with cs, which may have been configured further by the
+// caller, skipping skipped_res resolutions; samples receives component c
+// of the result at c * width * height, where width and height are those
+// of the reduced image
+static
+void decode_image(codestream& cs, const std::vector<ui8>& data,
+                  std::vector<si32>& samples, ui32 skipped_res = 0)
+{
+  mem_infile in;
+  in.open(data.data(), data.size());
+  cs.read_headers(&in);
+  cs.restrict_input_resolution(skipped_res, skipped_res);
+  cs.create();
+  param_siz siz = cs.access_siz();
+  ui32 num_comps = siz.get_num_components();
+  ui32 width = siz.get_recon_width(0), height = siz.get_recon_height(0);
+  samples.resize((size_t)num_comps * width * height);
+  std::vector<ui32> rows(num_comps, 0);
+  for (ui32 i = 0; i < num_comps * height; ++i)
+  {
+    ui32 c;
+    line_buf* line = cs.pull(c);
+    ASSERT_LT(rows[c], height);
+    si32* dp = samples.data() + ((size_t)c * height + rows[c]++) * width;
+    for (ui32 x = 0; x < width; ++x)
+      dp[x] = line->i32[x];
+  }
+  cs.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                     tests of the fused colour transform
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Tiles convert and colour transform the codestream's own lines in one
+// pass, but convert lines that belong to the caller one at a time; both
+// produce the same codestream, also when a row mixes the two, and for
+// tiles whose widths are not a multiple of the vector width.
+TEST(TestCodestream, FusedColour) {
+  for (int rev = 0; rev < 2; ++rev)
+  {
+    const test_image im = { 150, 70, 3, rev != 0, 3, size(61, 32) };
+    std::vector<ui8> ref;
+    codestream ref_enc;
+    encode_image(ref_enc, im, ref);
+
+    // some room past the end, as for the codestream's own lines
+    std::vector<si32> buf(im.width + 64);
+    line_buf own;
+    own.wrap(buf.data(), im.width, 0);
+    codestream cs;
+    set_params(cs, im);
+    cs.set_planar(false);
+    mem_outfile out;
+    out.open();
+    cs.write_headers(&out);
+    ui32 next_comp;
+    line_buf* line = cs.exchange(NULL, next_comp);
+    for (ui32 y = 0; y < im.height; ++y)
+      for (ui32 c = 0; c < im.num_comps; ++c)
+      {
+        // all components, component 1 only, or none are caller memory
+        bool caller = (y % 3 == 0) || (y % 3 == 1 && c == 1);
+        line_buf* lp = caller ? &own : line;
+        for (ui32 x = 0; x < im.width; ++x)
+          lp->i32[x] = test_sample(c, x, y);
+        line = cs.exchange(lp, next_comp);
+      }
+    cs.flush();
+    std::vector<ui8> data(out.get_data(), out.get_data() + out.tell());
+    cs.close();
+    EXPECT_EQ(data, ref) << (rev ? "reversible" : "irreversible");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                            tests of get_stats
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// The statistics count the stages an encode and a decode go through, when
+// the library collects them, and are all zero otherwise; reset_stats()
+// clears them.
+TEST(TestCodestream, Stats) {
+  const test_image im = { 64, 48, 3, true, 3, size() };
+  std::vector<ui8> data;
+  codestream enc;
+  encode_image(enc, im, data);
+  const codestream_stats& es = enc.get_stats();
+  if (es.enabled) {
+    EXPECT_GT(es.num_calls[codestream_stats::COLOUR], 0u);
+    EXPECT_GT(es.num_calls[codestream_stats::CB_ENCODE], 0u);
+    EXPECT_GT(es.num_calls[codestream_stats::DWT + 1], 0u);
+    EXPECT_EQ(es.num_calls[codestream_stats::CB_DECODE], 0u);
+  }
+  else
+    for (ui32 s = 0; s < codestream_stats::NUM_STAGES; ++s)
+      EXPECT_EQ(es.num_calls[s] + es.time_ns[s], 0u);
+  enc.reset_stats();
+  for (ui32 s = 0; s < codestream_stats::NUM_STAGES; ++s)
+    EXPECT_EQ(es.num_calls[s] + es.time_ns[s], 0u);
+
+  std::vector<si32> samples;
+  codestream dec;
+  decode_image(dec, data, samples);
+  const codestream_stats& ds = dec.get_stats();
+  EXPECT_EQ(ds.enabled, es.enabled);
+  if (ds.enabled) {
+    EXPECT_GT(ds.num_calls[codestream_stats::CB_DECODE], 0u);
+    EXPECT_GT(ds.num_calls[codestream_stats::PRECINCT_PARSE], 0u);
+    EXPECT_EQ(ds.num_calls[codestream_stats::CB_ENCODE], 0u);
+  }
+  EXPECT_STREQ(codestream_stats::get_stage_name(codestream_stats::COLOUR),
+               "colour");
+  EXPECT_STREQ(codestream_stats::get_stage_name(codestream_stats::DWT + 2),
+               "dwt");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                            tests of trace_sink
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// A trace holds the events of every thread that records into it, on a
+// track of its own, with their non-negative ids; a codestream given the
+// sink adds its stages when the library collects statistics.  Events
+// after close() are dropped, and the file is a complete JSON document.
+TEST(TestCodestream, TraceSink) {
+  const char* filename = "test_trace.json";
+  trace_sink sink;
+  EXPECT_FALSE(sink.is_open());
+  ASSERT_TRUE(sink.open(filename));
+  EXPECT_TRUE(sink.is_open());
+  sink.set_thread_name("main");
+  ui64 begin = trace_sink::now_ns();
+  sink.add_event("first", begin, trace_sink::now_ns(), 2, 1, -1, 5);
+  std::thread other([&sink]() {
+    sink.set_thread_name("other");
+    ui64 t = trace_sink::now_ns();
+    sink.add_event("second", t, trace_sink::now_ns());
+  });
+  other.join();
+
+  const test_image im = { 64, 48, 3, true, 3, size() };
+  std::vector<ui8> data;
+  codestream enc;
+  enc.set_trace_sink(&sink);
+  encode_image(enc, im, data);
+  bool enabled = enc.get_stats().enabled;
+  sink.close();
+  EXPECT_FALSE(sink.is_open());
+  sink.add_event("late", begin, trace_sink::now_ns());
+
+  std::string trace;
+  FILE* f = fopen(filename, "rb");
+  ASSERT_TRUE(f != NULL);
+  char buf[256];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+    trace.append(buf, n);
+  fclose(f);
+  remove(filename);
+
+  EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0u);
+  EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+  EXPECT_NE(trace.find("\"tid\":0,\"args\":{\"name\":\"main\"}"),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"tid\":1,\"args\":{\"name\":\"other\"}"),
+            std::string::npos);
+  size_t first = trace.find("{\"name\":\"first\"");
+  ASSERT_NE(first, std::string::npos);
+  EXPECT_NE(trace.find("\"tid\":0,", first), std::string::npos);
+  EXPECT_NE(trace.find("\"args\":{\"tile\":2,\"comp\":1,\"row\":5}}", first),
+            std::string::npos);
+  size_t second = trace.find("{\"name\":\"second\"");
+  ASSERT_NE(second, std::string::npos);
+  EXPECT_NE(trace.find("\"tid\":1,", second), std::string::npos);
+  EXPECT_NE(trace.find("\"args\":{}}", second), std::string::npos);
+  EXPECT_EQ(trace.find("\"late\""), std::string::npos);
+  EXPECT_EQ(trace.find("\"cb row encode\"") != std::string::npos, enabled);
+  EXPECT_EQ(trace.find("\"dwt\"") != std::string::npos, enabled);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                  tests of estimate_memory and get_memory_report
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// The estimate of the fixed arena is exact, for encoding and decoding, and
+// that of the elastic arena covers what is used for the given codestream
+// size; the report adds up.
+TEST(TestCodestream, MemoryEstimate) {
+  const test_image im = { 300, 200, 3, false, 5, size(128, 128) };
+  std::vector<ui8> data;
+  codestream first;
+  encode_image(first, im, data);
+
+  codestream est_enc;
+  set_params(est_enc, im);
+  codestream_memory ee = est_enc.estimate_memory(data.size());
+  codestream enc;
+  EXPECT_EQ(enc.get_memory_report().fixed_bytes, 0u);
+  encode_image(enc, im, data);
+  codestream_memory er = enc.get_memory_report();
+  EXPECT_EQ(er.fixed_bytes, ee.fixed_bytes);
+  EXPECT_GT(er.coded_bytes, 0u);
+  EXPECT_LE(er.coded_bytes, er.elastic_bytes);
+  EXPECT_LE(er.elastic_bytes, ee.elastic_bytes);
+  EXPECT_EQ(er.peak_bytes, er.fixed_bytes + er.elastic_bytes);
+
+  mem_infile in;
+  in.open(data.data(), data.size());
+  codestream est_dec;
+  est_dec.read_headers(&in);
+  codestream_memory de = est_dec.estimate_memory(data.size());
+  std::vector<si32> samples;
+  codestream dec;
+  decode_image(dec, data, samples);
+  codestream_memory dr = dec.get_memory_report();
+  EXPECT_EQ(dr.fixed_bytes, de.fixed_bytes);
+  EXPECT_LE(dr.elastic_bytes, de.elastic_bytes);
+  EXPECT_EQ(dr.peak_bytes, dr.fixed_bytes + dr.elastic_bytes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                   tests of push_region and pull_region
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Pushing the test image as interleaved bytes, in two calls, or as planar
+// floats, produces the same codestream as exchange(); pulling it back as
+// bottom-up planar 16-bit samples, in two calls, or as interleaved floats,
+// reproduces the image.
+TEST(TestCodestream, RegionRoundTrip) {
+  const test_image im = { 70, 45, 3, true, 3, size(32, 32) };
+  const ui32 w = im.width, h = im.height, nc = im.num_comps, split = 20;
+  std::vector<ui8> ref;
+  codestream ref_enc;
+  encode_image(ref_enc, im, ref);
+
+  std::vector<ui8> bytes((size_t)w * h * nc);
+  std::vector<float> floats((size_t)w * h * nc);
+  for (ui32 c = 0; c < nc; ++c)
+    for (ui32 y = 0; y < h; ++y)
+      for (ui32 x = 0; x < w; ++x) {
+        si32 v = test_sample(c, x, y);
+        bytes[((size_t)y * w + x) * nc + c] = (ui8)v;
+        floats[((size_t)c * h + y) * w + x] = (float)v / 255.0f;
+      }
+
+  for (int planar_floats = 0; planar_floats < 2; ++planar_floats)
+  {
+    codestream cs;
+    set_params(cs, im);
+    cs.set_planar(false);
+    mem_outfile out;
+    out.open();
+    cs.write_headers(&out);
+    if (planar_floats) {
+      image_region r = { floats.data(), image_region::F32, h,
+        (si64)w * 4, 4, (si64)w * h * 4 };
+      cs.push_region(r);
+    }
+    else {
+      image_region r = { bytes.data(), image_region::U8, split,
+        (si64)w * nc, nc, 1 };
+      cs.push_region(r);
+      r.data = bytes.data() + (size_t)split * w * nc;
+      r.num_rows = h - split;
+      cs.push_region(r);
+    }
+    cs.flush();
+    std::vector<ui8> data(out.get_data(), out.get_data() + out.tell());
+    cs.close();
+    EXPECT_EQ(data, ref);
+  }
+
+  {
+    std::vector<ui16> planes((size_t)w * h * nc);
+    mem_infile in;
+    in.open(ref.data(), ref.size());
+    codestream cs;
+    cs.read_headers(&in);
+    cs.create();
+    image_region r = { planes.data() + (size_t)(h - 1) * w,
+      image_region::U16, split, -(si64)w * 2, 2, (si64)w * h * 2 };
+    cs.pull_region(r);
+    r.data = planes.data() + (size_t)(h - 1 - split) * w;
+    r.num_rows = h - split;
+    cs.pull_region(r);
+    cs.close();
+    for (ui32 c = 0; c < nc; ++c)
+      for (ui32 y = 0; y < h; ++y)
+        for (ui32 x = 0; x < w; ++x)
+          ASSERT_EQ(planes[((size_t)c * h + h - 1 - y) * w + x],
+                    test_sample(c, x, y)) << c << " " << x << " " << y;
+  }
+
+  {
+    std::vector<float> samples((size_t)w * h * nc);
+    mem_infile in;
+    in.open(ref.data(), ref.size());
+    codestream cs;
+    cs.read_headers(&in);
+    cs.create();
+    image_region r = { samples.data(), image_region::F32, h,
+      (si64)w * nc * 4, nc * 4, 4 };
+    cs.pull_region(r);
+    cs.close();
+    for (ui32 c = 0; c < nc; ++c)
+      for (ui32 y = 0; y < h; ++y)
+        for (ui32 x = 0; x < w; ++x)
+          ASSERT_NEAR(samples[((size_t)y * w + x) * nc + c],
+            (float)test_sample(c, x, y) / 255.0f, 1e-6)
+            << c << " " << x << " " << y;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                        tests of set_decode_target
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Decoding into a planar 32-bit target, where samples are written directly,
+// and into an interleaved 8-bit target, where they are converted, gives the
+// same samples as pull(); the padding after each row and the rows past the
+// end of the target are not touched.
+TEST(TestCodestream, DecodeTarget) {
+  const si32 guard = -12345;
+  for (int rev = 0; rev < 2; ++rev)
+  {
+    const test_image im = { 77, 40, 3, rev != 0, 4, size(45, 24) };
+    const ui32 w = im.width, h = im.height, nc = im.num_comps;
+    const ui32 stride = w + 9, rows = h - 3; // padded rows; fewer rows
+    std::vector<ui8> data;
+    codestream enc;
+    encode_image(enc, im, data);
+    std::vector<si32> ref;
+    codestream ref_dec;
+    decode_image(ref_dec, data, ref);
+
+    std::vector<si32> planes((size_t)stride * h * nc, guard);
+    std::vector<ui8> bytes((size_t)w * h * nc, 0xA5);
+    for (int direct = 0; direct < 2; ++direct)
+    {
+      mem_infile in;
+      in.open(data.data(), data.size());
+      codestream cs;
+      cs.read_headers(&in);
+      cs.create();
+      image_region target;
+      if (direct)
+        target = { planes.data(), image_region::S32, rows,
+          (si64)stride * 4, 4, (si64)stride * h * 4 };
+      else
+        target = { bytes.data(), image_region::U8, rows,
+          (si64)w * nc, nc, 1 };
+      cs.set_decode_target(&target);
+      for (ui32 y = 0; y < h; ++y)
+        for (ui32 c = 0; c < nc; ++c)
+        {
+          ui32 comp_num;
+          line_buf* line = cs.pull(comp_num);
+          ASSERT_EQ(comp_num, c);
+          const si32* rp = ref.data() + ((size_t)c * h + y) * w;
+          for (ui32 x = 0; x < w; ++x)
+            ASSERT_EQ(line->i32[x], rp[x]);
+          if (direct && y < rows) {
+            EXPECT_EQ(line->i32, planes.data() + (c * h + y) * stride);
+          }
+        }
+      cs.close();
+    }
+
+    for (ui32 c = 0; c < nc; ++c)
+      for (ui32 y = 0; y < h; ++y)
+        for (ui32 x = 0; x < stride; ++x)
+        {
+          si32 v = planes[((size_t)c * h + y) * stride + x];
+          if (y < rows && x < w) {
+            ASSERT_EQ(v, ref[((size_t)c * h + y) * w + x]);
+          }
+          else {
+            ASSERT_EQ(v, guard) << c << " " << x << " " << y;
+          }
+          if (x < w) {
+            ui8 b = bytes[((size_t)y * w + x) * nc + c];
+            si32 e = ojph_max(0, ojph_min(255, ref[((size_t)c*h + y)*w + x]));
+            ASSERT_EQ(b, y < rows ? e : 0xA5);
+          }
+        }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                        tests of set_pyramid_output
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//                               pyramid_store
+////////////////////////////////////////////////////////////////////////////////
+// Keeps the pyramid levels it receives; levels[l - 1] holds level l, with
+// component c at c * width * height, as decode_image() stores them
+struct pyramid_store : public pyramid_sink
+{
+  void push_line(ui32 level, ui32 comp_num, ui32 row,
+                 const line_buf* line) override
+  {
+    ASSERT_GE(level, 1u);
+    ASSERT_LE(level, sizes.size());
+    const size& sz = sizes[level - 1];
+    ASSERT_LT(row, sz.h);
+    EXPECT_EQ(row, next_row[level - 1][comp_num]++);
+    si32* dp = levels[level - 1].data()
+      + ((size_t)comp_num * sz.h + row) * sz.w;
+    for (ui32 x = 0; x < sz.w; ++x)
+      dp[x] = line->i32[x];
+  }
+
+  std::vector<size> sizes;
+  std::vector<std::vector<si32>> levels;
+  std::vector<std::vector<ui32>> next_row;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Each pyramid level is the image that a decode at that lower resolution
+// produces, exactly for reversible codestreams, and within one for
+// irreversible ones, while pull() still returns the full image.
+TEST(TestCodestream, Pyramid) {
+  const test_image images[] = {
+    { 203, 129, 3, true, 5, size(64, 48) },
+    { 203, 129, 3, false, 5, size(64, 48) },
+    { 97, 61, 1, true, 3, size() },
+    { 97, 61, 1, false, 4, size(40, 40) },
+  };
+  for (const test_image& im : images)
+  {
+    const ui32 num_levels = im.num_decomps - 1;
+    std::vector<ui8> data;
+    codestream enc;
+    encode_image(enc, im, data);
+
+    pyramid_store store;
+    std::vector<si32> full;
+    codestream cs;
+    mem_infile in;
+    in.open(data.data(), data.size());
+    cs.read_headers(&in);
+    cs.set_pyramid_output(num_levels, &store);
+    for (ui32 l = 1; l <= num_levels; ++l) {
+      size sz = cs.get_pyramid_size(l, 0);
+      for (ui32 c = 1; c < im.num_comps; ++c) {
+        EXPECT_EQ(cs.get_pyramid_size(l, c).w, sz.w);
+        EXPECT_EQ(cs.get_pyramid_size(l, c).h, sz.h);
+      }
+      store.sizes.push_back(sz);
+      store.levels.push_back(
+        std::vector<si32>((size_t)sz.w * sz.h * im.num_comps));
+      store.next_row.push_back(std::vector<ui32>(im.num_comps, 0));
+    }
+    cs.create();
+    full.resize((size_t)im.width * im.height * im.num_comps);
+    std::vector<ui32> rows(im.num_comps, 0);
+    for (ui32 i = 0; i < im.height * im.num_comps; ++i) {
+      ui32 c;
+      line_buf* line = cs.pull(c);
+      si32* dp = full.data() + ((size_t)c * im.height + rows[c]++) * im.width;
+      for (ui32 x = 0; x < im.width; ++x)
+        dp[x] = line->i32[x];
+    }
+    cs.close();
+
+    std::vector<si32> ref;
+    codestream plain;
+    decode_image(plain, data, ref);
+    EXPECT_EQ(full, ref);
+    for (ui32 l = 1; l <= num_levels; ++l)
+    {
+      const size& sz = store.sizes[l - 1];
+      for (ui32 c = 0; c < im.num_comps; ++c)
+        EXPECT_EQ(store.next_row[l - 1][c], sz.h);
+      std::vector<si32> reduced;
+      codestream dec;
+      decode_image(dec, data, reduced, l);
+      param_siz siz = dec.access_siz();
+      ASSERT_EQ(siz.get_recon_width(0), sz.w);
+      ASSERT_EQ(siz.get_recon_height(0), sz.h);
+      const std::vector<si32>& pyr = store.levels[l - 1];
+      ASSERT_EQ(pyr.size(), reduced.size());
+      si32 tol = im.reversible ? 0 : 1;
+      for (size_t i = 0; i < pyr.size(); ++i)
+        ASSERT_LE(std::abs(pyr[i] - reduced[i]), tol)
+          << "level " << l << " sample " << i;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                              tests of restart
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// A restarted codestream encodes and decodes images of other sizes and
+// parameters exactly as a new one does, and keeps the memory of the
+// largest image for the others.
+TEST(TestCodestream, Restart) {
+  const test_image images[] = {
+    { 150, 100, 3, true, 5, size() },
+    { 64, 33, 1, false, 3, size(32, 32) },
+    { 150, 100, 3, true, 5, size() },
+  };
+  codestream enc, dec;
+  size_t fixed_bytes = 0;
+  for (const test_image& im : images)
+  {
+    std::vector<ui8> ref, data;
+    codestream fresh_enc;
+    encode_image(fresh_enc, im, ref);
+    enc.restart();
+    encode_image(enc, im, data);
+    EXPECT_EQ(data, ref);
+    // the arena of the first image, the largest, is kept
+    codestream_memory report = enc.get_memory_report();
+    EXPECT_GE(report.fixed_bytes, fresh_enc.get_memory_report().fixed_bytes);
+    if (fixed_bytes == 0)
+      fixed_bytes = report.fixed_bytes;
+    EXPECT_EQ(report.fixed_bytes, fixed_bytes);
+
+    std::vector<si32> expected, samples;
+    codestream fresh_dec;
+    decode_image(fresh_dec, ref, expected);
+    dec.restart();
+    decode_image(dec, data, samples);
+    EXPECT_EQ(samples, expected);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                         tests of thds::thread_pool
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// A task that adds its value to a total, after forking children that do
+// the same with half of it, and waiting for them
+struct fork_task : public thds::worker_thread_base
+{
+  void execute() override
+  {
+    if (value > 1)
+    {
+      thds::task_group group(pool);
+      fork_task children[2];
+      for (int i = 0; i < 2; ++i) {
+        children[i].pool = pool;
+        children[i].value = value / 2;
+        children[i].total = total;
+        group.add_task(children + i, i ? thds::PRIORITY_HIGH
+                                       : thds::PRIORITY_LOW);
+      }
+      group.wait();
+    }
+    total->fetch_add(value);
+  }
+  thds::thread_pool* pool;
+  ui32 value;
+  std::atomic<ui32>* total;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Nested task groups complete, whether the pool has threads or the tasks
+// execute only in wait(), and futures receive the results of submitted
+// callables.
+TEST(TestThreads, ForkJoin) {
+  for (size_t num_threads = 0; num_threads < 4; num_threads += 3)
+  {
+    thds::thread_pool pool;
+    pool.init(num_threads);
+    EXPECT_EQ(pool.get_num_threads(), num_threads);
+    for (int round = 0; round < 20; ++round)
+    {
+      std::atomic<ui32> total(0);
+      thds::task_group group(&pool);
+      fork_task tasks[4];
+      for (ui32 i = 0; i < 4; ++i) {
+        tasks[i].pool = &pool;
+        tasks[i].value = 64;
+        tasks[i].total = &total;
+        group.add_task(tasks + i);
+      }
+      group.wait();
+      // each task of value v adds v at each of its 7 levels
+      EXPECT_EQ(total.load(), 4u * 64u * 7u);
+    }
+
+    std::future<ui32> f = pool.submit([]() { return 42u; });
+    if (num_threads == 0) {
+      EXPECT_TRUE(pool.run_one());
+    }
+    EXPECT_EQ(f.get(), 42u);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                            tests of set_executor
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Codeblocks encoded and decoded on the threads of an executor give the
+// same codestream and samples as in the calling thread, whether the
+// executor owns its pool or shares the application's.
+TEST(TestCodestream, Executor) {
+  const test_image images[] = {
+    { 300, 90, 3, true, 5, size(128, 64) },
+    { 300, 90, 3, false, 5, size() },
+  };
+  thds::thread_pool pool;
+  pool.init(3);
+  thread_pool_executor shared(&pool);
+  thread_pool_executor owned(4);
+  executor* executors[] = { &shared, &owned };
+  for (const test_image& im : images)
+  {
+    std::vector<ui8> ref;
+    codestream ref_enc;
+    encode_image(ref_enc, im, ref);
+    std::vector<si32> expected;
+    codestream ref_dec;
+    decode_image(ref_dec, ref, expected);
+
+    for (executor* exec : executors)
+    {
+      EXPECT_GT(exec->get_concurrency(), 1u);
+      std::vector<ui8> data;
+      codestream enc;
+      enc.set_executor(exec);
+      encode_image(enc, im, data);
+      EXPECT_EQ(data, ref);
+
+      std::vector<si32> samples;
+      codestream dec;
+      dec.set_executor(exec);
+      decode_image(dec, ref, samples);
+      EXPECT_EQ(samples, expected);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   main
+////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -36,7 +36,11 @@
 //***************************************************************************/
 
 #include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <string>
+#include <vector>
 #include "ojph_arch.h"
 #include "gtest/gtest.h"
 
@@ -101,6 +105,8 @@ int execute(const std::string& cmd, std::string& result)
 #define COMPARE_FILES_PATH  ".\\compare_files"
 #define EXPAND_EXECUTABLE ".\\ojph_expand.exe"
 #define COMPRESS_EXECUTABLE ".\\ojph_compress.exe"
+#define KERNEL_BENCH_EXECUTABLE ".\\ojph_kernel_bench.exe"
+#define BENCH_EXECUTABLE ".\\ojph_bench.exe"
 #else
 #define SRC_FILE_DIR "./jp2k_test_codestreams/openjph/"
 #define OUT_FILE_DIR "./"
@@ -122,6 +128,8 @@ int execute(const std::string& cmd, std::string& result)
 
 #define EXPAND_EXECUTABLE "./ojph_expand"
 #define COMPRESS_EXECUTABLE "./ojph_compress"
+#define KERNEL_BENCH_EXECUTABLE "./ojph_kernel_bench"
+#define BENCH_EXECUTABLE "./ojph_bench"
 //#define EXPAND_EXECUTABLE "20.18.0_64bit/bin/node ./ojph_expand.js"
 //#define COMPRESS_EXECUTABLE "20.18.0_64bit/bin/node ./ojph_compress.js"
 //#define EXPAND_EXECUTABLE "node-v18.7.0-linux-x64/bin/node ./ojph_expand_simd.js"
@@ -139,12 +147,13 @@ void run_ojph_compress(const std::string& ref_filename,
   const std::string& base_filename,
   const std::string& extended_base_fname,
   const std::string& out_ext,
-  const std::string& extra_options)
+  const std::string& extra_options,
+  const std::string& ref_dir = REF_FILE_DIR)
 {
   try {
     std::string result, command;
     command = std::string(COMPRESS_EXECUTABLE)
-      + " -i " + REF_FILE_DIR + ref_filename
+      + " -i " + ref_dir + ref_filename
       + " -o " + OUT_FILE_DIR + base_filename + extended_base_fname +
       "." + out_ext + " " + extra_options;
     EXPECT_EQ(execute(command, result), 0);
@@ -178,13 +187,16 @@ void run_ojph_expand(const std::string& base_filename,
 ////////////////////////////////////////////////////////////////////////////////
 void run_ojph_compress_expand(const std::string& base_filename,
   const std::string& out_ext,
-  const std::string& decode_ext)
+  const std::string& decode_ext,
+  const std::string& extended_base_fname = "",
+  const std::string& extra_options = "")
 {
   try {
     std::string result, command;
     command = std::string(EXPAND_EXECUTABLE)
       + " -i " + OUT_FILE_DIR + base_filename + "." + out_ext
-      + " -o " + OUT_FILE_DIR + base_filename + "." + decode_ext;
+      + " -o " + OUT_FILE_DIR + base_filename + extended_base_fname
+      + "." + decode_ext + " " + extra_options;
     EXPECT_EQ(execute(command, result), 0);
   }
   catch (const std::runtime_error& error) {
@@ -242,13 +254,14 @@ void run_mse_pae(const std::string& base_filename,
 ////////////////////////////////////////////////////////////////////////////////
 void compare_files(const std::string& base_filename,
   const std::string& extended_base_fname,
-  const std::string& ext)
+  const std::string& ext,
+  const std::string& src_dir = SRC_FILE_DIR)
 {
   try {
     std::string result, command;
     command = std::string(COMPARE_FILES_PATH)
       + " " + OUT_FILE_DIR + base_filename + extended_base_fname + "." + ext
-      + " " + SRC_FILE_DIR + base_filename + "." + ext;
+      + " " + src_dir + base_filename + "." + ext;
     EXPECT_EQ(execute(command, result), 0);
   }
   catch (const std::runtime_error& error) {
@@ -256,6 +269,184 @@ void compare_files(const std::string& base_filename,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                        test_sample
+////////////////////////////////////////////////////////////////////////////////
+// A sample of component c at (x, y) in the images the tests make; seed
+// makes the frames of a sequence differ.
+static
+int test_sample(int c, int x, int y, int bit_depth, int seed)
+{
+  return (x * 13 + y * 29 + c * 300 + seed * 17 + ((x * y) & 15))
+    & ((1 << bit_depth) - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                        write_out_file
+////////////////////////////////////////////////////////////////////////////////
+static
+bool write_out_file(const std::string& filename,
+  const std::vector<unsigned char>& data)
+{
+  std::string path = std::string(OUT_FILE_DIR) + filename;
+  FILE* f = fopen(path.c_str(), "wb");
+  if (f == NULL)
+    return false;
+  size_t written = fwrite(data.data(), 1, data.size(), f);
+  fclose(f);
+  return written == data.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                        write_ppm_file
+////////////////////////////////////////////////////////////////////////////////
+// Writes a width x height P6 image of the given bit depth to OUT_FILE_DIR,
+// or a P5 one when num_comps is 1; samples are big-endian 16-bit words
+// when bit_depth exceeds 8.
+static
+bool write_ppm_file(const std::string& filename, int width, int height,
+  int bit_depth, int seed, int num_comps = 3)
+{
+  char header[64];
+  snprintf(header, sizeof(header), "P%d\n%d %d\n%d\n",
+    num_comps == 1 ? 5 : 6, width, height, (1 << bit_depth) - 1);
+  std::vector<unsigned char> data(header, header + strlen(header));
+  for (int y = 0; y < height; ++y)
+    for (int x = 0; x < width; ++x)
+      for (int c = 0; c < num_comps; ++c) {
+        int v = test_sample(c, x, y, bit_depth, seed);
+        if (bit_depth > 8)
+          data.push_back((unsigned char)(v >> 8));
+        data.push_back((unsigned char)v);
+      }
+  return write_out_file(filename, data);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                        write_yuv_file
+////////////////////////////////////////////////////////////////////////////////
+// Writes a planar three-component image to OUT_FILE_DIR, with components 1
+// and 2 subsampled by dx and dy; samples are little-endian 16-bit words
+// when bit_depth exceeds 8, as ojph_expand writes them.
+static
+bool write_yuv_file(const std::string& filename, int width, int height,
+  int bit_depth, int dx, int dy)
+{
+  std::vector<unsigned char> data;
+  for (int c = 0; c < 3; ++c) {
+    int w = c == 0 ? width : (width + dx - 1) / dx;
+    int h = c == 0 ? height : (height + dy - 1) / dy;
+    for (int y = 0; y < h; ++y)
+      for (int x = 0; x < w; ++x) {
+        int v = test_sample(c, x, y, bit_depth, 0);
+        data.push_back((unsigned char)v);
+        if (bit_depth > 8)
+          data.push_back((unsigned char)(v >> 8));
+      }
+  }
+  return write_out_file(filename, data);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                        write_raw_file
+////////////////////////////////////////////////////////////////////////////////
+// Writes a single-component image to OUT_FILE_DIR; samples are
+// little-endian 16-bit words when bit_depth exceeds 8, and are centred
+// around zero and sign-extended when is_signed is true.
+static
+bool write_raw_file(const std::string& filename, int width, int height,
+  int bit_depth, bool is_signed)
+{
+  std::vector<unsigned char> data;
+  for (int y = 0; y < height; ++y)
+    for (int x = 0; x < width; ++x) {
+      int v = test_sample(0, x, y, bit_depth, 0);
+      if (is_signed)
+        v -= 1 << (bit_depth - 1);
+      data.push_back((unsigned char)v);
+      if (bit_depth > 8)
+        data.push_back((unsigned char)(v >> 8));
+    }
+  return write_out_file(filename, data);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                      set_cpu_ext_level
+////////////////////////////////////////////////////////////////////////////////
+// Limits the instruction set extensions used by the executables run after
+// this call; an empty level lifts the limit.
+static
+void set_cpu_ext_level(const std::string& level)
+{
+#ifdef OJPH_COMPILER_MSVC
+  _putenv_s("OJPH_MAX_CPU_EXT_LEVEL", level.c_str());
+#else
+  if (level.empty())
+    unsetenv("OJPH_MAX_CPU_EXT_LEVEL");
+  else
+    setenv("OJPH_MAX_CPU_EXT_LEVEL", level.c_str(), 1);
+#endif
+}
+
+// The levels compare_cpu_ext_levels() runs the executables at; the first
+// is the generic path, and the empty last one is whatever the machine has.
+#if defined(OJPH_ARCH_I386) || defined(OJPH_ARCH_X86_64)
+static const char* const cpu_ext_levels[] =
+  { "generic", "sse2", "avx", "avx2", "" };
+#else
+static const char* const cpu_ext_levels[] = { "generic", "" };
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                    compare_cpu_ext_levels
+////////////////////////////////////////////////////////////////////////////////
+// Compresses base.ppm in OUT_FILE_DIR with options at every level of
+// cpu_ext_levels, and expands the generic codestream, base.j2c, at every
+// level to base_d.ppm, base_d_sse2.ppm, and so on; the codestreams and
+// the images of every level must match the generic ones.  The AVX-512
+// kernels of the floating-point irreversible wavelet fuse multiplies and
+// adds, so they are not bit-exact; when exact_max is false, the outputs of
+// the last, unlimited, level are produced but not compared.  img_ext
+// replaces ppm for the other image formats.
+static
+void compare_cpu_ext_levels(const std::string& base,
+  const std::string& options, bool exact_max = true,
+  const std::string& img_ext = "ppm")
+{
+  size_t num_levels = sizeof(cpu_ext_levels) / sizeof(cpu_ext_levels[0]);
+  for (size_t i = 0; i < num_levels; ++i) {
+    std::string level = cpu_ext_levels[i];
+    std::string ext = i == 0 ? "" : "_" + (level.empty() ? "max" : level);
+    set_cpu_ext_level(level);
+    run_ojph_compress(base + "." + img_ext, base, ext, "j2c", options,
+      OUT_FILE_DIR);
+    run_ojph_compress_expand(base, "j2c", img_ext, "_d" + ext);
+    if (i > 0 && (exact_max || i + 1 < num_levels)) {
+      compare_files(base, ext, "j2c", OUT_FILE_DIR);
+      compare_files(base + "_d", ext, img_ext, OUT_FILE_DIR);
+    }
+  }
+  set_cpu_ext_level("");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                      run_kernel_bench
+////////////////////////////////////////////////////////////////////////////////
+// Runs ojph_kernel_bench -check_only, which compares the output of every
+// SIMD kernel with that of the generic one, returning its exit code, or
+// -1 when the tests are built without ojph_kernel_bench.
+static
+int run_kernel_bench(const std::string& options)
+{
+  FILE* f = fopen(KERNEL_BENCH_EXECUTABLE, "rb");
+  if (f == NULL)
+    return -1;
+  fclose(f);
+  std::string result;
+  return execute(std::string(KERNEL_BENCH_EXECUTABLE)
+    + " -check_only true " + options, result);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                  tests
 ////////////////////////////////////////////////////////////////////////////////
@@ -1460,6 +1651,290 @@ TEST(TestExecutables, DpxEnc1280x72016bitResolve18) {
               "dpx_1280x720_16bit.ppm", "", 3, mse, pae);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//                       round trips of generated images
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Test the batch mode of ojph_compress and ojph_expand, with printf-style
+// file names and -num_frames.  Three frames are compressed and expanded in
+// one run each; every frame must come back unchanged, and its codestream
+// must match that of compressing the frame on its own.
+TEST(TestExecutables, BatchRoundTrip) {
+  for (int f = 0; f < 3; ++f) {
+    char name[32];
+    snprintf(name, sizeof(name), "batch_%02d.ppm", f);
+    ASSERT_TRUE(write_ppm_file(name, 64, 24, 8, f));
+  }
+  run_ojph_compress("batch_%02d.ppm", "batch_%02d", "", "j2c",
+                    "-num_frames 3 -reversible true", OUT_FILE_DIR);
+  run_ojph_compress_expand("batch_%02d", "j2c", "ppm", "_b", "-num_frames 3");
+  for (int f = 0; f < 3; ++f) {
+    char base[32];
+    snprintf(base, sizeof(base), "batch_%02d", f);
+    compare_files(base, "_b", "ppm", OUT_FILE_DIR);
+    run_ojph_compress(std::string(base) + ".ppm", base, "_s", "j2c",
+                      "-reversible true", OUT_FILE_DIR);
+    compare_files(base, "_s", "j2c", OUT_FILE_DIR);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Test -pipeline true and false in ojph_compress.  Both must produce the
+// same codestream, for the irv97 and the rev53 wavelets, and the rev53 one
+// must expand back to the original image.
+TEST(TestExecutables, PipelineRoundTrip) {
+  ASSERT_TRUE(write_ppm_file("pipeline.ppm", 100, 20, 10, 0));
+  run_ojph_compress("pipeline.ppm", "pipeline_irv", "", "j2c",
+                    "-pipeline true -qstep 0.01", OUT_FILE_DIR);
+  run_ojph_compress("pipeline.ppm", "pipeline_irv", "_off", "j2c",
+                    "-pipeline false -qstep 0.01", OUT_FILE_DIR);
+  compare_files("pipeline_irv", "_off", "j2c", OUT_FILE_DIR);
+  run_ojph_compress("pipeline.ppm", "pipeline_rev", "", "j2c",
+                    "-pipeline true -reversible true", OUT_FILE_DIR);
+  run_ojph_compress("pipeline.ppm", "pipeline_rev", "_off", "j2c",
+                    "-pipeline false -reversible true", OUT_FILE_DIR);
+  compare_files("pipeline_rev", "_off", "j2c", OUT_FILE_DIR);
+  run_ojph_compress_expand("pipeline_rev", "j2c", "ppm");
+  compare_files("pipeline", "_rev", "ppm", OUT_FILE_DIR);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Test v210 output of ojph_expand and input of ojph_compress.  A generated
+// 10-bit 4:2:2 image is compressed, expanded to v210, and the v210 file
+// compressed and expanded again; both v210 files and the final yuv image
+// must match what they came from.
+TEST(TestExecutables, V210RoundTrip) {
+  ASSERT_TRUE(write_yuv_file("v210.yuv", 100, 20, 10, 2, 1));
+  run_ojph_compress("v210.yuv", "v210", "", "j2c",
+                    "-reversible true -dims \"{100,20}\" -num_comps 3"
+                    " -downsamp \"{1,1}\",\"{2,1}\",\"{2,1}\""
+                    " -bit_depth 10,10,10 -signed false,false,false",
+                    OUT_FILE_DIR);
+  run_ojph_compress_expand("v210", "j2c", "v210");
+  run_ojph_compress("v210.v210", "v210", "_b", "j2c",
+                    "-reversible true -dims \"{100,20}\"", OUT_FILE_DIR);
+  run_ojph_compress_expand("v210_b", "j2c", "v210");
+  run_ojph_compress_expand("v210_b", "j2c", "yuv");
+  compare_files("v210", "_b", "v210", OUT_FILE_DIR);
+  compare_files("v210", "_b", "yuv", OUT_FILE_DIR);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Test P010 output of ojph_expand and input of ojph_compress, as for v210
+// but with a 10-bit 4:2:0 image.
+TEST(TestExecutables, P010RoundTrip) {
+  ASSERT_TRUE(write_yuv_file("p010.yuv", 100, 20, 10, 2, 2));
+  run_ojph_compress("p010.yuv", "p010", "", "j2c",
+                    "-reversible true -dims \"{100,20}\" -num_comps 3"
+                    " -downsamp \"{1,1}\",\"{2,2}\",\"{2,2}\""
+                    " -bit_depth 10,10,10 -signed false,false,false",
+                    OUT_FILE_DIR);
+  run_ojph_compress_expand("p010", "j2c", "p010");
+  run_ojph_compress("p010.p010", "p010", "_b", "j2c",
+                    "-reversible true -dims \"{100,20}\"", OUT_FILE_DIR);
+  run_ojph_compress_expand("p010_b", "j2c", "p010");
+  run_ojph_compress_expand("p010_b", "j2c", "yuv");
+  compare_files("p010", "_b", "p010", OUT_FILE_DIR);
+  compare_files("p010", "_b", "yuv", OUT_FILE_DIR);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Test DPX output of ojph_expand.  A generated 10-bit RGB image is
+// compressed and expanded to DPX, and the DPX file compressed and expanded
+// again; both DPX files and the final ppm image must match.
+TEST(TestExecutables, DpxOutRoundTrip) {
+  ASSERT_TRUE(write_ppm_file("dpx_out.ppm", 100, 20, 10, 0));
+  run_ojph_compress("dpx_out.ppm", "dpx_out", "", "j2c", "-reversible true",
+                    OUT_FILE_DIR);
+  run_ojph_compress_expand("dpx_out", "j2c", "dpx");
+  run_ojph_compress("dpx_out.dpx", "dpx_out", "_b", "j2c", "-reversible true",
+                    OUT_FILE_DIR);
+  run_ojph_compress_expand("dpx_out_b", "j2c", "dpx");
+  run_ojph_compress_expand("dpx_out_b", "j2c", "ppm");
+  compare_files("dpx_out", "_b", "dpx", OUT_FILE_DIR);
+  compare_files("dpx_out", "_b", "ppm", OUT_FILE_DIR);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Test ojph_bench, which encodes and decodes synthetic frames in memory.
+// Lossless runs verify the decoded samples by default, with and without
+// worker threads and tiles; the lossy presets must simply run.
+TEST(TestExecutables, BenchRuns) {
+  const char* options[] = {
+    "-dims \"{100,60}\"",
+    "-dims \"{100,60}\" -num_threads 2",
+    "-dims \"{100,60}\" -tile_size \"{48,32}\" -num_threads 2",
+    "-dims \"{100,60}\" -num_comps 1 -bit_depth 12 -noise_bits 12",
+    "-preset lossy -dims \"{100,60}\" -num_threads 2",
+    "-preset video4k -dims \"{100,60}\"",
+  };
+  for (size_t i = 0; i < sizeof(options) / sizeof(options[0]); ++i) {
+    try {
+      std::string result;
+      EXPECT_EQ(execute(std::string(BENCH_EXECUTABLE)
+        + " -iterations 2 -warmup 1 " + options[i], result), 0)
+        << options[i];
+      if (i < 4) {
+        EXPECT_NE(result.find("decoded samples match"), std::string::npos)
+          << options[i];
+      }
+    }
+    catch (const std::runtime_error& error) {
+      FAIL() << error.what();
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                  SIMD paths against the generic path
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Test ojph_kernel_bench -check_only, which must find every SIMD kernel
+// matching its generic one, at line widths around the 4kB column strips
+// and with codeblocks of extreme shapes.
+TEST(TestExecutables, KernelBenchCheck) {
+  const char* options[] = {
+    "-width 1024", "-width 1025", "-width 4096", "-width 4097",
+    "-block_size \"{4,1024}\"", "-block_size \"{1024,4}\"",
+    "-block_size \"{32,32}\"",
+  };
+  for (size_t i = 0; i < sizeof(options) / sizeof(options[0]); ++i) {
+    int rc = run_kernel_bench(options[i]);
+    if (rc == -1)
+      GTEST_SKIP() << "ojph_kernel_bench is not built";
+    EXPECT_EQ(rc, 0) << options[i];
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Test the SIMD kernels of the reversible path against the generic ones,
+// at widths that are not multiples of the vector length, so that the
+// masked tails of the loops are used.  The kernels are compared directly
+// by ojph_kernel_bench, when it is built, and through the executables at
+// every cpu level.
+TEST(TestExecutables, SimdTailWidths) {
+  const int widths[] = { 2, 15, 17, 33, 75 };
+  for (size_t i = 0; i < sizeof(widths) / sizeof(widths[0]); ++i) {
+    int rc = run_kernel_bench("-width " + std::to_string(widths[i]));
+    if (rc == -1)
+      break;
+    EXPECT_EQ(rc, 0) << "width " << widths[i];
+  }
+  ASSERT_TRUE(write_ppm_file("simd_tail.ppm", 75, 40, 8, 0));
+  compare_cpu_ext_levels("simd_tail",
+    "-reversible true -block_size \"{32,32}\"");
+  compare_files("simd_tail", "_d", "ppm", OUT_FILE_DIR);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Test the SIMD paths of the reversible wavelet on each side of the 16-bit
+// path, which is used when the precision of the transform is at most 16
+// bits.  With the colour transform, 11-bit images need 16 bits and 12-bit
+// ones 17; without it, 12-bit images need 16 and 13-bit ones 17.
+TEST(TestExecutables, SimdRev16BitPath) {
+  struct { int bit_depth; bool colour_trans; } cases[] =
+    { { 11, true }, { 12, true }, { 12, false }, { 13, false } };
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+    std::string base = "simd_rev_" + std::to_string(cases[i].bit_depth)
+      + (cases[i].colour_trans ? "" : "_nct");
+    ASSERT_TRUE(write_ppm_file(base + ".ppm", 75, 40, cases[i].bit_depth, 0));
+    compare_cpu_ext_levels(base, cases[i].colour_trans ? "-reversible true"
+      : "-reversible true -colour_trans false");
+    compare_files(base, "_d", "ppm", OUT_FILE_DIR);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Test the SIMD paths of the irreversible wavelet on each side of the
+// fixed-point path, which -fixed_point true selects for images of at most
+// 8 bits; 9-bit images take the floating-point path instead.
+TEST(TestExecutables, SimdIrvFixedPointPath) {
+  const int bit_depths[] = { 8, 9 };
+  for (size_t i = 0; i < sizeof(bit_depths) / sizeof(bit_depths[0]); ++i) {
+    std::string base = "simd_irv_" + std::to_string(bit_depths[i]);
+    ASSERT_TRUE(write_ppm_file(base + ".ppm", 75, 40, bit_depths[i], 0));
+    compare_cpu_ext_levels(base, "-qstep 0.01 -fixed_point true",
+      bit_depths[i] <= 8);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Test the SIMD paths of the vertical lifting steps on each side of the
+// width at which they are fused and applied one 4kB column strip at a
+// time, which is more than 4 strips: 8192 samples for 16-bit lines, and
+// 4096 for 32-bit integer and floating-point ones.
+TEST(TestExecutables, SimdVertLiftStrips) {
+  struct { const char* name; int width, bit_depth; const char* options; }
+  cases[] = {
+    { "simd_vert_i16", 8192, 8, "-reversible true" },
+    { "simd_vert_i16", 8193, 8, "-reversible true" },
+    { "simd_vert_i32", 4096, 12, "-reversible true" },
+    { "simd_vert_i32", 4097, 12, "-reversible true" },
+    { "simd_vert_fix16", 8192, 8, "-qstep 0.01 -fixed_point true" },
+    { "simd_vert_fix16", 8193, 8, "-qstep 0.01 -fixed_point true" },
+    { "simd_vert_f32", 4096, 9, "-qstep 0.01" },
+    { "simd_vert_f32", 4097, 9, "-qstep 0.01" },
+  };
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+    std::string base = std::string(cases[i].name) + "_"
+      + std::to_string(cases[i].width);
+    ASSERT_TRUE(write_ppm_file(base + ".ppm", cases[i].width, 6,
+      cases[i].bit_depth, 0));
+    bool reversible = strstr(cases[i].options, "-reversible") != NULL;
+    bool fixed_point = strstr(cases[i].options, "-fixed_point") != NULL;
+    compare_cpu_ext_levels(base, cases[i].options, reversible || fixed_point);
+    if (reversible)
+      compare_files(base, "_d", "ppm", OUT_FILE_DIR);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Test the SIMD readers of ojph_compress against the generic ones, which
+// unpack the lines of ppm, pgm, yuv and raw files; the readers are chosen
+// by the sample size, the number of interleaved components, signedness
+// and byte order.  Every image is 75 samples wide, or 38 for subsampled
+// yuv components, so that the tails of the loops are used, and must come
+// back unchanged from the reversible path.
+TEST(TestExecutables, SimdImgIoReaders) {
+  const int w = 75, h = 9;
+  std::string dims = " -dims \"{" + std::to_string(w) + ","
+    + std::to_string(h) + "}\"";
+  const int bit_depths[] = { 8, 12, 16 };
+  for (size_t i = 0; i < sizeof(bit_depths) / sizeof(bit_depths[0]); ++i) {
+    int bd = bit_depths[i];
+    std::string bds = std::to_string(bd);
+
+    std::string base = "simd_io_ppm_" + bds;
+    ASSERT_TRUE(write_ppm_file(base + ".ppm", w, h, bd, 0));
+    compare_cpu_ext_levels(base, "-reversible true");
+    compare_files(base, "_d", "ppm", OUT_FILE_DIR);
+
+    base = "simd_io_pgm_" + bds;
+    ASSERT_TRUE(write_ppm_file(base + ".pgm", w, h, bd, 0, 1));
+    compare_cpu_ext_levels(base, "-reversible true", true, "pgm");
+    compare_files(base, "_d", "pgm", OUT_FILE_DIR);
+
+    base = "simd_io_yuv_" + bds;
+    ASSERT_TRUE(write_yuv_file(base + ".yuv", w, h, bd, 2, 2));
+    compare_cpu_ext_levels(base, "-reversible true" + dims
+      + " -num_comps 3 -downsamp \"{1,1}\",\"{2,2}\",\"{2,2}\""
+      " -bit_depth " + bds + "," + bds + "," + bds
+      + " -signed false,false,false", true, "yuv");
+    compare_files(base, "_d", "yuv", OUT_FILE_DIR);
+
+    for (int s = 0; s < 2; ++s) {
+      base = "simd_io_raw_" + bds + (s ? "_s" : "_u");
+      ASSERT_TRUE(write_raw_file(base + ".raw", w, h, bd, s != 0));
+      compare_cpu_ext_levels(base, "-reversible true" + dims
+        + " -num_comps 1 -downsamp \"{1,1}\" -bit_depth " + bds
+        + (s ? " -signed true" : " -signed false"), true, "raw");
+      compare_files(base, "_d", "raw", OUT_FILE_DIR);
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                   main
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,488 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, OpenJPH Project
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// This file is part of the OpenJPH software implementation.
+// File: test_stream.cpp
+// Author: OpenJPH Project
+// Date: 2026
+//***************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ojph_arch.h"
+#include "ojph_file.h"
+#include "ojph_mem.h"
+#include "ojph_params.h"
+#include "ojph_codestream.h"
+#include "ojph_threads.h"
+#include "ojph_sockets.h"
+#include "stream_expand_support.h"
+#include "stream_compress_support.h"
+#include "gtest/gtest.h"
+
+using namespace ojph;
+
+////////////////////////////////////////////////////////////////////////////////
+//                                test_frame
+////////////////////////////////////////////////////////////////////////////////
+// A codestream of a small three-component image, which seed makes differ
+// from that of other frames, together with its RTP packets
+struct test_frame
+{
+  std::vector<ui8> data;
+  size_t main_header_size;
+  std::vector<std::vector<ui8> > packets;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                         make_frames
+////////////////////////////////////////////////////////////////////////////////
+// Encodes num_frames frames, and splits them into packets of at most
+// max_payload codestream bytes, with consecutive sequence numbers and time
+// stamps one 30 fps frame apart
+static
+void make_frames(ui32 num_frames, ui32 max_payload,
+                 std::vector<test_frame>& frames)
+{
+  const ui32 width = 64, height = 48;
+  stco::rtp_packetizer packetizer;
+  packetizer.init(96, 0x1234, max_payload, 1000);
+  frames.resize(num_frames);
+  for (ui32 f = 0; f < num_frames; ++f)
+  {
+    codestream cs;
+    param_siz siz = cs.access_siz();
+    siz.set_image_extent(point(width, height));
+    siz.set_num_components(3);
+    for (ui32 c = 0; c < 3; ++c)
+      siz.set_component(c, point(1, 1), 8, false);
+    cs.access_cod().set_reversible(true);
+    cs.access_cod().set_color_transform(true);
+    cs.set_planar(false);
+    mem_outfile out;
+    out.open();
+    cs.write_headers(&out);
+    frames[f].main_header_size = (size_t)out.tell();
+    ui32 next_comp;
+    line_buf* line = cs.exchange(NULL, next_comp);
+    for (ui32 y = 0; y < height; ++y)
+      for (ui32 c = 0; c < 3; ++c)
+      {
+        for (ui32 x = 0; x < width; ++x)
+          line->i32[x] = (si32)((x * 7 + y * 13 + c * 50 + f * 31
+                                + ((x * y) & 15)) & 0xFF);
+        line = cs.exchange(line, next_comp);
+      }
+    cs.flush();
+    frames[f].data.assign(out.get_data(), out.get_data() + out.tell());
+    cs.close();
+
+    ui32 num = packetizer.packetize(frames[f].data.data(),
+      frames[f].data.size(), frames[f].main_header_size, 3000 * (f + 1));
+    frames[f].packets.resize(num);
+    for (ui32 i = 0; i < num; ++i)
+      frames[f].packets[i].assign(packetizer.get_packet(i),
+        packetizer.get_packet(i) + packetizer.get_packet_size(i));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                               test_receiver
+////////////////////////////////////////////////////////////////////////////////
+// The receiving side of ojph_stream_expand, saving each completed frame
+// to <name>_<frame index>.j2c in the working directory
+struct test_receiver
+{
+  test_receiver(const char* name, ui32 num_packets, ui32 batch_size,
+                ui32 reorder_packets = 0)
+  : name(std::string(name) + "_%02d")
+  {
+    pool.init(2);
+    frames.init(true, this->name.c_str(), false, 0, &pool);
+    if (reorder_packets)
+      frames.set_reorder_window(reorder_packets, 0);
+    packets.init(true, num_packets, &frames, batch_size);
+  }
+
+  // pushes packets, in batches of batch_size, as ojph_stream_expand does
+  // with -batch
+  void push(const std::vector<const std::vector<ui8>*>& src,
+            ui32 batch_size)
+  {
+    std::vector<stex::rtp_packet*> slots(batch_size);
+    for (size_t i = 0; i < src.size(); )
+    {
+      ui32 n = packets.reserve_packets(slots.data(), batch_size);
+      ui32 k = 0;
+      for (; k < n && i < src.size(); ++k, ++i)
+      {
+        memcpy(slots[k]->data, src[i]->data(), src[i]->size());
+        slots[k]->num_bytes = (ui32)src[i]->size();
+      }
+      packets.push_packets(slots.data(), n);
+    }
+  }
+
+  // waits until the saved frames are written
+  void finish()
+  {
+    while (frames.flush())
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // reads the saved frame f
+  std::vector<ui8> read_frame(ui32 f)
+  {
+    char fname[64];
+    snprintf(fname, sizeof(fname), (name + ".j2c").c_str(), f);
+    std::vector<ui8> result;
+    FILE* fh = fopen(fname, "rb");
+    if (fh == NULL)
+      return result;
+    ui8 buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fh)) > 0)
+      result.insert(result.end(), buf, buf + n);
+    fclose(fh);
+    remove(fname);
+    return result;
+  }
+
+  std::string name;
+  thds::thread_pool pool;
+  stex::frames_handler frames;
+  stex::packets_handler packets;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                        check_frames
+////////////////////////////////////////////////////////////////////////////////
+// The receiver saved every frame, complete, and lost no packets
+static
+void check_frames(test_receiver& rx, const std::vector<test_frame>& frames)
+{
+  rx.finish();
+  ui32 total, trunc, lost;
+  rx.frames.get_stats(total, trunc, lost);
+  EXPECT_EQ(total, (ui32)frames.size());
+  EXPECT_EQ(trunc, 0u);
+  EXPECT_EQ(lost, 0u);
+  EXPECT_EQ(rx.packets.get_num_lost_packets(), 0u);
+  for (ui32 f = 0; f < (ui32)frames.size(); ++f)
+    EXPECT_EQ(rx.read_frame(f), frames[f].data) << "frame " << f;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                        tests of batched reception
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Packets pushed in batches, through reserve_packets() and push_packets(),
+// are put back in order within the window of packets_handler, and every
+// frame is saved complete.
+TEST(TestStream, BatchedPush) {
+  std::vector<test_frame> frames;
+  make_frames(3, 200, frames);
+  std::vector<const std::vector<ui8>*> order;
+  for (const test_frame& f : frames)
+    for (const std::vector<ui8>& p : f.packets)
+      order.push_back(&p);
+  // the first packet starts the sequence; later ones are rotated in threes
+  for (size_t i = 1; i + 2 < order.size(); i += 3)
+    std::rotate(order.begin() + (ptrdiff_t)i, order.begin() + (ptrdiff_t)i + 2,
+                order.begin() + (ptrdiff_t)i + 3);
+
+  const ui32 batch_sizes[] = { 1, 4, 32 };
+  for (ui32 batch_size : batch_sizes)
+  {
+    test_receiver rx("test_stream_batch", 8, batch_size);
+    rx.push(order, batch_size);
+    check_frames(rx, frames);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                         tests of late packets
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// A packet that arrives after the window of packets_handler truncates its
+// frame, unless the frame has a reordering window that reaches the packet,
+// in which case it is put back in place.  Two packets are late: one in the
+// middle of frame 0, and one near the end of frame 1, which arrives after
+// frame 2 has started, so that frame 1 waits for it while complete.
+TEST(TestStream, ReorderWindow) {
+  std::vector<test_frame> frames;
+  make_frames(3, 100, frames);
+  ASSERT_GT(frames[0].packets.size(), 12u);
+  std::vector<const std::vector<ui8>*> order;
+  for (const test_frame& f : frames)
+    for (const std::vector<ui8>& p : f.packets)
+      order.push_back(&p);
+  const ui32 delay = 10;
+  size_t late0 = 5;
+  size_t late1 = frames[0].packets.size() + frames[1].packets.size() - 3;
+  std::rotate(order.begin() + (ptrdiff_t)late1,
+    order.begin() + (ptrdiff_t)late1 + 1,
+    order.begin() + (ptrdiff_t)(late1 + delay + 1));
+  std::rotate(order.begin() + (ptrdiff_t)late0,
+    order.begin() + (ptrdiff_t)late0 + 1,
+    order.begin() + (ptrdiff_t)(late0 + delay + 1));
+
+  { // in time for the reordering window
+    test_receiver rx("test_stream_late", 2, 1, 2 * delay);
+    rx.push(order, 1);
+    check_frames(rx, frames);
+  }
+
+  const ui32 windows[] = { 0, delay / 2 };
+  for (ui32 window : windows)
+  { // without a window, or too late for it
+    test_receiver rx("test_stream_late", 2, 1, window);
+    rx.push(order, 1);
+    rx.finish();
+    ui32 total, trunc, lost;
+    rx.frames.get_stats(total, trunc, lost);
+    EXPECT_EQ(total, 3u);
+    EXPECT_EQ(trunc, 2u);
+    EXPECT_EQ(rx.packets.get_num_lost_packets(), 2u);
+    for (ui32 f = 0; f < 3; ++f)
+    {
+      std::vector<ui8> saved = rx.read_frame(f);
+      if (f == 2)
+        EXPECT_EQ(saved, frames[f].data);
+      else { // truncated at the late packet
+        size_t late = f == 0 ? late0 : late1 - frames[0].packets.size();
+        size_t bytes = 0;
+        for (size_t i = 0; i < late; ++i)
+          bytes += frames[f].packets[i].size()
+            - stco::rtp_packetizer::header_size;
+        EXPECT_EQ(saved.size(), bytes);
+        EXPECT_TRUE(std::equal(saved.begin(), saved.end(),
+                               frames[f].data.begin()));
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                          tests of the sender
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// rtp_packetizer carries the main header in main packets and the rest in
+// body packets, as rtp_packet reads them, with consecutive 24-bit sequence
+// numbers that wrap around, and marks only the last packet; a codestream
+// that fits in one packet has a single main packet.
+TEST(TestStream, Packetizer) {
+  std::vector<test_frame> frames;
+  make_frames(1, 100, frames);
+  const test_frame& f = frames[0];
+  stco::rtp_packetizer packetizer;
+  packetizer.init(97, 0x5678, 100, 0xFFFFFE);
+  ui32 num = packetizer.packetize(f.data.data(), f.data.size(),
+    f.main_header_size, 0x12345);
+  size_t num_main = (f.main_header_size + 99) / 100;
+  EXPECT_EQ(num, num_main + (f.data.size() - f.main_header_size + 99) / 100);
+
+  std::vector<ui8> data;
+  stex::rtp_packet p;
+  for (ui32 i = 0; i < num; ++i)
+  {
+    p.num_bytes = packetizer.get_packet_size(i);
+    ASSERT_LE(p.num_bytes, stco::rtp_packetizer::header_size + 100);
+    memcpy(p.data, packetizer.get_packet(i), p.num_bytes);
+    EXPECT_EQ(p.get_rtp_version(), 2u);
+    EXPECT_EQ(p.get_payload_type(), 97u);
+    EXPECT_EQ(p.get_ssrc(), 0x5678u);
+    EXPECT_EQ(p.get_seq_num(), (0xFFFFFE + i) & 0xFFFFFF);
+    EXPECT_EQ(p.get_time_stamp(), 0x12345u);
+    EXPECT_EQ(p.is_marked(), i + 1 == num);
+    ui32 type = i + 1 < num_main ? stex::rtp_packet::PT_MAIN_FOLLOWED_BY_MAIN
+      : i + 1 == num_main ? stex::rtp_packet::PT_MAIN_FOLLOWED_BY_BODY
+      : stex::rtp_packet::PT_BODY;
+    EXPECT_EQ(p.get_packet_type(), type);
+    if (type != stex::rtp_packet::PT_BODY) {
+      EXPECT_TRUE(p.is_PTSTAMP_used());
+      EXPECT_EQ(p.get_PTSTAMP(), 0x345u);
+    }
+    data.insert(data.end(), p.get_data(), p.get_data() + p.get_data_size());
+  }
+  EXPECT_EQ(data, f.data);
+
+  EXPECT_EQ(packetizer.packetize(f.data.data(), 60, 60, 0), 1u);
+  memcpy(p.data, packetizer.get_packet(0), packetizer.get_packet_size(0));
+  EXPECT_EQ(p.get_packet_type(), (ui32)stex::rtp_packet::PT_MAIN);
+  EXPECT_TRUE(p.is_marked());
+}
+
+#ifdef OJPH_OS_LINUX
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                       bind_loopback
+////////////////////////////////////////////////////////////////////////////////
+// Binds s to a free port of the loopback address, which is stored in addr
+static
+bool bind_loopback(net::socket& s, sockaddr_in& addr)
+{
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  socklen_t len = sizeof(addr);
+  return s.intern() != OJPH_INVALID_SOCKET
+    && bind(s.intern(), (struct sockaddr*)&addr, sizeof(addr)) == 0
+    && getsockname(s.intern(), (struct sockaddr*)&addr, &len) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// STATIC                      receive_packets
+////////////////////////////////////////////////////////////////////////////////
+// Receives count packets with receiver, in batches of batch_size, and
+// pushes them to rx, as ojph_stream_expand does with -batch; returns the
+// number of packets received before two seconds pass without any
+static
+size_t receive_packets(stex::batch_receiver& receiver, test_receiver& rx,
+                       ui32 batch_size, size_t count)
+{
+  std::vector<stex::rtp_packet*> slots(batch_size);
+  size_t received = 0;
+  int idle = 0;
+  while (received < count && idle < 20)
+  {
+    ui32 n = rx.packets.reserve_packets(slots.data(), batch_size);
+    int num = receiver.receive(slots.data(), n, 100);
+    EXPECT_GE(num, 0);
+    num = num > 0 ? num : 0;
+    idle = num == 0 ? idle + 1 : 0;
+    for (int i = 0; i < num; ++i)
+      EXPECT_NE(slots[(size_t)i]->rx_time, 0u);
+    received += (size_t)num;
+    rx.packets.push_packets(slots.data(), n);
+  }
+  return received;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// batch_receiver takes the packets sent to a loopback socket with recvmmsg,
+// in batches, with their kernel receive times, and the frames they make
+// are saved complete.
+TEST(TestStream, BatchReceiver) {
+  std::vector<test_frame> frames;
+  make_frames(3, 200, frames);
+
+  net::socket_manager smanager;
+  net::socket rs = smanager.create_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  net::socket ss = smanager.create_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  sockaddr_in addr;
+  ASSERT_TRUE(bind_loopback(rs, addr));
+  ASSERT_NE(ss.intern(), OJPH_INVALID_SOCKET);
+
+  const ui32 batch_size = 16;
+  stex::batch_receiver receiver;
+  ASSERT_TRUE(receiver.init(rs.intern(), batch_size, true));
+  test_receiver rx("test_stream_recv", 8, batch_size);
+  for (const test_frame& f : frames)
+  {
+    // one frame at a time, so that the socket buffer cannot overflow
+    for (const std::vector<ui8>& p : f.packets)
+      ASSERT_EQ(sendto(ss.intern(), p.data(), p.size(), 0,
+        (struct sockaddr*)&addr, sizeof(addr)), (ssize_t)p.size());
+    EXPECT_EQ(receive_packets(receiver, rx, batch_size, f.packets.size()),
+              f.packets.size());
+  }
+  check_frames(rx, frames);
+  rs.close();
+  ss.close();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// paced_sender sends every packet to a loopback socket, in batches with
+// sendmmsg, no faster than its bitrate allows, and the frames the packets
+// make are saved complete.
+TEST(TestStream, PacedSender) {
+  std::vector<test_frame> frames;
+  make_frames(3, 500, frames);
+
+  net::socket_manager smanager;
+  net::socket rs = smanager.create_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  net::socket ss = smanager.create_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  sockaddr_in addr;
+  ASSERT_TRUE(bind_loopback(rs, addr));
+  ASSERT_NE(ss.intern(), OJPH_INVALID_SOCKET);
+
+  const ui32 batch_size = 4;
+  const double bits_per_second = 2e6;
+  stco::paced_sender sender;
+  sender.init(ss.intern(), addr, batch_size, bits_per_second);
+  stex::batch_receiver receiver;
+  ASSERT_TRUE(receiver.init(rs.intern(), batch_size, true));
+  test_receiver rx("test_stream_paced", 8, batch_size);
+
+  stco::rtp_packetizer packetizer;
+  packetizer.init(96, 0x1234, 500, 1000);
+  ui64 paced_bytes = 0, total_bytes = 0;
+  ui64 start = stco::get_steady_time_ns();
+  for (ui32 i = 0; i < (ui32)frames.size(); ++i)
+  {
+    const test_frame& f = frames[i];
+    ui32 num = packetizer.packetize(f.data.data(), f.data.size(),
+      f.main_header_size, 3000 * (i + 1));
+    // only the first batch of a frame may leave at once
+    for (ui32 k = 0; k < num; ++k) {
+      total_bytes += packetizer.get_packet_size(k);
+      if (k >= batch_size)
+        paced_bytes += packetizer.get_packet_size(k);
+    }
+    ASSERT_TRUE(sender.send(packetizer));
+    EXPECT_EQ(receive_packets(receiver, rx, batch_size, num), (size_t)num);
+  }
+  double seconds = (double)(stco::get_steady_time_ns() - start) / 1e9;
+  EXPECT_GE(seconds, (double)paced_bytes * 8.0 / bits_per_second);
+  EXPECT_EQ(sender.get_bytes_sent(), total_bytes);
+  check_frames(rx, frames);
+  rs.close();
+  ss.close();
+}
+
+#endif // !OJPH_OS_LINUX
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   main
+////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}